@@ -0,0 +1,81 @@
+/**
+ * @file bench/bench_tools.hpp
+ *
+ * A tiny hand-rolled harness for the mlpack benchmark suite.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCH_BENCH_TOOLS_HPP
+#define MLPACK_BENCH_BENCH_TOOLS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace bench {
+
+/**
+ * Print the CSV header of the benchmark output.  One row per benchmark
+ * follows (see RunBenchmark()); the output is meant to be appended, together
+ * with the git revision and machine name, to a log for longitudinal
+ * comparison.
+ */
+inline void PrintHeader()
+{
+  std::cout << "benchmark,repetitions,min_s,median_s,mean_s" << std::endl;
+}
+
+/**
+ * Run the given callable several times and print one machine-readable CSV row
+ * with its name and the minimum, median and mean wall-clock time in seconds.
+ * One untimed warm-up run is done first, so one-time costs (allocator warmup,
+ * page faults on the input data) don't pollute the measurements.
+ *
+ * @param name Name of the benchmark (must not contain commas).
+ * @param filter Only run the benchmark if its name contains this substring.
+ * @param f The workload to measure.
+ * @param repetitions Number of timed runs.
+ */
+template<typename FuncType>
+void RunBenchmark(const std::string& name,
+                  const std::string& filter,
+                  FuncType f,
+                  const size_t repetitions = 5)
+{
+  if (name.find(filter) == std::string::npos)
+    return;
+
+  // Warm-up run.
+  f();
+
+  std::vector<double> times(repetitions);
+  for (size_t i = 0; i < repetitions; ++i)
+  {
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    f();
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+    times[i] = std::chrono::duration<double>(end - start).count();
+  }
+
+  std::sort(times.begin(), times.end());
+  double mean = 0.0;
+  for (size_t i = 0; i < repetitions; ++i)
+    mean += times[i];
+  mean /= repetitions;
+
+  std::cout << name << "," << repetitions << "," << times[0] << ","
+      << times[repetitions / 2] << "," << mean << std::endl;
+}
+
+} // namespace bench
+} // namespace mlpack
+
+#endif
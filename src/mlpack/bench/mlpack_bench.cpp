@@ -0,0 +1,134 @@
+/**
+ * @file bench/mlpack_bench.cpp
+ *
+ * The mlpack benchmark suite: wall-clock benchmarks of the hot paths, with
+ * machine-readable CSV output for longitudinal regression tracking.
+ *
+ * Build with `make mlpack_bench` and run with an optional substring filter:
+ *
+ *   mlpack_bench               # run everything
+ *   mlpack_bench tree          # run only benchmarks whose name contains
+ *                              # "tree"
+ *
+ * Append the output (together with the git revision and machine name) to a
+ * log to compare timings across revisions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+#include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/kmeans/naive_kmeans.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+#include "bench_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::ann;
+using namespace mlpack::bench;
+using namespace mlpack::neighbor;
+using namespace mlpack::tree;
+
+int main(int argc, char** argv)
+{
+  // An optional substring filter selects a subset of the benchmarks.
+  const std::string filter = (argc > 1) ? argv[1] : "";
+
+  // Fixed seeds, so that runs on different revisions measure the same work.
+  math::RandomSeed(42);
+
+  PrintHeader();
+
+  // Build a kd-tree on a moderately sized random dataset.
+  {
+    arma::mat data = arma::randu<arma::mat>(10, 50000);
+    RunBenchmark("binary_space_tree_build", filter, [&]()
+    {
+      KDTree<metric::EuclideanDistance, tree::EmptyStatistic, arma::mat>
+          tree(data);
+    });
+  }
+
+  // Dual-tree k-nearest-neighbor search (the trees are built once, outside
+  // the timed region).
+  {
+    arma::mat references = arma::randu<arma::mat>(10, 20000);
+    arma::mat queries = arma::randu<arma::mat>(10, 2000);
+    KNN knn(references);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    RunBenchmark("neighbor_search_search", filter, [&]()
+    {
+      knn.Search(queries, 5, neighbors, distances);
+    });
+  }
+
+  // A single Lloyd iteration of naive k-means.
+  {
+    arma::mat data = arma::randu<arma::mat>(10, 50000);
+    arma::mat centroids = arma::randu<arma::mat>(10, 50);
+    metric::EuclideanDistance metric;
+    kmeans::NaiveKMeans<metric::EuclideanDistance, arma::mat>
+        naive(data, metric);
+    arma::mat newCentroids;
+    arma::Col<size_t> counts;
+    RunBenchmark("naive_kmeans_iterate", filter, [&]()
+    {
+      naive.Iterate(centroids, newCentroids, counts);
+    });
+  }
+
+  // The forward pass of a small multilayer perceptron over a large batch.
+  {
+    arma::mat data = arma::randu<arma::mat>(100, 10000);
+    arma::mat responses = arma::randu<arma::mat>(10, 10000);
+    FFN<MeanSquaredError> network;
+    network.Add<Linear>(256);
+    network.Add<ReLU>();
+    network.Add<Linear>(256);
+    network.Add<ReLU>();
+    network.Add<Linear>(10);
+    // One short training epoch initializes the weights.
+    ens::RMSProp opt(0.01, 32, 0.88, 1e-8, data.n_cols, -1);
+    network.Train(data, responses, opt);
+    arma::mat predictions;
+    RunBenchmark("ffn_predict", filter, [&]()
+    {
+      network.Predict(data, predictions);
+    });
+  }
+
+  // Loading a numeric CSV file from disk.
+  {
+    const std::string file = "mlpack_bench_tmp.csv";
+    arma::mat data = arma::randu<arma::mat>(50, 20000);
+    data::Save(file, data);
+    arma::mat loaded;
+    RunBenchmark("load_numeric_csv", filter, [&]()
+    {
+      data::Load(file, loaded);
+    });
+    remove(file.c_str());
+  }
+
+  // Training a decision tree on a random two-class dataset.
+  {
+    arma::mat data = arma::randu<arma::mat>(10, 20000);
+    arma::Row<size_t> labels(20000);
+    for (size_t i = 0; i < labels.n_elem; ++i)
+      labels[i] = (data(0, i) + data(1, i) > 1.0) ? 1 : 0;
+    RunBenchmark("decision_tree_train", filter, [&]()
+    {
+      DecisionTree<> tree(data, labels, 2, 10 /* minimumLeafSize */);
+    });
+  }
+
+  return 0;
+}
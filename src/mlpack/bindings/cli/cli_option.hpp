@@ -76,56 +76,65 @@ class CLIOption
             const bool noTranspose = false,
             const std::string& bindingName = "")
   {
-    // Create the ParamData object to give to CLI.
-    util::ParamData data;
+    // Only queue the registration work here; it runs lazily, when a binding
+    // first asks IO for its parameters.  CLI binaries are often invoked just
+    // to print --help or run briefly, so startup should not pay for building
+    // and registering every parameter eagerly.
+    IO::Defer([=]()
+    {
+      // Create the ParamData object to give to CLI.
+      util::ParamData data;
 
-    data.desc = description;
-    data.name = identifier;
-    data.tname = TYPENAME(N);
-    data.alias = alias[0];
-    data.wasPassed = false;
-    data.noTranspose = noTranspose;
-    data.required = required;
-    data.input = input;
-    data.loaded = false;
-    data.cppType = cppName;
+      data.desc = description;
+      data.name = identifier;
+      data.tname = TYPENAME(N);
+      data.alias = alias[0];
+      data.wasPassed = false;
+      data.noTranspose = noTranspose;
+      data.required = required;
+      data.input = input;
+      data.loaded = false;
+      data.cppType = cppName;
 
-    // Apply default value.
-    if (std::is_same<typename std::remove_pointer<N>::type,
-                     typename ParameterType<typename
-                         std::remove_pointer<N>::type>::type>::value)
-    {
-      data.value = ANY(defaultValue);
-    }
-    else
-    {
-      typename ParameterType<typename std::remove_pointer<N>::type>::type tmp;
-      data.value = ANY(std::tuple<N, decltype(tmp)>(defaultValue, tmp));
-    }
+      // Apply default value.
+      if (std::is_same<typename std::remove_pointer<N>::type,
+                       typename ParameterType<typename
+                           std::remove_pointer<N>::type>::type>::value)
+      {
+        data.value = ANY(defaultValue);
+      }
+      else
+      {
+        typename ParameterType<typename std::remove_pointer<N>::type>::type tmp;
+        data.value = ANY(std::tuple<N, decltype(tmp)>(defaultValue, tmp));
+      }
 
-    const std::string tname = data.tname;
-    const std::string cliName = MapParameterName<
-        typename std::remove_pointer<N>::type>(identifier);
-    std::string progOptId = (alias[0] != '\0') ?
-        "-" + std::string(1, alias[0]) + ",--" + cliName : "--" + cliName;
+      const std::string tname = data.tname;
+      const std::string cliName = MapParameterName<
+          typename std::remove_pointer<N>::type>(identifier);
+      std::string progOptId = (alias[0] != '\0') ?
+          "-" + std::string(1, alias[0]) + ",--" + cliName : "--" + cliName;
 
-    // Set some function pointers that we need.
-    IO::AddFunction(tname, "DefaultParam", &DefaultParam<N>);
-    IO::AddFunction(tname, "OutputParam", &OutputParam<N>);
-    IO::AddFunction(tname, "GetPrintableParam", &GetPrintableParam<N>);
-    IO::AddFunction(tname, "StringTypeParam", &StringTypeParam<N>);
-    IO::AddFunction(tname, "GetParam", &GetParam<N>);
-    IO::AddFunction(tname, "GetRawParam", &GetRawParam<N>);
-    IO::AddFunction(tname, "AddToCLI11", &AddToCLI11<N>);
-    IO::AddFunction(tname, "MapParameterName", &MapParameterName<N>);
-    IO::AddFunction(tname, "GetPrintableParamName", &GetPrintableParamName<N>);
-    IO::AddFunction(tname, "GetPrintableParamValue",
-        &GetPrintableParamValue<N>);
-    IO::AddFunction(tname, "GetAllocatedMemory", &GetAllocatedMemory<N>);
-    IO::AddFunction(tname, "DeleteAllocatedMemory", &DeleteAllocatedMemory<N>);
-    IO::AddFunction(tname, "InPlaceCopy", &InPlaceCopy<N>);
+      // Set some function pointers that we need.
+      IO::AddFunction(tname, "DefaultParam", &DefaultParam<N>);
+      IO::AddFunction(tname, "OutputParam", &OutputParam<N>);
+      IO::AddFunction(tname, "GetPrintableParam", &GetPrintableParam<N>);
+      IO::AddFunction(tname, "StringTypeParam", &StringTypeParam<N>);
+      IO::AddFunction(tname, "GetParam", &GetParam<N>);
+      IO::AddFunction(tname, "GetRawParam", &GetRawParam<N>);
+      IO::AddFunction(tname, "AddToCLI11", &AddToCLI11<N>);
+      IO::AddFunction(tname, "MapParameterName", &MapParameterName<N>);
+      IO::AddFunction(tname, "GetPrintableParamName",
+          &GetPrintableParamName<N>);
+      IO::AddFunction(tname, "GetPrintableParamValue",
+          &GetPrintableParamValue<N>);
+      IO::AddFunction(tname, "GetAllocatedMemory", &GetAllocatedMemory<N>);
+      IO::AddFunction(tname, "DeleteAllocatedMemory",
+          &DeleteAllocatedMemory<N>);
+      IO::AddFunction(tname, "InPlaceCopy", &InPlaceCopy<N>);
 
-    IO::AddParameter(bindingName, std::move(data));
+      IO::AddParameter(bindingName, std::move(data));
+    });
   }
 };
 
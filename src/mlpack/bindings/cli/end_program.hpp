@@ -15,6 +15,8 @@
 
 #include <mlpack/core/util/io.hpp>
 
+#include "server_cache.hpp"
+
 namespace mlpack {
 namespace bindings {
 namespace cli {
@@ -90,7 +92,9 @@ inline void EndProgram(util::Params& params, util::Timers& timers)
     void* result;
     params.functionMap[data.tname]["GetAllocatedMemory"](data, NULL,
         (void*) &result);
-    if (result != NULL && memoryAddresses.count(result) == 0)
+    // In server mode, models owned by the cache live on for later requests.
+    if (result != NULL && memoryAddresses.count(result) == 0 &&
+        !ServerCache::Instance().Owns(result))
       memoryAddresses[result] = &data;
   }
 
@@ -13,7 +13,9 @@
 #define MLPACK_BINDINGS_CLI_GET_PARAM_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/shared_dataset.hpp>
 #include "parameter_type.hpp"
+#include "server_cache.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -59,11 +61,40 @@ T& GetParam(
   size_t& n_cols = std::get<2>(std::get<1>(tuple));
   if (d.input && !d.loaded)
   {
-    // Call correct data::Load() function.
-    if (arma::is_Row<T>::value || arma::is_Col<T>::value)
-      data::Load(value, matrix, true);
+    // In server mode, a dataset that an earlier request already parsed is
+    // copied out of the cache instead of being parsed again.
+    void* cached = ServerCache::Instance().Find(d.tname, value);
+    if (cached != NULL)
+    {
+      matrix = *static_cast<T*>(cached);
+    }
+    else if (value.rfind("shm://", 0) == 0)
+    {
+      // The dataset was published to POSIX shared memory by another process
+      // (see data::SharedDataset and the shared_dataset binding); attach to
+      // the segment instead of loading from disk.  The segment already holds
+      // the parsed column-major data, so no parse (or transposition) happens
+      // here; the copy out of the aliasing matrix keeps the binding's usual
+      // ownership rules.
+      data::SharedDataset<typename T::elem_type> shared;
+      shared.Attach(value.substr(6), true);
+      matrix = arma::conv_to<T>::from(shared.Matrix());
+
+      ServerCache::Instance().Insert(d.tname, value, new T(matrix),
+          [](void* object) { delete static_cast<T*>(object); });
+    }
     else
-      data::Load(value, matrix, true, !d.noTranspose);
+    {
+      // Call correct data::Load() function.
+      if (arma::is_Row<T>::value || arma::is_Col<T>::value)
+        data::Load(value, matrix, true);
+      else
+        data::Load(value, matrix, true, !d.noTranspose);
+
+      // A no-op unless the server cache is enabled.
+      ServerCache::Instance().Insert(d.tname, value, new T(matrix),
+          [](void* object) { delete static_cast<T*>(object); });
+    }
     n_rows = matrix.n_rows;
     n_cols = matrix.n_cols;
     d.loaded = true;
@@ -93,7 +124,17 @@ T& GetParam(
   size_t& n_cols = std::get<2>(std::get<1>(*tuple));
   if (d.input && !d.loaded)
   {
-    data::Load(value, std::get<1>(t), std::get<0>(t), true, !d.noTranspose);
+    void* cached = ServerCache::Instance().Find(d.tname, value);
+    if (cached != NULL)
+    {
+      t = *static_cast<T*>(cached);
+    }
+    else
+    {
+      data::Load(value, std::get<1>(t), std::get<0>(t), true, !d.noTranspose);
+      ServerCache::Instance().Insert(d.tname, value, new T(t),
+          [](void* object) { delete static_cast<T*>(object); });
+    }
     n_rows = std::get<1>(t).n_rows;
     n_cols = std::get<1>(t).n_cols;
     d.loaded = true;
@@ -120,8 +161,17 @@ T*& GetParam(
   const std::string& value = std::get<1>(*tuple);
   if (d.input && !d.loaded)
   {
-    T* model = new T();
-    data::Load(value, "model", *model, true);
+    // In server mode, a model that an earlier request already deserialized
+    // is shared directly; the cache keeps ownership, and EndProgram() knows
+    // not to delete it.
+    T* model = static_cast<T*>(ServerCache::Instance().Find(d.tname, value));
+    if (model == NULL)
+    {
+      model = new T();
+      data::Load(value, "model", *model, true);
+      ServerCache::Instance().Insert(d.tname, value, model,
+          [](void* object) { delete static_cast<T*>(object); });
+    }
     d.loaded = true;
     std::get<0>(*tuple) = model;
   }
@@ -83,6 +83,7 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 #include <mlpack/core/util/timers.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/server_mode.hpp>
 
 // Forward definition of the binding function.
 void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
@@ -90,6 +91,13 @@ void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
 // Define the main function that will be used by this binding.
 int main(int argc, char** argv)
 {
+  // If --server was given, run persistently instead: one request per line of
+  // standard input, with loaded models and datasets cached across requests
+  // (see server_mode.hpp).
+  for (int i = 1; i < argc; ++i)
+    if (std::string(argv[i]) == "--server")
+      return mlpack::bindings::cli::RunServer(argv[0], BINDING_FUNCTION);
+
   // Parse the command-line options; put them into CLI.
   mlpack::util::Params params =
       mlpack::bindings::cli::ParseCommandLine(argc, argv);
@@ -113,6 +121,10 @@ PARAM_GLOBAL(bool, "help", "Default help info.", "h", "bool", false, true,
     false, false);
 PARAM_GLOBAL(std::string, "info", "Print help on a specific option.", "",
     "std::string", false, true, false, "");
+PARAM_GLOBAL(bool, "server", "Run persistently: execute one request per line "
+    "of standard input (tokens as on a command line), caching loaded models "
+    "and datasets across requests; 'exit' or end of input stops the server.",
+    "", "bool", false, true, false, false);
 PARAM_GLOBAL(bool, "verbose", "Display informational messages and the full "
     "list of parameters and timers at the end of execution.", "v", "bool",
     false, true, false, false);
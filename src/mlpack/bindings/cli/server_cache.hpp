@@ -0,0 +1,136 @@
+/**
+ * @file bindings/cli/server_cache.hpp
+ * @author Ryan Curtin
+ *
+ * A cache of loaded input parameters for the persistent server mode of
+ * command-line bindings.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVER_CACHE_HPP
+#define MLPACK_BINDINGS_CLI_SERVER_CACHE_HPP
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * A process-wide cache of input parameters that were loaded from files, used
+ * by the persistent server mode (see server_mode.hpp).  A one-shot binding
+ * invocation loads its input model and datasets, runs, and exits; a server
+ * handles many requests, so loading the same files again for every request
+ * would waste most of the run time.  When the cache is enabled, GetParam()
+ * keeps every model and dataset it loads, keyed by parameter type and
+ * filename, and reuses them for later requests; EndProgram() skips deleting
+ * anything the cache owns.
+ *
+ * The cache is disabled by default, so one-shot invocations behave exactly
+ * as before.  It assumes the files it has loaded do not change while the
+ * server runs; the server's "clear-cache" command drops all entries if they
+ * do.  Entries are type-erased (the loading code registers a deleter), and
+ * everything left in the cache is deleted when the process exits.
+ */
+class ServerCache
+{
+ public:
+  //! Get the process-wide cache instance.
+  static ServerCache& Instance()
+  {
+    static ServerCache cache;
+    return cache;
+  }
+
+  //! Whether or not the cache is in use (false unless in server mode).
+  bool& Enabled() { return enabled; }
+
+  /**
+   * Look up a cached object.  Returns NULL if the cache is disabled or the
+   * object has not been loaded yet.
+   *
+   * @param tname Type name of the parameter (ParamData::tname).
+   * @param filename File the object was loaded from.
+   */
+  void* Find(const std::string& tname, const std::string& filename) const
+  {
+    if (!enabled)
+      return NULL;
+
+    const std::map<KeyType, Entry>::const_iterator it =
+        cache.find(KeyType(tname, filename));
+    return (it == cache.end()) ? NULL : it->second.object;
+  }
+
+  /**
+   * Take ownership of a loaded object.  A no-op if the cache is disabled, so
+   * loading code can call this unconditionally.
+   *
+   * @param tname Type name of the parameter (ParamData::tname).
+   * @param filename File the object was loaded from.
+   * @param object The loaded object.
+   * @param deleter Function that deletes the object with its real type.
+   */
+  void Insert(const std::string& tname,
+              const std::string& filename,
+              void* object,
+              void (*deleter)(void*))
+  {
+    if (!enabled)
+      return;
+
+    cache[KeyType(tname, filename)] = Entry{ object, deleter };
+  }
+
+  //! Get whether or not the cache owns the given object (and so it must not
+  //! be deleted by anyone else).
+  bool Owns(const void* object) const
+  {
+    if (!enabled)
+      return false;
+
+    for (const std::pair<const KeyType, Entry>& entry : cache)
+      if (entry.second.object == object)
+        return true;
+    return false;
+  }
+
+  //! Delete every cached object.
+  void Clear()
+  {
+    for (std::pair<const KeyType, Entry>& entry : cache)
+      entry.second.deleter(entry.second.object);
+    cache.clear();
+  }
+
+  ~ServerCache() { Clear(); }
+
+ private:
+  ServerCache() : enabled(false) { }
+
+  //! Cache entries are keyed by parameter type name and filename.
+  typedef std::pair<std::string, std::string> KeyType;
+
+  //! One cached object together with the function that can delete it.
+  struct Entry
+  {
+    void* object;
+    void (*deleter)(void*);
+  };
+
+  //! The cached objects.
+  std::map<KeyType, Entry> cache;
+  //! Whether or not the cache is in use.
+  bool enabled;
+};
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file bindings/cli/server_mode.hpp
+ * @author Ryan Curtin
+ *
+ * The persistent server mode of command-line bindings: execute one request
+ * per line of standard input instead of a single command line.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVER_MODE_HPP
+#define MLPACK_BINDINGS_CLI_SERVER_MODE_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parse_command_line.hpp"
+#include "end_program.hpp"
+#include "server_cache.hpp"
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Split one request line into command-line tokens.  Tokens are separated by
+ * whitespace; single and double quotes group characters (including
+ * whitespace) into one token, and a backslash escapes the next character.
+ */
+inline std::vector<std::string> SplitCommandLine(const std::string& line)
+{
+  std::vector<std::string> tokens;
+  std::string token;
+  bool inToken = false;
+  char quote = '\0';
+
+  for (size_t i = 0; i < line.length(); ++i)
+  {
+    const char c = line[i];
+    if (c == '\\' && i + 1 < line.length())
+    {
+      token += line[++i];
+      inToken = true;
+    }
+    else if (quote != '\0')
+    {
+      if (c == quote)
+        quote = '\0';
+      else
+        token += c;
+    }
+    else if (c == '\'' || c == '"')
+    {
+      quote = c;
+      inToken = true; // An empty quoted string is still a token.
+    }
+    else if (c == ' ' || c == '\t' || c == '\r')
+    {
+      if (inToken)
+        tokens.push_back(token);
+      token.clear();
+      inToken = false;
+    }
+    else
+    {
+      token += c;
+      inToken = true;
+    }
+  }
+  if (inToken)
+    tokens.push_back(token);
+
+  return tokens;
+}
+
+/**
+ * Run the binding as a long-lived server: read one request per line from
+ * standard input, execute it exactly as if its tokens had been the command
+ * line, and print one status line ("ok", or "error: <message>") to standard
+ * output when the request finishes.  The process exits when standard input
+ * is closed or an "exit" (or "quit") line is read; a "clear-cache" line
+ * drops every cached model and dataset (use it if the files on disk have
+ * changed).
+ *
+ * While the server runs, input models and datasets are cached by filename
+ * (see ServerCache), so a model is deserialized and a dataset parsed only
+ * for the first request that uses it; every later request starts at zero
+ * cost.  Standard input is a pipe like any other, so the server can sit
+ * behind a UNIX socket through standard tooling (e.g. socat) without any
+ * socket handling here.
+ *
+ * Requests are executed one at a time, in order.  A failed request (bad
+ * parameters, missing file, Log::Fatal from the binding) reports "error:"
+ * and does not take the server down; --version, --help and --info still
+ * exit the process, as they do on a normal command line.
+ *
+ * @param programName Name of the binding executable (argv[0]), used as the
+ *     first token of every request's argument vector.
+ * @param bindingFunction The binding function to execute for each request.
+ */
+template<typename BindingFunctionType>
+int RunServer(const char* programName, BindingFunctionType bindingFunction)
+{
+  ServerCache::Instance().Enabled() = true;
+  mlpack::Timer::EnableTiming();
+
+  std::string line;
+  while (std::getline(std::cin, line))
+  {
+    std::vector<std::string> tokens = SplitCommandLine(line);
+    if (tokens.empty())
+      continue;
+
+    if (tokens[0] == "exit" || tokens[0] == "quit")
+      break;
+
+    if (tokens[0] == "clear-cache")
+    {
+      ServerCache::Instance().Clear();
+      std::cout << "ok" << std::endl;
+      continue;
+    }
+
+    // Build the argument vector of this request.
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(programName));
+    for (size_t i = 0; i < tokens.size(); ++i)
+      argv.push_back(const_cast<char*>(tokens[i].c_str()));
+
+    try
+    {
+      mlpack::util::Params params = ParseCommandLine((int) argv.size(),
+          argv.data());
+      mlpack::util::Timers timers;
+      timers.Enabled() = true;
+
+      timers.Start("total_time");
+      bindingFunction(params, timers);
+      timers.Stop("total_time");
+
+      EndProgram(params, timers);
+      std::cout << "ok" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+      // A failed request must not take the server down; report it and wait
+      // for the next request.
+      std::cout << "error: " << e.what() << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
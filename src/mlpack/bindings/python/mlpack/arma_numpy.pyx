@@ -53,8 +53,10 @@ cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Make a copy only if we must: the array is not laid out the way
+    # Armadillo needs, or its memory must be owned so that ownership can be
+    # taken and it cannot be (a view does not own its memory).
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -75,9 +77,10 @@ cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Make a copy only if we must: the array is not laid out the way
+    # Armadillo needs, or its memory must be owned so that ownership can be
+    # taken and it cannot be (a view does not own its memory).
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -141,9 +144,10 @@ cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Make a copy only if we must: the array is not laid out the way
+    # Armadillo needs, or its memory must be owned so that ownership can be
+    # taken and it cannot be (a view does not own its memory).
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -165,9 +169,10 @@ cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Make a copy only if we must: the array is not laid out the way
+    # Armadillo needs, or its memory must be owned so that ownership can be
+    # taken and it cannot be (a view does not own its memory).
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -228,9 +233,10 @@ cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Make a copy only if we must: the array is not laid out the way
+    # Armadillo needs, or its memory must be owned so that ownership can be
+    # taken and it cannot be (a view does not own its memory).
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -252,9 +258,10 @@ cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Make a copy only if we must: the array is not laid out the way
+    # Armadillo needs, or its memory must be owned so that ownership can be
+    # taken and it cannot be (a view does not own its memory).
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -69,37 +69,44 @@ class TestOption
              const bool noTranspose = false,
              const std::string& bindingName = "")
   {
-    // Create the ParamData object to give to IO.
-    util::ParamData data;
+    // Only queue the registration work here; it runs lazily, when a binding
+    // first asks IO for its parameters (the test fixtures do this before
+    // touching the function maps, so the deferred work is always done by the
+    // time it is needed).
+    IO::Defer([=]()
+    {
+      // Create the ParamData object to give to IO.
+      util::ParamData data;
 
-    data.desc = description;
-    data.name = identifier;
-    data.tname = TYPENAME(N);
-    data.alias = alias[0];
-    // If this is an output option, set it as passed.
-    data.wasPassed = !input;
-    data.noTranspose = noTranspose;
-    data.required = required;
-    data.input = input;
-    data.loaded = false;
-    data.cppType = cppName;
-    data.value = ANY(defaultValue);
+      data.desc = description;
+      data.name = identifier;
+      data.tname = TYPENAME(N);
+      data.alias = alias[0];
+      // If this is an output option, set it as passed.
+      data.wasPassed = !input;
+      data.noTranspose = noTranspose;
+      data.required = required;
+      data.input = input;
+      data.loaded = false;
+      data.cppType = cppName;
+      data.value = ANY(defaultValue);
 
-    const std::string tname = data.tname;
+      const std::string tname = data.tname;
 
-    // Set the function pointers in the test function map singleton.  We don't
-    // register them with IO::AddFunction(), because these will be restored as
-    // part of the test binding fixture; see
-    // `src/mlpack/tests/main_tests/main_test_fixture.hpp`.
-    TestFunctionMap::RegisterFunction(tname, "GetPrintableParam",
-        &GetPrintableParam<N>);
-    TestFunctionMap::RegisterFunction(tname, "GetParam", &GetParam<N>);
-    TestFunctionMap::RegisterFunction(tname, "GetAllocatedMemory",
-        &GetAllocatedMemory<N>);
-    TestFunctionMap::RegisterFunction(tname, "DeleteAllocatedMemory",
-        &DeleteAllocatedMemory<N>);
+      // Set the function pointers in the test function map singleton.  We don't
+      // register them with IO::AddFunction(), because these will be restored as
+      // part of the test binding fixture; see
+      // `src/mlpack/tests/main_tests/main_test_fixture.hpp`.
+      TestFunctionMap::RegisterFunction(tname, "GetPrintableParam",
+          &GetPrintableParam<N>);
+      TestFunctionMap::RegisterFunction(tname, "GetParam", &GetParam<N>);
+      TestFunctionMap::RegisterFunction(tname, "GetAllocatedMemory",
+          &GetAllocatedMemory<N>);
+      TestFunctionMap::RegisterFunction(tname, "DeleteAllocatedMemory",
+          &DeleteAllocatedMemory<N>);
 
-    IO::AddParameter(bindingName, std::move(data));
+      IO::AddParameter(bindingName, std::move(data));
+    });
   }
 };
 
@@ -89,6 +89,7 @@
 #include <mlpack/core/dists/laplace_distribution.hpp>
 #include <mlpack/core/dists/gamma_distribution.hpp>
 #include <mlpack/core/dists/diagonal_gaussian_distribution.hpp>
+#include <mlpack/core/dists/low_rank_gaussian_distribution.hpp>
 #include <mlpack/core/data/confusion_matrix.hpp>
 #include <mlpack/core/data/one_hot_encoding.hpp>
 
@@ -25,6 +25,36 @@
  */
 namespace cereal {
 
+/**
+ * Serialize a block of elements with a single bulk read/write, for archives
+ * that support raw binary data (the binary and portable binary archives).
+ * This avoids pushing every element through the archive one at a time, which
+ * dominates save/load time for large models.
+ */
+template<typename Archive, typename eT>
+typename std::enable_if<
+    traits::is_output_serializable<BinaryData<eT>, Archive>::value &&
+    traits::is_input_serializable<BinaryData<eT>, Archive>::value, void>::type
+serialize_block(Archive& ar, eT* mem, const size_t nElem,
+                const char* /* name */)
+{
+  ar(binary_data(mem, nElem * sizeof(eT)));
+}
+
+/**
+ * Serialize a block of elements one at a time, for text archives (XML/JSON)
+ * that cannot hold raw binary data.
+ */
+template<typename Archive, typename eT>
+typename std::enable_if<
+    !(traits::is_output_serializable<BinaryData<eT>, Archive>::value &&
+      traits::is_input_serializable<BinaryData<eT>, Archive>::value), void>::type
+serialize_block(Archive& ar, eT* mem, const size_t nElem, const char* name)
+{
+  for (size_t i = 0; i < nElem; ++i)
+    ar(cereal::make_nvp(name, mem[i]));
+}
+
 template<typename Archive, typename eT>
 void serialize(Archive& ar, arma::SpMat<eT>& mat)
 {
@@ -50,13 +80,13 @@ void serialize(Archive& ar, arma::SpMat<eT>& mat)
     // column pointers, if necessary, so we don't need to worry about them.
   }
 
-  // Serialize the values held in the sparse matrix.
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("value", arma::access::rw(mat.values[i])));
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("row_index", arma::access::rw(mat.row_indices[i])));
-  for (size_t i = 0; i < mat.n_cols + 1; ++i)
-    ar(cereal::make_nvp("col_ptr", arma::access::rw(mat.col_ptrs[i])));
+  // Serialize the values held in the sparse matrix; for binary archives each
+  // of these is a single bulk read/write.
+  serialize_block(ar, arma::access::rwp(mat.values), mat.n_nonzero, "value");
+  serialize_block(ar, arma::access::rwp(mat.row_indices), mat.n_nonzero,
+      "row_index");
+  serialize_block(ar, arma::access::rwp(mat.col_ptrs), mat.n_cols + 1,
+      "col_ptr");
 }
 
 // Add an external serialization function for Mat.
@@ -78,9 +108,9 @@ void serialize(Archive& ar, arma::Mat<eT>& mat)
     arma::access::rw(mat.vec_state) = vec_state;
   }
 
-  // Directly serialize the contents of the matrix's memory.
-  for (size_t i = 0; i < mat.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
+  // Directly serialize the contents of the matrix's memory; for binary
+  // archives the whole payload is one bulk read/write.
+  serialize_block(ar, arma::access::rwp(mat.mem), mat.n_elem, "elem");
 }
 
 // Add a serialization function for armadillo Cube
@@ -99,9 +129,9 @@ void serialize(Archive& ar, arma::Cube<eT>& cube)
   if (cereal::is_loading<Archive>())
     cube.set_size(n_rows, n_cols, n_slices);
 
-  // Directly serialize the contents of the cube's memory.
-  for (size_t i = 0; i < cube.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(cube.mem[i])));
+  // Directly serialize the contents of the cube's memory; for binary
+  // archives the whole payload is one bulk read/write.
+  serialize_block(ar, arma::access::rwp(cube.mem), cube.n_elem, "elem");
 }
 
 } // end namespace cereal
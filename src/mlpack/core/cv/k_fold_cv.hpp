@@ -180,6 +180,17 @@ class KFoldCV
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get the number of folds that Evaluate() runs (k by default).
+  size_t NumEvaluationFolds() const { return numEvaluationFolds; }
+  /**
+   * Modify the number of folds that Evaluate() runs.  Values less than k make
+   * Evaluate() report the average score over only the first folds, which can
+   * serve as a cheap partial-budget estimate of the full k-fold score (e.g.
+   * for early stopping in hyper-parameter search).  The value should be in
+   * the [1, k] range.
+   */
+  size_t& NumEvaluationFolds() { return numEvaluationFolds; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -225,6 +236,9 @@ class KFoldCV
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! The number of folds to run during Evaluate() (k unless reduced).
+  size_t numEvaluationFolds;
+
   /**
    * Assert the k parameter and data consistency and initialize fields required
    * for running k-fold cross-validation.
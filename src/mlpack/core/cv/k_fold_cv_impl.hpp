@@ -135,7 +135,8 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    numEvaluationFolds(k)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -166,7 +167,8 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    numEvaluationFolds(k)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -244,15 +246,30 @@ double KFoldCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
-
-  size_t numInvalidScores = 0;
-  for (size_t i = 0; i < k; ++i)
+  if (numEvaluationFolds < 1 || numEvaluationFolds > k)
+    throw std::invalid_argument(
+        "KFoldCV: the number of evaluation folds should be in the [1, k] "
+        "range");
+
+  const size_t folds = numEvaluationFolds;
+  arma::vec evaluations(folds);
+
+  // The folds are independent of each other (each gets its own model and its
+  // own alias views of the data), so they can be trained across threads.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) folds; ++i)
   {
     MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
         GetTrainingSubset(ys, i), args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
+    if (i == (omp_size_t) folds - 1)
+      modelPtr.reset(new MLAlgorithm(std::move(model)));
+  }
+
+  size_t numInvalidScores = 0;
+  for (size_t i = 0; i < folds; ++i)
+  {
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -260,11 +277,9 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
-  if (numInvalidScores == k)
+  if (numInvalidScores == folds)
   {
     Log::Warn << "KFoldCV::TrainAndEvaluate(): all folds returned invalid "
         << "scores!  Returning 0.0 as overall score." << std::endl;
@@ -286,9 +301,18 @@ double KFoldCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
-
-  for (size_t i = 0; i < k; ++i)
+  if (numEvaluationFolds < 1 || numEvaluationFolds > k)
+    throw std::invalid_argument(
+        "KFoldCV: the number of evaluation folds should be in the [1, k] "
+        "range");
+
+  const size_t folds = numEvaluationFolds;
+  arma::vec evaluations(folds);
+
+  // The folds are independent of each other (each gets its own model and its
+  // own alias views of the data), so they can be trained across threads.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) folds; ++i)
   {
     MLAlgorithm&& model = (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
@@ -297,7 +321,7 @@ double KFoldCV<MLAlgorithm,
             args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) folds - 1)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
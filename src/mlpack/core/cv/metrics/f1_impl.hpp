@@ -13,6 +13,7 @@
 #define MLPACK_CORE_CV_METRICS_F1_IMPL_HPP
 
 #include <mlpack/core/cv/metrics/accuracy.hpp>
+#include <mlpack/core/cv/metrics/facilities.hpp>
 
 namespace mlpack {
 namespace cv {
@@ -37,9 +38,15 @@ double F1<AS, PC>::Evaluate(MLAlgorithm& model,
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
 
-  size_t tp = arma::sum((labels == PC) % (predictedLabels == PC));
-  size_t numberOfPositivePredictions = arma::sum(predictedLabels == PC);
-  size_t numberOfPositiveClassInstances = arma::sum(labels == PC);
+  // One pass over the predictions collects all the counts at once.
+  const size_t numClasses = std::max<size_t>(PC, std::max(
+      arma::max(labels), arma::max(predictedLabels))) + 1;
+  const arma::Mat<size_t> counts = ConfusionCounts(labels, predictedLabels,
+      numClasses);
+
+  const size_t tp = counts(PC, PC);
+  const size_t numberOfPositivePredictions = arma::sum(counts.row(PC));
+  const size_t numberOfPositiveClassInstances = arma::sum(counts.col(PC));
 
   double precision = double(tp) / numberOfPositivePredictions;
   double recall = double(tp) / numberOfPositiveClassInstances;
@@ -76,15 +83,24 @@ double F1<AS, PC>::Evaluate(MLAlgorithm& model,
 
   size_t numClasses = arma::max(labels) + 1;
 
+  // One pass over the predictions collects the counts of every class; the
+  // per-class totals then reduce the count table instead of the
+  // predictions.  The table is sized to also fit any predicted class
+  // outside the label range, but only the label classes are averaged.
+  const size_t countClasses = std::max<size_t>(numClasses,
+      arma::max(predictedLabels) + 1);
+  const arma::Mat<size_t> counts = ConfusionCounts(labels, predictedLabels,
+      countClasses);
+
+  const arma::Col<size_t> diagonal(counts.diag());
+  const arma::Col<size_t> rowTotals = arma::sum(counts, 1);
+  const arma::Row<size_t> colTotals = arma::sum(counts, 0);
+
   arma::vec f1s = arma::vec(numClasses);
   for (size_t c = 0; c < numClasses; ++c)
   {
-    size_t tp = arma::sum((labels == c) % (predictedLabels == c));
-    size_t positivePredictions = arma::sum(predictedLabels == c);
-    size_t positiveLabels = arma::sum(labels == c);
-
-    double precision = double(tp) / positivePredictions;
-    double recall = double(tp) / positiveLabels;
+    double precision = double(diagonal(c)) / rowTotals(c);
+    double recall = double(diagonal(c)) / colTotals(c);
     f1s(c) = (precision + recall == 0.0) ? 0.0 :
         2.0 * precision * recall / (precision + recall);
   }
@@ -14,11 +14,35 @@
 #define MLPACK_CORE_CV_METRICS_FACILITIES_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/confusion_matrix.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 
 namespace mlpack {
 namespace cv {
 
+/**
+ * Confusion counts of the given predictions, built in a single pass.  The
+ * returned table is indexed by (predicted class, actual class), so its
+ * diagonal holds the per-class true positives, its row sums the per-class
+ * prediction totals, and its column sums the per-class label totals --
+ * everything the averaged classification metrics are built from, without a
+ * separate pass over the predictions for every class.
+ *
+ * @param labels Ground truth labels.
+ * @param predictedLabels Labels predicted by a model.
+ * @param numClasses Number of classes to count; it must be greater than
+ *     every label and every predicted label.
+ */
+inline arma::Mat<size_t> ConfusionCounts(
+    const arma::Row<size_t>& labels,
+    const arma::Row<size_t>& predictedLabels,
+    const size_t numClasses)
+{
+  arma::Mat<size_t> counts;
+  data::ConfusionMatrix(predictedLabels, labels, counts, numClasses);
+  return counts;
+}
+
 /**
   * Pairwise distance of the given data.
   *
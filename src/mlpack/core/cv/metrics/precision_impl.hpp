@@ -13,6 +13,7 @@
 #define MLPACK_CORE_CV_METRICS_PRECISION_IMPL_HPP
 
 #include <mlpack/core/cv/metrics/accuracy.hpp>
+#include <mlpack/core/cv/metrics/facilities.hpp>
 
 namespace mlpack {
 namespace cv {
@@ -37,8 +38,14 @@ double Precision<AS, PC>::Evaluate(MLAlgorithm& model,
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
 
-  size_t tp = arma::sum((labels == PC) % (predictedLabels == PC));
-  size_t numberOfPositivePredictions = arma::sum(predictedLabels == PC);
+  // One pass over the predictions collects all the counts at once.
+  const size_t numClasses = std::max<size_t>(PC, std::max(
+      arma::max(labels), arma::max(predictedLabels))) + 1;
+  const arma::Mat<size_t> counts = ConfusionCounts(labels, predictedLabels,
+      numClasses);
+
+  const size_t tp = counts(PC, PC);
+  const size_t numberOfPositivePredictions = arma::sum(counts.row(PC));
 
   return double(tp) / numberOfPositivePredictions;
 }
@@ -70,15 +77,24 @@ double Precision<AS, PC>::Evaluate(MLAlgorithm& model,
 
   size_t numClasses = arma::max(labels) + 1;
 
-  arma::vec precisions = arma::vec(numClasses);
-  for (size_t c = 0; c < numClasses; ++c)
-  {
-    size_t tp = arma::sum((labels == c) % (predictedLabels == c));
-    size_t numberOfPositivePredictions = arma::sum(predictedLabels == c);
-    precisions(c) = double(tp) / numberOfPositivePredictions;
-  }
+  // One pass over the predictions collects the counts of every class; the
+  // per-class totals then reduce the count table instead of the
+  // predictions.  The table is sized to also fit any predicted class
+  // outside the label range, but only the label classes are averaged.
+  const size_t countClasses = std::max<size_t>(numClasses,
+      arma::max(predictedLabels) + 1);
+  const arma::Mat<size_t> counts = ConfusionCounts(labels, predictedLabels,
+      countClasses);
+
+  const arma::Col<size_t> diagonal(counts.diag());
+  const arma::Col<size_t> rowTotals = arma::sum(counts, 1);
+
+  const arma::vec tp = arma::conv_to<arma::vec>::from(
+      diagonal.head(numClasses));
+  const arma::vec positivePredictions = arma::conv_to<arma::vec>::from(
+      rowTotals.head(numClasses));
 
-  return arma::mean(precisions);
+  return arma::mean(tp / positivePredictions);
 }
 
 } // namespace cv
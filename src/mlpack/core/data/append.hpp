@@ -0,0 +1,74 @@
+/**
+ * @file core/data/append.hpp
+ * @author Jianxin Zhang
+ *
+ * Append columns to a matrix already saved on disk.  For datasets that grow
+ * continuously (e.g. logged feature vectors), rewriting the whole file with
+ * Save() makes every checkpoint cost O(total); Append() updates the header
+ * and writes only the new columns, so a checkpoint costs O(delta).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_APPEND_HPP
+#define MLPACK_CORE_DATA_APPEND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <mlpack/core/arma_extend/arma_extend.hpp> // Includes Armadillo.
+#include <string>
+
+#include "format.hpp"
+#include "detect_file_type.hpp"
+#include "mlpack_binary.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Appends the columns of the given matrix to a matrix already stored in the
+ * given file, without rewriting the existing data.  If the file does not
+ * exist yet, it is created as a regular save.  Only the binary formats
+ * support appending:
+ *
+ *  - Raw binary (raw_binary), denoted by .bin
+ *  - Armadillo binary (arma_binary), denoted by .bin
+ *  - mlpack binary (MLPACKBN), denoted by .mlbin
+ *
+ * The matrix is written in its stored (column-major) orientation---no
+ * transposition is performed---so each appended column is one new point, and
+ * the number of rows of `matrix` must match the number of rows already in the
+ * file.  Note that this is the opposite of Save()'s default behavior; a file
+ * built with Append() should be loaded with `transpose = false` (or with
+ * MmapLoad() or StreamingDataset, which use the stored orientation too).
+ *
+ * A raw binary file has no header at all, so no dimension checking is
+ * possible for that format and the new bytes are simply appended.  A
+ * compressed mlpack binary file cannot be appended to, since the payload
+ * encoding is not seekable; save such files uncompressed if they will grow.
+ *
+ * If the 'fatal' parameter is set to true, a std::runtime_error exception
+ * will be thrown upon failure.
+ *
+ * @param filename Name of file to append to.
+ * @param matrix Matrix holding the columns to append.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param inputAppendType File type to append as (defaults to
+ *     FileType::AutoDetect).
+ * @return Boolean value indicating success or failure of the append.
+ */
+template<typename eT>
+bool Append(const std::string& filename,
+            const arma::Mat<eT>& matrix,
+            const bool fatal = false,
+            FileType inputAppendType = FileType::AutoDetect);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "append_impl.hpp"
+
+#endif
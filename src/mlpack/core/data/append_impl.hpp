@@ -0,0 +1,329 @@
+/**
+ * @file core/data/append_impl.hpp
+ * @author Jianxin Zhang
+ *
+ * Implementation of append functionality.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_APPEND_IMPL_HPP
+#define MLPACK_CORE_DATA_APPEND_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "append.hpp"
+#include "save.hpp"
+
+namespace mlpack {
+namespace data {
+
+//! The width the dimension line of an Armadillo binary header is padded to
+//! when we write one; see WriteArmaBinaryPadded().
+const size_t ArmaBinaryDimsLineWidth = 24;
+
+/**
+ * Write the given matrix to the given stream in Armadillo binary format, with
+ * the dimension line left-padded with spaces to a fixed width.  Armadillo's
+ * loader skips leading whitespace, so the padding is invisible to it, but it
+ * leaves room for the column count to grow so that later calls to Append()
+ * can update the header in place instead of shifting the whole payload.
+ */
+template<typename eT>
+bool WriteArmaBinaryPadded(std::fstream& stream, const arma::Mat<eT>& matrix)
+{
+  std::ostringstream dims;
+  dims << matrix.n_rows << ' ' << matrix.n_cols;
+  std::string dimsLine = dims.str();
+  if (dimsLine.size() < ArmaBinaryDimsLineWidth)
+    dimsLine.insert(0, ArmaBinaryDimsLineWidth - dimsLine.size(), ' ');
+
+  stream << arma::diskio::gen_bin_header(matrix) << '\n';
+  stream << dimsLine << '\n';
+  stream.write(reinterpret_cast<const char*>(matrix.memptr()),
+      matrix.n_elem * sizeof(eT));
+
+  return stream.good();
+}
+
+/**
+ * Append the columns of the given matrix to an existing Armadillo binary
+ * file.  The stream must be positioned at the start of the file.  When the
+ * updated dimension line fits in the bytes of the old one (always true for
+ * files written by Append() itself), only the header bytes and the new
+ * columns are written; otherwise the payload must be shifted and the file is
+ * rewritten once, with padding so it does not happen again.
+ */
+template<typename eT>
+bool AppendArmaBinary(std::fstream& stream,
+                      const std::string& filename,
+                      const arma::Mat<eT>& matrix)
+{
+  std::string header;
+  std::getline(stream, header);
+  if (header != arma::diskio::gen_bin_header(matrix))
+  {
+    Log::Warn << "File '" << filename << "' does not hold Armadillo binary "
+        << "data with the requested element type!" << std::endl;
+    return false;
+  }
+
+  const std::streampos dimsPos = stream.tellg();
+  std::string dimsLine;
+  std::getline(stream, dimsLine);
+  const std::streampos payloadPos = stream.tellg();
+
+  arma::uword rows = 0, cols = 0;
+  std::stringstream dims(dimsLine);
+  dims >> rows >> cols;
+  if (dims.fail())
+  {
+    Log::Warn << "Cannot parse dimensions of Armadillo binary file '"
+        << filename << "'!" << std::endl;
+    return false;
+  }
+
+  if (rows != matrix.n_rows)
+  {
+    Log::Warn << "Matrix to append has " << matrix.n_rows << " rows, but '"
+        << filename << "' holds " << rows << "-dimensional points!"
+        << std::endl;
+    return false;
+  }
+
+  std::ostringstream newDims;
+  newDims << rows << ' ' << (cols + matrix.n_cols);
+
+  if (newDims.str().size() <= dimsLine.size())
+  {
+    // The new dimension line fits in the bytes of the old one, so the payload
+    // does not move: left-pad with spaces (which the loader skips), rewrite
+    // the line, and append the new columns at the end.
+    std::string padded = newDims.str();
+    padded.insert(0, dimsLine.size() - padded.size(), ' ');
+
+    stream.seekp(dimsPos);
+    stream.write(padded.c_str(), padded.size());
+    stream.seekp(0, std::ios::end);
+    stream.write(reinterpret_cast<const char*>(matrix.memptr()),
+        matrix.n_elem * sizeof(eT));
+
+    return stream.good();
+  }
+
+  // The header must grow, so the payload has to shift: read the old columns
+  // back and rewrite the file once, padded so future appends are in-place.
+  arma::Mat<eT> old(rows, cols);
+  stream.clear();
+  stream.seekg(payloadPos);
+  stream.read(reinterpret_cast<char*>(old.memptr()),
+      old.n_elem * sizeof(eT));
+  if (!stream.good())
+  {
+    Log::Warn << "Armadillo binary file '" << filename << "' is truncated!"
+        << std::endl;
+    return false;
+  }
+  stream.close();
+
+  stream.open(filename.c_str(),
+      std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (!stream.is_open())
+    return false;
+
+  return WriteArmaBinaryPadded(stream, arma::Mat<eT>(
+      arma::join_rows(old, matrix)));
+}
+
+/**
+ * Append the columns of the given matrix to an existing mlpack binary file.
+ * The stream must be positioned at the start of the file.  The new columns
+ * are written after the existing payload and the column and payload byte
+ * counts in the header are updated in place.
+ */
+template<typename eT>
+bool AppendMlpackBinary(std::fstream& stream,
+                        const std::string& filename,
+                        const arma::Mat<eT>& matrix)
+{
+  MlpackBinaryHeader header;
+  stream.read(reinterpret_cast<char*>(&header), sizeof(MlpackBinaryHeader));
+  if (!stream.good() ||
+      memcmp(header.magic, MlpackBinaryMagic, sizeof(MlpackBinaryMagic)) != 0)
+  {
+    Log::Warn << "File '" << filename << "' does not begin with a valid "
+        << "mlpack binary header!" << std::endl;
+    return false;
+  }
+
+  if (header.version != 1)
+  {
+    Log::Warn << "Unknown mlpack binary format version " << header.version
+        << "!" << std::endl;
+    return false;
+  }
+
+  if (header.elemType != MlpackBinaryElementCode<eT>())
+  {
+    Log::Warn << "mlpack binary file holds element type code "
+        << header.elemType << ", but type code " << MlpackBinaryElementCode<eT>()
+        << " was requested!" << std::endl;
+    return false;
+  }
+
+  if ((header.flags & 0xFF) != MLPACK_BINARY_RAW)
+  {
+    Log::Warn << "Cannot append to a compressed mlpack binary file; save it "
+        << "uncompressed if it will grow!" << std::endl;
+    return false;
+  }
+
+  if (header.rows != matrix.n_rows)
+  {
+    Log::Warn << "Matrix to append has " << matrix.n_rows << " rows, but '"
+        << filename << "' holds " << header.rows << "-dimensional points!"
+        << std::endl;
+    return false;
+  }
+
+  // Write the new columns after the existing payload, then update the counts
+  // in the header.
+  stream.seekp(header.payloadOffset + header.payloadBytes);
+  stream.write(reinterpret_cast<const char*>(matrix.memptr()),
+      matrix.n_elem * sizeof(eT));
+  if (!stream.good())
+    return false;
+
+  header.cols += matrix.n_cols;
+  header.payloadBytes += matrix.n_elem * sizeof(eT);
+  stream.seekp(0);
+  stream.write(reinterpret_cast<const char*>(&header),
+      sizeof(MlpackBinaryHeader));
+
+  return stream.good();
+}
+
+template<typename eT>
+bool Append(const std::string& filename,
+            const arma::Mat<eT>& matrix,
+            const bool fatal,
+            FileType inputAppendType)
+{
+  Timer::Start("saving_data");
+
+  // Try to open the existing file for update.  If it does not exist yet, the
+  // append degenerates to a fresh save in the stored orientation.
+  std::fstream stream;
+  stream.open(filename.c_str(),
+      std::fstream::in | std::fstream::out | std::fstream::binary);
+  if (!stream.is_open())
+  {
+    FileType appendType = inputAppendType;
+    if (appendType == FileType::AutoDetect)
+      appendType = DetectFromExtension(filename);
+
+    if (appendType != FileType::RawBinary &&
+        appendType != FileType::ArmaBinary &&
+        appendType != FileType::MlpackBinary)
+    {
+      Timer::Stop("saving_data");
+      if (fatal)
+        Log::Fatal << "Appending to '" << filename << "' is only supported "
+            << "for binary formats (.bin, .mlbin).  Append failed."
+            << std::endl;
+      else
+        Log::Warn << "Appending to '" << filename << "' is only supported "
+            << "for binary formats (.bin, .mlbin); append failed."
+            << std::endl;
+
+      return false;
+    }
+
+    Timer::Stop("saving_data");
+    if (appendType == FileType::ArmaBinary)
+    {
+      // Write the file ourselves, so the header is padded and the next append
+      // can update it in place.
+      stream.open(filename.c_str(),
+          std::fstream::out | std::fstream::binary);
+      const bool success = stream.is_open() &&
+          WriteArmaBinaryPadded(stream, matrix);
+      if (!success)
+      {
+        if (fatal)
+          Log::Fatal << "Append to '" << filename << "' failed." << std::endl;
+        else
+          Log::Warn << "Append to '" << filename << "' failed." << std::endl;
+      }
+      return success;
+    }
+
+    return Save(filename, matrix, fatal, false /* no transpose */,
+        appendType);
+  }
+
+  FileType appendType = inputAppendType;
+  if (appendType == FileType::AutoDetect)
+  {
+    appendType = AutoDetect(stream, filename);
+    stream.clear();
+    stream.seekg(0);
+  }
+
+  Log::Info << "Appending to " << GetStringType(appendType) << " in '"
+      << filename << "'." << std::endl;
+
+  bool success;
+  if (appendType == FileType::RawBinary)
+  {
+    // A raw binary file has no header, so there is no dimensionality to check
+    // or update; the new columns are simply appended.
+    Log::Warn << "Appending raw binary data to '" << filename << "'; "
+        << "dimensionality cannot be checked." << std::endl;
+    stream.seekp(0, std::ios::end);
+    stream.write(reinterpret_cast<const char*>(matrix.memptr()),
+        matrix.n_elem * sizeof(eT));
+    success = stream.good();
+  }
+  else if (appendType == FileType::ArmaBinary)
+  {
+    success = AppendArmaBinary(stream, filename, matrix);
+  }
+  else if (appendType == FileType::MlpackBinary)
+  {
+    success = AppendMlpackBinary(stream, filename, matrix);
+  }
+  else
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Appending to '" << filename << "' is only supported for "
+          << "binary formats (.bin, .mlbin).  Append failed." << std::endl;
+    else
+      Log::Warn << "Appending to '" << filename << "' is only supported for "
+          << "binary formats (.bin, .mlbin); append failed." << std::endl;
+
+    return false;
+  }
+
+  if (!success)
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Append to '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Append to '" << filename << "' failed." << std::endl;
+
+    return false;
+  }
+
+  Timer::Stop("saving_data");
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -33,6 +33,10 @@ namespace data {
  * Binarize<double>(input, output, threshold);
  * @endcode
  *
+ * If the binarization is one step of a longer elementwise preprocessing
+ * chain, the steps can be fused into a single pass over the matrix with
+ * TransformPipeline (see transform_pipeline.hpp).
+ *
  * @param input Input matrix to Binarize.
  * @param output Matrix you want to save binarized data into.
  * @param threshold Threshold can by any number.
@@ -53,10 +53,24 @@ void ConfusionMatrix(const arma::Row<size_t> predictors,
                      const size_t numClasses)
 {
   // Loop over the actual labels and predicted labels and add the count.
+  // Each thread accumulates into its own count table; the tables are summed
+  // once after the loop.
   output = arma::zeros<arma::Mat<eT> >(numClasses, numClasses);
-  for (size_t i = 0; i < predictors.n_elem; ++i)
+
+  #pragma omp parallel
   {
-    output.at(predictors[i], responses[i])++;
+    arma::Mat<eT> localOutput(numClasses, numClasses, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) predictors.n_elem; ++i)
+    {
+      localOutput.at(predictors[i], responses[i])++;
+    }
+
+    #pragma omp critical
+    {
+      output += localOutput;
+    }
   }
 }
 
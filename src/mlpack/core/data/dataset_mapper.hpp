@@ -148,13 +148,15 @@ class DatasetMapper
   size_t Dimensionality() const;
 
   /**
-   * Serialize the dataset information.
+   * Serialize the dataset information, including the policy state, so a
+   * mapper can be saved standalone and later re-used to seed another load.
    */
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
   {
     ar(CEREAL_NVP(types));
     ar(CEREAL_NVP(maps));
+    ar(CEREAL_NVP(policy));
   }
 
   //! Return the policy of the mapper.
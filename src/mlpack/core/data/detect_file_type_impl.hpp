@@ -35,6 +35,7 @@ inline std::string GetStringType(const FileType& type)
     case FileType::ArmaBinary:  return "Armadillo binary formatted data";
     case FileType::PGMBinary:   return "PGM data";
     case FileType::HDF5Binary:  return "HDF5 data";
+    case FileType::MlpackBinary: return "mlpack binary formatted data";
     default:                    return "";
   }
 }
@@ -259,11 +260,12 @@ inline FileType AutoDetect(std::fstream& stream, const std::string& filename)
         detectedLoadType = FileType::FileTypeUnknown;
     }
   }
-  else if (extension == "bin")
+  else if (extension == "bin" || extension == "mlbin")
   {
-    // This could be raw binary or Armadillo binary (binary with header).  We
-    // will check to see if it is Armadillo binary.
+    // This could be raw binary, Armadillo binary, or mlpack binary (the
+    // latter two have identifying headers).  We will check the headers.
     const std::string ARMA_MAT_BIN = "ARMA_MAT_BIN";
+    const std::string MLPACK_BIN = "MLPACKBN";
     std::string rawHeader(ARMA_MAT_BIN.length(), '\0');
 
     std::streampos pos = stream.tellg();
@@ -272,10 +274,18 @@ inline FileType AutoDetect(std::fstream& stream, const std::string& filename)
     stream.clear();
     stream.seekg(pos); // Reset stream position after peeking.
 
-    if (rawHeader == ARMA_MAT_BIN)
+    if (rawHeader.compare(0, MLPACK_BIN.length(), MLPACK_BIN) == 0)
+    {
+      detectedLoadType = FileType::MlpackBinary;
+    }
+    else if (rawHeader == ARMA_MAT_BIN)
     {
       detectedLoadType = FileType::ArmaBinary;
     }
+    else if (extension == "mlbin") // The header is mandatory for .mlbin.
+    {
+      detectedLoadType = FileType::FileTypeUnknown;
+    }
     else // We can only assume it's raw binary.
     {
       detectedLoadType = FileType::RawBinary;
@@ -320,6 +330,10 @@ inline FileType DetectFromExtension(const std::string& filename)
   {
     return FileType::ArmaBinary;
   }
+  else if (extension == "mlbin")
+  {
+    return FileType::MlpackBinary;
+  }
   else if (extension == "pgm")
   {
     return FileType::PGMBinary;
@@ -96,6 +96,90 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Begin a streaming imputation over the given dimensions.  Any statistics
+   * accumulated by a previous streaming pass are discarded.
+   *
+   * @param dimensions Dimensions whose statistics will be accumulated.
+   */
+  void Reset(const std::vector<size_t>& dimensions)
+  {
+    sums.clear();
+    counts.clear();
+    means.clear();
+
+    for (const size_t dimension : dimensions)
+    {
+      sums[dimension] = 0.0;
+      counts[dimension] = 0;
+    }
+  }
+
+  /**
+   * Accumulate the sum and count of one dimension over a batch of columns,
+   * excluding the mapped value and NaNs.  Reset() must have been called with
+   * this dimension first; distinct dimensions may be accumulated
+   * concurrently.
+   *
+   * @param batch Batch of columns to accumulate.
+   * @param mappedValue Value that the user wants to get rid of.
+   * @param dimension Index of the dimension of the mappedValue.
+   */
+  void Accumulate(const arma::Mat<T>& batch,
+                  const T& mappedValue,
+                  const size_t dimension)
+  {
+    double& sum = sums.at(dimension);
+    size_t& elems = counts.at(dimension);
+
+    for (size_t i = 0; i < batch.n_cols; ++i)
+    {
+      if (batch(dimension, i) == mappedValue ||
+          std::isnan(batch(dimension, i)))
+        continue;
+
+      elems++;
+      sum += batch(dimension, i);
+    }
+  }
+
+  /**
+   * Turn the accumulated sums and counts into the means handed out by
+   * Statistic().
+   */
+  void Finalize()
+  {
+    for (const auto& dimensionCount : counts)
+    {
+      if (dimensionCount.second == 0)
+      {
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in the dimension" << std::endl;
+      }
+
+      means[dimensionCount.first] =
+          sums.at(dimensionCount.first) / dimensionCount.second;
+    }
+  }
+
+  /**
+   * Return the imputation value (the mean) of the given dimension; only
+   * valid after Finalize() has been called.
+   *
+   * @param dimension Index of the dimension.
+   */
+  double Statistic(const size_t dimension) const
+  {
+    return means.at(dimension);
+  }
+
+ private:
+  // Streaming state: per-dimension running sums and counts of the valid
+  // elements, and the resulting means.
+  std::unordered_map<size_t, double> sums;
+  std::unordered_map<size_t, size_t> counts;
+  std::unordered_map<size_t, double> means;
 }; // class MeanImputation
 
 } // namespace data
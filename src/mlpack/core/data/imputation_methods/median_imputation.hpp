@@ -85,6 +85,81 @@ class MedianImputation
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Begin a streaming imputation over the given dimensions.  Any statistics
+   * accumulated by a previous streaming pass are discarded.
+   *
+   * @param dimensions Dimensions whose statistics will be accumulated.
+   */
+  void Reset(const std::vector<size_t>& dimensions)
+  {
+    keptElems.clear();
+    medians.clear();
+
+    for (const size_t dimension : dimensions)
+      keptElems[dimension] = std::vector<double>();
+  }
+
+  /**
+   * Accumulate the valid elements of one dimension over a batch of columns,
+   * excluding the mapped value and NaNs.  Reset() must have been called with
+   * this dimension first; distinct dimensions may be accumulated
+   * concurrently.  Note that the median, unlike the mean, cannot be computed
+   * from a constant-size summary, so the valid elements of each requested
+   * dimension are held in memory---one value per point, not the whole
+   * dataset.
+   *
+   * @param batch Batch of columns to accumulate.
+   * @param mappedValue Value that the user wants to get rid of.
+   * @param dimension Index of the dimension of the mappedValue.
+   */
+  void Accumulate(const arma::Mat<T>& batch,
+                  const T& mappedValue,
+                  const size_t dimension)
+  {
+    std::vector<double>& elemsToKeep = keptElems.at(dimension);
+
+    for (size_t i = 0; i < batch.n_cols; ++i)
+    {
+      if (batch(dimension, i) == mappedValue ||
+          std::isnan(batch(dimension, i)))
+        continue;
+
+      elemsToKeep.push_back(batch(dimension, i));
+    }
+  }
+
+  /**
+   * Turn the accumulated elements into the medians handed out by
+   * Statistic(), and release the accumulated elements.
+   */
+  void Finalize()
+  {
+    for (auto& dimensionElems : keptElems)
+    {
+      medians[dimensionElems.first] =
+          arma::median(arma::vec(dimensionElems.second));
+      dimensionElems.second.clear();
+    }
+  }
+
+  /**
+   * Return the imputation value (the median) of the given dimension; only
+   * valid after Finalize() has been called.
+   *
+   * @param dimension Index of the dimension.
+   */
+  double Statistic(const size_t dimension) const
+  {
+    return medians.at(dimension);
+  }
+
+ private:
+  // Streaming state: per-dimension valid elements seen so far, and the
+  // resulting medians.
+  std::unordered_map<size_t, std::vector<double>> keptElems;
+  std::unordered_map<size_t, double> medians;
 }; // class MedianImputation
 
 } // namespace data
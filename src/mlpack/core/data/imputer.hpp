@@ -17,6 +17,7 @@
 #include "dataset_mapper.hpp"
 #include "map_policies/missing_policy.hpp"
 #include "map_policies/increment_policy.hpp"
+#include "streaming_dataset.hpp"
 
 namespace mlpack {
 namespace data {
@@ -65,6 +66,76 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Impute the given dimensions of an on-disk dataset without ever loading it
+  * fully.  The dataset is swept twice: a statistics pass accumulates the
+  * imputation statistic of every requested dimension batch by batch, and an
+  * apply pass rewrites the batches in place with the missing entries
+  * replaced.  The per-batch work is distributed over the dimensions with
+  * OpenMP.  The streaming reader yields points as columns, so this overload
+  * always operates in column-major mode.
+  *
+  * The strategy must provide the streaming interface (Reset(),
+  * Accumulate(), Finalize() and Statistic()); MeanImputation and
+  * MedianImputation do.
+  *
+  * @param input Streaming dataset to impute in place.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation.
+  */
+  void Impute(StreamingDataset<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      mappedValues[i] = static_cast<T>(
+          mapper.UnmapValue(missingValue, dimensions[i]));
+    }
+
+    // Statistics pass: accumulate the statistic of every dimension.
+    strategy.Reset(dimensions);
+    input.Reset();
+    while (input.NextBatch())
+    {
+      const arma::Mat<T>& batch = input.Batch();
+
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t i = 0; i < (omp_size_t) dimensions.size(); ++i)
+        strategy.Accumulate(batch, mappedValues[i], dimensions[i]);
+    }
+    strategy.Finalize();
+
+    // Apply pass: rewrite each batch in place with the missing entries
+    // replaced.  Batches without missing entries are not written back.
+    arma::Mat<T> batch;
+    input.Reset();
+    while (input.NextBatch())
+    {
+      batch = input.Batch();
+      bool changed = false;
+
+      #pragma omp parallel for schedule(static) reduction(||: changed)
+      for (omp_size_t i = 0; i < (omp_size_t) dimensions.size(); ++i)
+      {
+        const T value = (T) strategy.Statistic(dimensions[i]);
+        for (size_t j = 0; j < batch.n_cols; ++j)
+        {
+          if (batch(dimensions[i], j) == mappedValues[i] ||
+              std::isnan(batch(dimensions[i], j)))
+          {
+            batch(dimensions[i], j) = value;
+            changed = true;
+          }
+        }
+      }
+
+      if (changed)
+        input.WriteBatch(batch);
+    }
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
@@ -25,6 +25,11 @@
 #include "load_csv.hpp"
 #include "load_arff.hpp"
 #include "load_image.hpp"
+#include "mlpack_binary.hpp"
+#include "mmap_load.hpp"
+#include "shared_dataset.hpp"
+#include "streaming_dataset.hpp"
+#include "skippable_section.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices and models. */ {
@@ -205,6 +210,13 @@ bool Load(const std::string& filename,
  * will be created.  If the given `info` has a different dimensionality of data
  * than what is present in `filename`, an exception will be thrown.
  *
+ * The re-use behavior allows the mapping dictionary to be cached across
+ * loads of files that share most of their category vocabulary: save the
+ * mapper with SaveMappings() (see save.hpp), seed the next load with
+ * LoadMappings(), and only categories not already in the cache pay the
+ * string-interning cost of creating a mapping (they are appended after the
+ * existing mappings, so cached mapped values stay stable).
+ *
  * @param filename Name of file to load.
  * @param matrix Matrix to load contents of file into.
  * @param info DatasetMapper object to populate with mappings and data types.
@@ -219,6 +231,24 @@ bool Load(const std::string& filename,
           const bool fatal = false,
           const bool transpose = true);
 
+/**
+ * Load a DatasetMapper that was previously saved with SaveMappings() (see
+ * save.hpp).  Passing the loaded mapper to a categorical data::Load() call
+ * seeds that load with the cached mappings: categories already in the cache
+ * keep their mapped values, and only new categories are appended.  The
+ * supported file types are the same as for model Load(): .json, .xml, and
+ * .bin.
+ *
+ * @param filename Name of the file to load the mappings from.
+ * @param info DatasetMapper object to load the mappings into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename PolicyType, typename InputType>
+bool LoadMappings(const std::string& filename,
+                  DatasetMapper<PolicyType, InputType>& info,
+                  const bool fatal = false);
+
 /**
  * Load a model from a file, guessing the filetype from the extension, or,
  * optionally, loading the specified format.  If automatic extension detection
@@ -243,19 +273,28 @@ bool Load(const std::string& filename,
  * If the parameter 'fatal' is set to true, then an exception will be thrown in
  * the event of load failure.  Otherwise, the method will return false and the
  * relevant error information will be printed to Log::Warn.
+ *
+ * If the parameter 'skipSections' is set to true, any members the model stores
+ * as skippable sections (see SerializeSection() in skippable_section.hpp) are
+ * consumed without being deserialized.  This cuts load time and memory for
+ * inference-only consumers; the loaded model predicts correctly but cannot
+ * have its training continued.
  */
 template<typename T>
 bool Load(const std::string& filename,
           const std::string& name,
           T& t,
           const bool fatal = false,
-          format f = format::autodetect);
+          format f = format::autodetect,
+          const bool skipSections = false);
 
 } // namespace data
 } // namespace mlpack
 
 // Include implementation of Load() for matrix.
 #include "load_impl.hpp"
+// Include LoadColumns(), the seek-based partial loader for binary formats.
+#include "partial_load.hpp"
 // Include implementation of model-loading Load() overload.
 #include "load_model_impl.hpp"
 // Include implementation of Load() for vectors.
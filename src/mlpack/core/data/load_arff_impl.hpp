@@ -17,6 +17,8 @@
 #include "string_algorithms.hpp"
 #include "is_naninf.hpp"
 
+#include <unordered_map>
+
 namespace mlpack {
 namespace data {
 
@@ -171,120 +173,235 @@ void LoadARFF(const std::string& filename,
     }
   }
 
-  // We need to find out how many lines of data are in the file.
-  std::streampos pos = ifs.tellg();
-  size_t row = 0;
-  while (ifs.good())
-  {
-    std::getline(ifs, line, '\n');
-    ++row;
-  }
-  // Uncount the EOF row.
-  --row;
-
-  // Since we've hit the EOF, we have to call clear() so we can seek again.
+  // Pull the rest of the file (the @data section) into memory in one read, so
+  // that the hot parsing loop can tokenize raw character ranges in place and
+  // the lines can be split across threads.
+  const std::streampos pos = ifs.tellg();
+  ifs.seekg(0, std::ios::end);
+  const size_t bufferSize = (size_t) (ifs.tellg() - pos);
   ifs.clear();
   ifs.seekg(pos);
 
+  std::string buffer(bufferSize, '\0');
+  ifs.read(&buffer[0], bufferSize);
+
+  // Index the start of each line; line i of the @data section is column i of
+  // the (transposed) output matrix.
+  std::vector<size_t> lineStarts;
+  size_t bufPos = 0;
+  while (bufPos < buffer.size())
+  {
+    lineStarts.push_back(bufPos);
+    const size_t newline = buffer.find('\n', bufPos);
+    if (newline == std::string::npos)
+      break;
+    bufPos = newline + 1;
+  }
+
   // Now, set the size of the matrix.
-  matrix.set_size(dimensionality, row);
+  matrix.set_size(dimensionality, lineStarts.size());
+
+  // The parallel parse needs read-only category lookups, so it can only be
+  // used when every categorical dimension declared its categories in the
+  // header; a 'string' attribute maps values in encounter order, which is
+  // inherently sequential.  When that requirement is not met, the loop below
+  // still runs, just on a single thread.
+  bool allCategoriesKnown = true;
+  for (size_t i = 0; i < types.size(); ++i)
+    if (types[i] && categoryStrings.count(i) == 0)
+      allCategoriesKnown = false;
 
-  // Now we are looking at the @data section.
-  row = 0;
-  while (ifs.good())
+  // Build read-only lookup tables for the pre-specified categories; the
+  // header registration above has already assigned their mappings.
+  std::map<size_t, std::unordered_map<std::string, eT>> categoryLookups;
+  if (allCategoriesKnown)
   {
-    std::getline(ifs, line, '\n');
-    Trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
-
-    // Tokenize the line.
-    std::vector<std::string> tok = Tokenize(line, ',', '"');
-
-    size_t col = 0;
-    std::stringstream token;
-    for (std::vector<std::string>::iterator it = tok.begin(); it != tok.end(); ++it)
+    for (const auto& dimCategories : categoryStrings)
     {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
-      {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
-      }
+      std::unordered_map<std::string, eT>& lookup =
+          categoryLookups[dimCategories.first];
+      for (const std::string& str : dimCategories.second)
+        lookup[str] = info.template MapString<eT>(str, dimCategories.first);
+    }
+  }
 
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
+  // Exceptions cannot leave the parallel region, so parse errors are
+  // collected and the one on the lowest line is rethrown afterwards.
+  size_t errorRow = std::numeric_limits<size_t>::max();
+  std::string errorMessage;
+
+  #pragma omp parallel for if (allCategoriesKnown)
+  for (omp_size_t row = 0; row < (omp_size_t) lineStarts.size(); ++row)
+  {
+    // Find the extent of this line and strip whitespace from either side.
+    size_t start = lineStarts[row];
+    size_t end = buffer.find('\n', start);
+    if (end == std::string::npos)
+      end = buffer.size();
+    while (start < end && isspace(buffer[start]))
+      ++start;
+    while (end > start && isspace(buffer[end - 1]))
+      --end;
+
+    std::string error;
+    try
+    {
+      // Each line of the @data section must be a CSV (except sparse data,
+      // which we will handle later).  The '?' representing a missing value is
+      // not allowed, and any piece of data that does not match its type
+      // (categorical or numeric) is an error.
+      if (start < end && buffer[start] == '{')
+        throw std::runtime_error("cannot yet parse sparse ARFF data");
+
+      size_t col = 0;
+      size_t tokenStart = start;
+      bool inEscape = false;
+      for (size_t i = start; i <= end; ++i)
       {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        Trim(token);
-        const size_t currentNumMappings = info.NumMappings(col);
-        const eT result = info.template MapString<eT>(token, col);
-
-        // If the set of categories was pre-specified, then we must crash if
-        // this was not one of those categories.
-        if (categoryStrings.count(col) > 0 &&
-            currentNumMappings < info.NumMappings(col))
+        if (i < end && buffer[i] == '"')
         {
-          std::stringstream error;
-          error << "Parse error at line " << (headerLines + row) << " token "
-              << col << ": category \"" << token << "\" not in the set of known"
-              << " categories for this dimension (";
-          for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
-            error << "\"" << categoryStrings.at(col)[i] << "\", ";
-          error << "\"" << categoryStrings.at(col).back() << "\").";
-          throw std::runtime_error(error.str());
+          inEscape = !inEscape;
+          continue;
+        }
+        if (i < end && (buffer[i] != ',' || inEscape))
+          continue;
+        if (i == end && tokenStart == end)
+          break; // Empty line: no tokens at all.
+
+        // The token is [tokenStart, i); strip spaces before parsing.
+        size_t ts = tokenStart, te = i;
+        tokenStart = i + 1;
+        while (ts < te && isspace(buffer[ts]))
+          ++ts;
+        while (te > ts && isspace(buffer[te - 1]))
+          --te;
+
+        // Check that we are not too many columns in.
+        if (col >= matrix.n_rows)
+        {
+          std::stringstream err;
+          err << "Too many columns in line " << (headerLines + row) << ".";
+          throw std::runtime_error(err.str());
         }
 
-        // We load transposed.
-        matrix(col, row) = result;
-      }
-      else if (info.Type(col) == Datatype::numeric)
-      {
-        // Attempt to read as numeric.
-        token.clear();
-        token.str(*it);
-
-        eT val = eT(0);
-        token >> val;
+        // What should this token be?
+        if (info.Type(col) == Datatype::categorical)
+        {
+          std::string token(buffer, ts, te - ts);
 
-        if (token.fail())
+          if (allCategoriesKnown)
+          {
+            // Read-only lookup in the pre-built table, safe across threads.
+            const auto& lookup = categoryLookups.at(col);
+            const auto it = lookup.find(token);
+            if (it == lookup.end())
+            {
+              std::stringstream err;
+              err << "Parse error at line " << (headerLines + row)
+                  << " token " << col << ": category \"" << token
+                  << "\" not in the set of known categories for this "
+                  << "dimension (";
+              for (size_t c = 0; c < categoryStrings.at(col).size() - 1; ++c)
+                err << "\"" << categoryStrings.at(col)[c] << "\", ";
+              err << "\"" << categoryStrings.at(col).back() << "\").";
+              throw std::runtime_error(err.str());
+            }
+
+            matrix(col, row) = it->second; // We load transposed.
+          }
+          else
+          {
+            // Sequential mapping, in encounter order.
+            const size_t currentNumMappings = info.NumMappings(col);
+            const eT result = info.template MapString<eT>(token, col);
+
+            // If the set of categories was pre-specified for this dimension,
+            // then we must crash if this was not one of those categories.
+            if (categoryStrings.count(col) > 0 &&
+                currentNumMappings < info.NumMappings(col))
+            {
+              std::stringstream err;
+              err << "Parse error at line " << (headerLines + row)
+                  << " token " << col << ": category \"" << token
+                  << "\" not in the set of known categories for this "
+                  << "dimension (";
+              for (size_t c = 0; c < categoryStrings.at(col).size() - 1; ++c)
+                err << "\"" << categoryStrings.at(col)[c] << "\", ";
+              err << "\"" << categoryStrings.at(col).back() << "\").";
+              throw std::runtime_error(err.str());
+            }
+
+            matrix(col, row) = result;
+          }
+        }
+        else if (info.Type(col) == Datatype::numeric)
         {
-          // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
+          // NUL-terminate the token in place so it can be converted without
+          // building a string; the overwritten byte belongs to this line, so
+          // no other thread can touch it.
+          char saved = '\0';
+          if (te < buffer.size())
+          {
+            saved = buffer[te];
+            buffer[te] = '\0';
+          }
+          const char* tokenPtr = buffer.c_str() + ts;
+
+          char* endptr = nullptr;
+          eT val = (eT) std::strtod(tokenPtr, &endptr);
+
+          if (endptr == tokenPtr)
           {
-            // Okay, it's not NaN or inf.  If it's '?', we issue a specific
-            // error, otherwise we issue a general error.
-            std::stringstream error;
-            std::string tokenStr = token.str();
-            Trim(tokenStr);
-            if (tokenStr == "?")
-              error << "Missing values ('?') not supported, ";
-            else
-              error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
-                << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
+            // Check for NaN or inf.
+            std::string tokenStr(tokenPtr, te - ts);
+            if (!IsNaNInf(val, tokenStr))
+            {
+              // Okay, it's not NaN or inf.  If it's '?', we issue a specific
+              // error, otherwise we issue a general error.
+              std::stringstream err;
+              if (tokenStr == "?")
+                err << "Missing values ('?') not supported, ";
+              else
+                err << "Parse error ";
+              err << "at line " << (headerLines + row) << " token " << col
+                  << ": \"" << tokenStr << "\".";
+
+              if (te < buffer.size())
+                buffer[te] = saved;
+              throw std::runtime_error(err.str());
+            }
           }
+
+          if (te < buffer.size())
+            buffer[te] = saved;
+
+          // If we made it to here, we have a value.
+          matrix(col, row) = val; // We load transposed.
         }
 
-        // If we made it to here, we have a value.
-        matrix(col, row) = val; // We load transposed.
+        ++col;
       }
+    }
+    catch (std::exception& e)
+    {
+      error = e.what();
+    }
 
-      ++col;
+    if (!error.empty())
+    {
+      #pragma omp critical (LoadARFFError)
+      {
+        if ((size_t) row < errorRow)
+        {
+          errorRow = (size_t) row;
+          errorMessage = error;
+        }
+      }
     }
-    ++row;
   }
+
+  if (errorRow != std::numeric_limits<size_t>::max())
+    throw std::runtime_error(errorMessage);
 }
 
 } // namespace data
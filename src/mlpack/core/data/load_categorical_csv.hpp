@@ -17,6 +17,47 @@
 namespace mlpack{
 namespace data{
 
+/**
+ * Return true if the policy forces all tokens to be mapped (or if we cannot
+ * tell, for policies that do not expose the flag), in which case the
+ * single-pass parse cannot be used.
+ */
+template<typename PolicyType>
+inline bool PolicyForcesAllMappings(const PolicyType& /* policy */)
+{
+  return true;
+}
+
+inline bool PolicyForcesAllMappings(const IncrementPolicy& policy)
+{
+  return policy.ForceAllMappings();
+}
+
+/**
+ * Return true (and convert into `val`) only if the whole token parses as a
+ * finite number.  This matches the stringstream-extraction test used by
+ * IncrementPolicy to classify dimensions, unlike ConvertToken(), which is
+ * deliberately permissive (empty tokens, INF/NAN, trailing garbage).
+ */
+template<typename T>
+inline bool TokenIsNumeric(const char* token, T& val)
+{
+  if (*token == '\0')
+    return false;
+
+  char* endptr = nullptr;
+  const double parsed = std::strtod(token, &endptr);
+  if (endptr == token || *endptr != '\0')
+    return false;
+
+  // Reject "inf"/"nan" spellings, which stringstream extraction rejects too.
+  if (!std::isfinite(parsed))
+    return false;
+
+  val = T(parsed);
+  return true;
+}
+
 template<typename eT, typename PolicyType>
 void LoadCSV::LoadCategoricalCSV(arma::Mat<eT> &inout,
                                  DatasetMapper<PolicyType> &infoSet,
@@ -24,12 +65,173 @@ void LoadCSV::LoadCategoricalCSV(arma::Mat<eT> &inout,
 {
   CheckOpen();
 
-  if (transpose)
+  // For the default mapping policy (when mappings are not forced), the
+  // single-pass parse produces results identical to the two-pass parse but
+  // reads the file only once and avoids per-token string construction.
+  if (transpose && std::is_same<PolicyType, IncrementPolicy>::value &&
+      !PolicyForcesAllMappings(infoSet.Policy()))
+    SinglePassTransposeParse(inout, infoSet);
+  else if (transpose)
     TransposeParse(inout, infoSet);
   else
     NonTransposeParse(inout, infoSet);
 }
 
+template<typename T, typename PolicyType>
+void LoadCSV::SinglePassTransposeParse(arma::Mat<T>& inout,
+                                       DatasetMapper<PolicyType>& infoSet)
+{
+  // Reset to the start of the file.
+  inFile.clear();
+  inFile.seekg(0, std::ios::beg);
+
+  // Per-dimension parse state: interned tokens, the interned id of each
+  // column's token, the values of dimensions that are numeric so far, and
+  // whether the dimension is still numeric.
+  std::vector<TokenInternTable> interns;
+  std::vector<std::vector<size_t>> ids;
+  std::vector<std::vector<T>> values;
+  std::vector<bool> numericSoFar;
+
+  size_t rows = 0, cols = 0;
+  std::string line;
+  while (std::getline(inFile, line))
+  {
+    // Remove whitespaces from either side.
+    Trim(line);
+    if (line.size() == 0)
+      continue;
+
+    size_t dim = 0;
+    size_t pos = 0;
+    while (true)
+    {
+      size_t start = pos;
+      size_t end = line.find(delim, pos);
+      if (end == std::string::npos)
+        end = line.size();
+
+      // Merge quoted tokens that contain the delimiter, like the two-pass
+      // parse does: a token that starts with '"' extends until a chunk that
+      // ends with '"'.
+      if (line[start] == '"' && (end == start + 1 || line[end - 1] != '"'))
+      {
+        while (end < line.size())
+        {
+          size_t next = line.find(delim, end + 1);
+          if (next == std::string::npos)
+            next = line.size();
+          end = next;
+          if (line[end - 1] == '"')
+            break;
+        }
+      }
+
+      pos = (end < line.size()) ? end + 1 : std::string::npos;
+
+      // Remove whitespace from either side of the token.
+      size_t tokenEnd = end;
+      while (start < tokenEnd && isspace(line[start]))
+        ++start;
+      while (tokenEnd > start && isspace(line[tokenEnd - 1]))
+        --tokenEnd;
+
+      // On the first line, each token opens a new dimension; afterwards, a
+      // surplus token is a dimension mismatch.
+      if (cols == 0)
+      {
+        interns.emplace_back();
+        ids.emplace_back();
+        values.emplace_back();
+        numericSoFar.push_back(true);
+        ++rows;
+      }
+      else if (dim >= rows)
+      {
+        ++dim; // Surplus token; the mismatch is reported below.
+        break;
+      }
+
+      // NUL-terminate the token in place so that it can be hashed and
+      // converted without constructing a std::string; the overwritten
+      // character is whitespace or the delimiter (or the terminator).
+      char saved = '\0';
+      if (tokenEnd < line.size())
+      {
+        saved = line[tokenEnd];
+        line[tokenEnd] = '\0';
+      }
+      const char* token = line.c_str() + start;
+
+      ids[dim].push_back(interns[dim].Intern(token, tokenEnd - start));
+
+      if (numericSoFar[dim])
+      {
+        T val = T(0);
+        if (TokenIsNumeric(token, val))
+          values[dim].push_back(val);
+        else
+          numericSoFar[dim] = false;
+      }
+
+      if (tokenEnd < line.size())
+        line[tokenEnd] = saved;
+
+      ++dim;
+      if (pos == std::string::npos)
+        break;
+    }
+
+    // Make sure we got the right number of rows.
+    if (dim != rows)
+    {
+      std::ostringstream oss;
+      oss << "LoadCSV::SinglePassTransposeParse(): wrong number of dimensions"
+          << " (" << dim << ") on line " << cols << "; should be " << rows
+          << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+
+    ++cols;
+  }
+
+  // Check the dimensionality against any existing DatasetMapper settings.
+  if (infoSet.Dimensionality() == 0)
+  {
+    infoSet.SetDimensionality(rows);
+  }
+  else if (infoSet.Dimensionality() != rows)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadCSV(): given DatasetInfo has dimensionality "
+        << infoSet.Dimensionality() << ", but data has dimensionality "
+        << rows;
+    throw std::invalid_argument(oss.str());
+  }
+
+  inout.set_size(rows, cols);
+
+  // Post-pass: numeric dimensions already hold their values; categorical
+  // dimensions are replayed through the mapper in column order, which assigns
+  // the same incrementing ids the two-pass parse would.
+  for (size_t dim = 0; dim < rows; ++dim)
+  {
+    if (numericSoFar[dim])
+    {
+      for (size_t col = 0; col < cols; ++col)
+        inout(dim, col) = values[dim][col];
+    }
+    else
+    {
+      for (size_t col = 0; col < cols; ++col)
+      {
+        inout(dim, col) = infoSet.template MapString<T>(
+            interns[dim].tokens[ids[dim][col]], dim);
+      }
+    }
+  }
+}
+
 inline void LoadCSV::CategoricalMatSize(
     std::stringstream& lineStream, size_t& col, const char delim)
 {
@@ -45,6 +45,8 @@
 #include <mlpack/core/util/log.hpp>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "string_algorithms.hpp"
 #include "extension.hpp"
@@ -114,6 +116,20 @@ class LoadCSV
   template<typename eT>
   bool LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f);
 
+  /**
+  * Parses a csv file in parallel, splitting it at line boundaries and
+  * converting each chunk of lines with a separate thread.  Each line of the
+  * file maps to one (pre-sized) row of the matrix, so the threads write to
+  * disjoint parts of the matrix and no synchronization of the output is
+  * needed.  This is used by LoadNumericCSV() for large files when OpenMP is
+  * enabled; the semantics are identical to the sequential parse.
+  *
+  * @param x Matrix in which data will be loaded; must already be sized.
+  * @param f File stream to access the data file.
+  */
+  template<typename eT>
+  bool LoadNumericCSVParallel(arma::Mat<eT>& x, std::fstream& f);
+
   /**
   * Converts the given string token to assigned datatype and assigns
   * this value to the given address. The address here will be a
@@ -128,6 +144,18 @@ class LoadCSV
   template<typename eT>
   bool ConvertToken(eT& val, const std::string& token);
 
+  /**
+  * Converts the given NUL-terminated token to the assigned datatype, exactly
+  * like the std::string overload, but without requiring a std::string to be
+  * constructed for the token.  This is the overload used by the single-pass
+  * categorical parse, which tokenizes the line buffer in place.
+  *
+  * @param val Token's value will be assigned to this address.
+  * @param token Value which should be assigned.
+  */
+  template<typename eT>
+  bool ConvertToken(eT& val, const char* token);
+
   /**
    * Calculate the number of columns in each row
    * and assign the value to the col. This function
@@ -297,6 +325,64 @@ class LoadCSV
   template<typename T, typename PolicyType>
   void TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet);
 
+  /**
+   * A per-dimension intern table for the single-pass categorical parse.  Each
+   * distinct token is stored once; lookups hash the raw character range of
+   * the token, so no std::string is constructed for tokens that have already
+   * been seen.
+   */
+  struct TokenInternTable
+  {
+    //! Map from token hash to the interned ids whose tokens have that hash.
+    std::unordered_map<uint64_t, std::vector<size_t>> buckets;
+    //! The distinct tokens, in order of first occurrence.
+    std::vector<std::string> tokens;
+
+    //! FNV-1a hash of a character range.
+    static uint64_t Hash(const char* token, const size_t length)
+    {
+      uint64_t hash = 14695981039346656037ULL;
+      for (size_t i = 0; i < length; ++i)
+      {
+        hash ^= (unsigned char) token[i];
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    //! Return the id of the given token, interning it if it is new.
+    size_t Intern(const char* token, const size_t length)
+    {
+      std::vector<size_t>& ids = buckets[Hash(token, length)];
+      for (size_t id : ids)
+      {
+        if (tokens[id].size() == length &&
+            tokens[id].compare(0, length, token, length) == 0)
+          return id;
+      }
+
+      // Not seen before; only now is a std::string constructed.
+      tokens.emplace_back(token, length);
+      ids.push_back(tokens.size() - 1);
+      return tokens.size() - 1;
+    }
+  };
+
+  /**
+  * Parse a transposed matrix in a single pass over the file.  Tokens are
+  * interned with TokenInternTable (hashing the raw token view), numeric
+  * values are converted as they are read, and dimensions that turn out to be
+  * categorical are remapped from the intern tables after the pass, giving
+  * results identical to the two-pass TransposeParse() for the default
+  * (IncrementPolicy) mapper.
+  *
+  * @param input Matrix to load into.
+  * @param infoSet DatasetMapper to load with.
+  */
+  template<typename T, typename PolicyType>
+  void SinglePassTransposeParse(arma::Mat<T>& inout,
+                                DatasetMapper<PolicyType>& infoSet);
+
   //! Extension (type) of file.
   std::string extension;
   //! Name of file.
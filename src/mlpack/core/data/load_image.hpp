@@ -62,6 +62,25 @@ bool Load(const std::vector<std::string>& files,
           ImageInfo& info,
           const bool fatal = false);
 
+/**
+ * Load a batch of image files into the columns of the given matrix, decoding
+ * the images across threads.  The first image fixes the dimensions of the
+ * batch; any subsequent image that decodes to different dimensions causes the
+ * load to fail.  Each thread decodes directly into its own columns of the
+ * destination matrix, so no full-batch intermediate is allocated.
+ *
+ * @param files A vector consisting of filenames.
+ * @param matrix Matrix to load the images into.
+ * @param info An object of ImageInfo class.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadImages(const std::vector<std::string>& files,
+                arma::Mat<eT>& matrix,
+                ImageInfo& info,
+                const bool fatal = false);
+
 // Implementation found in load_image.hpp.
 inline bool LoadImage(const std::string& filename,
                       arma::Mat<unsigned char>& matrix,
@@ -51,11 +51,21 @@ bool Load(const std::vector<std::string>& files,
           arma::Mat<eT>& matrix,
           ImageInfo& info,
           const bool fatal)
+{
+  return LoadImages(files, matrix, info, fatal);
+}
+
+// Batched image loading API; decodes across threads.
+template<typename eT>
+bool LoadImages(const std::vector<std::string>& files,
+                arma::Mat<eT>& matrix,
+                ImageInfo& info,
+                const bool fatal)
 {
   if (files.size() == 0)
   {
     std::ostringstream oss;
-    oss << "Load(): vector of image files is empty." << std::endl;
+    oss << "LoadImages(): vector of image files is empty." << std::endl;
 
     if (fatal)
       Log::Fatal << oss.str();
@@ -76,14 +86,54 @@ bool Load(const std::vector<std::string>& files,
       info.Width() * info.Height() * info.Channels(), files.size());
   tmpMatrix.col(0) = img;
 
-  for (size_t i = 1; i < files.size() ; ++i)
+  // Decode the remaining images in parallel, each directly into its own
+  // column of the batch.  Any failure (including a dimension mismatch) is
+  // collected into `status`; Log::Fatal cannot be used inside the parallel
+  // region since it throws, so the fatal report happens after the loop.
+  #pragma omp parallel for reduction(&&: status)
+  for (omp_size_t i = 1; i < (omp_size_t) files.size(); ++i)
   {
+    // Each thread uses its own ImageInfo, so the dimensions of a bad image
+    // can be detected instead of racing on the shared one.
+    ImageInfo localInfo = info;
     arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
         false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
 
-    if (!status)
-      return false;
+    bool localStatus = false;
+    try
+    {
+      localStatus = LoadImage(files[i], colImg, localInfo, false);
+    }
+    catch (std::logic_error&)
+    {
+      // A mis-sized image cannot be copied into the strict column alias;
+      // treat it as a failed load (the mismatch is reported below).
+    }
+
+    if (localStatus &&
+        (localInfo.Width() != info.Width() ||
+         localInfo.Height() != info.Height() ||
+         localInfo.Channels() != info.Channels()))
+    {
+      #pragma omp critical
+      Log::Warn << "LoadImages(): image '" << files[i] << "' has dimensions "
+          << localInfo.Width() << "x" << localInfo.Height() << "x"
+          << localInfo.Channels() << ", but the first image in the batch has "
+          << "dimensions " << info.Width() << "x" << info.Height() << "x"
+          << info.Channels() << "!" << std::endl;
+
+      localStatus = false;
+    }
+
+    status = status && localStatus;
+  }
+
+  if (!status)
+  {
+    if (fatal)
+      Log::Fatal << "LoadImages(): failed to load image batch." << std::endl;
+
+    return false;
   }
 
   matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
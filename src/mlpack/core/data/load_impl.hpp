@@ -166,6 +166,8 @@ bool Load(const std::string& filename,
   {
     if (loadType == FileType::CSVASCII)
       success = loader.LoadNumericCSV(matrix, stream);
+    else if (loadType == FileType::MlpackBinary)
+      success = LoadMlpackBinary(stream, matrix);
     else
       success = matrix.load(stream, ToArmaFileType(loadType));
   }
@@ -295,6 +297,15 @@ bool Load(const std::string& filename,
   return true;
 }
 
+// Load a cached DatasetMapper to seed a categorical load.
+template<typename PolicyType, typename InputType>
+bool LoadMappings(const std::string& filename,
+                  DatasetMapper<PolicyType, InputType>& info,
+                  const bool fatal)
+{
+  return Load(filename, "dataset_mapper", info, fatal);
+}
+
 // For loading data into sparse matrix
 template <typename eT>
 bool Load(const std::string& filename,
@@ -30,7 +30,8 @@ bool Load(const std::string& filename,
           const std::string& name,
           T& t,
           const bool fatal,
-          format f)
+          format f,
+          const bool skipSections)
 {
   if (f == format::autodetect)
   {
@@ -79,6 +80,9 @@ bool Load(const std::string& filename,
   }
   try
   {
+    // Skip any training-only sections if the caller only needs prediction.
+    SectionSkipGuard sectionGuard(skipSections);
+
     if (f == format::xml)
     {
       cereal::XMLInputArchive ar(ifs);
@@ -21,7 +21,14 @@ template<typename eT>
 bool LoadCSV::ConvertToken(eT& val,
                            const std::string& token)
 {
-  const size_t N = size_t(token.length());
+  return ConvertToken(val, token.c_str());
+}
+
+template<typename eT>
+bool LoadCSV::ConvertToken(eT& val,
+                           const char* token)
+{
+  const size_t N = strlen(token);
   // Fill empty data points with 0.
   if (N == 0)
   {
@@ -29,7 +36,7 @@ bool LoadCSV::ConvertToken(eT& val,
     return true;
   }
 
-  const char* str = token.c_str();
+  const char* str = token;
 
   // Checks for +/-INF and NAN
   // Converts them to their equivalent representation
@@ -99,6 +106,88 @@ bool LoadCSV::ConvertToken(eT& val,
   return true;
 }
 
+template<typename eT>
+bool LoadCSV::LoadNumericCSVParallel(arma::Mat<eT>& x, std::fstream& f)
+{
+  // Pull the remainder of the file into memory in one read, so that threads
+  // can parse disjoint ranges of lines without touching the stream.
+  const std::streampos start = f.tellg();
+  f.seekg(0, std::ios::end);
+  const size_t bufferSize = (size_t) (f.tellg() - start);
+  f.seekg(start);
+
+  std::string buffer(bufferSize, '\0');
+  f.read(&buffer[0], bufferSize);
+
+  // Record where each line starts; line i of the file is row i of the matrix,
+  // so each thread writes to rows no other thread touches.
+  std::vector<size_t> lineStarts;
+  lineStarts.reserve(x.n_rows);
+  size_t pos = 0;
+  while (lineStarts.size() < x.n_rows && pos < buffer.size())
+  {
+    // Stop at an empty line, like the sequential parse does.
+    if (buffer[pos] == '\n' || buffer[pos] == '\r')
+      break;
+
+    lineStarts.push_back(pos);
+    const size_t newline = buffer.find('\n', pos);
+    if (newline == std::string::npos)
+      break;
+    pos = newline + 1;
+  }
+
+  bool success = true;
+
+  #pragma omp parallel for reduction(&&: success)
+  for (omp_size_t row = 0; row < (omp_size_t) lineStarts.size(); ++row)
+  {
+    // Find the extent of this thread's line, trimming any trailing '\r'.
+    size_t lineEnd = buffer.find('\n', lineStarts[row]);
+    if (lineEnd == std::string::npos)
+      lineEnd = buffer.size();
+    while (lineEnd > lineStarts[row] && (buffer[lineEnd - 1] == '\r'))
+      --lineEnd;
+
+    // Convert each token of the line with this thread's own buffer.
+    std::string token;
+    size_t col = 0;
+    size_t tokenStart = lineStarts[row];
+    bool lineDone = false;
+    while (!lineDone && success)
+    {
+      size_t tokenEnd = buffer.find(',', tokenStart);
+      if (tokenEnd == std::string::npos || tokenEnd > lineEnd)
+      {
+        tokenEnd = lineEnd;
+        lineDone = true;
+      }
+
+      token.assign(buffer, tokenStart, tokenEnd - tokenStart);
+
+      eT tmpVal = eT(0);
+      if (ConvertToken<eT>(tmpVal, token))
+      {
+        x.at(row, col) = tmpVal;
+        ++col;
+      }
+      else
+      {
+        // Printing failed token and it's location.
+        #pragma omp critical
+        Log::Warn << "Failed to convert token " << token << ", at row " << row
+            << ", column " << col << " of matrix!";
+
+        success = false;
+      }
+
+      tokenStart = tokenEnd + 1;
+    }
+  }
+
+  return success;
+}
+
 template<typename eT>
 bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
 {
@@ -108,6 +197,22 @@ bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
   x.zeros(mat_size.first, mat_size.second);
   size_t row = 0;
 
+#ifdef HAS_OPENMP
+  // For large files, chunk the parse at line boundaries across threads; tiny
+  // files aren't worth the thread startup cost.
+  const size_t parallelThreshold = 1048576; // 1 MB.
+  if (loadOkay && omp_get_max_threads() > 1)
+  {
+    const std::streampos dataStart = f.tellg();
+    f.seekg(0, std::ios::end);
+    const size_t remaining = (size_t) (f.tellg() - dataStart);
+    f.seekg(dataStart);
+
+    if (remaining >= parallelThreshold)
+      return LoadNumericCSVParallel(x, f) && loadOkay;
+  }
+#endif
+
   std::string lineString;
   std::stringstream lineStream;
   std::string token;
@@ -142,6 +142,16 @@ class IncrementPolicy
     }
   }
 
+  //! Return whether or not all tokens are forced to be mapped.
+  bool ForceAllMappings() const { return forceAllMappings; }
+
+  //! Serialize the policy.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(forceAllMappings));
+  }
+
  private:
   // Whether or not we should map all tokens.
   bool forceAllMappings;
@@ -17,6 +17,7 @@
 #include <mlpack/core/data/map_policies/datatype.hpp>
 #include <limits>
 #include <set>
+#include <cereal/types/set.hpp>
 
 namespace mlpack {
 namespace data {
@@ -134,6 +135,13 @@ class MissingPolicy
     }
   }
 
+  //! Serialize the policy.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(missingSet));
+  }
+
  private:
   // Note that missingSet and maps are different.
   // missingSet specifies which value/string should be mapped and may be a
@@ -0,0 +1,124 @@
+/**
+ * @file core/data/mmap_load.hpp
+ * @author Jianxin Zhang
+ *
+ * Memory-mapped, zero-copy loading of numeric matrices from disk.  Instead of
+ * materializing the full dataset into a freshly-allocated arma::mat, the file
+ * is mapped into the process address space and an Armadillo matrix is built
+ * directly on top of the mapping, so load time is near-zero and residency is
+ * handled by the OS page cache.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MMAP_LOAD_HPP
+#define MLPACK_CORE_DATA_MMAP_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+#include <memory>
+
+#include "detect_file_type.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A matrix whose element storage is a memory-mapped, on-disk file instead of
+ * heap memory.  The mapping is established by Load() and torn down by Clear()
+ * or the destructor; the aliasing arma::Mat returned by Matrix() is built with
+ * Armadillo's advanced constructor (copy_aux_mem = false, strict = true), so
+ * no copy of the data is ever made.
+ *
+ * The mapping is copy-on-write (MAP_PRIVATE), so algorithms that modify matrix
+ * elements in place will work, but their writes will never reach the file.
+ * Because the matrix aliases the mapping, an MmapMatrix cannot be copied, and
+ * the matrix held by Matrix() must not outlive the MmapMatrix that owns it.
+ *
+ * Only the column-major binary formats can be mapped: Armadillo binary
+ * (FileType::ArmaBinary), whose header supplies the matrix dimensions, and raw
+ * binary (FileType::RawBinary), which---matching arma::raw_binary
+ * semantics---is loaded as a single column.  Note that no transposition can be
+ * performed at load time, so the file must already hold the data in the
+ * column-major (points-as-columns) layout that mlpack expects.
+ *
+ * @tparam eT Element type of the matrix to be mapped.
+ */
+template<typename eT>
+class MmapMatrix
+{
+ public:
+  //! Create an empty object; no mapping is established until Load().
+  MmapMatrix();
+
+  //! Unmap the file (if one is mapped).
+  ~MmapMatrix();
+
+  //! An MmapMatrix cannot be copied, since the matrix aliases the mapping.
+  MmapMatrix(const MmapMatrix&) = delete;
+  //! An MmapMatrix cannot be copied, since the matrix aliases the mapping.
+  MmapMatrix& operator=(const MmapMatrix&) = delete;
+
+  //! Take ownership of another MmapMatrix's mapping.
+  MmapMatrix(MmapMatrix&& other);
+  //! Take ownership of another MmapMatrix's mapping.
+  MmapMatrix& operator=(MmapMatrix&& other);
+
+  /**
+   * Map the given file and build the aliasing matrix.  Any existing mapping is
+   * released first.  On platforms without mmap() support (Windows), this falls
+   * back to a regular in-memory load.
+   *
+   * @param filename Name of the file to map.
+   * @param fatal If an error should be reported as fatal (default false).
+   * @param inputLoadType Type of the file (default auto-detect; only
+   *     FileType::ArmaBinary and FileType::RawBinary can be mapped).
+   * @return Boolean value indicating success or failure.
+   */
+  bool Load(const std::string& filename,
+            const bool fatal = false,
+            const FileType inputLoadType = FileType::AutoDetect);
+
+  //! Release the mapping and reset the matrix to an empty state.
+  void Clear();
+
+  //! Get the matrix backed by the mapping (empty if nothing is loaded).
+  const arma::Mat<eT>& Matrix() const { return *matrix; }
+  //! Modify the matrix backed by the mapping.  Writes are copy-on-write and
+  //! will not be reflected in the file.
+  arma::Mat<eT>& Matrix() { return *matrix; }
+
+ private:
+  //! The aliasing matrix; points at `mapping` once a file is loaded.
+  std::unique_ptr<arma::Mat<eT>> matrix;
+  //! Base address of the mapping (nullptr if nothing is mapped).
+  void* mapping;
+  //! Length of the mapping in bytes.
+  size_t mappedLength;
+};
+
+/**
+ * Map an on-disk column-major binary matrix directly into `matrix`, making no
+ * copy of the data.  This is a convenience wrapper for MmapMatrix::Load();
+ * see the documentation of MmapMatrix for the supported formats and aliasing
+ * caveats.
+ *
+ * @param filename Name of the file to map.
+ * @param matrix MmapMatrix to hold the mapping.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure.
+ */
+template<typename eT>
+bool MmapLoad(const std::string& filename,
+              MmapMatrix<eT>& matrix,
+              const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+#include "mmap_load_impl.hpp"
+
+#endif
@@ -0,0 +1,268 @@
+/**
+ * @file core/data/mmap_load_impl.hpp
+ * @author Jianxin Zhang
+ *
+ * Implementation of memory-mapped, zero-copy matrix loading.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MMAP_LOAD_IMPL_HPP
+#define MLPACK_CORE_DATA_MMAP_LOAD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mmap_load.hpp"
+#include "types.hpp"
+
+#include <fstream>
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+MmapMatrix<eT>::MmapMatrix() :
+    matrix(new arma::Mat<eT>()),
+    mapping(NULL),
+    mappedLength(0)
+{ /* Nothing to do. */ }
+
+template<typename eT>
+MmapMatrix<eT>::~MmapMatrix()
+{
+  Clear();
+}
+
+template<typename eT>
+MmapMatrix<eT>::MmapMatrix(MmapMatrix&& other) :
+    matrix(std::move(other.matrix)),
+    mapping(other.mapping),
+    mappedLength(other.mappedLength)
+{
+  other.matrix.reset(new arma::Mat<eT>());
+  other.mapping = NULL;
+  other.mappedLength = 0;
+}
+
+template<typename eT>
+MmapMatrix<eT>& MmapMatrix<eT>::operator=(MmapMatrix&& other)
+{
+  if (this != &other)
+  {
+    Clear();
+
+    matrix = std::move(other.matrix);
+    mapping = other.mapping;
+    mappedLength = other.mappedLength;
+
+    other.matrix.reset(new arma::Mat<eT>());
+    other.mapping = NULL;
+    other.mappedLength = 0;
+  }
+
+  return *this;
+}
+
+template<typename eT>
+void MmapMatrix<eT>::Clear()
+{
+  // The aliasing matrix must be destroyed before the mapping is released.
+  matrix.reset(new arma::Mat<eT>());
+
+#ifndef _WIN32
+  if (mapping != NULL)
+    munmap(mapping, mappedLength);
+#endif
+  mapping = NULL;
+  mappedLength = 0;
+}
+
+template<typename eT>
+bool MmapMatrix<eT>::Load(const std::string& filename,
+                          const bool fatal,
+                          const FileType inputLoadType)
+{
+  Timer::Start("loading_data");
+  Clear();
+
+  // Catch nonexistent files by opening the stream ourselves; the stream is
+  // also used to parse the Armadillo binary header, if there is one.
+  std::fstream stream;
+  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+  if (!stream.is_open())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  FileType loadType = inputLoadType;
+  if (inputLoadType == FileType::AutoDetect)
+    loadType = AutoDetect(stream, filename);
+
+  if (loadType != FileType::ArmaBinary && loadType != FileType::RawBinary)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot memory-map '" << filename << "': only "
+          << "column-major binary files (arma_binary or raw_binary) can be "
+          << "mapped." << std::endl;
+    else
+      Log::Warn << "Cannot memory-map '" << filename << "': only column-major "
+          << "binary files (arma_binary or raw_binary) can be mapped; load "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  // Find the size of the file, the extent of the element data within it, and
+  // the shape of the matrix.
+  stream.seekg(0, std::ios::end);
+  const size_t fileLength = (size_t) stream.tellg();
+  stream.seekg(0, std::ios::beg);
+
+  size_t dataOffset = 0;
+  arma::uword rows = 0, cols = 0;
+  if (loadType == FileType::ArmaBinary)
+  {
+    // The arma_binary header is two text lines: the format/element-type tag,
+    // then the matrix dimensions; the raw element data follows immediately.
+    std::string header;
+    std::getline(stream, header);
+
+    const std::string expected =
+        arma::diskio::gen_bin_header(arma::Mat<eT>());
+    if (header != expected)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << "Cannot memory-map '" << filename << "': arma_binary "
+            << "header '" << header << "' does not match the requested "
+            << "element type ('" << expected << "')." << std::endl;
+      else
+        Log::Warn << "Cannot memory-map '" << filename << "': arma_binary "
+            << "header '" << header << "' does not match the requested "
+            << "element type ('" << expected << "'); load failed."
+            << std::endl;
+
+      return false;
+    }
+
+    stream >> rows >> cols;
+    stream.get(); // Eat the newline that terminates the dimension line.
+    dataOffset = (size_t) stream.tellg();
+  }
+  else
+  {
+    // Raw binary has no header; as with arma::raw_binary, load the file as a
+    // single column.
+    rows = fileLength / sizeof(eT);
+    cols = 1;
+  }
+
+  if (dataOffset + rows * cols * sizeof(eT) > fileLength)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot memory-map '" << filename << "': file is too "
+          << "short to hold a " << rows << "x" << cols << " matrix."
+          << std::endl;
+    else
+      Log::Warn << "Cannot memory-map '" << filename << "': file is too "
+          << "short to hold a " << rows << "x" << cols << " matrix; load "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  stream.close();
+
+#ifndef _WIN32
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  // Map copy-on-write, so that in-place modification of the matrix works but
+  // never touches the file.
+  void* map = mmap(NULL, fileLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+      0);
+  // The mapping holds its own reference to the file.
+  close(fd);
+
+  if (map == MAP_FAILED)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot memory-map file '" << filename << "'."
+          << std::endl;
+    else
+      Log::Warn << "Cannot memory-map file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  mapping = map;
+  mappedLength = fileLength;
+
+  // Build the aliasing matrix on top of the mapping; no copy is made, and the
+  // matrix cannot be resized (strict = true).
+  eT* const data = reinterpret_cast<eT*>((char*) mapping + dataOffset);
+  matrix.reset(new arma::Mat<eT>(data, rows, cols, false, true));
+#else
+  // No mmap() on Windows; fall back to a regular in-memory load.
+  Log::Warn << "Memory mapping is not available on this platform; loading '"
+      << filename << "' into memory instead." << std::endl;
+  if (!matrix->load(filename, ToArmaFileType(loadType)))
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Loading from '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Loading from '" << filename << "' failed." << std::endl;
+
+    return false;
+  }
+#endif
+
+  Log::Info << "Mapped '" << filename << "' as a " << matrix->n_rows << "x"
+      << matrix->n_cols << " matrix." << std::endl;
+
+  Timer::Stop("loading_data");
+  return true;
+}
+
+template<typename eT>
+bool MmapLoad(const std::string& filename,
+              MmapMatrix<eT>& matrix,
+              const bool fatal)
+{
+  return matrix.Load(filename, fatal);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -47,6 +47,24 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     const arma::Col<size_t>& indices,
                     arma::Mat<eT>& output);
 
+/**
+ * Overloaded function for the above function, which produces a sparse
+ * output matrix.  One-hot encoding a dimension with many categories makes
+ * the dense output almost entirely zeros, so for high-cardinality data the
+ * sparse overload avoids an allocation proportional to the number of
+ * categories times the number of points.  The output is built with batch
+ * insertion, and the nonzero entries are gathered in parallel over the
+ * columns of the input when OpenMP is available.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output);
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
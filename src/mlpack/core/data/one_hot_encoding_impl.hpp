@@ -143,6 +143,101 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   }
 }
 
+/**
+ * Overloaded function for the above function, which produces a sparse
+ * output matrix.  The category mappings are computed the same way as in the
+ * dense overload; the nonzero entries are then gathered in parallel over the
+ * columns of the input and handed to the batch insertion constructor, so the
+ * dense output matrix is never materialized.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = arma::SpMat<eT>(input);
+    return;
+  }
+
+  // Compute the dimension offsets and category mappings exactly as in the
+  // dense overload.  The mapping pass is sequential, since the category
+  // indices depend on the order in which values are first seen.
+  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    dimensionOffsets[indices[i]] = 0;
+    mappings.insert(
+        std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
+  }
+
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (mappings.count(row) != 0)
+      {
+        // We have to one-hot encode this point.
+        if (mappings[row].count(input(row, col)) == 0)
+          mappings[row][input(row, col)] = dimensionOffsets[row]++;
+      }
+    }
+  }
+
+  // Turn the dimension counts into offsets.  Note that the last element is the
+  // total number of dimensions, and the first element is the offset for
+  // dimension *2* (not 1).
+  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
+    dimensionOffsets[i] += dimensionOffsets[i - 1];
+
+  // Every input element contributes exactly one candidate nonzero: either the
+  // one-hot indicator, or the passed-through value of a non-encoded
+  // dimension.  Each column of the input owns a disjoint block of the
+  // location and value arrays, so the gathering loop parallelizes cleanly.
+  // Only const lookups into `mappings` are performed here, which is safe
+  // across threads.
+  arma::umat locations(2, input.n_elem);
+  arma::Col<eT> values(input.n_elem);
+  const std::unordered_map<size_t, std::unordered_map<eT, size_t>>&
+      constMappings = mappings;
+
+  #pragma omp parallel for
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const size_t i = col * input.n_rows + row;
+      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
+      const auto it = constMappings.find(row);
+      if (it != constMappings.end())
+      {
+        locations(0, i) = dimOffset + it->second.at(input(row, col));
+        values[i] = eT(1);
+      }
+      else
+      {
+        // No need for one-hot encoding.
+        locations(0, i) = dimOffset;
+        values[i] = input(row, col);
+      }
+      locations(1, i) = col;
+    }
+  }
+
+  // Passed-through zeros should not become explicit nonzeros, so drop them
+  // before batch insertion.
+  const arma::uvec nonzeros = arma::find(values != eT(0));
+  output = arma::SpMat<eT>(locations.cols(nonzeros), values.elem(nonzeros),
+      dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
+}
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
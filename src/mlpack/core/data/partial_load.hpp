@@ -0,0 +1,103 @@
+/**
+ * @file core/data/partial_load.hpp
+ * @author Jianxin Zhang
+ *
+ * Load a subset of the columns of a matrix stored in a seekable binary
+ * format.  data::Load() is all-or-nothing: selecting 30 of 2000 dimensions
+ * for a feature-selection experiment still parses the whole file.  For the
+ * two binary formats whose payloads are raw column-major element data at a
+ * known offset — Armadillo binary and the mlpack binary format — the
+ * requested columns can instead be read by seeking directly to them, so I/O
+ * is proportional to the data actually wanted.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PARTIAL_LOAD_HPP
+#define MLPACK_CORE_DATA_PARTIAL_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load only the given on-disk columns of a matrix stored in Armadillo binary
+ * or mlpack binary format.  Each requested column is read with a seek to its
+ * exact byte offset in the payload; the rest of the file is never read, so
+ * the cost is proportional to the number of selected columns and not to the
+ * file size.  Runs of adjacent requested columns are coalesced into single
+ * reads.
+ *
+ * The column indices refer to the on-disk (untransposed) matrix.  Since
+ * data::Save() writes the transpose of an mlpack matrix by default, on-disk
+ * columns correspond to the dimensions (rows) of the matrix that was saved;
+ * with the default `transpose = true` the result is returned in mlpack's
+ * column-major convention, holding only those dimensions.  Column j of the
+ * on-disk result is on-disk column `columns[j]`, so the indices may be given
+ * in any order.
+ *
+ * Only Armadillo binary and mlpack binary files can be loaded this way; text
+ * formats have no fixed column stride to seek by, and run-length encoded
+ * mlpack binary payloads must be decoded from the start.  For those, load
+ * the full matrix with data::Load() and select columns afterwards.
+ *
+ * @param filename Name of the file to load.
+ * @param matrix Matrix to load the selected columns into.
+ * @param columns On-disk column indices to load, in output order.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, transpose the matrix after loading (default
+ *     true).
+ * @param inputLoadType Used to determine the type of file to load (default
+ *     FileType::AutoDetect).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadColumns(const std::string& filename,
+                 arma::Mat<eT>& matrix,
+                 const std::vector<size_t>& columns,
+                 const bool fatal = false,
+                 const bool transpose = true,
+                 const FileType inputLoadType = FileType::AutoDetect);
+
+/**
+ * Load only the contiguous on-disk column range [firstCol, lastCol] of a
+ * matrix stored in Armadillo binary or mlpack binary format.  The whole
+ * range is read with a single seek and a single bulk read.  See the
+ * index-list overload for the meaning of on-disk columns and the supported
+ * formats.
+ *
+ * @param filename Name of the file to load.
+ * @param matrix Matrix to load the selected columns into.
+ * @param firstCol First on-disk column of the range to load.
+ * @param lastCol Last on-disk column of the range to load (inclusive).
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, transpose the matrix after loading (default
+ *     true).
+ * @param inputLoadType Used to determine the type of file to load (default
+ *     FileType::AutoDetect).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadColumns(const std::string& filename,
+                 arma::Mat<eT>& matrix,
+                 const size_t firstCol,
+                 const size_t lastCol,
+                 const bool fatal = false,
+                 const bool transpose = true,
+                 const FileType inputLoadType = FileType::AutoDetect);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "partial_load_impl.hpp"
+
+#endif
@@ -0,0 +1,284 @@
+/**
+ * @file core/data/partial_load_impl.hpp
+ * @author Jianxin Zhang
+ *
+ * Implementation of the LoadColumns() functions defined in partial_load.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PARTIAL_LOAD_IMPL_HPP
+#define MLPACK_CORE_DATA_PARTIAL_LOAD_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "partial_load.hpp"
+
+// For inplace_transpose() and LoadMlpackBinaryColumns().
+#include "load.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <mlpack/core/util/timers.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Return the element type code that Armadillo's binary header stores for the
+ * given element type (e.g. "FN008" for double), or an empty string if the
+ * type has no code.
+ */
+template<typename eT>
+inline std::string ArmaBinaryElementCode()
+{
+  if (std::is_same<eT, double>::value)
+    return "FN008";
+  else if (std::is_same<eT, float>::value)
+    return "FN004";
+  else if (std::is_same<eT, int8_t>::value)
+    return "IS001";
+  else if (std::is_same<eT, uint8_t>::value)
+    return "IU001";
+  else if (std::is_same<eT, int16_t>::value)
+    return "IS002";
+  else if (std::is_same<eT, uint16_t>::value)
+    return "IU002";
+  else if (std::is_same<eT, int32_t>::value)
+    return "IS004";
+  else if (std::is_same<eT, uint32_t>::value)
+    return "IU004";
+  else if (std::is_same<eT, int64_t>::value ||
+      std::is_same<eT, long long>::value)
+    return "IS008";
+  else if (std::is_same<eT, uint64_t>::value ||
+      std::is_same<eT, unsigned long long>::value)
+    return "IU008";
+  else
+    return "";
+}
+
+/**
+ * Read only the given on-disk columns of a matrix in Armadillo binary
+ * format.  The format is a text header (the magic line with the element type
+ * code, then a "rows cols" line) followed by the raw column-major payload,
+ * so each requested column sits at a fixed offset that can be seeked to
+ * directly.  Runs of adjacent requested columns are coalesced into single
+ * reads.
+ *
+ * @param stream Stream to read from (must be opened for binary input).
+ * @param matrix Matrix to load the selected columns into.
+ * @param columns On-disk column indices to load, in output order.
+ * @return Boolean value indicating success or failure.
+ */
+template<typename eT>
+bool LoadArmaBinaryColumns(std::fstream& stream,
+                           arma::Mat<eT>& matrix,
+                           const std::vector<size_t>& columns)
+{
+  // The magic line identifies both the format and the element type.
+  std::string headerLine;
+  std::getline(stream, headerLine);
+  const std::string expectedHeader =
+      "ARMA_MAT_BIN_" + ArmaBinaryElementCode<eT>();
+  if (!stream.good() || headerLine != expectedHeader)
+  {
+    if (headerLine.compare(0, 13, "ARMA_MAT_BIN_") == 0)
+      Log::Warn << "Armadillo binary file holds element type '"
+          << headerLine.substr(13) << "', but element type '"
+          << ArmaBinaryElementCode<eT>() << "' was requested!" << std::endl;
+    else
+      Log::Warn << "File does not begin with a valid Armadillo binary "
+          << "header!" << std::endl;
+    return false;
+  }
+
+  // The second line holds the matrix dimensions; the payload begins
+  // immediately after its newline.
+  std::string sizeLine;
+  std::getline(stream, sizeLine);
+  uint64_t rows, cols;
+  std::istringstream sizeStream(sizeLine);
+  if (!stream.good() || !(sizeStream >> rows >> cols))
+  {
+    Log::Warn << "Cannot parse the size line of the Armadillo binary header!"
+        << std::endl;
+    return false;
+  }
+
+  const std::streampos dataStart = stream.tellg();
+
+  for (size_t i = 0; i < columns.size(); ++i)
+  {
+    if (columns[i] >= cols)
+    {
+      Log::Warn << "Requested column " << columns[i] << ", but the "
+          << "Armadillo binary file only holds " << cols << " columns!"
+          << std::endl;
+      return false;
+    }
+  }
+
+  matrix.set_size(rows, columns.size());
+  const size_t colBytes = rows * sizeof(eT);
+
+  // Coalesce runs of adjacent requested columns into single reads.
+  size_t i = 0;
+  while (i < columns.size())
+  {
+    size_t runLength = 1;
+    while (i + runLength < columns.size() &&
+        columns[i + runLength] == columns[i] + runLength)
+      ++runLength;
+
+    stream.seekg(dataStart + std::streamoff(columns[i] * colBytes));
+    stream.read(reinterpret_cast<char*>(matrix.colptr(i)),
+        runLength * colBytes);
+    if (!stream.good())
+      return false;
+
+    i += runLength;
+  }
+
+  return true;
+}
+
+template<typename eT>
+bool LoadColumns(const std::string& filename,
+                 arma::Mat<eT>& matrix,
+                 const std::vector<size_t>& columns,
+                 const bool fatal,
+                 const bool transpose,
+                 const FileType inputLoadType)
+{
+  Timer::Start("loading_data");
+
+  // The formats we can seek in are binary, so always open in binary mode.
+  std::fstream stream(filename.c_str(),
+      std::fstream::in | std::fstream::binary);
+  if (!stream.is_open())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  FileType loadType = inputLoadType;
+  if (inputLoadType == FileType::AutoDetect)
+  {
+    // Only the two seekable binary formats can be partially loaded, so peek
+    // at their identifying headers directly.
+    const std::string ARMA_MAT_BIN = "ARMA_MAT_BIN";
+    const std::string MLPACK_BIN = "MLPACKBN";
+    std::string rawHeader(ARMA_MAT_BIN.length(), '\0');
+
+    std::streampos pos = stream.tellg();
+    stream.read(&rawHeader[0], std::streamsize(ARMA_MAT_BIN.length()));
+    stream.clear();
+    stream.seekg(pos); // Reset stream position after peeking.
+
+    if (rawHeader.compare(0, MLPACK_BIN.length(), MLPACK_BIN) == 0)
+      loadType = FileType::MlpackBinary;
+    else if (rawHeader == ARMA_MAT_BIN)
+      loadType = FileType::ArmaBinary;
+    else
+      loadType = FileType::FileTypeUnknown;
+  }
+
+  bool success;
+  if (loadType == FileType::MlpackBinary)
+  {
+    Log::Info << "Loading " << columns.size() << " columns of '" << filename
+        << "' as mlpack binary formatted data.  " << std::flush;
+    success = LoadMlpackBinaryColumns(stream, matrix, columns);
+  }
+  else if (loadType == FileType::ArmaBinary)
+  {
+    Log::Info << "Loading " << columns.size() << " columns of '" << filename
+        << "' as Armadillo binary formatted data.  " << std::flush;
+    success = LoadArmaBinaryColumns(stream, matrix, columns);
+  }
+  else
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Partial loading of '" << filename << "' is not "
+          << "possible; only Armadillo binary and mlpack binary files "
+          << "support seek-based column loading." << std::endl;
+    else
+      Log::Warn << "Partial loading of '" << filename << "' is not "
+          << "possible; only Armadillo binary and mlpack binary files "
+          << "support seek-based column loading.  Load failed." << std::endl;
+
+    return false;
+  }
+
+  if (!success)
+  {
+    Log::Info << std::endl;
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Loading columns from '" << filename << "' failed."
+          << std::endl;
+    else
+      Log::Warn << "Loading columns from '" << filename << "' failed."
+          << std::endl;
+
+    return false;
+  }
+  else
+    Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
+        << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
+
+  // Now transpose the matrix, if necessary.
+  if (transpose)
+  {
+    success = inplace_transpose(matrix, fatal);
+  }
+
+  Timer::Stop("loading_data");
+
+  return success;
+}
+
+template<typename eT>
+bool LoadColumns(const std::string& filename,
+                 arma::Mat<eT>& matrix,
+                 const size_t firstCol,
+                 const size_t lastCol,
+                 const bool fatal,
+                 const bool transpose,
+                 const FileType inputLoadType)
+{
+  if (firstCol > lastCol)
+  {
+    if (fatal)
+      Log::Fatal << "Invalid column range [" << firstCol << ", " << lastCol
+          << "] requested!" << std::endl;
+    else
+      Log::Warn << "Invalid column range [" << firstCol << ", " << lastCol
+          << "] requested; load failed." << std::endl;
+
+    return false;
+  }
+
+  // Adjacent indices are coalesced into one bulk read, so a contiguous range
+  // costs a single seek.
+  std::vector<size_t> columns(lastCol - firstCol + 1);
+  for (size_t i = 0; i < columns.size(); ++i)
+    columns[i] = firstCol + i;
+
+  return LoadColumns(filename, matrix, columns, fatal, transpose,
+      inputLoadType);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
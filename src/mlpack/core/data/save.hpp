@@ -22,6 +22,7 @@
 #include "format.hpp"
 #include "image_info.hpp"
 #include "detect_file_type.hpp"
+#include "mlpack_binary.hpp"
 #include "save_image.hpp"
 
 namespace mlpack {
@@ -132,10 +133,33 @@ bool Save(const std::string& filename,
           const bool fatal = false,
           format f = format::autodetect);
 
+// Forward declaration (see dataset_mapper.hpp).
+template<typename PolicyType, typename InputType>
+class DatasetMapper;
+
+/**
+ * Save a DatasetMapper standalone, so its mappings can later seed another
+ * categorical data::Load() via LoadMappings() (see load.hpp).  The mapper is
+ * serialized with the model-serialization machinery, so the supported file
+ * types are the same as for model Save(): .json, .xml, and .bin.
+ *
+ * @param filename Name of the file to save the mappings to.
+ * @param info DatasetMapper object to save.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename PolicyType, typename InputType>
+bool SaveMappings(const std::string& filename,
+                  DatasetMapper<PolicyType, InputType>& info,
+                  const bool fatal = false);
+
 } // namespace data
 } // namespace mlpack
 
 // Include implementation.
 #include "save_impl.hpp"
 
+// Include append support, which builds on Save().
+#include "append.hpp"
+
 #endif
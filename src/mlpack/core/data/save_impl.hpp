@@ -98,14 +98,22 @@ bool Save(const std::string& filename,
   {
     arma::Mat<eT> tmp = trans(matrix);
 
+    bool success;
+    if (saveType == FileType::MlpackBinary)
+    {
+      success = SaveMlpackBinary(stream, tmp);
+    }
+    else
+    {
 #ifdef ARMA_USE_HDF5
-    // We can't save with streams for HDF5.
-    const bool success = (saveType == FileType::HDF5Binary) ?
-        tmp.quiet_save(filename, ToArmaFileType(saveType)) :
-        tmp.quiet_save(stream, ToArmaFileType(saveType));
+      // We can't save with streams for HDF5.
+      success = (saveType == FileType::HDF5Binary) ?
+          tmp.quiet_save(filename, ToArmaFileType(saveType)) :
+          tmp.quiet_save(stream, ToArmaFileType(saveType));
 #else
-    const bool success = tmp.quiet_save(stream, ToArmaFileType(saveType));
+      success = tmp.quiet_save(stream, ToArmaFileType(saveType));
 #endif
+    }
     if (!success)
     {
       Timer::Stop("saving_data");
@@ -119,14 +127,22 @@ bool Save(const std::string& filename,
   }
   else
   {
+    bool success;
+    if (saveType == FileType::MlpackBinary)
+    {
+      success = SaveMlpackBinary(stream, matrix);
+    }
+    else
+    {
 #ifdef ARMA_USE_HDF5
-    // We can't save with streams for HDF5.
-    const bool success = (saveType == FileType::HDF5Binary) ?
-        matrix.quiet_save(filename, ToArmaFileType(saveType)) :
-        matrix.quiet_save(stream, ToArmaFileType(saveType));
+      // We can't save with streams for HDF5.
+      success = (saveType == FileType::HDF5Binary) ?
+          matrix.quiet_save(filename, ToArmaFileType(saveType)) :
+          matrix.quiet_save(stream, ToArmaFileType(saveType));
 #else
-    const bool success = matrix.quiet_save(stream, ToArmaFileType(saveType));
+      success = matrix.quiet_save(stream, ToArmaFileType(saveType));
 #endif
+    }
     if (!success)
     {
       Timer::Stop("saving_data");
@@ -340,6 +356,15 @@ bool Save(const std::string& filename,
   }
 }
 
+// Save a DatasetMapper standalone.
+template<typename PolicyType, typename InputType>
+bool SaveMappings(const std::string& filename,
+                  DatasetMapper<PolicyType, InputType>& info,
+                  const bool fatal)
+{
+  return Save(filename, "dataset_mapper", info, fatal);
+}
+
 } // namespace data
 } // namespace mlpack
 
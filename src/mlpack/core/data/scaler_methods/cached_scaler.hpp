@@ -0,0 +1,143 @@
+/**
+ * @file core/data/scaler_methods/cached_scaler.hpp
+ *
+ * CachedScaler class to memoize the output of a scaler across repeated
+ * transforms of the same data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CACHED_SCALER_HPP
+#define MLPACK_CORE_DATA_CACHED_SCALER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <map>
+#include <tuple>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A wrapper around any scaler class from this directory that memoizes the
+ * output of Transform().  Results are keyed by the identity of the input
+ * matrix (its memory pointer and size), so transforming the same matrix — or
+ * the same alias view of a matrix, like the fold subsets that KFoldCV hands
+ * out — a second time returns a cached result instead of recomputing it.
+ *
+ * This is meant for workflows that pay the same preprocessing cost many times
+ * over, such as hyper-parameter tuning, where every trial scales the same
+ * cross-validation folds; with a CachedScaler each fold is scaled once and
+ * all subsequent trials reuse the cached tensors.
+ *
+ * @code
+ * arma::mat input;
+ * Load("train.csv", input);
+ *
+ * CachedScaler<StandardScaler> scale;
+ * scale.Fit(input);
+ *
+ * // The first call computes the scaled features; repeated calls on the same
+ * // matrix (or view) are served from the cache.
+ * const arma::mat& scaled = scale.Transform(input);
+ * @endcode
+ *
+ * Since results are keyed by identity rather than by contents, the cache must
+ * be cleared (with Clear(), or implicitly by calling Fit() again) if the
+ * underlying data is modified in place.  The cache is not thread-safe.
+ *
+ * @tparam ScalerType The wrapped scaler (e.g. StandardScaler).
+ * @tparam MatType The type of the matrices to be transformed.
+ */
+template<typename ScalerType, typename MatType = arma::mat>
+class CachedScaler
+{
+ public:
+  /**
+   * Fit the wrapped scaler on the given dataset.  Any previously cached
+   * results are discarded, since they were produced by the old fit.
+   *
+   * @param input Dataset to fit.
+   */
+  void Fit(const MatType& input)
+  {
+    scaler.Fit(input);
+    cache.clear();
+  }
+
+  /**
+   * Scale the given features, reusing a cached result if this matrix (or this
+   * view) has been transformed before.
+   *
+   * @param input Dataset to scale features.
+   * @return A reference to the cached scaled features; it stays valid until
+   *     the cache is cleared.
+   */
+  const MatType& Transform(const MatType& input)
+  {
+    const CacheKey key(input.memptr(), input.n_rows, input.n_cols);
+    typename CacheType::iterator it = cache.find(key);
+    if (it == cache.end())
+    {
+      MatType output;
+      scaler.Transform(input, output);
+      it = cache.emplace(key, std::move(output)).first;
+    }
+    return it->second;
+  }
+
+  /**
+   * Scale the given features into the given output matrix, reusing a cached
+   * result if this matrix (or this view) has been transformed before.
+   *
+   * @param input Dataset to scale features.
+   * @param output Output matrix with scaled features.
+   */
+  void Transform(const MatType& input, MatType& output)
+  {
+    output = Transform(input);
+  }
+
+  /**
+   * Retrieve the original dataset.  Inverse transforms are not cached — they
+   * are typically applied once, to final predictions.
+   *
+   * @param input Scaled dataset.
+   * @param output Output matrix with original dataset.
+   */
+  void InverseTransform(const MatType& input, MatType& output)
+  {
+    scaler.InverseTransform(input, output);
+  }
+
+  //! Discard all cached results (e.g. after modifying data in place).
+  void Clear() { cache.clear(); }
+
+  //! Get the number of cached results.
+  size_t CacheSize() const { return cache.size(); }
+
+  //! Get the wrapped scaler.
+  const ScalerType& Scaler() const { return scaler; }
+  //! Modify the wrapped scaler.  The cache is not invalidated; call Clear()
+  //! if the modification changes what Transform() would output.
+  ScalerType& Scaler() { return scaler; }
+
+ private:
+  //! The identity of an input matrix: its memory pointer and size.
+  using CacheKey = std::tuple<const typename MatType::elem_type*,
+      arma::uword, arma::uword>;
+  //! The type of the cache storage.
+  using CacheType = std::map<CacheKey, MatType>;
+
+  //! The wrapped scaler.
+  ScalerType scaler;
+
+  //! Cached transform results.
+  CacheType cache;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
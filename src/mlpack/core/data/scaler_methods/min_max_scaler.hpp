@@ -66,23 +66,95 @@ class MinMaxScaler
   }
 
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the min max and scale.  This
+   * resets any statistics accumulated by previous calls to Fit() or
+   * PartialFit().
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
-    scale = itemMax - itemMin;
-    // Handle zeros in scale vector.
-    scale.for_each([](arma::vec::elem_type& val) { val =
-        (val == 0) ? 1 : val; });
-    scale = (scaleMax - scaleMin) / scale;
-    scalerowmin.copy_size(itemMin);
-    scalerowmin.fill(scaleMin);
-    scalerowmin = scalerowmin - itemMin % scale;
+    itemMin.reset();
+    itemMax.reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Incrementally fit a batch of columns.  The running minimum and maximum
+   * are widened to cover the batch, so calling this repeatedly on batches of
+   * a dataset gives the same result as a single Fit() on the whole dataset.
+   * The scaler is usable with Transform() after every call.
+   *
+   * @param input Batch of columns to accumulate.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    const arma::vec batchMin = arma::min(input, 1);
+    const arma::vec batchMax = arma::max(input, 1);
+
+    if (itemMin.is_empty())
+    {
+      itemMin = batchMin;
+      itemMax = batchMax;
+    }
+    else
+    {
+      if (batchMin.n_elem != itemMin.n_elem)
+      {
+        throw std::runtime_error("PartialFit(): batch dimensionality does "
+            "not match the previously fitted batches!");
+      }
+
+      itemMin = arma::min(itemMin, batchMin);
+      itemMax = arma::max(itemMax, batchMax);
+    }
+
+    UpdateScale();
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one, as if this scaler
+   * had also been fitted on all the data the other scaler was fitted on.
+   * This allows fitting one scaler per data shard and combining the results
+   * without gathering the data in one place.  Both scalers must use the same
+   * output range.
+   *
+   * @param other Scaler whose statistics to merge in.
+   */
+  void Merge(const MinMaxScaler& other)
+  {
+    if (other.itemMin.is_empty())
+      return;
+
+    if (other.scaleMin != scaleMin || other.scaleMax != scaleMax)
+    {
+      throw std::runtime_error("Merge(): scalers must use the same output "
+          "range!");
+    }
+
+    if (itemMin.is_empty())
+    {
+      itemMin = other.itemMin;
+      itemMax = other.itemMax;
+    }
+    else
+    {
+      if (other.itemMin.n_elem != itemMin.n_elem)
+      {
+        throw std::runtime_error("Merge(): scalers were fitted on data of "
+            "different dimensionality!");
+      }
+
+      itemMin = arma::min(itemMin, other.itemMin);
+      itemMax = arma::max(itemMax, other.itemMax);
+    }
+
+    UpdateScale();
   }
 
   /**
@@ -139,6 +211,22 @@ class MinMaxScaler
   }
 
  private:
+  /**
+   * Recompute the scaling vectors used by Transform() from the running
+   * minimum and maximum.
+   */
+  void UpdateScale()
+  {
+    scale = itemMax - itemMin;
+    // Handle zeros in scale vector.
+    scale.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+    scale = (scaleMax - scaleMin) / scale;
+    scalerowmin.copy_size(itemMin);
+    scalerowmin.fill(scaleMin);
+    scalerowmin = scalerowmin - itemMin % scale;
+  }
+
   // Vector which holds minimum of each feature.
   arma::vec itemMin;
   // Vector which holds maximum of each feature.
@@ -48,18 +48,101 @@ class StandardScaler
 {
  public:
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the mean and standard deviation.
+   * This resets any statistics accumulated by previous calls to Fit() or
+   * PartialFit().
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
-    // Handle zeros in scale vector.
-    itemStdDev.for_each([](arma::vec::elem_type& val) { val =
-        (val == 0) ? 1 : val; });
+    count = 0;
+    PartialFit(input);
+  }
+
+  /**
+   * Incrementally fit a batch of columns.  The running mean and variance are
+   * maintained with Welford's accumulation, so calling this repeatedly on
+   * batches of a dataset gives the same result as a single Fit() on the
+   * whole dataset, without ever needing more than one batch in memory.  The
+   * scaler is usable with Transform() after every call.
+   *
+   * @param input Batch of columns to accumulate.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    const size_t batchCount = input.n_cols;
+    if (batchCount == 0)
+      return;
+
+    const arma::vec batchMean = arma::mean(input, 1);
+    const arma::vec batchM2 = arma::sum(arma::square(
+        input.each_col() - batchMean), 1);
+
+    if (count == 0)
+    {
+      runningMean = batchMean;
+      runningM2 = batchM2;
+      count = batchCount;
+    }
+    else
+    {
+      if (batchMean.n_elem != runningMean.n_elem)
+      {
+        throw std::runtime_error("PartialFit(): batch dimensionality does "
+            "not match the previously fitted batches!");
+      }
+
+      // Chan et al.'s pairwise update of Welford's accumulators.
+      const arma::vec delta = batchMean - runningMean;
+      const size_t total = count + batchCount;
+      runningMean += delta * ((double) batchCount / total);
+      runningM2 += batchM2 + arma::square(delta) *
+          ((double) count * batchCount / total);
+      count = total;
+    }
+
+    UpdateStatistics();
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one, as if this scaler
+   * had also been fitted on all the data the other scaler was fitted on.
+   * This allows fitting one scaler per data shard and combining the results
+   * without gathering the data in one place.
+   *
+   * @param other Scaler whose statistics to merge in.
+   */
+  void Merge(const StandardScaler& other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (count == 0)
+    {
+      count = other.count;
+      runningMean = other.runningMean;
+      runningM2 = other.runningM2;
+    }
+    else
+    {
+      if (other.runningMean.n_elem != runningMean.n_elem)
+      {
+        throw std::runtime_error("Merge(): scalers were fitted on data of "
+            "different dimensionality!");
+      }
+
+      const arma::vec delta = other.runningMean - runningMean;
+      const size_t total = count + other.count;
+      runningMean += delta * ((double) other.count / total);
+      runningM2 += other.runningM2 + arma::square(delta) *
+          ((double) count * other.count / total);
+      count = total;
+    }
+
+    UpdateStatistics();
   }
 
   /**
@@ -103,13 +186,35 @@ class StandardScaler
   {
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(itemStdDev));
+    ar(CEREAL_NVP(count));
+    ar(CEREAL_NVP(runningMean));
+    ar(CEREAL_NVP(runningM2));
   }
 
  private:
+  /**
+   * Recompute the mean and standard deviation exposed to Transform() from
+   * the running accumulators.
+   */
+  void UpdateStatistics()
+  {
+    itemMean = runningMean;
+    itemStdDev = arma::sqrt(runningM2 / count);
+    // Handle zeros in scale vector.
+    itemStdDev.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
   // Vector which holds mean of each feature.
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Number of columns accumulated so far.
+  size_t count = 0;
+  // Running mean of each feature (Welford accumulator).
+  arma::vec runningMean;
+  // Running sum of squared deviations of each feature (Welford accumulator).
+  arma::vec runningM2;
 }; // class StandardScaler
 
 } // namespace data
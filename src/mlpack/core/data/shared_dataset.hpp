@@ -0,0 +1,132 @@
+/**
+ * @file core/data/shared_dataset.hpp
+ *
+ * Publication of a loaded matrix in a POSIX shared-memory segment, so that
+ * other processes---typically later invocations of mlpack command-line
+ * bindings---can attach to the already-parsed data instead of each loading
+ * and parsing their own copy of the same file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SHARED_DATASET_HPP
+#define MLPACK_CORE_DATA_SHARED_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+#include <memory>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A dataset held in a named POSIX shared-memory segment.  One process calls
+ * Publish() to copy a loaded matrix into the segment; any number of other
+ * processes then call Attach() to map the segment and obtain an Armadillo
+ * matrix built directly on top of the mapping.  The segment outlives the
+ * publishing process and persists until Unpublish() is called, so a pipeline
+ * that runs several mlpack tools over the same 8 GB file pays for one load
+ * instead of N.
+ *
+ * The segment holds the same two-line Armadillo binary header that an
+ * arma_binary file begins with, followed by the raw column-major element
+ * data, so the published layout is exactly the on-disk binary format.
+ *
+ * As with MmapMatrix, the attached mapping is copy-on-write (MAP_PRIVATE):
+ * algorithms that modify the matrix in place will work, but their writes are
+ * never visible to the segment or to other processes.  The matrix returned by
+ * Matrix() aliases the mapping, so a SharedDataset cannot be copied and the
+ * matrix must not outlive the SharedDataset that owns it.
+ *
+ * POSIX shared memory is not available on Windows; there, Publish(), Attach(),
+ * and Unpublish() all fail (and report an error).
+ *
+ * @tparam eT Element type of the matrix to be shared.
+ */
+template<typename eT>
+class SharedDataset
+{
+ public:
+  //! Create an empty object; no mapping is established until Attach().
+  SharedDataset();
+
+  //! Detach from the segment (if attached).  The segment itself persists
+  //! until Unpublish() is called.
+  ~SharedDataset();
+
+  //! A SharedDataset cannot be copied, since the matrix aliases the mapping.
+  SharedDataset(const SharedDataset&) = delete;
+  //! A SharedDataset cannot be copied, since the matrix aliases the mapping.
+  SharedDataset& operator=(const SharedDataset&) = delete;
+
+  //! Take ownership of another SharedDataset's mapping.
+  SharedDataset(SharedDataset&& other);
+  //! Take ownership of another SharedDataset's mapping.
+  SharedDataset& operator=(SharedDataset&& other);
+
+  /**
+   * Publish the given matrix under the given name, creating (or replacing the
+   * contents of) the shared-memory segment.  The matrix is copied into the
+   * segment, so it may be freed afterwards.  The segment persists until
+   * Unpublish() is called with the same name.
+   *
+   * @param name Name of the shared dataset (e.g. "census"); a leading '/' is
+   *     added if not present, per POSIX shared-memory naming rules.
+   * @param matrix Matrix to publish.
+   * @param fatal If an error should be reported as fatal (default false).
+   * @return Boolean value indicating success or failure.
+   */
+  static bool Publish(const std::string& name,
+                      const arma::Mat<eT>& matrix,
+                      const bool fatal = false);
+
+  /**
+   * Attach to the shared dataset published under the given name and build the
+   * aliasing matrix.  Any existing mapping is released first.
+   *
+   * @param name Name of the shared dataset, as passed to Publish().
+   * @param fatal If an error should be reported as fatal (default false).
+   * @return Boolean value indicating success or failure.
+   */
+  bool Attach(const std::string& name, const bool fatal = false);
+
+  /**
+   * Remove the shared dataset published under the given name.  Processes that
+   * are already attached keep their mappings; new Attach() calls will fail.
+   *
+   * @param name Name of the shared dataset, as passed to Publish().
+   * @param fatal If an error should be reported as fatal (default false).
+   * @return Boolean value indicating success or failure.
+   */
+  static bool Unpublish(const std::string& name, const bool fatal = false);
+
+  //! Release the mapping and reset the matrix to an empty state.
+  void Clear();
+
+  //! Get the matrix backed by the mapping (empty if nothing is attached).
+  const arma::Mat<eT>& Matrix() const { return *matrix; }
+  //! Modify the matrix backed by the mapping.  Writes are copy-on-write and
+  //! will not be visible to other processes.
+  arma::Mat<eT>& Matrix() { return *matrix; }
+
+ private:
+  //! Prepend the leading '/' that POSIX shared-memory names require.
+  static std::string SegmentName(const std::string& name);
+
+  //! The aliasing matrix; points at `mapping` once a segment is attached.
+  std::unique_ptr<arma::Mat<eT>> matrix;
+  //! Base address of the mapping (nullptr if nothing is mapped).
+  void* mapping;
+  //! Length of the mapping in bytes.
+  size_t mappedLength;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#include "shared_dataset_impl.hpp"
+
+#endif
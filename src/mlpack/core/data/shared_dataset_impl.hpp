@@ -0,0 +1,338 @@
+/**
+ * @file core/data/shared_dataset_impl.hpp
+ *
+ * Implementation of dataset publication in POSIX shared memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SHARED_DATASET_IMPL_HPP
+#define MLPACK_CORE_DATA_SHARED_DATASET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "shared_dataset.hpp"
+
+#include <cstring>
+#include <sstream>
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+SharedDataset<eT>::SharedDataset() :
+    matrix(new arma::Mat<eT>()),
+    mapping(NULL),
+    mappedLength(0)
+{ /* Nothing to do. */ }
+
+template<typename eT>
+SharedDataset<eT>::~SharedDataset()
+{
+  Clear();
+}
+
+template<typename eT>
+SharedDataset<eT>::SharedDataset(SharedDataset&& other) :
+    matrix(std::move(other.matrix)),
+    mapping(other.mapping),
+    mappedLength(other.mappedLength)
+{
+  other.matrix.reset(new arma::Mat<eT>());
+  other.mapping = NULL;
+  other.mappedLength = 0;
+}
+
+template<typename eT>
+SharedDataset<eT>& SharedDataset<eT>::operator=(SharedDataset&& other)
+{
+  if (this != &other)
+  {
+    Clear();
+
+    matrix = std::move(other.matrix);
+    mapping = other.mapping;
+    mappedLength = other.mappedLength;
+
+    other.matrix.reset(new arma::Mat<eT>());
+    other.mapping = NULL;
+    other.mappedLength = 0;
+  }
+
+  return *this;
+}
+
+template<typename eT>
+void SharedDataset<eT>::Clear()
+{
+  // The aliasing matrix must be destroyed before the mapping is released.
+  matrix.reset(new arma::Mat<eT>());
+
+#ifndef _WIN32
+  if (mapping != NULL)
+    munmap(mapping, mappedLength);
+#endif
+  mapping = NULL;
+  mappedLength = 0;
+}
+
+template<typename eT>
+std::string SharedDataset<eT>::SegmentName(const std::string& name)
+{
+  return (name.empty() || name[0] != '/') ? "/" + name : name;
+}
+
+template<typename eT>
+bool SharedDataset<eT>::Publish(const std::string& name,
+                                const arma::Mat<eT>& matrix,
+                                const bool fatal)
+{
+#ifndef _WIN32
+  const std::string segment = SegmentName(name);
+
+  // The segment begins with the same two text lines as an arma_binary file:
+  // the format/element-type tag, then the matrix dimensions.
+  std::ostringstream header;
+  header << arma::diskio::gen_bin_header(matrix) << '\n'
+      << matrix.n_rows << ' ' << matrix.n_cols << '\n';
+  const std::string headerStr = header.str();
+  const size_t length = headerStr.size() + matrix.n_elem * sizeof(eT);
+
+  const int fd = shm_open(segment.c_str(), O_CREAT | O_RDWR, 0600);
+  if (fd == -1)
+  {
+    if (fatal)
+      Log::Fatal << "Cannot create shared-memory segment '" << segment
+          << "'." << std::endl;
+    else
+      Log::Warn << "Cannot create shared-memory segment '" << segment
+          << "'; publish failed." << std::endl;
+
+    return false;
+  }
+
+  if (ftruncate(fd, (off_t) length) == -1)
+  {
+    close(fd);
+    shm_unlink(segment.c_str());
+    if (fatal)
+      Log::Fatal << "Cannot size shared-memory segment '" << segment
+          << "' to " << length << " bytes." << std::endl;
+    else
+      Log::Warn << "Cannot size shared-memory segment '" << segment
+          << "' to " << length << " bytes; publish failed." << std::endl;
+
+    return false;
+  }
+
+  void* map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping holds its own reference to the segment.
+  close(fd);
+
+  if (map == MAP_FAILED)
+  {
+    shm_unlink(segment.c_str());
+    if (fatal)
+      Log::Fatal << "Cannot map shared-memory segment '" << segment << "'."
+          << std::endl;
+    else
+      Log::Warn << "Cannot map shared-memory segment '" << segment
+          << "'; publish failed." << std::endl;
+
+    return false;
+  }
+
+  std::memcpy(map, headerStr.data(), headerStr.size());
+  std::memcpy((char*) map + headerStr.size(), matrix.memptr(),
+      matrix.n_elem * sizeof(eT));
+  munmap(map, length);
+
+  Log::Info << "Published " << matrix.n_rows << "x" << matrix.n_cols
+      << " matrix as shared dataset '" << name << "'." << std::endl;
+
+  return true;
+#else
+  (void) name;
+  (void) matrix;
+  if (fatal)
+    Log::Fatal << "POSIX shared memory is not available on this platform; "
+        << "cannot publish shared dataset '" << name << "'." << std::endl;
+  else
+    Log::Warn << "POSIX shared memory is not available on this platform; "
+        << "cannot publish shared dataset '" << name << "'." << std::endl;
+
+  return false;
+#endif
+}
+
+template<typename eT>
+bool SharedDataset<eT>::Attach(const std::string& name, const bool fatal)
+{
+  Timer::Start("loading_data");
+  Clear();
+
+#ifndef _WIN32
+  const std::string segment = SegmentName(name);
+
+  const int fd = shm_open(segment.c_str(), O_RDONLY, 0);
+  if (fd == -1)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "No shared dataset is published under the name '" << name
+          << "'." << std::endl;
+    else
+      Log::Warn << "No shared dataset is published under the name '" << name
+          << "'; attach failed." << std::endl;
+
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) == -1)
+  {
+    close(fd);
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot stat shared-memory segment '" << segment << "'."
+          << std::endl;
+    else
+      Log::Warn << "Cannot stat shared-memory segment '" << segment
+          << "'; attach failed." << std::endl;
+
+    return false;
+  }
+  const size_t length = (size_t) info.st_size;
+
+  // Map copy-on-write, so that in-place modification of the matrix works but
+  // is never visible to the segment or to other processes.
+  void* map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  // The mapping holds its own reference to the segment.
+  close(fd);
+
+  if (map == MAP_FAILED)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot map shared-memory segment '" << segment << "'."
+          << std::endl;
+    else
+      Log::Warn << "Cannot map shared-memory segment '" << segment
+          << "'; attach failed." << std::endl;
+
+    return false;
+  }
+
+  mapping = map;
+  mappedLength = length;
+
+  // Parse the two header lines at the front of the segment.
+  std::istringstream stream(std::string((const char*) mapping,
+      std::min<size_t>(length, 256)));
+  std::string header;
+  std::getline(stream, header);
+
+  const std::string expected = arma::diskio::gen_bin_header(arma::Mat<eT>());
+  if (header != expected)
+  {
+    Clear();
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Shared dataset '" << name << "' has header '" << header
+          << "', which does not match the requested element type ('"
+          << expected << "')." << std::endl;
+    else
+      Log::Warn << "Shared dataset '" << name << "' has header '" << header
+          << "', which does not match the requested element type ('"
+          << expected << "'); attach failed." << std::endl;
+
+    return false;
+  }
+
+  arma::uword rows = 0, cols = 0;
+  stream >> rows >> cols;
+  stream.get(); // Eat the newline that terminates the dimension line.
+  const size_t dataOffset = (size_t) stream.tellg();
+
+  if (!stream || dataOffset + rows * cols * sizeof(eT) > length)
+  {
+    Clear();
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Shared dataset '" << name << "' is too short to hold a "
+          << rows << "x" << cols << " matrix." << std::endl;
+    else
+      Log::Warn << "Shared dataset '" << name << "' is too short to hold a "
+          << rows << "x" << cols << " matrix; attach failed." << std::endl;
+
+    return false;
+  }
+
+  // Build the aliasing matrix on top of the mapping; no copy is made, and the
+  // matrix cannot be resized (strict = true).
+  eT* const data = reinterpret_cast<eT*>((char*) mapping + dataOffset);
+  matrix.reset(new arma::Mat<eT>(data, rows, cols, false, true));
+
+  Log::Info << "Attached to shared dataset '" << name << "' as a "
+      << matrix->n_rows << "x" << matrix->n_cols << " matrix." << std::endl;
+
+  Timer::Stop("loading_data");
+  return true;
+#else
+  (void) name;
+  Timer::Stop("loading_data");
+  if (fatal)
+    Log::Fatal << "POSIX shared memory is not available on this platform; "
+        << "cannot attach to shared dataset '" << name << "'." << std::endl;
+  else
+    Log::Warn << "POSIX shared memory is not available on this platform; "
+        << "cannot attach to shared dataset '" << name << "'." << std::endl;
+
+  return false;
+#endif
+}
+
+template<typename eT>
+bool SharedDataset<eT>::Unpublish(const std::string& name, const bool fatal)
+{
+#ifndef _WIN32
+  const std::string segment = SegmentName(name);
+  if (shm_unlink(segment.c_str()) == -1)
+  {
+    if (fatal)
+      Log::Fatal << "No shared dataset is published under the name '" << name
+          << "'." << std::endl;
+    else
+      Log::Warn << "No shared dataset is published under the name '" << name
+          << "'; unpublish failed." << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Removed shared dataset '" << name << "'." << std::endl;
+  return true;
+#else
+  (void) name;
+  if (fatal)
+    Log::Fatal << "POSIX shared memory is not available on this platform; "
+        << "cannot remove shared dataset '" << name << "'." << std::endl;
+  else
+    Log::Warn << "POSIX shared memory is not available on this platform; "
+        << "cannot remove shared dataset '" << name << "'." << std::endl;
+
+  return false;
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file core/data/skippable_section.hpp
+ * @author Jianxin Zhang
+ *
+ * Sectioned serialization of training-only model state.  A member serialized
+ * with SerializeSection() is stored as a length-prefixed segment inside the
+ * enclosing archive, so an inference-only consumer can load the model while
+ * skipping the segment entirely: the bytes are consumed without constructing
+ * the member, cutting load time and peak memory for state that only matters
+ * when training is resumed.
+ *
+ * Skipping is controlled by the thread-local flag SkipSerializationSections();
+ * the RAII guard SectionSkipGuard sets and restores it, and the model Load()
+ * overload exposes it as the skipSections parameter.  A skipped member is left
+ * in whatever state it held before the load (for a freshly-constructed model,
+ * its default state).
+ *
+ * The segment payload is always a cereal binary sub-archive.  In a binary
+ * archive it is embedded as raw bytes and skipped in constant memory; in XML
+ * and JSON archives it is embedded base64-encoded, and skipping still decodes
+ * the text (text archives cannot seek) but never deserializes the member.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SKIPPABLE_SECTION_HPP
+#define MLPACK_CORE_DATA_SKIPPABLE_SECTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/cereal/is_loading.hpp>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/json.hpp>
+#include <cereal/archives/xml.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Access the thread-local flag that controls whether SerializeSection() skips
+ * its member when loading.  When the flag is true, sections are consumed
+ * without deserializing their contents.  Prefer SectionSkipGuard or the
+ * skipSections parameter of the model Load() overload over setting this
+ * directly.
+ */
+inline bool& SkipSerializationSections()
+{
+  static thread_local bool skipSections = false;
+  return skipSections;
+}
+
+/**
+ * RAII guard that enables (or disables) section skipping for the current
+ * thread and restores the previous setting when destroyed.
+ */
+class SectionSkipGuard
+{
+ public:
+  //! Set the section-skipping flag for the lifetime of the guard.
+  explicit SectionSkipGuard(const bool skip = true) :
+      oldValue(SkipSerializationSections())
+  {
+    SkipSerializationSections() = skip;
+  }
+
+  //! Restore the previous setting.
+  ~SectionSkipGuard()
+  {
+    SkipSerializationSections() = oldValue;
+  }
+
+ private:
+  //! The setting to restore on destruction.
+  bool oldValue;
+};
+
+//! Save a section payload into a binary archive as raw bytes.
+inline void SaveSectionBlob(cereal::BinaryOutputArchive& ar,
+                            const std::string& /* name */,
+                            const std::string& blob)
+{
+  ar.saveBinary(blob.data(), blob.size());
+}
+
+//! Save a section payload into a text (XML or JSON) archive, base64-encoded.
+template<typename Archive>
+void SaveSectionBlob(Archive& ar,
+                     const std::string& name,
+                     const std::string& blob)
+{
+  ar.saveBinaryValue(blob.data(), blob.size(), name.c_str());
+}
+
+//! Load a section payload from a binary archive.
+inline void LoadSectionBlob(cereal::BinaryInputArchive& ar,
+                            const std::string& /* name */,
+                            char* data,
+                            const size_t size)
+{
+  ar.loadBinary(data, size);
+}
+
+//! Load a section payload from a text (XML or JSON) archive.
+template<typename Archive>
+void LoadSectionBlob(Archive& ar,
+                     const std::string& name,
+                     char* data,
+                     const size_t size)
+{
+  ar.loadBinaryValue(data, size, name.c_str());
+}
+
+//! Consume a section payload from a binary archive without storing it.  The
+//! bytes are read through a small scratch buffer, so skipping is constant
+//! memory no matter how large the section is.
+inline void SkipSectionBlob(cereal::BinaryInputArchive& ar,
+                            const std::string& /* name */,
+                            const size_t size)
+{
+  char scratch[4096];
+  size_t remaining = size;
+  while (remaining > 0)
+  {
+    const size_t chunk = std::min(remaining, sizeof(scratch));
+    ar.loadBinary(scratch, chunk);
+    remaining -= chunk;
+  }
+}
+
+//! Consume a section payload from a text archive without deserializing it.
+//! Text archives cannot seek, so the base64 text is still decoded, but the
+//! member itself is never constructed.
+template<typename Archive>
+void SkipSectionBlob(Archive& ar, const std::string& name, const size_t size)
+{
+  std::string scratch(size, '\0');
+  ar.loadBinaryValue(&scratch[0], size, name.c_str());
+}
+
+/**
+ * Serialize a member as a skippable section.  On save, the value is serialized
+ * into a binary sub-archive and embedded in the enclosing archive behind a
+ * byte-length prefix; on load, the section is either deserialized normally or
+ * — if SkipSerializationSections() is set — consumed without touching the
+ * value.
+ *
+ * Use this for state that is only needed to continue training, never for
+ * state that prediction depends on: a model loaded with skipping enabled must
+ * still produce correct predictions.
+ *
+ * @param ar Enclosing archive (any of the archive types Load()/Save()
+ *     support).
+ * @param name Name of the section in the enclosing archive.
+ * @param value Member to serialize.
+ */
+template<typename Archive, typename T>
+void SerializeSection(Archive& ar, const std::string& name, T& value)
+{
+  const std::string sizeName = name + "Size";
+  if (cereal::is_loading<Archive>())
+  {
+    uint64_t sectionSize = 0;
+    ar(cereal::make_nvp(sizeName.c_str(), sectionSize));
+
+    if (SkipSerializationSections())
+    {
+      SkipSectionBlob(ar, name, (size_t) sectionSize);
+      return;
+    }
+
+    std::string blob((size_t) sectionSize, '\0');
+    LoadSectionBlob(ar, name, &blob[0], (size_t) sectionSize);
+
+    std::istringstream iss(blob, std::ios::in | std::ios::binary);
+    cereal::BinaryInputArchive sectionAr(iss);
+    sectionAr(value);
+  }
+  else
+  {
+    // Serialize the value into a standalone binary sub-archive.
+    std::ostringstream oss(std::ios::out | std::ios::binary);
+    {
+      cereal::BinaryOutputArchive sectionAr(oss);
+      sectionAr(value);
+    }
+    const std::string blob = oss.str();
+
+    uint64_t sectionSize = (uint64_t) blob.size();
+    ar(cereal::make_nvp(sizeName.c_str(), sectionSize));
+    SaveSectionBlob(ar, name, blob);
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
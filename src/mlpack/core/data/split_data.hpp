@@ -14,6 +14,7 @@
 #define MLPACK_CORE_DATA_SPLIT_DATA_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/shuffle_data.hpp>
 
 namespace mlpack {
 namespace data {
@@ -62,6 +63,84 @@ void SplitHelper(const InputType& input,
   }
 }
 
+/**
+ * Given the number of points in a dataset, compute index vectors for a
+ * train/test split without touching the data itself.  This is the index-view
+ * form of Split(): nothing is copied, so the cost is just the two index
+ * vectors, instead of a shuffled duplicate of the full dataset.  The indices
+ * can be used directly in Armadillo expressions (e.g.
+ * `input.cols(trainIndices)`), or a batch at a time
+ * (`input.cols(trainIndices.subvec(begin, end))`) to keep peak memory bounded.
+ *
+ * @code
+ * arma::uvec trainIndices, testIndices;
+ * Split(input.n_cols, trainIndices, testIndices, 0.3);
+ * model.Train(input.cols(trainIndices), labels.cols(trainIndices), ...);
+ * @endcode
+ *
+ * @param count Number of points in the dataset.
+ * @param trainIndices Vector to store the indices of training points into.
+ * @param testIndices Vector to store the indices of test points into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+inline void Split(const size_t count,
+                  arma::uvec& trainIndices,
+                  arma::uvec& testIndices,
+                  const double testRatio,
+                  const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(count * testRatio);
+  const size_t trainSize = count - testSize;
+
+  arma::uvec order;
+  if (shuffleData)
+    order = math::ShuffleOrdering(count);
+  else
+    order = arma::linspace<arma::uvec>(0, count - 1, count);
+
+  trainIndices = order.head(trainSize);
+  testIndices = order.tail(testSize);
+}
+
+/**
+ * Get a no-copy view of the training part of a train/test split.  Since the
+ * returned matrix aliases the memory of `input` (in the same way as
+ * math::MakeAlias()), the data cannot be reordered, so there is no shuffle
+ * option; combine with the index-based Split() overload when a shuffled split
+ * is needed, or shuffle `input` in place beforehand.  The view must not
+ * outlive `input`.
+ *
+ * @param input Dataset to split; the view shares its memory.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ */
+template<typename T>
+arma::Mat<T> TrainSplitView(arma::Mat<T>& input, const double testRatio)
+{
+  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
+  const size_t trainSize = input.n_cols - testSize;
+
+  return arma::Mat<T>(input.memptr(), input.n_rows, trainSize, false, true);
+}
+
+/**
+ * Get a no-copy view of the test part of a train/test split; see
+ * TrainSplitView() for the details and restrictions.
+ *
+ * @param input Dataset to split; the view shares its memory.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ */
+template<typename T>
+arma::Mat<T> TestSplitView(arma::Mat<T>& input, const double testRatio)
+{
+  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
+  const size_t trainSize = input.n_cols - testSize;
+
+  return arma::Mat<T>(input.memptr() + trainSize * input.n_rows, input.n_rows,
+      testSize, false, true);
+}
+
 /**
  * Given an input dataset and labels, stratify into a training set and test set.
  * It is recommended to have the input labels between the range [0, n) where n
@@ -175,8 +254,7 @@ void StratifiedSplit(const arma::Mat<T>& input,
 
   if (shuffleData)
   {
-    arma::uvec order = arma::shuffle(
-        arma::linspace<arma::uvec>(0, input.n_cols - 1, input.n_cols));
+    arma::uvec order = math::ShuffleOrdering(input.n_cols);
 
     for (arma::uword i : order)
     {
@@ -265,8 +343,7 @@ void Split(const arma::Mat<T>& input,
   util::CheckSameSizes(input, inputLabel, "data::Split()");
   if (shuffleData)
   {
-    arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
-        input.n_cols - 1, input.n_cols));
+    arma::uvec order = math::ShuffleOrdering(input.n_cols);
     SplitHelper(input, trainData, testData, testRatio, order);
     SplitHelper(inputLabel, trainLabel, testLabel, testRatio, order);
   }
@@ -309,8 +386,7 @@ void Split(const arma::Mat<T>& input,
 {
   if (shuffleData)
   {
-    arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
-        input.n_cols - 1, input.n_cols));
+    arma::uvec order = math::ShuffleOrdering(input.n_cols);
     SplitHelper(input, trainData, testData, testRatio, order);
   }
   else
@@ -460,8 +536,7 @@ void Split(const FieldType& input,
   util::CheckSameSizes(input, inputLabel, "data::Split()");
   if (shuffleData)
   {
-    arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
-        input.n_cols - 1, input.n_cols));
+    arma::uvec order = math::ShuffleOrdering(input.n_cols);
     SplitHelper(input, trainData, testData, testRatio, order);
     SplitHelper(inputLabel, trainLabel, testLabel, testRatio, order);
   }
@@ -512,8 +587,7 @@ void Split(const FieldType& input,
 {
   if (shuffleData)
   {
-    arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
-        input.n_cols - 1, input.n_cols));
+    arma::uvec order = math::ShuffleOrdering(input.n_cols);
     SplitHelper(input, trainData, testData, testRatio, order);
   }
   else
@@ -0,0 +1,74 @@
+/**
+ * @file core/data/stream_csv.hpp
+ *
+ * A chunked CSV reader for numeric points arriving on a stream.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STREAM_CSV_HPP
+#define MLPACK_CORE_DATA_STREAM_CSV_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <istream>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A reader for numeric CSV data arriving incrementally on a stream, such as
+ * standard input.  Rows are points; each call to ReadChunk() blocks until up
+ * to a chunk's worth of rows has been read (or the stream ends) and yields
+ * them as the columns of a matrix, so predictions can be produced and emitted
+ * chunk by chunk without ever materializing the full input.  The
+ * dimensionality is fixed by the first row.
+ *
+ * Unlike StreamingDataset, which prefetches batches of an on-disk
+ * arma_binary file, this reader consumes a one-shot text stream and cannot
+ * rewind.
+ */
+class StreamingCSVReader
+{
+ public:
+  /**
+   * Construct a reader over the given stream, which must outlive the reader.
+   *
+   * @param stream Stream to read CSV rows from.
+   * @param chunkSize Maximum number of rows (points) per chunk.
+   */
+  StreamingCSVReader(std::istream& stream, const size_t chunkSize = 1024);
+
+  /**
+   * Read the next chunk of rows into the given matrix, one point per column.
+   * Empty lines are skipped.  Throws a std::runtime_error if a value cannot
+   * be parsed or a row's length does not match the first row's.
+   *
+   * @param chunk Matrix to store the chunk in.
+   * @return true if at least one point was read; false when the stream is
+   *     exhausted.
+   */
+  bool ReadChunk(arma::mat& chunk);
+
+  //! Get the dimensionality of the points (0 until the first row is read).
+  size_t Dimensionality() const { return dimensionality; }
+
+ private:
+  //! The stream rows are read from.
+  std::istream& stream;
+  //! Maximum number of points per chunk.
+  const size_t chunkSize;
+  //! Number of values per row, fixed by the first row.
+  size_t dimensionality;
+  //! Number of lines read so far, for error messages.
+  size_t line;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "stream_csv_impl.hpp"
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file core/data/stream_csv_impl.hpp
+ *
+ * Implementation of the chunked streaming CSV reader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STREAM_CSV_IMPL_HPP
+#define MLPACK_CORE_DATA_STREAM_CSV_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stream_csv.hpp"
+
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+namespace mlpack {
+namespace data {
+
+inline StreamingCSVReader::StreamingCSVReader(std::istream& stream,
+                                              const size_t chunkSize) :
+    stream(stream),
+    chunkSize(chunkSize),
+    dimensionality(0),
+    line(0)
+{
+  // Nothing to do.
+}
+
+inline bool StreamingCSVReader::ReadChunk(arma::mat& chunk)
+{
+  if (dimensionality > 0)
+    chunk.set_size(dimensionality, chunkSize);
+
+  size_t count = 0;
+  std::string row;
+  std::vector<double> values;
+  while (count < chunkSize && std::getline(stream, row))
+  {
+    ++line;
+
+    // Tolerate CRLF line endings and skip empty lines.
+    if (!row.empty() && row.back() == '\r')
+      row.pop_back();
+    if (row.empty())
+      continue;
+
+    values.clear();
+    std::stringstream tokens(row);
+    std::string cell;
+    while (std::getline(tokens, cell, ','))
+    {
+      char* end = NULL;
+      const double value = std::strtod(cell.c_str(), &end);
+      if (end == cell.c_str())
+      {
+        throw std::runtime_error("StreamingCSVReader::ReadChunk(): could not "
+            "parse value '" + cell + "' on line " + std::to_string(line) +
+            "!");
+      }
+      values.push_back(value);
+    }
+
+    // The first row fixes the dimensionality.
+    if (dimensionality == 0)
+    {
+      dimensionality = values.size();
+      chunk.set_size(dimensionality, chunkSize);
+    }
+    else if (values.size() != dimensionality)
+    {
+      throw std::runtime_error("StreamingCSVReader::ReadChunk(): line " +
+          std::to_string(line) + " has " + std::to_string(values.size()) +
+          " values, but the first row had " +
+          std::to_string(dimensionality) + "!");
+    }
+
+    for (size_t d = 0; d < dimensionality; ++d)
+      chunk(d, count) = values[d];
+    ++count;
+  }
+
+  if (count == 0)
+  {
+    chunk.set_size(dimensionality, 0);
+    return false;
+  }
+
+  chunk.resize(dimensionality, count);
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
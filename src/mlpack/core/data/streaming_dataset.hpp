@@ -0,0 +1,158 @@
+/**
+ * @file core/data/streaming_dataset.hpp
+ * @author Jianxin Zhang
+ *
+ * A chunked, double-buffered reader for datasets that are too large to fit in
+ * RAM.  The dataset is read from an on-disk column-major arma_binary file in
+ * fixed-size column batches, and the next batch is prefetched asynchronously
+ * while the caller works on the current one, so SGD-style trainers can stream
+ * over datasets much larger than memory at near-disk speed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STREAMING_DATASET_HPP
+#define MLPACK_CORE_DATA_STREAMING_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <fstream>
+#include <future>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A streaming view of an on-disk column-major dataset.  The file must be in
+ * Armadillo binary format (arma_binary), whose header supplies the matrix
+ * dimensions; points are the columns of the matrix, matching mlpack's usual
+ * convention.
+ *
+ * Batches are yielded in order with NextBatch()/Batch(); Reset() rewinds to
+ * the first batch so the dataset can be swept multiple times (e.g. once per
+ * epoch).  Internally two buffers are held: while the caller works on the
+ * current batch, a background task reads the next one, so I/O overlaps with
+ * computation.  Peak memory usage is two batches, regardless of the size of
+ * the file.
+ *
+ * A typical training loop looks like this:
+ *
+ * @code
+ * data::StreamingDataset<> stream("dataset.bin", 10000);
+ * for (size_t epoch = 0; epoch < epochs; ++epoch)
+ * {
+ *   stream.Reset();
+ *   while (stream.NextBatch())
+ *     UpdateModel(stream.Batch(), stream.BatchOffset());
+ * }
+ * @endcode
+ *
+ * @tparam eT Element type of the dataset.
+ */
+template<typename eT = double>
+class StreamingDataset
+{
+ public:
+  /**
+   * Open the given arma_binary file for streaming.  Throws a
+   * std::runtime_error if the file cannot be opened or is not an arma_binary
+   * file of the right element type.
+   *
+   * @param filename File holding the dataset in arma_binary format.
+   * @param batchSize Number of columns (points) per batch.
+   */
+  StreamingDataset(const std::string& filename, const size_t batchSize);
+
+  //! Wait for any in-flight prefetch and close the file.
+  ~StreamingDataset();
+
+  //! The reader owns background I/O state and cannot be copied.
+  StreamingDataset(const StreamingDataset&) = delete;
+  //! The reader owns background I/O state and cannot be copied.
+  StreamingDataset& operator=(const StreamingDataset&) = delete;
+
+  /**
+   * Advance to the next batch, blocking until its prefetch has finished, and
+   * kick off the prefetch of the batch after it.
+   *
+   * @return true if a new batch is available, false if the dataset has been
+   *     fully consumed.
+   */
+  bool NextBatch();
+
+  //! Rewind to the start of the dataset (e.g. for the next epoch).
+  void Reset();
+
+  /**
+   * Overwrite the on-disk contents of the current batch with the given
+   * matrix, which must have the same size as the current batch.  This is
+   * meant for in-place streaming transformations: copy Batch(), modify the
+   * copy, and write it back before advancing to the next batch.  The write
+   * goes through a separate file handle, so it does not disturb the
+   * prefetch of the following batch.
+   *
+   * @param batch Data to write over the current batch.
+   */
+  void WriteBatch(const arma::Mat<eT>& batch);
+
+  //! Get the current batch; only valid after NextBatch() has returned true.
+  //! The view is invalidated by the next call to NextBatch() or Reset().
+  const arma::Mat<eT>& Batch() const { return current; }
+
+  //! Get the index of the first column of the current batch within the full
+  //! dataset (e.g. to index into a label row).
+  size_t BatchOffset() const { return batchOffset; }
+
+  //! Get the dimensionality of the dataset.
+  size_t Rows() const { return rows; }
+  //! Get the total number of points (columns) in the dataset.
+  size_t Cols() const { return cols; }
+  //! Get the number of columns per full batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Get the number of batches per sweep over the dataset.
+  size_t NumBatches() const { return (cols + batchSize - 1) / batchSize; }
+
+ private:
+  //! Synchronously read the batch starting at column `col` into `m`.
+  void ReadBatch(arma::Mat<eT>& m, const size_t col);
+
+  //! Start the asynchronous read of the batch starting at column `col`.
+  void Prefetch(const size_t col);
+
+  //! Name of the on-disk file.
+  std::string filename;
+  //! Stream the batches are read from (only touched by the prefetch task
+  //! after construction).
+  std::ifstream stream;
+  //! Byte offset of the first matrix element in the file.
+  size_t dataOffset;
+
+  //! Dimensionality of the dataset.
+  size_t rows;
+  //! Total number of points in the dataset.
+  size_t cols;
+  //! Number of columns per batch.
+  size_t batchSize;
+
+  //! The batch the caller is working on.
+  arma::Mat<eT> current;
+  //! The batch being filled by the prefetch task.
+  arma::Mat<eT> next;
+  //! The in-flight prefetch, if any.
+  std::future<void> prefetch;
+
+  //! First column of the current batch.
+  size_t batchOffset;
+  //! First column of the batch being prefetched.
+  size_t nextOffset;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#include "streaming_dataset_impl.hpp"
+
+#endif
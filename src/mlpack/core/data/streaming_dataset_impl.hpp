@@ -0,0 +1,163 @@
+/**
+ * @file core/data/streaming_dataset_impl.hpp
+ * @author Jianxin Zhang
+ *
+ * Implementation of the chunked, double-buffered out-of-core dataset reader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STREAMING_DATASET_IMPL_HPP
+#define MLPACK_CORE_DATA_STREAMING_DATASET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "streaming_dataset.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+StreamingDataset<eT>::StreamingDataset(const std::string& filename,
+                                       const size_t batchSize) :
+    filename(filename),
+    stream(filename, std::ios::binary),
+    dataOffset(0),
+    rows(0),
+    cols(0),
+    batchSize(batchSize),
+    batchOffset(0),
+    nextOffset(0)
+{
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("StreamingDataset: cannot open file '" +
+        filename + "'!");
+  }
+
+  // The arma_binary header is two text lines: the format/element-type tag,
+  // then the matrix dimensions; the raw element data follows immediately.
+  std::string header;
+  std::getline(stream, header);
+  const std::string expected = arma::diskio::gen_bin_header(arma::Mat<eT>());
+  if (header != expected)
+  {
+    throw std::runtime_error("StreamingDataset: '" + filename + "' is not an "
+        "arma_binary file of the requested element type (got header '" +
+        header + "', expected '" + expected + "')!");
+  }
+
+  arma::uword r, c;
+  stream >> r >> c;
+  stream.get(); // Eat the newline that terminates the dimension line.
+  rows = (size_t) r;
+  cols = (size_t) c;
+  dataOffset = (size_t) stream.tellg();
+
+  if (batchSize == 0)
+    throw std::runtime_error("StreamingDataset: batch size must be nonzero!");
+
+  Reset();
+}
+
+template<typename eT>
+StreamingDataset<eT>::~StreamingDataset()
+{
+  // Make sure the background read is not still touching the stream.
+  if (prefetch.valid())
+    prefetch.wait();
+}
+
+template<typename eT>
+void StreamingDataset<eT>::ReadBatch(arma::Mat<eT>& m, const size_t col)
+{
+  const size_t n = std::min(batchSize, cols - col);
+  m.set_size(rows, n);
+
+  stream.clear();
+  stream.seekg(dataOffset + col * rows * sizeof(eT));
+  stream.read((char*) m.memptr(), rows * n * sizeof(eT));
+
+  if (!stream)
+  {
+    throw std::runtime_error("StreamingDataset: short read from '" + filename +
+        "'; file truncated?");
+  }
+}
+
+template<typename eT>
+void StreamingDataset<eT>::Prefetch(const size_t col)
+{
+  if (col >= cols)
+    return;
+
+  prefetch = std::async(std::launch::async,
+      [this, col]() { this->ReadBatch(this->next, col); });
+}
+
+template<typename eT>
+void StreamingDataset<eT>::Reset()
+{
+  // A prefetch launched before the reset may still be in flight; let it finish
+  // before reusing the stream and the buffer.
+  if (prefetch.valid())
+    prefetch.wait();
+
+  batchOffset = 0;
+  nextOffset = 0;
+  Prefetch(0);
+}
+
+template<typename eT>
+void StreamingDataset<eT>::WriteBatch(const arma::Mat<eT>& batch)
+{
+  if (batch.n_rows != rows || batch.n_cols != current.n_cols)
+  {
+    throw std::runtime_error("StreamingDataset: WriteBatch() expects a matrix "
+        "of the same size as the current batch!");
+  }
+
+  // The prefetch task only touches the region of the following batch, which
+  // is disjoint from the region written here.
+  std::fstream out(filename, std::ios::binary | std::ios::in | std::ios::out);
+  if (!out.is_open())
+  {
+    throw std::runtime_error("StreamingDataset: cannot reopen file '" +
+        filename + "' for writing!");
+  }
+
+  out.seekp(dataOffset + batchOffset * rows * sizeof(eT));
+  out.write((const char*) batch.memptr(), rows * batch.n_cols * sizeof(eT));
+
+  if (!out)
+  {
+    throw std::runtime_error("StreamingDataset: short write to '" + filename +
+        "'!");
+  }
+}
+
+template<typename eT>
+bool StreamingDataset<eT>::NextBatch()
+{
+  if (!prefetch.valid())
+    return false; // The dataset has been fully consumed.
+
+  // Wait for the background read of the batch we are about to hand out; this
+  // rethrows any I/O error raised by the prefetch task.
+  prefetch.get();
+
+  current.swap(next);
+  batchOffset = nextOffset;
+
+  // Start reading the following batch while the caller works on this one.
+  nextOffset = batchOffset + current.n_cols;
+  Prefetch(nextOffset);
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -119,6 +119,38 @@ class StringEncoding
               OutputType& output,
               const TokenizerType& tokenizer);
 
+  /**
+   * Encode the given text in parallel and write the result to the given
+   * output.  The result is identical to the one produced by Encode(): each
+   * thread tokenizes a contiguous block of documents into its own
+   * dictionary, the thread-local dictionaries are merged in block order
+   * (which reproduces the labels the sequential pass would assign), and the
+   * stored token labels are remapped and written to the output.  Since
+   * tokenization dominates the cost of encoding a large corpus, this scales
+   * with the number of threads when OpenMP is available; without OpenMP it
+   * is equivalent to Encode().
+   *
+   * @tparam OutputType Type of the output container. The function supports
+   *                    the following types: arma::mat, arma::sp_mat,
+   *                    std::vector<std::vector<>>.
+   * @tparam TokenizerType Type of the tokenizer.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output container to store the result.
+   * @param tokenizer The tokenizer object.
+   *
+   * The tokenization algorithm has to be an object with two public methods:
+   * 1. operator() which accepts a reference to STRING_VIEW, extracts
+   * the next token from the given view, removes the prefix containing
+   * the extracted token and returns the token;
+   * 2. IsTokenEmpty() that accepts a token and returns true if the given
+   *    token is empty.
+   */
+  template<typename OutputType, typename TokenizerType>
+  void ParallelEncode(const std::vector<std::string>& input,
+                      OutputType& output,
+                      const TokenizerType& tokenizer);
+
   //! Return the dictionary.
   const DictionaryType& Dictionary() const { return dictionary; }
   //! Modify the dictionary.
@@ -201,6 +233,73 @@ class StringEncoding
                     typename std::enable_if<StringEncodingPolicyTraits<
                         PolicyType>::onePassEncoding>::type* = 0);
 
+  /**
+   * Tokenize the given corpus in parallel and write the assigned token
+   * labels to the given sequences.  Each thread tokenizes a contiguous
+   * block of documents into a thread-local dictionary; the local
+   * dictionaries are then merged into the main dictionary in block order,
+   * so the labels match the ones a sequential pass over the corpus would
+   * assign, and the stored sequences are remapped accordingly.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   *
+   * @param input Corpus of text to tokenize.
+   * @param tokenizer The tokenizer object.
+   * @param sequences The token labels of each document, in document order.
+   */
+  template<typename TokenizerType>
+  void TokenizeInParallel(const std::vector<std::string>& input,
+                          const TokenizerType& tokenizer,
+                          std::vector<std::vector<size_t>>& sequences);
+
+  /**
+   * A helper function to encode the given text in parallel and write the
+   * result to the given output.  The tokenization is distributed over the
+   * threads; the stored token labels are then replayed through the policy
+   * in document order, so the result is identical to EncodeHelper().
+   *
+   * @tparam OutputType Type of the output container. The function supports
+   *                    the following types: arma::mat, arma::sp_mat,
+   *                    std::vector<std::vector<>>.
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output container to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   */
+  template<typename OutputType, typename TokenizerType, typename PolicyType>
+  void ParallelEncodeHelper(const std::vector<std::string>& input,
+                            OutputType& output,
+                            const TokenizerType& tokenizer,
+                            PolicyType& policy);
+
+  /**
+   * A helper function to encode the given text in parallel and write the
+   * result to the given output.  This is the overload for policies that
+   * support the one pass encoding algorithm; the stored token labels are
+   * simply remapped and appended to the output rows.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output container to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void ParallelEncodeHelper(const std::vector<std::string>& input,
+                            std::vector<std::vector<ElemType>>& output,
+                            const TokenizerType& tokenizer,
+                            PolicyType& policy,
+                            typename std::enable_if<StringEncodingPolicyTraits<
+                                PolicyType>::onePassEncoding>::type* = 0);
+
  private:
   //! The encoding policy object.
   EncodingPolicyType encodingPolicy;
@@ -97,6 +97,183 @@ void StringEncoding<EncodingPolicyType, DictionaryType>::Encode(
 }
 
 
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename OutputType, typename TokenizerType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::ParallelEncode(
+    const std::vector<std::string>& input,
+    OutputType& output,
+    const TokenizerType& tokenizer)
+{
+  ParallelEncodeHelper(input, output, tokenizer, encodingPolicy);
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::TokenizeInParallel(
+    const std::vector<std::string>& input,
+    const TokenizerType& tokenizer,
+    std::vector<std::vector<size_t>>& sequences)
+{
+  using TokenType = typename std::decay<typename DictionaryType::
+      TokenType>::type;
+
+  sequences.clear();
+  sequences.resize(input.size());
+
+  if (input.empty())
+    return;
+
+#ifdef HAS_OPENMP
+  const size_t numThreads = (size_t) omp_get_max_threads();
+#else
+  const size_t numThreads = 1;
+#endif
+
+  // Each thread tokenizes a contiguous block of documents into its own
+  // dictionary, remembering the tokens in first-seen order.  Within a
+  // block, the first-seen order is exactly the order a sequential pass
+  // would visit the new tokens in.
+  const size_t blockSize = (input.size() + numThreads - 1) / numThreads;
+  const size_t numBlocks = (input.size() + blockSize - 1) / blockSize;
+  std::vector<DictionaryType> localDictionaries(numBlocks);
+  std::vector<std::vector<TokenType>> localTokens(numBlocks);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    DictionaryType& localDictionary = localDictionaries[block];
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, input.size());
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      STRING_VIEW strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       typename std::remove_reference<typename DictionaryType::
+                          TokenType>::type>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        size_t label;
+
+        if (!localDictionary.HasToken(token))
+        {
+          localTokens[block].push_back(token);
+          label = localDictionary.AddToken(std::move(token));
+        }
+        else
+        {
+          label = localDictionary.Value(token);
+        }
+
+        sequences[i].push_back(label);
+        token = tokenizer(strView);
+      }
+    }
+  }
+
+  // Merge the local dictionaries into the main dictionary in block order,
+  // which assigns exactly the labels the sequential pass would assign.  The
+  // local labels are one-based, so slot zero of each remap stays unused.
+  std::vector<std::vector<size_t>> remaps(numBlocks);
+  for (size_t block = 0; block < numBlocks; ++block)
+  {
+    remaps[block].resize(localTokens[block].size() + 1);
+    for (size_t t = 0; t < localTokens[block].size(); ++t)
+    {
+      TokenType& token = localTokens[block][t];
+
+      if (dictionary.HasToken(token))
+        remaps[block][t + 1] = dictionary.Value(token);
+      else
+        remaps[block][t + 1] = dictionary.AddToken(std::move(token));
+    }
+  }
+
+  // Rewrite the stored local labels as global ones.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, input.size());
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      for (size_t& label : sequences[i])
+        label = remaps[block][label];
+    }
+  }
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename OutputType, typename TokenizerType, typename PolicyType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+ParallelEncodeHelper(const std::vector<std::string>& input,
+                     OutputType& output,
+                     const TokenizerType& tokenizer,
+                     PolicyType& policy)
+{
+  policy.Reset();
+
+  std::vector<std::vector<size_t>> sequences;
+  TokenizeInParallel(input, tokenizer, sequences);
+
+  // Replay the stored labels through the policy in document order; this
+  // pass touches no strings and is cheap compared to the tokenization.
+  size_t numColumns = 0;
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    for (size_t j = 0; j < sequences[i].size(); ++j)
+      policy.PreprocessToken(i, j, sequences[i][j]);
+
+    numColumns = std::max(numColumns, sequences[i].size());
+  }
+
+  policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
+
+  // Each document writes only to its own column (or row) of the output, so
+  // the encoding pass runs in parallel for dense outputs.  Element access
+  // on a sparse matrix may insert into the shared storage and is not
+  // thread-safe, so that case stays sequential.
+  #pragma omp parallel for schedule(static) \
+      if (!arma::is_arma_sparse_type<OutputType>::value)
+  for (omp_size_t i = 0; i < (omp_size_t) sequences.size(); ++i)
+  {
+    for (size_t j = 0; j < sequences[i].size(); ++j)
+      policy.Encode(output, sequences[i][j], i, j);
+  }
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+ParallelEncodeHelper(const std::vector<std::string>& input,
+                     std::vector<std::vector<ElemType>>& output,
+                     const TokenizerType& tokenizer,
+                     PolicyType& policy,
+                     typename std::enable_if<StringEncodingPolicyTraits<
+                         PolicyType>::onePassEncoding>::type*)
+{
+  policy.Reset();
+
+  std::vector<std::vector<size_t>> sequences;
+  TokenizeInParallel(input, tokenizer, sequences);
+
+  output.resize(input.size());
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) sequences.size(); ++i)
+  {
+    for (size_t j = 0; j < sequences[i].size(); ++j)
+      policy.Encode(output[i], sequences[i][j]);
+  }
+}
+
 template<typename EncodingPolicyType, typename DictionaryType>
 template<typename MatType, typename TokenizerType, typename PolicyType>
 void StringEncoding<EncodingPolicyType, DictionaryType>::
@@ -0,0 +1,254 @@
+/**
+ * @file core/data/transform_pipeline.hpp
+ * @author Keon Kim
+ *
+ * Defines TransformPipeline, a composable chain of elementwise transforms
+ * that is applied to a matrix in a single parallel pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_TRANSFORM_PIPELINE_HPP
+#define MLPACK_CORE_DATA_TRANSFORM_PIPELINE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <tuple>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Binarize an element against a threshold: values greater than the threshold
+ * become 1 and all other values become 0.  This is the elementwise transform
+ * behind Binarize() (see binarize.hpp), in a form that can be chained in a
+ * TransformPipeline.
+ */
+class BinarizeTransform
+{
+ public:
+  //! Construct the transform with the given threshold.
+  explicit BinarizeTransform(const double threshold) : threshold(threshold) { }
+
+  //! Apply the transform to one element.
+  template<typename T>
+  T operator()(const T value) const { return (T) (value > threshold); }
+
+ private:
+  //! The binarization threshold.
+  double threshold;
+};
+
+/**
+ * Shift an element by a constant offset.
+ */
+class ShiftTransform
+{
+ public:
+  //! Construct the transform with the given offset.
+  explicit ShiftTransform(const double offset) : offset(offset) { }
+
+  //! Apply the transform to one element.
+  template<typename T>
+  T operator()(const T value) const { return (T) (value + offset); }
+
+ private:
+  //! The offset to add to each element.
+  double offset;
+};
+
+/**
+ * Scale an element by a constant factor.
+ */
+class ScaleTransform
+{
+ public:
+  //! Construct the transform with the given factor.
+  explicit ScaleTransform(const double factor) : factor(factor) { }
+
+  //! Apply the transform to one element.
+  template<typename T>
+  T operator()(const T value) const { return (T) (value * factor); }
+
+ private:
+  //! The factor to multiply each element by.
+  double factor;
+};
+
+/**
+ * Clamp an element into the range [min, max].
+ */
+class ClampTransform
+{
+ public:
+  //! Construct the transform with the given range.
+  ClampTransform(const double min, const double max) : min(min), max(max) { }
+
+  //! Apply the transform to one element.
+  template<typename T>
+  T operator()(const T value) const
+  {
+    return (value < min) ? (T) min : ((value > max) ? (T) max : value);
+  }
+
+ private:
+  //! The lower bound of the range.
+  double min;
+  //! The upper bound of the range.
+  double max;
+};
+
+/**
+ * TransformPipeline chains elementwise transforms and applies the whole chain
+ * to each element in a single pass over the matrix, parallelized over blocks
+ * of elements.  Preprocessing chains built from separate calls (Binarize(),
+ * shifting, scaling, ...) scan and allocate once per step; a pipeline reads
+ * and writes each element exactly once however many transforms are chained.
+ *
+ * Transforms are applied in the order they were chained.  Any type with a
+ * 'T operator()(T) const' call operator can be used as a transform, including
+ * lambdas.
+ *
+ * @code
+ * arma::mat data = loadData();
+ *
+ * // Scale to [0, 1], then binarize against 0.5, in one pass and in place.
+ * auto pipeline = MakeTransformPipeline(ScaleTransform(1.0 / 255.0))
+ *     .Then(BinarizeTransform(0.5));
+ * pipeline.Apply(data);
+ * @endcode
+ *
+ * @tparam TransformTypes Types of the chained elementwise transforms.
+ */
+template<typename... TransformTypes>
+class TransformPipeline
+{
+ public:
+  /**
+   * Construct the pipeline from instantiated transforms.  Prefer
+   * MakeTransformPipeline(), which deduces the transform types.
+   *
+   * @param transforms Instantiated transforms, applied in the given order.
+   */
+  explicit TransformPipeline(TransformTypes... transforms) :
+      transforms(std::move(transforms)...)
+  { }
+
+  /**
+   * Return a new pipeline with the given transform appended to the chain.
+   *
+   * @param next Transform to apply after the current chain.
+   */
+  template<typename NextTransformType>
+  TransformPipeline<TransformTypes..., NextTransformType> Then(
+      NextTransformType next) const
+  {
+    return ThenImpl(std::move(next),
+        std::index_sequence_for<TransformTypes...>());
+  }
+
+  /**
+   * Apply the whole chain to each element of the matrix in place, in one
+   * parallel pass and without allocating a copy.
+   *
+   * @param data Matrix to transform.
+   */
+  template<typename T>
+  void Apply(arma::Mat<T>& data) const
+  {
+    T* ptr = data.memptr();
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_elem; ++i)
+      ptr[i] = ApplyFrom<0>(ptr[i]);
+  }
+
+  /**
+   * Apply the whole chain to each element of the input matrix, writing the
+   * result into the output matrix in one parallel pass.
+   *
+   * @param input Matrix to transform.
+   * @param output Matrix to write the transformed elements into.
+   */
+  template<typename T>
+  void Apply(const arma::Mat<T>& input, arma::Mat<T>& output) const
+  {
+    output.copy_size(input);
+
+    const T* inPtr = input.memptr();
+    T* outPtr = output.memptr();
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_elem; ++i)
+      outPtr[i] = ApplyFrom<0>(inPtr[i]);
+  }
+
+  /**
+   * Apply the whole chain to a single dimension (row) of the matrix in
+   * place, in one parallel pass.
+   *
+   * @param data Matrix to transform.
+   * @param dimension Dimension (row) to apply the chain to.
+   */
+  template<typename T>
+  void Apply(arma::Mat<T>& data, const size_t dimension) const
+  {
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+      data(dimension, i) = ApplyFrom<0>(data(dimension, i));
+  }
+
+  /**
+   * Apply the whole chain to a single element.
+   *
+   * @param value Element to transform.
+   */
+  template<typename T>
+  T ApplyElement(const T value) const { return ApplyFrom<0>(value); }
+
+ private:
+  //! Apply the transforms starting at index I; end of the recursion.
+  template<size_t I, typename T>
+  typename std::enable_if<I == sizeof...(TransformTypes), T>::type
+  ApplyFrom(const T value) const { return value; }
+
+  //! Apply the transforms starting at index I.
+  template<size_t I, typename T>
+  typename std::enable_if<I < sizeof...(TransformTypes), T>::type
+  ApplyFrom(const T value) const
+  {
+    return ApplyFrom<I + 1>((T) std::get<I>(transforms)(value));
+  }
+
+  //! Build the extended pipeline by unpacking the current transforms.
+  template<typename NextTransformType, size_t... Is>
+  TransformPipeline<TransformTypes..., NextTransformType> ThenImpl(
+      NextTransformType next, std::index_sequence<Is...>) const
+  {
+    return TransformPipeline<TransformTypes..., NextTransformType>(
+        std::get<Is>(transforms)..., std::move(next));
+  }
+
+  //! The instantiated transforms, in application order.
+  std::tuple<TransformTypes...> transforms;
+};
+
+/**
+ * Construct a TransformPipeline from the given transforms, deducing the
+ * transform types.
+ *
+ * @param transforms Instantiated transforms, applied in the given order.
+ */
+template<typename... TransformTypes>
+TransformPipeline<TransformTypes...> MakeTransformPipeline(
+    TransformTypes... transforms)
+{
+  return TransformPipeline<TransformTypes...>(std::move(transforms)...);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
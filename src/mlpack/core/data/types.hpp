@@ -37,7 +37,8 @@ enum struct FileType
   PGMBinary,         //!< Portable Grey Map (greyscale image)
   PPMBinary,         //!< Portable Pixel Map (colour image), used by the field and cube classes
   HDF5Binary,        //!< HDF5: open binary format, not specific to Armadillo, which can store arbitrary data
-  CoordASCII         //!< simple co-ordinate format for sparse matrices (indices start at zero)
+  CoordASCII,        //!< simple co-ordinate format for sparse matrices (indices start at zero)
+  MlpackBinary       //!< mlpack native binary format, with aligned payload and optional compression
 };
 
 /**
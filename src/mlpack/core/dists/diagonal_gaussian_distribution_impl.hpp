@@ -45,8 +45,11 @@ inline double DiagonalGaussianDistribution::LogProbability(
 {
   const size_t k = observation.n_elem;
   const arma::vec diff = observation - mean;
-  const arma::vec logExponent = diff.t() * arma::diagmat(invCov) * diff;
-  return -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * logExponent(0);
+
+  // The inverse covariance is diagonal, so the exponent is just a weighted
+  // dot product; there is no need to form a d x d matrix for it.
+  return -0.5 * k * log2pi - 0.5 * logDetCov -
+      0.5 * arma::dot(diff % diff, invCov);
 }
 
 inline void DiagonalGaussianDistribution::LogProbability(
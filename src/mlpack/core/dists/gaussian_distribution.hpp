@@ -162,6 +162,19 @@ class GaussianDistribution
 
   void Covariance(arma::mat&& covariance);
 
+  /**
+   * Set the covariance together with its precomputed factorization, skipping
+   * the internal refactorization.  The caller is responsible for the
+   * consistency of the arguments: covLower must be the lower Cholesky factor
+   * of the covariance, invCov its inverse, and logDetCov its
+   * log-determinant.  Batched fitters use this together with
+   * math::BatchCholesky() to factor many small covariances at once.
+   */
+  void Covariance(arma::mat&& covariance,
+                  arma::mat&& covLower,
+                  arma::mat&& invCov,
+                  const double logDetCov);
+
   //! Return the invCov.
   const arma::mat& InvCov() const { return invCov; }
 
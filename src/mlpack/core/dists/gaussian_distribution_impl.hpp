@@ -40,6 +40,17 @@ inline void GaussianDistribution::Covariance(arma::mat&& covariance)
   FactorCovariance();
 }
 
+inline void GaussianDistribution::Covariance(arma::mat&& covariance,
+                                             arma::mat&& covLower,
+                                             arma::mat&& invCov,
+                                             const double logDetCov)
+{
+  this->covariance = std::move(covariance);
+  this->covLower = std::move(covLower);
+  this->invCov = std::move(invCov);
+  this->logDetCov = logDetCov;
+}
+
 inline void GaussianDistribution::FactorCovariance()
 {
   // On Armadillo < 4.500, the "lower" option isn't available.
@@ -0,0 +1,246 @@
+/**
+ * @file core/dists/low_rank_gaussian_distribution.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the Gaussian distribution with low-rank-plus-diagonal
+ * (factor analysis style) covariance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTIONS_LOW_RANK_GAUSSIAN_DISTRIBUTION_HPP
+#define MLPACK_CORE_DISTRIBUTIONS_LOW_RANK_GAUSSIAN_DISTRIBUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace distribution /** Probability distributions. */ {
+
+/**
+ * A single multivariate Gaussian distribution whose covariance is constrained
+ * to the low-rank-plus-diagonal (factor analysis) form
+ *
+ * @f[
+ * \Sigma = \Psi + W W^T
+ * @f]
+ *
+ * where @f$ W @f$ is a d x r factor loading matrix with @f$ r \ll d @f$ and
+ * @f$ \Psi @f$ is a positive diagonal noise matrix, stored as a vector.  The
+ * covariance is never materialized: the density is evaluated through the
+ * Woodbury identity and the matrix determinant lemma, so a single
+ * log-probability costs O(d r) instead of the O(d^2) of the full Gaussian
+ * (and training never pays the O(d^3) inversion).  This makes the class a
+ * drop-in emission or mixture component for high-dimensional problems; it
+ * implements the same interface as GaussianDistribution and
+ * DiagonalGaussianDistribution, and can be used with HMM<> or EMFit<> as the
+ * distribution type.
+ *
+ * The rank of the distribution is fixed by the number of columns of the
+ * factor matrix, which is set at construction time (or via Factors()).
+ * Train() fits the factor analysis model with a fixed number of EM
+ * iterations, holding the rank constant.  With rank 0 the distribution
+ * degenerates to a diagonal-covariance Gaussian.
+ */
+class LowRankGaussianDistribution
+{
+ private:
+  //! Mean of the distribution.
+  arma::vec mean;
+  //! Factor loading matrix W (d x r).
+  arma::mat factors;
+  //! Diagonal noise term of the covariance.
+  arma::vec noise;
+  //! Number of EM iterations used by Train().
+  size_t trainIterations;
+
+  //! Cached inverse of the diagonal noise term.
+  arma::vec invNoise;
+  //! Cached inverse of the capacitance matrix (I_r + W^T Psi^-1 W).
+  arma::mat invCapacitance;
+  //! Cached logdet(cov), via the matrix determinant lemma.
+  double logDetCov;
+
+  //! log(2pi)
+  static const constexpr double log2pi = 1.83787706640934533908193770912475883;
+
+ public:
+  //! Default constructor, which creates a Gaussian with zero dimension.
+  LowRankGaussianDistribution() : trainIterations(10), logDetCov(0.0)
+  { /* nothing to do. */ }
+
+  /**
+   * Create a Gaussian distribution with zero mean and unit covariance with
+   * the given dimensionality and rank.  The factor matrix is initialized to
+   * zero, so the covariance starts as the identity; Train() will fill it in.
+   *
+   * @param dimension Number of dimensions.
+   * @param rank Number of columns of the factor matrix.
+   */
+  LowRankGaussianDistribution(const size_t dimension, const size_t rank) :
+      mean(arma::zeros<arma::vec>(dimension)),
+      factors(arma::zeros<arma::mat>(dimension, rank)),
+      noise(arma::ones<arma::vec>(dimension)),
+      trainIterations(10),
+      invNoise(arma::ones<arma::vec>(dimension)),
+      invCapacitance(arma::eye<arma::mat>(rank, rank)),
+      logDetCov(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Create a Gaussian distribution with the given mean, factor matrix and
+   * diagonal noise term; the covariance is diagmat(noise) + factors *
+   * factors^T.
+   *
+   * @param mean Mean of distribution.
+   * @param factors Factor loading matrix of the covariance (d x r).
+   * @param noise Diagonal noise term of the covariance.
+   */
+  LowRankGaussianDistribution(const arma::vec& mean,
+                              const arma::mat& factors,
+                              const arma::vec& noise);
+
+  //! Return the dimensionality of this distribution.
+  size_t Dimensionality() const { return mean.n_elem; }
+
+  //! Return the rank of the factor matrix.
+  size_t Rank() const { return factors.n_cols; }
+
+  //! Return the probability of the given observation.
+  double Probability(const arma::vec& observation) const
+  {
+    return exp(LogProbability(observation));
+  }
+
+  //! Return the log probability of the given observation.
+  double LogProbability(const arma::vec& observation) const;
+
+  /**
+   * Calculate the multivariate Gaussian probability density function for each
+   * data point (column) in the given matrix.
+   *
+   * @param x Matrix of observations.
+   * @param probabilities Output probabilities for each input observation.
+   */
+  void Probability(const arma::mat& x, arma::vec& probabilities) const
+  {
+    arma::vec logProbabilities;
+    LogProbability(x, logProbabilities);
+    probabilities = arma::exp(logProbabilities);
+  }
+
+  /**
+   * Calculate the multivariate Gaussian log probability density function for
+   * each data point (column) in the given matrix.
+   *
+   * @param observations Matrix of observations.
+   * @param logProbabilities Output log probabilities for each observation.
+   */
+  void LogProbability(const arma::mat& observations,
+                      arma::vec& logProbabilities) const;
+
+  /**
+   * Return a randomly generated observation according to the probability
+   * distribution defined by this object.  This uses the generative factor
+   * analysis model directly, so it costs O(d r) and never forms the
+   * covariance.
+   *
+   * @return Random observation from this low-rank Gaussian distribution.
+   */
+  arma::vec Random() const;
+
+  /**
+   * Estimate the factor analysis model directly from the given observations,
+   * using EM with a fixed number of iterations (TrainingIterations()).  The
+   * rank is held at its current value (Rank()); the factor matrix is used as
+   * a warm start when it has the right size and is nonzero.  Maximum
+   * likelihood (1 / n) normalization is used, as is standard for the EM
+   * updates.
+   *
+   * @param observations Matrix of observations.
+   */
+  void Train(const arma::mat& observations);
+
+  /**
+   * Estimate the factor analysis model from the given observations, taking
+   * into account the probability of each observation actually being from
+   * this distribution.
+   *
+   * @param observations Matrix of observations.
+   * @param probabilities List of probability of the each observation being
+   * from this distribution.
+   */
+  void Train(const arma::mat& observations,
+             const arma::vec& probabilities);
+
+  //! Return the mean.
+  const arma::vec& Mean() const { return mean; }
+
+  //! Return a modifiable copy of the mean.
+  arma::vec& Mean() { return mean; }
+
+  //! Return the factor loading matrix.
+  const arma::mat& Factors() const { return factors; }
+
+  //! Set the factor loading matrix.
+  void Factors(const arma::mat& factors);
+
+  //! Set the factor loading matrix using move assignment.
+  void Factors(arma::mat&& factors);
+
+  //! Return the diagonal noise term of the covariance.
+  const arma::vec& Noise() const { return noise; }
+
+  //! Set the diagonal noise term of the covariance.
+  void Noise(const arma::vec& noise);
+
+  //! Set the diagonal noise term of the covariance using move assignment.
+  void Noise(arma::vec&& noise);
+
+  /**
+   * Return the full covariance matrix diagmat(noise) + factors * factors^T.
+   * Note that this materializes a d x d matrix, so it should only be used
+   * when the dimensionality is small (e.g. for testing or inspection).
+   */
+  arma::mat Covariance() const
+  {
+    return arma::diagmat(noise) + factors * arma::trans(factors);
+  }
+
+  //! Return the number of EM iterations used by Train().
+  size_t TrainingIterations() const { return trainIterations; }
+
+  //! Modify the number of EM iterations used by Train().
+  size_t& TrainingIterations() { return trainIterations; }
+
+  //! Serialize the distribution.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    // We just need to serialize each of the members.
+    ar(CEREAL_NVP(mean));
+    ar(CEREAL_NVP(factors));
+    ar(CEREAL_NVP(noise));
+    ar(CEREAL_NVP(trainIterations));
+    ar(CEREAL_NVP(invNoise));
+    ar(CEREAL_NVP(invCapacitance));
+    ar(CEREAL_NVP(logDetCov));
+  }
+
+ private:
+  /**
+   * Recompute the cached Woodbury quantities (the inverse noise, the inverse
+   * of the capacitance matrix I_r + W^T Psi^-1 W, and logdet(cov)) after the
+   * factors or the noise term have changed.
+   */
+  void UpdateWoodburyCache();
+};
+
+} // namespace distribution
+} // namespace mlpack
+
+// Include implementation.
+#include "low_rank_gaussian_distribution_impl.hpp"
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file core/dists/low_rank_gaussian_distribution_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the Gaussian distribution class with
+ * low-rank-plus-diagonal (factor analysis style) covariance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTIONS_LOW_RANK_GAUSSIAN_DISTRIBUTION_IMPL_HPP
+#define MLPACK_CORE_DISTRIBUTIONS_LOW_RANK_GAUSSIAN_DISTRIBUTION_IMPL_HPP
+
+#include "low_rank_gaussian_distribution.hpp"
+
+namespace mlpack {
+namespace distribution /** Probability distributions. */ {
+
+inline LowRankGaussianDistribution::LowRankGaussianDistribution(
+    const arma::vec& mean,
+    const arma::mat& factors,
+    const arma::vec& noise) :
+    mean(mean),
+    factors(factors),
+    noise(noise),
+    trainIterations(10)
+{
+  UpdateWoodburyCache();
+}
+
+inline void LowRankGaussianDistribution::Factors(const arma::mat& factors)
+{
+  this->factors = factors;
+  UpdateWoodburyCache();
+}
+
+inline void LowRankGaussianDistribution::Factors(arma::mat&& factors)
+{
+  this->factors = std::move(factors);
+  UpdateWoodburyCache();
+}
+
+inline void LowRankGaussianDistribution::Noise(const arma::vec& noise)
+{
+  this->noise = noise;
+  UpdateWoodburyCache();
+}
+
+inline void LowRankGaussianDistribution::Noise(arma::vec&& noise)
+{
+  this->noise = std::move(noise);
+  UpdateWoodburyCache();
+}
+
+inline void LowRankGaussianDistribution::UpdateWoodburyCache()
+{
+  invNoise = 1 / noise;
+
+  // Capacitance matrix of the Woodbury identity: I_r + W^T Psi^-1 W.  This
+  // is only r x r, so all of the work below is O(d r^2 + r^3).
+  const arma::mat capacitance =
+      arma::eye<arma::mat>(factors.n_cols, factors.n_cols) +
+      arma::trans(factors) * (factors.each_col() % invNoise);
+  invCapacitance = arma::inv_sympd(capacitance);
+
+  // logdet(cov) via the matrix determinant lemma:
+  // logdet(Psi + W W^T) = logdet(I_r + W^T Psi^-1 W) + logdet(Psi).
+  double logDetCapacitance, sign;
+  arma::log_det(logDetCapacitance, sign, capacitance);
+  logDetCov = logDetCapacitance + arma::accu(log(noise));
+}
+
+inline double LowRankGaussianDistribution::LogProbability(
+    const arma::vec& observation) const
+{
+  const size_t k = observation.n_elem;
+  const arma::vec diff = observation - mean;
+  const arma::vec scaled = diff % invNoise; // Psi^-1 (x - mu).
+  const arma::vec proj = arma::trans(factors) * scaled;
+
+  // Woodbury identity: (x - mu)^T Sigma^-1 (x - mu) =
+  // (x - mu)^T Psi^-1 (x - mu) - proj^T (I_r + W^T Psi^-1 W)^-1 proj,
+  // which only needs O(d r) work.
+  const double exponent = arma::dot(diff, scaled) -
+      arma::as_scalar(arma::trans(proj) * invCapacitance * proj);
+
+  return -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * exponent;
+}
+
+inline void LowRankGaussianDistribution::LogProbability(
+    const arma::mat& observations,
+    arma::vec& logProbabilities) const
+{
+  const size_t k = observations.n_rows;
+
+  // Column i of 'diffs' is the difference between observations.col(i) and
+  // the mean.
+  const arma::mat diffs = observations.each_col() - mean;
+  const arma::mat scaled = diffs.each_col() % invNoise;
+  const arma::mat projs = arma::trans(factors) * scaled; // r x n.
+
+  // Same Woodbury-based exponent as the single-point overload, for all
+  // points at once.
+  const arma::vec exponents = arma::trans(arma::sum(diffs % scaled, 0) -
+      arma::sum(projs % (invCapacitance * projs), 0));
+
+  logProbabilities = -0.5 * k * log2pi - 0.5 * logDetCov - 0.5 * exponents;
+}
+
+inline arma::vec LowRankGaussianDistribution::Random() const
+{
+  // Sample from the generative model: x = mu + W z + e, with z standard
+  // normal in the latent space and e diagonal Gaussian noise.
+  return mean + factors * arma::randn<arma::vec>(factors.n_cols) +
+      arma::sqrt(noise) % arma::randn<arma::vec>(mean.n_elem);
+}
+
+inline void LowRankGaussianDistribution::Train(const arma::mat& observations)
+{
+  // Equal weights give exactly the maximum likelihood EM updates.
+  Train(observations, arma::ones<arma::vec>(observations.n_cols));
+}
+
+inline void LowRankGaussianDistribution::Train(const arma::mat& observations,
+                                               const arma::vec& probabilities)
+{
+  const size_t rank = factors.n_cols;
+
+  if (observations.n_cols == 0)
+  {
+    mean.zeros(0);
+    factors.zeros(0, rank);
+    noise.zeros(0);
+    UpdateWoodburyCache();
+    return;
+  }
+
+  // If the sum of the weights is 0, there is nothing in this Gaussian.
+  // At least, set the noise term so that the covariance is invertible.
+  const double v1 = arma::accu(probabilities);
+  if (v1 == 0)
+  {
+    noise += 1e-50;
+    UpdateWoodburyCache();
+    return;
+  }
+
+  // Normalize the probabilities; every weighted sum below is then a
+  // weighted mean.
+  const arma::vec normalizedProbs = probabilities / v1;
+
+  // Calculate the mean and the per-dimension sample variances.
+  mean = observations * normalizedProbs;
+  const arma::mat diffs = observations.each_col() - mean;
+  const arma::vec sampleVar = (diffs % diffs) * normalizedProbs;
+
+  // With rank 0 the model is a diagonal Gaussian, and the sample variances
+  // are already the maximum likelihood solution.
+  if (rank == 0)
+  {
+    noise = arma::clamp(sampleVar, 1e-10, arma::datum::inf);
+    UpdateWoodburyCache();
+    return;
+  }
+
+  // Initialize the factors randomly if we cannot warm-start from the
+  // current ones, spreading the average sample variance over the columns.
+  if (factors.n_rows != observations.n_rows ||
+      arma::accu(arma::abs(factors)) == 0)
+  {
+    factors = arma::randn<arma::mat>(observations.n_rows, rank) *
+        std::sqrt(arma::mean(sampleVar) / rank);
+  }
+  noise = arma::clamp(sampleVar, 1e-10, arma::datum::inf);
+  UpdateWoodburyCache();
+
+  // EM for factor analysis (Ghahramani and Hinton, 1996).  Each iteration
+  // costs O(n d r + d r^2 + r^3) and never forms a d x d matrix.
+  for (size_t i = 0; i < trainIterations; ++i)
+  {
+    // E-step: beta = W^T Sigma^-1, computed via the Woodbury identity as
+    // (I_r + W^T Psi^-1 W)^-1 W^T Psi^-1.
+    const arma::mat beta = invCapacitance *
+        arma::trans(factors.each_col() % invNoise);
+    const arma::mat ez = beta * diffs; // Expected factors, r x n.
+    const arma::mat weightedEz = ez.each_row() % arma::trans(normalizedProbs);
+
+    // Weighted second moments of the factors, and the cross moments between
+    // the observations and the factors.
+    arma::mat ezz = (arma::eye<arma::mat>(rank, rank) - beta * factors) +
+        ez * arma::trans(weightedEz);
+    const arma::mat xez = diffs * arma::trans(weightedEz); // d x r.
+
+    // M-step.  The small ridge keeps the solve well-posed when the data
+    // have lower rank than the model.
+    ezz.diag() += 1e-10;
+    factors = arma::trans(arma::solve(ezz, arma::trans(xez)));
+    noise = arma::clamp(sampleVar - arma::sum(factors % xez, 1), 1e-10,
+        arma::datum::inf);
+    UpdateWoodburyCache();
+  }
+}
+
+} // namespace distribution
+} // namespace mlpack
+
+#endif
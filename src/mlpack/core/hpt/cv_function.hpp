@@ -86,6 +86,16 @@ class CVFunction
   //! Access and modify the best model so far.
   MLAlgorithm& BestModel() { return bestModel; }
 
+  //! Access and modify the underlying cross-validation object (e.g. to adjust
+  //! its evaluation budget between calls to Evaluate()).
+  CVType& CV() { return cv; }
+
+  //! Forget the best model and objective seen so far, so that subsequent
+  //! calls to Evaluate() restart the tracking.  This is meant for optimizers
+  //! that run cheap approximate evaluations first (e.g. on reduced budgets)
+  //! and don't want the best model to be selected by an approximate score.
+  void ResetBest() { bestObjective = std::numeric_limits<double>::max(); }
+
  private:
   //! The type of tuples of BoundArgs.
   using BoundArgsTupleType = std::tuple<BoundArgs...>;
@@ -0,0 +1,186 @@
+/**
+ * @file core/hpt/successive_halving.hpp
+ *
+ * An optimizer that searches a grid of hyper-parameter values with successive
+ * halving: cheap partial evaluations first, full evaluations only for the
+ * most promising combinations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * SuccessiveHalvingSearch is a drop-in alternative to ens::GridSearch for
+ * HyperParameterTuner.  Like grid search it considers every combination of
+ * the given (categorical) hyper-parameter values, but instead of running a
+ * full evaluation for each one it first scores all combinations on a reduced
+ * budget, keeps only the best 1 / halvingRate fraction of them, increases the
+ * budget by the factor halvingRate, and repeats until the surviving
+ * combinations are evaluated on the full budget (successive halving
+ * scheduling).
+ *
+ * The budget is the number of cross-validation folds.  When the function
+ * being optimized wraps KFoldCV, the engine drives
+ * KFoldCV::NumEvaluationFolds() between rounds, so early rounds average over
+ * only the first folds; any best model tracked during those partial rounds is
+ * discarded, and the model and objective reported at the end always come from
+ * full-budget evaluations.  For functions without a budget knob (e.g. ones
+ * wrapping SimpleCV) the search simply evaluates every combination on the
+ * full budget, which makes it equivalent to exhaustive grid search.
+ *
+ * Individual evaluations run the folds in parallel when OpenMP is enabled
+ * (see KFoldCV), so the machine is kept busy even though combinations are
+ * scheduled one at a time — the cross-validation object is shared between
+ * evaluations and cannot be used from several threads at once.
+ *
+ * For example, the following code tunes lambda of LinearRegression, running
+ * 9-fold cross-validation in full for only the most promising values:
+ *
+ * @code
+ * HyperParameterTuner<LinearRegression, MSE, KFoldCV,
+ *     SuccessiveHalvingSearch> hpt(9, xs, ys);
+ * arma::vec lambdas{0.0, 0.001, 0.01, 0.1, 1.0, 10.0};
+ * double bestLambda;
+ * std::tie(bestLambda) = hpt.Optimize(lambdas);
+ * @endcode
+ */
+class SuccessiveHalvingSearch
+{
+ public:
+  /**
+   * Construct a SuccessiveHalvingSearch object.
+   *
+   * @param halvingRate The rate of the search (often referred to as eta): in
+   *     each round only the best 1 / halvingRate fraction of the combinations
+   *     survives, and the budget of the next round is halvingRate times
+   *     bigger.  Should be at least 2.
+   */
+  SuccessiveHalvingSearch(const size_t halvingRate = 3);
+
+  /**
+   * Find the best combination of the given hyper-parameter values.
+   *
+   * @param function The function to be optimized (a CVFunction object).
+   * @param bestParameters Variable for storing the best combination found.
+   * @param categoricalDimensions Information on which parameters are
+   *     categorical (all of them should be).
+   * @param numCategories Number of values to try for each parameter.
+   * @return The objective of the best combination, evaluated on the full
+   *     budget.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories);
+
+  //! Get the halving rate.
+  size_t HalvingRate() const { return halvingRate; }
+  //! Modify the halving rate.
+  size_t& HalvingRate() { return halvingRate; }
+
+ private:
+  //! A convenience alias for SFINAE-based checks of expression validity.
+  template<typename... /* Ts */>
+  using Void = void;
+
+  /**
+   * A struct that finds out whether the given function exposes a fold-budget
+   * knob in the form of function.CV().NumEvaluationFolds().
+   */
+  template<typename FunctionType, typename = void>
+  struct HasFoldBudget;
+
+  /**
+   * A struct that finds out whether the given function supports discarding
+   * its best model tracking through function.ResetBest().
+   */
+  template<typename FunctionType, typename = void>
+  struct HasResetBest;
+
+  /**
+   * Get the full evaluation budget of the given function.  This overload is
+   * called when the function exposes a fold-budget knob.
+   */
+  template<typename FunctionType,
+           bool Enabled = HasFoldBudget<FunctionType>::value,
+           typename = typename std::enable_if<Enabled>::type>
+  size_t MaxBudget(FunctionType& function);
+
+  /**
+   * Get the full evaluation budget of the given function.  This overload is
+   * called when the function has no fold-budget knob; such functions can only
+   * run full evaluations, which is expressed as a budget of 1.
+   */
+  template<typename FunctionType,
+           bool Enabled = !HasFoldBudget<FunctionType>::value,
+           typename = typename std::enable_if<Enabled>::type,
+           typename = void>
+  size_t MaxBudget(FunctionType& /* function */);
+
+  /**
+   * Set the evaluation budget of the given function.  This overload is called
+   * when the function exposes a fold-budget knob.
+   */
+  template<typename FunctionType,
+           bool Enabled = HasFoldBudget<FunctionType>::value,
+           typename = typename std::enable_if<Enabled>::type>
+  void SetBudget(FunctionType& function, const size_t budget);
+
+  /**
+   * Set the evaluation budget of the given function.  This overload (a no-op)
+   * is called when the function has no fold-budget knob.
+   */
+  template<typename FunctionType,
+           bool Enabled = !HasFoldBudget<FunctionType>::value,
+           typename = typename std::enable_if<Enabled>::type,
+           typename = void>
+  void SetBudget(FunctionType& /* function */, const size_t /* budget */);
+
+  /**
+   * Discard the best model tracking of the given function.  This overload is
+   * called when the function supports it.
+   */
+  template<typename FunctionType,
+           bool Enabled = HasResetBest<FunctionType>::value,
+           typename = typename std::enable_if<Enabled>::type>
+  void ResetBest(FunctionType& function);
+
+  /**
+   * Discard the best model tracking of the given function.  This overload (a
+   * no-op) is called when the function does not track a best model.
+   */
+  template<typename FunctionType,
+           bool Enabled = !HasResetBest<FunctionType>::value,
+           typename = typename std::enable_if<Enabled>::type,
+           typename = void>
+  void ResetBest(FunctionType& /* function */);
+
+  /**
+   * Fill parameters with the combination that has the given index in the
+   * virtual grid of all combinations.
+   */
+  inline void Configuration(const size_t index,
+                            const arma::Row<size_t>& numCategories,
+                            arma::mat& parameters);
+
+  //! The rate of the search.
+  size_t halvingRate;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation
+#include "successive_halving_impl.hpp"
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ * @file core/hpt/successive_halving_impl.hpp
+ *
+ * The implementation of the class SuccessiveHalvingSearch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+
+namespace mlpack {
+namespace hpt {
+
+template<typename FunctionType, typename>
+struct SuccessiveHalvingSearch::HasFoldBudget : std::false_type { };
+
+template<typename FunctionType>
+struct SuccessiveHalvingSearch::HasFoldBudget<FunctionType,
+    SuccessiveHalvingSearch::Void<decltype(
+        std::declval<FunctionType&>().CV().NumEvaluationFolds())>> :
+    std::true_type { };
+
+template<typename FunctionType, typename>
+struct SuccessiveHalvingSearch::HasResetBest : std::false_type { };
+
+template<typename FunctionType>
+struct SuccessiveHalvingSearch::HasResetBest<FunctionType,
+    SuccessiveHalvingSearch::Void<decltype(
+        std::declval<FunctionType&>().ResetBest())>> : std::true_type { };
+
+inline SuccessiveHalvingSearch::SuccessiveHalvingSearch(
+    const size_t halvingRate) : halvingRate(halvingRate)
+{
+  if (halvingRate < 2)
+    throw std::invalid_argument(
+        "SuccessiveHalvingSearch: halvingRate should be at least 2");
+}
+
+template<typename FunctionType>
+double SuccessiveHalvingSearch::Optimize(
+    FunctionType& function,
+    arma::mat& bestParameters,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories)
+{
+  for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+  {
+    if (!categoricalDimensions[d])
+      throw std::invalid_argument(
+          "SuccessiveHalvingSearch::Optimize(): all dimensions should be "
+          "categorical (pass a collection of values to try for each "
+          "hyper-parameter)");
+  }
+
+  size_t numConfigurations = 1;
+  for (size_t d = 0; d < numCategories.n_elem; ++d)
+    numConfigurations *= numCategories[d];
+
+  if (numConfigurations == 0)
+    throw std::invalid_argument(
+        "SuccessiveHalvingSearch::Optimize(): each dimension should have at "
+        "least one value to try");
+
+  // All combinations are candidates at first; they are referred to by their
+  // indices in the virtual grid of all combinations.
+  std::vector<size_t> candidates(numConfigurations);
+  for (size_t c = 0; c < numConfigurations; ++c)
+    candidates[c] = c;
+
+  const size_t maxBudget = MaxBudget(function);
+
+  // The number of partial-budget rounds is limited both by how many times the
+  // full budget can be divided by halvingRate and by how many rounds it takes
+  // to reduce the candidates to a single one.
+  size_t budgetRounds = 0;
+  for (size_t b = maxBudget; b >= halvingRate; b /= halvingRate)
+    ++budgetRounds;
+  size_t candidateRounds = 0;
+  for (size_t n = numConfigurations; n > 1;
+      n = (n + halvingRate - 1) / halvingRate)
+    ++candidateRounds;
+  const size_t rounds = std::min(budgetRounds, candidateRounds);
+
+  size_t budget = maxBudget;
+  for (size_t round = 0; round < rounds; ++round)
+    budget /= halvingRate;
+
+  arma::mat parameters(numCategories.n_elem, 1);
+
+  for (size_t round = 0; round < rounds; ++round)
+  {
+    SetBudget(function, budget);
+
+    // Score every surviving combination on the current partial budget.
+    std::vector<std::pair<double, size_t>> scored(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+      Configuration(candidates[i], numCategories, parameters);
+      scored[i] = std::make_pair(function.Evaluate(parameters), candidates[i]);
+    }
+
+    // Only the best 1 / halvingRate fraction (but at least one combination)
+    // gets the increased budget of the next round.
+    const size_t survivors = std::max<size_t>(1,
+        (candidates.size() + halvingRate - 1) / halvingRate);
+    std::partial_sort(scored.begin(), scored.begin() + survivors,
+        scored.end());
+    candidates.resize(survivors);
+    for (size_t i = 0; i < survivors; ++i)
+      candidates[i] = scored[i].second;
+
+    budget *= halvingRate;
+  }
+
+  // The final round runs the survivors on the full budget.  Any best model
+  // tracked during the partial rounds is discarded first, so that the model
+  // reported by the function afterwards is one scored on the full budget.
+  SetBudget(function, maxBudget);
+  if (rounds > 0)
+    ResetBest(function);
+
+  double bestObjective = std::numeric_limits<double>::max();
+  size_t bestConfiguration = candidates[0];
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    Configuration(candidates[i], numCategories, parameters);
+    const double objective = function.Evaluate(parameters);
+    if (objective < bestObjective)
+    {
+      bestObjective = objective;
+      bestConfiguration = candidates[i];
+    }
+  }
+
+  Configuration(bestConfiguration, numCategories, bestParameters);
+
+  return bestObjective;
+}
+
+template<typename FunctionType, bool Enabled, typename>
+size_t SuccessiveHalvingSearch::MaxBudget(FunctionType& function)
+{
+  return function.CV().NumEvaluationFolds();
+}
+
+template<typename FunctionType, bool Enabled, typename, typename>
+size_t SuccessiveHalvingSearch::MaxBudget(FunctionType& /* function */)
+{
+  return 1;
+}
+
+template<typename FunctionType, bool Enabled, typename>
+void SuccessiveHalvingSearch::SetBudget(FunctionType& function,
+                                        const size_t budget)
+{
+  function.CV().NumEvaluationFolds() = budget;
+}
+
+template<typename FunctionType, bool Enabled, typename, typename>
+void SuccessiveHalvingSearch::SetBudget(FunctionType& /* function */,
+                                        const size_t /* budget */)
+{ /* Nothing to do. */ }
+
+template<typename FunctionType, bool Enabled, typename>
+void SuccessiveHalvingSearch::ResetBest(FunctionType& function)
+{
+  function.ResetBest();
+}
+
+template<typename FunctionType, bool Enabled, typename, typename>
+void SuccessiveHalvingSearch::ResetBest(FunctionType& /* function */)
+{ /* Nothing to do. */ }
+
+inline void SuccessiveHalvingSearch::Configuration(
+    const size_t index,
+    const arma::Row<size_t>& numCategories,
+    arma::mat& parameters)
+{
+  parameters.set_size(numCategories.n_elem, 1);
+  size_t remainder = index;
+  for (size_t d = 0; d < numCategories.n_elem; ++d)
+  {
+    parameters(d, 0) = double(remainder % numCategories[d]);
+    remainder /= numCategories[d];
+  }
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ *
+ * A lazily-evaluated view of a kernel matrix with a tile cache.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/pairwise_kernels.hpp>
+#include <list>
+#include <unordered_map>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * A view of the matrix of kernel evaluations between two sets of points that
+ * computes its entries lazily.  The matrix is divided into square tiles; the
+ * first access to any entry of a tile computes the whole tile with one call
+ * to PairwiseKernels() (a single matrix multiplication for dot-product
+ * kernels), and the tile is then kept in a least-recently-used cache.  The
+ * cache is bounded by a memory budget, so the view gives near-materialized
+ * access speed for localized access patterns without ever holding the full
+ * kernel matrix, which for large sets would not fit in memory.
+ *
+ * If the number of touched entries of a tile is very small, computing the
+ * full tile is wasted work; the view pays off when accesses cluster, as they
+ * do when nearby queries are processed together.
+ *
+ * This class is not thread-safe: concurrent threads should each use their own
+ * instance (splitting the memory budget between them).
+ *
+ * @tparam KernelType Type of the kernel to evaluate.
+ * @tparam MatType Type of the point matrices.
+ */
+template<typename KernelType, typename MatType = arma::mat>
+class KernelMatrix
+{
+ public:
+  /**
+   * Construct the view for the kernel evaluations between the given sets of
+   * points: entry (i, j) is the kernel value of references.col(i) and
+   * queries.col(j).  Neither matrix is copied, so both must outlive the view.
+   *
+   * @param references Reference points (one per column).
+   * @param queries Query points (one per column).
+   * @param kernel Instantiated kernel.
+   * @param tileSize Number of rows and columns per cached tile.
+   * @param memoryBudget Maximum number of bytes of cached tiles.
+   */
+  KernelMatrix(const MatType& references,
+               const MatType& queries,
+               KernelType& kernel,
+               const size_t tileSize = 512,
+               const size_t memoryBudget = size_t(1) << 26 /* 64 MB */);
+
+  /**
+   * Return the kernel evaluation between references.col(referenceIndex) and
+   * queries.col(queryIndex), computing and caching the containing tile if it
+   * is not cached.
+   */
+  double Evaluate(const size_t referenceIndex, const size_t queryIndex);
+
+  //! Get the number of rows of the view (the number of reference points).
+  size_t NumRows() const { return references.n_cols; }
+  //! Get the number of columns of the view (the number of query points).
+  size_t NumCols() const { return queries.n_cols; }
+
+  //! Get the number of accesses served from the cache.
+  size_t Hits() const { return hits; }
+  //! Get the number of accesses that had to compute a tile.
+  size_t Misses() const { return misses; }
+
+ private:
+  //! A cached tile of kernel evaluations.
+  struct Tile
+  {
+    //! Linear index of the tile in the grid of tiles.
+    size_t id;
+    //! The kernel evaluations of the tile.
+    arma::mat values;
+  };
+
+  //! The reference points.
+  const MatType& references;
+  //! The query points.
+  const MatType& queries;
+  //! The instantiated kernel.
+  KernelType& kernel;
+
+  //! Number of rows and columns per tile.
+  const size_t tileSize;
+  //! Maximum number of bytes of cached tiles.
+  const size_t memoryBudget;
+  //! Number of tile rows in the grid of tiles.
+  const size_t numTileRows;
+
+  //! Cached tiles, most recently used first.
+  std::list<Tile> tiles;
+  //! Map from tile id to its position in the cache list.
+  std::unordered_map<size_t, typename std::list<Tile>::iterator> tileMap;
+  //! Number of bytes currently held by cached tiles.
+  size_t cachedBytes;
+
+  //! For benchmarking.
+  size_t hits;
+  //! For benchmarking.
+  size_t misses;
+};
+
+} // namespace kernel
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_matrix_impl.hpp"
+
+#endif
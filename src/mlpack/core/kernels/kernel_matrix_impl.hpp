@@ -0,0 +1,97 @@
+/**
+ * @file core/kernels/kernel_matrix_impl.hpp
+ *
+ * Implementation of the lazily-evaluated kernel matrix view.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_matrix.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+template<typename KernelType, typename MatType>
+KernelMatrix<KernelType, MatType>::KernelMatrix(const MatType& references,
+                                                const MatType& queries,
+                                                KernelType& kernel,
+                                                const size_t tileSize,
+                                                const size_t memoryBudget) :
+    references(references),
+    queries(queries),
+    kernel(kernel),
+    tileSize(tileSize),
+    memoryBudget(memoryBudget),
+    numTileRows((references.n_cols + tileSize - 1) / tileSize),
+    cachedBytes(0),
+    hits(0),
+    misses(0)
+{
+  // Nothing to do.
+}
+
+template<typename KernelType, typename MatType>
+double KernelMatrix<KernelType, MatType>::Evaluate(
+    const size_t referenceIndex,
+    const size_t queryIndex)
+{
+  const size_t tileRow = referenceIndex / tileSize;
+  const size_t tileCol = queryIndex / tileSize;
+  const size_t tileId = tileRow + numTileRows * tileCol;
+
+  typename std::unordered_map<size_t,
+      typename std::list<Tile>::iterator>::iterator it = tileMap.find(tileId);
+  if (it != tileMap.end())
+  {
+    // Move the tile to the front of the LRU list.
+    tiles.splice(tiles.begin(), tiles, it->second);
+    ++hits;
+  }
+  else
+  {
+    // Compute the whole tile in one bulk panel.
+    const size_t rowBegin = tileRow * tileSize;
+    const size_t rowEnd = std::min(rowBegin + tileSize,
+        (size_t) references.n_cols);
+    const size_t colBegin = tileCol * tileSize;
+    const size_t colEnd = std::min(colBegin + tileSize,
+        (size_t) queries.n_cols);
+
+    const MatType referenceTile = references.cols(rowBegin, rowEnd - 1);
+    const MatType queryTile = queries.cols(colBegin, colEnd - 1);
+
+    Tile tile;
+    tile.id = tileId;
+    PairwiseKernels(referenceTile, queryTile, tile.values, kernel);
+
+    cachedBytes += tile.values.n_elem * sizeof(double);
+    tiles.push_front(std::move(tile));
+    tileMap[tileId] = tiles.begin();
+    ++misses;
+
+    // Evict least-recently-used tiles until we are back under the budget.
+    // The freshly computed tile is always kept, even if it alone exceeds the
+    // budget.
+    while (cachedBytes > memoryBudget && tiles.size() > 1)
+    {
+      const Tile& last = tiles.back();
+      cachedBytes -= last.values.n_elem * sizeof(double);
+      tileMap.erase(last.id);
+      tiles.pop_back();
+    }
+  }
+
+  return tiles.front().values(referenceIndex - tileRow * tileSize,
+                              queryIndex - tileCol * tileSize);
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
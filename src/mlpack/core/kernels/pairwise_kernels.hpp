@@ -0,0 +1,56 @@
+/**
+ * @file core/kernels/pairwise_kernels.hpp
+ *
+ * Bulk computation of the pairwise kernel evaluations between two sets of
+ * points.  Generic kernels are evaluated pair by pair (in parallel), but
+ * kernels that are functions of the dot product or the Euclidean distance are
+ * computed from one bulk distance computation, whose dominant cost is a
+ * single matrix multiplication.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_PAIRWISE_KERNELS_HPP
+#define MLPACK_CORE_KERNELS_PAIRWISE_KERNELS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Compute the matrix of all pairwise kernel evaluations between the columns
+ * of two matrices: kernels(j, i) is set to the kernel value of
+ * references.col(j) and queries.col(i).
+ *
+ * For a generic kernel every pair is evaluated individually, in parallel over
+ * the query points.  For kernels that are elementwise functions of the
+ * Euclidean distance or the dot product (the Gaussian, Laplacian, linear,
+ * and polynomial kernels, and the cosine similarity), the whole panel is
+ * instead computed from one bulk pairwise distance or inner product
+ * computation, so the dominant cost is a single GEMM, which BLAS blocks for
+ * cache reuse.
+ *
+ * The output matrix grows with the product of the two point counts, so
+ * callers with large sets should process the queries in column blocks.
+ *
+ * @param references First set of points (one per column).
+ * @param queries Second set of points (one per column).
+ * @param kernels Output matrix; set to references.n_cols x queries.n_cols.
+ * @param kernel Instantiated kernel.
+ */
+template<typename KernelType, typename MatAType, typename MatBType>
+void PairwiseKernels(const MatAType& references,
+                     const MatBType& queries,
+                     arma::mat& kernels,
+                     KernelType& kernel);
+
+} // namespace kernel
+} // namespace mlpack
+
+// Include implementation.
+#include "pairwise_kernels_impl.hpp"
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file core/kernels/pairwise_kernels_impl.hpp
+ *
+ * Implementation of the bulk pairwise kernel computation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_PAIRWISE_KERNELS_IMPL_HPP
+#define MLPACK_CORE_KERNELS_PAIRWISE_KERNELS_IMPL_HPP
+
+// In case it hasn't been included.
+#include "pairwise_kernels.hpp"
+
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
+
+#include "cosine_distance.hpp"
+#include "gaussian_kernel.hpp"
+#include "laplacian_kernel.hpp"
+#include "linear_kernel.hpp"
+#include "polynomial_kernel.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+//! Avoid a copy when the input is already a dense matrix.
+inline const arma::mat& DensifyKernelInput(const arma::mat& input,
+                                           arma::mat& /* storage */)
+{
+  return input;
+}
+
+//! Materialize any other matrix type (subview, sparse, ...) densely, so the
+//! dot-product specializations below are always a single dense GEMM.
+template<typename MatType>
+const arma::mat& DensifyKernelInput(const MatType& input, arma::mat& storage)
+{
+  storage = arma::conv_to<arma::mat>::from(input);
+  return storage;
+}
+
+/**
+ * Helper for PairwiseKernels(); the generic version evaluates the kernel once
+ * per pair of points.  It is specialized for kernels with bulk forms below.
+ */
+template<typename KernelType>
+struct PairwiseKernelsHelper
+{
+  template<typename MatAType, typename MatBType>
+  static void Apply(const MatAType& references,
+                    const MatBType& queries,
+                    arma::mat& kernels,
+                    KernelType& kernel)
+  {
+    kernels.set_size(references.n_cols, queries.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) queries.n_cols; ++i)
+      for (size_t j = 0; j < references.n_cols; ++j)
+        kernels(j, i) = kernel.Evaluate(references.col(j), queries.col(i));
+  }
+};
+
+/**
+ * Specialization for the Gaussian kernel: compute all squared Euclidean
+ * distances in one bulk call (one GEMM), then apply the exponential
+ * elementwise.
+ */
+template<>
+struct PairwiseKernelsHelper<GaussianKernel>
+{
+  template<typename MatAType, typename MatBType>
+  static void Apply(const MatAType& references,
+                    const MatBType& queries,
+                    arma::mat& kernels,
+                    GaussianKernel& kernel)
+  {
+    metric::SquaredEuclideanDistance metric;
+    metric::PairwiseDistances(references, queries, kernels, metric);
+    kernels = arma::exp(kernel.Gamma() * kernels);
+  }
+};
+
+/**
+ * Specialization for the Laplacian kernel: compute all Euclidean distances in
+ * one bulk call (one GEMM), then apply the exponential elementwise.
+ */
+template<>
+struct PairwiseKernelsHelper<LaplacianKernel>
+{
+  template<typename MatAType, typename MatBType>
+  static void Apply(const MatAType& references,
+                    const MatBType& queries,
+                    arma::mat& kernels,
+                    LaplacianKernel& kernel)
+  {
+    metric::EuclideanDistance metric;
+    metric::PairwiseDistances(references, queries, kernels, metric);
+    kernels = arma::exp(-kernels / kernel.Bandwidth());
+  }
+};
+
+/**
+ * Specialization for the linear kernel: the whole panel is exactly one matrix
+ * multiplication.
+ */
+template<>
+struct PairwiseKernelsHelper<LinearKernel>
+{
+  template<typename MatAType, typename MatBType>
+  static void Apply(const MatAType& references,
+                    const MatBType& queries,
+                    arma::mat& kernels,
+                    LinearKernel& /* kernel */)
+  {
+    arma::mat refStorage, queryStorage;
+    const arma::mat& refs = DensifyKernelInput(references, refStorage);
+    const arma::mat& qs = DensifyKernelInput(queries, queryStorage);
+
+    kernels = arma::trans(refs) * qs;
+  }
+};
+
+/**
+ * Specialization for the polynomial kernel: one matrix multiplication for all
+ * of the inner products, then the offset and power applied elementwise.
+ */
+template<>
+struct PairwiseKernelsHelper<PolynomialKernel>
+{
+  template<typename MatAType, typename MatBType>
+  static void Apply(const MatAType& references,
+                    const MatBType& queries,
+                    arma::mat& kernels,
+                    PolynomialKernel& kernel)
+  {
+    arma::mat refStorage, queryStorage;
+    const arma::mat& refs = DensifyKernelInput(references, refStorage);
+    const arma::mat& qs = DensifyKernelInput(queries, queryStorage);
+
+    kernels = arma::pow(arma::trans(refs) * qs + kernel.Offset(),
+        kernel.Degree());
+  }
+};
+
+/**
+ * Specialization for the cosine similarity: one matrix multiplication for all
+ * of the inner products, then each row and column scaled by the inverse norm
+ * of the corresponding point.  Zero points get a similarity of zero, matching
+ * CosineDistance::Evaluate().
+ */
+template<>
+struct PairwiseKernelsHelper<CosineDistance>
+{
+  template<typename MatAType, typename MatBType>
+  static void Apply(const MatAType& references,
+                    const MatBType& queries,
+                    arma::mat& kernels,
+                    CosineDistance& /* kernel */)
+  {
+    arma::mat refStorage, queryStorage;
+    const arma::mat& refs = DensifyKernelInput(references, refStorage);
+    const arma::mat& qs = DensifyKernelInput(queries, queryStorage);
+
+    kernels = arma::trans(refs) * qs;
+
+    // Invert the norms, mapping zero points to zero so that they get a
+    // similarity of zero, matching CosineDistance::Evaluate().
+    arma::colvec refInvNorms =
+        arma::trans(arma::sqrt(arma::sum(arma::square(refs))));
+    refInvNorms.transform(
+        [](double norm) { return (norm == 0.0) ? 0.0 : 1.0 / norm; });
+
+    arma::rowvec queryInvNorms = arma::sqrt(arma::sum(arma::square(qs)));
+    queryInvNorms.transform(
+        [](double norm) { return (norm == 0.0) ? 0.0 : 1.0 / norm; });
+
+    kernels.each_col() %= refInvNorms;
+    kernels.each_row() %= queryInvNorms;
+  }
+};
+
+template<typename KernelType, typename MatAType, typename MatBType>
+void PairwiseKernels(const MatAType& references,
+                     const MatBType& queries,
+                     arma::mat& kernels,
+                     KernelType& kernel)
+{
+  if (references.n_rows != queries.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "PairwiseKernels(): reference dimensionality ("
+        << references.n_rows << ") does not match query dimensionality ("
+        << queries.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  PairwiseKernelsHelper<KernelType>::Apply(references, queries, kernels,
+      kernel);
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
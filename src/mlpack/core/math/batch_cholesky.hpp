@@ -0,0 +1,75 @@
+/**
+ * @file core/math/batch_cholesky.hpp
+ *
+ * Batched Cholesky factorization and solves for many small symmetric
+ * positive definite systems.  Fitting procedures like the GMM M-step and
+ * ALS-WR solve thousands of independent d x d systems with small d; calling
+ * LAPACK once per system spends a large share of the time on dispatch
+ * overhead and leaves the other cores idle.  These helpers process a whole
+ * batch at once: OpenMP distributes the systems over the threads, and small
+ * systems use in-header unblocked kernels instead of LAPACK calls.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_BATCH_CHOLESKY_HPP
+#define MLPACK_CORE_MATH_BATCH_CHOLESKY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Factor every slice of the given cube, each a symmetric positive definite
+ * matrix, into its lower-triangular Cholesky factor, so that afterwards
+ * matrices.slice(i) == lowers.slice(i) * lowers.slice(i).t().  The slices
+ * are factored in parallel.
+ *
+ * @param matrices Batch of symmetric positive definite matrices (one per
+ *     slice).
+ * @param lowers Output batch of lower-triangular Cholesky factors.
+ * @return False if any slice is not positive definite (its factor is then
+ *     meaningless; the other slices are still valid).
+ */
+inline bool BatchCholesky(const arma::cube& matrices, arma::cube& lowers);
+
+/**
+ * From a batch of lower-triangular Cholesky factors, compute the inverse and
+ * the log-determinant of every factored matrix, as cached by Gaussian
+ * densities.  The slices are processed in parallel.
+ *
+ * @param lowers Batch of lower-triangular Cholesky factors (one per slice),
+ *     as produced by BatchCholesky().
+ * @param inverses Output batch of inverses of the factored matrices.
+ * @param logDets Output log-determinants of the factored matrices.
+ */
+inline void BatchCholeskyInverse(const arma::cube& lowers,
+                                 arma::cube& inverses,
+                                 arma::vec& logDets);
+
+/**
+ * Solve the batch of independent linear systems
+ * matrices.slice(i) * solutions.col(i) = rhs.col(i), where every slice is
+ * symmetric positive definite.  The systems are solved in parallel via
+ * Cholesky factorization; a slice that turns out not to be positive definite
+ * falls back to a general solver.
+ *
+ * @param matrices Batch of symmetric positive definite matrices (one per
+ *     slice).
+ * @param rhs Right-hand sides (one per column).
+ * @param solutions Output solutions (one per column).
+ */
+inline void BatchSolveSPD(const arma::cube& matrices,
+                          const arma::mat& rhs,
+                          arma::mat& solutions);
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_cholesky_impl.hpp"
+
+#endif // MLPACK_CORE_MATH_BATCH_CHOLESKY_HPP
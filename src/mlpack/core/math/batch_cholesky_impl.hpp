@@ -0,0 +1,186 @@
+/**
+ * @file core/math/batch_cholesky_impl.hpp
+ *
+ * Implementation of batched Cholesky factorization and solves.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_BATCH_CHOLESKY_IMPL_HPP
+#define MLPACK_CORE_MATH_BATCH_CHOLESKY_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "batch_cholesky.hpp"
+
+namespace mlpack {
+namespace math {
+
+//! Systems up to this dimension use the in-header unblocked kernels; larger
+//! ones go to LAPACK, whose blocking wins once the matrices leave cache.
+constexpr size_t BatchCholeskySmallLimit = 64;
+
+/**
+ * Unblocked in-place lower Cholesky factorization of one small matrix.  The
+ * lower triangle of A is replaced by the factor and the strict upper
+ * triangle is zeroed.  Returns false on a non-positive pivot.
+ */
+inline bool SmallCholesky(arma::mat& A)
+{
+  const size_t n = A.n_rows;
+  for (size_t j = 0; j < n; ++j)
+  {
+    double d = A(j, j);
+    for (size_t k = 0; k < j; ++k)
+      d -= A(j, k) * A(j, k);
+
+    if (d <= 0.0)
+      return false;
+
+    d = std::sqrt(d);
+    A(j, j) = d;
+
+    for (size_t i = j + 1; i < n; ++i)
+    {
+      double s = A(i, j);
+      for (size_t k = 0; k < j; ++k)
+        s -= A(i, k) * A(j, k);
+      A(i, j) = s / d;
+    }
+
+    for (size_t i = 0; i < j; ++i)
+      A(i, j) = 0.0;
+  }
+
+  return true;
+}
+
+/**
+ * Invert one small lower-triangular matrix by forward substitution.
+ */
+inline void SmallLowerTriangularInverse(const arma::mat& L, arma::mat& Linv)
+{
+  const size_t n = L.n_rows;
+  Linv.zeros(n, n);
+  for (size_t j = 0; j < n; ++j)
+  {
+    Linv(j, j) = 1.0 / L(j, j);
+    for (size_t i = j + 1; i < n; ++i)
+    {
+      double s = 0.0;
+      for (size_t k = j; k < i; ++k)
+        s -= L(i, k) * Linv(k, j);
+      Linv(i, j) = s / L(i, i);
+    }
+  }
+}
+
+/**
+ * Solve L * L^T * x = b in place by forward and back substitution, given the
+ * lower Cholesky factor L.
+ */
+inline void SmallCholeskySolve(const arma::mat& L, arma::vec& x)
+{
+  const size_t n = L.n_rows;
+
+  // Forward substitution: L * y = b.
+  for (size_t i = 0; i < n; ++i)
+  {
+    double s = x[i];
+    for (size_t k = 0; k < i; ++k)
+      s -= L(i, k) * x[k];
+    x[i] = s / L(i, i);
+  }
+
+  // Back substitution: L^T * x = y.
+  for (size_t i = n; i > 0; --i)
+  {
+    double s = x[i - 1];
+    for (size_t k = i; k < n; ++k)
+      s -= L(k, i - 1) * x[k];
+    x[i - 1] = s / L(i - 1, i - 1);
+  }
+}
+
+inline bool BatchCholesky(const arma::cube& matrices, arma::cube& lowers)
+{
+  lowers.set_size(matrices.n_rows, matrices.n_cols, matrices.n_slices);
+
+  bool success = true;
+  #pragma omp parallel for schedule(static) reduction(&& : success)
+  for (omp_size_t s = 0; s < (omp_size_t) matrices.n_slices; ++s)
+  {
+    arma::mat work;
+    if (matrices.n_rows <= BatchCholeskySmallLimit)
+    {
+      work = matrices.slice(s);
+      success = SmallCholesky(work) && success;
+    }
+    else
+    {
+      success = arma::chol(work, matrices.slice(s), "lower") && success;
+    }
+
+    lowers.slice(s) = work;
+  }
+
+  return success;
+}
+
+inline void BatchCholeskyInverse(const arma::cube& lowers,
+                                 arma::cube& inverses,
+                                 arma::vec& logDets)
+{
+  inverses.set_size(lowers.n_rows, lowers.n_cols, lowers.n_slices);
+  logDets.set_size(lowers.n_slices);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t s = 0; s < (omp_size_t) lowers.n_slices; ++s)
+  {
+    arma::mat lowerInv;
+    if (lowers.n_rows <= BatchCholeskySmallLimit)
+      SmallLowerTriangularInverse(lowers.slice(s), lowerInv);
+    else
+      lowerInv = arma::inv(arma::trimatl(arma::mat(lowers.slice(s))));
+
+    inverses.slice(s) = lowerInv.t() * lowerInv;
+    logDets[s] = 2.0 *
+        arma::accu(arma::log(arma::mat(lowers.slice(s)).diag()));
+  }
+}
+
+inline void BatchSolveSPD(const arma::cube& matrices,
+                          const arma::mat& rhs,
+                          arma::mat& solutions)
+{
+  solutions.set_size(rhs.n_rows, rhs.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t s = 0; s < (omp_size_t) matrices.n_slices; ++s)
+  {
+    if (matrices.n_rows <= BatchCholeskySmallLimit)
+    {
+      arma::mat work = matrices.slice(s);
+      if (SmallCholesky(work))
+      {
+        arma::vec x = rhs.col(s);
+        SmallCholeskySolve(work, x);
+        solutions.col(s) = x;
+        continue;
+      }
+      // Not positive definite; fall through to the general solver.
+    }
+
+    arma::vec x;
+    if (!arma::solve(x, arma::mat(matrices.slice(s)), rhs.col(s),
+        arma::solve_opts::likely_sympd))
+      x.zeros(rhs.n_rows);
+    solutions.col(s) = x;
+  }
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif // MLPACK_CORE_MATH_BATCH_CHOLESKY_IMPL_HPP
@@ -40,9 +40,40 @@ inline arma::Mat<eT> ColumnCovariance(const arma::Mat<eT>& x,
     const size_t n = xAlias.n_cols;
     const eT normVal = (normType == 0) ? ((n > 1) ? eT(n - 1) : eT(1)) : eT(n);
 
-    const arma::Mat<eT> tmp = xAlias.each_col() - arma::mean(xAlias, 1);
+    const arma::Col<eT> mu = arma::mean(xAlias, 1);
+
+    // Process the data in column blocks: each block is centered into a small
+    // temporary and folded into the covariance with one rank-k update, so a
+    // full centered copy of the input is never materialized.  The block size
+    // keeps each temporary at a few megabytes.
+    const size_t blockSize = std::max((size_t) 1,
+        (size_t) (1 << 22) / xAlias.n_rows);
+    const size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+    out.zeros(xAlias.n_rows, xAlias.n_rows);
+
+    #pragma omp parallel
+    {
+      arma::Mat<eT> localOut(xAlias.n_rows, xAlias.n_rows, arma::fill::zeros);
+      arma::Mat<eT> block;
+
+      #pragma omp for schedule(static)
+      for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+      {
+        const size_t begin = b * blockSize;
+        const size_t end = std::min(begin + blockSize, n) - 1;
+
+        block = xAlias.cols(begin, end);
+        block.each_col() -= mu;
+        localOut += block * block.t();
+      }
+
+      #pragma omp critical
+      {
+        out += localOut;
+      }
+    }
 
-    out = tmp * tmp.t();
     out /= normVal;
   }
 
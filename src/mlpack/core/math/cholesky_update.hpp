@@ -0,0 +1,86 @@
+/**
+ * @file core/math/cholesky_update.hpp
+ * @author Nishant Mehta
+ *
+ * Rank-1 update and downdate of an upper-triangular Cholesky factor of a Gram
+ * matrix, for maintaining the factorization of an active set of features
+ * without refactorizing from scratch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_CHOLESKY_UPDATE_HPP
+#define MLPACK_CORE_MATH_CHOLESKY_UPDATE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Update the upper-triangular Cholesky factor R of a Gram matrix when a new
+ * feature is appended to the active set, so that afterwards
+ * R^T R = [G, g; g^T, s] where G = R^T R before the call.  This costs O(p^2)
+ * (one triangular solve), instead of the O(p^3) of refactorizing.
+ *
+ * If R is empty, a 1 x 1 factor is created.
+ *
+ * @param R Upper-triangular Cholesky factor to update; modified in place.
+ * @param sqNormNewX Squared l2-norm of the new feature, including any
+ *     diagonal penalty term.
+ * @param newGramCol Inner products of the new feature with each feature of
+ *     the active set (the new column of the Gram matrix).
+ */
+inline void CholeskyInsert(arma::mat& R,
+                           const double sqNormNewX,
+                           const arma::vec& newGramCol);
+
+/**
+ * Update the upper-triangular Cholesky factor R of the Gram matrix X^T X when
+ * the feature newX is appended to the feature matrix X.  The needed inner
+ * products are computed from the given matrices; see the other overload if
+ * they are already available.
+ *
+ * @param R Upper-triangular Cholesky factor to update; modified in place.
+ * @param newX The new feature.
+ * @param X Matrix whose columns are the features of the active set.
+ * @param diagPenalty Penalty term added to the diagonal of the Gram matrix
+ *     (e.g. the l2 regularization parameter of an elastic net).
+ */
+inline void CholeskyInsert(arma::mat& R,
+                           const arma::vec& newX,
+                           const arma::mat& X,
+                           const double diagPenalty = 0.0);
+
+/**
+ * Compute the Givens rotation G that zeroes the second component of the given
+ * two-dimensional vector, so that G * x = (||x||, 0)^T.
+ *
+ * @param x Vector to rotate.
+ * @param rotatedX Will be set to G * x.
+ * @param matG Will be set to the 2 x 2 rotation matrix.
+ */
+inline void GivensRotate(const arma::vec::fixed<2>& x,
+                         arma::vec::fixed<2>& rotatedX,
+                         arma::mat& matG);
+
+/**
+ * Downdate the upper-triangular Cholesky factor R of a Gram matrix when the
+ * feature with the given index is removed from the active set.  The factor is
+ * restored to triangular form with a sequence of Givens rotations, costing
+ * O(p^2).
+ *
+ * @param R Upper-triangular Cholesky factor to downdate; modified in place.
+ * @param colToKill Index of the removed feature.
+ */
+inline void CholeskyDelete(arma::mat& R, const size_t colToKill);
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "cholesky_update_impl.hpp"
+
+#endif
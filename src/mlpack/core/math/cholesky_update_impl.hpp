@@ -0,0 +1,128 @@
+/**
+ * @file core/math/cholesky_update_impl.hpp
+ * @author Nishant Mehta
+ *
+ * Implementation of the Cholesky rank-1 update and downdate functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_CHOLESKY_UPDATE_IMPL_HPP
+#define MLPACK_CORE_MATH_CHOLESKY_UPDATE_IMPL_HPP
+
+#include "cholesky_update.hpp"
+
+namespace mlpack {
+namespace math {
+
+inline void CholeskyInsert(arma::mat& R,
+                           const double sqNormNewX,
+                           const arma::vec& newGramCol)
+{
+  const size_t n = R.n_rows;
+
+  if (n == 0)
+  {
+    R = arma::mat(1, 1);
+    R(0, 0) = sqrt(sqNormNewX);
+  }
+  else
+  {
+    arma::mat newR = arma::mat(n + 1, n + 1);
+
+    // The new column of the factor is obtained with a single triangular
+    // solve; the new diagonal element completes the norm of the new feature.
+    arma::vec Rk = solve(trimatl(trans(R)), newGramCol);
+
+    newR(arma::span(0, n - 1), arma::span(0, n - 1)) = R;
+    newR(arma::span(0, n - 1), n) = Rk;
+    newR(n, arma::span(0, n - 1)).fill(0.0);
+    newR(n, n) = sqrt(sqNormNewX - dot(Rk, Rk));
+
+    R = std::move(newR);
+  }
+}
+
+inline void CholeskyInsert(arma::mat& R,
+                           const arma::vec& newX,
+                           const arma::mat& X,
+                           const double diagPenalty)
+{
+  if (R.n_rows == 0)
+  {
+    R = arma::mat(1, 1);
+    R(0, 0) = sqrt(dot(newX, newX) + diagPenalty);
+  }
+  else
+  {
+    arma::vec newGramCol = trans(X) * newX;
+    CholeskyInsert(R, dot(newX, newX) + diagPenalty, newGramCol);
+  }
+}
+
+inline void GivensRotate(const arma::vec::fixed<2>& x,
+                         arma::vec::fixed<2>& rotatedX,
+                         arma::mat& matG)
+{
+  if (x(1) == 0)
+  {
+    matG = arma::eye(2, 2);
+    rotatedX = x;
+  }
+  else
+  {
+    double r = norm(x, 2);
+    matG = arma::mat(2, 2);
+
+    double scaledX1 = x(0) / r;
+    double scaledX2 = x(1) / r;
+
+    matG(0, 0) = scaledX1;
+    matG(1, 0) = -scaledX2;
+    matG(0, 1) = scaledX2;
+    matG(1, 1) = scaledX1;
+
+    rotatedX = arma::vec(2);
+    rotatedX(0) = r;
+    rotatedX(1) = 0;
+  }
+}
+
+inline void CholeskyDelete(arma::mat& R, const size_t colToKill)
+{
+  size_t n = R.n_rows;
+
+  if (colToKill == (n - 1))
+  {
+    R = R(arma::span(0, n - 2), arma::span(0, n - 2));
+  }
+  else
+  {
+    R.shed_col(colToKill); // remove column colToKill
+    n--;
+
+    // Restore the triangular form with Givens rotations, each one zeroing
+    // the subdiagonal element introduced by the removed column.
+    for (size_t k = colToKill; k < n; ++k)
+    {
+      arma::mat matG;
+      arma::vec::fixed<2> rotatedVec;
+      GivensRotate(R(arma::span(k, k + 1), k), rotatedVec, matG);
+      R(arma::span(k, k + 1), k) = rotatedVec;
+      if (k < n - 1)
+      {
+        R(arma::span(k, k + 1), arma::span(k + 1, n - 1)) =
+            matG * R(arma::span(k, k + 1), arma::span(k + 1, n - 1));
+      }
+    }
+
+    R.shed_row(n);
+  }
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
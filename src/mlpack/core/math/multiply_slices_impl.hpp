@@ -56,24 +56,31 @@ CubeType MultiplyCube2Cube(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // Every slice product is independent, so run the small GEMMs across OpenMP
+  // threads; a single BLAS call cannot keep the machine busy on the small
+  // per-slice shapes that attention-style layers produce.
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = arma::trans(cubeB.slice(i) * cubeA.slice(i));
   }
   else if (bTranspose && !aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * cubeB.slice(i).t();
   }
   else if (aTranspose && !bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i).t() * cubeB.slice(i);
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * cubeB.slice(i);
   }
   return z;
@@ -114,25 +121,34 @@ CubeType MultiplyMat2Cube(const MatType& matA,
 
   CubeType z(rows, cols, slices);
 
+  typedef typename CubeType::elem_type eT;
+
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = arma::trans(cubeB.slice(i) * matA);
   }
   else if (bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = matA * cubeB.slice(i).t();
   }
-  else if (aTranspose)
-  {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA.t() * cubeB.slice(i);
-  }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA * cubeB.slice(i);
+    // The slices of a cube are laid out contiguously, so when B is not
+    // transposed the whole batch collapses to one large GEMM on flattened
+    // aliases of the cubes; this keeps the BLAS fed even when individual
+    // slices are small.
+    const arma::Mat<eT> bFlat(const_cast<eT*>(cubeB.memptr()), cubeB.n_rows,
+        cubeB.n_cols * slices, false, false);
+    arma::Mat<eT> zFlat(z.memptr(), rows, cols * slices, false, true);
+
+    if (aTranspose)
+      zFlat = matA.t() * bFlat;
+    else
+      zFlat = matA * bFlat;
   }
   return z;
 }
@@ -170,24 +186,31 @@ CubeType MultiplyCube2Mat(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // Here the shared matrix sits on the right of each product, so the batch
+  // cannot be flattened into one GEMM like MultiplyMat2Cube(); instead the
+  // independent per-slice products run across OpenMP threads.
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = arma::trans(matB * cubeA.slice(i));
   }
   else if (bTranspose && !aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * matB.t();
   }
   else if (aTranspose && !bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i).t() * matB;
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) slices; ++i)
       z.slice(i) = cubeA.slice(i) * matB;
   }
   return z;
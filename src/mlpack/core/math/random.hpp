@@ -13,8 +13,13 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/mlpack_export.hpp>
+#include <atomic>
 #include <random>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace math /** Miscellaneous math routines. */ {
 
@@ -23,13 +28,96 @@ namespace math /** Miscellaneous math routines. */ {
  * correctly on Windows.
  */
 
-//! Global random object.
+//! The base seed shared by all threads; set by RandomSeed().
+inline size_t& RandGenSeed()
+{
+  static size_t randGenSeed = std::mt19937::default_seed;
+  return randGenSeed;
+}
+
+//! Counter bumped every time the base seed is set; each thread's generator
+//! reseeds itself lazily when it notices the counter changed.
+inline std::atomic<size_t>& RandGenGeneration()
+{
+  static std::atomic<size_t> randGenGeneration(0);
+  return randGenGeneration;
+}
+
+//! Mix the bits of a value into a generator seed (the SplitMix64 finalizer),
+//! so that related inputs (consecutive thread or stream ids) give unrelated
+//! generator states.
+inline uint64_t MixSeed(uint64_t z)
+{
+  z += 0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+//! Global random object.  Each thread has its own generator; after
+//! RandomSeed() is called, thread 0 is seeded with exactly the given seed
+//! (preserving single-threaded sequences) and every other thread with a seed
+//! derived deterministically from the base seed and its thread id.
 inline std::mt19937& RandGen()
 {
   static thread_local std::mt19937 randGen;
+  static thread_local size_t lastGeneration = 0;
+
+  // Reseed lazily if the base seed was changed since this thread last seeded
+  // its generator.  This mapping from (seed, thread id) to generator state is
+  // deterministic, so runs with the same seed and thread count are
+  // reproducible.
+  const size_t generation =
+      RandGenGeneration().load(std::memory_order_relaxed);
+  if (lastGeneration != generation)
+  {
+    #ifdef HAS_OPENMP
+    const size_t threadId = (size_t) omp_get_thread_num();
+    #else
+    const size_t threadId = 0;
+    #endif
+
+    if (threadId == 0)
+      randGen.seed((uint32_t) RandGenSeed());
+    else
+      randGen.seed((uint32_t) MixSeed(MixSeed(RandGenSeed()) ^ threadId));
+
+    lastGeneration = generation;
+  }
+
   return randGen;
 }
 
+/**
+ * Get a generator deterministically seeded for the given logical stream.  The
+ * stream's sequence depends only on the base seed and the stream identifier —
+ * not on which thread runs it or on how many threads there are — so parallel
+ * loops that draw one stream per chunk (or per point, per tree, ...) produce
+ * the same results for any thread count.
+ *
+ * @param stream Identifier of the logical stream (e.g. a chunk index).
+ */
+inline std::mt19937 RandGenStream(const size_t stream)
+{
+  return std::mt19937((uint32_t) MixSeed(MixSeed(RandGenSeed()) +
+      0x100000000 /* separate the stream space from the thread id space */ +
+      stream));
+}
+
+/**
+ * Get or set whether parallel code must be run-to-run reproducible.  When
+ * enabled, parallel accumulators merge their thread-local state in a fixed
+ * order (instead of whichever thread reaches the merge first), so for a fixed
+ * seed and thread count repeated runs produce bit-identical results.  The
+ * default is disabled, which allows the faster unordered reductions; parallel
+ * loops whose iterations write disjoint outputs are reproducible either way.
+ */
+inline bool& Deterministic()
+{
+  static bool deterministic = false;
+  return deterministic;
+}
+
 //! Global uniform distribution.
 inline std::uniform_real_distribution<>& RandUniformDist()
 {
@@ -54,7 +142,10 @@ inline std::normal_distribution<>& RandNormalDist()
 inline void RandomSeed(const size_t seed)
 {
   #if (!defined(BINDING_TYPE) || BINDING_TYPE != BINDING_TYPE_TEST)
-    RandGen().seed((uint32_t) seed);
+    // Every thread's generator reseeds itself (lazily, on its next use) from
+    // the new base seed; see RandGen().
+    RandGenSeed() = seed;
+    ++RandGenGeneration();
     #if (BINDING_TYPE == BINDING_TYPE_R)
       // To suppress Found 'srand', possibly from 'srand' (C).
       (void) seed;
@@ -78,14 +169,16 @@ inline void RandomSeed(const size_t seed)
 inline void FixedRandomSeed()
 {
   const static size_t seed = rand();
-  RandGen().seed((uint32_t) seed);
+  RandGenSeed() = seed;
+  ++RandGenGeneration();
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
 
 inline void CustomRandomSeed(const size_t seed)
 {
-  RandGen().seed((uint32_t) seed);
+  RandGenSeed() = seed;
+  ++RandGenGeneration();
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
@@ -155,6 +248,43 @@ inline double RandNormal(const double mean, const double variance)
   return variance * RandNormalDist()(RandGen()) + mean;
 }
 
+/**
+ * Fill the given memory with draws from the given distribution, in parallel
+ * when OpenMP is available.  The values are drawn in fixed-size chunks, one
+ * deterministically-seeded stream per chunk (see RandGenStream()), so the
+ * result depends only on the base seed and on the order of FillRandom() calls
+ * — not on the thread count or on which thread fills which chunk.  This is
+ * meant for large fills (e.g. weight initialization), where drawing from the
+ * single thread-local generator serially would dominate.
+ *
+ * @param values Memory to fill.
+ * @param n Number of elements to fill.
+ * @param dist Distribution to draw from (e.g.
+ *     `std::uniform_real_distribution<>`); each chunk uses its own copy.
+ */
+template<typename eT, typename DistributionType>
+inline void FillRandom(eT* values, const size_t n, DistributionType dist)
+{
+  // Drawn serially from the calling thread's generator, so that successive
+  // fills (and anything drawn between them) get distinct streams.
+  const size_t streamBase = (size_t) RandGen()();
+
+  const size_t chunkSize = 65536;
+  const size_t chunks = (n + chunkSize - 1) / chunkSize;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t c = 0; c < (omp_size_t) chunks; ++c)
+  {
+    std::mt19937 gen = RandGenStream(streamBase + (size_t) c);
+    DistributionType chunkDist(dist);
+
+    const size_t begin = (size_t) c * chunkSize;
+    const size_t end = std::min(begin + chunkSize, n);
+    for (size_t i = begin; i < end; ++i)
+      values[i] = (eT) chunkDist(gen);
+  }
+}
+
 /**
  * Obtains no more than maxNumSamples distinct samples. Each sample belongs to
  * [loInclusive, hiExclusive).
@@ -0,0 +1,45 @@
+/**
+ * @file core/math/scores_to_labels.hpp
+ * @author Ryan Curtin
+ *
+ * Convert a matrix of per-class scores for a batch of points into predicted
+ * class labels.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_SCORES_TO_LABELS_HPP
+#define MLPACK_CORE_MATH_SCORES_TO_LABELS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Given a matrix of scores, where each column holds the per-class scores
+ * (probabilities, log-likelihoods, decision values, ...) of one point, set
+ * each label to the index of the highest-scoring class for that point.  Ties
+ * are broken in favor of the lowest class index.
+ *
+ * This is the batch equivalent of a per-point max() loop, and classifiers
+ * should prefer it for their bulk Classify() overloads: the scores for all
+ * points can then be produced with a handful of matrix operations and the
+ * argmax is vectorized too, instead of looping over the points one at a time.
+ *
+ * @param scores Matrix of scores; scores(j, i) is the score of class j for
+ *     point i.
+ * @param labels Will be set to the predicted label of each point.
+ */
+template<typename MatType>
+inline void ScoresToLabels(const MatType& scores, arma::Row<size_t>& labels)
+{
+  labels = arma::conv_to<arma::Row<size_t>>::from(arma::index_max(scores, 0));
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -17,6 +17,18 @@
 namespace mlpack {
 namespace math {
 
+/**
+ * Generate a random ordering (permutation) of the point indices [0, count).
+ * This is the ordering used by ShuffleData() and data::Split(); it is exposed
+ * so that callers who cannot afford a shuffled copy of their dataset can keep
+ * just the permutation and access columns through it instead (e.g. with
+ * `input.cols(ordering)` expressions, one batch at a time).
+ */
+inline arma::uvec ShuffleOrdering(const size_t count)
+{
+  return arma::shuffle(arma::linspace<arma::uvec>(0, count - 1, count));
+}
+
 /**
  * Shuffle a dataset and associated labels (or responses).  It is expected that
  * inputPoints and inputLabels have the same number of columns (so, be sure that
@@ -33,8 +45,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   outputPoints = inputPoints.cols(ordering);
   outputLabels = inputLabels.cols(ordering);
@@ -56,8 +67,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Extract coordinate list representation.
   arma::umat locations(2, inputPoints.n_nonzero);
@@ -109,8 +119,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<arma::is_Cube<LabelsType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Properly handle the case where the input and output data are the same
   // object.
@@ -167,8 +176,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   outputPoints = inputPoints.cols(ordering);
   outputLabels = inputLabels.cols(ordering);
@@ -195,8 +203,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffleOrdering(inputPoints.n_cols);
 
   // Extract coordinate list representation.
   arma::umat locations(2, inputPoints.n_nonzero);
@@ -0,0 +1,58 @@
+/**
+ * @file core/metrics/pairwise_distances.hpp
+ *
+ * Bulk computation of the pairwise distances between two sets of points.
+ * Generic metrics are evaluated pair by pair, but L2-based metrics are
+ * computed with a single matrix multiplication, which is typically an order
+ * of magnitude faster than a per-column loop.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_HPP
+#define MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "lmetric.hpp"
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * Compute the matrix of all pairwise distances between the columns of two
+ * matrices: distances(j, i) is set to the distance between references.col(j)
+ * and queries.col(i).
+ *
+ * For a generic metric every pair is evaluated individually (in parallel over
+ * the query points).  For LMetric<2> — the Euclidean and squared Euclidean
+ * distances — the expansion ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y is used
+ * instead, so the dominant cost is one GEMM, which BLAS blocks for cache
+ * reuse.  Optionally the GEMM may be performed in 32-bit floats, roughly
+ * doubling its throughput at the cost of single precision in the results.
+ *
+ * The output matrix grows with the product of the two point counts, so
+ * callers with large sets should process the queries in column blocks.
+ *
+ * @param references First set of points (one per column).
+ * @param queries Second set of points (one per column).
+ * @param distances Output matrix; set to references.n_cols x queries.n_cols.
+ * @param metric Instantiated metric.
+ * @param lowPrecision If true, L2 metrics accumulate the inner products in
+ *      32-bit floats.  Ignored for other metrics.
+ */
+template<typename MetricType, typename MatAType, typename MatBType>
+void PairwiseDistances(const MatAType& references,
+                       const MatBType& queries,
+                       arma::mat& distances,
+                       MetricType& metric,
+                       const bool lowPrecision = false);
+
+} // namespace metric
+} // namespace mlpack
+
+// Include implementation.
+#include "pairwise_distances_impl.hpp"
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file core/metrics/pairwise_distances_impl.hpp
+ *
+ * Implementation of the bulk pairwise distance computation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_IMPL_HPP
+#define MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_IMPL_HPP
+
+// In case it hasn't been included.
+#include "pairwise_distances.hpp"
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * Helper for PairwiseDistances(); the generic version evaluates the metric
+ * once per pair of points.  It is specialized for LMetric<2> below.
+ */
+template<typename MetricType>
+struct PairwiseDistancesHelper
+{
+  template<typename MatAType, typename MatBType>
+  static void Apply(const MatAType& references,
+                    const MatBType& queries,
+                    arma::mat& distances,
+                    MetricType& metric,
+                    const bool /* lowPrecision */)
+  {
+    distances.set_size(references.n_cols, queries.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) queries.n_cols; ++i)
+      for (size_t j = 0; j < references.n_cols; ++j)
+        distances(j, i) = metric.Evaluate(references.col(j), queries.col(i));
+  }
+};
+
+/**
+ * Specialization for the Euclidean and squared Euclidean distances: use the
+ * expansion ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y, whose dominant cost is
+ * a single matrix multiplication.
+ */
+template<bool TakeRoot>
+struct PairwiseDistancesHelper<LMetric<2, TakeRoot>>
+{
+  template<typename MatAType, typename MatBType>
+  static void Apply(const MatAType& references,
+                    const MatBType& queries,
+                    arma::mat& distances,
+                    LMetric<2, TakeRoot>& /* metric */,
+                    const bool lowPrecision)
+  {
+    // Subviews and sparse matrices are densified once up front; the copy is
+    // negligible next to the multiplication below.
+    arma::mat refStorage, queryStorage;
+    const arma::mat& refs = Densify(references, refStorage);
+    const arma::mat& qs = Densify(queries, queryStorage);
+
+    if (lowPrecision)
+    {
+      // Perform the multiplication in 32-bit floats.  SGEMM has twice the
+      // throughput of DGEMM, but the results are only single precision.
+      const arma::fmat refs32 = arma::conv_to<arma::fmat>::from(refs);
+      const arma::fmat qs32 = arma::conv_to<arma::fmat>::from(qs);
+      distances = arma::conv_to<arma::mat>::from(
+          -2.0f * (arma::trans(refs32) * qs32));
+    }
+    else
+    {
+      distances = -2.0 * (arma::trans(refs) * qs);
+    }
+
+    const arma::colvec refNorms = arma::trans(arma::sum(arma::square(refs)));
+    const arma::rowvec queryNorms = arma::sum(arma::square(qs));
+
+    distances.each_col() += refNorms;
+    distances.each_row() += queryNorms;
+
+    // Cancellation may leave tiny negative values; clamp them to zero so the
+    // square root below is safe.
+    distances.transform([](double d) { return (d < 0.0) ? 0.0 : d; });
+
+    if (TakeRoot)
+      distances = arma::sqrt(distances);
+  }
+
+ private:
+  //! Avoid a copy when the input is already a dense matrix.
+  static const arma::mat& Densify(const arma::mat& input, arma::mat& /* s */)
+  {
+    return input;
+  }
+
+  //! Materialize any other matrix type (subview, sparse, ...) densely.
+  template<typename MatType>
+  static const arma::mat& Densify(const MatType& input, arma::mat& storage)
+  {
+    storage = arma::conv_to<arma::mat>::from(input);
+    return storage;
+  }
+};
+
+template<typename MetricType, typename MatAType, typename MatBType>
+void PairwiseDistances(const MatAType& references,
+                       const MatBType& queries,
+                       arma::mat& distances,
+                       MetricType& metric,
+                       const bool lowPrecision)
+{
+  if (references.n_rows != queries.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "PairwiseDistances(): reference dimensionality ("
+        << references.n_rows << ") does not match query dimensionality ("
+        << queries.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  PairwiseDistancesHelper<MetricType>::Apply(references, queries, distances,
+      metric, lowPrecision);
+}
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
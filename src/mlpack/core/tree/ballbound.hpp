@@ -25,23 +25,27 @@ namespace bound {
  * to the Euclidean (L2) distance.
  *
  * @tparam MetricType metric type used in the distance measure.
- * @tparam VecType Type of vector (arma::vec or arma::sp_vec or similar).
+ * @tparam VecType Type of vector (arma::vec or arma::sp_vec or similar), or
+ *     an element type (double/float/etc.), in which case a dense column
+ *     vector of that type is used.  This allows trees to instantiate the
+ *     bound with the element type of their dataset, like the other bounds.
  */
 template<typename MetricType = metric::LMetric<2, true>,
          typename VecType = arma::vec>
 class BallBound
 {
  public:
+  //! The vector type in use (resolves element types to dense vectors).
+  typedef typename std::conditional<std::is_arithmetic<VecType>::value,
+      arma::Col<VecType>, VecType>::type Vec;
   //! The underlying data type.
-  typedef typename VecType::elem_type ElemType;
-  //! A public version of the vector type.
-  typedef VecType Vec;
+  typedef typename Vec::elem_type ElemType;
 
  private:
   //! The radius of the ball bound.
   ElemType radius;
   //! The center of the ball bound.
-  VecType center;
+  Vec center;
   //! The metric used in this bound.
   MetricType* metric;
 
@@ -70,7 +74,7 @@ class BallBound
    * @param radius Radius of ball bound.
    * @param center Center of ball bound.
    */
-  BallBound(const ElemType radius, const VecType& center);
+  BallBound(const ElemType radius, const Vec& center);
 
   //! Copy constructor. To prevent memory leaks.
   BallBound(const BallBound& other);
@@ -93,9 +97,9 @@ class BallBound
   ElemType& Radius() { return radius; }
 
   //! Get the center point of the ball.
-  const VecType& Center() const { return center; }
+  const Vec& Center() const { return center; }
   //! Modify the center point of the ball.
-  VecType& Center() { return center; }
+  Vec& Center() { return center; }
 
   //! Get the dimensionality of the ball.
   size_t Dim() const { return center.n_elem; }
@@ -114,14 +118,14 @@ class BallBound
    *
    * @param point Point to check the condition.
    */
-  bool Contains(const VecType& point) const;
+  bool Contains(const Vec& point) const;
 
   /**
    * Place the center of BallBound into the given vector.
    *
    * @param center Vector which the centroid will be written to.
    */
-  void Center(VecType& center) const { center = this->center; }
+  void Center(Vec& center) const { center = this->center; }
 
   /**
    * Calculates minimum bound-to-point squared distance.
@@ -133,6 +137,20 @@ class BallBound
       const OtherVecType& point,
       typename std::enable_if_t<IsVector<OtherVecType>::value>* = 0) const;
 
+  /**
+   * Calculates the minimum bound-to-point distance for every column of the
+   * given matrix at once.  The center distances are computed in one bulk
+   * pass -- a single matrix-vector product for the L2 metric -- which is much
+   * faster than calling the single-point overload once per column.
+   *
+   * @param points Points to which the minimum distances are requested (one
+   *     per column).
+   * @param distances Output vector; set to points.n_cols distances.
+   */
+  template<typename MatType>
+  void MinDistance(const MatType& points,
+                   arma::Col<ElemType>& distances) const;
+
   /**
    * Calculates minimum bound-to-bound squared distance.
    *
@@ -15,6 +15,7 @@
 // In case it hasn't been included already.
 #include "ballbound.hpp"
 #include <mlpack/core/math/clamp.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 
 #include <string>
 
@@ -50,7 +51,7 @@ BallBound<MetricType, VecType>::BallBound(const size_t dimension) :
  */
 template<typename MetricType, typename VecType>
 BallBound<MetricType, VecType>::BallBound(const ElemType radius,
-                                           const VecType& center) :
+                                           const Vec& center) :
     radius(radius),
     center(center),
     metric(new MetricType()),
@@ -91,7 +92,7 @@ BallBound<MetricType, VecType>::BallBound(BallBound&& other) :
 {
   // Fix the other bound.
   other.radius = 0.0;
-  other.center = VecType();
+  other.center = Vec();
   other.metric = NULL;
   other.ownsMetric = false;
 }
@@ -109,7 +110,7 @@ BallBound<MetricType, VecType>& BallBound<MetricType, VecType>::operator=(
     ownsMetric = other.ownsMetric;
 
     other.radius = 0.0;
-    other.center = VecType();
+    other.center = Vec();
     other.metric = nullptr;
     other.ownsMetric = false;
   }
@@ -139,7 +140,7 @@ BallBound<MetricType, VecType>::operator[](const size_t i) const
  * Determines if a point is within the bound.
  */
 template<typename MetricType, typename VecType>
-bool BallBound<MetricType, VecType>::Contains(const VecType& point) const
+bool BallBound<MetricType, VecType>::Contains(const Vec& point) const
 {
   if (radius < 0)
     return false;
@@ -163,6 +164,33 @@ BallBound<MetricType, VecType>::MinDistance(
     return math::ClampNonNegative(metric->Evaluate(point, center) - radius);
 }
 
+/**
+ * Calculates minimum bound-to-point distances in bulk.
+ */
+template<typename MetricType, typename VecType>
+template<typename MatType>
+void BallBound<MetricType, VecType>::MinDistance(
+    const MatType& points,
+    arma::Col<ElemType>& distances) const
+{
+  distances.set_size(points.n_cols);
+
+  if (radius < 0)
+  {
+    distances.fill(std::numeric_limits<ElemType>::max());
+    return;
+  }
+
+  // Compute all center-to-point distances in one bulk pass; for the L2 metric
+  // the dominant cost is a single matrix-vector product.
+  arma::mat centerDistances;
+  mlpack::metric::PairwiseDistances(center, points, centerDistances, *metric);
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+    distances[i] = math::ClampNonNegative(
+        (ElemType) centerDistances(0, i) - radius);
+}
+
 /**
  * Calculates minimum bound-to-bound squared distance.
  */
@@ -288,14 +316,14 @@ BallBound<MetricType, VecType>::operator|=(const MatType& data)
   // Now iteratively add points.
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    const ElemType dist = metric->Evaluate(center, (VecType) data.col(i));
+    const ElemType dist = metric->Evaluate(center, (Vec) data.col(i));
 
     // See if the new point lies outside the bound.
     if (dist > radius)
     {
       // Move towards the new point and increase the radius just enough to
       // accommodate the new point.
-      const VecType diff = data.col(i) - center;
+      const Vec diff = data.col(i) - center;
       center += ((dist - radius) / (2 * dist)) * diff;
       radius = 0.5 * (dist + radius);
     }
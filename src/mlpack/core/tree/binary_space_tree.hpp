@@ -27,6 +27,9 @@
 #include "binary_space_tree/dual_tree_traverser_impl.hpp"
 #include "binary_space_tree/breadth_first_dual_tree_traverser.hpp"
 #include "binary_space_tree/breadth_first_dual_tree_traverser_impl.hpp"
+#include "binary_space_tree/best_first_dual_tree_traverser.hpp"
+#include "binary_space_tree/best_first_dual_tree_traverser_impl.hpp"
+#include "binary_space_tree/compact_binary_space_tree.hpp"
 #include "binary_space_tree/traits.hpp"
 #include "binary_space_tree/typedef.hpp"
 
@@ -0,0 +1,128 @@
+/**
+ * @file core/tree/binary_space_tree/best_first_dual_tree_traverser.hpp
+ *
+ * Defines the BestFirstDualTreeTraverser for the BinarySpaceTree tree type.
+ * This is a nested class of BinarySpaceTree which traverses two trees in a
+ * best-first manner: a single priority queue holds every unexpanded node
+ * combination, and the combination with the lowest score is always expanded
+ * next.  For approximate rules (high relative error or epsilon), visiting the
+ * most promising combinations first tightens the bounds quickly and allows
+ * far more of the frontier to be pruned than a depth-first descent.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <queue>
+
+#include "../binary_space_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A node combination on the best-first frontier, with the score it received
+ * when it was inserted and the traversal information that was current at that
+ * time.
+ */
+template<typename TreeType, typename TraversalInfoType>
+struct BestFirstFrame
+{
+  TreeType* queryNode;
+  TreeType* referenceNode;
+  double score;
+  TraversalInfoType traversalInfo;
+};
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                      SplitType>::BestFirstDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the best-first dual-tree traverser with the given rule set.
+   */
+  BestFirstDualTreeTraverser(RuleType& rule);
+
+  typedef BestFirstFrame<BinarySpaceTree,
+      typename RuleType::TraversalInfoType> FrameType;
+
+  /**
+   * Traverse the two trees.  Each node combination is scored when it enters
+   * the frontier and rescored when it leaves, so combinations that become
+   * prunable while they wait in the queue are never expanded.  This does not
+   * reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+ private:
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+
+  //! Traversal information, held in the class so that it isn't continually
+  //! being reallocated.
+  typename RuleType::TraversalInfoType traversalInfo;
+
+  /**
+   * Score the given combination and, unless it can be pruned immediately,
+   * push it onto the frontier.
+   */
+  void Enqueue(BinarySpaceTree& queryNode,
+               BinarySpaceTree& referenceNode,
+               std::priority_queue<FrameType>& frontier);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "best_first_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DUAL_TREE_TRAVERSER_HPP
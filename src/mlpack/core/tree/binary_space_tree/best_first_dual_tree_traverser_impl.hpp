@@ -0,0 +1,176 @@
+/**
+ * @file core/tree/binary_space_tree/best_first_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the BestFirstDualTreeTraverser for BinarySpaceTree.  This
+ * expands node combinations in order of increasing score instead of
+ * depth-first, so the combinations most likely to improve the results are
+ * visited first and the rest of the frontier can often be pruned wholesale.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DT_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DT_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "best_first_dual_tree_traverser.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BestFirstDualTreeTraverser<RuleType>::BestFirstDualTreeTraverser(
+    RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+//! The frame with the lowest score has the highest priority.
+template<typename TreeType, typename TraversalInfoType>
+bool operator<(const BestFirstFrame<TreeType, TraversalInfoType>& a,
+               const BestFirstFrame<TreeType, TraversalInfoType>& b)
+{
+  return a.score > b.score;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BestFirstDualTreeTraverser<RuleType>::Enqueue(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode,
+    std::priority_queue<FrameType>& frontier)
+{
+  // Restore the parent's traversal information before scoring the child
+  // combination.
+  rule.TraversalInfo() = traversalInfo;
+  const double score = rule.Score(queryNode, referenceNode);
+  ++numScores;
+
+  if (score == DBL_MAX)
+  {
+    ++numPrunes;
+    return;
+  }
+
+  FrameType frame;
+  frame.queryNode = &queryNode;
+  frame.referenceNode = &referenceNode;
+  frame.score = score;
+  frame.traversalInfo = rule.TraversalInfo();
+  frontier.push(frame);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BestFirstDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryRoot,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceRoot)
+{
+  std::priority_queue<FrameType> frontier;
+
+  // Score the root combination and seed the frontier with it.
+  traversalInfo = rule.TraversalInfo();
+  Enqueue(queryRoot, referenceRoot, frontier);
+
+  while (!frontier.empty())
+  {
+    const FrameType frame = frontier.top();
+    frontier.pop();
+
+    BinarySpaceTree& queryNode = *frame.queryNode;
+    BinarySpaceTree& referenceNode = *frame.referenceNode;
+
+    // The bounds may have tightened while this combination waited in the
+    // queue; check whether it is still worth expanding.
+    rule.TraversalInfo() = frame.traversalInfo;
+    const double score = rule.Rescore(queryNode, referenceNode, frame.score);
+
+    if (score == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    ++numVisited;
+    traversalInfo = frame.traversalInfo;
+
+    if (queryNode.IsLeaf() && referenceNode.IsLeaf())
+    {
+      // Loop through each of the points in each node.
+      const size_t queryEnd = queryNode.Begin() + queryNode.Count();
+      const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+      for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+      {
+        // See if we need to investigate this point.  Restore the traversal
+        // information first.
+        rule.TraversalInfo() = traversalInfo;
+        const double childScore = rule.Score(query, referenceNode);
+
+        if (childScore == DBL_MAX)
+          continue; // We can't improve this particular point.
+
+        for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
+          rule.BaseCase(query, ref);
+
+        numBaseCases += referenceNode.Count();
+      }
+    }
+    else if (((!queryNode.IsLeaf()) && referenceNode.IsLeaf()) ||
+             (queryNode.NumDescendants() > 3 * referenceNode.NumDescendants()
+              && !queryNode.IsLeaf() && !referenceNode.IsLeaf()))
+    {
+      // Split the query node only; both children keep the same reference
+      // node.
+      Enqueue(*queryNode.Left(), referenceNode, frontier);
+      Enqueue(*queryNode.Right(), referenceNode, frontier);
+    }
+    else if (queryNode.IsLeaf() && (!referenceNode.IsLeaf()))
+    {
+      // Split the reference node only; the frontier orders the children by
+      // score, so no manual prioritization is needed here.
+      Enqueue(queryNode, *referenceNode.Left(), frontier);
+      Enqueue(queryNode, *referenceNode.Right(), frontier);
+    }
+    else
+    {
+      // Split both nodes; all four combinations go onto the frontier.
+      Enqueue(*queryNode.Left(), *referenceNode.Left(), frontier);
+      Enqueue(*queryNode.Left(), *referenceNode.Right(), frontier);
+      Enqueue(*queryNode.Right(), *referenceNode.Left(), frontier);
+      Enqueue(*queryNode.Right(), *referenceNode.Right(), frontier);
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_BEST_FIRST_DT_TRAVERSER_IMPL_HPP
@@ -12,9 +12,11 @@
 #define MLPACK_CORE_TREE_BINARY_SPACE_TREE_BINARY_SPACE_TREE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/arena_allocator.hpp>
 
 #include "../statistic.hpp"
 #include "midpoint_split.hpp"
+#include "mean_split.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -59,7 +61,7 @@ class BinarySpaceTree
   //! The type of element held in MatType.
   typedef typename MatType::elem_type ElemType;
 
-  typedef SplitType<BoundType<MetricType>, MatType> Split;
+  typedef SplitType<BoundType<MetricType, ElemType>, MatType> Split;
 
  private:
   //! The left child node.
@@ -75,7 +77,7 @@ class BinarySpaceTree
   //! children).
   size_t count;
   //! The bound object for this node.
-  BoundType<MetricType> bound;
+  BoundType<MetricType, ElemType> bound;
   //! Any extra data contained in the node.
   StatisticType stat;
   //! The distance from the centroid of this node to the centroid of the parent.
@@ -88,6 +90,12 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! The arena every descendant node (and its statistic and bound) was
+  //! allocated from, when this tree was built by one of the building
+  //! constructors; the root owns the arena and destroys all descendants at
+  //! once by destroying it.  NULL for trees whose nodes were allocated
+  //! individually (copies and deserialized trees).
+  util::ArenaAllocator* arena = NULL;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -102,6 +110,11 @@ class BinarySpaceTree
   template<typename RuleType>
   class BreadthFirstDualTreeTraverser;
 
+  //! A best-first dual-tree traverser for binary space trees; see
+  //! best_first_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class BestFirstDualTreeTraverser;
+
   /**
    * Construct this as the root node of a binary space tree using the given
    * dataset.  This will copy the input matrix; if you don't want this, consider
@@ -211,7 +224,7 @@ class BinarySpaceTree
   BinarySpaceTree(BinarySpaceTree* parent,
                   const size_t begin,
                   const size_t count,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -237,7 +250,7 @@ class BinarySpaceTree
                   const size_t begin,
                   const size_t count,
                   std::vector<size_t>& oldFromNew,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -267,7 +280,7 @@ class BinarySpaceTree
                   const size_t count,
                   std::vector<size_t>& oldFromNew,
                   std::vector<size_t>& newFromOld,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -316,9 +329,9 @@ class BinarySpaceTree
   ~BinarySpaceTree();
 
   //! Return the bound object for this node.
-  const BoundType<MetricType>& Bound() const { return bound; }
+  const BoundType<MetricType, ElemType>& Bound() const { return bound; }
   //! Return the bound object for this node.
-  BoundType<MetricType>& Bound() { return bound; }
+  BoundType<MetricType, ElemType>& Bound() { return bound; }
 
   //! Return the statistic object for this node.
   const StatisticType& Stat() const { return stat; }
@@ -507,7 +520,39 @@ class BinarySpaceTree
   //! Store the center of the bounding region in the given vector.
   void Center(arma::vec& center) const { bound.Center(center); }
 
+  /**
+   * Get or modify the minimum number of points a node must hold for its two
+   * subtrees to be built as OpenMP tasks during construction.  Subtrees
+   * smaller than this are built serially, so that the task overhead does not
+   * drown out the work; for roughly balanced splits this acts as a depth
+   * cutoff.  Only construction with the stateless splitters (MidpointSplit
+   * and MeanSplit) is parallelized.
+   */
+  static size_t& ParallelBuildCutoff()
+  {
+    static size_t cutoff = 8192;
+    return cutoff;
+  }
+
  private:
+  //! Whether the splitter is known to be safe for task-parallel construction.
+  //! After PerformSplit() the left and right recursions touch disjoint column
+  //! ranges of the dataset, so the only remaining hazard is state inside the
+  //! splitter itself; MidpointSplit and MeanSplit are entirely static.
+  static constexpr bool ParallelSafeSplit =
+      std::is_same<Split,
+                   MidpointSplit<BoundType<MetricType, ElemType>,
+                                 MatType>>::value ||
+      std::is_same<Split,
+                   MeanSplit<BoundType<MetricType, ElemType>, MatType>>::value;
+
+  /**
+   * Release this node's descendants: in one sweep through the arena when the
+   * tree was built by a building constructor, or by recursive deletion when
+   * the nodes were allocated individually.
+   */
+  void FreeChildren();
+
   /**
    * Splits the current node, assigning its left and right children recursively.
    *
@@ -515,7 +560,7 @@ class BinarySpaceTree
    * @param splitter Instantiated SplitType object.
    */
   void SplitNode(const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
 
   /**
    * Splits the current node, assigning its left and right children recursively.
@@ -527,7 +572,7 @@ class BinarySpaceTree
    */
   void SplitNode(std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
 
   /**
    * Update the bound of the current node. This method does not take into
@@ -41,12 +41,25 @@ BinarySpaceTree(
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
     dataset(new MatType(data)) // Copies the dataset.
 {
-  // Do the actual splitting of this node.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  util::ProfileRegion profile("binary_space_tree_build");
+
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
+  // Do the actual splitting of this node.  The parallel region lets
+  // SplitNode() hand subtree builds to OpenMP tasks: one thread starts the
+  // recursion and the others pick up tasks as they are spawned.
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
+
+  util::MemoryTracker::Report("BinarySpaceTree build");
 }
 
 template<typename MetricType,
@@ -74,12 +87,25 @@ BinarySpaceTree(
   for (size_t i = 0; i < data.n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  util::ProfileRegion profile("binary_space_tree_build");
+
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
+  // Now do the actual splitting.  The parallel region lets SplitNode() hand
+  // subtree builds to OpenMP tasks: one thread starts the recursion and the
+  // others pick up tasks as they are spawned.
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
+
+  util::MemoryTracker::Report("BinarySpaceTree build");
 }
 
 template<typename MetricType,
@@ -108,8 +134,19 @@ BinarySpaceTree(
   for (size_t i = 0; i < data.n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  util::ProfileRegion profile("binary_space_tree_build");
+
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
+  // Now do the actual splitting.  The parallel region lets SplitNode() hand
+  // subtree builds to OpenMP tasks: one thread starts the recursion and the
+  // others pick up tasks as they are spawned.
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -119,6 +156,8 @@ BinarySpaceTree(
   newFromOld.resize(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
     newFromOld[oldFromNew[i]] = i;
+
+  util::MemoryTracker::Report("BinarySpaceTree build");
 }
 
 template<typename MetricType,
@@ -138,12 +177,25 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
     dataset(new MatType(std::move(data)))
 {
-  // Do the actual splitting of this node.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  util::ProfileRegion profile("binary_space_tree_build");
+
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
+  // Do the actual splitting of this node.  The parallel region lets
+  // SplitNode() hand subtree builds to OpenMP tasks: one thread starts the
+  // recursion and the others pick up tasks as they are spawned.
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
+
+  util::MemoryTracker::Report("BinarySpaceTree build");
 }
 
 template<typename MetricType,
@@ -171,12 +223,25 @@ BinarySpaceTree(
   for (size_t i = 0; i < dataset->n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  util::ProfileRegion profile("binary_space_tree_build");
+
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
+  // Now do the actual splitting.  The parallel region lets SplitNode() hand
+  // subtree builds to OpenMP tasks: one thread starts the recursion and the
+  // others pick up tasks as they are spawned.
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
+
+  util::MemoryTracker::Report("BinarySpaceTree build");
 }
 
 template<typename MetricType,
@@ -205,8 +270,19 @@ BinarySpaceTree(
   for (size_t i = 0; i < dataset->n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
+  util::ProfileRegion profile("binary_space_tree_build");
+
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
+  // Now do the actual splitting.  The parallel region lets SplitNode() hand
+  // subtree builds to OpenMP tasks: one thread starts the recursion and the
+  // others pick up tasks as they are spawned.
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  #pragma omp parallel
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -216,6 +292,8 @@ BinarySpaceTree(
   newFromOld.resize(dataset->n_cols);
   for (size_t i = 0; i < dataset->n_cols; ++i)
     newFromOld[oldFromNew[i]] = i;
+
+  util::MemoryTracker::Report("BinarySpaceTree build");
 }
 
 template<typename MetricType,
@@ -229,7 +307,7 @@ BinarySpaceTree(
     BinarySpaceTree* parent,
     const size_t begin,
     const size_t count,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -239,6 +317,9 @@ BinarySpaceTree(
     bound(parent->Dataset().n_rows),
     dataset(&parent->Dataset()) // Point to the parent's dataset.
 {
+  // Children are carved out of the same arena as the rest of the tree.
+  arena = parent->arena;
+
   // Perform the actual splitting.
   SplitNode(maxLeafSize, splitter);
 
@@ -258,7 +339,7 @@ BinarySpaceTree(
     const size_t begin,
     const size_t count,
     std::vector<size_t>& oldFromNew,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -272,6 +353,9 @@ BinarySpaceTree(
   // entirely but we can do a minor sanity check.
   assert(oldFromNew.size() == dataset->n_cols);
 
+  // Children are carved out of the same arena as the rest of the tree.
+  arena = parent->arena;
+
   // Perform the actual splitting.
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
@@ -292,7 +376,7 @@ BinarySpaceTree(
     const size_t count,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -306,6 +390,9 @@ BinarySpaceTree(
   // entirely but we can do a minor sanity check.
   Log::Assert(oldFromNew.size() == dataset->n_cols);
 
+  // Children are carved out of the same arena as the rest of the tree.
+  arena = parent->arena;
+
   // Perform the actual splitting.
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
@@ -398,11 +485,8 @@ operator=(const BinarySpaceTree& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  FreeChildren();
 
-  left = NULL;
-  right = NULL;
   parent = other.Parent();
   begin = other.Begin();
   count = other.Count();
@@ -470,8 +554,7 @@ operator=(BinarySpaceTree&& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  FreeChildren();
 
   parent = other.Parent();
   left = other.Left();
@@ -495,6 +578,11 @@ operator=(BinarySpaceTree&& other)
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
 
+  // Take over the arena (if any); its address is stable, so the descendants'
+  // arena pointers stay valid.
+  arena = other.arena;
+  other.arena = NULL;
+
   return *this;
 }
 
@@ -534,6 +622,11 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
 
+  // Take over the arena (if any); its address is stable, so the descendants'
+  // arena pointers stay valid.
+  arena = other.arena;
+  other.arena = NULL;
+
   // Set new parent.
   if (left)
     left->parent = this;
@@ -576,14 +669,43 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
-  delete left;
-  delete right;
+  FreeChildren();
 
   // If we're the root, delete the matrix.
   if (!parent)
     delete dataset;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                     SplitType>::FreeChildren()
+{
+  if (arena != NULL)
+  {
+    // Every descendant lives in the arena; destroying the arena runs all of
+    // their destructors in one linear sweep and releases the memory in a few
+    // bulk frees.  Only the root owns the arena.  When the arena runs a
+    // descendant's destructor, that destructor ends up back here, sees a
+    // non-NULL parent, and does nothing.
+    if (parent == NULL)
+      delete arena;
+    arena = NULL;
+  }
+  else
+  {
+    delete left;
+    delete right;
+  }
+
+  left = NULL;
+  right = NULL;
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -866,7 +988,7 @@ template<typename MetricType,
              class SplitType>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     SplitNode(const size_t maxLeafSize,
-              SplitType<BoundType<MetricType>, MatType>& splitter)
+              SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
 {
   // We need to expand the bounds of this node properly.
   UpdateBound(bound);
@@ -904,11 +1026,21 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
+  // After PerformSplit() the two recursions touch disjoint column ranges, so
+  // on large nodes they are handed to OpenMP tasks; small subtrees are built
+  // in place, since a task per tiny node costs more than it saves.
+  #pragma omp task default(shared) \
+      if (ParallelSafeSplit && count >= ParallelBuildCutoff())
+  left = arena->New<BinarySpaceTree>(this, begin, splitCol - begin, splitter,
       maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+
+  #pragma omp task default(shared) \
+      if (ParallelSafeSplit && count >= ParallelBuildCutoff())
+  right = arena->New<BinarySpaceTree>(this, splitCol, begin + count - splitCol,
       splitter, maxLeafSize);
 
+  #pragma omp taskwait
+
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
   Center(center);
@@ -933,7 +1065,7 @@ template<typename MetricType,
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 SplitNode(std::vector<size_t>& oldFromNew,
           const size_t maxLeafSize,
-          SplitType<BoundType<MetricType>, MatType>& splitter)
+          SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
 {
   // We need to expand the bounds of this node properly.
   UpdateBound(bound);
@@ -972,11 +1104,22 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
+  // After PerformSplit() the two recursions touch disjoint column ranges of
+  // both the dataset and oldFromNew, so on large nodes they are handed to
+  // OpenMP tasks; small subtrees are built in place, since a task per tiny
+  // node costs more than it saves.
+  #pragma omp task default(shared) \
+      if (ParallelSafeSplit && count >= ParallelBuildCutoff())
+  left = arena->New<BinarySpaceTree>(this, begin, splitCol - begin, oldFromNew,
       splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+
+  #pragma omp task default(shared) \
+      if (ParallelSafeSplit && count >= ParallelBuildCutoff())
+  right = arena->New<BinarySpaceTree>(this, splitCol, begin + count - splitCol,
       oldFromNew, splitter, maxLeafSize);
 
+  #pragma omp taskwait
+
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
   Center(center);
@@ -1067,19 +1210,16 @@ template<typename Archive>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     serialize(Archive& ar, const uint32_t /* version */)
 {
-  // If we're loading, and we have children, they need to be deleted.
+  // If we're loading, and we have children, they need to be deleted.  The
+  // loaded nodes will be allocated individually by cereal, so the arena (if
+  // this tree was built into one) is not reused.
   if (cereal::is_loading<Archive>())
   {
-    if (left)
-      delete left;
-    if (right)
-      delete right;
+    FreeChildren();
     if (!parent)
       delete dataset;
 
     parent = NULL;
-    left = NULL;
-    right = NULL;
   }
 
   ar(CEREAL_NVP(begin));
@@ -0,0 +1,235 @@
+/**
+ * @file core/tree/binary_space_tree/compact_binary_space_tree.hpp
+ * @author Jianxin Zhang
+ *
+ * A compact, read-only copy of a built BinarySpaceTree for query-time
+ * traversal.  Each BinarySpaceTree node is a separate heap allocation (and
+ * its HRectBound allocates again), so traversals chase pointers all over the
+ * heap; on large trees most of the query time goes to cache misses in node
+ * access.  CompactBinarySpaceTree stores the nodes of a finished tree in
+ * breadth-first order in a handful of contiguous arrays---the bounds are
+ * packed into two dense matrices---so that a traversal touches memory that is
+ * adjacent for nodes that are near each other in the tree.
+ *
+ * Because every array is contiguous and child links are indices rather than
+ * pointers, the whole tree (including the permuted dataset) can be saved as
+ * one relocatable blob and memory-mapped back: loading is a single mmap()
+ * and the first query can run immediately, with the operating system paging
+ * the index in on demand.
+ *
+ * The compact tree is a view for querying only: it does not own the dataset
+ * when flattened in memory, cannot be modified, and drops the per-node
+ * statistic.  It is built from a tree whose bound is HRectBound with the
+ * Euclidean metric (i.e. KDTree).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_COMPACT_BINARY_SPACE_TREE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_COMPACT_BINARY_SPACE_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <memory>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A flattened copy of a built BinarySpaceTree.  Node i's child links, point
+ * range, and bound all live at index i of contiguous arrays, laid out in
+ * breadth-first order.  Use Root() to get a lightweight Node handle and
+ * SingleTreeTraverser to run a rule set over the flattened tree; the rule
+ * interface (BaseCase()/Score()/Rescore()) is the same as for the pointer
+ * tree's traversers.
+ *
+ * Save() writes the flattened tree and its dataset as one contiguous blob,
+ * and the filename constructor maps such a blob back into memory for
+ * immediate querying.
+ *
+ * @tparam TreeType The type of the (already built) tree to flatten.
+ */
+template<typename TreeType>
+class CompactBinarySpaceTree
+{
+ public:
+  //! The matrix type held by the original tree.
+  typedef typename TreeType::Mat MatType;
+  //! The element type held by the matrix.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Flatten the given (already built) tree.  The compact tree keeps a
+   * reference to the tree's dataset, so the original tree (or at least its
+   * dataset) must outlive the compact tree.
+   *
+   * @param tree The tree to flatten.
+   */
+  CompactBinarySpaceTree(const TreeType& tree);
+
+  /**
+   * Load a compact tree previously written with Save().  On POSIX systems
+   * the file is memory-mapped and the arrays (including the dataset) point
+   * directly into the mapping, so no deserialization work happens at load
+   * time; elsewhere the file is read into memory instead.  Throws a
+   * std::runtime_error if the file cannot be opened or does not hold a
+   * compact tree with matching element type.
+   *
+   * @param filename File holding the saved compact tree.
+   */
+  CompactBinarySpaceTree(const std::string& filename);
+
+  //! Release the mapping, if this tree was loaded from a file.
+  ~CompactBinarySpaceTree();
+
+  //! The compact tree may hold a file mapping, so it cannot be copied.
+  CompactBinarySpaceTree(const CompactBinarySpaceTree&) = delete;
+  CompactBinarySpaceTree& operator=(const CompactBinarySpaceTree&) = delete;
+
+  /**
+   * Save the flattened tree, including its (permuted) dataset, to the given
+   * file as one contiguous blob that the filename constructor can map back.
+   * Returns false (with a warning) if the file cannot be written.
+   *
+   * @param filename File to write to.
+   */
+  bool Save(const std::string& filename) const;
+
+  /**
+   * A lightweight handle to one node of the compact tree: an index plus a
+   * pointer to the arrays.  Node objects are cheap to copy and carry no
+   * ownership.  The subset of the BinarySpaceTree node interface needed by
+   * single-tree rules is provided.
+   */
+  class Node
+  {
+   public:
+    //! Construct a handle to the given node of the given compact tree.
+    Node(const CompactBinarySpaceTree& tree, const size_t index) :
+        tree(&tree), index(index) { }
+
+    //! Return true if this node has no children.
+    bool IsLeaf() const { return tree->childLeft[index] == 0; }
+    //! Return true if this is the root of the tree.
+    bool IsRoot() const { return index == 0; }
+
+    //! Get the left child (undefined for leaves).
+    Node Left() const { return Node(*tree, tree->childLeft[index]); }
+    //! Get the right child (undefined for leaves).
+    Node Right() const { return Node(*tree, tree->childRight[index]); }
+
+    //! Get the index of the first point held in this node.
+    size_t Begin() const { return tree->begins[index]; }
+    //! Get the number of points held in this node.
+    size_t Count() const { return tree->counts[index]; }
+
+    //! Get the dataset the tree was built on.
+    const MatType& Dataset() const { return *tree->dataset; }
+
+    //! Return the minimum (Euclidean) distance from the given point to the
+    //! bound of this node.
+    template<typename VecType>
+    ElemType MinDistance(const VecType& point) const;
+
+    //! Return the maximum (Euclidean) distance from the given point to the
+    //! bound of this node.
+    template<typename VecType>
+    ElemType MaxDistance(const VecType& point) const;
+
+   private:
+    //! The compact tree the node belongs to.
+    const CompactBinarySpaceTree* tree;
+    //! The index of the node in the flattened arrays.
+    size_t index;
+  };
+
+  //! Get a handle to the root node.
+  Node Root() const { return Node(*this, 0); }
+
+  //! Get the number of nodes in the tree.
+  size_t NumNodes() const { return numNodes; }
+
+  //! Get the dataset the tree was built on.
+  const MatType& Dataset() const { return *dataset; }
+
+  /**
+   * A depth-first single-tree traverser over the compact tree.  This mirrors
+   * BinarySpaceTree::SingleTreeTraverser: the rule must provide BaseCase(),
+   * Score(), and Rescore(), with Node in place of the tree node type.
+   */
+  template<typename RuleType>
+  class SingleTreeTraverser
+  {
+   public:
+    //! Instantiate the traverser with the given rule set.
+    SingleTreeTraverser(RuleType& rule) : rule(rule), numPrunes(0) { }
+
+    /**
+     * Traverse the tree with the given query point index, starting from the
+     * given reference node.
+     *
+     * @param queryIndex The query point to traverse with.
+     * @param referenceNode The node to start traversal from.
+     */
+    void Traverse(const size_t queryIndex, const Node& referenceNode);
+
+    //! Get the number of prunes so far.
+    size_t NumPrunes() const { return numPrunes; }
+    //! Modify the number of prunes so far.
+    size_t& NumPrunes() { return numPrunes; }
+
+   private:
+    //! The rule set to use during traversal.
+    RuleType& rule;
+    //! The number of nodes that have been pruned.
+    size_t numPrunes;
+  };
+
+ private:
+  //! The dataset of the flattened tree; points at the original tree's
+  //! dataset, or at mappedDataset when loaded from a file.
+  const MatType* dataset;
+  //! Alias over the dataset section of a loaded blob.
+  std::unique_ptr<MatType> mappedDataset;
+
+  //! Lower bound of each node's hyperrectangle; column i is node i.  An
+  //! alias over the blob when loaded from a file.
+  std::unique_ptr<arma::Mat<ElemType>> loBounds;
+  //! Upper bound of each node's hyperrectangle; column i is node i.
+  std::unique_ptr<arma::Mat<ElemType>> hiBounds;
+
+  //! Backing store for the index arrays when the tree is flattened in
+  //! memory; empty when the arrays point into a file mapping.  Layout:
+  //! [childLeft | childRight | begins | counts], each numNodes long.
+  std::vector<uint64_t> indexStorage;
+
+  //! Index of the left child of each node (0 for leaves; the root can never
+  //! be a child, so 0 is a safe sentinel).
+  const uint64_t* childLeft;
+  //! Index of the right child of each node (0 for leaves).
+  const uint64_t* childRight;
+  //! Index of the first point held in each node.
+  const uint64_t* begins;
+  //! Number of points held in each node.
+  const uint64_t* counts;
+
+  //! The number of nodes in the tree.
+  size_t numNodes;
+
+  //! The file mapping (POSIX) or in-memory copy of the blob, when loaded.
+  void* mapping;
+  //! The length of the mapping in bytes (0 if not mapped).
+  size_t mappedLength;
+  //! In-memory copy of the blob on systems without mmap().
+  std::vector<char> blobStorage;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "compact_binary_space_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,453 @@
+/**
+ * @file core/tree/binary_space_tree/compact_binary_space_tree_impl.hpp
+ * @author Jianxin Zhang
+ *
+ * Implementation of CompactBinarySpaceTree, including saving the flattened
+ * tree as one relocatable blob and memory-mapping it back.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_COMPACT_BINARY_SPACE_TREE_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_COMPACT_BINARY_SPACE_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "compact_binary_space_tree.hpp"
+
+// For the element type codes shared with the mlpack binary matrix format.
+#include <mlpack/core/data/mlpack_binary.hpp>
+
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace tree {
+
+//! The magic bytes that begin a saved compact tree.
+const char CompactTreeMagic[8] = { 'M', 'L', 'P', 'A', 'C', 'K', 'C', 'T' };
+
+/**
+ * The fixed 128-byte header of a saved compact tree.  Every section offset
+ * is 64-byte aligned, so a memory-mapped blob presents aligned arrays.  All
+ * links inside the blob are offsets, never pointers, so the blob is
+ * relocatable and can be mapped at any address.
+ */
+struct CompactTreeHeader
+{
+  char magic[8];
+  uint16_t version;
+  uint16_t elemType;
+  uint32_t flags;
+  uint64_t numNodes;
+  uint64_t dims;
+  uint64_t numPoints;
+  uint64_t childLeftOffset;
+  uint64_t childRightOffset;
+  uint64_t beginsOffset;
+  uint64_t countsOffset;
+  uint64_t loBoundsOffset;
+  uint64_t hiBoundsOffset;
+  uint64_t datasetOffset;
+  char reserved[32];
+};
+
+static_assert(sizeof(CompactTreeHeader) == 128,
+    "CompactTreeHeader must be exactly 128 bytes!");
+
+//! Round the given offset up to the next multiple of 64.
+inline uint64_t CompactTreeAlign(const uint64_t offset)
+{
+  return (offset + 63) & ~uint64_t(63);
+}
+
+template<typename TreeType>
+CompactBinarySpaceTree<TreeType>::CompactBinarySpaceTree(
+    const TreeType& tree) :
+    dataset(&tree.Dataset()),
+    mapping(NULL),
+    mappedLength(0)
+{
+  // Walk the tree in breadth-first order; a node's children are appended to
+  // the order as it is visited, so child indices are known immediately.
+  std::vector<const TreeType*> bfsOrder;
+  bfsOrder.push_back(&tree);
+  std::vector<uint64_t> left, right, nodeBegins, nodeCounts;
+  for (size_t i = 0; i < bfsOrder.size(); ++i)
+  {
+    const TreeType* node = bfsOrder[i];
+    nodeBegins.push_back(node->Begin());
+    nodeCounts.push_back(node->Count());
+
+    if (node->IsLeaf())
+    {
+      left.push_back(0);
+      right.push_back(0);
+    }
+    else
+    {
+      left.push_back(bfsOrder.size());
+      bfsOrder.push_back(node->Left());
+      right.push_back(bfsOrder.size());
+      bfsOrder.push_back(node->Right());
+    }
+  }
+
+  numNodes = bfsOrder.size();
+
+  // Pack the four index arrays into one contiguous backing store.
+  indexStorage.reserve(4 * numNodes);
+  indexStorage.insert(indexStorage.end(), left.begin(), left.end());
+  indexStorage.insert(indexStorage.end(), right.begin(), right.end());
+  indexStorage.insert(indexStorage.end(), nodeBegins.begin(),
+      nodeBegins.end());
+  indexStorage.insert(indexStorage.end(), nodeCounts.begin(),
+      nodeCounts.end());
+  childLeft = indexStorage.data();
+  childRight = indexStorage.data() + numNodes;
+  begins = indexStorage.data() + 2 * numNodes;
+  counts = indexStorage.data() + 3 * numNodes;
+
+  // Pack the hyperrectangle bounds into two dense matrices, one column per
+  // node; this replaces one heap allocation per bound with two contiguous
+  // blocks.
+  const size_t dims = dataset->n_rows;
+  loBounds.reset(new arma::Mat<ElemType>(dims, numNodes));
+  hiBounds.reset(new arma::Mat<ElemType>(dims, numNodes));
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    for (size_t d = 0; d < dims; ++d)
+    {
+      (*loBounds)(d, i) = bfsOrder[i]->Bound()[d].Lo();
+      (*hiBounds)(d, i) = bfsOrder[i]->Bound()[d].Hi();
+    }
+  }
+}
+
+template<typename TreeType>
+CompactBinarySpaceTree<TreeType>::CompactBinarySpaceTree(
+    const std::string& filename) :
+    dataset(NULL),
+    mapping(NULL),
+    mappedLength(0)
+{
+  // Read and validate the header through a regular stream first, so that a
+  // bad file is rejected before anything is mapped.
+  std::fstream stream;
+  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+  if (!stream.is_open())
+    throw std::runtime_error("CompactBinarySpaceTree: cannot open file '" +
+        filename + "'!");
+
+  CompactTreeHeader header;
+  stream.read(reinterpret_cast<char*>(&header), sizeof(CompactTreeHeader));
+  if (!stream.good() ||
+      memcmp(header.magic, CompactTreeMagic, sizeof(CompactTreeMagic)) != 0)
+    throw std::runtime_error("CompactBinarySpaceTree: '" + filename +
+        "' does not hold a saved compact tree!");
+
+  if (header.version != 1)
+    throw std::runtime_error("CompactBinarySpaceTree: unknown compact tree "
+        "format version in '" + filename + "'!");
+
+  if (header.elemType != data::MlpackBinaryElementCode<ElemType>())
+    throw std::runtime_error("CompactBinarySpaceTree: element type of '" +
+        filename + "' does not match the requested element type!");
+
+  stream.seekg(0, std::ios::end);
+  const size_t fileLength = (size_t) stream.tellg();
+  const size_t neededLength = (size_t) (header.datasetOffset +
+      header.dims * header.numPoints * sizeof(ElemType));
+  if (fileLength < neededLength)
+    throw std::runtime_error("CompactBinarySpaceTree: '" + filename +
+        "' is truncated!");
+
+  char* base = NULL;
+#ifndef _WIN32
+  stream.close();
+
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw std::runtime_error("CompactBinarySpaceTree: cannot open file '" +
+        filename + "'!");
+
+  // Map copy-on-write, so the file itself can never be modified.
+  void* map = mmap(NULL, fileLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+      0);
+  close(fd); // The mapping holds its own reference to the file.
+
+  if (map == MAP_FAILED)
+    throw std::runtime_error("CompactBinarySpaceTree: cannot memory-map "
+        "file '" + filename + "'!");
+
+  mapping = map;
+  mappedLength = fileLength;
+  base = (char*) mapping;
+#else
+  // No mmap() on Windows; read the blob into memory instead.  The layout is
+  // identical, so everything below works the same way.
+  blobStorage.resize(fileLength);
+  stream.seekg(0, std::ios::beg);
+  stream.read(blobStorage.data(), fileLength);
+  if (!stream.good())
+    throw std::runtime_error("CompactBinarySpaceTree: cannot read file '" +
+        filename + "'!");
+  stream.close();
+  base = blobStorage.data();
+#endif
+
+  numNodes = (size_t) header.numNodes;
+
+  // Point the arrays directly into the blob; nothing is deserialized or
+  // copied, so the tree is ready to query immediately.
+  childLeft = reinterpret_cast<const uint64_t*>(base +
+      header.childLeftOffset);
+  childRight = reinterpret_cast<const uint64_t*>(base +
+      header.childRightOffset);
+  begins = reinterpret_cast<const uint64_t*>(base + header.beginsOffset);
+  counts = reinterpret_cast<const uint64_t*>(base + header.countsOffset);
+
+  loBounds.reset(new arma::Mat<ElemType>(
+      reinterpret_cast<ElemType*>(base + header.loBoundsOffset),
+      header.dims, header.numNodes, false, true));
+  hiBounds.reset(new arma::Mat<ElemType>(
+      reinterpret_cast<ElemType*>(base + header.hiBoundsOffset),
+      header.dims, header.numNodes, false, true));
+  mappedDataset.reset(new MatType(
+      reinterpret_cast<ElemType*>(base + header.datasetOffset),
+      header.dims, header.numPoints, false, true));
+  dataset = mappedDataset.get();
+}
+
+template<typename TreeType>
+CompactBinarySpaceTree<TreeType>::~CompactBinarySpaceTree()
+{
+  // The aliasing matrices must be destroyed before the mapping is released.
+  loBounds.reset();
+  hiBounds.reset();
+  mappedDataset.reset();
+
+#ifndef _WIN32
+  if (mapping != NULL)
+    munmap(mapping, mappedLength);
+#endif
+}
+
+template<typename TreeType>
+bool CompactBinarySpaceTree<TreeType>::Save(const std::string& filename)
+    const
+{
+  const uint64_t dims = dataset->n_rows;
+  const uint64_t numPoints = dataset->n_cols;
+  const uint64_t indexBytes = numNodes * sizeof(uint64_t);
+  const uint64_t boundBytes = dims * numNodes * sizeof(ElemType);
+
+  // Lay out the sections at 64-byte aligned offsets.
+  CompactTreeHeader header;
+  memset(&header, 0, sizeof(CompactTreeHeader));
+  memcpy(header.magic, CompactTreeMagic, sizeof(CompactTreeMagic));
+  header.version = 1;
+  header.elemType = data::MlpackBinaryElementCode<ElemType>();
+  header.numNodes = numNodes;
+  header.dims = dims;
+  header.numPoints = numPoints;
+  header.childLeftOffset = CompactTreeAlign(sizeof(CompactTreeHeader));
+  header.childRightOffset =
+      CompactTreeAlign(header.childLeftOffset + indexBytes);
+  header.beginsOffset = CompactTreeAlign(header.childRightOffset + indexBytes);
+  header.countsOffset = CompactTreeAlign(header.beginsOffset + indexBytes);
+  header.loBoundsOffset = CompactTreeAlign(header.countsOffset + indexBytes);
+  header.hiBoundsOffset = CompactTreeAlign(header.loBoundsOffset + boundBytes);
+  header.datasetOffset = CompactTreeAlign(header.hiBoundsOffset + boundBytes);
+
+  if (header.elemType == 0)
+  {
+    Log::Warn << "Compact tree element type cannot be stored!" << std::endl;
+    return false;
+  }
+
+  std::fstream stream;
+  stream.open(filename.c_str(),
+      std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (!stream.is_open())
+  {
+    Log::Warn << "Cannot open file '" << filename << "' for writing!"
+        << std::endl;
+    return false;
+  }
+
+  // Write each section at its offset, padding the alignment gaps with
+  // zeros.
+  const char zeros[64] = { 0 };
+  stream.write(reinterpret_cast<const char*>(&header),
+      sizeof(CompactTreeHeader));
+
+  auto padTo = [&](const uint64_t offset)
+  {
+    uint64_t pos = (uint64_t) stream.tellp();
+    while (pos < offset)
+    {
+      const uint64_t n = std::min((uint64_t) sizeof(zeros), offset - pos);
+      stream.write(zeros, n);
+      pos += n;
+    }
+  };
+
+  padTo(header.childLeftOffset);
+  stream.write(reinterpret_cast<const char*>(childLeft), indexBytes);
+  padTo(header.childRightOffset);
+  stream.write(reinterpret_cast<const char*>(childRight), indexBytes);
+  padTo(header.beginsOffset);
+  stream.write(reinterpret_cast<const char*>(begins), indexBytes);
+  padTo(header.countsOffset);
+  stream.write(reinterpret_cast<const char*>(counts), indexBytes);
+  padTo(header.loBoundsOffset);
+  stream.write(reinterpret_cast<const char*>(loBounds->memptr()),
+      boundBytes);
+  padTo(header.hiBoundsOffset);
+  stream.write(reinterpret_cast<const char*>(hiBounds->memptr()),
+      boundBytes);
+  padTo(header.datasetOffset);
+  stream.write(reinterpret_cast<const char*>(dataset->memptr()),
+      dims * numPoints * sizeof(ElemType));
+
+  return stream.good();
+}
+
+template<typename TreeType>
+template<typename VecType>
+typename CompactBinarySpaceTree<TreeType>::ElemType
+CompactBinarySpaceTree<TreeType>::Node::MinDistance(const VecType& point)
+    const
+{
+  const ElemType* lo = tree->loBounds->colptr(index);
+  const ElemType* hi = tree->hiBounds->colptr(index);
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < tree->loBounds->n_rows; ++d)
+  {
+    ElemType v = 0;
+    if (point[d] < lo[d])
+      v = lo[d] - point[d];
+    else if (point[d] > hi[d])
+      v = point[d] - hi[d];
+
+    sum += v * v;
+  }
+
+  return std::sqrt(sum);
+}
+
+template<typename TreeType>
+template<typename VecType>
+typename CompactBinarySpaceTree<TreeType>::ElemType
+CompactBinarySpaceTree<TreeType>::Node::MaxDistance(const VecType& point)
+    const
+{
+  const ElemType* lo = tree->loBounds->colptr(index);
+  const ElemType* hi = tree->hiBounds->colptr(index);
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < tree->loBounds->n_rows; ++d)
+  {
+    const ElemType v = std::max(std::abs(point[d] - lo[d]),
+                                std::abs(point[d] - hi[d]));
+    sum += v * v;
+  }
+
+  return std::sqrt(sum);
+}
+
+template<typename TreeType>
+template<typename RuleType>
+void CompactBinarySpaceTree<TreeType>::SingleTreeTraverser<RuleType>::
+Traverse(const size_t queryIndex, const Node& referenceNode)
+{
+  // If we are a leaf, run the base case as necessary.
+  if (referenceNode.IsLeaf())
+  {
+    const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+    for (size_t i = referenceNode.Begin(); i < refEnd; ++i)
+      rule.BaseCase(queryIndex, i);
+  }
+  else
+  {
+    // If it's the root node, just score it.
+    if (referenceNode.IsRoot())
+    {
+      const double rootScore = rule.Score(queryIndex, referenceNode);
+      // If root score is DBL_MAX, don't recurse into that node.
+      if (rootScore == DBL_MAX)
+      {
+        ++numPrunes;
+        return;
+      }
+    }
+
+    const Node left = referenceNode.Left();
+    const Node right = referenceNode.Right();
+
+    // If either score is DBL_MAX, we do not recurse into that node.
+    double leftScore = rule.Score(queryIndex, left);
+    double rightScore = rule.Score(queryIndex, right);
+
+    if (leftScore < rightScore)
+    {
+      // Recurse to the left.
+      Traverse(queryIndex, left);
+
+      // Is it still valid to recurse to the right?
+      rightScore = rule.Rescore(queryIndex, right, rightScore);
+
+      if (rightScore != DBL_MAX)
+        Traverse(queryIndex, right); // Recurse to the right.
+      else
+        ++numPrunes;
+    }
+    else if (rightScore < leftScore)
+    {
+      // Recurse to the right.
+      Traverse(queryIndex, right);
+
+      // Is it still valid to recurse to the left?
+      leftScore = rule.Rescore(queryIndex, left, leftScore);
+
+      if (leftScore != DBL_MAX)
+        Traverse(queryIndex, left); // Recurse to the left.
+      else
+        ++numPrunes;
+    }
+    else // leftScore is equal to rightScore.
+    {
+      if (leftScore == DBL_MAX)
+      {
+        numPrunes += 2; // Pruned both left and right.
+      }
+      else
+      {
+        // Choose the left first.
+        Traverse(queryIndex, left);
+
+        // Is it still valid to recurse to the right?
+        rightScore = rule.Rescore(queryIndex, right, rightScore);
+
+        if (rightScore != DBL_MAX)
+          Traverse(queryIndex, right);
+        else
+          ++numPrunes;
+      }
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -58,15 +58,24 @@ class CosineTree
    * split node. The basis vector from a node is the orthonormalized centroid of
    * its columns. The splitting continues till the Monte Carlo estimate of the
    * input matrix's projection on the obtained subspace is less than a fraction
-   * of the norm of the input matrix.
+   * of the norm of the input matrix, or, if 'maxRank' is nonzero, until the
+   * basis holds 'maxRank' vectors---whichever comes first.  This makes the
+   * constructor directly usable as a "rank-k approximation to error epsilon"
+   * primitive.  When OpenMP is available, the nodes with the highest errors
+   * are expanded in batches of up to one node per thread, since the splits
+   * and the Monte Carlo error estimates of the children are independent
+   * across nodes.
    *
    * @param dataset Matrix for which the CosineTree is constructed.
    * @param epsilon Error tolerance fraction for calculated subspace.
    * @param delta Cumulative probability for Monte Carlo error lower bound.
+   * @param maxRank Maximum number of basis vectors to build (0 means no
+   *      limit).
    */
   CosineTree(const arma::mat& dataset,
              const double epsilon,
-             const double delta);
+             const double delta,
+             const size_t maxRank = 0);
 
   /**
    * Copy the given tree.  Be careful!  This may use a lot of memory.
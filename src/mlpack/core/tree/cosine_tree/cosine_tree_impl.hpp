@@ -77,7 +77,8 @@ inline CosineTree::CosineTree(CosineTree& parentNode,
 
 inline CosineTree::CosineTree(const arma::mat& dataset,
                               const double epsilon,
-                              const double delta) :
+                              const double delta,
+                              const size_t maxRank) :
     dataset(&dataset),
     delta(delta),
     left(NULL),
@@ -98,18 +99,45 @@ inline CosineTree::CosineTree(const arma::mat& dataset,
   // Initialize Monte Carlo error estimate for comparison.
   double monteCarloError = root.FrobNormSquared();
 
+  // Expand the frontier in batches of up to one node per thread: the splits
+  // (and the error estimates of the resulting children) are independent
+  // across nodes, so only the Gram-Schmidt orthogonalization of the new basis
+  // vectors has to run sequentially.
+#ifdef HAS_OPENMP
+  const size_t maxBatchSize = (size_t) omp_get_max_threads();
+#else
+  const size_t maxBatchSize = 1;
+#endif
+
+  // Each split replaces one node in the queue with its two children, so the
+  // basis grows by one vector per split; a nonzero 'maxRank' caps it.
   while (treeQueue.size() > 0 &&
-         (monteCarloError > epsilon * root.FrobNormSquared()))
+         (monteCarloError > epsilon * root.FrobNormSquared()) &&
+         (maxRank == 0 || treeQueue.size() < maxRank))
   {
-    // Pop node from queue with highest projection error.
-    CosineTree* currentNode;
-    currentNode = treeQueue.front();
-    std::pop_heap(treeQueue.begin(), treeQueue.end(), comp);
-    treeQueue.pop_back();
-
-    // If the priority is 0, we can't improve anything, and we can assume that
-    // we've done the best we can.
-    if (currentNode->L2Error() == 0.0)
+    // Pop the nodes with the highest projection errors, up to the batch size
+    // (further limited so that the rank bound cannot be overshot).
+    size_t batchSize = maxBatchSize;
+    if (maxRank > 0)
+      batchSize = std::min(batchSize, maxRank - treeQueue.size());
+
+    std::vector<CosineTree*> batch;
+    while (batch.size() < batchSize && !treeQueue.empty())
+    {
+      CosineTree* currentNode = treeQueue.front();
+
+      // If the priority is 0 (or the node holds a single column), we can't
+      // improve anything more, and we can assume that we've done the best we
+      // can.
+      if (currentNode->L2Error() == 0.0 || currentNode->NumColumns() < 2)
+        break;
+
+      std::pop_heap(treeQueue.begin(), treeQueue.end(), comp);
+      treeQueue.pop_back();
+      batch.push_back(currentNode);
+    }
+
+    if (batch.empty())
     {
       Log::Warn << "CosineTree::CosineTree(): could not build tree to "
           << "desired relative error " << epsilon << "; failing with estimated "
@@ -118,36 +146,46 @@ inline CosineTree::CosineTree(const arma::mat& dataset,
       break;
     }
 
-    // Split the node into left and right children.  We assume that this cannot
-    // fail; it might fail if L2Error() is 0, but we have already avoided that
-    // case.
-    currentNode->CosineNodeSplit();
-
-    // Obtain pointers to the left and right children of the current node.
-    CosineTree *currentLeft, *currentRight;
-    currentLeft = currentNode->Left();
-    currentRight = currentNode->Right();
+    // Split each node of the batch into left and right children.  The splits
+    // touch disjoint sets of columns, so they can run concurrently.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) batch.size(); ++i)
+      batch[i]->CosineNodeSplit();
+
+    // Orthonormalize the centroids of the new children against the current
+    // basis.  This has to happen one vector at a time; pushing each child
+    // into the queue as soon as its basis vector is set makes the later
+    // children orthogonal to the earlier ones of the same batch.  The heap
+    // invariant is restored below, after the children receive their error
+    // estimates.
+    const size_t firstChild = treeQueue.size();
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      CosineTree* currentLeft = batch[i]->Left();
+      CosineTree* currentRight = batch[i]->Right();
 
-    // Calculate basis vectors of left and right children.
-    arma::vec lBasisVector, rBasisVector;
+      arma::vec lBasisVector, rBasisVector;
 
-    ModifiedGramSchmidt(treeQueue, currentLeft->Centroid(), lBasisVector);
-    ModifiedGramSchmidt(treeQueue, currentRight->Centroid(), rBasisVector,
-                        &lBasisVector);
+      ModifiedGramSchmidt(treeQueue, currentLeft->Centroid(), lBasisVector);
+      currentLeft->BasisVector(lBasisVector);
+      treeQueue.push_back(currentLeft);
 
-    // Add basis vectors to their respective nodes.
-    currentLeft->BasisVector(lBasisVector);
-    currentRight->BasisVector(rBasisVector);
+      ModifiedGramSchmidt(treeQueue, currentRight->Centroid(), rBasisVector);
+      currentRight->BasisVector(rBasisVector);
+      treeQueue.push_back(currentRight);
+    }
 
-    // Calculate Monte Carlo error estimates for child nodes.
-    MonteCarloError(currentLeft, treeQueue, &lBasisVector, &rBasisVector);
-    MonteCarloError(currentRight, treeQueue, &lBasisVector, &rBasisVector);
+    // Calculate Monte Carlo error estimates for the new children.  The
+    // estimates are per-node independent, and each call draws its samples
+    // into its own local buffers, so the children can be processed
+    // concurrently.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = firstChild; i < (omp_size_t) treeQueue.size(); ++i)
+      MonteCarloError(treeQueue[i], treeQueue);
 
-    // Push child nodes into the priority queue.
-    treeQueue.push_back(currentLeft);
-    std::push_heap(treeQueue.begin(), treeQueue.end(), comp);
-    treeQueue.push_back(currentRight);
-    std::push_heap(treeQueue.begin(), treeQueue.end(), comp);
+    // The children were appended with their errors not yet known; rebuild the
+    // heap ordering now that they are.
+    std::make_heap(treeQueue.begin(), treeQueue.end(), comp);
 
     // Calculate Monte Carlo error estimate for the root node.
     monteCarloError = MonteCarloError(&root, treeQueue);
@@ -434,7 +472,10 @@ inline double CosineTree::MonteCarloError(CosineTree* node,
     projectionSize = treeQueue.size();
 
   // For each sample, calculate the weighted projection onto the current basis.
-  for (size_t i = 0; i < numSamples; ++i)
+  // The samples were drawn up front, so each projection is independent and
+  // they can be computed in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numSamples; ++i)
   {
     // Initialize projection as a vector of zeros.
     arma::vec projection;
@@ -636,7 +677,10 @@ inline void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; ++i)
+  // The cosine of each column is independent of the others, so this loop (the
+  // hot loop of a node split) can run in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
     // between two vectors.
@@ -658,10 +702,22 @@ inline void CosineTree::CalculateCentroid()
   // Initialize centroid as vector of zeros.
   centroid.zeros(dataset->n_rows);
 
-  // Calculate centroid of columns in the node.
-  for (size_t i = 0; i < numColumns; ++i)
+  // Calculate centroid of columns in the node; each thread accumulates its
+  // own partial sum, and the partial sums are combined at the end.
+  #pragma omp parallel
   {
-    centroid += dataset->col(indices[i]);
+    arma::vec localCentroid(dataset->n_rows, arma::fill::zeros);
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
+    {
+      localCentroid += dataset->col(indices[i]);
+    }
+
+    #pragma omp critical
+    {
+      centroid += localCentroid;
+    }
   }
   centroid /= numColumns;
 }
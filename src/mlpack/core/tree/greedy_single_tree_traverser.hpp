@@ -37,6 +37,20 @@ class GreedySingleTreeTraverser
    */
   void Traverse(const size_t queryIndex, TreeType& referenceNode);
 
+  /**
+   * Traverse the tree with a batch of points at once.  The whole batch walks
+   * down the tree together, splitting at each node by which child each point
+   * prefers, so every tree node and reference point touched is fetched once
+   * per batch instead of once per query point.  The result is identical to
+   * calling the single-point Traverse() for each index in turn.
+   *
+   * @param queryIndices The indices of the points in the query set which are
+   *     being used as query points.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const std::vector<size_t>& queryIndices,
+                TreeType& referenceNode);
+
   //! Get the number of prunes.
   size_t NumPrunes() const { return numPrunes; }
 
@@ -68,6 +68,55 @@ void GreedySingleTreeTraverser<TreeType, RuleType>::Traverse(
   }
 }
 
+template<typename TreeType, typename RuleType>
+void GreedySingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const std::vector<size_t>& queryIndices,
+    TreeType& referenceNode)
+{
+  // Run the base case as necessary for all the points in the reference node.
+  // The loop over the batch is innermost, so each reference point is fetched
+  // from memory once per batch instead of once per query point.
+  for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
+    for (size_t j = 0; j < queryIndices.size(); ++j)
+      rule.BaseCase(queryIndices[j], referenceNode.Point(i));
+
+  if (referenceNode.IsLeaf())
+    return;
+
+  // Split the batch by which child each query point prefers.
+  std::vector<std::vector<size_t>> childBatches(referenceNode.NumChildren());
+  for (size_t j = 0; j < queryIndices.size(); ++j)
+  {
+    const size_t bestChild = rule.GetBestChild(queryIndices[j], referenceNode);
+    const size_t numDescendants =
+        referenceNode.Child(bestChild).NumDescendants();
+
+    // As in the single-point traversal, descend only if the best child has
+    // more than rule.MinimumBaseCases() descendants; otherwise run the base
+    // case over the first descendants of this node directly.
+    if (numDescendants > rule.MinimumBaseCases())
+    {
+      childBatches[bestChild].push_back(queryIndices[j]);
+    }
+    else
+    {
+      for (size_t i = 0; i <= rule.MinimumBaseCases(); ++i)
+        rule.BaseCase(queryIndices[j], referenceNode.Descendant(i));
+    }
+  }
+
+  // Recurse into each child that some part of the batch prefers.  Each query
+  // point that descends prunes all of the other children.
+  for (size_t c = 0; c < childBatches.size(); ++c)
+  {
+    if (childBatches[c].empty())
+      continue;
+
+    numPrunes += childBatches[c].size() * (referenceNode.NumChildren() - 1);
+    Traverse(childBatches[c], referenceNode.Child(c));
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
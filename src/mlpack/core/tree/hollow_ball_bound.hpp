@@ -157,6 +157,21 @@ class HollowBallBound
                        typename std::enable_if_t<IsVector<VecType>::value>* = 0)
       const;
 
+  /**
+   * Calculates the minimum bound-to-point distance for every column of the
+   * given matrix at once.  The distances to the center and to the hollow
+   * center are computed in one bulk pass -- a single matrix product for the
+   * L2 metric -- which is much faster than calling the single-point overload
+   * once per column.
+   *
+   * @param points Points to which the minimum distances are requested (one
+   *     per column).
+   * @param distances Output vector; set to points.n_cols distances.
+   */
+  template<typename MatType>
+  void MinDistance(const MatType& points,
+                   arma::Col<ElemType>& distances) const;
+
   /**
    * Calculates minimum bound-to-bound squared distance.
    *
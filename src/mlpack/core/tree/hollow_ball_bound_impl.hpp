@@ -14,6 +14,7 @@
 
 // In case it hasn't been included already.
 #include "hollow_ball_bound.hpp"
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 
 namespace mlpack {
 namespace bound {
@@ -239,6 +240,51 @@ ElemType HollowBallBound<TMetricType, ElemType>::MinDistance(
   }
 }
 
+/**
+ * Calculates minimum bound-to-point distances in bulk.
+ */
+template<typename TMetricType, typename ElemType>
+template<typename MatType>
+void HollowBallBound<TMetricType, ElemType>::MinDistance(
+    const MatType& points,
+    arma::Col<ElemType>& distances) const
+{
+  distances.set_size(points.n_cols);
+
+  if (radii.Hi() < 0)
+  {
+    distances.fill(std::numeric_limits<ElemType>::max());
+    return;
+  }
+
+  // Compute the distances from every point to the center and to the hollow
+  // center in one bulk pass; for the L2 metric the dominant cost is a single
+  // matrix product.
+  arma::Mat<ElemType> centers(center.n_elem, 2);
+  centers.col(0) = center;
+  centers.col(1) = hollowCenter;
+  arma::mat centerDistances;
+  mlpack::metric::PairwiseDistances(centers, points, centerDistances, *metric);
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const ElemType outerDistance = (ElemType) centerDistances(0, i) -
+        radii.Hi();
+
+    if (outerDistance >= 0)
+    {
+      // The outer ball does not contain the point.
+      distances[i] = outerDistance;
+    }
+    else
+    {
+      // Check if the point is situated in the hole.
+      distances[i] = math::ClampNonNegative(radii.Lo() -
+          (ElemType) centerDistances(1, i));
+    }
+  }
+}
+
 /**
  * Calculates minimum bound-to-bound squared distance.
  */
@@ -192,6 +192,42 @@ inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
 {
   Log::Assert(point.n_elem == dim);
 
+  // Fast path for the L2 metric, the overwhelmingly common case and the
+  // hottest loop in tree traversals.  Four independent accumulators break the
+  // serial dependency chain on the sum, and the body is straight-line
+  // branchless arithmetic over the contiguous bounds array, which compilers
+  // can turn into SIMD code (SSE/AVX/AVX-512, whatever the target offers)
+  // without any intrinsics.
+  if (MetricType::Power == 2)
+  {
+    ElemType sums[4] = { 0, 0, 0, 0 };
+    size_t d = 0;
+    for (; d + 4 <= dim; d += 4)
+    {
+      for (size_t k = 0; k < 4; ++k)
+      {
+        const ElemType lo = bounds[d + k].Lo() - point[d + k];
+        const ElemType hi = point[d + k] - bounds[d + k].Hi();
+        const ElemType dist = (lo + std::fabs(lo)) + (hi + std::fabs(hi));
+        sums[k] += dist * dist;
+      }
+    }
+    for (; d < dim; ++d)
+    {
+      const ElemType lo = bounds[d].Lo() - point[d];
+      const ElemType hi = point[d] - bounds[d].Hi();
+      const ElemType dist = (lo + std::fabs(lo)) + (hi + std::fabs(hi));
+      sums[0] += dist * dist;
+    }
+
+    // Cancel out the constant of 2 introduced by the branchless max.
+    const ElemType total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(total) * 0.5;
+    else
+      return total * 0.25;
+  }
+
   ElemType sum = 0;
 
   ElemType lower, higher;
@@ -249,6 +285,36 @@ ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
 {
   Log::Assert(dim == other.dim);
 
+  // Fast path for the L2 metric; see MinDistance(point) above.
+  if (MetricType::Power == 2)
+  {
+    ElemType sums[4] = { 0, 0, 0, 0 };
+    size_t d = 0;
+    for (; d + 4 <= dim; d += 4)
+    {
+      for (size_t k = 0; k < 4; ++k)
+      {
+        const ElemType lo = other.bounds[d + k].Lo() - bounds[d + k].Hi();
+        const ElemType hi = bounds[d + k].Lo() - other.bounds[d + k].Hi();
+        const ElemType dist = (lo + std::fabs(lo)) + (hi + std::fabs(hi));
+        sums[k] += dist * dist;
+      }
+    }
+    for (; d < dim; ++d)
+    {
+      const ElemType lo = other.bounds[d].Lo() - bounds[d].Hi();
+      const ElemType hi = bounds[d].Lo() - other.bounds[d].Hi();
+      const ElemType dist = (lo + std::fabs(lo)) + (hi + std::fabs(hi));
+      sums[0] += dist * dist;
+    }
+
+    const ElemType total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(total) * 0.5;
+    else
+      return total * 0.25;
+  }
+
   ElemType sum = 0;
   const math::RangeType<ElemType>* mbound = bounds;
   const math::RangeType<ElemType>* obound = other.bounds;
@@ -314,6 +380,35 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
 
   Log::Assert(point.n_elem == dim);
 
+  // Fast path for the L2 metric; see MinDistance(point) above.
+  if (MetricType::Power == 2)
+  {
+    ElemType sums[4] = { 0, 0, 0, 0 };
+    size_t d = 0;
+    for (; d + 4 <= dim; d += 4)
+    {
+      for (size_t k = 0; k < 4; ++k)
+      {
+        const ElemType v = std::max(
+            std::fabs(point[d + k] - bounds[d + k].Lo()),
+            std::fabs(bounds[d + k].Hi() - point[d + k]));
+        sums[k] += v * v;
+      }
+    }
+    for (; d < dim; ++d)
+    {
+      const ElemType v = std::max(std::fabs(point[d] - bounds[d].Lo()),
+          std::fabs(bounds[d].Hi() - point[d]));
+      sums[0] += v * v;
+    }
+
+    const ElemType total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(total);
+    else
+      return total;
+  }
+
   for (size_t d = 0; d < dim; d++)
   {
     ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
@@ -354,6 +449,36 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
 
   Log::Assert(dim == other.dim);
 
+  // Fast path for the L2 metric; see MinDistance(point) above.
+  if (MetricType::Power == 2)
+  {
+    ElemType sums[4] = { 0, 0, 0, 0 };
+    size_t d = 0;
+    for (; d + 4 <= dim; d += 4)
+    {
+      for (size_t k = 0; k < 4; ++k)
+      {
+        const ElemType v = std::max(
+            std::fabs(other.bounds[d + k].Hi() - bounds[d + k].Lo()),
+            std::fabs(bounds[d + k].Hi() - other.bounds[d + k].Lo()));
+        sums[k] += v * v;
+      }
+    }
+    for (; d < dim; ++d)
+    {
+      const ElemType v = std::max(
+          std::fabs(other.bounds[d].Hi() - bounds[d].Lo()),
+          std::fabs(bounds[d].Hi() - other.bounds[d].Lo()));
+      sums[0] += v * v;
+    }
+
+    const ElemType total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(total);
+    else
+      return total;
+  }
+
   ElemType v;
   for (size_t d = 0; d < dim; d++)
   {
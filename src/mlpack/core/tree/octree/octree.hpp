@@ -13,6 +13,7 @@
 #define MLPACK_CORE_TREE_OCTREE_OCTREE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/arena_allocator.hpp>
 #include "../hrectbound.hpp"
 #include "../statistic.hpp"
 
@@ -63,6 +64,11 @@ class Octree
   ElemType furthestDescendantDistance;
   //! An instantiated metric.
   MetricType metric;
+  //! The arena every descendant node was allocated from, when this tree was
+  //! built by one of the building constructors; the root owns the arena and
+  //! destroys all descendants at once by destroying it.  NULL for trees whose
+  //! nodes were allocated individually (copies and deserialized trees).
+  util::ArenaAllocator* arena = NULL;
 
  public:
   /**
@@ -72,8 +78,12 @@ class Octree
    *
    * @param data Dataset to create tree from.  This will be copied!
    * @param maxLeafSize Maximum number of points in a leaf node.
+   * @param mortonBuild If true, use the Morton-code-based bulk build (see
+   *      MortonBuild()) instead of recursive partitioning.
    */
-  Octree(const MatType& data, const size_t maxLeafSize = 20);
+  Octree(const MatType& data,
+         const size_t maxLeafSize = 20,
+         const bool mortonBuild = false);
 
   /**
    * Construct this as the root node of an octree on the given dataset.  This
@@ -86,10 +96,13 @@ class Octree
    * @param oldFromNew Vector which will be filled with the old positions for
    *      each new point.
    * @param maxLeafSize Maximum number of points in a leaf node.
+   * @param mortonBuild If true, use the Morton-code-based bulk build (see
+   *      MortonBuild()) instead of recursive partitioning.
    */
   Octree(const MatType& data,
          std::vector<size_t>& oldFromNew,
-         const size_t maxLeafSize = 20);
+         const size_t maxLeafSize = 20,
+         const bool mortonBuild = false);
 
   /**
    * Construct this as the root node of an octree on the given dataset.  This
@@ -105,11 +118,14 @@ class Octree
    * @param newFromOld Vector which will be filled with the new positions for
    *      each old point.
    * @param maxLeafSize Maximum number of points in a leaf node.
+   * @param mortonBuild If true, use the Morton-code-based bulk build (see
+   *      MortonBuild()) instead of recursive partitioning.
    */
   Octree(const MatType& data,
          std::vector<size_t>& oldFromNew,
          std::vector<size_t>& newFromOld,
-         const size_t maxLeafSize = 20);
+         const size_t maxLeafSize = 20,
+         const bool mortonBuild = false);
 
   /**
    * Construct this as the root node of an octree on the given dataset.  This
@@ -118,8 +134,12 @@ class Octree
    *
    * @param data Dataset to create tree from.  This will be copied!
    * @param maxLeafSize Maximum number of points in a leaf node.
+   * @param mortonBuild If true, use the Morton-code-based bulk build (see
+   *      MortonBuild()) instead of recursive partitioning.
    */
-  Octree(MatType&& data, const size_t maxLeafSize = 20);
+  Octree(MatType&& data,
+         const size_t maxLeafSize = 20,
+         const bool mortonBuild = false);
 
   /**
    * Construct this as the root node of an octree on the given dataset. This
@@ -132,10 +152,13 @@ class Octree
    * @param oldFromNew Vector which will be filled with the old positions for
    *      each new point.
    * @param maxLeafSize Maximum number of points in a leaf node.
+   * @param mortonBuild If true, use the Morton-code-based bulk build (see
+   *      MortonBuild()) instead of recursive partitioning.
    */
   Octree(MatType&& data,
          std::vector<size_t>& oldFromNew,
-         const size_t maxLeafSize = 20);
+         const size_t maxLeafSize = 20,
+         const bool mortonBuild = false);
 
   /**
    * Construct this as the root node of an octree on the given dataset.  This
@@ -151,11 +174,14 @@ class Octree
    * @param newFromOld Vector which will be filled with the new positions for
    *      each old point.
    * @param maxLeafSize Maximum number of points in a leaf node.
+   * @param mortonBuild If true, use the Morton-code-based bulk build (see
+   *      MortonBuild()) instead of recursive partitioning.
    */
   Octree(MatType&& data,
          std::vector<size_t>& oldFromNew,
          std::vector<size_t>& newFromOld,
-         const size_t maxLeafSize = 20);
+         const size_t maxLeafSize = 20,
+         const bool mortonBuild = false);
 
   /**
    * Construct this node as a child of the given parent, starting at column
@@ -205,6 +231,33 @@ class Octree
          const double width,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Construct this node as a child of the given parent during a Morton-code
+   * build, starting at column begin and using count points.  The dataset is
+   * already in Morton order, so this does not modify it; children are derived
+   * from the next chunk of the points' Morton codes.  This is used for
+   * recursive tree-building by MortonBuild().
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of the first point held by this node.
+   * @param count Number of points held by this node.
+   * @param codes Morton codes of all points, in sorted (dataset) order.
+   * @param level Depth of this node; chunk of the codes to split on.
+   * @param bitsPerDim Number of bits each dimension contributes to a code.
+   * @param center Center of the node (for splitting).
+   * @param width Width of the node in each dimension.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(Octree* parent,
+         const size_t begin,
+         const size_t count,
+         const std::vector<uint64_t>& codes,
+         const size_t level,
+         const size_t bitsPerDim,
+         const arma::vec& center,
+         const double width,
+         const size_t maxLeafSize);
+
   /**
    * Copy the given tree.  Be careful!  This may use a lot of memory.
    *
@@ -413,6 +466,13 @@ class Octree
   friend class cereal::access;
 
  private:
+  /**
+   * Release this node's descendants: in one sweep through the arena when the
+   * tree was built by a building constructor, or by recursive deletion when
+   * the nodes were allocated individually.
+   */
+  void FreeChildren();
+
   /**
    * Split the node, using the given center and the given maximum width of this
    * node.
@@ -439,6 +499,62 @@ class Octree
                  std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize);
 
+  /**
+   * Build the tree below the root in bulk from Morton codes, instead of
+   * recursively partitioning the dataset per octant.  Each point's
+   * coordinates are quantized onto a 2^bitsPerDim grid over the root cube and
+   * the grid bits are interleaved into a Morton code, so that sorting the
+   * codes arranges the points in exactly the order a recursive octant
+   * partition would; the node hierarchy is then read off the code prefixes
+   * without touching the dataset again.  Codes are computed in parallel and
+   * sorted with an LSD radix sort, so the build is O(n) after the O(n) code
+   * pass.  The resulting hierarchy is the same as SplitNode()'s, up to the
+   * order of points inside each leaf.
+   *
+   * This may only be called on the root node, and falls back to SplitNode()
+   * if the dimensionality is too high for at least one bit per dimension.
+   *
+   * @param center Center of the root node.
+   * @param width Width of the root node in each dimension.
+   * @param oldFromNew Mappings from old to new; must already be initialized.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void MortonBuild(const arma::vec& center,
+                   const double width,
+                   std::vector<size_t>& oldFromNew,
+                   const size_t maxLeafSize);
+
+  /**
+   * Bulk build from Morton codes without keeping any mappings; see the other
+   * overload.
+   *
+   * @param center Center of the root node.
+   * @param width Width of the root node in each dimension.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void MortonBuild(const arma::vec& center,
+                   const double width,
+                   const size_t maxLeafSize);
+
+  /**
+   * Create the children of this node from one chunk of the sorted Morton
+   * codes.  The dataset is already in Morton order, so each octant is a
+   * contiguous run of equal code chunks at this level.
+   *
+   * @param codes Morton codes of all points, in sorted (dataset) order.
+   * @param level Depth of this node; chunk of the codes to split on.
+   * @param bitsPerDim Number of bits each dimension contributes to a code.
+   * @param center Center of the node.
+   * @param width Width of the current node.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void SplitNodeMorton(const std::vector<uint64_t>& codes,
+                       const size_t level,
+                       const size_t bitsPerDim,
+                       const arma::vec& center,
+                       const double width,
+                       const size_t maxLeafSize);
+
   /**
    * This is used for sorting points while splitting.
    */
@@ -14,6 +14,7 @@
 
 #include "octree.hpp"
 #include <mlpack/core/tree/perform_split.hpp>
+#include <algorithm>
 #include <stack>
 
 namespace mlpack {
@@ -22,7 +23,8 @@ namespace tree {
 //! Construct the tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(const MatType& dataset,
-                                                   const size_t maxLeafSize) :
+                                                   const size_t maxLeafSize,
+                                                   const bool mortonBuild) :
     begin(0),
     count(dataset.n_cols),
     bound(dataset.n_rows),
@@ -30,6 +32,11 @@ Octree<MetricType, StatisticType, MatType>::Octree(const MatType& dataset,
     parent(NULL),
     parentDistance(0.0)
 {
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
   if (count > 0)
   {
     // Calculate empirical center of data.
@@ -42,7 +49,10 @@ Octree<MetricType, StatisticType, MatType>::Octree(const MatType& dataset,
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, maxLeafSize);
+    if (mortonBuild)
+      MortonBuild(center, maxWidth, maxLeafSize);
+    else
+      SplitNode(center, maxWidth, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -60,7 +70,8 @@ template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(
     const MatType& dataset,
     std::vector<size_t>& oldFromNew,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool mortonBuild) :
     begin(0),
     count(dataset.n_cols),
     bound(dataset.n_rows),
@@ -72,6 +83,11 @@ Octree<MetricType, StatisticType, MatType>::Octree(
   for (size_t i = 0; i < this->dataset->n_cols; ++i)
     oldFromNew[i] = i;
 
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
   if (count > 0)
   {
     // Calculate empirical center of data.
@@ -84,7 +100,10 @@ Octree<MetricType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    if (mortonBuild)
+      MortonBuild(center, maxWidth, oldFromNew, maxLeafSize);
+    else
+      SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -103,7 +122,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     const MatType& dataset,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool mortonBuild) :
     begin(0),
     count(dataset.n_cols),
     bound(dataset.n_rows),
@@ -115,6 +135,11 @@ Octree<MetricType, StatisticType, MatType>::Octree(
   for (size_t i = 0; i < this->dataset->n_cols; ++i)
     oldFromNew[i] = i;
 
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
   if (count > 0)
   {
     // Calculate empirical center of data.
@@ -127,7 +152,10 @@ Octree<MetricType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    if (mortonBuild)
+      MortonBuild(center, maxWidth, oldFromNew, maxLeafSize);
+    else
+      SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -148,7 +176,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
 //! Construct the tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(MatType&& dataset,
-                                                   const size_t maxLeafSize) :
+                                                   const size_t maxLeafSize,
+                                                   const bool mortonBuild) :
     begin(0),
     count(dataset.n_cols),
     bound(dataset.n_rows),
@@ -156,6 +185,11 @@ Octree<MetricType, StatisticType, MatType>::Octree(MatType&& dataset,
     parent(NULL),
     parentDistance(0.0)
 {
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
   if (count > 0)
   {
     // Calculate empirical center of data.
@@ -168,7 +202,10 @@ Octree<MetricType, StatisticType, MatType>::Octree(MatType&& dataset,
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, maxLeafSize);
+    if (mortonBuild)
+      MortonBuild(center, maxWidth, maxLeafSize);
+    else
+      SplitNode(center, maxWidth, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -186,7 +223,8 @@ template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(
     MatType&& dataset,
     std::vector<size_t>& oldFromNew,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool mortonBuild) :
     begin(0),
     count(dataset.n_cols),
     bound(dataset.n_rows),
@@ -198,6 +236,11 @@ Octree<MetricType, StatisticType, MatType>::Octree(
   for (size_t i = 0; i < this->dataset->n_cols; ++i)
     oldFromNew[i] = i;
 
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
   if (count > 0)
   {
     // Calculate empirical center of data.
@@ -210,7 +253,10 @@ Octree<MetricType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    if (mortonBuild)
+      MortonBuild(center, maxWidth, oldFromNew, maxLeafSize);
+    else
+      SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -229,7 +275,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     MatType&& dataset,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool mortonBuild) :
     begin(0),
     count(dataset.n_cols),
     bound(dataset.n_rows),
@@ -241,6 +288,11 @@ Octree<MetricType, StatisticType, MatType>::Octree(
   for (size_t i = 0; i < this->dataset->n_cols; ++i)
     oldFromNew[i] = i;
 
+  // All descendant nodes will be carved out of this arena, which the root
+  // owns; teardown then frees the arena in one sweep instead of recursing
+  // with one delete per node.
+  arena = new util::ArenaAllocator();
+
   if (count > 0)
   {
     // Calculate empirical center of data.
@@ -253,7 +305,10 @@ Octree<MetricType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    if (mortonBuild)
+      MortonBuild(center, maxWidth, oldFromNew, maxLeafSize);
+    else
+      SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -286,6 +341,9 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     dataset(parent->dataset),
     parent(parent)
 {
+  // Children are carved out of the same arena as the rest of the tree.
+  arena = parent->arena;
+
   // Calculate empirical center of data.
   bound |= dataset->cols(begin, begin + count - 1);
 
@@ -321,6 +379,9 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     dataset(parent->dataset),
     parent(parent)
 {
+  // Children are carved out of the same arena as the rest of the tree.
+  arena = parent->arena;
+
   // Calculate empirical center of data.
   bound |= dataset->cols(begin, begin + count - 1);
 
@@ -340,6 +401,46 @@ Octree<MetricType, StatisticType, MatType>::Octree(
   stat = StatisticType(*this);
 }
 
+//! Construct a child node during a Morton-code build.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    Octree* parent,
+    const size_t begin,
+    const size_t count,
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const arma::vec& center,
+    const double width,
+    const size_t maxLeafSize) :
+    begin(begin),
+    count(count),
+    bound(parent->dataset->n_rows),
+    dataset(parent->dataset),
+    parent(parent)
+{
+  // Children are carved out of the same arena as the rest of the tree.
+  arena = parent->arena;
+
+  // Calculate empirical center of data.
+  bound |= dataset->cols(begin, begin + count - 1);
+
+  // Now split the node; the dataset is already in Morton order.
+  SplitNodeMorton(codes, level, bitsPerDim, center, width, maxLeafSize);
+
+  // Calculate the distance from the empirical center of this node to the
+  // empirical center of the parent.
+  arma::vec trueCenter, parentCenter;
+  bound.Center(trueCenter);
+  parent->Bound().Center(parentCenter);
+  parentDistance = metric.Evaluate(trueCenter, parentCenter);
+
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
 //! Copy the given tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(const Octree& other) :
@@ -375,9 +476,7 @@ operator=(const Octree& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
-  children.clear();
+  FreeChildren();
 
   begin = other.Begin();
   count = other.Count();
@@ -418,6 +517,11 @@ Octree<MetricType, StatisticType, MatType>::Octree(Octree&& other) :
   for (size_t i = 0; i < children.size(); ++i)
     children[i]->parent = this;
 
+  // Take over the arena (if any); its address is stable, so the descendants'
+  // arena pointers stay valid.
+  arena = other.arena;
+  other.arena = NULL;
+
   other.begin = 0;
   other.count = 0;
   other.dataset = new MatType();
@@ -438,9 +542,7 @@ operator=(Octree&& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
-  children.clear();
+  FreeChildren();
 
   children = std::move(other.children);
   begin = other.Begin();
@@ -457,6 +559,11 @@ operator=(Octree&& other)
   for (size_t i = 0; i < children.size(); ++i)
     children[i]->parent = this;
 
+  // Take over the arena (if any); its address is stable, so the descendants'
+  // arena pointers stay valid.
+  arena = other.arena;
+  other.arena = NULL;
+
   other.begin = 0;
   other.count = 0;
   other.dataset = new MatType();
@@ -499,9 +606,30 @@ Octree<MetricType, StatisticType, MatType>::~Octree()
   if (!parent)
     delete dataset;
 
-  // Now delete each of the children.
-  for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
+  // Now delete the children.
+  FreeChildren();
+}
+
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::FreeChildren()
+{
+  if (arena != NULL)
+  {
+    // Every descendant lives in the arena; destroying the arena runs all of
+    // their destructors in one linear sweep and releases the memory in a few
+    // bulk frees.  Only the root owns the arena.  When the arena runs a
+    // descendant's destructor, that destructor ends up back here, sees a
+    // non-NULL parent, and does nothing.
+    if (parent == NULL)
+      delete arena;
+    arena = NULL;
+  }
+  else
+  {
+    for (size_t i = 0; i < children.size(); ++i)
+      delete children[i];
+  }
+
   children.clear();
 }
 
@@ -712,12 +840,12 @@ void Octree<MetricType, StatisticType, MatType>::serialize(
     Archive& ar,
     const uint32_t /* version */)
 {
-  // If we're loading and we have children, they need to be deleted.
+  // If we're loading and we have children, they need to be deleted.  The
+  // loaded nodes will be allocated individually by cereal, so the arena (if
+  // this tree was built into one) is not reused.
   if (cereal::is_loading<Archive>())
   {
-    for (size_t i = 0; i < children.size(); ++i)
-      delete children[i];
-    children.clear();
+    FreeChildren();
 
     if (!parent)
       delete dataset;
@@ -865,7 +993,7 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
         childCenter[d] = center[d] + childWidth;
     }
 
-    children.push_back(new Octree(this, childBegins[i],
+    children.push_back(arena->New<Octree>(this, childBegins[i],
         childBegins[i + 1] - childBegins[i], childCenter, childWidth,
         maxLeafSize));
   }
@@ -967,12 +1095,175 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
         childCenter[d] = center[d] + childWidth;
     }
 
-    children.push_back(new Octree(this, childBegins[i],
+    children.push_back(arena->New<Octree>(this, childBegins[i],
         childBegins[i + 1] - childBegins[i], oldFromNew, childCenter,
         childWidth, maxLeafSize));
   }
 }
 
+//! Build the tree below the root from Morton codes, and store mappings.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::MortonBuild(
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>& oldFromNew,
+    const size_t maxLeafSize)
+{
+  // No need to split if we have fewer than the maximum number of points in
+  // this node, or if all points are identical.
+  if (count <= maxLeafSize || width <= 0.0)
+    return;
+
+  const size_t dims = dataset->n_rows;
+
+  // Each dimension contributes the same number of bits to a 64-bit code, and
+  // each bit corresponds to one level of octant splits.  If the
+  // dimensionality is too high for a useful number of levels, fall back to
+  // the recursive build.
+  if (dims > 32)
+  {
+    SplitNode(center, width, oldFromNew, maxLeafSize);
+    return;
+  }
+  const size_t bitsPerDim = std::min((size_t) 32, (size_t) 64 / dims);
+
+  // Quantize every point onto the grid and interleave the grid bits into
+  // Morton codes, in parallel.  The grid covers [center - width,
+  // center + width) in every dimension: the recursive build splits at the
+  // center and then at the centers of child cells of half the width, so bit
+  // l (from the most significant) of a dimension's grid coordinate is
+  // exactly that dimension's side of the level-l split.
+  const uint64_t cellsPerDim = ((uint64_t) 1 << bitsPerDim);
+  const double scale = (double) cellsPerDim / (2.0 * width);
+  std::vector<uint64_t> codes(count);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) count; ++i)
+  {
+    uint64_t code = 0;
+    for (size_t d = 0; d < dims; ++d)
+    {
+      const double v = ((double) (*dataset)(d, i) - (center[d] - width)) *
+          scale;
+      const uint64_t gridCoord = (v <= 0.0) ? 0 :
+          std::min((uint64_t) v, cellsPerDim - 1);
+
+      // Spread the bits of the grid coordinate so that bit l of the
+      // coordinate lands at position (l * dims + d) of the code: each
+      // dims-wide chunk of the code is then one level's octant index.
+      for (size_t l = 0; l < bitsPerDim; ++l)
+        code |= ((gridCoord >> l) & 1) << (l * dims + d);
+    }
+    codes[i] = code;
+  }
+
+  // Sort the codes with an LSD radix sort over 8-bit digits, carrying the
+  // permutation along.
+  std::vector<size_t> order(count), orderAlt(count);
+  for (size_t i = 0; i < count; ++i)
+    order[i] = i;
+  std::vector<uint64_t> codesAlt(count);
+  const size_t passes = (bitsPerDim * dims + 7) / 8;
+  for (size_t pass = 0; pass < passes; ++pass)
+  {
+    const size_t shift = 8 * pass;
+    size_t bucketStarts[257] = { 0 };
+    for (size_t i = 0; i < count; ++i)
+      ++bucketStarts[((codes[i] >> shift) & 0xFF) + 1];
+    for (size_t b = 1; b < 257; ++b)
+      bucketStarts[b] += bucketStarts[b - 1];
+    for (size_t i = 0; i < count; ++i)
+    {
+      const size_t target = bucketStarts[(codes[i] >> shift) & 0xFF]++;
+      codesAlt[target] = codes[i];
+      orderAlt[target] = order[i];
+    }
+    codes.swap(codesAlt);
+    order.swap(orderAlt);
+  }
+
+  // Rearrange the dataset (and the mappings) into Morton order.
+  MatType sortedDataset(dataset->n_rows, dataset->n_cols);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) count; ++i)
+    sortedDataset.col(i) = dataset->col(order[i]);
+  *dataset = std::move(sortedDataset);
+
+  std::vector<size_t> sortedOldFromNew(count);
+  for (size_t i = 0; i < count; ++i)
+    sortedOldFromNew[i] = oldFromNew[order[i]];
+  oldFromNew.swap(sortedOldFromNew);
+
+  // Now derive the node hierarchy from the code prefixes.
+  SplitNodeMorton(codes, 0, bitsPerDim, center, width, maxLeafSize);
+}
+
+//! Build the tree below the root from Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::MortonBuild(
+    const arma::vec& center,
+    const double width,
+    const size_t maxLeafSize)
+{
+  // The mappings are cheap next to the rest of the build; use the other
+  // overload and throw them away.
+  std::vector<size_t> oldFromNew(count);
+  for (size_t i = 0; i < count; ++i)
+    oldFromNew[i] = i;
+
+  MortonBuild(center, width, oldFromNew, maxLeafSize);
+}
+
+//! Create the children of the node from the sorted Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::SplitNodeMorton(
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const arma::vec& center,
+    const double width,
+    const size_t maxLeafSize)
+{
+  // No need to split if we have fewer than the maximum number of points in
+  // this node, or if the codes have no chunks left (which can only happen
+  // when many points share a grid cell).
+  if (count <= maxLeafSize || level == bitsPerDim)
+    return;
+
+  const size_t dims = dataset->n_rows;
+  const size_t shift = (bitsPerDim - 1 - level) * dims;
+  const uint64_t mask = ((uint64_t) 1 << dims) - 1;
+
+  // The codes are sorted, so each occupied octant is a contiguous run of
+  // equal chunks at this level; walk the runs and create a child for each.
+  arma::vec childCenter(center.n_elem);
+  const double childWidth = width / 2.0;
+  size_t childBegin = begin;
+  while (childBegin < begin + count)
+  {
+    const uint64_t chunk = (codes[childBegin] >> shift) & mask;
+    size_t childEnd = childBegin + 1;
+    while (childEnd < begin + count &&
+        ((codes[childEnd] >> shift) & mask) == chunk)
+      ++childEnd;
+
+    // Create the correct center.
+    for (size_t d = 0; d < center.n_elem; ++d)
+    {
+      // Is the dimension "right" (1) or "left" (0)?
+      if (((chunk >> d) & 1) == 0)
+        childCenter[d] = center[d] - childWidth;
+      else
+        childCenter[d] = center[d] + childWidth;
+    }
+
+    children.push_back(arena->New<Octree>(this, childBegin,
+        childEnd - childBegin, codes, level + 1, bitsPerDim, childCenter,
+        childWidth, maxLeafSize));
+
+    childBegin = childEnd;
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -127,13 +127,20 @@ class RectangleTree
    *      have.
    * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
    *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   * @param bulkLoad If true, the tree is packed directly from the dataset
+   *      with a sort-tile-recursive (STR) bulk load instead of point-by-point
+   *      insertion; this is much faster and fills nodes nearly completely,
+   *      but bypasses the split and descent heuristics and maintains no
+   *      auxiliary information, so it must only be used with variants that
+   *      keep no auxiliary state (e.g. RTree or RStarTree).
    */
   RectangleTree(const MatType& data,
                 const size_t maxLeafSize = 20,
                 const size_t minLeafSize = 8,
                 const size_t maxNumChildren = 5,
                 const size_t minNumChildren = 2,
-                const size_t firstDataIndex = 0);
+                const size_t firstDataIndex = 0,
+                const bool bulkLoad = false);
 
   /**
    * Construct this as the root node of a rectangle tree type using the given
@@ -148,13 +155,17 @@ class RectangleTree
    *      have.
    * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
    *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   * @param bulkLoad If true, the tree is packed directly from the dataset
+   *      with a sort-tile-recursive (STR) bulk load instead of point-by-point
+   *      insertion (see the other batch constructor for caveats).
    */
   RectangleTree(MatType&& data,
                 const size_t maxLeafSize = 20,
                 const size_t minLeafSize = 8,
                 const size_t maxNumChildren = 5,
                 const size_t minNumChildren = 2,
-                const size_t firstDataIndex = 0);
+                const size_t firstDataIndex = 0,
+                const bool bulkLoad = false);
 
   /**
    * Construct this as an empty node with the specified parent.  Copying the
@@ -564,6 +575,55 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Build the tree under this (root) node directly from the dataset with a
+   * sort-tile-recursive bulk load: the points are packed into near-full
+   * leaves that tile the space, and each level of nodes is then packed the
+   * same way until everything fits under the root.  This runs in O(n log n)
+   * and never splits or reinserts.
+   *
+   * @param firstDataIndex The index of the first data point.
+   */
+  void BulkLoad(const size_t firstDataIndex);
+
+  /**
+   * Pack a range of point indices into near-full leaf nodes by recursively
+   * tiling the range: the range is sorted by the given coordinate, cut into
+   * slabs, and each slab is tiled by the next coordinate.  Created leaves are
+   * appended to the given vector in tiling order, so that spatially close
+   * leaves are adjacent.
+   *
+   * @param indices Point indices; the range [rangeBegin, rangeEnd) of this
+   *      vector will be reordered.
+   * @param rangeBegin First position of the range to pack.
+   * @param rangeEnd One past the last position of the range to pack.
+   * @param dim The coordinate to sort the range by.
+   * @param leaves Vector that created leaves are appended to.
+   */
+  void PackPointsSTR(std::vector<size_t>& indices,
+                     const size_t rangeBegin,
+                     const size_t rangeEnd,
+                     const size_t dim,
+                     std::vector<RectangleTree*>& leaves);
+
+  /**
+   * Pack a range of same-level nodes into near-full parent nodes, tiling the
+   * range by the centers of the node bounds exactly as PackPointsSTR() tiles
+   * points.  Created parents are appended to the given vector.
+   *
+   * @param nodes Nodes of one level; the range [rangeBegin, rangeEnd) of this
+   *      vector will be reordered.
+   * @param rangeBegin First position of the range to pack.
+   * @param rangeEnd One past the last position of the range to pack.
+   * @param dim The coordinate to sort the range by.
+   * @param nextLevel Vector that created parent nodes are appended to.
+   */
+  void PackNodesSTR(std::vector<RectangleTree*>& nodes,
+                    const size_t rangeBegin,
+                    const size_t rangeEnd,
+                    const size_t dim,
+                    std::vector<RectangleTree*>& nextLevel);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -17,6 +17,8 @@
 
 #include <mlpack/core/util/log.hpp>
 
+#include <algorithm>
+
 namespace mlpack {
 namespace tree {
 
@@ -52,7 +54,8 @@ RectangleTree(const MatType& data,
               const size_t minLeafSize,
               const size_t maxNumChildren,
               const size_t minNumChildren,
-              const size_t firstDataIndex) :
+              const size_t firstDataIndex,
+              const bool bulkLoad) :
     maxNumChildren(maxNumChildren),
     minNumChildren(minNumChildren),
     numChildren(0),
@@ -70,11 +73,19 @@ RectangleTree(const MatType& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
+  if (bulkLoad)
+  {
+    // Pack the tree directly from the dataset.
+    BulkLoad(firstDataIndex);
+  }
+  else
+  {
+    // For now, just insert the points in order.
+    RectangleTree* root = this;
 
-  for (size_t i = firstDataIndex; i < data.n_cols; ++i)
-    root->InsertPoint(i);
+    for (size_t i = firstDataIndex; i < data.n_cols; ++i)
+      root->InsertPoint(i);
+  }
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
@@ -93,7 +104,8 @@ RectangleTree(MatType&& data,
               const size_t minLeafSize,
               const size_t maxNumChildren,
               const size_t minNumChildren,
-              const size_t firstDataIndex) :
+              const size_t firstDataIndex,
+              const bool bulkLoad) :
     maxNumChildren(maxNumChildren),
     minNumChildren(minNumChildren),
     numChildren(0),
@@ -111,16 +123,184 @@ RectangleTree(MatType&& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
+  if (bulkLoad)
+  {
+    // Pack the tree directly from the dataset.
+    BulkLoad(firstDataIndex);
+  }
+  else
+  {
+    // For now, just insert the points in order.
+    RectangleTree* root = this;
 
-  for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
-    root->InsertPoint(i);
+    for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
+      root->InsertPoint(i);
+  }
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
 }
 
+// Pack the tree directly from the dataset with a sort-tile-recursive bulk
+// load.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoad(const size_t firstDataIndex)
+{
+  const size_t numPoints = dataset->n_cols - firstDataIndex;
+
+  // If everything fits into one node, the root is a leaf.
+  if (numPoints <= maxLeafSize)
+  {
+    for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
+    {
+      points[count++] = i;
+      bound |= dataset->col(i);
+    }
+    numDescendants = numPoints;
+    return;
+  }
+
+  // Pack the points into near-full leaves that tile the space.
+  std::vector<size_t> indices(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    indices[i] = firstDataIndex + i;
+
+  std::vector<RectangleTree*> level;
+  PackPointsSTR(indices, 0, numPoints, 0, level);
+
+  // Pack each level of nodes into near-full parents until the remaining
+  // nodes fit under the root.
+  while (level.size() > maxNumChildren)
+  {
+    std::vector<RectangleTree*> nextLevel;
+    PackNodesSTR(level, 0, level.size(), 0, nextLevel);
+    level = std::move(nextLevel);
+  }
+
+  // Attach the last level to the root.
+  for (size_t i = 0; i < level.size(); ++i)
+  {
+    level[i]->parent = this;
+    children[numChildren++] = level[i];
+    bound |= level[i]->Bound();
+    numDescendants += level[i]->NumDescendants();
+  }
+}
+
+// Pack a range of point indices into near-full leaf nodes.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+PackPointsSTR(std::vector<size_t>& indices,
+              const size_t rangeBegin,
+              const size_t rangeEnd,
+              const size_t dim,
+              std::vector<RectangleTree*>& leaves)
+{
+  const size_t length = rangeEnd - rangeBegin;
+
+  if (length <= maxLeafSize)
+  {
+    // This range is one full leaf.
+    RectangleTree* leaf = new RectangleTree(this);
+    for (size_t i = rangeBegin; i < rangeEnd; ++i)
+    {
+      leaf->points[leaf->count++] = indices[i];
+      leaf->bound |= dataset->col(indices[i]);
+    }
+    leaf->numDescendants = leaf->count;
+    leaves.push_back(leaf);
+    return;
+  }
+
+  // Order the range by the current coordinate.
+  const MatType& data = *dataset;
+  std::sort(indices.begin() + rangeBegin, indices.begin() + rangeEnd,
+      [&data, dim](const size_t a, const size_t b)
+      { return data(dim, a) < data(dim, b); });
+
+  // The range needs ceil(length / maxLeafSize) leaf pages; cut it into
+  // ceil(pages^(1 / (remaining dimensions))) slabs of equal size and tile
+  // each slab by the next coordinate.  In the last dimension this degrades
+  // to chopping the sorted run directly into consecutive pages.
+  const size_t pages = (length + maxLeafSize - 1) / maxLeafSize;
+  const size_t remainingDims = dataset->n_rows - dim;
+  const size_t slabs = std::min(pages, (size_t) std::ceil(std::pow(
+      (double) pages, 1.0 / (double) remainingDims)));
+  const size_t nextDim = std::min(dim + 1, (size_t) dataset->n_rows - 1);
+
+  for (size_t s = 0; s < slabs; ++s)
+  {
+    const size_t slabBegin = rangeBegin + (s * length) / slabs;
+    const size_t slabEnd = rangeBegin + ((s + 1) * length) / slabs;
+    PackPointsSTR(indices, slabBegin, slabEnd, nextDim, leaves);
+  }
+}
+
+// Pack a range of same-level nodes into near-full parent nodes.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+PackNodesSTR(std::vector<RectangleTree*>& nodes,
+             const size_t rangeBegin,
+             const size_t rangeEnd,
+             const size_t dim,
+             std::vector<RectangleTree*>& nextLevel)
+{
+  const size_t length = rangeEnd - rangeBegin;
+
+  if (length <= maxNumChildren)
+  {
+    // This range is one full parent node.
+    RectangleTree* node = new RectangleTree(this);
+    for (size_t i = rangeBegin; i < rangeEnd; ++i)
+    {
+      nodes[i]->parent = node;
+      node->children[node->numChildren++] = nodes[i];
+      node->bound |= nodes[i]->Bound();
+      node->numDescendants += nodes[i]->NumDescendants();
+    }
+    nextLevel.push_back(node);
+    return;
+  }
+
+  // Order the range by the center of the node bounds in the current
+  // coordinate, then tile exactly as PackPointsSTR() tiles points.
+  std::sort(nodes.begin() + rangeBegin, nodes.begin() + rangeEnd,
+      [dim](RectangleTree* a, RectangleTree* b)
+      { return a->Bound()[dim].Mid() < b->Bound()[dim].Mid(); });
+
+  const size_t pages = (length + maxNumChildren - 1) / maxNumChildren;
+  const size_t remainingDims = dataset->n_rows - dim;
+  const size_t slabs = std::min(pages, (size_t) std::ceil(std::pow(
+      (double) pages, 1.0 / (double) remainingDims)));
+  const size_t nextDim = std::min(dim + 1, (size_t) dataset->n_rows - 1);
+
+  for (size_t s = 0; s < slabs; ++s)
+  {
+    const size_t slabBegin = rangeBegin + (s * length) / slabs;
+    const size_t slabEnd = rangeBegin + ((s + 1) * length) / slabs;
+    PackNodesSTR(nodes, slabBegin, slabEnd, nextDim, nextLevel);
+  }
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
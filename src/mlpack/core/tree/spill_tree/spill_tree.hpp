@@ -80,6 +80,30 @@ class SpillTree
   //! The bound type.
   typedef typename HyperplaneType<MetricType>::BoundType BoundType;
 
+  /**
+   * Build-time statistics about one level of the tree.  Every split performed
+   * during construction records how many of its points fell into the
+   * overlapping buffer (and so were duplicated into both children),
+   * aggregated per level; see LevelInfos().
+   */
+  struct LevelInfo
+  {
+    //! Number of splits performed at this level.
+    size_t numNodes = 0;
+    //! Total number of points held by the nodes split at this level.
+    size_t numPoints = 0;
+    //! Number of points duplicated into both children at this level.
+    size_t numSpilled = 0;
+    //! Sum of the overlap widths used by the splits at this level; divide by
+    //! numNodes for the average.  The widths only differ within a level when
+    //! the tree is auto-tuned.
+    double totalTau = 0.0;
+
+    //! Return the fraction of this level's points that were duplicated.
+    double SpillRate() const
+    { return (numPoints == 0) ? 0.0 : (double) numSpilled / numPoints; }
+  };
+
  private:
   //! The left child node.
   SpillTree* left;
@@ -113,6 +137,9 @@ class SpillTree
   const MatType* dataset;
   //! If true, we own the dataset and need to destroy it in the destructor.
   bool localDataset;
+  //! Per-level build statistics; only filled at the root while the tree is
+  //! built (empty for non-root nodes and deserialized trees).
+  std::vector<LevelInfo> levelInfo;
 
   //! A generic single-tree traverser for hybrid spill trees; see
   //! spill_single_tree_traverser.hpp for implementation.  The Defeatist
@@ -154,11 +181,15 @@ class SpillTree
    * @param tau Overlapping size.
    * @param maxLeafSize Size of each leaf in the tree.
    * @param rho Balance threshold.
+   * @param overlapBudget If greater than 1, ignore the given tau and pick the
+   *      overlap width of every split automatically, so that the total number
+   *      of stored points stays near overlapBudget * data.n_cols.
    */
   SpillTree(const MatType& data,
             const double tau = 0,
             const size_t maxLeafSize = 20,
-            const double rho = 0.7);
+            const double rho = 0.7,
+            const double overlapBudget = 0.0);
 
   /**
    * Construct this as the root node of a hybrid spill tree using the given
@@ -170,11 +201,15 @@ class SpillTree
    * @param tau Overlapping size.
    * @param maxLeafSize Size of each leaf in the tree.
    * @param rho Balance threshold.
+   * @param overlapBudget If greater than 1, ignore the given tau and pick the
+   *      overlap width of every split automatically, so that the total number
+   *      of stored points stays near overlapBudget * data.n_cols.
    */
   SpillTree(MatType&& data,
             const double tau = 0,
             const size_t maxLeafSize = 20,
-            const double rho = 0.7);
+            const double rho = 0.7,
+            const double overlapBudget = 0.0);
 
   /**
    * Construct this node as a child of the given parent, including the given
@@ -186,12 +221,16 @@ class SpillTree
    * @param tau Overlapping size.
    * @param maxLeafSize Size of each leaf in the tree.
    * @param rho Balance threshold.
+   * @param spillFraction If positive, the fraction of every split's points to
+   *      duplicate; the overlap width of each split is then picked to match
+   *      it and tau is ignored (auto-tuned mode).
    */
   SpillTree(SpillTree* parent,
             arma::Col<size_t>& points,
             const double tau = 0,
             const size_t maxLeafSize = 20,
-            const double rho = 0.7);
+            const double rho = 0.7,
+            const double spillFraction = 0.0);
 
   /**
    * Create a hybrid spill tree by copying the other tree.  Be careful!  This
@@ -274,6 +313,11 @@ class SpillTree
   //! Distinguish overlapping nodes from non-overlapping nodes.
   bool Overlap() const { return overlappingNode; }
 
+  //! Per-level build statistics: element l describes the splits performed at
+  //! depth l.  Only non-empty at the root of a built tree; this is build
+  //! instrumentation and is not serialized.
+  const std::vector<LevelInfo>& LevelInfos() const { return levelInfo; }
+
   //! Get the Hyperplane instance.
   const HyperplaneType<MetricType>& Hyperplane() const { return hyperplane; }
 
@@ -445,17 +489,23 @@ class SpillTree
    * @param maxLeafSize Maximum number of points held in a leaf.
    * @param tau Overlapping size.
    * @param rho Balance threshold.
+   * @param spillFraction If positive, fraction of each split's points to
+   *      duplicate (auto-tuned mode); tau is ignored.
    */
   void SplitNode(arma::Col<size_t>& points,
                  const size_t maxLeafSize,
                  const double tau,
-                 const double rho);
+                 const double rho,
+                 const double spillFraction);
 
   /**
    * Split the list of points.
    *
    * @param tau Overlapping size.
    * @param rho Balance threshold.
+   * @param spillFraction If positive, pick the overlap width as the
+   *      spillFraction-quantile of the absolute projection values, so that
+   *      about that fraction of the points is duplicated; tau is ignored.
    * @param points Vector of indexes of points to be included.
    * @param leftPoints Indexes of points to be included in left child.
    * @param rightPoints Indexes of points to be included in right child.
@@ -463,9 +513,21 @@ class SpillTree
    */
   bool SplitPoints(const double tau,
                    const double rho,
+                   const double spillFraction,
                    const arma::Col<size_t>& points,
                    arma::Col<size_t>& leftPoints,
                    arma::Col<size_t>& rightPoints);
+
+  /**
+   * Aggregate one split into the per-level statistics held at the root.
+   *
+   * @param numPoints Number of points held by the split node.
+   * @param numSpilled Number of points duplicated into both children.
+   * @param tau Overlap width used by the split (0 if the overlap was undone).
+   */
+  void RecordSplit(const size_t numPoints,
+                   const size_t numSpilled,
+                   const double tau);
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -14,6 +14,7 @@
 // In case it wasn't included already for some reason.
 #include "spill_tree.hpp"
 
+#include <algorithm>
 #include <queue>
 
 namespace mlpack {
@@ -30,7 +31,8 @@ SpillTree(
     const MatType& data,
     const double tau,
     const size_t maxLeafSize,
-    const double rho) :
+    const double rho,
+    const double overlapBudget) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -49,8 +51,20 @@ SpillTree(
     points = arma::linspace<arma::Col<size_t>>(0, dataset->n_cols - 1,
         dataset->n_cols);
 
+  // If an overlap budget was given, pick the overlap width of every split
+  // automatically: spreading the budget evenly across the levels of a
+  // balanced tree, each split may duplicate at most this fraction of its
+  // node's points.
+  double spillFraction = 0.0;
+  if (overlapBudget > 1.0 && dataset->n_cols > maxLeafSize)
+  {
+    const double depth = std::ceil(std::log2((double) dataset->n_cols /
+        maxLeafSize));
+    spillFraction = std::pow(overlapBudget, 1.0 / depth) - 1.0;
+  }
+
   // Do the actual splitting of this node.
-  SplitNode(points, maxLeafSize, tau, rho);
+  SplitNode(points, maxLeafSize, tau, rho, spillFraction);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -67,7 +81,8 @@ SpillTree(
     MatType&& data,
     const double tau,
     const size_t maxLeafSize,
-    const double rho) :
+    const double rho,
+    const double overlapBudget) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -86,8 +101,20 @@ SpillTree(
     points = arma::linspace<arma::Col<size_t>>(0, dataset->n_cols - 1,
         dataset->n_cols);
 
+  // If an overlap budget was given, pick the overlap width of every split
+  // automatically: spreading the budget evenly across the levels of a
+  // balanced tree, each split may duplicate at most this fraction of its
+  // node's points.
+  double spillFraction = 0.0;
+  if (overlapBudget > 1.0 && dataset->n_cols > maxLeafSize)
+  {
+    const double depth = std::ceil(std::log2((double) dataset->n_cols /
+        maxLeafSize));
+    spillFraction = std::pow(overlapBudget, 1.0 / depth) - 1.0;
+  }
+
   // Do the actual splitting of this node.
-  SplitNode(points, maxLeafSize, tau, rho);
+  SplitNode(points, maxLeafSize, tau, rho, spillFraction);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -105,7 +132,8 @@ SpillTree(
     arma::Col<size_t>& points,
     const double tau,
     const size_t maxLeafSize,
-    const double rho) :
+    const double rho,
+    const double spillFraction) :
     left(NULL),
     right(NULL),
     parent(parent),
@@ -118,7 +146,7 @@ SpillTree(
     localDataset(false)
 {
   // Perform the actual splitting.
-  SplitNode(points, maxLeafSize, tau, rho);
+  SplitNode(points, maxLeafSize, tau, rho, spillFraction);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -151,7 +179,8 @@ SpillTree(const SpillTree& other) :
     // copy of the dataset.
     dataset((other.parent == NULL && other.localDataset) ?
         new MatType(*other.dataset) : other.dataset),
-    localDataset(other.parent == NULL && other.localDataset)
+    localDataset(other.parent == NULL && other.localDataset),
+    levelInfo(other.levelInfo)
 {
   // Create left and right children (if any).
   if (other.Left())
@@ -233,6 +262,7 @@ operator=(const SpillTree& other)
   dataset = (other.parent == NULL && other.localDataset) ?
       new MatType(*other.dataset) : other.dataset;
   localDataset = other.parent == NULL && other.localDataset;
+  levelInfo = other.levelInfo;
 
   // Create left and right children (if any).
   if (other.Left())
@@ -298,7 +328,8 @@ SpillTree(SpillTree&& other) :
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
     dataset(other.dataset),
-    localDataset(other.localDataset)
+    localDataset(other.localDataset),
+    levelInfo(std::move(other.levelInfo))
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -357,6 +388,7 @@ operator=(SpillTree&& other)
   minimumBoundDistance = other.minimumBoundDistance;
   dataset = other.dataset;
   localDataset = other.localDataset;
+  levelInfo = std::move(other.levelInfo);
 
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -720,7 +752,8 @@ void SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
     SplitNode(arma::Col<size_t>& points,
               const size_t maxLeafSize,
               const double tau,
-              const double rho)
+              const double rho,
+              const double spillFraction)
 {
   // We need to expand the bounds of this node properly.
   for (size_t i = 0; i < points.n_elem; ++i)
@@ -750,7 +783,8 @@ void SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
 
   arma::Col<size_t> leftPoints, rightPoints;
   // Split the node.
-  overlappingNode = SplitPoints(tau, rho, points, leftPoints, rightPoints);
+  overlappingNode = SplitPoints(tau, rho, spillFraction, points, leftPoints,
+      rightPoints);
 
   if (overlappingNode)
   {
@@ -767,8 +801,9 @@ void SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
 
   // Now we will recursively split the children by calling their constructors
   // (which perform this splitting process).
-  left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
-  right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+  left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho, spillFraction);
+  right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho,
+      spillFraction);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -793,28 +828,52 @@ template<typename MetricType,
 bool SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
     SplitPoints(const double tau,
                 const double rho,
+                const double spillFraction,
                 const arma::Col<size_t>& points,
                 arma::Col<size_t>& leftPoints,
                 arma::Col<size_t>& rightPoints)
 {
   arma::vec projections(points.n_elem);
+
+  // Store projection values for future use.
+  for (size_t i = 0; i < points.n_elem; ++i)
+    projections[i] = hyperplane.Project(dataset->col(points[i]));
+
+  // In auto-tuned mode, pick the overlap width for this split so that about
+  // spillFraction of the points fall inside the overlapping buffer: the width
+  // becomes the spillFraction-quantile of the absolute projection values.
+  double effectiveTau = tau;
+  if (spillFraction > 0)
+  {
+    const size_t rank = (size_t) (spillFraction * points.n_elem);
+    if (rank > 0 && rank < points.n_elem)
+    {
+      arma::vec absProjections = arma::abs(projections);
+      std::nth_element(absProjections.begin(), absProjections.begin() + rank,
+          absProjections.end());
+      effectiveTau = absProjections[rank];
+    }
+    else
+    {
+      effectiveTau = 0;
+    }
+  }
+
   size_t left = 0, right = 0, leftFrontier = 0, rightFrontier = 0;
 
   // Count the number of points to the left/right of the splitting hyperplane.
   for (size_t i = 0; i < points.n_elem; ++i)
   {
-    // Store projection value for future use.
-    projections[i] = hyperplane.Project(dataset->col(points[i]));
     if (projections[i] <= 0)
     {
       left++;
-      if (projections[i] > -tau)
+      if (projections[i] > -effectiveTau)
         leftFrontier++;
     }
     else
     {
       right++;
-      if (projections[i] < tau)
+      if (projections[i] < effectiveTau)
         rightFrontier++;
     }
   }
@@ -838,16 +897,19 @@ bool SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
     {
       // We put any points in the frontier should come last in the left node,
       // and first in the right node.  (This ordering is not required.)
-      if (projections[i] < -tau)
+      if (projections[i] < -effectiveTau)
         leftPoints[lc++] = points[i];
-      else if (projections[i] < tau)
+      else if (projections[i] < effectiveTau)
         leftPoints[lf++] = points[i];
 
-      if (projections[i] > tau)
+      if (projections[i] > effectiveTau)
         rightPoints[rc++] = points[i];
-      else if (projections[i] > -tau)
+      else if (projections[i] > -effectiveTau)
         rightPoints[rf++] = points[i];
     }
+
+    RecordSplit(points.n_elem, overlap, effectiveTau);
+
     // Return true, because it is a overlapping node.
     return true;
   }
@@ -865,10 +927,43 @@ bool SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
     else
       rightPoints[rc++] = points[i];
   }
+
+  RecordSplit(points.n_elem, 0, 0);
+
   // Return false, because it isn't a overlapping node.
   return false;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneMetricType> class HyperplaneType,
+         template<typename SplitMetricType, typename SplitMatType>
+             class SplitType>
+void SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
+    RecordSplit(const size_t numPoints,
+                const size_t numSpilled,
+                const double tau)
+{
+  // Find our level and the root, which holds the statistics.
+  size_t level = 0;
+  SpillTree* root = this;
+  while (root->parent != NULL)
+  {
+    root = root->parent;
+    ++level;
+  }
+
+  if (root->levelInfo.size() <= level)
+    root->levelInfo.resize(level + 1);
+
+  LevelInfo& info = root->levelInfo[level];
+  ++info.numNodes;
+  info.numPoints += numPoints;
+  info.numSpilled += numSpilled;
+  info.totalTau += tau;
+}
+
 // Default constructor (private), for cereal.
 template<typename MetricType,
          typename StatisticType,
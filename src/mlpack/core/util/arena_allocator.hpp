@@ -0,0 +1,171 @@
+/**
+ * @file core/util/arena_allocator.hpp
+ * @author Jianxin Zhang
+ *
+ * A chunked arena allocator for objects that are built once and torn down
+ * together, such as the nodes of a search tree.  Allocation is a pointer
+ * bump inside a large chunk, so consecutively allocated objects are adjacent
+ * in memory; teardown destroys every allocated object in one linear sweep
+ * and then frees a handful of chunks, instead of one free per object.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_ARENA_ALLOCATOR_HPP
+#define MLPACK_CORE_UTIL_ARENA_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mlpack/core/util/memory_tracker.hpp>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * A bump allocator over large chunks of memory.  Objects are created with
+ * New() and are destroyed---in reverse order of creation, for those with
+ * non-trivial destructors---when the arena itself is destroyed; there is no
+ * way to free a single object.  This trades the ability to delete objects
+ * individually for O(1) allocation, cache-friendly placement of objects that
+ * are allocated together, and bulk teardown.
+ *
+ * New() may be called concurrently from multiple OpenMP threads; the pointer
+ * bump is serialized, but object construction runs outside the lock (and may
+ * itself call New(), as recursive tree-building constructors do).
+ */
+class ArenaAllocator
+{
+ public:
+  /**
+   * Create an arena that requests memory in chunks of the given size.
+   * Allocations larger than the chunk size get a dedicated chunk.
+   *
+   * @param chunkSize Size of each chunk, in bytes.
+   */
+  ArenaAllocator(const size_t chunkSize = 1048576) :
+      chunkSize(chunkSize),
+      current(NULL),
+      remaining(0)
+  {
+    // Nothing to do.
+  }
+
+  //! The arena owns its objects, so it cannot be copied.
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+  //! Destroy every object allocated from the arena, then free the chunks.
+  ~ArenaAllocator()
+  {
+    // Destroy in reverse order of construction, like the stack would.
+    for (size_t i = finalizers.size(); i > 0; --i)
+      finalizers[i - 1].destroy(finalizers[i - 1].object);
+
+    for (size_t i = 0; i < chunks.size(); ++i)
+      delete[] chunks[i];
+
+    MemoryTracker::RecordDeallocation(chunkBytes);
+  }
+
+  /**
+   * Allocate and construct an object of type T inside the arena.  The object
+   * is destroyed when the arena is destroyed.  If T's constructor throws,
+   * its memory is abandoned inside the arena.
+   *
+   * @param args Arguments to forward to T's constructor.
+   */
+  template<typename T, typename... Args>
+  T* New(Args&&... args)
+  {
+    void* memory;
+    // Only the bookkeeping is serialized; construction (which may recurse
+    // back into New()) runs outside the critical section.
+    #pragma omp critical (mlpackArenaAllocator)
+    {
+      memory = Allocate(sizeof(T), alignof(T));
+      if (!std::is_trivially_destructible<T>::value)
+        finalizers.push_back(Finalizer{ memory, &Destroy<T> });
+    }
+
+    return new (memory) T(std::forward<Args>(args)...);
+  }
+
+  //! Get the total number of bytes handed out so far.
+  size_t BytesAllocated() const { return bytesAllocated; }
+
+ private:
+  /**
+   * Carve the given number of bytes out of the current chunk, starting a new
+   * chunk if it does not fit.  Must be called with the bookkeeping lock held.
+   */
+  void* Allocate(const size_t bytes, const size_t alignment)
+  {
+    // Align the bump pointer.
+    const size_t padding = (alignment - ((uintptr_t) current) % alignment) %
+        alignment;
+    if (padding + bytes > remaining)
+    {
+      // Start a new chunk; oversized requests get a chunk of their own.
+      const size_t newChunkSize = std::max(chunkSize, bytes + alignment);
+      chunks.push_back(new char[newChunkSize]);
+      if (MemoryTracker::Enabled())
+      {
+        // Only bytes that were actually recorded are given back at teardown,
+        // so toggling tracking during the arena's lifetime cannot make the
+        // tracker's counter go negative.
+        chunkBytes += newChunkSize;
+        MemoryTracker::RecordAllocation(newChunkSize);
+      }
+      current = chunks.back();
+      remaining = newChunkSize;
+      return Allocate(bytes, alignment);
+    }
+
+    char* result = current + padding;
+    current += padding + bytes;
+    remaining -= padding + bytes;
+    bytesAllocated += bytes;
+    return result;
+  }
+
+  //! Run the destructor of a T placed at the given address.
+  template<typename T>
+  static void Destroy(void* object) { static_cast<T*>(object)->~T(); }
+
+  //! One registered destructor call, for a non-trivially-destructible object.
+  struct Finalizer
+  {
+    void* object;
+    void (*destroy)(void*);
+  };
+
+  //! The chunks of memory owned by the arena.
+  std::vector<char*> chunks;
+  //! Destructors to run at teardown, in order of construction.
+  std::vector<Finalizer> finalizers;
+
+  //! The size of each new chunk, in bytes.
+  size_t chunkSize;
+  //! Bump pointer into the current chunk.
+  char* current;
+  //! Bytes left in the current chunk.
+  size_t remaining;
+  //! Total bytes handed out.
+  size_t bytesAllocated = 0;
+  //! Total bytes requested from the system for chunks (reported to the
+  //! MemoryTracker).
+  size_t chunkBytes = 0;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,268 @@
+/**
+ * @file core/util/async_log_sink.hpp
+ *
+ * An asynchronous stream buffer for the mlpack logging streams.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_ASYNC_LOG_SINK_HPP
+#define MLPACK_CORE_UTIL_ASYNC_LOG_SINK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * A stream buffer that hands complete lines to a background thread instead of
+ * writing them to its target synchronously.  Characters are assembled into
+ * lines; each finished line is pushed into a bounded lock-free ring buffer
+ * (a standard sequence-numbered MPMC queue), and a drainer thread owned by
+ * the sink pops the lines and writes them to the target stream buffer.  The
+ * caller thus pays for in-memory string assembly only, never for the write
+ * or flush of the underlying device.
+ *
+ * If the ring is full the producer spins until the drainer catches up, so
+ * memory stays bounded and no lines are ever dropped or reordered.  Flush
+ * requests (std::endl, sync()) are deferred: the drainer flushes the target
+ * whenever it empties the ring; Flush() waits for that to happen.
+ *
+ * Like PrefixedOutStream itself, a single sink is not meant to be written
+ * from several threads at the same time (the line being assembled is shared
+ * state); the ring itself is safe for concurrent producers.
+ *
+ * This is the backend of Log::EnableAsync() (see log.hpp), but it can wrap
+ * any std::streambuf:
+ *
+ * @code
+ * AsyncLogSink sink(std::cout.rdbuf());
+ * std::ostream asyncCout(&sink);
+ * asyncCout << "written by the drainer thread" << std::endl;
+ * sink.Flush();
+ * @endcode
+ */
+class AsyncLogSink : public std::streambuf
+{
+ public:
+  /**
+   * Create a sink that drains into the given target stream buffer.  The
+   * drainer thread starts immediately.
+   *
+   * @param target Stream buffer that the drainer thread writes to; must
+   *     outlive the sink.
+   * @param capacity Number of lines the ring buffer can hold (rounded up to
+   *     a power of two).
+   */
+  AsyncLogSink(std::streambuf* target, const size_t capacity = 1024) :
+      target(target),
+      capacityMask(RoundUpToPowerOfTwo(capacity) - 1),
+      slots(new Slot[capacityMask + 1]),
+      enqueueCount(0),
+      dequeueCount(0),
+      flushedCount(0),
+      running(true)
+  {
+    for (size_t i = 0; i <= capacityMask; ++i)
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    drainer = std::thread(&AsyncLogSink::DrainLoop, this);
+  }
+
+  //! The sink owns its drainer thread, so it cannot be copied.
+  AsyncLogSink(const AsyncLogSink&) = delete;
+  AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+  //! Drain everything that was written, then stop the drainer thread.
+  ~AsyncLogSink()
+  {
+    // Hand the unfinished line to the drainer too, so nothing is lost.
+    if (!partial.empty())
+      Push(std::move(partial));
+
+    running.store(false);
+    drainer.join();
+  }
+
+  //! Block until every line pushed so far has been written to the target and
+  //! the target has been flushed.
+  void Flush()
+  {
+    const size_t goal = enqueueCount.load(std::memory_order_acquire);
+    while (flushedCount.load(std::memory_order_acquire) < goal)
+      std::this_thread::yield();
+  }
+
+  //! Get the number of lines that are queued but not yet written.
+  size_t Pending() const
+  {
+    return enqueueCount.load(std::memory_order_acquire) -
+        dequeueCount.load(std::memory_order_acquire);
+  }
+
+ protected:
+  //! Collect one character; a newline completes the line and enqueues it.
+  int overflow(int c)
+  {
+    if (c == traits_type::eof())
+      return traits_type::not_eof(c);
+
+    partial += (char) c;
+    if (c == '\n')
+      Push(std::move(partial));
+    return c;
+  }
+
+  //! Collect a block of characters, enqueueing every completed line in it.
+  std::streamsize xsputn(const char* s, std::streamsize n)
+  {
+    std::streamsize pos = 0;
+    for (std::streamsize i = 0; i < n; ++i)
+    {
+      if (s[i] == '\n')
+      {
+        partial.append(s + pos, i - pos + 1);
+        Push(std::move(partial));
+        pos = i + 1;
+      }
+    }
+    partial.append(s + pos, n - pos);
+    return n;
+  }
+
+  //! Flushes are deferred: the drainer flushes the target whenever it has
+  //! emptied the ring.  Use Flush() to wait for that.
+  int sync() { return 0; }
+
+ private:
+  //! One slot of the ring buffer.
+  struct Slot
+  {
+    //! The sequence number that makes the lock-free hand-off safe.
+    std::atomic<size_t> sequence;
+    //! The line stored in the slot.
+    std::string line;
+  };
+
+  //! Round up to the next power of two (so the ring index is a cheap mask).
+  static size_t RoundUpToPowerOfTwo(size_t x)
+  {
+    size_t result = 1;
+    while (result < x)
+      result *= 2;
+    return result;
+  }
+
+  //! Enqueue one line, spinning if the ring is full.
+  void Push(std::string&& line)
+  {
+    size_t pos = enqueueCount.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      Slot& slot = slots[pos & capacityMask];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const intptr_t difference = (intptr_t) sequence - (intptr_t) pos;
+
+      if (difference == 0)
+      {
+        // The slot is free; try to claim it.
+        if (enqueueCount.compare_exchange_weak(pos, pos + 1,
+            std::memory_order_relaxed))
+        {
+          slot.line = std::move(line);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return;
+        }
+      }
+      else if (difference < 0)
+      {
+        // The ring is full; wait for the drainer instead of dropping or
+        // reordering lines.
+        std::this_thread::yield();
+        pos = enqueueCount.load(std::memory_order_relaxed);
+      }
+      else
+      {
+        // Another producer claimed this slot; reload and retry.
+        pos = enqueueCount.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  //! Dequeue one line (only the drainer thread calls this).
+  bool Pop(std::string& line)
+  {
+    const size_t pos = dequeueCount.load(std::memory_order_relaxed);
+    Slot& slot = slots[pos & capacityMask];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if ((intptr_t) sequence - (intptr_t) (pos + 1) < 0)
+      return false; // Empty (or the producer has not published yet).
+
+    line = std::move(slot.line);
+    slot.sequence.store(pos + capacityMask + 1, std::memory_order_release);
+    dequeueCount.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  //! The drainer thread: write queued lines to the target, flushing the
+  //! target whenever the ring has been emptied.
+  void DrainLoop()
+  {
+    std::string line;
+    size_t written = 0;
+    while (true)
+    {
+      if (Pop(line))
+      {
+        target->sputn(line.data(), line.size());
+        ++written;
+      }
+      else
+      {
+        if (written > 0)
+        {
+          target->pubsync();
+          written = 0;
+        }
+        flushedCount.store(dequeueCount.load(std::memory_order_acquire),
+            std::memory_order_release);
+
+        if (!running.load(std::memory_order_acquire) && Pending() == 0)
+          return;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  //! The stream buffer the drainer thread writes to.
+  std::streambuf* target;
+  //! Ring size minus one; indices are masked with this.
+  size_t capacityMask;
+  //! The slots of the ring buffer.
+  std::unique_ptr<Slot[]> slots;
+  //! Total lines ever enqueued; the low bits index the ring.
+  std::atomic<size_t> enqueueCount;
+  //! Total lines ever dequeued.
+  std::atomic<size_t> dequeueCount;
+  //! Total lines written out with the target flushed afterwards.
+  std::atomic<size_t> flushedCount;
+  //! Cleared by the destructor to stop the drainer thread.
+  std::atomic<bool> running;
+  //! The line currently being assembled (owned by the producer side).
+  std::string partial;
+  //! The drainer thread.
+  std::thread drainer;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_ASYNC_LOG_SINK_HPP
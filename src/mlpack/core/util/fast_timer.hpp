@@ -0,0 +1,273 @@
+/**
+ * @file core/util/fast_timer.hpp
+ *
+ * Preregistered integer-handle timers with per-thread aggregation, cheap
+ * enough to leave enabled in production code.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_FAST_TIMER_HPP
+#define MLPACK_CORE_UTIL_FAST_TIMER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * FastTimer provides flat named aggregates like Timer (see timers.hpp), but
+ * without its per-call cost: Timer::Start() and Timer::Stop() take a global
+ * lock and look the name up in a std::map on every call, which makes timing
+ * a hot inner loop more expensive than the loop itself.  A FastTimer handle
+ * is registered once, by name, at setup time; Start() and Stop() then index
+ * per-thread arrays with the integer handle and take one clock read each, so
+ * the overhead is a few tens of nanoseconds and the timers can stay enabled
+ * in library code unconditionally.
+ *
+ * @code
+ * static const size_t handle = FastTimer::Register("tree_base_cases");
+ *
+ * FastTimer::Start(handle);
+ * // ... the hot section ...
+ * FastTimer::Stop(handle);
+ *
+ * Log::Info << FastTimer::Get(handle).count() << " us over "
+ *     << FastTimer::Count(handle) << " calls." << std::endl;
+ * @endcode
+ *
+ * Each thread accumulates into its own counters; Get() and GetAllTimers()
+ * sum over all threads that ever used the timer.  Unlike Timer, a FastTimer
+ * handle may be started concurrently on several threads, but on any one
+ * thread Start() and Stop() calls for a handle must alternate.  Do not read
+ * the aggregates while other threads are between Start() and Stop() if an
+ * exact answer is needed; like Profiler (see profiler.hpp), reporting is
+ * meant to happen at quiescent points.
+ */
+class FastTimer
+{
+ public:
+  /**
+   * Register a timer with the given name, returning its handle.  Registering
+   * the same name again returns the existing handle.  This takes a lock and
+   * is meant to be called once at setup time (e.g. to initialize a static),
+   * not from hot code.
+   *
+   * @param name Name of the timer; reported by GetAllTimers().
+   */
+  static size_t Register(const std::string& name)
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    std::vector<std::string>& names = Names();
+    for (size_t handle = 0; handle < names.size(); ++handle)
+      if (names[handle] == name)
+        return handle;
+
+    names.push_back(name);
+    return names.size() - 1;
+  }
+
+  //! Start the timer with the given handle on the calling thread.
+  static void Start(const size_t handle)
+  {
+    ThreadTimers& local = LocalTimers(handle);
+    local.starts[handle] = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Stop the timer with the given handle on the calling thread, adding the
+   * time since the matching Start() call to the thread's aggregate.  Like
+   * Timer, FastTimer aggregates are additive over runs and do not reset.
+   */
+  static void Stop(const size_t handle)
+  {
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    ThreadTimers& local = LocalTimers(handle);
+    local.elapsedNs[handle] += std::chrono::duration_cast<
+        std::chrono::nanoseconds>(end - local.starts[handle]).count();
+    ++local.counts[handle];
+  }
+
+  //! Get the total time of the given timer, summed over all threads.
+  static std::chrono::microseconds Get(const size_t handle)
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    uint64_t totalNs = 0;
+    for (size_t t = 0; t < Registry().size(); ++t)
+    {
+      const ThreadTimers& timers = *Registry()[t];
+      if (handle < timers.elapsedNs.size())
+        totalNs += timers.elapsedNs[handle];
+    }
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::nanoseconds(totalNs));
+  }
+
+  //! Get how many times the given timer was stopped, over all threads.
+  static size_t Count(const size_t handle)
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    size_t total = 0;
+    for (size_t t = 0; t < Registry().size(); ++t)
+    {
+      const ThreadTimers& timers = *Registry()[t];
+      if (handle < timers.counts.size())
+        total += timers.counts[handle];
+    }
+
+    return total;
+  }
+
+  //! Returns all registered timers by name, in the format of
+  //! Timer::GetAllTimers(), summed over all threads.
+  static std::map<std::string, std::chrono::microseconds> GetAllTimers()
+  {
+    std::map<std::string, std::chrono::microseconds> result;
+    const size_t numTimers = NumTimers();
+    for (size_t handle = 0; handle < numTimers; ++handle)
+      result[Name(handle)] = Get(handle);
+
+    return result;
+  }
+
+  //! Get the name of the given timer.
+  static std::string Name(const size_t handle)
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    return Names()[handle];
+  }
+
+  //! Get the number of registered timers.
+  static size_t NumTimers()
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    return Names().size();
+  }
+
+  //! Reset the aggregates of every timer on every thread to zero.  The
+  //! registered handles remain valid.  Do not call this while other threads
+  //! are between Start() and Stop().
+  static void Reset()
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    for (size_t t = 0; t < Registry().size(); ++t)
+    {
+      ThreadTimers& timers = *Registry()[t];
+      std::fill(timers.elapsedNs.begin(), timers.elapsedNs.end(), 0);
+      std::fill(timers.counts.begin(), timers.counts.end(), 0);
+    }
+  }
+
+ private:
+  //! All timer state owned by one thread.
+  struct ThreadTimers
+  {
+    //! Start time of each running timer, indexed by handle.
+    std::vector<std::chrono::steady_clock::time_point> starts;
+    //! Accumulated nanoseconds of each timer, indexed by handle.
+    std::vector<uint64_t> elapsedNs;
+    //! How many times each timer was stopped, indexed by handle.
+    std::vector<size_t> counts;
+  };
+
+  //! The mutex guarding the registered names and the per-thread registry.
+  static std::mutex& RegistryMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  //! The names of the registered timers, indexed by handle.
+  static std::vector<std::string>& Names()
+  {
+    static std::vector<std::string> names;
+    return names;
+  }
+
+  //! The registry of per-thread timers.  Timers are never removed, so time
+  //! recorded by threads that have exited is still reported.
+  static std::vector<std::unique_ptr<ThreadTimers>>& Registry()
+  {
+    static std::vector<std::unique_ptr<ThreadTimers>> registry;
+    return registry;
+  }
+
+  /**
+   * Get the timers of the calling thread, registering them on first use and
+   * growing the arrays to cover the given handle.  The growth branch is
+   * taken at most once per handle per thread; afterwards this is a
+   * thread-local load and a bounds check.
+   */
+  static ThreadTimers& LocalTimers(const size_t handle)
+  {
+    static thread_local ThreadTimers* timers = NULL;
+    if (timers == NULL)
+    {
+      std::lock_guard<std::mutex> lock(RegistryMutex());
+      Registry().emplace_back(new ThreadTimers());
+      timers = Registry().back().get();
+    }
+
+    if (handle >= timers->elapsedNs.size())
+    {
+      timers->starts.resize(handle + 1);
+      timers->elapsedNs.resize(handle + 1, 0);
+      timers->counts.resize(handle + 1, 0);
+    }
+
+    return *timers;
+  }
+};
+
+/**
+ * A RAII marker for a fast-timed section: the timer starts at construction
+ * and stops at destruction.
+ *
+ * @code
+ * void HotSection()
+ * {
+ *   static const size_t handle = FastTimer::Register("hot_section");
+ *   util::ScopedFastTimer timer(handle);
+ *   // ... the code of the section ...
+ * }
+ * @endcode
+ */
+class ScopedFastTimer
+{
+ public:
+  //! Start the timer with the given handle.
+  explicit ScopedFastTimer(const size_t handle) : handle(handle)
+  {
+    FastTimer::Start(handle);
+  }
+
+  //! Stop the timer.
+  ~ScopedFastTimer()
+  {
+    FastTimer::Stop(handle);
+  }
+
+  //! Scoped timers cannot be copied or moved.
+  ScopedFastTimer(const ScopedFastTimer&) = delete;
+  ScopedFastTimer& operator=(const ScopedFastTimer&) = delete;
+
+ private:
+  //! The handle of the started timer.
+  const size_t handle;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_FAST_TIMER_HPP
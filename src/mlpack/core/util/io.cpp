@@ -169,6 +169,28 @@ void IO::AddSeeAlso(const std::string& bindingName,
       std::make_pair(description, link));
 }
 
+// Defer a registration action until the first Parameters() call.
+void IO::Defer(std::function<void()> registration)
+{
+  std::lock_guard<std::mutex> lock(GetSingleton().deferredMutex);
+  GetSingleton().deferred.push_back(std::move(registration));
+}
+
+// Run (and clear) any deferred registration actions.
+void IO::RunDeferred()
+{
+  // Move the queue out under the lock, then run it unlocked: the
+  // registrations take the map mutex themselves.
+  std::vector<std::function<void()>> pending;
+  {
+    std::lock_guard<std::mutex> lock(GetSingleton().deferredMutex);
+    pending.swap(GetSingleton().deferred);
+  }
+
+  for (size_t i = 0; i < pending.size(); ++i)
+    pending[i]();
+}
+
 // Returns the sole instance of this class.
 IO& IO::GetSingleton()
 {
@@ -189,6 +211,9 @@ util::Timers& IO::GetTimers()
  */
 util::Params IO::Parameters(const std::string& bindingName)
 {
+  // Run any parameter registrations that were deferred at startup.
+  RunDeferred();
+
   // We don't need a mutex here, because we are only randomly accessing elements
   // of the maps.
 
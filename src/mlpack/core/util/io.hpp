@@ -13,10 +13,12 @@
 #ifndef MLPACK_CORE_UTIL_IO_HPP
 #define MLPACK_CORE_UTIL_IO_HPP
 
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <mlpack/prereqs.hpp>
 
@@ -250,6 +252,17 @@ class IO
    */
   static util::Params Parameters(const std::string& bindingName);
 
+  /**
+   * Defer a registration action until the first call to Parameters().  The
+   * binding option types use this so that program startup only pays for
+   * queueing one closure per parameter; the real registration work (building
+   * the ParamData object and inserting it into the parameter maps) runs
+   * lazily once, when a binding first asks for its parameters.
+   *
+   * @param registration Action that performs the deferred registration.
+   */
+  static void Defer(std::function<void()> registration);
+
   /**
    * Retrieve the singleton.  As an end user, if you are just using the IO
    * object, you should not need to use this function---the other static
@@ -286,6 +299,14 @@ class IO
   //! Map of binding details.
   std::map<std::string, util::BindingDetails> docs;
 
+  //! Ensure only one thread can touch the deferred registration queue.
+  std::mutex deferredMutex;
+  //! Registration actions deferred until the first Parameters() call.
+  std::vector<std::function<void()>> deferred;
+
+  //! Run (and clear) any deferred registration actions.
+  static void RunDeferred();
+
   //! Holds the timer objects.
   util::Timers timer;
 
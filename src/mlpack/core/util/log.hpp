@@ -51,7 +51,13 @@ namespace mlpack {
  * mode.  Messages to Log::Info will only be shown when the --verbose flag is
  * given to the program (or rather, the IO class).
  *
- * @see PrefixedOutStream, NullOutStream, IO
+ * By default every message is written to the terminal synchronously, so a
+ * program that logs heavily pays for the writes on its hot path.  Calling
+ * EnableAsync() moves the writes of Log::Debug and Log::Info to a background
+ * thread (see AsyncLogSink); Log::Warn and Log::Fatal always stay
+ * synchronous, so nothing is lost if the program terminates.
+ *
+ * @see PrefixedOutStream, NullOutStream, AsyncLogSink, IO
  */
 class Log
 {
@@ -64,6 +70,31 @@ class Log
   static void Assert(bool condition,
                      const std::string& message = "Assert Failed.");
 
+  /**
+   * Route the output of Log::Debug and Log::Info through a bounded ring
+   * buffer drained by a background thread, so that logging on a hot path
+   * costs only in-memory string assembly and never blocks on the terminal
+   * (see AsyncLogSink).  Lines are never dropped or reordered; if the ring
+   * fills up, the logging thread waits for the drainer.  A no-op if the
+   * asynchronous backend is already enabled.
+   *
+   * @param capacity Number of lines the ring buffer can hold.
+   */
+  static void EnableAsync(const size_t capacity = 1024);
+
+  /**
+   * Drain all pending output, then go back to writing Log::Debug and
+   * Log::Info synchronously.  A no-op if the asynchronous backend is not
+   * enabled.
+   */
+  static void DisableAsync();
+
+  /**
+   * Block until every line logged so far has been written out and flushed.
+   * A no-op if the asynchronous backend is not enabled.
+   */
+  static void FlushAsync();
+
   /**
    * MLPACK_EXPORT is required for global variables, so that they are properly
    * exported by the Windows compiler.
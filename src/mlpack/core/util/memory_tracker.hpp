@@ -0,0 +1,203 @@
+/**
+ * @file core/util/memory_tracker.hpp
+ *
+ * Opt-in allocation statistics and peak-memory reporting for mlpack.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_MEMORY_TRACKER_HPP
+#define MLPACK_CORE_UTIL_MEMORY_TRACKER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include <mlpack/core/util/log.hpp>
+
+#if !defined(_WIN32)
+  #include <sys/resource.h>
+#else
+  #include <windows.h>
+  #include <psapi.h>
+#endif
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The MemoryTracker collects allocation statistics from instrumented
+ * allocation sites (currently the ArenaAllocator that backs tree builds;
+ * other sites can hook in with RecordAllocation()/RecordDeallocation()) and
+ * reports high-water marks, so jobs can log their real peak working set
+ * instead of users sizing machines by trial and error.
+ *
+ * Tracking is disabled by default and all calls are no-ops then.  When
+ * enabled, the tracker maintains the current and peak number of tracked
+ * bytes, and Report() logs them through Log::Info together with the peak
+ * resident set size of the whole process as reported by the operating
+ * system.  The Profiler (see profiler.hpp) additionally records the tracked
+ * high-water mark per region, so hierarchical reports show which phase of a
+ * job was responsible for the peak.
+ *
+ * @code
+ * MemoryTracker::Enable();
+ * Profiler::Enable();
+ * // ... build trees, run k-means, ... (peaks are reported via Log::Info)
+ * Profiler::Print(Log::Info);  // Region tree with per-region peaks.
+ * @endcode
+ */
+class MemoryTracker
+{
+ public:
+  //! Get whether or not memory tracking is enabled.
+  static bool Enabled()
+  {
+    return EnabledFlag().load(std::memory_order_relaxed);
+  }
+
+  //! Enable memory tracking.
+  static void Enable() { EnabledFlag().store(true); }
+
+  //! Disable memory tracking.
+  static void Disable() { EnabledFlag().store(false); }
+
+  /**
+   * Record that the given number of bytes was allocated (a no-op if tracking
+   * is disabled).  Meant to be called from instrumented allocation sites.
+   */
+  static void RecordAllocation(const size_t bytes)
+  {
+    if (!Enabled())
+      return;
+
+    const size_t current = CurrentBytesRef().fetch_add(bytes,
+        std::memory_order_relaxed) + bytes;
+    std::atomic<size_t>& peak = PeakBytesRef();
+    size_t observed = peak.load(std::memory_order_relaxed);
+    while (observed < current &&
+        !peak.compare_exchange_weak(observed, current)) { }
+  }
+
+  /**
+   * Record that the given number of bytes was freed (a no-op if tracking is
+   * disabled).
+   */
+  static void RecordDeallocation(const size_t bytes)
+  {
+    if (!Enabled())
+      return;
+
+    CurrentBytesRef().fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  //! Get the number of tracked bytes currently allocated.
+  static size_t CurrentBytes()
+  {
+    return CurrentBytesRef().load(std::memory_order_relaxed);
+  }
+
+  //! Get the high-water mark of tracked bytes.
+  static size_t PeakBytes()
+  {
+    return PeakBytesRef().load(std::memory_order_relaxed);
+  }
+
+  //! Reset the high-water mark to the current number of tracked bytes.
+  static void ResetPeak() { PeakBytesRef().store(CurrentBytes()); }
+
+  /**
+   * Save the high-water mark and restart it from the current number of
+   * tracked bytes, so that a nested watermark can be taken; the saved value
+   * must later be given back to PopWatermark().  Used by the Profiler to
+   * track the peak of each region.  Watermarks taken while other threads
+   * allocate concurrently attribute those allocations to whichever regions
+   * are open at the time.
+   */
+  static size_t PushWatermark()
+  {
+    return PeakBytesRef().exchange(CurrentBytes());
+  }
+
+  /**
+   * Finish a nested watermark: return the peak seen since the matching
+   * PushWatermark() call, and fold it back into the saved outer watermark.
+   *
+   * @param saved The value returned by the matching PushWatermark() call.
+   */
+  static size_t PopWatermark(const size_t saved)
+  {
+    const size_t regionPeak = PeakBytes();
+    PeakBytesRef().store(std::max(saved, regionPeak));
+    return regionPeak;
+  }
+
+  /**
+   * Get the peak resident set size of the whole process, in bytes, as
+   * reported by the operating system (0 if it cannot be determined).  This
+   * covers all memory, not only the tracked allocation sites.
+   */
+  static size_t PeakRSS()
+  {
+    #if !defined(_WIN32)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0;
+    #if defined(__APPLE__)
+    return (size_t) usage.ru_maxrss; // Reported in bytes.
+    #else
+    return (size_t) usage.ru_maxrss * 1024; // Reported in kilobytes.
+    #endif
+    #else
+    PROCESS_MEMORY_COUNTERS info;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info)))
+      return 0;
+    return (size_t) info.PeakWorkingSetSize;
+    #endif
+  }
+
+  /**
+   * Log the tracked current and peak bytes and the process peak RSS through
+   * Log::Info (a no-op if tracking is disabled).
+   *
+   * @param job Name of the job being reported (e.g. "BinarySpaceTree build").
+   */
+  static void Report(const std::string& job)
+  {
+    if (!Enabled())
+      return;
+
+    Log::Info << job << ": " << CurrentBytes() << " tracked bytes in use, "
+        << PeakBytes() << " tracked bytes at peak; process peak RSS "
+        << PeakRSS() << " bytes." << std::endl;
+  }
+
+ private:
+  //! The enabled flag.
+  static std::atomic<bool>& EnabledFlag()
+  {
+    static std::atomic<bool> enabled(false);
+    return enabled;
+  }
+
+  //! The number of tracked bytes currently allocated.
+  static std::atomic<size_t>& CurrentBytesRef()
+  {
+    static std::atomic<size_t> currentBytes(0);
+    return currentBytes;
+  }
+
+  //! The high-water mark of tracked bytes.
+  static std::atomic<size_t>& PeakBytesRef()
+  {
+    static std::atomic<size_t> peakBytes(0);
+    return peakBytes;
+  }
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_MEMORY_TRACKER_HPP
@@ -0,0 +1,170 @@
+/**
+ * @file core/util/numa_topology.hpp
+ *
+ * NUMA topology detection and thread placement helpers.  On multi-socket
+ * machines, the parallel search and clustering paths lose a large fraction
+ * of their throughput to cross-node memory traffic when worker threads
+ * wander between sockets.  This header detects the node layout, lets a
+ * worker bind itself to one node, and partitions work so that each node's
+ * workers touch -- and therefore first-touch-allocate -- only their own
+ * shard of the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_NUMA_TOPOLOGY_HPP
+#define MLPACK_CORE_UTIL_NUMA_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+  #include <sched.h>
+#endif
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The NumaTopology class describes the NUMA node layout of the machine: how
+ * many nodes there are and which CPUs belong to each.  The layout is read
+ * once from sysfs (Linux; other platforms report a single node) and shared
+ * through Get().
+ *
+ * Workers use PinThreadToNode() to restrict themselves to one node's CPUs --
+ * the whole node's CPU set, not a single CPU, so the scheduler can still
+ * balance within the node -- and Partition() to split a range of work items
+ * into per-node shards.  Memory written by a pinned worker is allocated on
+ * its node by the operating system's first-touch policy, so copying a shard
+ * after pinning places it in node-local memory.
+ *
+ * On single-node machines (and non-Linux platforms) NumNodes() is 1 and
+ * pinning is a no-op, so callers can use the helpers unconditionally.
+ */
+class NumaTopology
+{
+ public:
+  //! Get the topology of this machine (detected once, on first use).
+  static const NumaTopology& Get()
+  {
+    static const NumaTopology topology;
+    return topology;
+  }
+
+  //! Get the number of NUMA nodes (at least 1).
+  size_t NumNodes() const { return nodeCpus.size(); }
+
+  //! Get the CPU ids belonging to the given node.  The list may be empty on
+  //! platforms where the layout could not be detected.
+  const std::vector<int>& Cpus(const size_t node) const
+  {
+    return nodeCpus[node];
+  }
+
+  /**
+   * Restrict the calling thread to the CPUs of the given node.  Returns true
+   * if the affinity was changed; on single-node machines, on platforms
+   * without affinity support, or if the node's CPU list is empty, nothing is
+   * done and false is returned.
+   *
+   * @param node Node to bind the calling thread to.
+   */
+  bool PinThreadToNode(const size_t node) const
+  {
+#if defined(__linux__)
+    if (NumNodes() <= 1 || node >= NumNodes() || nodeCpus[node].empty())
+      return false;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (size_t i = 0; i < nodeCpus[node].size(); ++i)
+      CPU_SET(nodeCpus[node][i], &cpus);
+
+    return (sched_setaffinity(0, sizeof(cpu_set_t), &cpus) == 0);
+#else
+    (void) node;
+    return false;
+#endif
+  }
+
+  /**
+   * Split a range of `count` work items into contiguous per-node shards and
+   * return the [begin, end) range of the given node's shard.  The shards
+   * differ in size by at most one item.
+   *
+   * @param count Total number of work items.
+   * @param node Node to get the shard of.
+   * @param numNodes Number of shards to split into.
+   */
+  static std::pair<size_t, size_t> Partition(const size_t count,
+                                             const size_t node,
+                                             const size_t numNodes)
+  {
+    return std::make_pair((count * node) / numNodes,
+                          (count * (node + 1)) / numNodes);
+  }
+
+ private:
+  //! Detect the topology.  Private; use Get().
+  NumaTopology()
+  {
+#if defined(__linux__)
+    // Each node directory in sysfs lists its CPUs as e.g. "0-15,32-47".
+    for (size_t node = 0; ; ++node)
+    {
+      std::ostringstream path;
+      path << "/sys/devices/system/node/node" << node << "/cpulist";
+      std::ifstream f(path.str());
+      if (!f.is_open())
+        break;
+
+      std::string cpuList;
+      std::getline(f, cpuList);
+      nodeCpus.push_back(ParseCpuList(cpuList));
+    }
+#endif
+
+    // Fall back to a single node covering everything if detection failed.
+    if (nodeCpus.empty())
+      nodeCpus.resize(1);
+  }
+
+  //! Parse a sysfs CPU list of the form "0-3,8,10-11" into CPU ids.
+  static std::vector<int> ParseCpuList(const std::string& cpuList)
+  {
+    std::vector<int> cpus;
+    std::istringstream in(cpuList);
+    std::string token;
+    while (std::getline(in, token, ','))
+    {
+      const size_t dash = token.find('-');
+      if (dash == std::string::npos)
+      {
+        cpus.push_back(atoi(token.c_str()));
+      }
+      else
+      {
+        const int first = atoi(token.substr(0, dash).c_str());
+        const int last = atoi(token.substr(dash + 1).c_str());
+        for (int cpu = first; cpu <= last; ++cpu)
+          cpus.push_back(cpu);
+      }
+    }
+
+    return cpus;
+  }
+
+  //! The CPU ids of each node.
+  std::vector<std::vector<int>> nodeCpus;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_NUMA_TOPOLOGY_HPP
@@ -0,0 +1,346 @@
+/**
+ * @file core/util/profiler.hpp
+ *
+ * A lightweight hierarchical profiler for mlpack library code.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROFILER_HPP
+#define MLPACK_CORE_UTIL_PROFILER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <mlpack/core/util/memory_tracker.hpp>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The Profiler provides hierarchical self-profiling for mlpack, unlike the
+ * flat named aggregates of Timer (see timers.hpp).  Library code marks
+ * regions with the RAII helper ProfileRegion; nested regions form a tree per
+ * thread, and for every tree node the profiler tracks the call count and the
+ * inclusive time (the exclusive time — inclusive minus the time spent in
+ * child regions — is computed when reporting).  Each thread writes into its
+ * own buffers, so marking regions never takes a lock.
+ *
+ * Profiling is disabled by default; a disabled ProfileRegion costs one atomic
+ * load.  When enabled, every region entry is also kept as an event, so a
+ * timeline of the run can be exported in the chrome-trace JSON format (load
+ * it in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * @code
+ * Profiler::Enable();
+ * // ... run the code of interest, e.g. tree building and search ...
+ * Profiler::Disable();
+ *
+ * Profiler::Print(std::cout);              // Aggregated region tree.
+ *
+ * std::ofstream trace("trace.json");
+ * Profiler::ExportChromeTrace(trace);      // Timeline of all events.
+ * @endcode
+ *
+ * Do not enable or disable profiling while regions are open, and do not call
+ * Clear() while other threads are inside profiled code.
+ */
+class Profiler
+{
+ public:
+  //! A node of the aggregated region tree of one thread.
+  struct Node
+  {
+    //! The name of the region.
+    std::string name;
+    //! The parent region (NULL for the root sentinel).
+    Node* parent;
+    //! How many times this region was entered at this position in the tree.
+    size_t count;
+    //! Total time spent in this region, children included.
+    std::chrono::microseconds inclusive;
+    //! The highest number of tracked bytes seen while this region was open
+    //! (0 if memory tracking was disabled; see memory_tracker.hpp).
+    size_t peakBytes;
+    //! Nested regions, by name.
+    std::map<std::string, std::unique_ptr<Node>> children;
+
+    Node(const std::string& name, Node* parent) :
+        name(name), parent(parent), count(0), inclusive(0), peakBytes(0) { }
+  };
+
+  //! Get whether or not profiling is enabled.
+  static bool Enabled()
+  {
+    return EnabledFlag().load(std::memory_order_relaxed);
+  }
+
+  //! Enable profiling.  Do not run this while regions are open!
+  static void Enable() { EnabledFlag().store(true); }
+
+  //! Disable profiling.  Do not run this while regions are open!
+  static void Disable() { EnabledFlag().store(false); }
+
+  /**
+   * Enter a region.  This is meant to be called through ProfileRegion rather
+   * than directly, so that regions cannot be left unbalanced.
+   *
+   * @param name Name of the region; should be a plain identifier-like string
+   *     (it is emitted verbatim into the chrome-trace JSON).
+   */
+  static void BeginRegion(const char* name)
+  {
+    ThreadProfile& profile = LocalProfile();
+
+    std::unique_ptr<Node>& child = profile.current->children[name];
+    if (!child)
+      child.reset(new Node(name, profile.current));
+    profile.current = child.get();
+
+    profile.watermarkStack.push_back(MemoryTracker::PushWatermark());
+    profile.startStack.push_back(std::chrono::steady_clock::now());
+  }
+
+  //! Leave the region entered by the matching BeginRegion() call.
+  static void EndRegion()
+  {
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+
+    ThreadProfile& profile = LocalProfile();
+    const std::chrono::steady_clock::time_point start =
+        profile.startStack.back();
+    profile.startStack.pop_back();
+
+    const std::chrono::microseconds duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    const size_t regionPeak =
+        MemoryTracker::PopWatermark(profile.watermarkStack.back());
+    profile.watermarkStack.pop_back();
+
+    ++profile.current->count;
+    profile.current->inclusive += duration;
+    profile.current->peakBytes = std::max(profile.current->peakBytes,
+        regionPeak);
+
+    profile.events.push_back(Event{profile.current->name,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            start - TraceEpoch()).count(), duration.count()});
+
+    profile.current = profile.current->parent;
+  }
+
+  /**
+   * Print the aggregated region tree of every thread that recorded regions.
+   * For each region the call count, inclusive time and exclusive time are
+   * given, and, if memory tracking was enabled (see memory_tracker.hpp), the
+   * tracked high-water mark of the region; nesting is shown by indentation.
+   */
+  static void Print(std::ostream& stream)
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    for (size_t t = 0; t < Registry().size(); ++t)
+    {
+      const ThreadProfile& profile = *Registry()[t];
+      if (profile.root.children.empty())
+        continue;
+
+      stream << "thread " << t << ":" << std::endl;
+      for (const auto& child : profile.root.children)
+        PrintNode(stream, *child.second, 1);
+    }
+  }
+
+  /**
+   * Export all recorded events in the chrome-trace JSON format (one complete
+   * event per region entry, with the thread the region ran on as the trace
+   * thread id).
+   */
+  static void ExportChromeTrace(std::ostream& stream)
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    stream << "{\"traceEvents\":[";
+    bool first = true;
+    for (size_t t = 0; t < Registry().size(); ++t)
+    {
+      for (const Event& event : Registry()[t]->events)
+      {
+        if (!first)
+          stream << ",";
+        first = false;
+        stream << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":0,"
+            << "\"tid\":" << t << ",\"ts\":" << event.startUs << ",\"dur\":"
+            << event.durationUs << "}";
+      }
+    }
+    stream << "]}" << std::endl;
+  }
+
+  //! Remove all recorded regions and events of all threads.  Do not call this
+  //! while other threads are inside profiled code.
+  static void Clear()
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    for (size_t t = 0; t < Registry().size(); ++t)
+    {
+      ThreadProfile& profile = *Registry()[t];
+      profile.root.children.clear();
+      profile.current = &profile.root;
+      profile.startStack.clear();
+      profile.watermarkStack.clear();
+      profile.events.clear();
+    }
+  }
+
+  /**
+   * Get the aggregated region tree of the calling thread (the children of the
+   * returned sentinel node are the top-level regions).  Meant for tests and
+   * for custom reporting.
+   */
+  static const Node& LocalTree() { return LocalProfile().root; }
+
+ private:
+  //! One region entry, for the chrome-trace timeline.
+  struct Event
+  {
+    //! The name of the region.
+    std::string name;
+    //! Start of the region, in microseconds since the trace epoch.
+    long long startUs;
+    //! Duration of the region in microseconds.
+    long long durationUs;
+  };
+
+  //! All profiling state owned by one thread.
+  struct ThreadProfile
+  {
+    //! The sentinel root of the region tree.
+    Node root;
+    //! The innermost open region (the root sentinel if none is open).
+    Node* current;
+    //! Start times of the open regions.
+    std::vector<std::chrono::steady_clock::time_point> startStack;
+    //! Saved memory watermarks of the open regions.
+    std::vector<size_t> watermarkStack;
+    //! All recorded region entries, for the chrome-trace timeline.
+    std::vector<Event> events;
+
+    ThreadProfile() : root("", NULL), current(&root) { }
+  };
+
+  //! The enabled flag.
+  static std::atomic<bool>& EnabledFlag()
+  {
+    static std::atomic<bool> enabled(false);
+    return enabled;
+  }
+
+  //! The mutex guarding the registry of per-thread profiles.
+  static std::mutex& RegistryMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  //! The registry of per-thread profiles.  Profiles are never removed, so
+  //! data recorded by threads that have exited is still reported.
+  static std::vector<std::unique_ptr<ThreadProfile>>& Registry()
+  {
+    static std::vector<std::unique_ptr<ThreadProfile>> registry;
+    return registry;
+  }
+
+  //! The common reference point of all event timestamps.
+  static std::chrono::steady_clock::time_point TraceEpoch()
+  {
+    static const std::chrono::steady_clock::time_point epoch =
+        std::chrono::steady_clock::now();
+    return epoch;
+  }
+
+  //! Get the profile of the calling thread, registering it on first use.
+  static ThreadProfile& LocalProfile()
+  {
+    static thread_local ThreadProfile* profile = NULL;
+    if (profile == NULL)
+    {
+      std::lock_guard<std::mutex> lock(RegistryMutex());
+      Registry().emplace_back(new ThreadProfile());
+      profile = Registry().back().get();
+    }
+    return *profile;
+  }
+
+  //! Print one node of the region tree and, recursively, its children.
+  static void PrintNode(std::ostream& stream,
+                        const Node& node,
+                        const size_t depth)
+  {
+    std::chrono::microseconds childTime(0);
+    for (const auto& child : node.children)
+      childTime += child.second->inclusive;
+
+    stream << std::string(2 * depth, ' ') << node.name << ": "
+        << node.count << " call" << (node.count == 1 ? "" : "s") << ", "
+        << node.inclusive.count() << " us inclusive, "
+        << (node.inclusive - childTime).count() << " us exclusive";
+    if (node.peakBytes > 0)
+      stream << ", " << node.peakBytes << " bytes at peak";
+    stream << std::endl;
+    for (const auto& child : node.children)
+      PrintNode(stream, *child.second, depth + 1);
+  }
+};
+
+/**
+ * A RAII marker for a profiled region: the region opens at construction and
+ * closes at destruction.  If profiling is disabled at construction time, the
+ * marker does nothing at all.
+ *
+ * @code
+ * void SomeExpensivePhase()
+ * {
+ *   util::ProfileRegion profile("some_expensive_phase");
+ *   // ... the code of the phase ...
+ * }
+ * @endcode
+ */
+class ProfileRegion
+{
+ public:
+  //! Open a region with the given name (if profiling is enabled).
+  explicit ProfileRegion(const char* name) : active(Profiler::Enabled())
+  {
+    if (active)
+      Profiler::BeginRegion(name);
+  }
+
+  //! Close the region (if it was opened).
+  ~ProfileRegion()
+  {
+    if (active)
+      Profiler::EndRegion();
+  }
+
+  //! Regions cannot be copied or moved.
+  ProfileRegion(const ProfileRegion&) = delete;
+  ProfileRegion& operator=(const ProfileRegion&) = delete;
+
+ private:
+  //! Whether profiling was enabled when the region was opened.
+  bool active;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_PROFILER_HPP
@@ -11,7 +11,9 @@
  */
 #include "io.hpp"
 #include "log.hpp"
+#include "async_log_sink.hpp"
 #include <iostream>
+#include <memory>
 
 using namespace mlpack;
 using namespace mlpack::util;
@@ -31,16 +33,54 @@ using namespace mlpack::util;
   #define BASH_CLEAR ""
 #endif
 
+// The destinations of Log::Debug and Log::Info are separate ostream objects
+// over the MLPACK_COUT_STREAM buffer, so that Log::EnableAsync() can point
+// them at an asynchronous sink without touching MLPACK_COUT_STREAM itself.
+// Log::Warn and Log::Fatal always write synchronously.
+static std::ostream debugDestination(MLPACK_COUT_STREAM.rdbuf());
+static std::ostream infoDestination(MLPACK_COUT_STREAM.rdbuf());
+
+//! The asynchronous sink, when Log::EnableAsync() has been called.
+static std::unique_ptr<AsyncLogSink> asyncSink;
+
 #ifdef DEBUG
-PrefixedOutStream Log::Debug = PrefixedOutStream(MLPACK_COUT_STREAM,
+PrefixedOutStream Log::Debug = PrefixedOutStream(debugDestination,
     BASH_CYAN "[DEBUG] " BASH_CLEAR);
 #else
 NullOutStream Log::Debug = NullOutStream();
 #endif
 
-PrefixedOutStream Log::Info = PrefixedOutStream(MLPACK_COUT_STREAM,
+PrefixedOutStream Log::Info = PrefixedOutStream(infoDestination,
     BASH_GREEN "[INFO ] " BASH_CLEAR, true /* unless --verbose */, false);
 PrefixedOutStream Log::Warn = PrefixedOutStream(MLPACK_COUT_STREAM,
     BASH_YELLOW "[WARN ] " BASH_CLEAR, false, false);
 PrefixedOutStream Log::Fatal = PrefixedOutStream(MLPACK_CERR_STREAM,
     BASH_RED "[FATAL] " BASH_CLEAR, false, true /* fatal */);
+
+void Log::EnableAsync(const size_t capacity)
+{
+  if (asyncSink)
+    return;
+
+  asyncSink.reset(new AsyncLogSink(MLPACK_COUT_STREAM.rdbuf(), capacity));
+  debugDestination.rdbuf(asyncSink.get());
+  infoDestination.rdbuf(asyncSink.get());
+}
+
+void Log::DisableAsync()
+{
+  if (!asyncSink)
+    return;
+
+  // Point the streams back at the synchronous buffer first, so nothing is
+  // enqueued while the sink drains and shuts down.
+  debugDestination.rdbuf(MLPACK_COUT_STREAM.rdbuf());
+  infoDestination.rdbuf(MLPACK_COUT_STREAM.rdbuf());
+  asyncSink.reset();
+}
+
+void Log::FlushAsync()
+{
+  if (asyncSink)
+    asyncSink->Flush();
+}
@@ -0,0 +1,213 @@
+/**
+ * @file core/util/task_pool.hpp
+ *
+ * A small work-stealing task pool for irregular workloads.  Static chunking
+ * splits work evenly by count, but tree workloads are skewed: some subtrees
+ * are orders of magnitude deeper than others, and a fixed partition leaves
+ * most workers idle while one finishes the heavy chunk.  The pool gives
+ * every worker its own task deque; a worker runs tasks from its own deque
+ * and steals from the others when it runs dry, and running tasks may submit
+ * further tasks, so oversized work items can split themselves when workers
+ * are starving.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_TASK_POOL_HPP
+#define MLPACK_CORE_UTIL_TASK_POOL_HPP
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+#include <mlpack/core/util/numa_topology.hpp>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The TaskPool runs a batch of tasks to completion on the available OpenMP
+ * threads, balancing load by work stealing.  Seed tasks are dealt round-robin
+ * across the per-worker deques; each worker pops from the back of its own
+ * deque and steals from the front of another worker's when its own is empty.
+ * A running task may call Submit() to add tasks to its worker's deque, and
+ * Starving() to ask whether there is currently less queued work than there
+ * are workers -- the cue for a task over a large subtree to split itself
+ * rather than run serially.
+ *
+ * Run() returns when every task, including all submitted ones, has finished.
+ * Idle workers spin (yielding) until then, so the pool is meant for compute
+ * regions, not for waiting on I/O.  Workers are pinned across the NUMA nodes
+ * of the machine for the duration of Run(), matching the placement used by
+ * the block-partitioned parallel code paths.  Without OpenMP, Run() executes
+ * every task on the calling thread.
+ *
+ * Exceptions must not escape a task; run them entirely inside the task body.
+ *
+ * @code
+ * TaskPool pool;
+ * std::vector<TaskPool::Task> seeds;
+ * for (Tree* node : frontier)
+ *   seeds.push_back([&pool, node]() { TraverseOrSplit(pool, node); });
+ * pool.Run(std::move(seeds));
+ * @endcode
+ */
+class TaskPool
+{
+ public:
+  //! The type of a task.
+  typedef std::function<void()> Task;
+
+  TaskPool() : outstanding(0), numWorkers(1) { }
+
+  //! The deques hold tasks bound to this pool, so it cannot be copied.
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  /**
+   * Run the given seed tasks (and any tasks they submit) to completion.
+   *
+   * @param seeds Initial batch of tasks.
+   */
+  void Run(std::vector<Task>&& seeds)
+  {
+#ifdef HAS_OPENMP
+    numWorkers = (size_t) omp_get_max_threads();
+#else
+    numWorkers = 1;
+#endif
+
+    queues.clear();
+    for (size_t i = 0; i < numWorkers; ++i)
+      queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+
+    // Deal the seeds round-robin so every worker starts with work.
+    outstanding.store(seeds.size());
+    for (size_t i = 0; i < seeds.size(); ++i)
+      queues[i % numWorkers]->tasks.push_back(std::move(seeds[i]));
+    seeds.clear();
+
+#ifdef HAS_OPENMP
+    #pragma omp parallel num_threads(numWorkers)
+    {
+      const size_t workerId = (size_t) omp_get_thread_num();
+
+      // Keep each worker on one NUMA node for the duration of the batch.
+      const NumaTopology& topology = NumaTopology::Get();
+      topology.PinThreadToNode((workerId * topology.NumNodes()) / numWorkers);
+
+      WorkerLoop(workerId);
+    }
+#else
+    WorkerLoop(0);
+#endif
+  }
+
+  /**
+   * Submit a task to the calling worker's deque.  Must only be called from
+   * inside a running task.
+   *
+   * @param task Task to add.
+   */
+  void Submit(Task task)
+  {
+#ifdef HAS_OPENMP
+    const size_t workerId = (size_t) omp_get_thread_num();
+#else
+    const size_t workerId = 0;
+#endif
+    ++outstanding;
+    std::lock_guard<std::mutex> lock(queues[workerId]->mutex);
+    queues[workerId]->tasks.push_back(std::move(task));
+  }
+
+  //! Report whether there is currently less queued and running work than
+  //! there are workers.  A heavy task seeing this should split itself.
+  bool Starving() const
+  {
+    return outstanding.load(std::memory_order_relaxed) < numWorkers;
+  }
+
+  //! Get the number of workers the pool runs on.
+  size_t NumWorkers() const { return numWorkers; }
+
+ private:
+  //! A worker's deque and the mutex serializing access to it.
+  struct WorkerQueue
+  {
+    std::deque<Task> tasks;
+    std::mutex mutex;
+  };
+
+  //! Run tasks until none are queued or running anywhere.
+  void WorkerLoop(const size_t workerId)
+  {
+    Task task;
+    while (outstanding.load(std::memory_order_acquire) > 0)
+    {
+      if (Pop(workerId, task) || Steal(workerId, task))
+      {
+        task();
+        task = Task();
+        --outstanding;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  //! Pop a task from the back of our own deque.
+  bool Pop(const size_t workerId, Task& task)
+  {
+    std::lock_guard<std::mutex> lock(queues[workerId]->mutex);
+    if (queues[workerId]->tasks.empty())
+      return false;
+
+    task = std::move(queues[workerId]->tasks.back());
+    queues[workerId]->tasks.pop_back();
+    return true;
+  }
+
+  //! Steal a task from the front of another worker's deque.
+  bool Steal(const size_t workerId, Task& task)
+  {
+    for (size_t i = 1; i < queues.size(); ++i)
+    {
+      const size_t victim = (workerId + i) % queues.size();
+      std::lock_guard<std::mutex> lock(queues[victim]->mutex);
+      if (queues[victim]->tasks.empty())
+        continue;
+
+      task = std::move(queues[victim]->tasks.front());
+      queues[victim]->tasks.pop_front();
+      return true;
+    }
+
+    return false;
+  }
+
+  //! One deque per worker.
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  //! Number of tasks queued or running.
+  std::atomic<size_t> outstanding;
+  //! Number of workers in use.
+  size_t numWorkers;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTIL_TASK_POOL_HPP
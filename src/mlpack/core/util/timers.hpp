@@ -42,6 +42,10 @@ namespace mlpack {
  * stopped, and its value to be obtained.  A named timer is specific to the
  * thread it is running on, so if you start a timer in one thread, it cannot be
  * stopped from a different thread.
+ *
+ * Starting and stopping a named timer takes a global lock and a map lookup,
+ * so this interface is meant for coarse phases; to time hot sections, use the
+ * integer-handle util::FastTimer (see fast_timer.hpp) instead.
  */
 class Timer
 {
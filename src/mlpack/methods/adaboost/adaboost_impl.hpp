@@ -28,9 +28,54 @@
 
 #include "adaboost.hpp"
 
+#include <mlpack/core/math/scores_to_labels.hpp>
+
 namespace mlpack {
 namespace adaboost {
 
+//! True if the weak learner has a training constructor that accepts a
+//! precomputed per-dimension sorted-order cache (one column of point indices
+//! per dimension); see the DecisionTree constructor taking sortedOrders.
+template<typename WeakLearnerType, typename MatType>
+struct HasSortedOrderTraining
+{
+  const static bool value = std::is_constructible<
+      WeakLearnerType,
+      const WeakLearnerType&,
+      const MatType&,
+      const arma::Row<size_t>&,
+      const size_t,
+      const arma::rowvec&,
+      const arma::umat&>::value;
+};
+
+//! Train a weak learner, reusing the precomputed sorted-order cache.
+template<typename WeakLearnerType, typename MatType>
+WeakLearnerType TrainWeakLearner(const WeakLearnerType& other,
+                                 MatType& data,
+                                 const arma::Row<size_t>& labels,
+                                 const size_t numClasses,
+                                 const arma::rowvec& weights,
+                                 const arma::umat& sortedOrders,
+                                 const std::true_type&)
+{
+  return WeakLearnerType(other, data, labels, numClasses, weights,
+      sortedOrders);
+}
+
+//! Train a weak learner that cannot use a sorted-order cache.
+template<typename WeakLearnerType, typename MatType>
+WeakLearnerType TrainWeakLearner(const WeakLearnerType& other,
+                                 MatType& data,
+                                 const arma::Row<size_t>& labels,
+                                 const size_t numClasses,
+                                 const arma::rowvec& weights,
+                                 const arma::umat& /* sortedOrders */,
+                                 const std::false_type&)
+{
+  return WeakLearnerType(other, data, labels, numClasses, weights);
+}
+
 /**
  * Constructor. Currently runs the AdaBoost.MH algorithm.
  *
@@ -90,10 +135,6 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // Use tempData to modify input data for incorporating weights.
   MatType tempData(data);
 
-  // This matrix is a helper matrix used to calculate the final hypothesis.
-  arma::mat sumFinalH = arma::zeros<arma::mat>(numClasses,
-      predictedLabels.n_cols);
-
   // Load the initial weights into a 2-D matrix.
   const double initWeight = 1.0 / double(data.n_cols * numClasses);
   arma::mat D(numClasses, data.n_cols);
@@ -102,20 +143,26 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // Weights are stored in this row vector.
   arma::rowvec weights(predictedLabels.n_cols);
 
-  // This is the final hypothesis.
-  arma::Row<size_t> finalH(predictedLabels.n_cols);
+  // If the weak learner can train from a precomputed sorted order of each
+  // dimension (e.g. decision stumps over numeric data), compute the orders
+  // once here: the boosting rounds only reweight the points, so the sorted
+  // order of every dimension is identical in every round, and each round's
+  // split search becomes a linear scan over the cached order instead of a
+  // fresh sort.
+  arma::umat sortedOrders;
+  if (HasSortedOrderTraining<WeakLearnerType, MatType>::value)
+  {
+    sortedOrders.set_size(tempData.n_cols, tempData.n_rows);
+    for (size_t j = 0; j < tempData.n_rows; ++j)
+    {
+      sortedOrders.col(j) =
+          arma::conv_to<arma::uvec>::from(arma::sort_index(tempData.row(j)));
+    }
+  }
 
   // Now, start the boosting rounds.
   for (size_t i = 0; i < iterations; ++i)
   {
-    // Initialized to zero in every round.  rt is used for calculation of
-    // alphat; it is the weighted error.
-    // rt = (sum) D(i) y(i) ht(xi)
-    rt = 0.0;
-
-    // zt is used for weight normalization.
-    zt = 0.0;
-
     // Build the weight vectors.
     weights = arma::sum(D);
 
@@ -131,7 +178,10 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // This trains the new WeakLearnerType using the hyperparameters from the
     // given WeakLearnerType.
 
-    WeakLearnerType w(other, tempData, labels, numClasses, weights);
+    WeakLearnerType w = TrainWeakLearner(other, tempData, labels, numClasses,
+        weights, sortedOrders,
+        std::integral_constant<bool,
+            HasSortedOrderTraining<WeakLearnerType, MatType>::value>());
     // There is a bug with Adaboost!  It will not use the specified
     // hyperparameters for the decision tree because they are not properly
     // passed to the new weak learners!  (And: it's a hard bug, because the
@@ -141,17 +191,12 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // DecisionTree(DecisionTree&, MatType&, LabelsType&, size_t, WeightsType&, double = 0.0, double = 0.0, ...);
     w.Classify(tempData, predictedLabels);
 
-    // Now from predictedLabels, build ht, the weak hypothesis
-    // buildClassificationMatrix(ht, predictedLabels);
-
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
-    {
-      if (predictedLabels(j) == labels(j))
-        rt += arma::accu(D.col(j));
-      else
-        rt -= arma::accu(D.col(j));
-    }
+    // Now, calculate alpha(t) using ht.  rt is the total weight of the
+    // correctly classified points minus the total weight of the misclassified
+    // points:
+    //   rt = (sum) D(i) y(i) ht(xi)
+    const arma::uvec correct = arma::find(predictedLabels == labels);
+    rt = 2.0 * arma::accu(weights(correct)) - arma::accu(weights);
 
     if ((i > 0) && (std::abs(rt - crt) < tolerance))
       break;
@@ -174,42 +219,15 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
-    {
-      const double expo = exp(alphat);
-      if (predictedLabels(j) == labels(j))
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) /= expo;
-          zt += D(k, j); // * exp(-1 * alphat * yt(j,k) * ht(j,k));
-
-          // Add to the final hypothesis matrix.
-          // sumFinalH(k, j) += (alphat * ht(k, j));
-          if (k == labels(j))
-            sumFinalH(k, j) += (alphat); // * ht(k, j));
-          else
-            sumFinalH(k, j) -= (alphat);
-        }
-      }
-      else
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) *= expo;
-          zt += D(k, j);
-
-          // Add to the final hypothesis matrix.
-          if (k == labels(j))
-            sumFinalH(k, j) += alphat; // * ht(k, j));
-          else
-            sumFinalH(k, j) -= alphat;
-        }
-      }
-    }
+    // Now start modifying the weights: scale the weight columns of the
+    // correctly classified points down by exp(alphat) and the misclassified
+    // ones up by the same factor, then renormalize.
+    const double expo = exp(alphat);
+    D.cols(correct) /= expo;
+    D.cols(arma::find(predictedLabels != labels)) *= expo;
+
+    // zt is the normalization constant.
+    zt = arma::accu(D);
 
     // Normalize D.
     D /= zt;
@@ -256,16 +274,11 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
       probabilities(tempPredictedLabels(j), j) += alpha[i];
   }
 
-  arma::colvec pRow;
-  arma::uword maxIndex = 0;
+  // Normalize the accumulated weak learner weights into probabilities, then
+  // take the vectorized argmax over the classes.
+  probabilities.each_row() /= arma::sum(probabilities, 0);
 
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
-  {
-    probabilities.col(i) /= arma::accu(probabilities.col(i));
-    pRow = probabilities.unsafe_col(i);
-    pRow.max(maxIndex);
-    predictedLabels(i) = maxIndex;
-  }
+  math::ScoresToLabels(probabilities, predictedLabels);
 }
 
 /**
@@ -0,0 +1,245 @@
+/**
+ * @file methods/amf/update_rules/parallel_sgd.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Block-stratified parallel SGD update rules for AMF.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_PARALLEL_SGD_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_PARALLEL_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements parallel stochastic gradient descent over the
+ * observed (nonzero) entries of V, using the distributed SGD stratification
+ * of
+ *
+ * @code
+ * @inproceedings{gemulla2011large,
+ *   title={Large-Scale Matrix Factorization with Distributed Stochastic
+ *       Gradient Descent},
+ *   author={Gemulla, R. and Nijkamp, E. and Haas, P. J. and Sismanis, Y.},
+ *   booktitle={Proceedings of the 17th ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining (KDD '11)},
+ *   pages={69--77},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * The nonzero entries are bucketed once into a p x p grid of rating blocks,
+ * where p is the number of threads.  Each epoch is p sub-epochs; in a
+ * sub-epoch the threads process one diagonal of the grid, so the blocks
+ * being processed share no rows of W and no columns of H.  The SGD updates
+ * are therefore conflict-free without any locking or atomics, while every
+ * observed entry is still visited exactly once per epoch.
+ *
+ * Each visited entry (i, j) applies the usual regularized SGD step to
+ * W.row(i) and H.col(j).  Both factor matrices are updated together inside
+ * WUpdate(); HUpdate() is a no-op, because splitting the SGD step across the
+ * two calls would require visiting every entry twice per epoch.
+ *
+ * If nonNegative is set, negative factor entries are clamped to zero after
+ * each update, which makes the factorization an NMF in the style of the
+ * other NMF update rules.
+ */
+class ParallelSGDUpdate
+{
+ public:
+  /**
+   * Construct the update rule with the given step size and regularization.
+   *
+   * @param stepSize Step size of each SGD update.
+   * @param lambda Regularization applied to the factors of each visited
+   *      entry.
+   * @param nonNegative If true, clamp negative factor entries to zero after
+   *      each update (nonnegative factorization).
+   */
+  ParallelSGDUpdate(const double stepSize = 0.001,
+                    const double lambda = 0.02,
+                    const bool nonNegative = false) :
+      stepSize(stepSize),
+      lambda(lambda),
+      nonNegative(nonNegative),
+      numBlocks(1)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Bucket the observed entries of the dataset into the block grid.  This
+   * function must be called before a new factorization.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of factorization.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    #ifdef HAS_OPENMP
+    numBlocks = std::max(1, omp_get_max_threads());
+    #else
+    numBlocks = 1;
+    #endif
+
+    blocks.clear();
+    blocks.resize(numBlocks * numBlocks);
+    BucketEntries(dataset);
+  }
+
+  /**
+   * Run one epoch of block-stratified parallel SGD over the observed entries
+   * of V, updating both W and H.  The blocks processed concurrently share no
+   * rows of W and no columns of H, so no synchronization is needed.
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& /* V */,
+                      arma::mat& W,
+                      arma::mat& H)
+  {
+    for (size_t subEpoch = 0; subEpoch < numBlocks; ++subEpoch)
+    {
+      // Process one diagonal of the block grid: block (b, (b + subEpoch) mod
+      // p) for each b.  These blocks are disjoint in both rows and columns.
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+      {
+        const std::vector<Entry>& block =
+            blocks[b * numBlocks + ((b + subEpoch) % numBlocks)];
+        for (size_t k = 0; k < block.size(); ++k)
+        {
+          const size_t i = block[k].row;
+          const size_t j = block[k].col;
+
+          const double error = block[k].value -
+              arma::dot(W.row(i), H.col(j));
+
+          // The step of each factor uses the other factor's old value.
+          const arma::rowvec wi = W.row(i);
+          W.row(i) += stepSize *
+              (error * H.col(j).t() - lambda * W.row(i));
+          H.col(j) += stepSize * (error * wi.t() - lambda * H.col(j));
+
+          if (nonNegative)
+          {
+            W.row(i) = arma::clamp(W.row(i), 0.0, DBL_MAX);
+            H.col(j) = arma::clamp(H.col(j), 0.0, DBL_MAX);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * The update of the encoding matrix H is a no-op: both factor matrices are
+   * updated together by WUpdate(), since each SGD step touches a row of W and
+   * a column of H at once.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& /* V */,
+                      const arma::mat& /* W */,
+                      arma::mat& /* H */)
+  {
+    // Nothing to do.
+  }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get whether negative factor entries are clamped to zero.
+  bool NonNegative() const { return nonNegative; }
+  //! Modify whether negative factor entries are clamped to zero.
+  bool& NonNegative() { return nonNegative; }
+
+  //! Serialize the object (the blocks are rebuilt by Initialize()).
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(stepSize));
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(nonNegative));
+  }
+
+ private:
+  //! One observed entry of the dataset.
+  struct Entry
+  {
+    arma::uword row;
+    arma::uword col;
+    double value;
+  };
+
+  //! Bucket the nonzero entries of a sparse matrix into the block grid.
+  void BucketEntries(const arma::sp_mat& dataset)
+  {
+    for (arma::sp_mat::const_iterator it = dataset.begin();
+         it != dataset.end(); ++it)
+    {
+      blocks[BlockIndex(it.row(), it.col(), dataset.n_rows,
+          dataset.n_cols)].push_back(Entry{ it.row(), it.col(), *it });
+    }
+  }
+
+  //! Bucket the nonzero entries of a dense matrix into the block grid.
+  template<typename MatType>
+  void BucketEntries(const MatType& dataset)
+  {
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+    {
+      for (size_t i = 0; i < dataset.n_rows; ++i)
+      {
+        const double val = dataset(i, j);
+        if (val != 0)
+        {
+          blocks[BlockIndex(i, j, dataset.n_rows, dataset.n_cols)].push_back(
+              Entry{ i, j, val });
+        }
+      }
+    }
+  }
+
+  //! Get the block grid index of the given entry.
+  size_t BlockIndex(const size_t row,
+                    const size_t col,
+                    const size_t numRows,
+                    const size_t numCols) const
+  {
+    const size_t rowBlock = (row * numBlocks) / numRows;
+    const size_t colBlock = (col * numBlocks) / numCols;
+    return rowBlock * numBlocks + colBlock;
+  }
+
+  //! Step size of each SGD update.
+  double stepSize;
+  //! Regularization applied to the factors of each visited entry.
+  double lambda;
+  //! Whether negative factor entries are clamped to zero.
+  bool nonNegative;
+  //! Number of blocks along each side of the grid (the number of threads).
+  size_t numBlocks;
+  //! The observed entries, bucketed into the (numBlocks x numBlocks) grid.
+  std::vector<std::vector<Entry>> blocks;
+}; // class ParallelSGDUpdate
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
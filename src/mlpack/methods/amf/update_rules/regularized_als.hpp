@@ -0,0 +1,211 @@
+/**
+ * @file methods/amf/update_rules/regularized_als.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Parallel regularized alternating least squares update rules for AMF.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_REGULARIZED_ALS_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_REGULARIZED_ALS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/batch_cholesky.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements the alternating least squares update rules with
+ * weighted lambda-regularization (ALS-WR), described in the following paper:
+ *
+ * @code
+ * @inproceedings{zhou2008large,
+ *   title={Large-Scale Parallel Collaborative Filtering for the Netflix
+ *       Prize},
+ *   author={Zhou, Y. and Wilkinson, D. and Schreiber, R. and Pan, R.},
+ *   booktitle={Proceedings of the 4th International Conference on Algorithmic
+ *       Aspects in Information and Management (AAIM 2008)},
+ *   pages={337--348},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * Unlike NMFALSUpdate, which solves one least squares problem over all
+ * entries of V, this rule treats zero entries of V as unobserved and solves
+ * one small regularized normal-equation system per row of W (and per column
+ * of H), using only the entries that row (or column) has observed.  The
+ * per-row systems are completely independent, so each update is parallelized
+ * across rows.  The regularization term of each system is scaled by the
+ * number of observed entries it covers, as in the paper.
+ */
+class RegularizedALSUpdate
+{
+ public:
+  /**
+   * Construct the update rule with the given regularization parameter.
+   *
+   * @param lambda Regularization applied to each least squares solve, scaled
+   *      by the number of observed entries of the row or column being solved.
+   */
+  RegularizedALSUpdate(const double lambda = 0.06) : lambda(lambda)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Set initial values for the factorization.  In this case, we don't need to
+   * set anything.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& /* dataset */, const size_t /* rank */)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * The update rule for the basis matrix W.  Each row of W is the solution of
+   * a regularized least squares problem over the columns of H corresponding
+   * to the observed entries of the matching row of V.  The rows are
+   * independent, so they are solved in parallel.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& V,
+                      arma::mat& W,
+                      const arma::mat& H)
+  {
+    const size_t r = W.n_cols;
+
+    // Process the rows in blocks: accumulate the normal equations of a block
+    // in parallel, then factor and solve all of its systems in one batch (see
+    // math::BatchSolveSPD()).  The block size caps the scratch cubes at a few
+    // megabytes regardless of the number of rows.
+    const size_t blockSize = std::max<size_t>(1, (1 << 22) / (r * r));
+
+    for (size_t begin = 0; begin < V.n_rows; begin += blockSize)
+    {
+      const size_t len = std::min(blockSize, (size_t) V.n_rows - begin);
+
+      arma::cube normals(r, r, len, arma::fill::zeros);
+      arma::mat rhs(r, len, arma::fill::zeros);
+      arma::uvec observed(len, arma::fill::zeros);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t b = 0; b < (omp_size_t) len; ++b)
+      {
+        const size_t i = begin + b;
+        for (size_t j = 0; j < V.n_cols; ++j)
+        {
+          const double val = V(i, j);
+          if (val != 0)
+          {
+            normals.slice(b) += H.col(j) * H.col(j).t();
+            rhs.col(b) += val * H.col(j);
+            ++observed[b];
+          }
+        }
+
+        if (observed[b] == 0)
+          normals.slice(b).eye(); // Placeholder; the result is discarded.
+        else
+          normals.slice(b).diag() += lambda * observed[b];
+      }
+
+      arma::mat solutions;
+      math::BatchSolveSPD(normals, rhs, solutions);
+
+      // A row with no observations keeps its current factors.
+      for (size_t b = 0; b < len; ++b)
+        if (observed[b] > 0)
+          W.row(begin + b) = solutions.col(b).t();
+    }
+  }
+
+  /**
+   * The update rule for the encoding matrix H.  Each column of H is the
+   * solution of a regularized least squares problem over the rows of W
+   * corresponding to the observed entries of the matching column of V.  The
+   * columns are independent, so they are solved in parallel.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& V,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    const size_t r = H.n_rows;
+
+    // Process the columns in blocks and solve each block's systems in one
+    // batch, as in WUpdate().
+    const size_t blockSize = std::max<size_t>(1, (1 << 22) / (r * r));
+
+    for (size_t begin = 0; begin < V.n_cols; begin += blockSize)
+    {
+      const size_t len = std::min(blockSize, (size_t) V.n_cols - begin);
+
+      arma::cube normals(r, r, len, arma::fill::zeros);
+      arma::mat rhs(r, len, arma::fill::zeros);
+      arma::uvec observed(len, arma::fill::zeros);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t b = 0; b < (omp_size_t) len; ++b)
+      {
+        const size_t j = begin + b;
+        for (size_t i = 0; i < V.n_rows; ++i)
+        {
+          const double val = V(i, j);
+          if (val != 0)
+          {
+            normals.slice(b) += W.row(i).t() * W.row(i);
+            rhs.col(b) += val * W.row(i).t();
+            ++observed[b];
+          }
+        }
+
+        if (observed[b] == 0)
+          normals.slice(b).eye(); // Placeholder; the result is discarded.
+        else
+          normals.slice(b).diag() += lambda * observed[b];
+      }
+
+      arma::mat solutions;
+      math::BatchSolveSPD(normals, rhs, solutions);
+
+      // A column with no observations keeps its current factors.
+      for (size_t b = 0; b < len; ++b)
+        if (observed[b] > 0)
+          H.col(begin + b) = solutions.col(b);
+    }
+  }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(lambda));
+  }
+
+ private:
+  //! Regularization parameter for the least squares solves.
+  double lambda;
+}; // class RegularizedALSUpdate
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
@@ -52,8 +52,10 @@ class GELUFunction
   template<typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType& x, OutputVecType& y)
   {
+    // Cube with multiplications rather than arma::pow(): pow() is a scalar
+    // libm call per element, while this form stays vectorizable.
     y = 0.5 * x % (1 + arma::tanh(std::sqrt(2 / M_PI) *
-        (x + 0.044715 * arma::pow(x, 3))));
+        (x + 0.044715 * (x % x % x))));
   }
 
   /**
@@ -79,10 +81,13 @@ class GELUFunction
   template<typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType& y, OutputVecType& x)
   {
-    x = 0.5 * arma::tanh(0.0356774 * arma::pow(y, 3) + 0.797885 * y) +
-        (0.0535161 * arma::pow(y, 3) + 0.398942 * y) %
-        arma::pow(1 / arma::cosh(0.0356774 * arma::pow(y, 3) +
-        0.797885 * y), 2) + 0.5;
+    // Evaluate the shared cubic argument once and replace the pow() calls
+    // with multiplications, so the expression is one vectorizable pass.
+    const OutputVecType cube = y % y % y;
+    const OutputVecType inner = 0.0356774 * cube + 0.797885 * y;
+    x = 0.5 * arma::tanh(inner) +
+        (0.0535161 * cube + 0.398942 * y) %
+        arma::square(1 / arma::cosh(inner)) + 0.5;
   }
 }; // class GELUFunction
 
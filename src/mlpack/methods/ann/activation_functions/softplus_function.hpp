@@ -66,10 +66,11 @@ class SoftplusFunction
   template<typename InputType, typename OutputType>
   static void Fn(const InputType& x, OutputType& y)
   {
-    y.set_size(arma::size(x));
-
-    for (size_t i = 0; i < x.n_elem; ++i)
-      y(i) = Fn(x(i));
+    // Branch-free, overflow-safe form of ln(1 + e^x): since
+    // ln(1 + e^x) = max(x, 0) + ln(1 + e^{-|x|}), the exponential is always
+    // taken of a non-positive value, so the whole activation is a single
+    // vectorizable pass instead of a scalar loop with per-element branches.
+    y = 0.5 * (x + arma::abs(x)) + arma::log(1.0 + arma::exp(-arma::abs(x)));
   }
 
   /**
@@ -72,7 +72,7 @@ class TanhFunction
   template<typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType& y, OutputVecType& x)
   {
-    x = 1 - arma::pow(y, 2);
+    x = 1 - arma::square(y);
   }
 
   /**
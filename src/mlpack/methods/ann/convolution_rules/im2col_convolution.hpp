@@ -0,0 +1,346 @@
+/**
+ * @file methods/ann/convolution_rules/im2col_convolution.hpp
+ *
+ * Implementation of the convolution through the im2col transformation and a
+ * matrix multiplication.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution by rearranging the input patches
+ * into the rows of a matrix (im2col) and expressing the convolution as a
+ * matrix multiplication.  The rearrangement costs one pass over the input,
+ * after which the whole computation is a single GEMM/GEMV call, which is much
+ * faster than the scalar loops of NaiveConvolution for all but tiny inputs;
+ * unlike FFTConvolution there is no crossover point below which it loses.
+ * The results are identical to NaiveConvolution.
+ *
+ * The patch matrix is kept in a thread-local scratch buffer, so repeated
+ * forward calls with the same layer shapes (the common case during inference)
+ * reuse the same allocation, and concurrent predictions do not contend.
+ *
+ * This class can be used as the ForwardConvolutionRule,
+ * BackwardConvolutionRule, or GradientConvolutionRule of the Convolution
+ * layer.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    // Compute the output size; see NaiveConvolution for details on the
+    // dilation arithmetic.
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+    const size_t outputRows = (input.n_rows - filterRows + dH) / dH;
+    const size_t outputCols = (input.n_cols - filterCols + dW) / dW;
+
+    // Gather the input patches into the scratch buffer, then compute all
+    // output elements with a single matrix-vector product.
+    arma::Mat<eT>& patches = Scratch<eT>();
+    Im2Col(input, filter.n_rows, filter.n_cols, outputRows, outputCols,
+        dW, dH, dilationW, dilationH, patches);
+
+    output.set_size(outputRows, outputCols);
+    arma::Col<eT> outputAlias(output.memptr(), outputRows * outputCols,
+        false, true);
+    outputAlias = patches * arma::vectorise(filter);
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    // Pad the input to the working shape, then run the valid-mode rule; this
+    // mirrors NaiveConvolution<FullConvolution>.
+    arma::Mat<eT> inputPadded;
+    Pad(input, filter, dilationW, dilationH, inputPadded);
+
+    Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, dW, dH, dilationW, dilationH);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.  All filters share the same input, so the input is
+   * rearranged only once and every output map is produced by one matrix
+   * multiplication.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    if (std::is_same<BorderMode, FullConvolution>::value)
+    {
+      arma::Mat<eT> inputPadded;
+      Pad(input, filter.slice(0), dilationW, dilationH, inputPadded);
+
+      Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+          output, dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+    const size_t outputRows = (input.n_rows - filterRows + dH) / dH;
+    const size_t outputCols = (input.n_cols - filterCols + dW) / dW;
+
+    arma::Mat<eT>& patches = Scratch<eT>();
+    Im2Col(input, filter.n_rows, filter.n_cols, outputRows, outputCols,
+        dW, dH, dilationW, dilationH, patches);
+
+    // The slices of the filter cube are contiguous in memory, so they can be
+    // viewed as the columns of a matrix without a copy; the same holds for
+    // the output cube.  One GEMM then computes every output map.
+    const arma::Mat<eT> filterMatrix(const_cast<eT*>(filter.memptr()),
+        filter.n_rows * filter.n_cols, filter.n_slices, false, true);
+
+    output.set_size(outputRows, outputCols, filter.n_slices);
+    arma::Mat<eT> outputAlias(output.memptr(), outputRows * outputCols,
+        filter.n_slices, false, true);
+    outputAlias = patches * filterMatrix;
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+ private:
+  /*
+   * Rearrange the input patches into the rows of the given matrix, so that
+   * row (i + j * outputRows) holds the input window that produces output
+   * element (i, j), ordered to match vectorise(filter).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filterRows Number of rows of the (undilated) filter.
+   * @param filterCols Number of columns of the (undilated) filter.
+   * @param outputRows Number of rows of the output.
+   * @param outputCols Number of columns of the output.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param patches Matrix to store the rearranged patches in.
+   */
+  template<typename eT>
+  static void Im2Col(const arma::Mat<eT>& input,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t outputRows,
+                     const size_t outputCols,
+                     const size_t dW,
+                     const size_t dH,
+                     const size_t dilationW,
+                     const size_t dilationH,
+                     arma::Mat<eT>& patches)
+  {
+    patches.set_size(outputRows * outputCols, filterRows * filterCols);
+
+    for (size_t kj = 0; kj < filterCols; ++kj)
+    {
+      for (size_t ki = 0; ki < filterRows; ++ki)
+      {
+        eT* patchesPtr = patches.colptr(kj * filterRows + ki);
+        for (size_t j = 0; j < outputCols; ++j, patchesPtr += outputRows)
+        {
+          const eT* inputPtr = input.colptr(kj * dilationW + j * dW) +
+              ki * dilationH;
+          if (dH == 1)
+          {
+            // The gathered elements are contiguous in the input column.
+            std::copy(inputPtr, inputPtr + outputRows, patchesPtr);
+          }
+          else
+          {
+            for (size_t i = 0; i < outputRows; ++i)
+              patchesPtr[i] = inputPtr[i * dH];
+          }
+        }
+      }
+    }
+  }
+
+  /*
+   * Zero-pad the input for a full convolution, exactly as NaiveConvolution
+   * does.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param inputPadded Matrix to store the padded input in.
+   */
+  template<typename eT>
+  static void Pad(const arma::Mat<eT>& input,
+                  const arma::Mat<eT>& filter,
+                  const size_t dilationW,
+                  const size_t dilationH,
+                  arma::Mat<eT>& inputPadded)
+  {
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+    const size_t paddingRows = filterRows - 1;
+    const size_t paddingCols = filterCols - 1;
+
+    inputPadded.zeros(input.n_rows + 2 * paddingRows,
+        input.n_cols + 2 * paddingCols);
+    inputPadded.submat(paddingRows, paddingCols, paddingRows + input.n_rows - 1,
+        paddingCols + input.n_cols - 1) = input;
+  }
+
+  /*
+   * Return the thread-local scratch buffer that holds the rearranged patches.
+   * Repeated calls with the same layer shapes reuse the same allocation, and
+   * each thread has its own buffer so concurrent forward passes do not
+   * contend.
+   */
+  template<typename eT>
+  static arma::Mat<eT>& Scratch()
+  {
+    static thread_local arma::Mat<eT> scratch;
+    return scratch;
+  }
+};  // class Im2ColConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
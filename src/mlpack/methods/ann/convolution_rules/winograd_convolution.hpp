@@ -0,0 +1,345 @@
+/**
+ * @file methods/ann/convolution_rules/winograd_convolution.hpp
+ *
+ * Implementation of the Winograd F(2x2, 3x3) convolution.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "im2col_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution with the Winograd minimal
+ * filtering algorithm F(2x2, 3x3): each 2x2 output tile is computed from a
+ * 4x4 input tile with 16 multiplications instead of 36, for a 2.25x
+ * reduction in multiplies on the 3x3, stride-1, undilated convolutions that
+ * dominate typical CNNs.  The tile transforms
+ *
+ *   Y = A^T ((G g G^T) o (B^T d B)) A
+ *
+ * have constant matrices containing only 0, +-1, and +-0.5, so they are
+ * fully unrolled into additions at compile time rather than stored and
+ * multiplied at runtime.  The filter transform G g G^T is computed once per
+ * call and shared by all tiles.
+ *
+ * Shapes the algorithm does not cover (kernels other than 3x3, strides or
+ * dilations other than 1, inputs smaller than the kernel) automatically fall
+ * back to Im2ColConvolution, so this rule can be used unconditionally as the
+ * Convolution layer's ForwardConvolutionRule or BackwardConvolutionRule; the
+ * Winograd path is selected exactly when the kernel shape matches.  The
+ * results are identical to NaiveConvolution up to floating-point rounding.
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class WinogradConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    // F(2x2, 3x3) only covers 3x3 kernels applied with unit stride and no
+    // dilation; anything else falls back to the im2col rule.
+    if (filter.n_rows != 3 || filter.n_cols != 3 || dW != 1 || dH != 1 ||
+        dilationW != 1 || dilationH != 1 ||
+        input.n_rows < 3 || input.n_cols < 3)
+    {
+      Im2ColConvolution<ValidConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    const size_t outputRows = input.n_rows - 2;
+    const size_t outputCols = input.n_cols - 2;
+    output.set_size(outputRows, outputCols);
+
+    // Transform the filter once: U = G g G^T, where
+    //   G = [ 1    0    0  ]
+    //       [ 1/2  1/2  1/2]
+    //       [ 1/2 -1/2  1/2]
+    //       [ 0    0    1  ].
+    eT w[4][3];
+    for (size_t j = 0; j < 3; ++j)
+    {
+      w[0][j] = filter(0, j);
+      w[1][j] = 0.5 * (filter(0, j) + filter(1, j) + filter(2, j));
+      w[2][j] = 0.5 * (filter(0, j) - filter(1, j) + filter(2, j));
+      w[3][j] = filter(2, j);
+    }
+    eT u[4][4];
+    for (size_t i = 0; i < 4; ++i)
+    {
+      u[i][0] = w[i][0];
+      u[i][1] = 0.5 * (w[i][0] + w[i][1] + w[i][2]);
+      u[i][2] = 0.5 * (w[i][0] - w[i][1] + w[i][2]);
+      u[i][3] = w[i][2];
+    }
+
+    // Each tile computes the 2x2 output block at (2 * ti, 2 * tj) from the
+    // 4x4 input block at the same origin; odd-sized outputs read (and write)
+    // one row or column past the edge, which is handled by zero-padding the
+    // gather and clipping the scatter.
+    const size_t tileRows = (outputRows + 1) / 2;
+    const size_t tileCols = (outputCols + 1) / 2;
+
+    for (size_t tj = 0; tj < tileCols; ++tj)
+    {
+      for (size_t ti = 0; ti < tileRows; ++ti)
+      {
+        const size_t r = 2 * ti;
+        const size_t c = 2 * tj;
+
+        // Gather the 4x4 input tile.
+        eT d[4][4];
+        if ((r + 4 <= input.n_rows) && (c + 4 <= input.n_cols))
+        {
+          for (size_t j = 0; j < 4; ++j)
+          {
+            const eT* inputPtr = input.colptr(c + j) + r;
+            d[0][j] = inputPtr[0];
+            d[1][j] = inputPtr[1];
+            d[2][j] = inputPtr[2];
+            d[3][j] = inputPtr[3];
+          }
+        }
+        else
+        {
+          for (size_t j = 0; j < 4; ++j)
+            for (size_t i = 0; i < 4; ++i)
+              d[i][j] = (r + i < input.n_rows && c + j < input.n_cols) ?
+                  input(r + i, c + j) : 0;
+        }
+
+        // Transform the input tile: V = B^T d B, where
+        //   B^T = [ 1  0 -1  0]
+        //         [ 0  1  1  0]
+        //         [ 0 -1  1  0]
+        //         [ 0  1  0 -1].
+        eT t[4][4];
+        for (size_t j = 0; j < 4; ++j)
+        {
+          t[0][j] = d[0][j] - d[2][j];
+          t[1][j] = d[1][j] + d[2][j];
+          t[2][j] = d[2][j] - d[1][j];
+          t[3][j] = d[1][j] - d[3][j];
+        }
+        eT v[4][4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+          v[i][0] = t[i][0] - t[i][2];
+          v[i][1] = t[i][1] + t[i][2];
+          v[i][2] = t[i][2] - t[i][1];
+          v[i][3] = t[i][1] - t[i][3];
+        }
+
+        // The elementwise product is where the 16 multiplications happen;
+        // then the output transform Y = A^T (U o V) A, where
+        //   A^T = [ 1  1  1  0]
+        //         [ 0  1 -1 -1].
+        eT s[2][4];
+        for (size_t j = 0; j < 4; ++j)
+        {
+          const eT m0 = u[0][j] * v[0][j];
+          const eT m1 = u[1][j] * v[1][j];
+          const eT m2 = u[2][j] * v[2][j];
+          const eT m3 = u[3][j] * v[3][j];
+          s[0][j] = m0 + m1 + m2;
+          s[1][j] = m1 - m2 - m3;
+        }
+
+        // Scatter the 2x2 output tile, clipping at the edges.
+        output(r, c) = s[0][0] + s[0][1] + s[0][2];
+        if (r + 1 < outputRows)
+          output(r + 1, c) = s[1][0] + s[1][1] + s[1][2];
+        if (c + 1 < outputCols)
+          output(r, c + 1) = s[0][1] - s[0][2] - s[0][3];
+        if ((r + 1 < outputRows) && (c + 1 < outputCols))
+          output(r + 1, c + 1) = s[1][1] - s[1][2] - s[1][3];
+      }
+    }
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    // Pad the input to the working shape, then run the valid-mode rule; this
+    // mirrors NaiveConvolution<FullConvolution>.
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+    const size_t paddingRows = filterRows - 1;
+    const size_t paddingCols = filterCols - 1;
+
+    arma::Mat<eT> inputPadded(input.n_rows + 2 * paddingRows,
+        input.n_cols + 2 * paddingCols, arma::fill::zeros);
+    inputPadded.submat(paddingRows, paddingCols, paddingRows + input.n_rows - 1,
+        paddingCols + input.n_cols - 1) = input;
+
+    WinogradConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, dW, dH, dilationW, dilationH);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+};  // class WinogradConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_FFN_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/streaming_dataset.hpp>
 
 #include "forward_decls.hpp"
 #include "init_rules/network_init.hpp"
@@ -186,6 +187,35 @@ class FFN
                                     MatType responses,
                                     CallbackTypes&&... callbacks);
 
+  /**
+   * Train the feedforward network by streaming batches of predictors and
+   * responses from disk.  For each epoch, both streams are swept batch by
+   * batch and the given optimizer is run on each batch in turn (configure its
+   * maximum iterations accordingly); while the optimizer works on the current
+   * batch, the streams read the next one on a background task, so I/O
+   * overlaps with the optimization step.  Within-batch shuffling is handled
+   * by the optimizer as usual.
+   *
+   * The two streams must be column-aligned: column i of the response stream
+   * is the response for column i of the predictor stream.
+   *
+   * @param predictorStream Streaming view of the input training variables.
+   * @param responseStream Streaming view of the training responses.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of sweeps over the dataset.
+   * @param callbacks Callback function for ensmallen optimizer
+   *      `OptimizerType`.  See
+   *      https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The objective of the final batch of the final epoch.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(
+      data::StreamingDataset<typename MatType::elem_type>& predictorStream,
+      data::StreamingDataset<typename MatType::elem_type>& responseStream,
+      OptimizerType& optimizer,
+      const size_t epochs,
+      CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will be
    * the output of the output layer when `predictors` is passed through the
@@ -199,6 +229,90 @@ class FFN
                MatType& results,
                const size_t batchSize = 128);
 
+  /**
+   * Predict the responses to a given set of predictors, using all available
+   * threads.  The predictor matrix is sharded into contiguous blocks of
+   * columns, and each worker thread predicts its shard with its own copy of
+   * the network, since the layers store their activations internally and
+   * cannot be shared between threads.  The results are identical to
+   * `Predict()`.
+   *
+   * Each worker copies the network once per call, so this is only worthwhile
+   * when the number of points is large compared to the size of the model; for
+   * small prediction sets, use `Predict()`.  If OpenMP is not available (or
+   * only one thread is), this is equivalent to `Predict()`.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Batch size to use for prediction within each thread.
+   */
+  void ParallelPredict(MatType predictors,
+                       MatType& results,
+                       const size_t batchSize = 128);
+
+  /**
+   * Configure `handle` as a cheap, shared-weight inference handle for this
+   * network.  The handle clones the layer objects---which hold only small
+   * per-layer state---but aliases this network's `parameters` matrix instead
+   * of copying it, so many handles of a large model fit in memory where many
+   * deep copies would not.
+   *
+   * A forward pass only mutates buffers local to the handle and only reads
+   * the shared weights, so each serving thread can call `Predict()` on its
+   * own handle concurrently.  A handle must not outlive the network whose
+   * weights it shares, and must not be trained or reset (that would write to
+   * the shared weights).
+   *
+   * The network must be trained (or loaded) before its weights can be shared.
+   *
+   * @param handle Network object to configure as an inference handle.
+   */
+  void CreateInferenceHandle(FFN& handle);
+
+  /**
+   * Pre-reserve the network's activation memory for prediction batches of up
+   * to `maxBatchSize` points.  After this call, every `Predict()` whose
+   * batch size does not exceed the reservation is serviced by aliases into
+   * the reserved memory and performs no activation allocation at all, no
+   * matter how batch sizes vary between calls---in steady-state serving the
+   * allocator is never touched.  (Whether any allocation happens can be
+   * verified with `util::MemoryTracker`, which the activation arena reports
+   * to.)
+   *
+   * The reservation holds `maxBatchSize` columns for every layer output, so
+   * pick the largest batch size the serving path will actually use.  The
+   * network must be trained (or loaded) before memory can be reserved; for
+   * shared-weight handles (see `CreateInferenceHandle()`), reserve on each
+   * handle, since activation memory is local to the handle.
+   *
+   * @param maxBatchSize Largest batch size to reserve for.
+   */
+  void ReserveInferenceMemory(const size_t maxBatchSize);
+
+  /**
+   * Configure `folded` as an inference-only copy of this network in which
+   * every `BatchNorm` layer that directly follows a `Linear` layer or a
+   * `Convolution` layer with a bias term has been folded into that layer's
+   * weights and bias, and removed from the network.  At prediction time the
+   * folded network computes the same outputs (up to floating-point rounding)
+   * with whole layers removed from the hot path.
+   *
+   * The fold scales each output unit (or output map) of the preceding layer
+   * by `gamma / sqrt(runningVariance + eps)` and adjusts its bias to absorb
+   * the running mean and `beta`.  `BatchNorm` layers that do not follow a
+   * foldable layer are kept as-is.
+   *
+   * The folded network holds its own copy of the (rewritten) weights, so it
+   * may outlive this network; but it uses the running statistics accrued so
+   * far, so it should only be used for prediction---train this network and
+   * fold again instead of training the folded copy.
+   *
+   * The network must be trained (or loaded) before it can be folded.
+   *
+   * @param folded Network object to configure as the folded inference network.
+   */
+  void FoldNormalization(FFN& folded);
+
   // Return the number of weights in the model.
   size_t WeightSize();
 
@@ -235,6 +349,19 @@ class FFN
   //! time a forward pass is done.
   MatType& Parameters() { return parameters; }
 
+  //! Get the gradient checkpointing interval (0 or 1 means checkpointing is
+  //! disabled).
+  size_t CheckpointInterval() const { return network.CheckpointInterval(); }
+  //! Modify the gradient checkpointing interval.  When set to some k > 1,
+  //! during training only the activation of every k-th layer is stored; the
+  //! activations in between are recomputed from the nearest checkpoint during
+  //! the backward pass.  This reduces the activation memory of a deep network
+  //! by roughly a factor of k, at the cost of up to two extra forward passes.
+  //! Take care: layers whose forward pass is stochastic or stateful (e.g.
+  //! `Dropout` or `BatchNorm`) will run their forward pass again during
+  //! recomputation, so they should not be used together with checkpointing.
+  size_t& CheckpointInterval() { return network.CheckpointInterval(); }
+
   /**
    * Reset the stored data of the network entirely.  This resets all weights of
    * each layer using `InitializationRuleType`, and prepares the network to
@@ -17,9 +17,60 @@
 
 #include "make_alias.hpp"
 
+#include <mlpack/core/util/sfinae_utility.hpp>
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
+//! This is used to detect whether the output layer provides a fused
+//! EvaluateWithGradient() method (see e.g. NegativeLogLikelihood).
+HAS_MEM_FUNC(EvaluateWithGradient, HasEvaluateWithGradientCheck);
+
+/*
+ * Utility struct to detect whether a loss function can compute the loss and
+ * its gradient in one fused pass via
+ * EvaluateWithGradient(prediction, target, gradient).
+ */
+template<typename LossType, typename MatType>
+struct HasFusedEvaluateWithGradient
+{
+  static const bool value = HasEvaluateWithGradientCheck<LossType,
+      typename MatType::elem_type(LossType::*)(const MatType&,
+                                               const MatType&,
+                                               MatType&)>::value;
+};
+
+//! Compute the loss and its gradient with the loss function's fused
+//! implementation, if it has one.
+template<typename LossType, typename MatType>
+typename MatType::elem_type LossForwardBackward(
+    LossType& outputLayer,
+    const MatType& prediction,
+    const MatType& target,
+    MatType& error,
+    const typename std::enable_if_t<
+        HasFusedEvaluateWithGradient<LossType, MatType>::value>* = 0)
+{
+  return outputLayer.EvaluateWithGradient(prediction, target, error);
+}
+
+//! Compute the loss and its gradient with separate Forward() and Backward()
+//! passes, for loss functions without a fused implementation.
+template<typename LossType, typename MatType>
+typename MatType::elem_type LossForwardBackward(
+    LossType& outputLayer,
+    const MatType& prediction,
+    const MatType& target,
+    MatType& error,
+    const typename std::enable_if_t<
+        !HasFusedEvaluateWithGradient<LossType, MatType>::value>* = 0)
+{
+  const typename MatType::elem_type obj =
+      outputLayer.Forward(prediction, target);
+  outputLayer.Backward(prediction, target, error);
+  return obj;
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -188,6 +239,45 @@ typename MatType::elem_type FFN<
       callbacks...);
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(data::StreamingDataset<typename MatType::elem_type>& predictorStream,
+         data::StreamingDataset<typename MatType::elem_type>& responseStream,
+         OptimizerType& optimizer,
+         const size_t epochs,
+         CallbackTypes&&... callbacks)
+{
+  typename MatType::elem_type objective = 0;
+  for (size_t epoch = 0; epoch < epochs; ++epoch)
+  {
+    predictorStream.Reset();
+    responseStream.Reset();
+
+    // While the optimizer works on the current batch, both streams prefetch
+    // the next one in the background.
+    while (predictorStream.NextBatch())
+    {
+      if (!responseStream.NextBatch() ||
+          responseStream.Batch().n_cols != predictorStream.Batch().n_cols)
+      {
+        throw std::runtime_error("FFN::Train(): predictor and response "
+            "streams are not column-aligned!");
+      }
+
+      objective = Train(MatType(predictorStream.Batch()),
+          MatType(responseStream.Batch()), optimizer, callbacks...);
+    }
+  }
+
+  return objective;
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -202,6 +292,10 @@ void FFN<
 
   results.set_size(network.OutputSize(), predictors.n_cols);
 
+  // The intermediate activations are not needed once they have been consumed
+  // during prediction, so let the network pack them into a reused arena.
+  network.ActivationMemoryPlanning() = true;
+
   for (size_t i = 0; i < predictors.n_cols; i += batchSize)
   {
     const size_t effectiveBatchSize = std::min(batchSize,
@@ -214,6 +308,279 @@ void FFN<
 
     network.Forward(predictorAlias, resultAlias);
   }
+
+  network.ActivationMemoryPlanning() = false;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ParallelPredict(MatType predictors,
+                   MatType& results,
+                   const size_t batchSize)
+{
+  // Ensure that the network is configured correctly.
+  CheckNetwork("FFN::ParallelPredict()", predictors.n_rows, true, false);
+
+  // Never use more threads than there are batches of work.
+  #ifdef HAS_OPENMP
+  const size_t numThreads = std::min((size_t) omp_get_max_threads(),
+      (size_t(predictors.n_cols) + batchSize - 1) / batchSize);
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  // With a single thread there is no point copying the network.
+  if (numThreads <= 1)
+  {
+    Predict(std::move(predictors), results, batchSize);
+    return;
+  }
+
+  results.set_size(network.OutputSize(), predictors.n_cols);
+
+  // Shard the points into one contiguous block of columns per thread.  Each
+  // worker runs the usual batched prediction loop on its own copy of the
+  // network, since Forward() stores intermediate activations inside the
+  // layers and so a single network cannot be shared between threads.
+  #pragma omp parallel num_threads((int) numThreads)
+  {
+    FFN<OutputLayerType, InitializationRuleType, MatType> worker(*this);
+    // As in Predict(), the intermediate activations are not needed once they
+    // have been consumed, so pack them into a reused arena.
+    worker.network.ActivationMemoryPlanning() = true;
+
+    #ifdef HAS_OPENMP
+    const size_t threadId = (size_t) omp_get_thread_num();
+    #else
+    const size_t threadId = 0;
+    #endif
+    const size_t shardSize =
+        (size_t(predictors.n_cols) + numThreads - 1) / numThreads;
+    const size_t begin = threadId * shardSize;
+    const size_t end = std::min(size_t(predictors.n_cols),
+        begin + shardSize);
+
+    for (size_t i = begin; i < end; i += batchSize)
+    {
+      const size_t effectiveBatchSize = std::min(batchSize, end - i);
+
+      MatType predictorAlias(predictors.colptr(i), predictors.n_rows,
+          effectiveBatchSize, false, true);
+      MatType resultAlias(results.colptr(i), results.n_rows,
+          effectiveBatchSize, false, true);
+
+      worker.network.Forward(predictorAlias, resultAlias);
+    }
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::CreateInferenceHandle(FFN& handle)
+{
+  if (parameters.is_empty())
+  {
+    Log::Fatal << "FFN::CreateInferenceHandle(): cannot share the weights of "
+        << "an uninitialized network; train or load the model first!"
+        << std::endl;
+  }
+
+  // Make sure the dimensions and weight aliases of this network are set up
+  // before sharing them.
+  CheckNetwork("FFN::CreateInferenceHandle()", 0, true, false);
+
+  // Clone the layers (these hold only small per-layer state), but alias this
+  // network's parameter matrix instead of copying it.  The alias is strict,
+  // so an accidental attempt to resize the shared weights through the handle
+  // will throw instead of silently detaching.
+  handle.outputLayer = outputLayer;
+  handle.initializeRule = initializeRule;
+  handle.network = network;
+  handle.inputDimensions = inputDimensions;
+  handle.predictors.clear();
+  handle.responses.clear();
+  MakeAlias(handle.parameters, parameters.memptr(), parameters.n_rows,
+      parameters.n_cols);
+
+  // Wire the cloned layers to the shared weights, and put the handle into
+  // prediction mode.
+  handle.inputDimensionsAreSet = true;
+  handle.layerMemoryIsSet = false;
+  handle.CheckNetwork("FFN::CreateInferenceHandle()", 0, true, false);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ReserveInferenceMemory(const size_t maxBatchSize)
+{
+  if (parameters.is_empty())
+  {
+    Log::Fatal << "FFN::ReserveInferenceMemory(): cannot reserve memory for "
+        << "an uninitialized network; train or load the model first!"
+        << std::endl;
+  }
+
+  // Make sure the layer output sizes are known before sizing the arena.
+  CheckNetwork("FFN::ReserveInferenceMemory()", 0, true, false);
+
+  network.ReserveForwardPassMemory(maxBatchSize);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::FoldNormalization(FFN& folded)
+{
+  // The standard Convolution layer, for any matrix type.
+  typedef ConvolutionType<NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<FullConvolution>, NaiveConvolution<ValidConvolution>,
+      MatType> StandardConvolution;
+
+  if (parameters.is_empty())
+  {
+    Log::Fatal << "FFN::FoldNormalization(): cannot fold an uninitialized "
+        << "network; train or load the model first!" << std::endl;
+  }
+
+  // Make sure the dimensions and weight aliases of this network are set up
+  // before we inspect the layers.
+  CheckNetwork("FFN::FoldNormalization()", 0, true, false);
+
+  const std::vector<Layer<MatType>*>& layers = network.Network();
+
+  // Decide, for each layer, whether it is a BatchNorm that can be folded into
+  // the layer directly before it.  We can fold into a Linear layer whose
+  // output size matches the number of normalized channels, or into a standard
+  // Convolution layer with a bias term whose number of output maps matches.
+  std::vector<bool> foldAway(layers.size(), false);
+  for (size_t i = 1; i < layers.size(); ++i)
+  {
+    BatchNormType<MatType>* bn =
+        dynamic_cast<BatchNormType<MatType>*>(layers[i]);
+    if (bn == NULL || foldAway[i - 1])
+      continue;
+
+    LinearType<MatType, NoRegularizer>* linear =
+        dynamic_cast<LinearType<MatType, NoRegularizer>*>(layers[i - 1]);
+    StandardConvolution* conv =
+        dynamic_cast<StandardConvolution*>(layers[i - 1]);
+
+    if (linear != NULL && bn->InputSize() == linear->OutputSize())
+      foldAway[i] = true;
+    else if (conv != NULL && conv->UseBias() && bn->InputSize() == conv->Maps())
+      foldAway[i] = true;
+  }
+
+  // Build the folded network from clones of the kept layers.
+  folded.outputLayer = outputLayer;
+  folded.initializeRule = initializeRule;
+  folded.network = MultiLayer<MatType>();
+  folded.inputDimensions = inputDimensions;
+  folded.parameters.clear();
+  folded.predictors.clear();
+  folded.responses.clear();
+  folded.inputDimensionsAreSet = false;
+  folded.layerMemoryIsSet = false;
+
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    if (!foldAway[i])
+      folded.network.Add(layers[i]->Clone());
+  }
+
+  // Allocate and initialize the folded parameter matrix, wire the cloned
+  // layers to it, and put the folded network into prediction mode.  (The
+  // initialized values will be overwritten below.)
+  folded.CheckNetwork("FFN::FoldNormalization()", 0, true, false);
+
+  // Now copy the weights of each kept layer, folding the scale and shift of
+  // each removed BatchNorm into the weights of the layer before it.
+  size_t srcOffset = 0;
+  size_t dstOffset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    const size_t weightSize = layers[i]->WeightSize();
+
+    if (!foldAway[i])
+    {
+      if (weightSize > 0)
+      {
+        folded.parameters.rows(dstOffset, dstOffset + weightSize - 1) =
+            parameters.rows(srcOffset, srcOffset + weightSize - 1);
+      }
+
+      srcOffset += weightSize;
+      dstOffset += weightSize;
+      continue;
+    }
+
+    // This BatchNorm is folded away: at prediction time it computes
+    // `y = s % x + t` with `s = gamma / sqrt(runningVariance + eps)` and
+    // `t = beta - s % runningMean`, so we can scale each output unit of the
+    // previous layer by `s` and absorb `t` into its bias.
+    BatchNormType<MatType>* bn =
+        dynamic_cast<BatchNormType<MatType>*>(layers[i]);
+    const size_t channels = bn->InputSize();
+    const MatType scale = bn->Parameters().rows(0, channels - 1) /
+        arma::sqrt(bn->TrainingVariance() + bn->Epsilon());
+    const MatType shift = bn->Parameters().rows(channels, 2 * channels - 1) -
+        scale % bn->TrainingMean();
+
+    // The previous layer's weights have already been copied; they start at
+    // `prevDst` in the folded parameter matrix.
+    const size_t prevWeightSize = layers[i - 1]->WeightSize();
+    const size_t prevDst = dstOffset - prevWeightSize;
+
+    MatType bias;
+    if (dynamic_cast<LinearType<MatType, NoRegularizer>*>(layers[i - 1]))
+    {
+      // The block holds the (outSize x inSize) weight matrix followed by the
+      // bias vector; scaling an output unit scales a row of the weight.
+      const size_t inSize = (prevWeightSize / channels) - 1;
+      MatType weight;
+      MakeAlias(weight, folded.parameters.memptr() + prevDst, channels,
+          inSize);
+      MakeAlias(bias, folded.parameters.memptr() + prevDst + channels * inSize,
+          channels, 1);
+      weight.each_col() %= scale;
+    }
+    else
+    {
+      // The block holds the filters of each output map contiguously, followed
+      // by the bias vector.
+      const size_t filterElems = (prevWeightSize - channels) / channels;
+      MakeAlias(bias,
+          folded.parameters.memptr() + prevDst + channels * filterElems,
+          channels, 1);
+      for (size_t j = 0; j < channels; ++j)
+      {
+        folded.parameters.rows(prevDst + j * filterElems,
+            prevDst + (j + 1) * filterElems - 1) *= scale[j];
+      }
+    }
+    bias = scale % bias + shift;
+
+    srcOffset += weightSize;
+  }
 }
 
 template<typename OutputLayerType,
@@ -300,6 +667,8 @@ void FFN<
            const size_t begin,
            const size_t end)
 {
+  util::ProfileRegion profile("ffn_forward");
+
   // Sanity checking...
   if (end < begin)
     return;
@@ -329,11 +698,13 @@ typename MatType::elem_type FFN<
             const MatType& targets,
             MatType& gradients)
 {
-  const typename MatType::elem_type res =
-      outputLayer.Forward(networkOutput, targets) + network.Loss();
+  util::ProfileRegion profile("ffn_backward");
 
-  // Compute the error of the output layer.
-  outputLayer.Backward(networkOutput, targets, error);
+  // Compute the loss and the error of the output layer, using the fused
+  // implementation of the loss function if it provides one.
+  const typename MatType::elem_type res =
+      LossForwardBackward(outputLayer, networkOutput, targets, error) +
+      network.Loss();
 
   // Perform the backward pass.
   network.Backward(networkOutput, error, networkDelta);
@@ -456,7 +827,7 @@ typename MatType::elem_type FFN<
   res += EvaluateWithGradient(parameters, 0, gradient, 1);
   for (size_t i = 1; i < predictors.n_cols; ++i)
   {
-    arma::mat tmpGradient(gradient.n_rows, gradient.n_cols);
+    MatType tmpGradient(gradient.n_rows, gradient.n_cols);
     res += EvaluateWithGradient(parameters, i, tmpGradient, 1);
     gradient += tmpGradient;
   }
@@ -484,12 +855,11 @@ typename MatType::elem_type FFN<
 
   network.Forward(predictors.cols(begin, begin + batchSize - 1), networkOutput);
 
-  const typename MatType::elem_type obj = outputLayer.Forward(networkOutput,
-      responses.cols(begin, begin + batchSize - 1)) + network.Loss();
-
-  // Now perform the backward pass.
-  outputLayer.Backward(networkOutput,
-      responses.cols(begin, begin + batchSize - 1), error);
+  // Compute the loss and the error of the output layer, using the fused
+  // implementation of the loss function if it provides one.
+  const typename MatType::elem_type obj = LossForwardBackward(outputLayer,
+      networkOutput, MatType(responses.cols(begin, begin + batchSize - 1)),
+      error) + network.Loss();
 
   // The delta should have the same size as the input.
   networkDelta.set_size(predictors.n_rows, batchSize);
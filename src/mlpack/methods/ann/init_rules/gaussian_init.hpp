@@ -53,7 +53,12 @@ class GaussianInitialization
     if (W.is_empty())
       W.set_size(rows, cols);
 
-    W.imbue( [&]() { return arma::as_scalar(mlpack::math::RandNormal(mean, variance)); } );
+    // Fill in parallel; the result is deterministic given the random seed,
+    // whatever the thread count (see math::FillRandom()).  Note that to match
+    // RandNormal(), `variance` is used to directly scale the unit-variance
+    // draws.
+    math::FillRandom(W.memptr(), W.n_elem,
+        std::normal_distribution<double>(mean, variance));
   }
 
   /**
@@ -67,7 +72,12 @@ class GaussianInitialization
     if (W.is_empty())
       Log::Fatal << "Cannot initialize an empty matrix." << std::endl;
 
-    W.imbue( [&]() { return arma::as_scalar(mlpack::math::RandNormal(mean, variance)); } );
+    // Fill in parallel; the result is deterministic given the random seed,
+    // whatever the thread count (see math::FillRandom()).  Note that to match
+    // RandNormal(), `variance` is used to directly scale the unit-variance
+    // draws.
+    math::FillRandom(W.memptr(), W.n_elem,
+        std::normal_distribution<double>(mean, variance));
   }
 
   /**
@@ -78,9 +78,10 @@ class LecunNormalInitialization
     if (W.is_empty())
       W.set_size(rows, cols);
 
-    // Multipling a random variable X with variance V(X) by some factor c,
-    // then the variance V(cX) = (c ^ 2) * V(X).
-    W.imbue( [&]() { return sqrt(variance) * arma::randn(); } );
+    // Fill in parallel; the result is deterministic given the random seed,
+    // whatever the thread count (see math::FillRandom()).
+    math::FillRandom(W.memptr(), W.n_elem,
+        std::normal_distribution<double>(0.0, sqrt(variance)));
   }
 
   /**
@@ -100,9 +101,10 @@ class LecunNormalInitialization
     if (W.is_empty())
       Log::Fatal << "Cannot initialize an empty matrix." << std::endl;
 
-    // Multipling a random variable X with variance V(X) by some factor c,
-    // then the variance V(cX) = (c ^ 2) * V(X).
-    W.imbue( [&]() { return sqrt(variance) * arma::randn(); } );
+    // Fill in parallel; the result is deterministic given the random seed,
+    // whatever the thread count (see math::FillRandom()).
+    math::FillRandom(W.memptr(), W.n_elem,
+        std::normal_distribution<double>(0.0, sqrt(variance)));
   }
 
   /**
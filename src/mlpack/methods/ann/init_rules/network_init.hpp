@@ -72,8 +72,8 @@ class NetworkInitialization
         // Initialize the layer with the specified parameter/weight
         // initialization rule.
         const size_t weight = network[i]->WeightSize();
-        arma::Mat<eT> tmp = arma::mat(parameters.memptr() + offset,
-            weight, 1, false, false);
+        arma::Mat<eT> tmp(parameters.memptr() + offset, weight, 1, false,
+            false);
         initializeRule.Initialize(tmp, tmp.n_elem, 1);
 
         // Increase the parameter/weight offset for the next layer.
@@ -84,6 +84,17 @@ class NetworkInitialization
     {
       initializeRule.Initialize(parameters, parameters.n_elem, 1);
     }
+
+    // Now allow any layer to overwrite the initialization rule's output for
+    // its weights (e.g. BatchNorm sets its scale parameters to 1).
+    for (size_t i = 0, offset = parameterOffset; i < network.size(); ++i)
+    {
+      const size_t weight = network[i]->WeightSize();
+      arma::Mat<eT> tmp(parameters.memptr() + offset, weight, 1, false, false);
+      network[i]->CustomInitialize(tmp, weight);
+
+      offset += weight;
+    }
   }
 
  private:
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_INIT_RULES_RANDOM_INIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -58,9 +59,10 @@ class RandomInitialization
     if (W.is_empty())
       W.set_size(rows, cols);
 
-    W.randu();
-    W *= (upperBound - lowerBound);
-    W += lowerBound;
+    // Fill in parallel; the result is deterministic given the random seed,
+    // whatever the thread count (see math::FillRandom()).
+    math::FillRandom(W.memptr(), W.n_elem,
+        std::uniform_real_distribution<double>(lowerBound, upperBound));
   }
 
   /**
@@ -74,9 +76,10 @@ class RandomInitialization
     if (W.is_empty())
       Log::Fatal << "Cannot initialize an empty matrix." << std::endl;
 
-    W.randu();
-    W *= (upperBound - lowerBound);
-    W += lowerBound;
+    // Fill in parallel; the result is deterministic given the random seed,
+    // whatever the thread count (see math::FillRandom()).
+    math::FillRandom(W.memptr(), W.n_elem,
+        std::uniform_real_distribution<double>(lowerBound, upperBound));
   }
 
   /**
@@ -109,6 +109,10 @@ class BaseLayer : public Layer<MatType>
     g = gy % derivative;
   }
 
+  //! The activation is elementwise, so it can be applied in place during
+  //! inference.
+  bool SupportsInPlaceForward() const { return true; }
+
   /**
    * Serialize the layer.
    */
@@ -0,0 +1,242 @@
+/**
+ * @file methods/ann/layer/batch_norm.hpp
+ * @author Praveen Ch
+ * @author Manthan-R-Sheth
+ * @author Kartik Dutt
+ *
+ * Definition of the Batch Normalization layer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_BATCHNORM_HPP
+#define MLPACK_METHODS_ANN_LAYER_BATCHNORM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Declaration of the Batch Normalization layer class. The layer transforms
+ * the input data into zero mean and unit variance and then scales and shifts
+ * the data by parameters, gamma and beta respectively. These parameters are
+ * learnt by the network.
+ *
+ * If the network is in training mode, the mean and variance over the batch is
+ * calculated and the data is normalized.  In prediction mode, the mean and
+ * variance accrued over the training set is used instead.
+ *
+ * The normalization is applied separately to each channel, where the number of
+ * channels is the last element of the input dimensions (so, for the flat
+ * output of a `Linear` layer every element is its own channel, and for the
+ * output of a `Convolution` layer each output map is a channel).
+ *
+ * For more information, refer to the following paper,
+ *
+ * @code
+ * @article{Ioffe15,
+ *   author    = {Sergey Ioffe and
+ *                Christian Szegedy},
+ *   title     = {Batch Normalization: Accelerating Deep Network Training by
+ *                Reducing Internal Covariate Shift},
+ *   journal   = {CoRR},
+ *   volume    = {abs/1502.03167},
+ *   year      = {2015},
+ *   url       = {http://arxiv.org/abs/1502.03167},
+ *   eprint    = {1502.03167},
+ * }
+ * @endcode
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class BatchNormType : public Layer<MatType>
+{
+ public:
+  /**
+   * Create the BatchNorm layer object.
+   *
+   * @param eps The epsilon added to variance to ensure numerical stability.
+   * @param average Boolean to determine whether cumulative average is used for
+   *                updating the parameters or momentum is used.
+   * @param momentum Parameter used to to update the running mean and variance.
+   */
+  BatchNormType(const double eps = 1e-8,
+                const bool average = true,
+                const double momentum = 0.1);
+
+  //! Clone the BatchNormType object. This handles polymorphism correctly.
+  BatchNormType* Clone() const { return new BatchNormType(*this); }
+
+  // Virtual destructor.
+  virtual ~BatchNormType() { }
+
+  //! Copy the other BatchNorm layer (but not weights).
+  BatchNormType(const BatchNormType& layer);
+  //! Take ownership of the members of the other BatchNorm layer (but not
+  //! weights).
+  BatchNormType(BatchNormType&& layer);
+  //! Copy the other BatchNorm layer (but not weights).
+  BatchNormType& operator=(const BatchNormType& layer);
+  //! Take ownership of the members of the other BatchNorm layer (but not
+  //! weights).
+  BatchNormType& operator=(BatchNormType&& layer);
+
+  /**
+   * Reset the layer parameters.
+   */
+  void SetWeights(typename MatType::elem_type* weightsPtr);
+
+  /**
+   * Initialize the weight matrix of the layer: the scale parameters (gamma)
+   * are set to 1, and the shift parameters (beta) are set to 0.
+   *
+   * @param W Weight matrix to initialize.
+   * @param elements Number of elements.
+   */
+  void CustomInitialize(MatType& W, const size_t elements);
+
+  /**
+   * Forward pass of the Batch Normalization layer. Transforms the input data
+   * into zero mean and unit variance, scales the data by a factor gamma and
+   * shifts it by beta.
+   *
+   * @param input Input data for the layer.
+   * @param output Resulting output activations.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Backward pass through the layer.
+   *
+   * @param input The input activations.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& input, const MatType& gy, MatType& g);
+
+  /**
+   * Calculate the gradient using the output delta and the input activations.
+   *
+   * @param input The input activations.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the mean over the training data.
+  const MatType& TrainingMean() const { return runningMean; }
+  //! Modify the mean over the training data.
+  MatType& TrainingMean() { return runningMean; }
+
+  //! Get the variance over the training data.
+  const MatType& TrainingVariance() const { return runningVariance; }
+  //! Modify the variance over the training data.
+  MatType& TrainingVariance() { return runningVariance; }
+
+  //! Get the number of input units / channels.
+  size_t InputSize() const { return size; }
+
+  //! Get the epsilon value.
+  double Epsilon() const { return eps; }
+
+  //! Get the momentum value.
+  double Momentum() const { return momentum; }
+
+  //! Get the average parameter.
+  bool Average() const { return average; }
+
+  //! Get size of weights.
+  size_t WeightSize() const { return 2 * size; }
+
+  /**
+   * Compute the output dimensions of the layer, assuming that inputDimensions
+   * has been set.  The output dimensions are the same as the input dimensions;
+   * the number of channels is taken to be the last input dimension.
+   */
+  void ComputeOutputDimensions();
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units / channels.
+  size_t size;
+
+  //! Locally-stored epsilon value.
+  double eps;
+
+  //! If true use average else use momentum for computing running mean
+  //! and variance.
+  bool average;
+
+  //! Locally-stored value for momentum.
+  double momentum;
+
+  //! Locally-stored running mean/variance counter.
+  size_t count;
+
+  //! Locally-stored value for average factor which is used to update running
+  //! mean and variance.
+  double averageFactor;
+
+  //! Locally-stored number of elements per channel in one input point.
+  size_t inputSize;
+
+  //! Locally-stored parameters (all of the weights; we store gamma and beta
+  //! as aliases into this).
+  MatType weights;
+
+  //! Locally-stored scale parameter.
+  MatType gamma;
+
+  //! Locally-stored shift parameter.
+  MatType beta;
+
+  //! Locally-stored mean object.
+  MatType mean;
+
+  //! Locally-stored variance object.
+  MatType variance;
+
+  //! Locally-stored mean object over the training data.
+  MatType runningMean;
+
+  //! Locally-stored variance object over the training data.
+  MatType runningVariance;
+
+  //! Locally-stored normalized input.
+  arma::Cube<typename MatType::elem_type> normalized;
+
+  //! Locally-stored zero mean input.
+  arma::Cube<typename MatType::elem_type> inputMean;
+}; // class BatchNormType
+
+// Convenience typedefs.
+
+// Standard BatchNorm layer.
+typedef BatchNormType<arma::mat> BatchNorm;
+
+} // namespace ann
+} // namespace mlpack
+
+// Include the implementation.
+#include "batch_norm_impl.hpp"
+
+#endif
@@ -210,6 +210,9 @@ class ConvolutionType : public Layer<MatType>
   //! Get the number of output maps.
   size_t const& Maps() const { return maps; }
 
+  //! Get whether a bias term is used.
+  bool const& UseBias() const { return useBias; }
+
   //! Get the kernel width.
   size_t const& KernelWidth() const { return kernelWidth; }
   //! Modify the kernel width.
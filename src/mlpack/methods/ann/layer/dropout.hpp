@@ -87,6 +87,10 @@ class DropoutType : public Layer<MatType>
    */
   void Backward(const MatType& /* input */, const MatType& gy, MatType& g);
 
+  //! Dropout is elementwise (and the identity during inference), so it can
+  //! be applied in place.
+  bool SupportsInPlaceForward() const { return true; }
+
   //! The probability of setting a value to zero.
   double Ratio() const { return ratio; }
 
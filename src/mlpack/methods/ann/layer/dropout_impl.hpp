@@ -81,7 +81,10 @@ void DropoutType<MatType>::Forward(const MatType& input, MatType& output)
   // The dropout mask will not be multiplied in testing mode.
   if (!this->training)
   {
-    output = input;
+    // If the output already aliases the input (the network fuses dropout in
+    // place during inference), there is nothing at all to do.
+    if (output.memptr() != input.memptr())
+      output = input;
   }
   else
   {
@@ -0,0 +1,191 @@
+/**
+ * @file methods/ann/layer/embedding.hpp
+ *
+ * Definition of the Embedding layer, a lookup table from token ids to dense
+ * embedding vectors with sparse gradient accumulation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_EMBEDDING_HPP
+#define MLPACK_METHODS_ANN_LAYER_EMBEDDING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the Embedding layer.  The layer holds a table of
+ * `vocabSize` embedding vectors of `embeddingSize` elements each, and maps
+ * token ids to their embedding vectors.
+ *
+ * Each input point is expected to be a vector of token ids in the range
+ * `[0, vocabSize)`; the output for a point is the concatenation of the
+ * embedding vectors of its tokens, in order.  This is mathematically
+ * equivalent to multiplying the embedding matrix with a one-hot (or k-hot)
+ * encoding of the tokens, but only the embedding vectors of the tokens that
+ * actually occur are touched: the forward pass gathers those columns of the
+ * table, and the gradient pass scatters the error back into only those
+ * columns.  For large vocabularies this avoids almost all of the work of a
+ * dense Linear layer on a sparse input.
+ *
+ * Regularization is applied lazily, in keeping with the sparse updates: only
+ * the embedding vectors of tokens in the current batch are regularized, with
+ * the decay they accumulated while untouched applied in one scaled step (see
+ * LRegularizer::LazyEvaluate()).
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ * @tparam RegularizerType Type of the regularizer to be used.  It must
+ *    provide a LazyEvaluate() method (NoRegularizer and the L-regularizers
+ *    do).
+ */
+template<
+    typename MatType = arma::mat,
+    typename RegularizerType = NoRegularizer
+>
+class EmbeddingType : public Layer<MatType>
+{
+ public:
+  //! Create the Embedding object.
+  EmbeddingType();
+
+  /**
+   * Create the Embedding layer object with the given vocabulary size and
+   * embedding dimension.
+   *
+   * @param vocabSize Number of embedding vectors in the table (i.e. the
+   *     number of distinct token ids).
+   * @param embeddingSize Dimension of each embedding vector.
+   * @param regularizer The regularizer to use, optional (default: no
+   *     regularizer).
+   */
+  EmbeddingType(const size_t vocabSize,
+                const size_t embeddingSize,
+                RegularizerType regularizer = RegularizerType());
+
+  virtual ~EmbeddingType() { }
+
+  //! Clone the EmbeddingType object. This handles polymorphism correctly.
+  EmbeddingType* Clone() const { return new EmbeddingType(*this); }
+
+  //! Copy the other Embedding layer (but not weights).
+  EmbeddingType(const EmbeddingType& layer);
+
+  //! Take ownership of the members of the other Embedding layer (but not
+  //! weights).
+  EmbeddingType(EmbeddingType&& layer);
+
+  //! Copy the other Embedding layer (but not weights).
+  EmbeddingType& operator=(const EmbeddingType& layer);
+
+  //! Take ownership of the members of the other Embedding layer (but not
+  //! weights).
+  EmbeddingType& operator=(EmbeddingType&& layer);
+
+  /**
+   * Reset the layer parameter (the embedding table).  The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(typename MatType::elem_type* weightsPtr);
+
+  /**
+   * Forward pass: gather the embedding vector of each token id in the input.
+   *
+   * @param input Matrix of token ids; each column is one point.
+   * @param output Resulting concatenated embedding vectors.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Backward pass.  Token ids are not differentiable, so the downstream
+   * gradient is zero.
+   *
+   * @param * (input) The propagated input activation.
+   * @param * (gy) The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* gy */,
+                MatType& g);
+
+  /**
+   * Scatter the error of each token back into the gradient of its embedding
+   * vector.  Only the embedding vectors of tokens that occur in the input are
+   * accumulated into.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the embedding table; each column is one embedding vector.
+  MatType const& Embedding() const { return embedding; }
+  //! Modify the embedding table.
+  MatType& Embedding() { return embedding; }
+
+  //! Get the number of embedding vectors in the table.
+  size_t VocabSize() const { return vocabSize; }
+  //! Get the dimension of each embedding vector.
+  size_t EmbeddingSize() const { return embeddingSize; }
+
+  //! Get the size of the weights.
+  size_t WeightSize() const { return vocabSize * embeddingSize; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of embedding vectors in the table.
+  size_t vocabSize;
+
+  //! Dimension of each embedding vector.
+  size_t embeddingSize;
+
+  //! Number of token ids in each input point; cached for convenience.
+  size_t inSize;
+
+  //! Locally-stored weight object.  This holds the whole embedding table in
+  //! vectorized form.
+  MatType weights;
+
+  //! Alias of `weights` shaped as the embedding table (one embedding vector
+  //! per column).
+  MatType embedding;
+
+  //! Locally-stored regularizer object.
+  RegularizerType regularizer;
+}; // class EmbeddingType
+
+// Convenience typedefs.
+
+// Standard Embedding layer.
+typedef EmbeddingType<arma::mat, NoRegularizer> Embedding;
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "embedding_impl.hpp"
+
+#endif
@@ -0,0 +1,210 @@
+/**
+ * @file methods/ann/layer/embedding_impl.hpp
+ *
+ * Implementation of the Embedding layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_EMBEDDING_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_EMBEDDING_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "embedding.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename MatType, typename RegularizerType>
+EmbeddingType<MatType, RegularizerType>::EmbeddingType() :
+    Layer<MatType>(),
+    vocabSize(0),
+    embeddingSize(0),
+    inSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType, typename RegularizerType>
+EmbeddingType<MatType, RegularizerType>::EmbeddingType(
+    const size_t vocabSize,
+    const size_t embeddingSize,
+    RegularizerType regularizer) :
+    Layer<MatType>(),
+    vocabSize(vocabSize),
+    embeddingSize(embeddingSize),
+    inSize(0), // This will be computed in ComputeOutputDimensions().
+    regularizer(std::move(regularizer))
+{
+  weights.set_size(WeightSize(), 1);
+}
+
+// Copy constructor.
+template<typename MatType, typename RegularizerType>
+EmbeddingType<MatType, RegularizerType>::EmbeddingType(
+    const EmbeddingType& layer) :
+    Layer<MatType>(layer),
+    vocabSize(layer.vocabSize),
+    embeddingSize(layer.embeddingSize),
+    inSize(layer.inSize),
+    regularizer(layer.regularizer)
+{
+  // Nothing else to do.
+}
+
+// Move constructor.
+template<typename MatType, typename RegularizerType>
+EmbeddingType<MatType, RegularizerType>::EmbeddingType(
+    EmbeddingType&& layer) :
+    Layer<MatType>(std::move(layer)),
+    vocabSize(std::move(layer.vocabSize)),
+    embeddingSize(std::move(layer.embeddingSize)),
+    inSize(std::move(layer.inSize)),
+    regularizer(std::move(layer.regularizer))
+{
+  // Nothing else to do.
+}
+
+template<typename MatType, typename RegularizerType>
+EmbeddingType<MatType, RegularizerType>&
+EmbeddingType<MatType, RegularizerType>::operator=(const EmbeddingType& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(layer);
+    vocabSize = layer.vocabSize;
+    embeddingSize = layer.embeddingSize;
+    inSize = layer.inSize;
+    regularizer = layer.regularizer;
+  }
+
+  return *this;
+}
+
+template<typename MatType, typename RegularizerType>
+EmbeddingType<MatType, RegularizerType>&
+EmbeddingType<MatType, RegularizerType>::operator=(EmbeddingType&& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(std::move(layer));
+    vocabSize = std::move(layer.vocabSize);
+    embeddingSize = std::move(layer.embeddingSize);
+    inSize = std::move(layer.inSize);
+    regularizer = std::move(layer.regularizer);
+  }
+
+  return *this;
+}
+
+template<typename MatType, typename RegularizerType>
+void EmbeddingType<MatType, RegularizerType>::SetWeights(
+    typename MatType::elem_type* weightsPtr)
+{
+  MakeAlias(weights, weightsPtr, vocabSize * embeddingSize, 1);
+  MakeAlias(embedding, weightsPtr, embeddingSize, vocabSize);
+}
+
+template<typename MatType, typename RegularizerType>
+void EmbeddingType<MatType, RegularizerType>::Forward(
+    const MatType& input, MatType& output)
+{
+  // Gather the embedding vector of each token; this touches only the columns
+  // of the table whose tokens actually occur.
+  for (size_t c = 0; c < input.n_cols; ++c)
+  {
+    for (size_t t = 0; t < inSize; ++t)
+    {
+      const size_t token = (size_t) input(t, c);
+      Log::Assert(token < vocabSize,
+          "EmbeddingType::Forward(): token id out of range!");
+
+      output.submat(t * embeddingSize, c, (t + 1) * embeddingSize - 1, c) =
+          embedding.col(token);
+    }
+  }
+}
+
+template<typename MatType, typename RegularizerType>
+void EmbeddingType<MatType, RegularizerType>::Backward(
+    const MatType& /* input */, const MatType& /* gy */, MatType& g)
+{
+  // Token ids are discrete, so there is no gradient to propagate downwards.
+  g.zeros();
+}
+
+template<typename MatType, typename RegularizerType>
+void EmbeddingType<MatType, RegularizerType>::Gradient(
+    const MatType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  // Scatter the error of each token into the gradient of its embedding
+  // vector.  The gradient is zero everywhere else, so only the embedding
+  // vectors of tokens that occur in the input are accumulated into.
+  gradient.zeros();
+  for (size_t c = 0; c < input.n_cols; ++c)
+  {
+    for (size_t t = 0; t < inSize; ++t)
+    {
+      const size_t token = (size_t) input(t, c);
+      Log::Assert(token < vocabSize,
+          "EmbeddingType::Gradient(): token id out of range!");
+
+      gradient.submat(token * embeddingSize, 0,
+          (token + 1) * embeddingSize - 1, 0) +=
+          error.submat(t * embeddingSize, c, (t + 1) * embeddingSize - 1, c);
+    }
+  }
+
+  // Regularize lazily, in keeping with the sparse updates: only the embedding
+  // vectors touched by this batch are regularized, with the decay they
+  // accumulated while untouched applied in one scaled step.
+  if (!std::is_same<RegularizerType, NoRegularizer>::value)
+  {
+    const arma::uvec tokens = arma::unique(
+        arma::conv_to<arma::uvec>::from(arma::vectorise(input)));
+
+    MatType gradientAlias;
+    MakeAlias(gradientAlias, gradient.memptr(), embeddingSize, vocabSize);
+    regularizer.LazyEvaluate(embedding, gradientAlias, tokens);
+  }
+}
+
+template<typename MatType, typename RegularizerType>
+void EmbeddingType<MatType, RegularizerType>::ComputeOutputDimensions()
+{
+  // Each element of the input is one token id.
+  inSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    inSize *= this->inputDimensions[i];
+
+  // The output is one embedding vector per token.
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+  this->outputDimensions[0] = embeddingSize;
+  if (this->outputDimensions.size() > 1)
+    this->outputDimensions[1] = inSize;
+  else if (inSize > 1)
+    this->outputDimensions.push_back(inSize);
+}
+
+template<typename MatType, typename RegularizerType>
+template<typename Archive>
+void EmbeddingType<MatType, RegularizerType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(vocabSize));
+  ar(CEREAL_NVP(embeddingSize));
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(regularizer));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -189,6 +189,22 @@ class Layer
    */
   virtual void SetWeights(typename MatType::elem_type* /* weightsPtr */) { }
 
+  /**
+   * Override the weight initialization performed by the network's
+   * initialization rule.  This is called once, just after the initialization
+   * rule has been applied to the layer's weights; by default it does nothing.
+   * Layers whose weights have a required starting value (e.g. the scale and
+   * shift parameters of BatchNorm, which should start at 1 and 0) should
+   * overwrite `W` here.
+   *
+   * @param W Weight matrix to initialize (an alias of the layer's portion of
+   *    the network's parameter matrix).
+   * @param elements Number of elements in `W` (this will be the same as
+   *    `WeightSize()`).
+   */
+  virtual void CustomInitialize(MatType& /* W */, const size_t /* elements */)
+  { }
+
   /**
    * Get the total number of trainable weights in the layer.
    */
@@ -218,6 +234,27 @@ class Layer
   //! to the loss function when computing the objective.  (TODO: better comment)
   virtual double Loss() { return 0; }
 
+  /**
+   * Get whether `Forward()` may be called with `output` aliasing the same
+   * memory as `input`.  Overload this to return `true` for layers whose
+   * forward pass is purely elementwise (e.g. activation functions): the
+   * network can then fuse such layers with their predecessor, writing their
+   * output directly over their input instead of streaming the activations
+   * through memory a second time.  Note that `Backward()` is never called
+   * with aliased memory, so this is only used during inference.
+   */
+  virtual bool SupportsInPlaceForward() const { return false; }
+
+  /**
+   * Pre-reserve any internally-held forward-pass memory for batches of up to
+   * the given size, so that later `Forward()` calls with smaller batches can
+   * be serviced from the reserved memory without touching the allocator.
+   * This is a no-op for layers that hold no forward-pass memory of their own;
+   * `MultiLayer` overrides it to size its activation arena (and to recurse
+   * into the layers it holds).
+   */
+  virtual void ReserveForwardPassMemory(const size_t /* maxBatchSize */) { }
+
   //! Get the input dimensions.
   const std::vector<size_t>& InputDimensions() const { return inputDimensions; }
   //! Modify the input dimensions.
@@ -99,22 +99,21 @@ template<typename MatType, typename RegularizerType>
 void Linear3DType<MatType, RegularizerType>::Forward(
     const MatType& input, MatType& output)
 {
-  typedef typename arma::Cube<typename MatType::elem_type> CubeType;
-
   const size_t nPoints = input.n_rows / this->inputDimensions[0];
   const size_t batchSize = input.n_cols;
 
-  const CubeType inputTemp(const_cast<MatType&>(input).memptr(),
-      this->inputDimensions[0], nPoints, batchSize, false, false);
-
-  for (size_t i = 0; i < batchSize; ++i)
-  {
-    // Shape of weight : (outSize, inSize).
-    // Shape of inputTemp : (inSize, nPoints, batchSize).
-    MatType z = weight * inputTemp.slice(i);
-    z.each_col() += bias;
-    output.col(i) = arma::vectorise(z);
-  }
+  // The weight is shared across time steps, and the (inSize * nPoints) x
+  // batchSize input is, in memory, exactly an inSize x (nPoints * batchSize)
+  // matrix, so all time steps of all points can go through a single GEMM
+  // instead of one small multiply per batch element.
+  const MatType inputTemp(const_cast<MatType&>(input).memptr(),
+      this->inputDimensions[0], nPoints * batchSize, false, false);
+  MatType outputTemp(output.memptr(), outSize, nPoints * batchSize, false,
+      false);
+
+  // Shape of weight : (outSize, inSize).
+  outputTemp = weight * inputTemp;
+  outputTemp.each_col() += bias;
 }
 
 template<typename MatType, typename RegularizerType>
@@ -123,8 +122,6 @@ void Linear3DType<MatType, RegularizerType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  typedef typename arma::Cube<typename MatType::elem_type> CubeType;
-
   if (gy.n_rows % outSize != 0)
   {
     Log::Fatal << "Number of rows in propagated error must be divisible by \
@@ -134,15 +131,15 @@ void Linear3DType<MatType, RegularizerType>::Backward(
   const size_t nPoints = gy.n_rows / outSize;
   const size_t batchSize = gy.n_cols;
 
-  const CubeType gyTemp(const_cast<MatType&>(gy).memptr(), outSize,
-      nPoints, batchSize, false, false);
+  // As in Forward(), flatten the time axis into the columns so that the
+  // whole backward pass is one GEMM.
+  const MatType gyTemp(const_cast<MatType&>(gy).memptr(), outSize,
+      nPoints * batchSize, false, false);
+  MatType gTemp(g.memptr(), this->inputDimensions[0], nPoints * batchSize,
+      false, false);
 
-  for (size_t i = 0; i < gyTemp.n_slices; ++i)
-  {
-    // Shape of weight : (outSize, inSize).
-    // Shape of gyTemp : (outSize, nPoints, batchSize).
-    g.col(i) = arma::vectorise(weight.t() * gyTemp.slice(i));
-  }
+  // Shape of weight : (outSize, inSize).
+  gTemp = weight.t() * gyTemp;
 }
 
 template<typename MatType, typename RegularizerType>
@@ -151,32 +148,25 @@ void Linear3DType<MatType, RegularizerType>::Gradient(
     const MatType& error,
     MatType& gradient)
 {
-  typedef typename arma::Cube<typename MatType::elem_type> CubeType;
-
   if (error.n_rows % outSize != 0)
     Log::Fatal << "Propagated error matrix has invalid dimension!" << std::endl;
 
   const size_t nPoints = input.n_rows / this->inputDimensions[0];
   const size_t batchSize = input.n_cols;
 
-  const CubeType inputTemp(const_cast<MatType&>(input).memptr(),
-      this->inputDimensions[0], nPoints, batchSize, false, false);
-  const CubeType errorTemp(const_cast<MatType&>(error).memptr(), outSize,
-      nPoints, batchSize, false, false);
-
-  CubeType dW(outSize, this->inputDimensions[0], batchSize);
-  for (size_t i = 0; i < batchSize; ++i)
-  {
-    // Shape of errorTemp : (outSize, nPoints, batchSize).
-    // Shape of inputTemp : (inSize, nPoints, batchSize).
-    dW.slice(i) = errorTemp.slice(i) * inputTemp.slice(i).t();
-  }
+  // With the time axis flattened into the columns, the sum of the per-slice
+  // outer products (error_i * input_i^T) is just one GEMM between the
+  // flattened matrices.
+  const MatType inputTemp(const_cast<MatType&>(input).memptr(),
+      this->inputDimensions[0], nPoints * batchSize, false, false);
+  const MatType errorTemp(const_cast<MatType&>(error).memptr(), outSize,
+      nPoints * batchSize, false, false);
 
   gradient.submat(0, 0, weight.n_elem - 1, 0)
-      = arma::vectorise(arma::sum(dW, 2));
+      = arma::vectorise(errorTemp * inputTemp.t());
 
   gradient.submat(weight.n_elem, 0, weights.n_elem - 1, 0)
-      = arma::vectorise(arma::sum(arma::sum(errorTemp, 2), 1));
+      = arma::sum(errorTemp, 1);
 
   regularizer.Evaluate(weights, gradient);
 }
@@ -205,19 +205,21 @@ class LSTMType : public RecurrentLayer<MatType>
   //! Weights between cell and output gate.
   MatType cell2GateOutputWeight;
 
-  // Below here are recurrent state matrices.
+  //! Concatenated copy of the four input-to-gate weights, rebuilt by
+  //! ClearRecurrentState() so that all gate pre-activations are one GEMM.
+  MatType input2AllWeight;
 
-  //! Locally-stored input gate parameter.
-  MatType inputGate;
+  //! Concatenated copy of the four output-to-gate weights; see
+  //! input2AllWeight.
+  MatType output2AllWeight;
 
-  //! Locally-stored forget gate parameter.
-  MatType forgetGate;
+  //! Concatenated copy of the four gate biases; see input2AllWeight.
+  MatType allBias;
 
-  //! Locally-stored hidden layer parameter.
-  MatType hiddenLayer;
+  // Below here are recurrent state matrices.
 
-  //! Locally-stored output gate parameter.
-  MatType outputGate;
+  //! Pre-activation values of all four gates ((4 * outSize) x batchSize).
+  MatType gatePreActivation;
 
   //! Locally-stored input to hidden weight.
   MatType input2HiddenWeight;
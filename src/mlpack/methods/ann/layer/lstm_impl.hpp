@@ -76,10 +76,7 @@ void LSTMType<MatType>::ClearRecurrentState(
 {
   // Make sure all of the different matrices we will use to hold parameters are
   // at least as large as we need.
-  inputGate.set_size(outSize, batchSize);
-  forgetGate.set_size(outSize, batchSize);
-  hiddenLayer.set_size(outSize, batchSize);
-  outputGate.set_size(outSize, batchSize);
+  gatePreActivation.set_size(4 * outSize, batchSize);
 
   inputGateActivation.set_size(outSize, batchSize, bpttSteps);
   forgetGateActivation.set_size(outSize, batchSize, bpttSteps);
@@ -91,6 +88,25 @@ void LSTMType<MatType>::ClearRecurrentState(
 
   // Now reset recurrent values to 0.
   cell.zeros(outSize, batchSize, bpttSteps);
+
+  // This method is called before each pass over a sequence, and the optimizer
+  // only updates the weights between passes, so this is the place to refresh
+  // the concatenated weight copies that Forward() uses.  (The per-gate aliases
+  // set by SetWeights() point into the network's parameter vector, where the
+  // four gates' weights are separated by the biases and thus cannot be viewed
+  // as one matrix.)
+  if (!input2GateOutputWeight.is_empty())
+  {
+    input2AllWeight = arma::join_cols(
+        arma::join_cols(input2GateOutputWeight, input2GateForgetWeight),
+        arma::join_cols(input2GateInputWeight, input2HiddenWeight));
+    output2AllWeight = arma::join_cols(
+        arma::join_cols(output2GateOutputWeight, output2GateForgetWeight),
+        arma::join_cols(output2GateInputWeight, output2HiddenWeight));
+    allBias = arma::join_cols(
+        arma::join_cols(input2GateOutputBias, input2GateForgetBias),
+        arma::join_cols(input2GateInputBias, input2HiddenBias));
+  }
 }
 
 template<typename MatType>
@@ -153,87 +169,79 @@ void LSTMType<MatType>::SetWeights(
 template<typename MatType>
 void LSTMType<MatType>::Forward(const MatType& input, MatType& output)
 {
+  typedef typename MatType::elem_type ElemType;
+
   // Convenience alias.
   const size_t batchSize = input.n_cols;
 
-  inputGate = input2GateInputWeight * input;
-  if (this->HasPreviousStep())
-  {
-    inputGate +=
-        output2GateInputWeight * outParameter.slice(this->PreviousStep());
-  }
-  inputGate.each_col() += input2GateInputBias;
-
-  forgetGate = input2GateForgetWeight * input;
-  if (this->HasPreviousStep())
-  {
-    forgetGate += output2GateForgetWeight * outParameter.slice(
-        this->PreviousStep());
-  }
-  forgetGate.each_col() += input2GateForgetBias;
-
-  if (this->HasPreviousStep())
-  {
-    inputGate += arma::repmat(cell2GateInputWeight, 1, batchSize) %
-        cell.slice(this->PreviousStep());
-
-    forgetGate += arma::repmat(cell2GateForgetWeight, 1, batchSize) %
-        cell.slice(this->PreviousStep());
-  }
-
-  inputGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + arma::exp(-inputGate));
-  forgetGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + arma::exp(-forgetGate));
-
-  hiddenLayer = input2HiddenWeight * input;
+  // One GEMM produces the pre-activations of all four gates at once: rows
+  // [0, outSize) hold the output gate, then the forget, input, and hidden
+  // gates follow (the order the weights appear in the parameter vector).
+  gatePreActivation = input2AllWeight * input;
   if (this->HasPreviousStep())
   {
-    hiddenLayer += output2HiddenWeight *
-        outParameter.slice(this->PreviousStep());
-  }
-  hiddenLayer.each_col() += input2HiddenBias;
-
-  hiddenLayerActivation.slice(this->CurrentStep()) = arma::tanh(hiddenLayer);
-
-  if (!this->HasPreviousStep())
-  {
-    cell.slice(this->CurrentStep()) =
-        inputGateActivation.slice(this->CurrentStep()) %
-        hiddenLayerActivation.slice(this->CurrentStep());
+    gatePreActivation +=
+        output2AllWeight * outParameter.slice(this->PreviousStep());
   }
-  else
+  gatePreActivation.each_col() += allBias;
+
+  // One elementwise sweep then applies the peephole connections, the gate
+  // nonlinearities, and the cell update.
+  const bool hasPrevious = this->HasPreviousStep();
+  const ElemType* cellPrev = hasPrevious ?
+      cell.slice_memptr(this->PreviousStep()) : NULL;
+  const ElemType* c2o = cell2GateOutputWeight.memptr();
+  const ElemType* c2f = cell2GateForgetWeight.memptr();
+  const ElemType* c2i = cell2GateInputWeight.memptr();
+
+  ElemType* iAct = inputGateActivation.slice_memptr(this->CurrentStep());
+  ElemType* fAct = forgetGateActivation.slice_memptr(this->CurrentStep());
+  ElemType* oAct = outputGateActivation.slice_memptr(this->CurrentStep());
+  ElemType* hAct = hiddenLayerActivation.slice_memptr(this->CurrentStep());
+  ElemType* cellCur = cell.slice_memptr(this->CurrentStep());
+  ElemType* cellAct = cellActivation.slice_memptr(this->CurrentStep());
+  ElemType* outParam = outParameter.slice_memptr(this->CurrentStep());
+
+  for (size_t c = 0; c < batchSize; ++c)
   {
-    cell.slice(this->CurrentStep()) =
-        forgetGateActivation.slice(this->CurrentStep()) %
-        cell.slice(this->PreviousStep()) +
-        inputGateActivation.slice(this->CurrentStep()) %
-        hiddenLayerActivation.slice(this->CurrentStep());
+    const ElemType* g = gatePreActivation.colptr(c);
+    const size_t offset = c * outSize;
+    for (size_t r = 0; r < outSize; ++r)
+    {
+      const ElemType cPrev = hasPrevious ?
+          cellPrev[offset + r] : ElemType(0);
+
+      ElemType f = g[outSize + r];
+      ElemType i = g[2 * outSize + r];
+      if (hasPrevious)
+      {
+        f += c2f[r] * cPrev;
+        i += c2i[r] * cPrev;
+      }
+
+      const ElemType fa = 1 / (1 + std::exp(-f));
+      const ElemType ia = 1 / (1 + std::exp(-i));
+      const ElemType ha = std::tanh(g[3 * outSize + r]);
+
+      const ElemType cNew = (hasPrevious ? fa * cPrev : ElemType(0)) +
+          ia * ha;
+      const ElemType oa = 1 / (1 + std::exp(-(g[r] + c2o[r] * cNew)));
+      const ElemType ca = std::tanh(cNew);
+
+      fAct[offset + r] = fa;
+      iAct[offset + r] = ia;
+      hAct[offset + r] = ha;
+      oAct[offset + r] = oa;
+      cellCur[offset + r] = cNew;
+      cellAct[offset + r] = ca;
+      outParam[offset + r] = ca * oa;
+    }
   }
 
-  outputGate = input2GateOutputWeight * input +
-      cell.slice(this->CurrentStep()).each_col() % cell2GateOutputWeight;
-  if (this->HasPreviousStep())
-  {
-    outputGate +=
-        output2GateOutputWeight * outParameter.slice(this->PreviousStep());
-  }
-  outputGate.each_col() += input2GateOutputBias;
-
-  outputGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + arma::exp(-outputGate));
-
-  cellActivation.slice(this->CurrentStep()) =
-      arma::tanh(cell.slice(this->CurrentStep()));
-
   // There's a bit of an issue here: we need to preserve the output for the next
   // time step, but we also need to set `output` to that.  Unfortunately for now
   // we make a copy, but it's possible that we could instead use an alias here,
   // or have `outParameter` hold a collection of aliases.
-  outParameter.slice(this->CurrentStep()) =
-      cellActivation.slice(this->CurrentStep()) %
-      outputGateActivation.slice(this->CurrentStep());
-
   output = outParameter.slice(this->CurrentStep());
 }
 
@@ -400,6 +408,10 @@ void LSTMType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
   // Clear recurrent state if we are loading.
   if (Archive::is_loading::value)
   {
+    input2AllWeight.clear();
+    output2AllWeight.clear();
+    allBias.clear();
+    gatePreActivation.clear();
     inputGateActivation.clear();
     forgetGateActivation.clear();
     outputGateActivation.clear();
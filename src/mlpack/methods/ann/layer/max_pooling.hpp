@@ -164,9 +164,51 @@ class MaxPoolingType : public Layer<MatType>
       arma::Cube<typename MatType::elem_type>& output,
       arma::Cube<size_t>& poolingIndices)
   {
-    // Iterate over all slices individually.
-    for (size_t s = 0; s < input.n_slices; ++s)
+    typedef typename MatType::elem_type ElemType;
+
+    // The max over a window factors into a max over its rows and then its
+    // columns, so each slice is swept twice instead of once per output cell:
+    // the first pass computes running window maxima down each (contiguous)
+    // input column, and the second combines them across column windows.
+    // Slices (channels x batch) are independent, so they are processed in
+    // parallel.
+    #pragma omp parallel for
+    for (omp_size_t s = 0; s < (omp_size_t) input.n_slices; ++s)
     {
+      MatType rowMax(output.n_rows, input.n_cols);
+      arma::Mat<size_t> rowArg(output.n_rows, input.n_cols);
+      for (size_t c = 0; c < input.n_cols; ++c)
+      {
+        const ElemType* col = input.slice(s).colptr(c);
+        for (size_t i = 0, rowidx = 0; i < output.n_rows;
+            ++i, rowidx += strideWidth)
+        {
+          size_t rowEnd = rowidx + kernelWidth - 1;
+          // Check if the kernel along row is out of bounds.
+          if (rowEnd > input.n_rows - 1)
+          {
+            // If so, we need to reduce the kernel width or terminate.
+            if (floor)
+              continue;
+            rowEnd = input.n_rows - 1;
+          }
+
+          ElemType best = col[rowidx];
+          size_t bestRow = rowidx;
+          for (size_t r = rowidx + 1; r <= rowEnd; ++r)
+          {
+            if (col[r] > best)
+            {
+              best = col[r];
+              bestRow = r;
+            }
+          }
+
+          rowMax(i, c) = best;
+          rowArg(i, c) = bestRow;
+        }
+      }
+
       for (size_t j = 0, colidx = 0; j < output.n_cols;
           ++j, colidx += strideHeight)
       {
@@ -179,36 +221,25 @@ class MaxPoolingType : public Layer<MatType>
             continue;
           colEnd = input.n_cols - 1;
         }
-        for (size_t i = 0, rowidx = 0; i < output.n_rows;
-            ++i, rowidx += strideWidth)
+
+        for (size_t i = 0; i < output.n_rows; ++i)
         {
-          size_t rowEnd = rowidx + kernelWidth - 1;
-          // Check if the kernel along row is out of bounds.
-          if (rowEnd > input.n_rows - 1)
+          ElemType best = rowMax(i, colidx);
+          size_t bestCol = colidx;
+          for (size_t c = colidx + 1; c <= colEnd; ++c)
           {
-            // If so, we need to reduce the kernel width or terminate.
-            if (floor)
-              continue;
-            rowEnd = input.n_rows - 1;
+            if (rowMax(i, c) > best)
+            {
+              best = rowMax(i, c);
+              bestCol = c;
+            }
           }
-          const std::tuple<size_t, typename MatType::elem_type> poolResult =
-              pooling.PoolingWithIndex(input.slice(s).submat(
-                  rowidx,
-                  colidx,
-                  rowEnd,
-                  colEnd));
-
-          // Now map the returned pooling index, which corresponds to the
-          // submatrix we gave, back to its position in the (linearized) input.
-          const size_t poolIndex = std::get<0>(poolResult);
-          const size_t poolingCol = poolIndex / (kernelWidth);
-          const size_t poolingRow = poolIndex % (kernelWidth);
-          const size_t unmappedPoolingIndex = (rowidx + poolingRow) +
-              input.n_rows * (colidx + poolingCol) +
-              input.n_rows * input.n_cols * s;
-
-          poolingIndices(i, j, s) = unmappedPoolingIndex;
-          output(i, j, s) = std::get<1>(poolResult);
+
+          output(i, j, s) = best;
+          // Map the winning cell back to its position in the (linearized)
+          // input.
+          poolingIndices(i, j, s) = rowArg(i, bestCol) +
+              input.n_rows * bestCol + input.n_rows * input.n_cols * s;
         }
       }
     }
@@ -225,21 +256,17 @@ class MaxPoolingType : public Layer<MatType>
       const arma::Cube<typename MatType::elem_type>& input,
       arma::Cube<typename MatType::elem_type>& output)
   {
-    // Iterate over all slices individually.
-    for (size_t s = 0; s < input.n_slices; ++s)
+    typedef typename MatType::elem_type ElemType;
+
+    // Same two-pass sweep as the index-tracking overload above, without the
+    // bookkeeping of the winning positions.
+    #pragma omp parallel for
+    for (omp_size_t s = 0; s < (omp_size_t) input.n_slices; ++s)
     {
-      for (size_t j = 0, colidx = 0; j < output.n_cols;
-          ++j, colidx += strideHeight)
+      MatType rowMax(output.n_rows, input.n_cols);
+      for (size_t c = 0; c < input.n_cols; ++c)
       {
-        size_t colEnd = colidx + kernelHeight - 1;
-        // Check if the kernel along column is out of bounds.
-        if (colEnd > input.n_cols - 1)
-        {
-          // If so, we need to reduce the kernel height or terminate.
-          if (floor)
-            continue;
-          colEnd = input.n_cols - 1;
-        }
+        const ElemType* col = input.slice(s).colptr(c);
         for (size_t i = 0, rowidx = 0; i < output.n_rows;
             ++i, rowidx += strideWidth)
         {
@@ -253,11 +280,34 @@ class MaxPoolingType : public Layer<MatType>
             rowEnd = input.n_rows - 1;
           }
 
-          output(i, j, s) = pooling.Pooling(input.slice(s).submat(
-              rowidx,
-              colidx,
-              rowEnd,
-              colEnd));
+          ElemType best = col[rowidx];
+          for (size_t r = rowidx + 1; r <= rowEnd; ++r)
+            best = std::max(best, col[r]);
+
+          rowMax(i, c) = best;
+        }
+      }
+
+      for (size_t j = 0, colidx = 0; j < output.n_cols;
+          ++j, colidx += strideHeight)
+      {
+        size_t colEnd = colidx + kernelHeight - 1;
+        // Check if the kernel along column is out of bounds.
+        if (colEnd > input.n_cols - 1)
+        {
+          // If so, we need to reduce the kernel height or terminate.
+          if (floor)
+            continue;
+          colEnd = input.n_cols - 1;
+        }
+
+        for (size_t i = 0; i < output.n_rows; ++i)
+        {
+          ElemType best = rowMax(i, colidx);
+          for (size_t c = colidx + 1; c <= colEnd; ++c)
+            best = std::max(best, rowMax(i, c));
+
+          output(i, j, s) = best;
         }
       }
     }
@@ -203,21 +203,22 @@ void MeanPoolingType<MatType>::PoolingOperation(
     const arma::Cube<typename MatType::elem_type>& input,
     arma::Cube<typename MatType::elem_type>& output)
 {
-  // Iterate over all slices individually.
-  for (size_t s = 0; s < input.n_slices; ++s)
+  typedef typename MatType::elem_type ElemType;
+
+  // The mean over a window factors into a sum over its rows and then its
+  // columns, so each slice is swept twice instead of once per output cell:
+  // the first pass accumulates row-window sums down each (contiguous) input
+  // column, and the second combines them across column windows and divides by
+  // the window area.  Slices (channels x batch) are independent, so they are
+  // processed in parallel.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) input.n_slices; ++s)
   {
-    for (size_t j = 0, colidx = 0; j < output.n_cols;
-        ++j, colidx += strideHeight)
+    MatType rowSum(output.n_rows, input.n_cols);
+    arma::Col<size_t> rowCount(output.n_rows, arma::fill::zeros);
+    for (size_t c = 0; c < input.n_cols; ++c)
     {
-      size_t colEnd = colidx + kernelHeight - 1;
-      // Check if the kernel along column is out of bounds.
-      if (colEnd > input.n_cols - 1)
-      {
-        // If so, we need to reduce the kernel height or terminate.
-        if (floor)
-          continue;
-        colEnd = input.n_cols - 1;
-      }
+      const ElemType* col = input.slice(s).colptr(c);
       for (size_t i = 0, rowidx = 0; i < output.n_rows;
           ++i, rowidx += strideWidth)
       {
@@ -230,11 +231,37 @@ void MeanPoolingType<MatType>::PoolingOperation(
             continue;
           rowEnd = input.n_rows - 1;
         }
-        output(i, j, s) = Pooling(input.slice(s).submat(
-            rowidx,
-            colidx,
-            rowEnd,
-            colEnd));
+
+        ElemType sum = ElemType(0);
+        for (size_t r = rowidx; r <= rowEnd; ++r)
+          sum += col[r];
+
+        rowSum(i, c) = sum;
+        rowCount[i] = rowEnd - rowidx + 1;
+      }
+    }
+
+    for (size_t j = 0, colidx = 0; j < output.n_cols;
+        ++j, colidx += strideHeight)
+    {
+      size_t colEnd = colidx + kernelHeight - 1;
+      // Check if the kernel along column is out of bounds.
+      if (colEnd > input.n_cols - 1)
+      {
+        // If so, we need to reduce the kernel height or terminate.
+        if (floor)
+          continue;
+        colEnd = input.n_cols - 1;
+      }
+
+      for (size_t i = 0; i < output.n_rows; ++i)
+      {
+        ElemType sum = ElemType(0);
+        for (size_t c = colidx; c <= colEnd; ++c)
+          sum += rowSum(i, c);
+
+        output(i, j, s) = sum /
+            (ElemType) (rowCount[i] * (colEnd - colidx + 1));
       }
     }
   }
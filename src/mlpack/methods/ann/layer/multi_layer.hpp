@@ -130,6 +130,12 @@ class MultiLayer : public Layer<MatType>
    */
   virtual void SetWeights(typename MatType::elem_type* weightsPtr);
 
+  /**
+   * Apply the custom initialization of each held layer to the corresponding
+   * portion of `W` (which should have `elements` total elements).
+   */
+  virtual void CustomInitialize(MatType& W, const size_t elements);
+
   /**
    * Return the number of weights in the MultiLayer.  This is the sum of the
    * number of weights in each layer.
@@ -184,6 +190,41 @@ class MultiLayer : public Layer<MatType>
   //! careful!
   std::vector<Layer<MatType>*>& Network() { return network; }
 
+  //! Get whether activation memory planning is enabled.
+  bool ActivationMemoryPlanning() const { return planActivationMemory; }
+  //! Modify whether activation memory planning is enabled.  When enabled and
+  //! the network is not in training mode, `Forward()` packs the intermediate
+  //! activations into a small reused arena (see
+  //! `InitializeInferencePassMemory()`).  Take care: `Backward()` and
+  //! `Gradient()` cannot be called after a `Forward()` pass that used planned
+  //! memory, since the intermediate activations will have been overwritten!
+  bool& ActivationMemoryPlanning() { return planActivationMemory; }
+
+  /**
+   * Pre-reserve the activation arena for batches of up to the given size, so
+   * that every later forward pass with a batch that fits the reservation is
+   * serviced by aliases into the already-held memory without touching the
+   * allocator.  The reservation also disables the shrink-on-small-batch
+   * heuristic of the pass memory initializers, so alternating batch sizes do
+   * not cause reallocation either.  Recurses into held layers that hold
+   * forward-pass memory of their own.
+   */
+  virtual void ReserveForwardPassMemory(const size_t maxBatchSize);
+
+  //! Get the gradient checkpointing interval (0 or 1 means checkpointing is
+  //! disabled).
+  size_t CheckpointInterval() const { return checkpointInterval; }
+  //! Modify the gradient checkpointing interval.  When set to some k > 1,
+  //! during training `Forward()` only keeps the activation of every k-th
+  //! layer; the activations in between are recomputed from the nearest
+  //! checkpoint when `Backward()` and `Gradient()` need them.  This reduces
+  //! the activation memory of a deep network by roughly a factor of k, at the
+  //! cost of up to two extra forward passes through the network.  Take care:
+  //! layers whose forward pass is stochastic or stateful (e.g. `Dropout` or
+  //! `BatchNorm`) will run their forward pass again during recomputation, so
+  //! they should not be used together with checkpointing.
+  size_t& CheckpointInterval() { return checkpointInterval; }
+
   //! Serialize the MultiLayer.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -198,6 +239,35 @@ class MultiLayer : public Layer<MatType>
    */
   void InitializeForwardPassMemory(const size_t batchSize);
 
+  /**
+   * Initialize memory for a forward pass whose intermediate activations are
+   * not needed once they have been consumed (i.e. inference).  During the
+   * forward pass each layer's output is read only by the layer directly after
+   * it, so the activations have short, non-overlapping lifetimes: instead of
+   * giving every layer its own region of `layerOutputMatrix`, this plans an
+   * offset for each activation into one arena, reusing the space of
+   * activations that are already dead.  Peak memory is then governed by the
+   * two largest adjacent activations instead of the sum of all of them.
+   * Elementwise layers (see `Layer::SupportsInPlaceForward()`) are fused with
+   * their predecessor: they are given their input's slot and write their
+   * output directly over it, generating no extra activation traffic.  Only
+   * used when `ActivationMemoryPlanning()` is enabled and the network is not
+   * in training mode.
+   */
+  void InitializeInferencePassMemory(const size_t batchSize);
+
+  /**
+   * Initialize memory for a forward pass with gradient checkpointing (see
+   * `CheckpointInterval()`).  Layers at multiples of the checkpoint interval
+   * are checkpoints and keep dedicated slots for the whole pass; the interior
+   * activations of each segment only need to live until the end of their
+   * segment, so all segments share one scratch region sized for the largest
+   * segment.  The interior activations are recomputed from the preceding
+   * checkpoint, one segment at a time, when `Backward()` and `Gradient()`
+   * need them.
+   */
+  void InitializeCheckpointPassMemory(const size_t batchSize);
+
   /**
    * Initialize memory that will be used by each layer for the backwards pass,
    * assuming that the input will have the given `batchSize`.  When `Backward()`
@@ -215,6 +285,14 @@ class MultiLayer : public Layer<MatType>
    */
   void InitializeGradientPassMemory(MatType& gradient);
 
+  /**
+   * Replace `layerOutputMatrix` with a freshly-allocated arena of the given
+   * number of elements, recording the change with the `MemoryTracker` so
+   * that allocation-free serving can be verified (see
+   * `ReserveForwardPassMemory()`).
+   */
+  void ResizeActivationArena(const size_t elems);
+
   //! The internally-held network.
   std::vector<Layer<MatType>*> network;
 
@@ -225,6 +303,24 @@ class MultiLayer : public Layer<MatType>
   // Total number of output elements for *every* layer.
   size_t totalOutputSize;
 
+  //! If true, Forward() packs the intermediate activations into a reused
+  //! arena when the network is not in training mode.  See
+  //! `InitializeInferencePassMemory()`.
+  bool planActivationMemory;
+  //! Planned arena offset (in elements per point) of each layer's output.
+  //! Only valid during a planned forward pass.
+  std::vector<size_t> activationOffsets;
+
+  //! If greater than 1, only every `checkpointInterval`-th layer's activation
+  //! is stored during training; the others are recomputed on demand.  See
+  //! `InitializeCheckpointPassMemory()`.
+  size_t checkpointInterval;
+
+  //! Number of elements of `layerOutputMatrix` that are reserved and must
+  //! never be released by the pass memory initializers (0 when no
+  //! reservation has been made).  See `ReserveForwardPassMemory()`.
+  size_t reservedActivationMemory;
+
   //! This matrix stores all of the outputs of each layer when Forward() is
   //! called.  See `InitializeForwardPassMemory()`.
   MatType layerOutputMatrix;
@@ -15,6 +15,8 @@
 
 #include "multi_layer.hpp"
 
+#include <mlpack/core/util/memory_tracker.hpp>
+
 namespace mlpack {
 namespace ann {
 
@@ -23,7 +25,10 @@ MultiLayer<MatType>::MultiLayer() :
     Layer<MatType>(),
     inSize(0),
     totalInputSize(0),
-    totalOutputSize(0)
+    totalOutputSize(0),
+    planActivationMemory(false),
+    checkpointInterval(0),
+    reservedActivationMemory(0)
 {
   // Nothing to do.
 }
@@ -34,6 +39,9 @@ MultiLayer<MatType>::MultiLayer(const MultiLayer& other) :
     inSize(other.inSize),
     totalInputSize(other.totalInputSize),
     totalOutputSize(other.totalOutputSize),
+    planActivationMemory(other.planActivationMemory),
+    checkpointInterval(other.checkpointInterval),
+    reservedActivationMemory(other.reservedActivationMemory),
     layerOutputMatrix(other.layerOutputMatrix),
     layerDeltaMatrix(other.layerDeltaMatrix)
 {
@@ -57,6 +65,9 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
     inSize(std::move(other.inSize)),
     totalInputSize(std::move(other.totalInputSize)),
     totalOutputSize(std::move(other.totalOutputSize)),
+    planActivationMemory(std::move(other.planActivationMemory)),
+    checkpointInterval(std::move(other.checkpointInterval)),
+    reservedActivationMemory(std::move(other.reservedActivationMemory)),
     layerOutputMatrix(std::move(other.layerOutputMatrix)),
     layerDeltaMatrix(std::move(other.layerDeltaMatrix))
 {
@@ -88,6 +99,9 @@ MultiLayer<MatType>& MultiLayer<MatType>::operator=(const MultiLayer& other)
     inSize = other.inSize;
     totalInputSize = other.totalInputSize;
     totalOutputSize = other.totalOutputSize;
+    planActivationMemory = other.planActivationMemory;
+    checkpointInterval = other.checkpointInterval;
+    reservedActivationMemory = other.reservedActivationMemory;
 
     layerOutputMatrix = other.layerOutputMatrix;
     layerDeltaMatrix = other.layerDeltaMatrix;
@@ -118,6 +132,9 @@ MultiLayer<MatType>& MultiLayer<MatType>::operator=(MultiLayer&& other)
     inSize = std::move(other.inSize);
     totalInputSize = std::move(other.totalInputSize);
     totalOutputSize = std::move(other.totalOutputSize);
+    planActivationMemory = std::move(other.planActivationMemory);
+    checkpointInterval = std::move(other.checkpointInterval);
+    reservedActivationMemory = std::move(other.reservedActivationMemory);
 
     network = std::move(other.network);
 
@@ -155,8 +172,16 @@ void MultiLayer<MatType>::Forward(
   // intermediate values between layers.
   if ((end - start) > 0)
   {
-    // Initialize memory for the forward pass (if needed).
-    InitializeForwardPassMemory(input.n_cols);
+    // Initialize memory for the forward pass (if needed).  If activation
+    // memory planning is enabled and we will not need the intermediate
+    // activations after the pass (i.e. no backward pass will follow), pack
+    // them into a reused arena instead of giving each layer its own space.
+    if (planActivationMemory && !this->training)
+      InitializeInferencePassMemory(input.n_cols);
+    else if (checkpointInterval > 1 && this->training)
+      InitializeCheckpointPassMemory(input.n_cols);
+    else
+      InitializeForwardPassMemory(input.n_cols);
 
     network[start]->Forward(input, layerOutputs[start]);
     for (size_t i = start + 1; i < end; ++i)
@@ -184,8 +209,47 @@ void MultiLayer<MatType>::Backward(
     InitializeBackwardPassMemory(input.n_cols);
 
     network.back()->Backward(input, gy, layerDeltas.back());
-    for (size_t i = network.size() - 2; i > 0; --i)
-      network[i]->Backward(layerOutputs[i], layerDeltas[i + 1], layerDeltas[i]);
+    if (checkpointInterval > 1 && this->training)
+    {
+      // Gradient checkpointing: only the activations of the checkpoint layers
+      // survived the forward pass, so walk backwards one segment at a time,
+      // recomputing the segment's interior activations from its checkpoint
+      // before backpropagating through it.
+      size_t i = network.size() - 2;
+      while (i > 0)
+      {
+        // Index of the checkpoint at or below layer i.
+        const size_t segStart = (i / checkpointInterval) * checkpointInterval;
+
+        // Recompute the activations of layers (segStart, i]; their scratch
+        // slots were reused by later segments during the forward pass.
+        for (size_t j = segStart + 1; j <= i; ++j)
+          network[j]->Forward(layerOutputs[j - 1], layerOutputs[j]);
+
+        // Backpropagate through the segment's interior layers...
+        for (; i > segStart; --i)
+        {
+          network[i]->Backward(layerOutputs[i], layerDeltas[i + 1],
+              layerDeltas[i]);
+        }
+
+        // ...and then through the checkpoint layer itself, whose activation
+        // is still stored.
+        if (i == 0)
+          break;
+        network[i]->Backward(layerOutputs[i], layerDeltas[i + 1],
+            layerDeltas[i]);
+        --i;
+      }
+    }
+    else
+    {
+      for (size_t i = network.size() - 2; i > 0; --i)
+      {
+        network[i]->Backward(layerOutputs[i], layerDeltas[i + 1],
+            layerDeltas[i]);
+      }
+    }
     network[0]->Backward(layerOutputs[0], layerDeltas[1], g);
   }
   else if (network.size() == 1)
@@ -212,10 +276,36 @@ void MultiLayer<MatType>::Gradient(
     InitializeGradientPassMemory(gradient);
 
     network.front()->Gradient(input, layerDeltas[1], layerGradients.front());
-    for (size_t i = 1; i < network.size() - 1; ++i)
+    if (checkpointInterval > 1 && this->training)
     {
-      network[i]->Gradient(layerOutputs[i - 1], layerDeltas[i + 1],
-          layerGradients[i]);
+      // Gradient checkpointing: recompute the interior activations of each
+      // segment from its checkpoint before computing the gradients of the
+      // layers that consume them.  (See Backward(); here we walk the segments
+      // in forward order, since each layer's gradient needs the activation of
+      // the layer before it.)
+      for (size_t c = 0; c < network.size() - 1; c += checkpointInterval)
+      {
+        const size_t top = std::min(c + checkpointInterval - 1,
+            network.size() - 2);
+        for (size_t j = c + 1; j <= top; ++j)
+          network[j]->Forward(layerOutputs[j - 1], layerOutputs[j]);
+
+        const size_t gradEnd = std::min(c + checkpointInterval,
+            network.size() - 2);
+        for (size_t i = c + 1; i <= gradEnd; ++i)
+        {
+          network[i]->Gradient(layerOutputs[i - 1], layerDeltas[i + 1],
+              layerGradients[i]);
+        }
+      }
+    }
+    else
+    {
+      for (size_t i = 1; i < network.size() - 1; ++i)
+      {
+        network[i]->Gradient(layerOutputs[i - 1], layerDeltas[i + 1],
+            layerGradients[i]);
+      }
     }
     network.back()->Gradient(layerOutputs[network.size() - 2], error,
         layerGradients.back());
@@ -256,6 +346,28 @@ void MultiLayer<MatType>::SetWeights(typename MatType::elem_type* weightsPtr)
       "size!");
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::CustomInitialize(MatType& W, const size_t elements)
+{
+  size_t start = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    const size_t weightSize = network[i]->WeightSize();
+
+    // Sanity check: ensure we aren't passing memory past the end of the
+    // parameters.
+    Log::Assert(start + weightSize <= elements,
+        "MultiLayer::CustomInitialize(): parameter size does not match total "
+        "layer weight size!");
+
+    MatType WTemp;
+    MakeAlias(WTemp, W.memptr() + start, weightSize, 1);
+    network[i]->CustomInitialize(WTemp, weightSize);
+
+    start += weightSize;
+  }
+}
+
 template<typename MatType>
 size_t MultiLayer<MatType>::WeightSize() const
 {
@@ -326,6 +438,7 @@ void MultiLayer<MatType>::serialize(
     layerOutputMatrix.clear();
     layerDeltaMatrix.clear();
     layerGradients.clear();
+    reservedActivationMemory = 0;
     layerOutputs.resize(network.size(), MatType());
     layerDeltas.resize(network.size(), MatType());
     layerGradients.resize(network.size(), MatType());
@@ -339,12 +452,13 @@ void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize)
   // call.  We'll do this all in one matrix, but, the size of this matrix
   // depends on the batch size we are using for computation.  We avoid resizing
   // layerOutputMatrix down, unless we only need 10% or less of it.
-  if (batchSize * totalOutputSize > layerOutputMatrix.n_elem ||
-      batchSize * totalOutputSize <
-          std::floor(0.1 * layerOutputMatrix.n_elem))
+  const size_t required = std::max(batchSize * totalOutputSize,
+      reservedActivationMemory);
+  if (required > layerOutputMatrix.n_elem ||
+      required < std::floor(0.1 * layerOutputMatrix.n_elem))
   {
     // All outputs will be represented by one big block of memory.
-    layerOutputMatrix = MatType(1, batchSize * totalOutputSize);
+    ResizeActivationArena(required);
   }
 
   // Now, create an alias to the right place for each layer.  We assume that
@@ -359,6 +473,146 @@ void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize)
   }
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::InitializeInferencePassMemory(const size_t batchSize)
+{
+  // First, plan an arena offset for each layer's output.  During the forward
+  // pass, layer i's output is read only by layer (i + 1), so when we place
+  // activation i we only need to avoid the (still live) activation (i - 1);
+  // the space of everything earlier can be reused.  We place each activation
+  // greedily at offset 0 when it fits below the previous activation, and
+  // directly after it otherwise, so the arena peaks at the two largest
+  // adjacent activations instead of the sum of all of them.  (Offsets are in
+  // elements per point; they are scaled by the batch size below.)
+  size_t arenaSize = 0;
+  size_t prevOffset = 0, prevSize = 0;
+  activationOffsets.resize(layerOutputs.size());
+  for (size_t i = 0; i < layerOutputs.size(); ++i)
+  {
+    const size_t layerOutputSize = network[i]->OutputSize();
+    size_t offset;
+    if (i > 0 && layerOutputSize == prevSize &&
+        network[i]->SupportsInPlaceForward())
+    {
+      // Fuse this elementwise layer with its predecessor: it writes its
+      // output directly over its input, so no extra activation traffic is
+      // generated for it at all.
+      offset = prevOffset;
+    }
+    else
+    {
+      offset = (layerOutputSize <= prevOffset) ? 0 : prevOffset + prevSize;
+    }
+
+    activationOffsets[i] = offset;
+    arenaSize = std::max(arenaSize, offset + layerOutputSize);
+    prevOffset = offset;
+    prevSize = layerOutputSize;
+  }
+
+  // Allocate the arena, following the same resizing policy as
+  // InitializeForwardPassMemory(): avoid resizing down unless we need 10% or
+  // less of the held memory.
+  const size_t required = std::max(batchSize * arenaSize,
+      reservedActivationMemory);
+  if (required > layerOutputMatrix.n_elem ||
+      required < std::floor(0.1 * layerOutputMatrix.n_elem))
+  {
+    ResizeActivationArena(required);
+  }
+
+  // Now, alias each layer's output to its planned slot in the arena.
+  for (size_t i = 0; i < layerOutputs.size(); ++i)
+  {
+    MakeAlias(layerOutputs[i],
+        layerOutputMatrix.colptr(batchSize * activationOffsets[i]),
+        network[i]->OutputSize(), batchSize);
+  }
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::InitializeCheckpointPassMemory(const size_t batchSize)
+{
+  // First, give every checkpoint layer (each `checkpointInterval`-th layer) a
+  // dedicated slot at the front of the arena; these activations are kept for
+  // the whole pass.
+  activationOffsets.resize(layerOutputs.size());
+  size_t checkpointSize = 0;
+  for (size_t i = 0; i < layerOutputs.size(); i += checkpointInterval)
+  {
+    activationOffsets[i] = checkpointSize;
+    checkpointSize += network[i]->OutputSize();
+  }
+
+  // The interior activations of a segment are only needed until the next
+  // checkpoint has been computed (they are recomputed from the checkpoint when
+  // Backward() and Gradient() need them), so all segments can share one
+  // scratch region, sized for the largest segment.  (Offsets are in elements
+  // per point; they are scaled by the batch size below.)
+  size_t scratchSize = 0, segmentOffset = 0;
+  for (size_t i = 0; i < layerOutputs.size(); ++i)
+  {
+    if (i % checkpointInterval == 0)
+    {
+      segmentOffset = 0; // Already placed in the checkpoint region.
+      continue;
+    }
+
+    activationOffsets[i] = checkpointSize + segmentOffset;
+    segmentOffset += network[i]->OutputSize();
+    scratchSize = std::max(scratchSize, segmentOffset);
+  }
+
+  // Allocate the arena, following the same resizing policy as
+  // InitializeForwardPassMemory(): avoid resizing down unless we need 10% or
+  // less of the held memory.
+  const size_t arenaSize = checkpointSize + scratchSize;
+  const size_t required = std::max(batchSize * arenaSize,
+      reservedActivationMemory);
+  if (required > layerOutputMatrix.n_elem ||
+      required < std::floor(0.1 * layerOutputMatrix.n_elem))
+  {
+    ResizeActivationArena(required);
+  }
+
+  // Now, alias each layer's output to its planned slot in the arena.
+  for (size_t i = 0; i < layerOutputs.size(); ++i)
+  {
+    MakeAlias(layerOutputs[i],
+        layerOutputMatrix.colptr(batchSize * activationOffsets[i]),
+        network[i]->OutputSize(), batchSize);
+  }
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::ReserveForwardPassMemory(const size_t maxBatchSize)
+{
+  // Reserve for the largest layout any pass initializer can ask for; the
+  // planned inference and checkpoint arenas are never larger than the plain
+  // forward-pass layout, so a reservation made before training still holds.
+  reservedActivationMemory = maxBatchSize * totalOutputSize;
+  if (layerOutputMatrix.n_elem < reservedActivationMemory)
+    ResizeActivationArena(reservedActivationMemory);
+
+  // Layers held by this network may hold forward-pass memory of their own
+  // (e.g. nested MultiLayers).
+  for (size_t i = 0; i < network.size(); ++i)
+    network[i]->ReserveForwardPassMemory(maxBatchSize);
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::ResizeActivationArena(const size_t elems)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Record the change with the MemoryTracker, so that steady-state serving
+  // can verify that no arena reallocation is happening.
+  util::MemoryTracker::RecordDeallocation(
+      layerOutputMatrix.n_elem * sizeof(ElemType));
+  layerOutputMatrix = MatType(1, elems);
+  util::MemoryTracker::RecordAllocation(elems * sizeof(ElemType));
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::InitializeBackwardPassMemory(
     const size_t batchSize)
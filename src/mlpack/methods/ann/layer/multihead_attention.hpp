@@ -0,0 +1,198 @@
+/**
+ * @file methods/ann/layer/multihead_attention.hpp
+ *
+ * Definition of the MultiheadAttention layer, a multi-head self-attention
+ * primitive whose forward and backward passes use tiled streaming softmax, so
+ * that the full L x L attention score matrix is never materialized.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_MULTIHEAD_ATTENTION_HPP
+#define MLPACK_METHODS_ANN_LAYER_MULTIHEAD_ATTENTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the MultiheadAttention layer, which performs scaled
+ * dot-product self-attention with multiple heads.  Each input point is
+ * expected to be a sequence: a matrix with `embedDim` rows and `seqLen`
+ * columns (vectorized into one column, as with `Linear3D`), where `embedDim`
+ * is the first input dimension and `seqLen` is the product of the remaining
+ * ones.  The layer learns query, key, value, and output projections, and its
+ * output has the same shape as its input.
+ *
+ * Both the forward and backward passes stream over the keys in blocks of
+ * `blockSize` columns, maintaining an online (running max and running sum)
+ * softmax: only the per-query log-sum-exp is stored between the passes, and
+ * the attention probabilities of a block are recomputed on the fly during
+ * backpropagation.  As a result the scratch memory is O(L * blockSize)
+ * instead of the O(L^2) required to materialize the score matrix, which is
+ * what makes long sequences feasible.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class MultiheadAttentionType : public Layer<MatType>
+{
+ public:
+  //! Create the MultiheadAttention object.
+  MultiheadAttentionType();
+
+  /**
+   * Create the MultiheadAttention layer object with the given number of
+   * attention heads.  The embedding dimension (the first input dimension)
+   * must be divisible by `numHeads`.
+   *
+   * @param numHeads Number of attention heads.
+   * @param blockSize Number of keys to process per tile of the streaming
+   *     softmax.  This only affects memory usage and performance, not the
+   *     result.
+   */
+  MultiheadAttentionType(const size_t numHeads, const size_t blockSize = 256);
+
+  virtual ~MultiheadAttentionType() { }
+
+  //! Clone the MultiheadAttentionType object.  This handles polymorphism
+  //! correctly.
+  MultiheadAttentionType* Clone() const
+  {
+    return new MultiheadAttentionType(*this);
+  }
+
+  //! Copy the other MultiheadAttention layer (but not weights).
+  MultiheadAttentionType(const MultiheadAttentionType& layer);
+
+  //! Take ownership of the members of the other MultiheadAttention layer (but
+  //! not weights).
+  MultiheadAttentionType(MultiheadAttentionType&& layer);
+
+  //! Copy the other MultiheadAttention layer (but not weights).
+  MultiheadAttentionType& operator=(const MultiheadAttentionType& layer);
+
+  //! Take ownership of the members of the other MultiheadAttention layer (but
+  //! not weights).
+  MultiheadAttentionType& operator=(MultiheadAttentionType&& layer);
+
+  /**
+   * Reset the layer parameters (the projection matrices and biases).  The
+   * method is called to assign the allocated memory to the internal learnable
+   * parameters.
+   */
+  void SetWeights(typename MatType::elem_type* weightsPtr);
+
+  /**
+   * Forward pass: project the input sequences to queries, keys, and values,
+   * apply streaming-softmax attention per head, and project the result back.
+   *
+   * @param input Input data; each column holds one vectorized sequence.
+   * @param output Resulting attended sequences.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Backward pass through the attention operation.  The attention
+   * probabilities are recomputed tile by tile from the cached projections and
+   * per-query log-sum-exp values, so this must be called right after
+   * `Forward()`.
+   *
+   * @param * (input) The propagated input activation.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient with respect to the input.
+   */
+  void Backward(const MatType& /* input */, const MatType& gy, MatType& g);
+
+  /**
+   * Compute the gradients of the projection matrices and biases.  This
+   * depends on intermediate results of `Backward()`, so it must be called
+   * right after it.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the number of attention heads.
+  size_t NumHeads() const { return numHeads; }
+
+  //! Get the number of keys processed per tile of the streaming softmax.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of keys processed per tile of the streaming softmax.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get the size of the weights.
+  size_t WeightSize() const
+  {
+    return 4 * (embedDim * embedDim + embedDim);
+  }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of attention heads.
+  size_t numHeads;
+
+  //! Number of keys processed per tile of the streaming softmax.
+  size_t blockSize;
+
+  //! Embedding dimension (first input dimension); cached for convenience.
+  size_t embedDim;
+
+  //! Sequence length (product of the remaining input dimensions); cached for
+  //! convenience.
+  size_t seqLen;
+
+  //! Locally-stored weight object.  This holds all four projections in
+  //! vectorized form.
+  MatType weights;
+
+  //! Aliases of `weights` for the query, key, value, and output projection
+  //! matrices and their biases.
+  MatType queryWeight, keyWeight, valueWeight, outWeight;
+  MatType queryBias, keyBias, valueBias, outBias;
+
+  //! Cached projections and per-query log-sum-exp values of the last forward
+  //! pass; one column per point.  These are only valid between `Forward()`
+  //! and the following `Backward()`/`Gradient()` calls.
+  MatType query, key, value, attention, logsumexp;
+
+  //! Deltas of the projections, computed by `Backward()` and consumed by
+  //! `Gradient()`.
+  MatType queryDelta, keyDelta, valueDelta;
+}; // class MultiheadAttentionType
+
+// Convenience typedefs.
+
+// Standard MultiheadAttention layer.
+typedef MultiheadAttentionType<arma::mat> MultiheadAttention;
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "multihead_attention_impl.hpp"
+
+#endif
@@ -0,0 +1,395 @@
+/**
+ * @file methods/ann/layer/multihead_attention_impl.hpp
+ *
+ * Implementation of the MultiheadAttention layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_MULTIHEAD_ATTENTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_MULTIHEAD_ATTENTION_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "multihead_attention.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename MatType>
+MultiheadAttentionType<MatType>::MultiheadAttentionType() :
+    Layer<MatType>(),
+    numHeads(1),
+    blockSize(256),
+    embedDim(0),
+    seqLen(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+MultiheadAttentionType<MatType>::MultiheadAttentionType(
+    const size_t numHeads,
+    const size_t blockSize) :
+    Layer<MatType>(),
+    numHeads(numHeads),
+    blockSize(std::max(blockSize, size_t(1))),
+    embedDim(0), // This will be computed in ComputeOutputDimensions().
+    seqLen(0)
+{
+  // Nothing to do here.
+}
+
+// Copy constructor.
+template<typename MatType>
+MultiheadAttentionType<MatType>::MultiheadAttentionType(
+    const MultiheadAttentionType& layer) :
+    Layer<MatType>(layer),
+    numHeads(layer.numHeads),
+    blockSize(layer.blockSize),
+    embedDim(layer.embedDim),
+    seqLen(layer.seqLen)
+{
+  // Nothing else to do.
+}
+
+// Move constructor.
+template<typename MatType>
+MultiheadAttentionType<MatType>::MultiheadAttentionType(
+    MultiheadAttentionType&& layer) :
+    Layer<MatType>(std::move(layer)),
+    numHeads(std::move(layer.numHeads)),
+    blockSize(std::move(layer.blockSize)),
+    embedDim(std::move(layer.embedDim)),
+    seqLen(std::move(layer.seqLen))
+{
+  // Nothing else to do.
+}
+
+template<typename MatType>
+MultiheadAttentionType<MatType>&
+MultiheadAttentionType<MatType>::operator=(const MultiheadAttentionType& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(layer);
+    numHeads = layer.numHeads;
+    blockSize = layer.blockSize;
+    embedDim = layer.embedDim;
+    seqLen = layer.seqLen;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+MultiheadAttentionType<MatType>&
+MultiheadAttentionType<MatType>::operator=(MultiheadAttentionType&& layer)
+{
+  if (&layer != this)
+  {
+    Layer<MatType>::operator=(std::move(layer));
+    numHeads = std::move(layer.numHeads);
+    blockSize = std::move(layer.blockSize);
+    embedDim = std::move(layer.embedDim);
+    seqLen = std::move(layer.seqLen);
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void MultiheadAttentionType<MatType>::SetWeights(
+    typename MatType::elem_type* weightsPtr)
+{
+  MakeAlias(weights, weightsPtr, WeightSize(), 1);
+
+  size_t offset = 0;
+  MakeAlias(queryWeight, weightsPtr + offset, embedDim, embedDim);
+  offset += embedDim * embedDim;
+  MakeAlias(queryBias, weightsPtr + offset, embedDim, 1);
+  offset += embedDim;
+
+  MakeAlias(keyWeight, weightsPtr + offset, embedDim, embedDim);
+  offset += embedDim * embedDim;
+  MakeAlias(keyBias, weightsPtr + offset, embedDim, 1);
+  offset += embedDim;
+
+  MakeAlias(valueWeight, weightsPtr + offset, embedDim, embedDim);
+  offset += embedDim * embedDim;
+  MakeAlias(valueBias, weightsPtr + offset, embedDim, 1);
+  offset += embedDim;
+
+  MakeAlias(outWeight, weightsPtr + offset, embedDim, embedDim);
+  offset += embedDim * embedDim;
+  MakeAlias(outBias, weightsPtr + offset, embedDim, 1);
+}
+
+template<typename MatType>
+void MultiheadAttentionType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t batchSize = input.n_cols;
+  const size_t headDim = embedDim / numHeads;
+  const ElemType scale = 1.0 / std::sqrt((ElemType) headDim);
+
+  // The projections, attended values, and per-query log-sum-exp values are
+  // kept for the backward pass; this is O(L) memory per point.
+  query.set_size(embedDim * seqLen, batchSize);
+  key.set_size(embedDim * seqLen, batchSize);
+  value.set_size(embedDim * seqLen, batchSize);
+  attention.set_size(embedDim * seqLen, batchSize);
+  logsumexp.set_size(numHeads * seqLen, batchSize);
+
+  MatType x, q, k, v, attn, out;
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    // Reshape this point into its sequence form, and compute the three input
+    // projections.
+    MakeAlias(x, (ElemType*) input.colptr(c), embedDim, seqLen);
+    MakeAlias(q, query.colptr(c), embedDim, seqLen);
+    MakeAlias(k, key.colptr(c), embedDim, seqLen);
+    MakeAlias(v, value.colptr(c), embedDim, seqLen);
+    MakeAlias(attn, attention.colptr(c), embedDim, seqLen);
+
+    q = queryWeight * x;
+    q.each_col() += queryBias;
+    k = keyWeight * x;
+    k.each_col() += keyBias;
+    v = valueWeight * x;
+    v.each_col() += valueBias;
+
+    for (size_t h = 0; h < numHeads; ++h)
+    {
+      const size_t r0 = h * headDim;
+      const size_t r1 = r0 + headDim - 1;
+      const MatType qh = q.rows(r0, r1) * scale;
+
+      // Stream over the keys in blocks, maintaining the running maximum `m`,
+      // running normalizer `l`, and unnormalized output `acc` of an online
+      // softmax for every query at once.  Only one (blockSize x seqLen) score
+      // tile is live at any time.
+      arma::Row<ElemType> m(seqLen);
+      m.fill(-std::numeric_limits<ElemType>::infinity());
+      arma::Row<ElemType> l(seqLen, arma::fill::zeros);
+      MatType acc(headDim, seqLen, arma::fill::zeros);
+
+      for (size_t b0 = 0; b0 < seqLen; b0 += blockSize)
+      {
+        const size_t b1 = std::min(b0 + blockSize, seqLen) - 1;
+
+        // s(j, i) is the scaled score of key (b0 + j) for query i.
+        MatType s = k.submat(r0, b0, r1, b1).t() * qh;
+
+        const arma::Row<ElemType> mNew = arma::max(m, arma::max(s, 0));
+        s.each_row() -= mNew;
+        s = arma::exp(s);
+
+        // Rescale the running statistics to the new maximum, then fold this
+        // block in.
+        const arma::Row<ElemType> correction = arma::exp(m - mNew);
+        l = l % correction + arma::sum(s, 0);
+        acc.each_row() %= correction;
+        acc += v.submat(r0, b0, r1, b1) * s;
+        m = mNew;
+      }
+
+      acc.each_row() /= l;
+      attn.rows(r0, r1) = acc;
+
+      // Store the log-sum-exp of each query's scores; the backward pass uses
+      // it to recompute the attention probabilities tile by tile.
+      logsumexp.submat(h * seqLen, c, (h + 1) * seqLen - 1, c) =
+          (m + arma::log(l)).t();
+    }
+
+    // Apply the output projection.
+    MakeAlias(out, output.colptr(c), embedDim, seqLen);
+    out = outWeight * attn;
+    out.each_col() += outBias;
+  }
+}
+
+template<typename MatType>
+void MultiheadAttentionType<MatType>::Backward(
+    const MatType& /* input */, const MatType& gy, MatType& g)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t batchSize = gy.n_cols;
+  const size_t headDim = embedDim / numHeads;
+  const ElemType scale = 1.0 / std::sqrt((ElemType) headDim);
+
+  // The projection deltas are consumed by Gradient().
+  queryDelta.set_size(embedDim * seqLen, batchSize);
+  keyDelta.set_size(embedDim * seqLen, batchSize);
+  valueDelta.set_size(embedDim * seqLen, batchSize);
+
+  MatType dy, q, k, v, attn, dq, dk, dv, gx;
+  MatType dAttn(embedDim, seqLen);
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    MakeAlias(dy, (ElemType*) gy.colptr(c), embedDim, seqLen);
+    MakeAlias(q, query.colptr(c), embedDim, seqLen);
+    MakeAlias(k, key.colptr(c), embedDim, seqLen);
+    MakeAlias(v, value.colptr(c), embedDim, seqLen);
+    MakeAlias(attn, attention.colptr(c), embedDim, seqLen);
+    MakeAlias(dq, queryDelta.colptr(c), embedDim, seqLen);
+    MakeAlias(dk, keyDelta.colptr(c), embedDim, seqLen);
+    MakeAlias(dv, valueDelta.colptr(c), embedDim, seqLen);
+
+    // Backpropagate through the output projection.
+    dAttn = outWeight.t() * dy;
+
+    for (size_t h = 0; h < numHeads; ++h)
+    {
+      const size_t r0 = h * headDim;
+      const size_t r1 = r0 + headDim - 1;
+      const MatType qh = q.rows(r0, r1) * scale;
+      const MatType dOh = dAttn.rows(r0, r1);
+
+      // For softmax outputs p and normalized attention output o_i, the score
+      // gradient is dS(j, i) = p(j, i) * (dp(j, i) - dot(do_i, o_i)); compute
+      // the per-query dot products once.
+      const arma::Row<ElemType> dDotO = arma::sum(dOh % attn.rows(r0, r1), 0);
+      const arma::Row<ElemType> lse = logsumexp.submat(
+          h * seqLen, c, (h + 1) * seqLen - 1, c).t();
+
+      MatType dQh(headDim, seqLen, arma::fill::zeros);
+      for (size_t b0 = 0; b0 < seqLen; b0 += blockSize)
+      {
+        const size_t b1 = std::min(b0 + blockSize, seqLen) - 1;
+
+        // Recompute this tile's attention probabilities from the cached
+        // log-sum-exp values.
+        MatType p = k.submat(r0, b0, r1, b1).t() * qh;
+        p.each_row() -= lse;
+        p = arma::exp(p);
+
+        dv.submat(r0, b0, r1, b1) = dOh * p.t();
+
+        MatType dp = v.submat(r0, b0, r1, b1).t() * dOh;
+        dp.each_row() -= dDotO;
+        dp %= p; // This is now the gradient of the scaled scores.
+
+        dQh += k.submat(r0, b0, r1, b1) * dp;
+        dk.submat(r0, b0, r1, b1) = qh * dp.t();
+      }
+
+      dq.rows(r0, r1) = dQh * scale;
+    }
+
+    // Backpropagate through the input projections.
+    MakeAlias(gx, g.colptr(c), embedDim, seqLen);
+    gx = queryWeight.t() * dq + keyWeight.t() * dk + valueWeight.t() * dv;
+  }
+}
+
+template<typename MatType>
+void MultiheadAttentionType<MatType>::Gradient(
+    const MatType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // This implementation depends on Gradient() being called just after
+  // Backward(), which is something we can safely assume.
+  const size_t batchSize = input.n_cols;
+
+  MatType dwq(embedDim, embedDim, arma::fill::zeros);
+  MatType dwk(embedDim, embedDim, arma::fill::zeros);
+  MatType dwv(embedDim, embedDim, arma::fill::zeros);
+  MatType dwo(embedDim, embedDim, arma::fill::zeros);
+  MatType dbq(embedDim, 1, arma::fill::zeros);
+  MatType dbk(embedDim, 1, arma::fill::zeros);
+  MatType dbv(embedDim, 1, arma::fill::zeros);
+  MatType dbo(embedDim, 1, arma::fill::zeros);
+
+  MatType x, dy, attn, dq, dk, dv;
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    MakeAlias(x, (ElemType*) input.colptr(c), embedDim, seqLen);
+    MakeAlias(dy, (ElemType*) error.colptr(c), embedDim, seqLen);
+    MakeAlias(attn, attention.colptr(c), embedDim, seqLen);
+    MakeAlias(dq, queryDelta.colptr(c), embedDim, seqLen);
+    MakeAlias(dk, keyDelta.colptr(c), embedDim, seqLen);
+    MakeAlias(dv, valueDelta.colptr(c), embedDim, seqLen);
+
+    dwq += dq * x.t();
+    dwk += dk * x.t();
+    dwv += dv * x.t();
+    dwo += dy * attn.t();
+    dbq += arma::sum(dq, 1);
+    dbk += arma::sum(dk, 1);
+    dbv += arma::sum(dv, 1);
+    dbo += arma::sum(dy, 1);
+  }
+
+  // The layout here must match SetWeights().
+  size_t offset = 0;
+  gradient.submat(offset, 0, offset + embedDim * embedDim - 1, 0) =
+      arma::vectorise(dwq);
+  offset += embedDim * embedDim;
+  gradient.submat(offset, 0, offset + embedDim - 1, 0) = dbq;
+  offset += embedDim;
+
+  gradient.submat(offset, 0, offset + embedDim * embedDim - 1, 0) =
+      arma::vectorise(dwk);
+  offset += embedDim * embedDim;
+  gradient.submat(offset, 0, offset + embedDim - 1, 0) = dbk;
+  offset += embedDim;
+
+  gradient.submat(offset, 0, offset + embedDim * embedDim - 1, 0) =
+      arma::vectorise(dwv);
+  offset += embedDim * embedDim;
+  gradient.submat(offset, 0, offset + embedDim - 1, 0) = dbv;
+  offset += embedDim;
+
+  gradient.submat(offset, 0, offset + embedDim * embedDim - 1, 0) =
+      arma::vectorise(dwo);
+  offset += embedDim * embedDim;
+  gradient.submat(offset, 0, offset + embedDim - 1, 0) = dbo;
+}
+
+template<typename MatType>
+void MultiheadAttentionType<MatType>::ComputeOutputDimensions()
+{
+  // The first input dimension is the embedding dimension; any remaining
+  // dimensions make up the sequence length.
+  embedDim = this->inputDimensions[0];
+  seqLen = 1;
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    seqLen *= this->inputDimensions[i];
+
+  if (numHeads == 0 || embedDim % numHeads != 0)
+  {
+    Log::Fatal << "MultiheadAttentionType::ComputeOutputDimensions(): "
+        << "embedding dimension (" << embedDim << ") must be divisible by the "
+        << "number of attention heads (" << numHeads << ")!" << std::endl;
+  }
+
+  // Attention does not change the shape of its input.
+  this->outputDimensions = this->inputDimensions;
+}
+
+template<typename MatType>
+template<typename Archive>
+void MultiheadAttentionType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(numHeads));
+  ar(CEREAL_NVP(blockSize));
+  ar(CEREAL_NVP(embedDim));
+  ar(CEREAL_NVP(seqLen));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -64,6 +64,23 @@ class BCELossType
                 const MatType& target,
                 MatType& loss);
 
+  /**
+   * Compute the cross-entropy loss and its gradient in a single fused pass.
+   * This is equivalent to calling Forward() followed by Backward(), but the
+   * epsilon-shifted prediction terms shared by both results are computed only
+   * once; the FFN class uses it during training when computing the objective
+   * and the gradient together.
+   *
+   * @param prediction Predictions used for evaluating the specified loss
+   *     function.
+   * @param target The target vector.
+   * @param gradient The calculated gradient of the loss with respect to the
+   *        predictions.
+   */
+  typename MatType::elem_type EvaluateWithGradient(const MatType& prediction,
+                                                   const MatType& target,
+                                                   MatType& gradient);
+
   //! Get the epsilon.
   double Eps() const { return eps; }
   //! Modify the epsilon.
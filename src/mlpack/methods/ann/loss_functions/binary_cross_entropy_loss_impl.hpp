@@ -53,6 +53,30 @@ void BCELossType<MatType>::Backward(
     loss /= target.n_elem;
 }
 
+template<typename MatType>
+typename MatType::elem_type BCELossType<MatType>::EvaluateWithGradient(
+    const MatType& prediction,
+    const MatType& target,
+    MatType& gradient)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Both the loss and its gradient use the epsilon-shifted predictions;
+  // compute them once and reuse them.
+  const MatType predEps = prediction + eps;
+  const MatType invPredEps = 1. - prediction + eps;
+
+  const ElemType lossSum = -arma::accu(target % arma::log(predEps) +
+      (1. - target) % arma::log(invPredEps));
+  gradient = (1. - target) / invPredEps - target / predEps;
+
+  if (reduction)
+    return lossSum;
+
+  gradient /= target.n_elem;
+  return lossSum / target.n_elem;
+}
+
 template<typename MatType>
 template<typename Archive>
 void BCELossType<MatType>::serialize(
@@ -61,6 +61,23 @@ class MeanSquaredErrorType
                 const MatType& target,
                 MatType& loss);
 
+  /**
+   * Compute the mean squared error and its gradient in a single fused pass.
+   * This is equivalent to calling Forward() followed by Backward(), but the
+   * prediction-target difference is computed only once and reused for both
+   * results; the FFN class uses it during training when computing the
+   * objective and the gradient together.
+   *
+   * @param prediction Predictions used for evaluating the specified loss
+   *     function.
+   * @param target The target vector.
+   * @param gradient The calculated gradient of the loss with respect to the
+   *        predictions.
+   */
+  typename MatType::elem_type EvaluateWithGradient(const MatType& prediction,
+                                                   const MatType& target,
+                                                   MatType& gradient);
+
   //! Get the reduction type, represented as boolean
   //! (false 'mean' reduction, true 'sum' reduction).
   bool Reduction() const { return reduction; }
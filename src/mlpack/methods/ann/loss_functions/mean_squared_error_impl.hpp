@@ -51,6 +51,26 @@ void MeanSquaredErrorType<MatType>::Backward(
     loss = loss / target.n_elem;
 }
 
+template<typename MatType>
+typename MatType::elem_type MeanSquaredErrorType<MatType>::EvaluateWithGradient(
+    const MatType& prediction,
+    const MatType& target,
+    MatType& gradient)
+{
+  // The difference is needed for both the loss and its gradient; compute it
+  // once and reuse it.
+  gradient = prediction - target;
+  const typename MatType::elem_type lossSum =
+      arma::accu(arma::square(gradient));
+  gradient *= 2;
+
+  if (reduction)
+    return lossSum;
+
+  gradient /= target.n_elem;
+  return lossSum / target.n_elem;
+}
+
 template<typename MatType>
 template<typename Archive>
 void MeanSquaredErrorType<MatType>::serialize(
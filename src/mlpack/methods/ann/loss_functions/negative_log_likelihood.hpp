@@ -68,6 +68,26 @@ class NegativeLogLikelihoodType
                 const MatType& target,
                 MatType& loss);
 
+  /**
+   * Compute the negative log likelihood and its gradient in a single fused
+   * pass over the predictions.  This is equivalent to calling Forward()
+   * followed by Backward(), but visits each target index only once; the FFN
+   * class uses it during training when computing the objective and the
+   * gradient together.  Note that when the network ends with a LogSoftMax
+   * layer, the one-hot gradient produced here combines with that layer's
+   * Backward() to give the usual softmax-minus-one-hot error in one sweep.
+   *
+   * @param prediction Predictions used for evaluating the specified loss
+   *     function.
+   * @param target The target vector, that contains the class index in the
+   *        range between 1 and the number of classes.
+   * @param gradient The calculated gradient of the loss with respect to the
+   *        predictions.
+   */
+  typename MatType::elem_type EvaluateWithGradient(const MatType& prediction,
+                                                   const MatType& target,
+                                                   MatType& gradient);
+
   //! Get the reduction type, represented as boolean
   //! (false 'mean' reduction, true 'sum' reduction).
   bool Reduction() const { return reduction; }
@@ -65,6 +65,33 @@ void NegativeLogLikelihoodType<MatType>::Backward(
     loss = loss / target.n_elem;
 }
 
+template<typename MatType>
+typename MatType::elem_type
+NegativeLogLikelihoodType<MatType>::EvaluateWithGradient(
+    const MatType& prediction,
+    const MatType& target,
+    MatType& gradient)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  gradient = arma::zeros<MatType>(prediction.n_rows, prediction.n_cols);
+  ElemType lossSum = 0;
+  for (size_t i = 0; i < prediction.n_cols; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < prediction.n_rows,
+        "Target class out of range.");
+
+    lossSum -= prediction(target(i), i);
+    gradient(target(i), i) = -1;
+  }
+
+  if (reduction)
+    return lossSum;
+
+  gradient /= target.n_elem;
+  return lossSum / target.n_elem;
+}
+
 template<typename MatType>
 template<typename Archive>
 void NegativeLogLikelihoodType<MatType>::serialize(
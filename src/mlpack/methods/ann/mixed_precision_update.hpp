@@ -0,0 +1,138 @@
+/**
+ * @file methods/ann/mixed_precision_update.hpp
+ *
+ * An ensmallen update policy wrapper that keeps a double-precision master
+ * copy of the parameters while the network itself trains in a lower
+ * precision.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_MIXED_PRECISION_UPDATE_HPP
+#define MLPACK_METHODS_ANN_MIXED_PRECISION_UPDATE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <ensmallen.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Mixed-precision update policy for ensmallen optimizers.
+ *
+ * When a network is trained in single precision (e.g.
+ * `FFN<..., ..., arma::fmat>`), the forward and backward passes run at half
+ * the memory bandwidth, but repeatedly adding small gradient steps to fp32
+ * weights loses the low-order bits of every update and can stall training.
+ * This policy wraps any other update policy and applies it to a
+ * double-precision master copy of the parameters; after every step the
+ * master copy is rounded back down into the network's own parameters.  The
+ * expensive per-point work stays in single precision, and only the O(number
+ * of weights) update runs in double.
+ *
+ * Use it by wrapping the update policy of the optimizer, for example:
+ *
+ * @code
+ * FFN<NegativeLogLikelihoodType<arma::fmat>, RandomInitialization,
+ *     arma::fmat> network;
+ * ...
+ * ens::SGD<MixedPrecisionUpdate<ens::MomentumUpdate>> opt;
+ * network.Train(trainData, trainLabels, opt);
+ * @endcode
+ *
+ * @tparam UpdatePolicyType The wrapped update policy; it is instantiated in
+ *     double precision.
+ */
+template<typename UpdatePolicyType = ens::VanillaUpdate>
+class MixedPrecisionUpdate
+{
+ public:
+  /**
+   * Construct the mixed-precision update policy, optionally around a
+   * configured instance of the policy to wrap.
+   *
+   * @param updatePolicy Update policy to apply to the master parameters.
+   */
+  MixedPrecisionUpdate(UpdatePolicyType updatePolicy = UpdatePolicyType()) :
+      updatePolicy(std::move(updatePolicy))
+  {
+    // Nothing to do.
+  }
+
+  //! Get the wrapped update policy.
+  const UpdatePolicyType& UpdatePolicy() const { return updatePolicy; }
+  //! Modify the wrapped update policy.
+  UpdatePolicyType& UpdatePolicy() { return updatePolicy; }
+
+  /**
+   * The instantiated update policy; this applies the wrapped policy to a
+   * double-precision master copy of the iterate.
+   *
+   * @tparam MatType The matrix type of the iterate.
+   * @tparam GradType The matrix type of the gradient.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    /**
+     * Instantiate the mixed-precision update policy.
+     *
+     * @param parent The instantiated parent class.
+     * @param rows The number of rows in the parameter matrix.
+     * @param cols The number of columns in the parameter matrix.
+     */
+    Policy(MixedPrecisionUpdate& parent, const size_t rows, const size_t cols)
+        : basePolicy(parent.UpdatePolicy(), rows, cols),
+          initialized(false)
+    {
+      // Nothing to do.
+    }
+
+    /**
+     * Apply the wrapped update policy to the double-precision master copy of
+     * the iterate, then round the master copy back into the iterate.
+     *
+     * @param iterate Parameters to be optimized.
+     * @param stepSize Step size to be used for this update.
+     * @param gradient The gradient for this step.
+     */
+    void Update(MatType& iterate,
+                const double stepSize,
+                const GradType& gradient)
+    {
+      // On the first step (or if the parameters were resized externally),
+      // pull the iterate up into the master copy.
+      if (!initialized || masterIterate.n_elem != iterate.n_elem)
+      {
+        masterIterate = arma::conv_to<arma::mat>::from(iterate);
+        initialized = true;
+      }
+
+      basePolicy.Update(masterIterate, stepSize,
+          arma::conv_to<arma::mat>::from(gradient));
+      iterate = arma::conv_to<MatType>::from(masterIterate);
+    }
+
+   private:
+    //! The instantiated wrapped policy, in double precision.
+    typename UpdatePolicyType::template Policy<arma::mat, arma::mat>
+        basePolicy;
+    //! Double-precision master copy of the parameters.
+    arma::mat masterIterate;
+    //! Whether the master copy has been initialized from the iterate.
+    bool initialized;
+  };
+
+ private:
+  //! The update policy to apply to the master parameters.
+  UpdatePolicyType updatePolicy;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
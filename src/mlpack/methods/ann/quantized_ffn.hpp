@@ -0,0 +1,141 @@
+/**
+ * @file methods/ann/quantized_ffn.hpp
+ *
+ * Definition of the QuantizedFFN class, a post-training int8-quantized view
+ * of a trained FFN for lower-memory, integer-arithmetic inference.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZED_FFN_HPP
+#define MLPACK_METHODS_ANN_QUANTIZED_FFN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "ffn.hpp"
+#include "layer/linear.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of a post-training int8-quantized feed forward network.
+ *
+ * A QuantizedFFN is built from a trained FFN and a matrix of calibration
+ * points.  Every Linear layer in the network is replaced by an int8 kernel:
+ * its weights are rounded to eight bits with one scale per output channel,
+ * and its input activations are quantized with a single scale calibrated
+ * from the range that the layer saw on the calibration data.  The matrix
+ * product is accumulated in 32-bit integers and dequantized before it is
+ * passed on; all other layers (activations, pooling, convolutions, and so
+ * forth) run in floating point, unchanged.
+ *
+ * The quantized weights occupy a quarter of the memory of the original
+ * single-precision weights (an eighth for double precision), and the integer
+ * matrix products can be dispatched to int8 hardware where Armadillo is
+ * backed by a BLAS that provides it.  Prediction accuracy depends on how
+ * representative the calibration data is of the data to be predicted; with
+ * reasonable calibration data the results typically match the float network
+ * to well under a percent.
+ *
+ * The QuantizedFFN is a read-only view for prediction: it cannot be trained
+ * further.  If the original FFN is retrained, build a new QuantizedFFN.
+ *
+ * @tparam OutputLayerType The output layer type of the quantized FFN.
+ * @tparam InitializationRuleType The initialization rule of the quantized
+ *     FFN.
+ * @tparam MatType The matrix type of the quantized FFN.
+ */
+template<
+    typename OutputLayerType = NegativeLogLikelihood,
+    typename InitializationRuleType = RandomInitialization,
+    typename MatType = arma::mat>
+class QuantizedFFN
+{
+ public:
+  //! The element type used for floating-point computation.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create an empty QuantizedFFN.  This is only useful if the network will
+   * subsequently be loaded with `data::Load()`.
+   */
+  QuantizedFFN();
+
+  /**
+   * Quantize the given trained network, calibrating the activation ranges of
+   * each quantized layer on the given calibration data.  The network itself
+   * is not modified.
+   *
+   * The calibration data should be representative of the data that will later
+   * be passed to `Predict()`; a random sample of a few hundred training
+   * points generally suffices.
+   *
+   * @param network Trained network to quantize.
+   * @param calibrationData Data to calibrate activation ranges with.
+   */
+  QuantizedFFN(
+      const FFN<OutputLayerType, InitializationRuleType, MatType>& network,
+      const MatType& calibrationData);
+
+  /**
+   * Predict the responses to a given set of predictors, using the quantized
+   * kernels for every quantized layer.  The responses will reflect the output
+   * of the final output layer.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Batch size to use for prediction.
+   */
+  void Predict(MatType predictors,
+               MatType& results,
+               const size_t batchSize = 128);
+
+  //! Get the number of layers that were quantized.
+  size_t NumQuantizedLayers() const { return quantizedWeights.size(); }
+
+  //! Get the int8 weights of the given quantized layer.
+  const arma::Mat<arma::s8>& QuantizedWeights(const size_t i) const
+  {
+    return quantizedWeights[i];
+  }
+
+  //! Serialize the quantized network.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Walk the layers of `network`, calibrating activation scales on the given
+   * data and quantizing the weights of every Linear layer.
+   */
+  void Quantize(const MatType& calibrationData);
+
+  //! A float copy of the quantized network; used for all non-quantized
+  //! layers and to hold the network structure.
+  FFN<OutputLayerType, InitializationRuleType, MatType> network;
+
+  //! For each layer of `network`, the index of its quantized kernel, or
+  //! `size_t(-1)` if the layer runs in floating point.
+  std::vector<size_t> layerKernels;
+
+  //! Int8 weights of each quantized layer.
+  std::vector<arma::Mat<arma::s8>> quantizedWeights;
+  //! Scale used to quantize the input of each quantized layer.
+  std::vector<ElemType> inputScales;
+  //! Per-output-channel dequantization scales of each quantized layer; these
+  //! already include the input scale.
+  std::vector<arma::Col<ElemType>> dequantScales;
+  //! Bias of each quantized layer (applied after dequantization).
+  std::vector<arma::Col<ElemType>> biases;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_ffn_impl.hpp"
+
+#endif
@@ -0,0 +1,196 @@
+/**
+ * @file methods/ann/quantized_ffn_impl.hpp
+ *
+ * Implementation of the QuantizedFFN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZED_FFN_IMPL_HPP
+#define MLPACK_METHODS_ANN_QUANTIZED_FFN_IMPL_HPP
+
+#include "quantized_ffn.hpp"
+
+namespace mlpack {
+namespace ann {
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+QuantizedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::QuantizedFFN()
+{
+  // Nothing to do here.
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+QuantizedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::QuantizedFFN(
+    const FFN<OutputLayerType, InitializationRuleType, MatType>& network,
+    const MatType& calibrationData) :
+    network(network)
+{
+  if (calibrationData.n_cols == 0)
+  {
+    Log::Fatal << "QuantizedFFN::QuantizedFFN(): cannot calibrate activation "
+        << "ranges with an empty calibration set!" << std::endl;
+  }
+
+  // Run a prediction on the calibration data first; this configures the
+  // copied network (computing layer dimensions and setting the layer weight
+  // aliases) and validates the dimensionality of the calibration data.
+  MatType unused;
+  this->network.Predict(calibrationData, unused);
+
+  Quantize(calibrationData);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void QuantizedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Quantize(const MatType& calibrationData)
+{
+  const std::vector<Layer<MatType>*>& layers = network.Network();
+  layerKernels.assign(layers.size(), size_t(-1));
+
+  // Propagate the calibration data through the network one layer at a time.
+  // At each Linear layer, the range of its input gives the activation scale,
+  // and its weights are rounded to eight bits with one scale per output
+  // channel (i.e. per row of the weight matrix), so that an unusually large
+  // channel cannot destroy the resolution of the others.
+  MatType current = calibrationData, next;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    LinearType<MatType, NoRegularizer>* linear =
+        dynamic_cast<LinearType<MatType, NoRegularizer>*>(layers[i]);
+    if (linear != NULL)
+    {
+      // A symmetric int8 quantizer maps [-r, r] to [-127, 127]; degenerate
+      // all-zero inputs or channels get a scale of 1 to avoid dividing by
+      // zero.
+      const ElemType maxAbs = arma::abs(current).max();
+      const ElemType inputScale = (maxAbs > 0) ? maxAbs / 127 : 1;
+
+      const MatType& w = linear->Weight();
+      arma::Col<ElemType> scales = arma::max(arma::abs(w), 1);
+      scales.transform(
+          [](ElemType v) { return (v > 0) ? v / 127 : ElemType(1); });
+
+      MatType scaled = w;
+      scaled.each_col() /= scales;
+
+      layerKernels[i] = quantizedWeights.size();
+      quantizedWeights.push_back(arma::conv_to<arma::Mat<arma::s8>>::from(
+          arma::clamp(arma::round(scaled), ElemType(-127), ElemType(127))));
+      inputScales.push_back(inputScale);
+      dequantScales.push_back(scales * inputScale);
+      biases.push_back(arma::vectorise(linear->Bias()));
+    }
+
+    // Compute the layer's output in floating point to calibrate the layers
+    // after it.
+    next.set_size(layers[i]->OutputSize(), current.n_cols);
+    layers[i]->Forward(current, next);
+    current = std::move(next);
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void QuantizedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Predict(MatType predictors, MatType& results, const size_t batchSize)
+{
+  // Ensure that the underlying float network is fully configured; if the
+  // model was just loaded from disk, this sets the layer dimensions and
+  // weight aliases (and it validates the dimensionality of the predictors).
+  MatType warmup(predictors.colptr(0), predictors.n_rows, 1, false, true);
+  MatType warmupResult;
+  network.Predict(warmup, warmupResult);
+
+  const std::vector<Layer<MatType>*>& layers = network.Network();
+  results.set_size(layers.back()->OutputSize(), predictors.n_cols);
+
+  // Widen the stored int8 weights to 32 bits once per call; the integer
+  // matrix products below accumulate in 32 bits so that they cannot
+  // overflow.
+  std::vector<arma::Mat<arma::s32>> wideWeights(quantizedWeights.size());
+  for (size_t k = 0; k < quantizedWeights.size(); ++k)
+    wideWeights[k] = arma::conv_to<arma::Mat<arma::s32>>::from(
+        quantizedWeights[k]);
+
+  MatType current, next;
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols) - i);
+
+    current = predictors.cols(i, i + effectiveBatchSize - 1);
+    for (size_t l = 0; l < layers.size(); ++l)
+    {
+      const size_t k = layerKernels[l];
+      if (k != size_t(-1))
+      {
+        // Quantize the input activations with the calibrated scale, multiply
+        // in integer arithmetic, and dequantize the accumulated result.
+        const arma::Mat<arma::s32> quantizedInput =
+            arma::conv_to<arma::Mat<arma::s32>>::from(arma::clamp(
+                arma::round(current / inputScales[k]),
+                ElemType(-127), ElemType(127)));
+
+        next = arma::conv_to<MatType>::from(wideWeights[k] * quantizedInput);
+        next.each_col() %= dequantScales[k];
+        next.each_col() += biases[k];
+      }
+      else
+      {
+        next.set_size(layers[l]->OutputSize(), current.n_cols);
+        layers[l]->Forward(current, next);
+      }
+
+      current = std::move(next);
+    }
+
+    results.cols(i, i + effectiveBatchSize - 1) = current;
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename Archive>
+void QuantizedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(network));
+  ar(CEREAL_NVP(layerKernels));
+  ar(CEREAL_NVP(quantizedWeights));
+  ar(CEREAL_NVP(inputScales));
+  ar(CEREAL_NVP(dequantScales));
+  ar(CEREAL_NVP(biases));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -44,6 +44,26 @@ class LRegularizer
   template<typename MatType>
   void Evaluate(const MatType& weight, MatType& gradient);
 
+  /**
+   * Lazily calculate the gradient for regularization, touching only the given
+   * columns of the weight matrix.  This is meant for layers with sparse
+   * updates (e.g. Embedding), where each step touches only a few columns of
+   * the weights: instead of regularizing the whole matrix every step, the
+   * regularization each column accumulated while it was untouched is applied
+   * in one scaled step the next time it is part of a batch.  The bookkeeping
+   * of when each column was last regularized is held by the regularizer
+   * itself, and is reset whenever the number of weight columns changes.
+   *
+   * @tparam MatType Type of weight matrix.
+   * @param weight The weight matrix to be regularized.
+   * @param gradient The calculated gradient (same shape as `weight`).
+   * @param cols The columns of `weight` touched by the current step.
+   */
+  template<typename MatType>
+  void LazyEvaluate(const MatType& weight,
+                    MatType& gradient,
+                    const arma::uvec& cols);
+
   //! Serialize the regularizer.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -53,6 +73,12 @@ class LRegularizer
 
   //! The constant for the regularization
   double factor;
+
+  //! The step each column was last regularized at (used by LazyEvaluate()).
+  arma::uvec lastStep;
+
+  //! The current lazy regularization step (used by LazyEvaluate()).
+  size_t currentStep;
 };
 
 // Convenience typedefs.
@@ -20,7 +20,8 @@ namespace ann {
 
 template<int Power>
 LRegularizer<Power>::LRegularizer(double factor) :
-    factor(factor)
+    factor(factor),
+    currentStep(0)
 {
   // Nothing to do here
 }
@@ -49,6 +50,76 @@ void LRegularizer<2>::Evaluate(const MatType& weight, MatType& gradient)
   gradient += arma::vectorise(2 * factor * weight);
 }
 
+// Unspecialized lazy implementation. This should almost never be used...
+template<int Power>
+template<typename MatType>
+void LRegularizer<Power>::LazyEvaluate(const MatType& weight,
+                                       MatType& gradient,
+                                       const arma::uvec& cols)
+{
+  if (lastStep.n_elem != weight.n_cols)
+  {
+    lastStep.zeros(weight.n_cols);
+    currentStep = 0;
+  }
+
+  ++currentStep;
+  for (size_t i = 0; i < cols.n_elem; ++i)
+  {
+    // Apply the regularization accumulated since this column was last
+    // touched in one scaled step.
+    const double skipped = currentStep - lastStep[cols[i]];
+    gradient.col(cols[i]) += skipped * Power * factor *
+        arma::pow(weight.col(cols[i]), Power - 1);
+    lastStep[cols[i]] = currentStep;
+  }
+}
+
+// L1-Regularizer specializations.
+template<>
+template<typename MatType>
+void LRegularizer<1>::LazyEvaluate(const MatType& weight,
+                                   MatType& gradient,
+                                   const arma::uvec& cols)
+{
+  if (lastStep.n_elem != weight.n_cols)
+  {
+    lastStep.zeros(weight.n_cols);
+    currentStep = 0;
+  }
+
+  ++currentStep;
+  for (size_t i = 0; i < cols.n_elem; ++i)
+  {
+    const double skipped = currentStep - lastStep[cols[i]];
+    gradient.col(cols[i]) += skipped * factor * weight.col(cols[i]) /
+        arma::abs(weight.col(cols[i]));
+    lastStep[cols[i]] = currentStep;
+  }
+}
+
+// L2-Regularizer specializations.
+template<>
+template<typename MatType>
+void LRegularizer<2>::LazyEvaluate(const MatType& weight,
+                                   MatType& gradient,
+                                   const arma::uvec& cols)
+{
+  if (lastStep.n_elem != weight.n_cols)
+  {
+    lastStep.zeros(weight.n_cols);
+    currentStep = 0;
+  }
+
+  ++currentStep;
+  for (size_t i = 0; i < cols.n_elem; ++i)
+  {
+    const double skipped = currentStep - lastStep[cols[i]];
+    gradient.col(cols[i]) += skipped * 2 * factor * weight.col(cols[i]);
+    lastStep[cols[i]] = currentStep;
+  }
+}
+
 template<int Power>
 template<typename Archive>
 void LRegularizer<Power>::serialize(
@@ -45,6 +45,22 @@ class NoRegularizer
     // Nothing to do here.
   }
 
+  /**
+   * Lazily calculate the gradient for regularization of the given columns.
+   *
+   * @tparam MatType Type of weight matrix.
+   * @param * (weight) The weight matrix to be regularized.
+   * @param * (gradient) The calculated gradient.
+   * @param * (cols) The columns touched by the current step.
+   */
+  template<typename MatType>
+  void LazyEvaluate(const MatType& /* weight */,
+                    MatType& /* gradient */,
+                    const arma::uvec& /* cols */)
+  {
+    // Nothing to do here.
+  }
+
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */)
   {
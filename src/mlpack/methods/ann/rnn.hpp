@@ -160,6 +160,59 @@ class RNN
       arma::Cube<typename MatType::elem_type> responses,
       CallbackTypes&&... callbacks);
 
+  /**
+   * Train the recurrent network on one window of a longer sequence stream,
+   * carrying the hidden state of every recurrent layer over from the previous
+   * window.  This implements truncated BPTT over arbitrarily long sequences:
+   * instead of materializing an entire sequence as one cube, feed it to
+   * successive calls of this function in fixed-size windows.  Gradients are
+   * truncated at the window boundary---the carried state is treated as a
+   * constant input to the window---but the forward pass sees the same state it
+   * would have seen on the full sequence.
+   *
+   * Every window of one stream must have the same number of sequences
+   * (columns) and time steps (slices); if the shape changes, the carried state
+   * is discarded and a fresh stream is started.  To start a new stream of the
+   * same shape (e.g. to make another pass over the data), call
+   * `ResetStreamingState()` first.
+   *
+   * The carried state is stored per-sequence, so the sequences cannot be
+   * reordered or subsampled during a window: the optimizer's batch size must
+   * be at least `predictors.n_cols`, and it must not compute the exact
+   * objective via `Evaluate()` (e.g. don't set `exactObjective`).  Pass the
+   * same optimizer object for every window so that its state (e.g. momentum)
+   * also carries across windows.
+   *
+   * Note that `Train()` and `Predict()` discard any carried state.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables for this window.
+   * @param responses Outputs results from input training variables for this
+   *      window.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective on this window (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type TrainWindow(
+      arma::Cube<typename MatType::elem_type> predictors,
+      arma::Cube<typename MatType::elem_type> responses,
+      OptimizerType& optimizer,
+      CallbackTypes&&... callbacks);
+
+  /**
+   * Forget any recurrent state carried over from previous calls to
+   * `TrainWindow()`, so that the next window starts a fresh stream.
+   */
+  void ResetStreamingState()
+  {
+    streamingSteps = 0;
+    streamingCols = 0;
+    streamingCarry = false;
+  }
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -365,6 +418,14 @@ class RNN
   //! response per time step.
   bool single;
 
+  //! Number of time steps per window when training with `TrainWindow()`; 0 if
+  //! no streaming window training is in progress.
+  size_t streamingSteps;
+  //! Number of sequences per window when training with `TrainWindow()`.
+  size_t streamingCols;
+  //! Whether recurrent state carried over from a previous window is available.
+  bool streamingCarry;
+
   //! The network itself is stored in this FFN object.  Note that this network
   //! may contain recursive layers, and thus we will be responsible for
   //! occasionally resetting any memory cells.
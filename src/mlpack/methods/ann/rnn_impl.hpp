@@ -35,6 +35,9 @@ RNN<
     InitializationRuleType initializeRule) :
     bpttSteps(bpttSteps),
     single(single),
+    streamingSteps(0),
+    streamingCols(0),
+    streamingCarry(false),
     network(std::move(outputLayer), std::move(initializeRule))
 {
   /* Nothing to do here */
@@ -53,6 +56,9 @@ RNN<
     const RNN& network) :
     bpttSteps(network.bpttSteps),
     single(network.single),
+    streamingSteps(network.streamingSteps),
+    streamingCols(network.streamingCols),
+    streamingCarry(network.streamingCarry),
     network(network.network)
 {
   // Nothing else to do.
@@ -71,6 +77,9 @@ RNN<
     RNN&& network) :
     bpttSteps(std::move(network.bpttSteps)),
     single(std::move(network.single)),
+    streamingSteps(std::move(network.streamingSteps)),
+    streamingCols(std::move(network.streamingCols)),
+    streamingCarry(std::move(network.streamingCarry)),
     network(std::move(network.network))
 {
   // Nothing to do here.
@@ -96,6 +105,9 @@ RNN<
   {
     bpttSteps = other.bpttSteps;
     single = other.single;
+    streamingSteps = other.streamingSteps;
+    streamingCols = other.streamingCols;
+    streamingCarry = other.streamingCarry;
     network = other.network;
     predictors.clear();
     responses.clear();
@@ -124,6 +136,9 @@ RNN<
   {
     bpttSteps = std::move(other.bpttSteps);
     single = std::move(other.single);
+    streamingSteps = std::move(other.streamingSteps);
+    streamingCols = std::move(other.streamingCols);
+    streamingCarry = std::move(other.streamingCarry);
     network = std::move(other.network);
     predictors.clear();
     responses.clear();
@@ -162,6 +177,10 @@ typename MatType::elem_type RNN<
     OptimizerType& optimizer,
     CallbackTypes&&... callbacks)
 {
+  // Training on full sequences is not streaming window training; any state
+  // carried over by TrainWindow() is meaningless now.
+  ResetStreamingState();
+
   ResetData(std::move(predictors), std::move(responses));
 
   network.WarnMessageMaxIterations(optimizer, this->predictors.n_cols);
@@ -200,6 +219,78 @@ typename MatType::elem_type RNN<
       callbacks...);
 }
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::TrainWindow(
+    arma::Cube<typename MatType::elem_type> predictors,
+    arma::Cube<typename MatType::elem_type> responses,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  ResetData(std::move(predictors), std::move(responses));
+
+  network.WarnMessageMaxIterations(optimizer, this->predictors.n_cols);
+
+  // Ensure that the network can be used.
+  network.CheckNetwork("RNN::TrainWindow()", this->predictors.n_rows, true,
+      true);
+
+  // The state carried over from the previous window is only valid if this
+  // window has the same shape.  If the shape changed (or this is the first
+  // window of a stream), allocate the recurrent state memory: one slot per
+  // BPTT step, plus one extra slot that holds the carried state.  The extra
+  // slot is never written by the gradient evaluations, so it stays valid for
+  // the entire window.
+  const size_t carrySlot = std::max(size_t(1),
+      std::min(bpttSteps, size_t(this->predictors.n_slices)));
+  if (this->predictors.n_slices != streamingSteps ||
+      this->predictors.n_cols != streamingCols)
+  {
+    streamingSteps = this->predictors.n_slices;
+    streamingCols = this->predictors.n_cols;
+    streamingCarry = false;
+    ResetMemoryState(carrySlot + 1, streamingCols);
+  }
+
+  // Train the model on this window.
+  Timer::Start("rnn_optimization");
+  const typename MatType::elem_type out =
+      optimizer.Optimize(*this, network.Parameters(), callbacks...);
+  Timer::Stop("rnn_optimization");
+
+  // Run one forward pass over the window with the final parameters, writing
+  // the state of the last time step into the carry slot, so that the next
+  // window continues from it.  The intermediate steps don't need to be kept,
+  // so they can all share one slot (as in Predict()).
+  SetPreviousStep(streamingCarry ? carrySlot : size_t(-1));
+  MatType stepData;
+  MatType output(network.network.OutputSize(), streamingCols);
+  for (size_t t = 0; t < this->predictors.n_slices; ++t)
+  {
+    const size_t slot = (t == this->predictors.n_slices - 1) ? carrySlot : 0;
+    SetCurrentStep(slot);
+
+    MakeAlias(stepData, this->predictors.slice(t).memptr(),
+        this->predictors.n_rows, streamingCols);
+    network.network.Forward(stepData, output);
+
+    SetPreviousStep(slot);
+  }
+  streamingCarry = true;
+
+  Log::Info << "RNN::TrainWindow(): final objective on this window is " << out
+      << "." << std::endl;
+  return out;
+}
+
 template<
     typename OutputLayerType,
     typename InitializationRuleType,
@@ -214,12 +305,21 @@ void RNN<
     arma::Cube<typename MatType::elem_type>& results,
     const size_t batchSize)
 {
+  // Prediction reuses (and thus destroys) the recurrent state memory, so any
+  // state carried between windows by TrainWindow() is lost.
+  ResetStreamingState();
+
   // Ensure that the network is configured correctly.
   network.CheckNetwork("RNN::Predict()", predictors.n_rows, true, false);
 
   results.set_size(network.network.OutputSize(), predictors.n_cols,
       predictors.n_slices);
 
+  // The intermediate activations are not needed once they have been consumed
+  // during prediction (any recurrent state is held by the layers themselves),
+  // so let the network pack them into a reused arena.
+  network.network.ActivationMemoryPlanning() = true;
+
   MatType inputAlias, outputAlias;
   for (size_t i = 0; i < predictors.n_cols; i += batchSize)
   {
@@ -249,6 +349,8 @@ void RNN<
       network.Forward(inputAlias, outputAlias);
     }
   }
+
+  network.network.ActivationMemoryPlanning() = false;
 }
 
 template<
@@ -301,6 +403,10 @@ void RNN<
     // middle of training and resume.
     predictors.clear();
     responses.clear();
+
+    // The recurrent state of the layers is not serialized either, so any
+    // streaming window training state is lost.
+    ResetStreamingState();
   }
 }
 
@@ -321,6 +427,15 @@ typename MatType::elem_type RNN<
   // Ensure the network is valid.
   network.CheckNetwork("RNN::Evaluate()", predictors.n_rows);
 
+  if (streamingSteps > 0)
+  {
+    // Evaluate() reuses the recurrent state memory, which would destroy the
+    // state carried between windows by TrainWindow().
+    Log::Fatal << "RNN::Evaluate(): cannot be used during streaming window "
+        << "training; use an optimizer that does not compute the exact "
+        << "objective!" << std::endl;
+  }
+
   // The core of the computation here is to pass through each step.  Since we
   // are not computing the gradient, we can be "clever" and use only one memory
   // cell---we don't need to know about the past.
@@ -392,8 +507,27 @@ typename MatType::elem_type RNN<
   const size_t effectiveBPTTSteps = std::max(size_t(1),
       std::min(bpttSteps, size_t(predictors.n_slices)));
 
-  ResetMemoryState(effectiveBPTTSteps, batchSize);
-  SetPreviousStep(size_t(-1));
+  if (streamingSteps > 0)
+  {
+    // Streaming window training (see TrainWindow()): the recurrent state
+    // memory was allocated by TrainWindow() with one extra slot holding the
+    // state carried over from the previous window, so we must not reallocate
+    // it here; and reordering or subsetting the sequences would misalign them
+    // with the carried state, so only full-batch evaluations are possible.
+    if (begin != 0 || batchSize != predictors.n_cols)
+    {
+      Log::Fatal << "RNN::EvaluateWithGradient(): streaming window training "
+          << "requires an optimizer batch size of at least the number of "
+          << "sequences (" << predictors.n_cols << ")!" << std::endl;
+    }
+
+    SetPreviousStep(streamingCarry ? effectiveBPTTSteps : size_t(-1));
+  }
+  else
+  {
+    ResetMemoryState(effectiveBPTTSteps, batchSize);
+    SetPreviousStep(size_t(-1));
+  }
   arma::Cube<typename MatType::elem_type> outputs(
       network.network.OutputSize(), batchSize, effectiveBPTTSteps);
 
@@ -528,6 +662,11 @@ void RNN<
     MatType
 >::Shuffle()
 {
+  // During streaming window training the carried recurrent state is stored
+  // per-sequence, so the sequences cannot be reordered.
+  if (streamingSteps > 0)
+    return;
+
   math::ShuffleData(predictors, responses, predictors, responses);
 }
 
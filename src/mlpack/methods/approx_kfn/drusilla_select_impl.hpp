@@ -16,9 +16,7 @@
 #include "drusilla_select.hpp"
 
 #include <queue>
-#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
-#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
-#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 #include <algorithm>
 
 namespace mlpack {
@@ -179,23 +177,69 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  metric::EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
-      tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  // Score the queries against the candidate set in blocked panels: each panel
+  // of distances is one GEMM-backed bulk evaluation instead of a scalar
+  // evaluation per (query, candidate) pair, and the refinement of each panel
+  // to the k furthest candidates is done in parallel over the query points.
+  metric::EuclideanDistance distMetric;
+  const size_t blockSize = std::max((size_t) 1,
+      (size_t) (1 << 20) / candidateSet.n_cols);
 
-  rules.GetResults(neighbors, distances);
+  typedef std::pair<double, size_t> Candidate;
+  struct CandidateCmp
+  {
+    bool operator()(const Candidate& c1, const Candidate& c2)
+    {
+      return c2.first < c1.first;
+    }
+  };
+  typedef std::priority_queue<Candidate, std::vector<Candidate>,
+      CandidateCmp> CandidateList;
+
+  arma::mat distPanel;
+  for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+  {
+    const size_t blockCols = std::min(blockSize, querySet.n_cols - begin);
+    const MatType queryBlock = querySet.cols(begin, begin + blockCols - 1);
+    mlpack::metric::PairwiseDistances(candidateSet, queryBlock, distPanel,
+        distMetric);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) blockCols; ++i)
+    {
+      const size_t q = begin + i;
+
+      // Keep the k furthest candidates; the top of the queue is the nearest
+      // of the ones we have kept.
+      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+      std::vector<Candidate> cList(k, def);
+      CandidateList pqueue(CandidateCmp(), std::move(cList));
 
-  // Map the neighbors back to their original indices in the reference set.
-  for (size_t i = 0; i < neighbors.n_elem; ++i)
-    neighbors[i] = candidateIndices[neighbors[i]];
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+      {
+        const double dist = distPanel(r, i);
+
+        if (dist > pqueue.top().first)
+        {
+          Candidate c = std::make_pair(dist, r);
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
+
+      // Extract the results in descending order of distance, mapping the
+      // candidates back to their original indices in the reference set.
+      for (size_t j = 1; j <= k; ++j)
+      {
+        neighbors(k - j, q) = candidateIndices[pqueue.top().second];
+        distances(k - j, q) = pqueue.top().first;
+        pqueue.pop();
+      }
+    }
+  }
 }
 
 //! Serialize the model.
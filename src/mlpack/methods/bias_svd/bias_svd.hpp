@@ -18,6 +18,8 @@
 #include <ensmallen.hpp>
 #include <mlpack/methods/cf/cf.hpp>
 
+#include <mlpack/methods/regularized_svd/sharded_sgd.hpp>
+
 #include "bias_svd_function.hpp"
 
 namespace mlpack {
@@ -86,6 +88,31 @@ class BiasSVD
              arma::vec& p,
              arma::vec& q);
 
+  /**
+   * Trains the model, optionally starting the optimization from the factors
+   * and biases of a previous decomposition.  If warmStart is set but the
+   * passed factors do not match the rank and the numbers of users and items
+   * in the data (e.g. on the very first fit), random initialization is used
+   * instead.  Training uses parallel sharded SGD over disjoint user blocks
+   * (ShardedSGD), so repeated refits on slightly changed data converge much
+   * faster than training from scratch.
+   *
+   * @param data Rating data matrix.
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix: starting point and output of decomposition.
+   * @param v User matrix: starting point and output of decomposition.
+   * @param p Item bias: starting point and output of decomposition.
+   * @param q User bias: starting point and output of decomposition.
+   * @param warmStart If true, start the optimization from the passed factors.
+   */
+  void Apply(const arma::mat& data,
+             const size_t rank,
+             arma::mat& u,
+             arma::mat& v,
+             arma::vec& p,
+             arma::vec& q,
+             const bool warmStart);
+
  private:
   //! Number of optimization iterations.
   size_t iterations;
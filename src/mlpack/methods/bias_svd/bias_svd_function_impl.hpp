@@ -178,6 +178,47 @@ void BiasSVDFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void BiasSVDFunction<MatType>::ShardedUpdate(arma::mat& parameters,
+                                             const size_t index,
+                                             const double stepSize) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, index);
+  const size_t item = data(1, index) + numUsers;
+
+  // Prediction error for the example.
+  const double rating = data(2, index);
+  const double userBias = parameters(rank, user);
+  const double itemBias = parameters(rank, item);
+  double ratingError = rating - userBias - itemBias -
+      arma::dot(parameters.col(user).subvec(0, rank - 1),
+                parameters.col(item).subvec(0, rank - 1));
+
+  const arma::vec itemVecUpdate = stepSize * 2 * (
+      lambda * parameters.col(item).subvec(0, rank - 1) -
+      ratingError * parameters.col(user).subvec(0, rank - 1));
+  const double itemBiasUpdate = stepSize * 2 * (
+      lambda * parameters(rank, item) - ratingError);
+
+  // The caller guarantees exclusive access to the user's column, so it can be
+  // written directly.
+  parameters.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
+      lambda * parameters.col(user).subvec(0, rank - 1) -
+      ratingError * parameters.col(item).subvec(0, rank - 1));
+  parameters(rank, user) -= stepSize * 2 * (
+      lambda * parameters(rank, user) - ratingError);
+
+  // The item column may be shared with other shards.
+  for (size_t j = 0; j < rank; ++j)
+  {
+    #pragma omp atomic
+    parameters(j, item) -= itemVecUpdate(j);
+  }
+  #pragma omp atomic
+  parameters(rank, item) -= itemBiasUpdate;
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -63,6 +63,57 @@ void BiasSVD<OptimizerType>::Apply(const arma::mat& data,
   q = parameters.row(rank).subvec(0, numUsers - 1).t();
 }
 
+template<typename OptimizerType>
+void BiasSVD<OptimizerType>::Apply(const arma::mat& data,
+                                   const size_t rank,
+                                   arma::mat& u,
+                                   arma::mat& v,
+                                   arma::vec& p,
+                                   arma::vec& q,
+                                   const bool warmStart)
+{
+  // Make the optimizer object using a BiasSVDFunction object.
+  BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
+  ShardedSGD optimizer(alpha, iterations * data.n_cols);
+
+  // Constants for assembling and extracting user and item matrices.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+
+  // Seed the parameters from the passed factorization when possible;
+  // otherwise fall back to random initialization.
+  arma::mat parameters;
+  if (warmStart && u.n_rows == numItems && u.n_cols == rank &&
+      v.n_rows == rank && v.n_cols == numUsers &&
+      p.n_elem == numItems && q.n_elem == numUsers)
+  {
+    parameters.set_size(rank + 1, numUsers + numItems);
+    parameters.submat(0, 0, rank - 1, numUsers - 1) = v;
+    parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1) = u.t();
+    parameters.row(rank).subvec(0, numUsers - 1) = q.t();
+    parameters.row(rank).subvec(numUsers, numUsers + numItems - 1) = p.t();
+  }
+  else
+  {
+    if (warmStart)
+    {
+      Log::Warn << "BiasSVD::Apply(): passed factor matrices do not match "
+          << "the data; using random initialization instead." << std::endl;
+    }
+    parameters = biasSVDFunc.GetInitialPoint();
+  }
+
+  // Get optimized parameters.
+  optimizer.Optimize(biasSVDFunc, parameters);
+
+  // Extract user and item matrices, user and item bias from the optimized
+  // parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+  p = parameters.row(rank).subvec(numUsers, numUsers + numItems - 1).t();
+  q = parameters.row(rank).subvec(0, numUsers - 1).t();
+}
+
 } // namespace svd
 } // namespace mlpack
 
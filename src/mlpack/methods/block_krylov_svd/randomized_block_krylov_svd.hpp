@@ -69,6 +69,9 @@ class RandomizedBlockKrylovSVD
    *        (Default: 2).
    * @param rank Rank of the approximation (Default: number of rows.)
    * @param blockSize The block size, must be >= rank (Default: rank + 10).
+   * @param numThreads Number of threads used to overlap the orthogonalization
+   *        of finished panels with the next multiply; 0 means all available
+   *        threads (Default: 0).
    */
   RandomizedBlockKrylovSVD(const arma::mat& data,
                            arma::mat& u,
@@ -76,7 +79,8 @@ class RandomizedBlockKrylovSVD
                            arma::mat& v,
                            const size_t maxIterations = 2,
                            const size_t rank = 0,
-                           const size_t blockSize = 0);
+                           const size_t blockSize = 0,
+                           const size_t numThreads = 0);
 
   /**
    * Create object for the randomized block krylov SVD method.
@@ -84,9 +88,13 @@ class RandomizedBlockKrylovSVD
    * @param maxIterations Number of iterations for the power method
    *        (Default: 2).
    * @param blockSize The block size, must be >= rank (Default: rank + 10).
+   * @param numThreads Number of threads used to overlap the orthogonalization
+   *        of finished panels with the next multiply; 0 means all available
+   *        threads (Default: 0).
    */
   RandomizedBlockKrylovSVD(const size_t maxIterations = 2,
-                           const size_t blockSize = 0);
+                           const size_t blockSize = 0,
+                           const size_t numThreads = 0);
 
   /**
    * Apply Principal Component Analysis to the provided data set using the
@@ -114,12 +122,21 @@ class RandomizedBlockKrylovSVD
   //! Modify the block size.
   size_t& BlockSize() { return blockSize; }
 
+  //! Get the number of threads (0 means all available threads).
+  size_t NumThreads() const { return numThreads; }
+  //! Modify the number of threads (0 means all available threads).
+  size_t& NumThreads() { return numThreads; }
+
  private:
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
   //! The block size value.
   size_t blockSize;
+
+  //! The number of threads used to pipeline panel orthogonalization with the
+  //! multiply chain (0 means all available threads).
+  size_t numThreads;
 };
 
 } // namespace svd
@@ -24,9 +24,11 @@ inline RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(
     arma::mat& v,
     const size_t maxIterations,
     const size_t rank,
-    const size_t blockSize) :
+    const size_t blockSize,
+    const size_t numThreads) :
     maxIterations(maxIterations),
-    blockSize(blockSize)
+    blockSize(blockSize),
+    numThreads(numThreads)
 {
   if (rank == 0)
   {
@@ -40,9 +42,11 @@ inline RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(
 
 inline RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(
     const size_t maxIterations,
-    const size_t blockSize) :
+    const size_t blockSize,
+    const size_t numThreads) :
     maxIterations(maxIterations),
-    blockSize(blockSize)
+    blockSize(blockSize),
+    numThreads(numThreads)
 {
   /* Nothing to do here */
 }
@@ -66,23 +70,75 @@ inline void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
   // Construct and orthonormalize Krylov subspace.
   arma::mat K(data.n_rows, blockSize * (maxIterations + 1));
 
-  // Create a working matrix using data from writable auxiliary memory
-  // (K matrix). Doing so avoids an uncessary copy in upcoming step.
-  block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
-  arma::qr_econ(block, R, data * G);
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  const int threads = (numThreads == 0) ? omp_get_max_threads() :
+      (int) numThreads;
+#else
+  const int threads = 1;
+#endif
 
-  for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
-      blockOffset += block.n_elem)
+  if (threads > 1)
   {
-    // Temporary working matrix to store the result in the correct place.
-    blockIteration = arma::mat(K.memptr() + blockOffset, block.n_rows,
-        block.n_cols, false, false);
-
-    arma::qr_econ(blockIteration, R, data * (data.t() * block));
-
-    // Update working matrix for the next iteration.
-    block = arma::mat(K.memptr() + blockOffset, block.n_rows, block.n_cols,
-        false, false);
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+    // Pipelined construction of the Krylov subspace.  The QR factorization of
+    // each panel only serves the conditioning of K---the final QR of K
+    // orthonormalizes the subspace globally---so the multiply chain can be
+    // advanced from a cheap LU-stabilized copy of each raw panel (which spans
+    // the same subspace as its Q factor), while the panel's QR factorization
+    // runs in a background task, overlapping the next multiply.
+    std::vector<arma::mat> panels(maxIterations + 1);
+    panels[0] = data * G;
+
+    #pragma omp parallel num_threads(threads)
+    #pragma omp single
+    {
+      for (size_t i = 0; i <= maxIterations; ++i)
+      {
+        // Orthonormalize the finished raw panel into its slice of K.
+        #pragma omp task default(shared) firstprivate(i)
+        {
+          arma::mat panelR;
+          arma::mat panel(K.memptr() + i * data.n_rows * blockSize,
+              data.n_rows, blockSize, false, false);
+          arma::qr_econ(panel, panelR, panels[i]);
+        }
+
+        if (i < maxIterations)
+        {
+          // Stabilize the raw panel with an LU factorization (cheaper than
+          // QR, and the permuted lower-trapezoidal factor spans the same
+          // subspace), then advance the multiply chain.
+          arma::mat L, U;
+          arma::lu(L, U, panels[i]);
+          panels[i + 1] = data * (data.t() * L);
+        }
+      }
+      // The implicit barrier of the parallel region waits for the panel
+      // tasks.
+    }
+#endif
+  }
+  else
+  {
+    // Serial construction, orthonormalizing each panel in place.
+    // Create a working matrix using data from writable auxiliary memory
+    // (K matrix). Doing so avoids an uncessary copy in upcoming step.
+    block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
+    arma::qr_econ(block, R, data * G);
+
+    for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
+        blockOffset += block.n_elem)
+    {
+      // Temporary working matrix to store the result in the correct place.
+      blockIteration = arma::mat(K.memptr() + blockOffset, block.n_rows,
+          block.n_cols, false, false);
+
+      arma::qr_econ(blockIteration, R, data * (data.t() * block));
+
+      // Update working matrix for the next iteration.
+      block = arma::mat(K.memptr() + blockOffset, block.n_rows, block.n_cols,
+          false, false);
+    }
   }
 
   arma::qr_econ(Q, R, K);
@@ -206,66 +206,130 @@ GetRecommendations(const size_t numRecs,
   // time and we don't want to repeat the initialization process in each loop.
   InterpolationPolicy interpolation(cleanedData);
 
-  for (size_t i = 0; i < users.n_elem; ++i)
+  // Process the query users in blocks.  Each block collects the distinct
+  // neighbors it references and materializes each of their predicted rating
+  // vectors exactly once; the weighted sums of all users in the block then
+  // come out of a single matrix product.  This way a neighbor shared by many
+  // query users (common when generating recommendations for every user) has
+  // its ratings computed only once, and the per-user accumulation loop is
+  // replaced by one BLAS-3 call per block.  The block size bounds the memory
+  // needed for the materialized neighbor ratings.
+  const size_t blockSize = 1024;
+  for (size_t blockBegin = 0; blockBegin < users.n_elem;
+       blockBegin += blockSize)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
+    const size_t blockEnd = std::min(blockBegin + blockSize,
+        (size_t) users.n_elem);
+    const size_t blockUsers = blockEnd - blockBegin;
 
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
-        neighborhood.col(i), similarities.col(i), cleanedData);
+    // Calculate interpolation weights of each user in the block.
+    arma::mat weights(neighborhood.n_rows, blockUsers);
+    for (size_t i = blockBegin; i < blockEnd; ++i)
+    {
+      interpolation.GetWeights(weights.col(i - blockBegin), decomposition,
+          users(i), neighborhood.col(i), similarities.col(i), cleanedData);
+    }
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    // Collect the distinct neighbors referenced by the block.
+    std::unordered_map<size_t, size_t> neighborIndex;
+    for (size_t i = blockBegin; i < blockEnd; ++i)
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+        neighborIndex.emplace(neighborhood(j, i), neighborIndex.size());
+
+    std::vector<size_t> neighborIds(neighborIndex.size());
+    for (auto& it : neighborIndex)
+      neighborIds[it.second] = it.first;
+
+    // Materialize the predicted ratings of each distinct neighbor; the
+    // neighbors are independent, so this runs in parallel.
+    arma::mat neighborRatings(cleanedData.n_rows, neighborIds.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t k = 0; k < (omp_size_t) neighborIds.size(); ++k)
+    {
+      arma::vec rating;
+      decomposition.GetRatingOfUser(neighborIds[k], rating);
+      neighborRatings.col(k) = rating;
+    }
+
+    // Scatter the interpolation weights into a (distinct neighbors x block
+    // users) matrix, so that the weighted sums of every user in the block are
+    // computed by a single matrix product.
+    arma::mat scatteredWeights(neighborIds.size(), blockUsers,
+        arma::fill::zeros);
+    for (size_t i = blockBegin; i < blockEnd; ++i)
     {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+      {
+        scatteredWeights(neighborIndex[neighborhood(j, i)], i - blockBegin) +=
+            weights(j, i - blockBegin);
+      }
     }
 
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+    const arma::mat blockRatings = neighborRatings * scatteredWeights;
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
+    // Now pick the top numRecs candidates for each user in the block.  The
+    // users are independent, so this also runs in parallel.  The rated items
+    // of each user are read through const iterators, since concurrent element
+    // access to a sparse matrix is not safe.
+    const arma::sp_mat& ratedItems = cleanedData;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = blockBegin; i < (omp_size_t) blockEnd; ++i)
     {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
-      // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
-
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      // Mark the items the user has already rated.  The algorithm omits
+      // ratings of zero; when normalizing original ratings in Normalize(), a
+      // normalized rating that equals zero is set to the smallest positive
+      // double value.
+      std::vector<bool> rated(cleanedData.n_rows, false);
+      arma::sp_mat::const_iterator it = ratedItems.begin_col(users(i));
+      const arma::sp_mat::const_iterator itEnd = ratedItems.end_col(users(i));
+      for (; it != itEnd; ++it)
+        rated[it.row()] = true;
+
+      // Let's build the list of candidate recomendations for the given user.
+      // Default candidate: the smallest possible value and invalid item
+      // number.
+      const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
+      std::vector<Candidate> vect(numRecs, def);
+      typedef std::priority_queue<Candidate, std::vector<Candidate>,
+          CandidateCmp> CandidateList;
+      CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+      // Look through the ratings column corresponding to the current user.
+      for (size_t j = 0; j < cleanedData.n_rows; ++j)
       {
-        Candidate c = std::make_pair(realRating, j);
+        // Ensure that the user hasn't already rated the item.
+        if (rated[j])
+          continue; // The user already rated the item.
+
+        // Is the estimated value better than the worst candidate?
+        // Denormalize rating before comparison.
+        double realRating = normalization.Denormalize(users(i), j,
+            blockRatings(j, i - blockBegin));
+        if (realRating > pqueue.top().first)
+        {
+          Candidate c = std::make_pair(realRating, j);
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
+
+      for (size_t p = 1; p <= numRecs; p++)
+      {
+        recommendations(numRecs - p, i) = pqueue.top().second;
+        values(numRecs - p, i) = pqueue.top().first;
         pqueue.pop();
-        pqueue.push(c);
       }
     }
 
-    for (size_t p = 1; p <= numRecs; p++)
+    // If we were not able to come up with enough recommendations for some
+    // user, issue a warning.  (This is done outside the parallel loop above.)
+    for (size_t i = blockBegin; i < blockEnd; ++i)
     {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
+      if (recommendations(numRecs - 1, i) == cleanedData.n_rows)
+        Log::Warn << "Could not provide " << numRecs << " recommendations "
+            << "for user " << users(i) << " (not enough un-rated items)!"
+            << std::endl;
     }
-
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
-      Log::Warn << "Could not provide " << numRecs << " recommendations "
-          << "for user " << users(i) << " (not enough un-rated items)!"
-          << std::endl;
   }
 }
 
@@ -16,6 +16,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
 #include <mlpack/methods/emst/union_find.hpp>
+#include "grid_range_search.hpp"
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
 
@@ -0,0 +1,124 @@
+/**
+ * @file methods/dbscan/grid_range_search.hpp
+ *
+ * A uniform-grid range search engine for low-dimensional data, usable as the
+ * RangeSearchType policy of the DBSCAN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/math/range.hpp>
+
+#include <map>
+
+namespace mlpack {
+namespace dbscan {
+
+/**
+ * A range search engine that bins the reference points into a uniform grid
+ * whose cells are sized to the search radius, so a range query only has to
+ * examine the points in the 3^d cells surrounding the query point.  For
+ * low-dimensional (roughly 2--6 dimensional) spatial data this is usually far
+ * faster than tree-based range search; in higher dimensions the number of
+ * surrounding cells grows exponentially and a tree should be preferred.
+ *
+ * The batch Search() overload is parallelized over the query points with
+ * OpenMP.  This class implements the interface that the DBSCAN class expects
+ * of its RangeSearchType template parameter:
+ *
+ * @code
+ * DBSCAN<GridRangeSearch<>> d(0.1, 5);
+ * @endcode
+ *
+ * Only the Euclidean metric is supported, since the grid geometry depends on
+ * it.
+ *
+ * @tparam MatType Type of matrix to search on (arma::mat).
+ */
+template<typename MatType = arma::mat>
+class GridRangeSearch
+{
+ public:
+  //! Construct an empty GridRangeSearch object.
+  GridRangeSearch();
+
+  /**
+   * Set the reference set.  The grid itself is built lazily on the first
+   * Search() call, since the cell size is the upper bound of the searched
+   * range.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(const MatType& referenceSet);
+
+  /**
+   * Search for all reference points in the given range from each query point.
+   * The work is parallelized over the query points.
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances to search for.
+   * @param neighbors Object which will hold the list of neighbors for each
+   *      query point.
+   * @param distances Object which will hold the list of distances for each
+   *      query point.
+   */
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
+  /**
+   * Search for all reference points in the given range from a single query
+   * point.
+   *
+   * @param query Query point.
+   * @param range Range of distances to search for.
+   * @param neighbors Object which will hold the list of neighbors.
+   * @param distances Object which will hold the list of distances.
+   */
+  template<typename VecType>
+  void Search(const VecType& query,
+              const math::Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
+ private:
+  //! The key of the grid cell that holds the given point.
+  std::vector<long> Cell(const arma::vec& point) const;
+
+  //! Rebuild the grid if the cell size does not match the searched range.
+  void BuildGrid(const double newCellSize);
+
+  /**
+   * Collect all reference points within the range of the query point by
+   * scanning the 3^d cells surrounding it.
+   */
+  void SearchPoint(const arma::vec& query,
+                   const math::Range& range,
+                   std::vector<size_t>& neighbors,
+                   std::vector<double>& distances) const;
+
+  //! The reference set.
+  arma::mat referenceSet;
+  //! Lowest coordinate of the reference set in each dimension.
+  arma::vec minCorner;
+  //! Edge length of the grid cells; 0 if the grid has not been built.
+  double cellSize;
+  //! Map from cell coordinates to the indices of the points in the cell.
+  std::map<std::vector<long>, std::vector<size_t>> grid;
+};
+
+} // namespace dbscan
+} // namespace mlpack
+
+// Include implementation.
+#include "grid_range_search_impl.hpp"
+
+#endif
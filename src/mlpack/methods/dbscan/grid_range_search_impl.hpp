@@ -0,0 +1,159 @@
+/**
+ * @file methods/dbscan/grid_range_search_impl.hpp
+ *
+ * Implementation of the uniform-grid range search engine.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_DBSCAN_GRID_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included.
+#include "grid_range_search.hpp"
+
+namespace mlpack {
+namespace dbscan {
+
+template<typename MatType>
+GridRangeSearch<MatType>::GridRangeSearch() : cellSize(0.0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Train(const MatType& referenceSet)
+{
+  this->referenceSet = arma::conv_to<arma::mat>::from(referenceSet);
+  minCorner = arma::min(this->referenceSet, 1);
+  cellSize = 0.0; // Force a grid rebuild on the next Search().
+
+  if (referenceSet.n_rows > 8)
+  {
+    Log::Warn << "GridRangeSearch::Train(): the number of cells scanned per "
+        << "query grows as 3^d; with " << referenceSet.n_rows << " dimensions "
+        << "a tree-based range search will likely be faster." << std::endl;
+  }
+}
+
+template<typename MatType>
+std::vector<long> GridRangeSearch<MatType>::Cell(const arma::vec& point) const
+{
+  std::vector<long> cell(point.n_elem);
+  for (size_t d = 0; d < point.n_elem; ++d)
+    cell[d] = (long) std::floor((point[d] - minCorner[d]) / cellSize);
+  return cell;
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::BuildGrid(const double newCellSize)
+{
+  if (newCellSize == cellSize)
+    return; // The grid is already built for this range.
+
+  if (newCellSize <= 0.0)
+  {
+    throw std::invalid_argument("GridRangeSearch::Search(): the upper bound "
+        "of the range must be positive!");
+  }
+
+  cellSize = newCellSize;
+  grid.clear();
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+    grid[Cell(referenceSet.col(i))].push_back(i);
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::SearchPoint(
+    const arma::vec& query,
+    const math::Range& range,
+    std::vector<size_t>& neighbors,
+    std::vector<double>& distances) const
+{
+  neighbors.clear();
+  distances.clear();
+
+  // Walk the 3^d cells surrounding the query's cell with an odometer over
+  // the per-dimension offsets.
+  const std::vector<long> center = Cell(query);
+  std::vector<long> offset(center.size(), -1);
+  std::vector<long> cell(center.size());
+
+  while (true)
+  {
+    for (size_t d = 0; d < center.size(); ++d)
+      cell[d] = center[d] + offset[d];
+
+    const auto it = grid.find(cell);
+    if (it != grid.end())
+    {
+      for (const size_t index : it->second)
+      {
+        const double distance = metric::EuclideanDistance::Evaluate(query,
+            referenceSet.unsafe_col(index));
+        if (range.Contains(distance))
+        {
+          neighbors.push_back(index);
+          distances.push_back(distance);
+        }
+      }
+    }
+
+    // Advance the odometer.
+    size_t d = 0;
+    while (d < offset.size() && offset[d] == 1)
+      offset[d++] = -1;
+    if (d == offset.size())
+      break;
+    offset[d]++;
+  }
+}
+
+template<typename MatType>
+void GridRangeSearch<MatType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  BuildGrid(range.Hi());
+
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  // Each query point only touches its own output slots, so the expansion over
+  // the grid cells is embarrassingly parallel.
+  #pragma omp parallel for schedule(dynamic, 256)
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    const arma::vec query = arma::vec(querySet.col(i));
+    SearchPoint(query, range, neighbors[i], distances[i]);
+  }
+}
+
+template<typename MatType>
+template<typename VecType>
+void GridRangeSearch<MatType>::Search(
+    const VecType& query,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  BuildGrid(range.Hi());
+
+  neighbors.clear();
+  neighbors.resize(1);
+  distances.clear();
+  distances.resize(1);
+
+  SearchPoint(arma::vec(query), range, neighbors[0], distances[0]);
+}
+
+} // namespace dbscan
+} // namespace mlpack
+
+#endif
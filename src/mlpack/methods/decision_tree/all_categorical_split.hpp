@@ -31,7 +31,13 @@ class AllCategoricalSplit
 {
  public:
   // No extra info needed for split.
-  class AuxiliarySplitInfo { };
+  class AuxiliarySplitInfo
+  {
+   public:
+    //! Nothing to serialize.
+    template<typename Archive>
+    void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+  };
 
   /**
    * Check if we can split a node.  If we can split a node in a way that
@@ -117,6 +123,16 @@ class AllCategoricalSplit
   static size_t NumChildren(const double& splitInfo,
                             const AuxiliarySplitInfo& /* aux */);
 
+  /**
+   * Return the number of categories of the split dimension (which, for this
+   * split type, is also the number of children).
+   *
+   * @param splitInfo Auxiliary information for the split.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  static size_t NumCategories(const double& splitInfo,
+                              const AuxiliarySplitInfo& /* aux */);
+
   /**
    * Calculate the direction a point should percolate to.
    *
@@ -216,6 +216,14 @@ size_t AllCategoricalSplit<FitnessFunction>::NumChildren(
   return (size_t) splitInfo;
 }
 
+template<typename FitnessFunction>
+size_t AllCategoricalSplit<FitnessFunction>::NumCategories(
+    const double& splitInfo,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  return (size_t) splitInfo;
+}
+
 template<typename FitnessFunction>
 template<typename ElemType>
 size_t AllCategoricalSplit<FitnessFunction>::CalculateDirection(
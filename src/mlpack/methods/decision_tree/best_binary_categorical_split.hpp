@@ -0,0 +1,314 @@
+/**
+ * @file methods/decision_tree/best_binary_categorical_split.hpp
+ * @author Ryan Curtin
+ *
+ * A tree splitter that finds a binary partition of the categories of a
+ * categorical feature.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "best_binary_numeric_split.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The BestBinaryCategoricalSplit is a splitting function for decision trees
+ * that partitions the categories of a categorical feature into two children,
+ * instead of creating one child per category like AllCategoricalSplit.  On
+ * high-cardinality features this keeps the number of children (and thus the
+ * number of nodes in the tree) small, and usually generalizes better, since
+ * each child still has enough points to split further.
+ *
+ * The partition is found by sorting the categories by a one-dimensional score
+ * and scanning the prefixes of the sorted order, so only k - 1 candidate
+ * partitions are evaluated instead of all 2^(k - 1).  For classification the
+ * categories are ordered by the probability of the node's majority class,
+ * which finds the optimal partition when there are two classes (Breiman et
+ * al., "Classification and Regression Trees", 1984) and is a standard
+ * heuristic otherwise; for regression they are ordered by their mean response,
+ * which is optimal for squared-error-type losses (Fisher, 1958).
+ *
+ * The chosen partition is stored as a bitset over the categories in the
+ * auxiliary split information, so a node costs only a few words regardless of
+ * the cardinality of the feature.  Categories that did not occur in the node
+ * during training are sent to the second child.
+ *
+ * @tparam FitnessFunction Fitness function to evaluate gain with.
+ */
+template<typename FitnessFunction>
+class BestBinaryCategoricalSplit
+{
+ public:
+  /**
+   * The auxiliary split information for a binary categorical split: a bitset
+   * over the categories of the split dimension, with the bit of a category
+   * set if that category belongs to the second child.
+   */
+  class AuxiliarySplitInfo
+  {
+   public:
+    //! Construct the object with no split stored.
+    AuxiliarySplitInfo() : numCategories(0) { }
+
+    /**
+     * Get the direction of the given category (0 for the first child, 1 for
+     * the second).
+     *
+     * @param category Category to look up.
+     */
+    size_t Direction(const size_t category) const
+    {
+      return (size_t) ((categoryMask[category / 64] >> (category % 64)) & 1);
+    }
+
+    //! Get the number of categories of the split dimension.
+    size_t NumCategories() const { return numCategories; }
+
+    /**
+     * Store the given binary partition.  The direction of category c will be
+     * directions[c].
+     *
+     * @param directions Direction (0 or 1) of each category.
+     */
+    void Set(const arma::Row<size_t>& directions)
+    {
+      numCategories = directions.n_elem;
+      categoryMask.zeros((numCategories + 63) / 64);
+      for (size_t c = 0; c < numCategories; ++c)
+      {
+        if (directions[c] == 1)
+          categoryMask[c / 64] |= (((arma::u64) 1) << (c % 64));
+      }
+    }
+
+    //! Serialize the split.
+    template<typename Archive>
+    void serialize(Archive& ar, const uint32_t /* version */)
+    {
+      ar(CEREAL_NVP(categoryMask));
+      ar(CEREAL_NVP(numCategories));
+    }
+
+   private:
+    //! The bitset over categories; a set bit sends the category to the second
+    //! child.
+    arma::Col<arma::u64> categoryMask;
+    //! The number of categories of the split dimension.
+    size_t numCategories;
+  };
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and
+   * aux may be modified; splitInfo will store the number of children (always
+   * two) and aux will store the bitset of the partition.  If no better split
+   * is found, neither is touched.
+   *
+   * This overload is used only for classification.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param numCategories Number of categories in the categorical data.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename LabelsType,
+           typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const size_t numCategories,
+      const LabelsType& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and
+   * aux may be modified; splitInfo will store the number of children (always
+   * two) and aux will store the bitset of the partition.  If no better split
+   * is found, neither is touched.
+   *
+   * This overload is used only for regression.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param numCategories Number of categories in the categorical data.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   * @param fitnessFunction The FitnessFunction object instance. It it used to
+   *      evaluate the gain for the split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType>
+  static typename std::enable_if<
+      !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+      double>::type
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const size_t numCategories,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      double& splitInfo,
+      AuxiliarySplitInfo& aux,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and
+   * aux may be modified.
+   *
+   * This overload is specialized for any fitness function that implements
+   * BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param numCategories Number of categories in the categorical data.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   * @param fitnessFunction The FitnessFunction object instance. It it used to
+   *      evaluate the gain for the split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType>
+  static typename std::enable_if<
+      HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+      double>::type
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const size_t numCategories,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      double& splitInfo,
+      AuxiliarySplitInfo& aux,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * Returns 2, since the binary categorical split always has two children.
+   *
+   * @param * (splitInfo) Auxiliary information for the split (unused).
+   * @param * (aux) Auxiliary information for the split (unused).
+   */
+  static size_t NumChildren(const double& /* splitInfo */,
+                            const AuxiliarySplitInfo& /* aux */)
+  {
+    return 2;
+  }
+
+  /**
+   * Return the number of categories of the split dimension.
+   *
+   * @param * (splitInfo) Auxiliary information for the split (unused).
+   * @param aux Auxiliary information for the split.
+   */
+  static size_t NumCategories(const double& /* splitInfo */,
+                              const AuxiliarySplitInfo& aux)
+  {
+    return aux.NumCategories();
+  }
+
+  /**
+   * Calculate the direction a point should percolate to.
+   *
+   * @param point the Point to use.
+   * @param * (splitInfo) Auxiliary information for the split (unused).
+   * @param aux Auxiliary information for the split.
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const double& /* splitInfo */,
+      const AuxiliarySplitInfo& aux);
+
+ private:
+  /**
+   * Group the given points (and optionally their weights) contiguously by
+   * category, with the categories laid out in the given order.  This is a
+   * counting sort; categoryStarts[i] will hold the index at which the points
+   * of category categoryOrder[i] begin, with one extra trailing element
+   * holding the total number of points.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType, typename RType, typename WType>
+  static void GroupByCategory(
+      const VecType& data,
+      const arma::Row<size_t>& categoryCounts,
+      const arma::Row<size_t>& categoryOrder,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      arma::Row<size_t>& categoryStarts,
+      arma::Row<RType>& sortedResponses,
+      arma::Row<WType>& sortedWeights);
+
+  /**
+   * Store the partition that sends the first prefixLength categories of
+   * categoryOrder to the first child and every other category to the second
+   * child.
+   */
+  static void StorePartition(
+      const size_t numCategories,
+      const arma::Row<size_t>& categoryOrder,
+      const size_t prefixLength,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
+  //! Overload for the regression split types, whose splitInfo is a double.
+  static void StorePartition(
+      const size_t numCategories,
+      const arma::Row<size_t>& categoryOrder,
+      const size_t prefixLength,
+      double& splitInfo,
+      AuxiliarySplitInfo& aux);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "best_binary_categorical_split_impl.hpp"
+
+#endif
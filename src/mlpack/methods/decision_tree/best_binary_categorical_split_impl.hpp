@@ -0,0 +1,688 @@
+/**
+ * @file methods/decision_tree/best_binary_categorical_split_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the BestBinaryCategoricalSplit categorical split class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_BEST_BINARY_CATEGORICAL_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+// Overload used in classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename LabelsType,
+         typename WeightVecType>
+double BestBinaryCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const LabelsType& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& aux)
+{
+  // First sanity check: if we don't have enough points or categories, we can't
+  // split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (numCategories < 2)
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Build the per-category class histogram.
+  arma::Row<size_t> categoryCounts(numCategories, arma::fill::zeros);
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
+  arma::rowvec categoryWeights;
+  double totalWeight = 0.0;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, numCategories);
+    categoryWeights.zeros(numCategories);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      const size_t category = (size_t) data[i];
+      ++categoryCounts[category];
+      classWeightSums(labels[i], category) += weights[i];
+      categoryWeights[category] += weights[i];
+      totalWeight += weights[i];
+    }
+  }
+  else
+  {
+    classCounts.zeros(numClasses, numCategories);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      const size_t category = (size_t) data[i];
+      ++categoryCounts[category];
+      ++classCounts(labels[i], category);
+    }
+  }
+
+  // Find the majority class of the node, and order the categories by the
+  // fraction of their points that belong to it.  Scanning the prefixes of
+  // this order finds the optimal partition when there are two classes
+  // (Breiman et al., 1984); with more classes it is a heuristic.  Empty
+  // categories sort to the end and never enter a prefix, so they end up in
+  // the second child.
+  arma::uword majorityClass = 0;
+  if (UseWeights)
+  {
+    const arma::vec classTotals = arma::sum(classWeightSums, 1);
+    classTotals.max(majorityClass);
+  }
+  else
+  {
+    const arma::Col<size_t> classTotals = arma::sum(classCounts, 1);
+    classTotals.max(majorityClass);
+  }
+
+  arma::vec scores(numCategories);
+  size_t numNonEmpty = 0;
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    if (categoryCounts[c] == 0)
+    {
+      scores[c] = -1.0; // Sorts after every occupied category.
+      continue;
+    }
+
+    ++numNonEmpty;
+    if (UseWeights)
+      scores[c] = classWeightSums(majorityClass, c) / categoryWeights[c];
+    else
+      scores[c] = double(classCounts(majorityClass, c)) /
+          double(categoryCounts[c]);
+  }
+
+  // We need at least two occupied categories to make a binary partition.
+  if (numNonEmpty < 2)
+    return DBL_MAX;
+
+  const arma::uvec sortedCategories = arma::sort_index(scores, "descend");
+  arma::Row<size_t> categoryOrder(numCategories);
+  for (size_t i = 0; i < numCategories; ++i)
+    categoryOrder[i] = (size_t) sortedCategories[i];
+
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  size_t bestPrefix = 0;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+  if (UseWeights)
+    bestFoundGain *= totalWeight;
+  else
+    bestFoundGain *= data.n_elem;
+
+  // Scan the prefixes of the sorted category order (the only candidate
+  // partitions), accumulating the first child's statistics as we go.
+  arma::Col<size_t> leftCounts, rightCounts;
+  arma::vec leftWeightSums, rightWeightSums;
+  if (UseWeights)
+  {
+    leftWeightSums.zeros(numClasses);
+    rightWeightSums = arma::sum(classWeightSums, 1);
+  }
+  else
+  {
+    leftCounts.zeros(numClasses);
+    rightCounts = arma::sum(classCounts, 1);
+  }
+
+  size_t leftPoints = 0;
+  double leftWeight = 0.0;
+  double rightWeight = totalWeight;
+  for (size_t p = 0; p + 1 < numNonEmpty; ++p)
+  {
+    const size_t category = categoryOrder[p];
+    if (UseWeights)
+    {
+      leftWeightSums += classWeightSums.col(category);
+      rightWeightSums -= classWeightSums.col(category);
+      leftWeight += categoryWeights[category];
+      rightWeight -= categoryWeights[category];
+    }
+    else
+    {
+      leftCounts += classCounts.col(category);
+      rightCounts -= classCounts.col(category);
+    }
+    leftPoints += categoryCounts[category];
+    const size_t rightPoints = data.n_elem - leftPoints;
+
+    if (leftPoints < minimum)
+      continue;
+    if (rightPoints < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(leftWeightSums.memptr(),
+            numClasses, leftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(leftCounts.memptr(),
+            numClasses, leftPoints);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(rightWeightSums.memptr(),
+            numClasses, rightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(rightCounts.memptr(),
+            numClasses, rightPoints);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftWeight * leftGain + rightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain of this partition.
+      gain = double(leftPoints) * leftGain + double(rightPoints) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      StorePartition(numCategories, categoryOrder, p + 1, splitInfo, aux);
+
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      bestPrefix = p + 1;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  StorePartition(numCategories, categoryOrder, bestPrefix, splitInfo, aux);
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Overload used in regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+BestBinaryCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& aux,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points or categories, we
+  // can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (numCategories < 2)
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Compute the mean response of every category; the categories are then
+  // ordered by mean and only the prefixes of that order are candidate
+  // partitions, which is optimal for squared-error-type losses (Fisher,
+  // 1958).  Empty categories sort to the end and never enter a prefix, so
+  // they end up in the second child.
+  arma::Row<size_t> categoryCounts(numCategories, arma::fill::zeros);
+  arma::vec responseSums(numCategories, arma::fill::zeros);
+  arma::vec weightSums(numCategories, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    ++categoryCounts[category];
+    if (UseWeights)
+    {
+      responseSums[category] += weights[i] * responses[i];
+      weightSums[category] += weights[i];
+    }
+    else
+    {
+      responseSums[category] += responses[i];
+    }
+  }
+
+  arma::vec means(numCategories);
+  size_t numNonEmpty = 0;
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    if (categoryCounts[c] == 0)
+    {
+      means[c] = DBL_MAX; // Sorts after every occupied category.
+      continue;
+    }
+
+    ++numNonEmpty;
+    means[c] = UseWeights ? responseSums[c] / weightSums[c] :
+        responseSums[c] / categoryCounts[c];
+  }
+
+  // We need at least two occupied categories to make a binary partition.
+  if (numNonEmpty < 2)
+    return DBL_MAX;
+
+  const arma::uvec sortedCategories = arma::sort_index(means);
+  arma::Row<size_t> categoryOrder(numCategories);
+  for (size_t i = 0; i < numCategories; ++i)
+    categoryOrder[i] = (size_t) sortedCategories[i];
+
+  // Group the responses (and weights) contiguously by category, in sorted
+  // category order, with a counting sort; the category boundaries are then
+  // the candidate split points.
+  arma::Row<size_t> categoryStarts;
+  arma::Row<RType> sortedResponses;
+  arma::Row<WType> sortedWeights;
+  GroupByCategory<UseWeights>(data, categoryCounts, categoryOrder, responses,
+      weights, categoryStarts, sortedResponses, sortedWeights);
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  size_t bestPrefix = 0;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType totalLeftWeight = 0.0;
+  WType totalRightWeight = 0.0;
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+    totalRightWeight = totalWeight;
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  size_t lastIndex = 0;
+  for (size_t p = 0; p + 1 < numNonEmpty; ++p)
+  {
+    const size_t index = categoryStarts[p + 1];
+    if (UseWeights)
+    {
+      for (size_t i = lastIndex; i < index; ++i)
+      {
+        totalLeftWeight += sortedWeights[i];
+        totalRightWeight -= sortedWeights[i];
+      }
+    }
+    lastIndex = index;
+
+    if (index < minimum)
+      continue;
+    if (data.n_elem - index < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.
+    const double leftGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, 0, index);
+    const double rightGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, index,
+            responses.n_elem);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain of this partition.
+      gain = double(index) * leftGain +
+          double(responses.n_elem - index) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      StorePartition(numCategories, categoryOrder, p + 1, splitInfo, aux);
+
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      bestPrefix = p + 1;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  StorePartition(numCategories, categoryOrder, bestPrefix, splitInfo, aux);
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Optimized version for any fitness function that implements
+// BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+BestBinaryCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& aux,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points or categories, we
+  // can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (numCategories < 2)
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Compute the mean response of every category; the categories are then
+  // ordered by mean and only the prefixes of that order are candidate
+  // partitions, which is optimal for squared-error-type losses (Fisher,
+  // 1958).  Empty categories sort to the end and never enter a prefix, so
+  // they end up in the second child.
+  arma::Row<size_t> categoryCounts(numCategories, arma::fill::zeros);
+  arma::vec responseSums(numCategories, arma::fill::zeros);
+  arma::vec weightSums(numCategories, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    ++categoryCounts[category];
+    if (UseWeights)
+    {
+      responseSums[category] += weights[i] * responses[i];
+      weightSums[category] += weights[i];
+    }
+    else
+    {
+      responseSums[category] += responses[i];
+    }
+  }
+
+  arma::vec means(numCategories);
+  size_t numNonEmpty = 0;
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    if (categoryCounts[c] == 0)
+    {
+      means[c] = DBL_MAX; // Sorts after every occupied category.
+      continue;
+    }
+
+    ++numNonEmpty;
+    means[c] = UseWeights ? responseSums[c] / weightSums[c] :
+        responseSums[c] / categoryCounts[c];
+  }
+
+  // We need at least two occupied categories to make a binary partition.
+  if (numNonEmpty < 2)
+    return DBL_MAX;
+
+  const arma::uvec sortedCategories = arma::sort_index(means);
+  arma::Row<size_t> categoryOrder(numCategories);
+  for (size_t i = 0; i < numCategories; ++i)
+    categoryOrder[i] = (size_t) sortedCategories[i];
+
+  // Group the responses (and weights) contiguously by category, in sorted
+  // category order, with a counting sort; the category boundaries are then
+  // the candidate split points.
+  arma::Row<size_t> categoryStarts;
+  arma::Row<RType> sortedResponses;
+  arma::Row<WType> sortedWeights;
+  GroupByCategory<UseWeights>(data, categoryCounts, categoryOrder, responses,
+      weights, categoryStarts, sortedResponses, sortedWeights);
+
+  // Mark the first-child sizes at which a category boundary falls, along with
+  // the prefix length of that boundary.
+  const size_t sentinel = numCategories + 1;
+  arma::Row<size_t> prefixAt(data.n_elem + 1);
+  prefixAt.fill(sentinel);
+  for (size_t p = 0; p + 1 < numNonEmpty; ++p)
+    prefixAt[categoryStarts[p + 1]] = p + 1;
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  size_t bestPrefix = 0;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType leftChildWeight = 0.0;
+  WType rightChildWeight = 0.0;
+
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+
+    for (size_t i = 0; i < minimum - 1; ++i)
+      leftChildWeight += sortedWeights[i];
+
+    for (size_t i = minimum - 1; i < data.n_elem; ++i)
+      rightChildWeight += sortedWeights[i];
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Initialize and precompute various statistics to efficiently compute gain
+  // values for all candidate splits.
+  fitnessFunction.template BinaryScanInitialize<UseWeights>(sortedResponses,
+      sortedWeights, minimum);
+
+  // Step through every point in category order, but compute gains only at the
+  // category boundaries.
+  for (size_t index = minimum; index < data.n_elem - minimum + 1; ++index)
+  {
+    if (UseWeights)
+    {
+      leftChildWeight += sortedWeights[index - 1];
+      rightChildWeight -= sortedWeights[index - 1];
+    }
+
+    // Steps through the current index and updates the cached data.
+    fitnessFunction.template BinaryStep<UseWeights>(sortedResponses,
+        sortedWeights, index - 1);
+
+    // Only category boundaries are candidate splits.
+    if (prefixAt[index] == sentinel)
+      continue;
+
+    // Calculate the gain for the left and right child.
+    std::tuple<double, double> binaryGains = fitnessFunction.BinaryGains();
+    const double leftGain = std::get<0>(binaryGains);
+    const double rightGain = std::get<1>(binaryGains);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftChildWeight * leftGain + rightChildWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain of this partition.
+      gain = double(index) * leftGain +
+          double(sortedResponses.n_elem - index) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      StorePartition(numCategories, categoryOrder, prefixAt[index], splitInfo,
+          aux);
+
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      bestPrefix = prefixAt[index];
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  StorePartition(numCategories, categoryOrder, bestPrefix, splitInfo, aux);
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t BestBinaryCategoricalSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const double& /* splitInfo */,
+    const AuxiliarySplitInfo& aux)
+{
+  return aux.Direction((size_t) point);
+}
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType, typename RType, typename WType>
+void BestBinaryCategoricalSplit<FitnessFunction>::GroupByCategory(
+    const VecType& data,
+    const arma::Row<size_t>& categoryCounts,
+    const arma::Row<size_t>& categoryOrder,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    arma::Row<size_t>& categoryStarts,
+    arma::Row<RType>& sortedResponses,
+    arma::Row<WType>& sortedWeights)
+{
+  const size_t numCategories = categoryCounts.n_elem;
+
+  // The position of each category in the sorted order.
+  arma::Row<size_t> categoryRank(numCategories);
+  for (size_t i = 0; i < numCategories; ++i)
+    categoryRank[categoryOrder[i]] = i;
+
+  categoryStarts.set_size(numCategories + 1);
+  categoryStarts[0] = 0;
+  for (size_t i = 0; i < numCategories; ++i)
+  {
+    categoryStarts[i + 1] = categoryStarts[i] +
+        categoryCounts[categoryOrder[i]];
+  }
+
+  arma::Row<size_t> positions = categoryStarts.subvec(0, numCategories - 1);
+  sortedResponses.set_size(responses.n_elem);
+  if (UseWeights)
+    sortedWeights.set_size(responses.n_elem);
+  for (size_t i = 0; i < responses.n_elem; ++i)
+  {
+    const size_t position = positions[categoryRank[(size_t) data[i]]]++;
+    sortedResponses[position] = responses[i];
+    if (UseWeights)
+      sortedWeights[position] = weights[i];
+  }
+}
+
+template<typename FitnessFunction>
+void BestBinaryCategoricalSplit<FitnessFunction>::StorePartition(
+    const size_t numCategories,
+    const arma::Row<size_t>& categoryOrder,
+    const size_t prefixLength,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& aux)
+{
+  splitInfo.set_size(1);
+  double packedSplitInfo = 2; // The number of children.
+  StorePartition(numCategories, categoryOrder, prefixLength, packedSplitInfo,
+      aux);
+  splitInfo[0] = packedSplitInfo;
+}
+
+template<typename FitnessFunction>
+void BestBinaryCategoricalSplit<FitnessFunction>::StorePartition(
+    const size_t numCategories,
+    const arma::Row<size_t>& categoryOrder,
+    const size_t prefixLength,
+    double& splitInfo,
+    AuxiliarySplitInfo& aux)
+{
+  // Every category outside the prefix---including the categories that did not
+  // occur in this node---goes to the second child.
+  arma::Row<size_t> directions(numCategories);
+  directions.fill(1);
+  for (size_t p = 0; p < prefixLength; ++p)
+    directions[categoryOrder[p]] = 0;
+
+  aux.Set(directions);
+  splitInfo = 2; // The number of children.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -50,7 +50,13 @@ class BestBinaryNumericSplit
 {
  public:
   // No extra info needed for split.
-  class AuxiliarySplitInfo { };
+  class AuxiliarySplitInfo
+  {
+   public:
+    //! Nothing to serialize.
+    template<typename Archive>
+    void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+  };
 
   /**
    * Check if we can split a node.  If we can split a node in a way that
@@ -85,6 +91,43 @@ class BestBinaryNumericSplit
       arma::vec& splitInfo,
       AuxiliarySplitInfo& aux);
 
+  /**
+   * Check if we can split a node, using a precomputed sorted order of the
+   * dimension.  This is the same split search as the classification overload
+   * above, but the O(n log n) sort is skipped: the scan over the given order
+   * is linear.  This is useful when the same dimension is searched repeatedly
+   * with different weights (e.g. across boosting rounds), where the sorted
+   * order never changes.  The caller is responsible for `sortedIndices`
+   * actually being the ascending sorted order of `data`.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param sortedIndices Indices of `data` in ascending sorted order.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename IndexVecType,
+           typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const IndexVecType& sortedIndices,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
   /**
    * Check if we can split a node.  If we can split a node in a way that
    * improves on 'bestGain', then we return the improved gain.  Otherwise we
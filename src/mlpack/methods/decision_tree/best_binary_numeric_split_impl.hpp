@@ -27,6 +27,34 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     arma::vec& splitInfo,
+    AuxiliarySplitInfo& aux)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Sort the data, then hand off to the sorted-order overload.
+  const arma::uvec sortedIndices = arma::sort_index(data);
+  return SplitIfBetter<UseWeights>(bestGain, data, sortedIndices, labels,
+      numClasses, weights, minimumLeafSize, minimumGainSplit, splitInfo, aux);
+}
+
+// Overload used for classification, with a precomputed sorted order.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename IndexVecType,
+         typename WeightVecType>
+double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const IndexVecType& sortedIndices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
     AuxiliarySplitInfo& /* aux */)
 {
   // First sanity check: if we don't have enough points, we can't split.
@@ -35,8 +63,6 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
   if (bestGain == 0.0)
     return DBL_MAX; // It can't be outperformed.
 
-  // Next, sort the data.
-  arma::uvec sortedIndices = arma::sort_index(data);
   arma::Row<size_t> sortedLabels(labels.n_elem);
   arma::rowvec sortedWeights;
   for (size_t i = 0; i < sortedLabels.n_elem; ++i)
@@ -17,9 +17,12 @@
 #include "gini_gain.hpp"
 #include "information_gain.hpp"
 #include "best_binary_numeric_split.hpp"
+#include "histogram_binary_numeric_split.hpp"
 #include "random_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
+#include "best_binary_categorical_split.hpp"
 #include "all_dimension_select.hpp"
+#include <cereal/types/base_class.hpp>
 #include <type_traits>
 
 namespace mlpack {
@@ -230,6 +233,48 @@ class DecisionTree :
       const std::enable_if_t<arma::is_arma_type<
           typename std::remove_reference<WeightsType>::type>::value>* = 0);
 
+  /**
+   * Take ownership of another decision tree and train on the given data and
+   * labels with weights, reusing a precomputed per-dimension sorted-order
+   * cache.  The data must be all of the numeric type.  Column i of
+   * `sortedOrders` must hold the indices of the points in ascending order of
+   * dimension i; when the same dataset is trained on repeatedly with
+   * different weights (e.g. across boosting rounds), computing the orders
+   * once and passing them here turns each root split search from
+   * O(n log n) per dimension into a linear scan.  The cache is only valid
+   * for the root node, so it benefits single-level trees (decision stumps)
+   * most; deeper nodes sort their (rearranged) subsets as usual.
+   *
+   * Use std::move if data, labels or weights are no longer needed to avoid
+   * copies.
+   *
+   * @param other Tree to take ownership of.
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights The Weight list of given labels.
+   * @param sortedOrders Precomputed sorted order of each dimension, one
+   *      column of point indices per dimension.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   */
+  template<typename MatType, typename LabelsType, typename WeightsType>
+  DecisionTree(
+      const DecisionTree& other,
+      MatType data,
+      LabelsType labels,
+      const size_t numClasses,
+      WeightsType weights,
+      const arma::umat& sortedOrders,
+      const size_t minimumLeafSize = 10,
+      const double minimumGainSplit = 1e-7,
+      const size_t maximumDepth = 0,
+      DimensionSelectionType dimensionSelector = DimensionSelectionType(),
+      const std::enable_if_t<arma::is_arma_type<
+          typename std::remove_reference<WeightsType>::type>::value>* = 0);
+
   /**
    * Construct a decision tree without training it.  It will be a leaf node with
    * equal probabilities for each class.
@@ -464,6 +509,18 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the type of the split dimension, as an element of data::Datatype
+  //! (only meaningful if this is a non-leaf in a trained tree).
+  size_t DimensionType() const { return dimensionType; }
+
+  //! Get the majority class (only meaningful if this is a leaf in a trained
+  //! tree).
+  size_t MajorityClass() const { return majorityClass; }
+
+  //! Get the class probabilities, if this is a leaf in a trained tree, or the
+  //! split information, if it is a non-leaf.
+  const arma::vec& ClassProbabilities() const { return classProbabilities; }
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -562,6 +619,10 @@ class DecisionTree :
    * @param minimumLeafSize Minimum number of points in each leaf node.
    * @param minimumGainSplit Minimum gain for the node to split.
    * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param sortedOrders If non-NULL, the precomputed sorted order of each
+   *      dimension (one column of point indices per dimension), valid only
+   *      for the root scan over all points; child nodes ignore it.
    * @return The final entropy of decision tree.
    */
   template<bool UseWeights, typename MatType>
@@ -574,7 +635,8 @@ class DecisionTree :
                const size_t minimumLeafSize,
                const double minimumGainSplit,
                const size_t maximumDepth,
-               DimensionSelectionType& dimensionSelector);
+               DimensionSelectionType& dimensionSelector,
+               const arma::umat* sortedOrders = NULL);
 };
 
 /**
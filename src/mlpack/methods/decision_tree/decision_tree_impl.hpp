@@ -17,6 +17,59 @@
 namespace mlpack {
 namespace tree {
 
+namespace details {
+
+// Call the numeric splitter's sorted-order SplitIfBetter() if it provides
+// one (e.g. BestBinaryNumericSplit); the `int` overload is preferred when
+// the expression is well-formed.  The extra `int`/`long` parameter ranks the
+// two overloads.
+template<bool UseWeights, typename SplitType, typename VecType,
+         typename IndexVecType, typename WeightVecType>
+auto SortedOrderSplitIfBetter(
+    int,
+    const double bestGain,
+    const VecType& data,
+    const IndexVecType& sortedIndices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    typename SplitType::AuxiliarySplitInfo& aux)
+    -> decltype(SplitType::template SplitIfBetter<UseWeights>(bestGain, data,
+        sortedIndices, labels, numClasses, weights, minimumLeafSize,
+        minimumGainSplit, splitInfo, aux))
+{
+  return SplitType::template SplitIfBetter<UseWeights>(bestGain, data,
+      sortedIndices, labels, numClasses, weights, minimumLeafSize,
+      minimumGainSplit, splitInfo, aux);
+}
+
+// Fallback for splitters without a sorted-order overload: the precomputed
+// order is of no use, so search the split as usual.
+template<bool UseWeights, typename SplitType, typename VecType,
+         typename IndexVecType, typename WeightVecType>
+double SortedOrderSplitIfBetter(
+    long,
+    const double bestGain,
+    const VecType& data,
+    const IndexVecType& /* sortedIndices */,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    typename SplitType::AuxiliarySplitInfo& aux)
+{
+  return SplitType::template SplitIfBetter<UseWeights>(bestGain, data,
+      labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+      splitInfo, aux);
+}
+
+} // namespace details
+
 //! Construct and train without weight.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -258,6 +311,61 @@ DecisionTree<FitnessFunction,
       minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
 }
 
+//! Construct and train with weights and a precomputed sorted-order cache.
+template<typename FitnessFunction,
+        template<typename> class NumericSplitType,
+        template<typename> class CategoricalSplitType,
+        typename DimensionSelectionType,
+        bool NoRecursion>
+template<typename MatType, typename LabelsType, typename WeightsType>
+DecisionTree<FitnessFunction,
+        NumericSplitType,
+        CategoricalSplitType,
+        DimensionSelectionType,
+        NoRecursion>::DecisionTree(
+    const DecisionTree& other,
+    MatType data,
+    LabelsType labels,
+    const size_t numClasses,
+    WeightsType weights,
+    const arma::umat& sortedOrders,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const std::enable_if_t<arma::is_arma_type<
+        typename std::remove_reference<
+        WeightsType>::type>::value>*):
+        NumericAuxiliarySplitInfo(other),
+        CategoricalAuxiliarySplitInfo(other)  // other info does need to copy
+{
+  using TrueMatType = typename std::decay<MatType>::type;
+  using TrueLabelsType = typename std::decay<LabelsType>::type;
+  using TrueWeightsType = typename std::decay<WeightsType>::type;
+
+  // Copy or move data.
+  TrueMatType tmpData(std::move(data));
+  TrueLabelsType tmpLabels(std::move(labels));
+  TrueWeightsType tmpWeights(std::move(weights));
+
+  // Sanity check the cache dimensions: one column of point indices per
+  // dimension of the data.
+  if (sortedOrders.n_rows != tmpData.n_cols ||
+      sortedOrders.n_cols != tmpData.n_rows)
+  {
+    throw std::invalid_argument("DecisionTree: sortedOrders must have one "
+        "column of point indices per dimension of the data!");
+  }
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = tmpData.n_rows;
+
+  // Pass off work to the weighted Train() method.
+  Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
+      &sortedOrders);
+}
+
 //! Construct, don't train.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -654,13 +762,20 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
-    for (size_t i = dimensionSelector.Begin(); i != end;
-         i = dimensionSelector.Next())
+    // The gain computation of one dimension is independent of all others, so
+    // large nodes can scan their candidate dimensions in parallel.  This
+    // helper computes the gain of a single dimension against the given gain
+    // bound, writing the split information into the given buffer.
+    auto splitGain = [&](const size_t i,
+                         const double gainBound,
+                         arma::vec& splitInfo,
+                         NumericAuxiliarySplitInfo& numericAux,
+                         CategoricalAuxiliarySplitInfo& categoricalAux)
+        -> double
     {
-      double dimGain = -DBL_MAX;
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
-        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+        return CategoricalSplit::template SplitIfBetter<UseWeights>(gainBound,
             data.cols(begin, begin + count - 1).row(i),
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
@@ -668,34 +783,105 @@ double DecisionTree<FitnessFunction,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            splitInfo,
+            categoricalAux);
       }
-      else if (datasetInfo.Type(i) == data::Datatype::numeric)
+      else
       {
-        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+        return NumericSplit::template SplitIfBetter<UseWeights>(gainBound,
             data.cols(begin, begin + count - 1).row(i),
             labels.subvec(begin, begin + count - 1),
             numClasses,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            splitInfo,
+            numericAux);
+      }
+    };
+
+    // Small nodes are scanned serially---the candidate materialization and
+    // per-dimension buffers of the parallel scan are not worth it---and so is
+    // any node that is already being built inside a subtree task (nested
+    // parallel regions are inactive by default).
+    bool parallelScan = false;
+    #ifdef HAS_OPENMP
+    parallelScan = (count >= 1000) && (omp_get_max_threads() > 1) &&
+        !omp_in_parallel();
+    #endif
+
+    if (parallelScan)
+    {
+      // Materialize the candidate dimensions; the dimension selector is
+      // stateful and must be stepped serially.
+      std::vector<size_t> candidateDims;
+      for (size_t i = dimensionSelector.Begin(); i != end;
+           i = dimensionSelector.Next())
+        candidateDims.push_back(i);
+
+      // Every dimension gets its own gain, split information, and auxiliary
+      // split information buffer, so the threads share no state.  Each
+      // dimension is evaluated against the unsplit gain of the node, not a
+      // running best, which may do a little extra work but gives the same
+      // split as the serial scan.
+      arma::vec dimGains(candidateDims.size());
+      dimGains.fill(DBL_MAX);
+      std::vector<arma::vec> dimSplitInfos(candidateDims.size());
+      std::vector<NumericAuxiliarySplitInfo> dimNumericAuxes(
+          candidateDims.size());
+      std::vector<CategoricalAuxiliarySplitInfo> dimCategoricalAuxes(
+          candidateDims.size());
+
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t k = 0; k < (omp_size_t) candidateDims.size(); ++k)
+      {
+        dimGains[k] = splitGain(candidateDims[k], bestGain, dimSplitInfos[k],
+            dimNumericAuxes[k], dimCategoricalAuxes[k]);
       }
 
-      // If the splitter reported that it did not split, move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
-        continue;
-
-      // Was there an improvement?  If so mark that it's the new best dimension.
-      bestDim = i;
-      bestGain = dimGain;
-
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
+      // Reduce to the best dimension; ties go to the earlier dimension, the
+      // same as the serial scan.
+      for (size_t k = 0; k < candidateDims.size(); ++k)
+      {
+        if (dimGains[k] == DBL_MAX)
+          continue;
+        if (bestDim != datasetInfo.Dimensionality() && dimGains[k] <= bestGain)
+          continue;
+
+        bestDim = candidateDims[k];
+        bestGain = dimGains[k];
+        classProbabilities = std::move(dimSplitInfos[k]);
+        NumericAuxiliarySplitInfo::operator=(std::move(dimNumericAuxes[k]));
+        CategoricalAuxiliarySplitInfo::operator=(
+            std::move(dimCategoricalAuxes[k]));
+
+        // If the gain is the best possible, no need to keep looking.
+        if (bestGain >= 0.0)
+          break;
+      }
+    }
+    else
+    {
+      for (size_t i = dimensionSelector.Begin(); i != end;
+           i = dimensionSelector.Next())
+      {
+        const double dimGain = splitGain(i, bestGain, classProbabilities,
+            *this, *this);
+
+        // If the splitter reported that it did not split, move to the next
+        // dimension.
+        if (dimGain == DBL_MAX)
+          continue;
+
+        // Was there an improvement?  If so mark that it's the new best
+        // dimension.
+        bestDim = i;
+        bestGain = dimGain;
+
+        // If the gain is the best possible, no need to keep looking.
+        if (bestGain >= 0.0)
+          break;
+      }
     }
   }
 
@@ -740,12 +926,16 @@ double DecisionTree<FitnessFunction,
       bestGain = 0.0;
     }
 
-    // Split into children.
+    // Partition the data so that every child's points are contiguous, before
+    // building any subtree.  Since each child then touches only its own
+    // disjoint column range, the recursive builds are independent of each
+    // other and can run as OpenMP tasks near the top of the tree.
+    arma::Row<size_t> childBegins(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -757,26 +947,77 @@ double DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
+      children.push_back(new DecisionTree());
+    }
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
+    // Build one child; its gain is stored so that the parent's gain can be
+    // accumulated after all the builds have finished.
+    std::vector<double> childGains(numChildren, 0.0);
+    auto trainChild = [&](const size_t i)
+    {
+      // Each child gets its own dimension selector, since the selectors are
+      // stateful.
+      DimensionSelectionType childSelector(dimensionSelector);
       if (NoRecursion)
       {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
+        children[i]->Train<UseWeights>(data, childBegins[i], childCounts[i],
+            datasetInfo, labels, numClasses, weights, childCounts[i],
+            minimumGainSplit, maximumDepth - 1, childSelector);
       }
       else
       {
         // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        childGains[i] = children[i]->Train<UseWeights>(data, childBegins[i],
+            childCounts[i], datasetInfo, labels, numClasses, weights,
+            minimumLeafSize, minimumGainSplit, maximumDepth - 1, childSelector);
+      }
+    };
+
+    #if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+    // Subtrees with enough points are built as OpenMP tasks; smaller ones are
+    // built inline by whichever thread reaches them, since the scheduling
+    // overhead would outweigh the work.
+    const size_t minimumTaskSize = 10000;
+    const bool useTasks = (count >= 2 * minimumTaskSize);
+    if (useTasks && !omp_in_parallel())
+    {
+      // We are at (or near) the root, so create the task team here.
+      #pragma omp parallel
+      #pragma omp single
+      {
+        for (size_t i = 0; i < numChildren; ++i)
+        {
+          #pragma omp task default(shared) firstprivate(i) \
+              if (childCounts[i] >= minimumTaskSize)
+          trainChild(i);
+        }
+      }
+    }
+    else if (useTasks)
+    {
+      // We are inside the task team of an ancestor node; nest further tasks.
+      for (size_t i = 0; i < numChildren; ++i)
+      {
+        #pragma omp task default(shared) firstprivate(i) \
+            if (childCounts[i] >= minimumTaskSize)
+        trainChild(i);
       }
-      children.push_back(child);
+      #pragma omp taskwait
+    }
+    else
+    {
+      for (size_t i = 0; i < numChildren; ++i)
+        trainChild(i);
+    }
+    #else
+    for (size_t i = 0; i < numChildren; ++i)
+      trainChild(i);
+    #endif
+
+    if (!NoRecursion)
+    {
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -816,7 +1057,8 @@ double DecisionTree<FitnessFunction,
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     const size_t maximumDepth,
-    DimensionSelectionType& dimensionSelector)
+    DimensionSelectionType& dimensionSelector,
+    const arma::umat* sortedOrders)
 {
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
@@ -826,6 +1068,11 @@ double DecisionTree<FitnessFunction,
   // We won't be using these members, so reset them.
   CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
 
+  // The precomputed sorted orders are only valid for a scan over the whole
+  // dataset in its original column order, i.e. for this node being the root.
+  const bool useSortedOrders = (sortedOrders != NULL) && (begin == 0) &&
+      (count == data.n_cols);
+
   // Look through the list of dimensions and obtain the best split.  We'll cache
   // the best numeric split auxiliary information in numericAux (and clear it
   // later if we don't make a split), and use classProbabilities as auxiliary
@@ -839,11 +1086,36 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
-    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
-         i = dimensionSelector.Next())
+    // The gain computation of one dimension is independent of all others, so
+    // large nodes can scan their candidate dimensions in parallel.  This
+    // helper computes the gain of a single dimension against the given gain
+    // bound, writing the split information into the given buffer.
+    auto splitGain = [&](const size_t i,
+                         const double gainBound,
+                         arma::vec& splitInfo,
+                         NumericAuxiliarySplitInfo& numericAux) -> double
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
-          SplitIfBetter<UseWeights>(bestGain,
+      if (useSortedOrders)
+      {
+        // Reuse the cached sorted order of this dimension; for splitters
+        // with a sorted-order overload this skips the O(n log n) sort.
+        return details::SortedOrderSplitIfBetter<UseWeights,
+            NumericSplitType<FitnessFunction>>(0, gainBound,
+                data.cols(begin, begin + count - 1).row(i),
+                sortedOrders->unsafe_col(i),
+                labels.cols(begin, begin + count - 1),
+                numClasses,
+                UseWeights ?
+                    weights.cols(begin, begin + count - 1) :
+                    weights,
+                minimumLeafSize,
+                minimumGainSplit,
+                splitInfo,
+                numericAux);
+      }
+
+      return NumericSplitType<FitnessFunction>::template
+          SplitIfBetter<UseWeights>(gainBound,
                                     data.cols(begin, begin + count - 1).row(i),
                                     labels.cols(begin, begin + count - 1),
                                     numClasses,
@@ -852,20 +1124,85 @@ double DecisionTree<FitnessFunction,
                                         weights,
                                     minimumLeafSize,
                                     minimumGainSplit,
-                                    classProbabilities,
-                                    *this);
+                                    splitInfo,
+                                    numericAux);
+    };
+
+    // Small nodes are scanned serially, and so is any node that is already
+    // being built inside a subtree task (nested parallel regions are inactive
+    // by default).
+    bool parallelScan = false;
+    #ifdef HAS_OPENMP
+    parallelScan = (count >= 1000) && (omp_get_max_threads() > 1) &&
+        !omp_in_parallel();
+    #endif
+
+    if (parallelScan)
+    {
+      // Materialize the candidate dimensions; the dimension selector is
+      // stateful and must be stepped serially.
+      std::vector<size_t> candidateDims;
+      for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+           i = dimensionSelector.Next())
+        candidateDims.push_back(i);
+
+      // Every dimension gets its own gain, split information, and auxiliary
+      // split information buffer, so the threads share no state.  Each
+      // dimension is evaluated against the unsplit gain of the node, not a
+      // running best, which may do a little extra work but gives the same
+      // split as the serial scan.
+      arma::vec dimGains(candidateDims.size());
+      dimGains.fill(DBL_MAX);
+      std::vector<arma::vec> dimSplitInfos(candidateDims.size());
+      std::vector<NumericAuxiliarySplitInfo> dimNumericAuxes(
+          candidateDims.size());
+
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t k = 0; k < (omp_size_t) candidateDims.size(); ++k)
+      {
+        dimGains[k] = splitGain(candidateDims[k], bestGain, dimSplitInfos[k],
+            dimNumericAuxes[k]);
+      }
+
+      // Reduce to the best dimension; ties go to the earlier dimension, the
+      // same as the serial scan.
+      for (size_t k = 0; k < candidateDims.size(); ++k)
+      {
+        if (dimGains[k] == DBL_MAX)
+          continue;
+        if (bestDim != data.n_rows && dimGains[k] <= bestGain)
+          continue;
+
+        bestDim = candidateDims[k];
+        bestGain = dimGains[k];
+        classProbabilities = std::move(dimSplitInfos[k]);
+        NumericAuxiliarySplitInfo::operator=(std::move(dimNumericAuxes[k]));
+
+        // If the gain is the best possible, no need to keep looking.
+        if (bestGain >= 0.0)
+          break;
+      }
+    }
+    else
+    {
+      for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+           i = dimensionSelector.Next())
+      {
+        const double dimGain = splitGain(i, bestGain, classProbabilities,
+            *this);
 
-      // If the splitter did not report that it improved, then move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
-        continue;
+        // If the splitter did not report that it improved, then move to the
+        // next dimension.
+        if (dimGain == DBL_MAX)
+          continue;
 
-      bestDim = i;
-      bestGain = dimGain;
+        bestDim = i;
+        bestGain = dimGain;
 
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
+        // If the gain is the best possible, no need to keep looking.
+        if (bestGain >= 0.0)
+          break;
+      }
     }
   }
 
@@ -899,11 +1236,16 @@ double DecisionTree<FitnessFunction,
       bestGain = 0.0;
     }
 
+    // Partition the data so that every child's points are contiguous, before
+    // building any subtree.  Since each child then touches only its own
+    // disjoint column range, the recursive builds are independent of each
+    // other and can run as OpenMP tasks near the top of the tree.
+    arma::Row<size_t> childBegins(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -915,26 +1257,77 @@ double DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
+      children.push_back(new DecisionTree());
+    }
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
+    // Build one child; its gain is stored so that the parent's gain can be
+    // accumulated after all the builds have finished.
+    std::vector<double> childGains(numChildren, 0.0);
+    auto trainChild = [&](const size_t i)
+    {
+      // Each child gets its own dimension selector, since the selectors are
+      // stateful.
+      DimensionSelectionType childSelector(dimensionSelector);
       if (NoRecursion)
       {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+        children[i]->Train<UseWeights>(data, childBegins[i], childCounts[i],
+            labels, numClasses, weights, childCounts[i], minimumGainSplit,
+            maximumDepth - 1, childSelector);
       }
       else
       {
         // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        childGains[i] = children[i]->Train<UseWeights>(data, childBegins[i],
+            childCounts[i], labels, numClasses, weights, minimumLeafSize,
+            minimumGainSplit, maximumDepth - 1, childSelector);
+      }
+    };
+
+    #if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+    // Subtrees with enough points are built as OpenMP tasks; smaller ones are
+    // built inline by whichever thread reaches them, since the scheduling
+    // overhead would outweigh the work.
+    const size_t minimumTaskSize = 10000;
+    const bool useTasks = (count >= 2 * minimumTaskSize);
+    if (useTasks && !omp_in_parallel())
+    {
+      // We are at (or near) the root, so create the task team here.
+      #pragma omp parallel
+      #pragma omp single
+      {
+        for (size_t i = 0; i < numChildren; ++i)
+        {
+          #pragma omp task default(shared) firstprivate(i) \
+              if (childCounts[i] >= minimumTaskSize)
+          trainChild(i);
+        }
+      }
+    }
+    else if (useTasks)
+    {
+      // We are inside the task team of an ancestor node; nest further tasks.
+      for (size_t i = 0; i < numChildren; ++i)
+      {
+        #pragma omp task default(shared) firstprivate(i) \
+            if (childCounts[i] >= minimumTaskSize)
+        trainChild(i);
       }
-      children.push_back(child);
+      #pragma omp taskwait
+    }
+    else
+    {
+      for (size_t i = 0; i < numChildren; ++i)
+        trainChild(i);
+    }
+    #else
+    for (size_t i = 0; i < numChildren; ++i)
+      trainChild(i);
+    #endif
+
+    if (!NoRecursion)
+    {
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -1092,6 +1485,11 @@ void DecisionTree<FitnessFunction,
   // Since dimensionType and majorityClass are a union, we only need to serialize one.
   ar(CEREAL_NVP(dimensionType));
   ar(CEREAL_NVP(classProbabilities));
+
+  // Serialize the auxiliary split information, since some split types (e.g.
+  // BestBinaryCategoricalSplit) store their split state there.
+  ar(cereal::base_class<NumericAuxiliarySplitInfo>(this));
+  ar(cereal::base_class<CategoricalAuxiliarySplitInfo>(this));
 }
 
 template<typename FitnessFunction,
@@ -17,9 +17,12 @@
 #include "mad_gain.hpp"
 #include "mse_gain.hpp"
 #include "best_binary_numeric_split.hpp"
+#include "histogram_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
+#include "best_binary_categorical_split.hpp"
 #include "random_binary_numeric_split.hpp"
 #include "all_dimension_select.hpp"
+#include <cereal/types/base_class.hpp>
 #include <type_traits>
 
 
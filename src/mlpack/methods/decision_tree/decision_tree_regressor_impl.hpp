@@ -1037,6 +1037,11 @@ void DecisionTreeRegressor<FitnessFunction,
   ar(CEREAL_NVP(splitPoint));
   // Since splitPoint and prediction are a union, we only need to serialize one of them.
   ar(CEREAL_NVP(splitPoint));
+
+  // Serialize the auxiliary split information, since some split types (e.g.
+  // BestBinaryCategoricalSplit) store their split state there.
+  ar(cereal::base_class<NumericAuxiliarySplitInfo>(this));
+  ar(cereal::base_class<CategoricalAuxiliarySplitInfo>(this));
 }
 
 //! Return the number of leaves.
@@ -0,0 +1,168 @@
+/**
+ * @file methods/decision_tree/flat_decision_tree.hpp
+ * @author Ryan Curtin
+ *
+ * A read-only, flattened representation of a trained decision tree, for
+ * low-latency scoring.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_HPP
+#define MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A FlatDecisionTree is a read-only representation of a trained DecisionTree
+ * that stores all of the nodes in one contiguous array, in breadth-first
+ * order, with 16 bytes per node.  Classification walks the array with a
+ * branch-light loop instead of chasing a heap-allocated child pointer at each
+ * level, which makes scoring both faster and much friendlier to the cache.
+ *
+ * A flat tree is built from a trained tree with Build() (or the matching
+ * constructor) and holds its own copy of everything it needs, so it may
+ * outlive the tree it was built from.  It cannot be trained or modified; to
+ * pick up a retrained tree, build a new flat tree.
+ *
+ * The flattened traversal supports the binary threshold numeric splitters
+ * (BestBinaryNumericSplit, RandomBinaryNumericSplit,
+ * HistogramBinaryNumericSplit) and, via a per-category direction table built
+ * at flattening time, any categorical splitter that provides NumCategories()
+ * (AllCategoricalSplit and BestBinaryCategoricalSplit)---which covers every
+ * splitter shipped with mlpack.
+ */
+class FlatDecisionTree
+{
+ public:
+  /**
+   * One node of the flattened tree (16 bytes).  The children of a node are
+   * laid out contiguously, so a node only needs the index of its first child;
+   * the child to descend to is that index plus the direction of the point.
+   */
+  struct FlatNode
+  {
+    //! The dimension this node splits on.  The high bit is set if the
+    //! dimension is categorical, and leaves hold leafMarker here.
+    uint32_t splitDimension;
+    //! The index of this node's first child.  For a leaf, this instead holds
+    //! the index of the leaf's column in LeafProbabilities().
+    uint32_t child;
+    //! The numeric split threshold: points with values less than or equal to
+    //! this go to the first child.  For categorical splits this instead holds
+    //! the offset of the node's direction table in CategoryDirections().
+    double splitInfo;
+  };
+
+  //! The value held in FlatNode::splitDimension by leaf nodes.
+  static const uint32_t leafMarker = 0xFFFFFFFF;
+  //! The bit set in FlatNode::splitDimension by categorical splits.
+  static const uint32_t categoricalMask = 0x80000000;
+
+  /**
+   * Construct an empty flat tree; it cannot classify anything until Build()
+   * is called.
+   */
+  FlatDecisionTree();
+
+  /**
+   * Construct a flat tree from the given trained decision tree.
+   *
+   * @param tree Trained decision tree to flatten.
+   */
+  template<typename TreeType>
+  explicit FlatDecisionTree(const TreeType& tree);
+
+  /**
+   * Flatten the given trained decision tree into this object, replacing
+   * anything that was built before.
+   *
+   * @param tree Trained decision tree to flatten.
+   */
+  template<typename TreeType>
+  void Build(const TreeType& tree);
+
+  /**
+   * Classify the given point, returning the predicted label.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given point and also return estimates of the probability for
+   * each class in the given vector.
+   *
+   * @param point Point to classify.
+   * @param prediction This will be set to the predicted class of the point.
+   * @param probabilities This will be filled with class probabilities for the
+   *      point.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Classify the given points, storing the predicted labels in the given
+   * vector.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions) const;
+
+  /**
+   * Walk the tree for the given point and return the index of the leaf the
+   * point falls into; the index is the leaf's column in LeafProbabilities().
+   *
+   * @param point Point to walk the tree with.
+   */
+  template<typename VecType>
+  size_t WalkToLeaf(const VecType& point) const;
+
+  //! Get the flattened nodes, in breadth-first order.
+  const std::vector<FlatNode>& Nodes() const { return nodes; }
+
+  //! Get the concatenated per-category child directions of the categorical
+  //! split nodes; each categorical node's FlatNode::splitInfo holds the offset
+  //! of its own table.
+  const std::vector<uint32_t>& CategoryDirections() const
+  {
+    return categoryDirections;
+  }
+
+  //! Get the class probabilities of each leaf (one column per leaf).
+  const arma::mat& LeafProbabilities() const { return leafProbabilities; }
+
+  //! Get the number of classes in the tree.
+  size_t NumClasses() const { return numClasses; }
+
+ private:
+  //! The nodes of the tree, in breadth-first order.
+  std::vector<FlatNode> nodes;
+  //! The per-category child directions of the categorical split nodes.
+  std::vector<uint32_t> categoryDirections;
+  //! The class probabilities of each leaf, one column per leaf.
+  arma::mat leafProbabilities;
+  //! The majority class of each leaf.
+  arma::Row<size_t> leafClasses;
+  //! The number of classes in the tree.
+  size_t numClasses;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_decision_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file methods/decision_tree/flat_decision_tree_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the FlatDecisionTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_IMPL_HPP
+
+#include "flat_decision_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+inline FlatDecisionTree::FlatDecisionTree() : numClasses(0)
+{
+  // Nothing to do here.
+}
+
+template<typename TreeType>
+FlatDecisionTree::FlatDecisionTree(const TreeType& tree)
+{
+  Build(tree);
+}
+
+template<typename TreeType>
+void FlatDecisionTree::Build(const TreeType& tree)
+{
+  numClasses = tree.NumClasses();
+  categoryDirections.clear();
+
+  // Lay the nodes out in breadth-first order, so that the children of any
+  // node are contiguous and each node only needs the index of its first
+  // child.  We also collect the leaves, so that their class probabilities can
+  // be cached afterwards.
+  std::vector<const TreeType*> order;
+  std::vector<const TreeType*> leaves;
+  order.push_back(&tree);
+  nodes.resize(1);
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    const TreeType& node = *order[i];
+    if (node.NumChildren() == 0)
+    {
+      nodes[i].splitDimension = leafMarker;
+      nodes[i].child = (uint32_t) leaves.size();
+      nodes[i].splitInfo = 0.0;
+      leaves.push_back(&node);
+      continue;
+    }
+
+    nodes[i].splitDimension = (uint32_t) node.SplitDimension();
+    if (node.DimensionType() == (size_t) data::Datatype::categorical)
+    {
+      nodes[i].splitDimension |= categoricalMask;
+
+      // Tabulate the direction of every category of the split dimension, so
+      // that traversal does not need the (type-erased) splitter; the node's
+      // splitInfo holds the offset of its table.
+      const size_t numCategories = TreeType::CategoricalSplit::NumCategories(
+          node.ClassProbabilities()[0], node);
+      nodes[i].splitInfo = (double) categoryDirections.size();
+      for (size_t c = 0; c < numCategories; ++c)
+      {
+        categoryDirections.push_back((uint32_t)
+            TreeType::CategoricalSplit::CalculateDirection((double) c,
+            node.ClassProbabilities()[0], node));
+      }
+    }
+    else
+    {
+      nodes[i].splitInfo = node.ClassProbabilities()[0];
+    }
+    nodes[i].child = (uint32_t) order.size();
+
+    for (size_t c = 0; c < node.NumChildren(); ++c)
+      order.push_back(&node.Child(c));
+    nodes.resize(order.size());
+  }
+
+  // Cache the class probabilities and majority class of every leaf.
+  leafProbabilities.set_size(numClasses, leaves.size());
+  leafClasses.set_size(leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    leafProbabilities.col(i) = leaves[i]->ClassProbabilities();
+    leafClasses[i] = leaves[i]->MajorityClass();
+  }
+}
+
+template<typename VecType>
+size_t FlatDecisionTree::WalkToLeaf(const VecType& point) const
+{
+  uint32_t index = 0;
+  uint32_t dim = nodes[0].splitDimension;
+  while (dim != leafMarker)
+  {
+    const FlatNode& node = nodes[index];
+    if (dim & categoricalMask)
+    {
+      index = node.child + categoryDirections[(size_t) node.splitInfo +
+          (size_t) point[dim & ~categoricalMask]];
+    }
+    else
+    {
+      index = node.child + (uint32_t) (point[dim] > node.splitInfo);
+    }
+    dim = nodes[index].splitDimension;
+  }
+
+  return (size_t) nodes[index].child;
+}
+
+template<typename VecType>
+size_t FlatDecisionTree::Classify(const VecType& point) const
+{
+  return leafClasses[WalkToLeaf(point)];
+}
+
+template<typename VecType>
+void FlatDecisionTree::Classify(const VecType& point,
+                                size_t& prediction,
+                                arma::vec& probabilities) const
+{
+  const size_t leaf = WalkToLeaf(point);
+  probabilities = leafProbabilities.col(leaf);
+  prediction = leafClasses[leaf];
+}
+
+template<typename MatType>
+void FlatDecisionTree::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions) const
+{
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < data.n_cols; ++i)
+    predictions[i] = Classify(data.col(i));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
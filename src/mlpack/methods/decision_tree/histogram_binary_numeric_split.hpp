@@ -0,0 +1,218 @@
+/**
+ * @file methods/decision_tree/histogram_binary_numeric_split.hpp
+ * @author Ryan Curtin
+ *
+ * A tree splitter that finds a good binary numeric split from a histogram of
+ * the dimension's values, avoiding the per-node sort of
+ * BestBinaryNumericSplit.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "best_binary_numeric_split.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The HistogramBinaryNumericSplit is a splitting function for decision trees
+ * that quantizes a numeric dimension into at most `MaxBins()` equal-width bins
+ * and considers only the bin boundaries as split candidates.  Building the
+ * histogram is a single O(n) pass (instead of the O(n log n) sort that
+ * BestBinaryNumericSplit performs at every node), and the gain scan touches at
+ * most `MaxBins()` candidates, which makes tree construction dramatically
+ * faster on large datasets at a small cost in split resolution.
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{Ke17,
+ *   author    = {Guolin Ke and Qi Meng and Thomas Finley and Taifeng Wang and
+ *                Wei Chen and Weidong Ma and Qiwei Ye and Tie-Yan Liu},
+ *   title     = {LightGBM: A Highly Efficient Gradient Boosting Decision
+ *                Tree},
+ *   booktitle = {Advances in Neural Information Processing Systems 30},
+ *   year      = {2017}
+ * }
+ * @endcode
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction>
+class HistogramBinaryNumericSplit
+{
+ public:
+  // No extra info needed for split.
+  class AuxiliarySplitInfo
+  {
+   public:
+    //! Nothing to serialize.
+    template<typename Archive>
+    void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+  };
+
+  //! The maximum number of histogram bins used per dimension.
+  static size_t MaxBins() { return 256; }
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is used only for classification tasks.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is used only for regression tasks.  The points are grouped
+   * by bin with a counting sort (O(n)), and the gain is evaluated only at the
+   * bin boundaries.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   * @param fitnessFunction The FitnessFunction object instance. It it used to
+   *      evaluate the gain for the split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType>
+  static typename std::enable_if<
+      !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+      double>::type
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      double& splitInfo,
+      AuxiliarySplitInfo& aux,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is specialized for any fitness function that implements
+   * BinaryScanInitialize(), BinaryStep() and BinaryGains() functions; the
+   * scan over the bin-grouped points is O(n), and gains are computed only at
+   * the bin boundaries.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+          typename WeightVecType>
+  static typename std::enable_if<
+      HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+      double>::type
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      double& splitInfo,
+      AuxiliarySplitInfo& /* aux */,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * Returns 2, since the binary split always has two children.
+   */
+  static size_t NumChildren(const double& /* splitInfo */,
+                            const AuxiliarySplitInfo& /* aux */)
+  {
+    return 2;
+  }
+
+  /**
+   * Given a point, calculate which child it should go to (left or right).
+   *
+   * @param point Point to calculate direction of.
+   * @param splitInfo Auxiliary information for the split.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const double& splitInfo,
+      const AuxiliarySplitInfo& /* aux */);
+
+ private:
+  /**
+   * Assign each point to one of at most `MaxBins()` equal-width bins, filling
+   * `assignments` with the bin index of each point and `binCounts` with the
+   * number of points in each bin.  Returns false if the dimension is constant
+   * (and thus cannot be split).
+   */
+  template<typename VecType>
+  static bool BinData(const VecType& data,
+                      arma::Row<size_t>& assignments,
+                      arma::Row<size_t>& binCounts,
+                      double& minValue,
+                      double& binWidth);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_binary_numeric_split_impl.hpp"
+
+#endif
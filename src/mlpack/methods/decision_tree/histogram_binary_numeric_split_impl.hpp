@@ -0,0 +1,537 @@
+/**
+ * @file methods/decision_tree/histogram_binary_numeric_split_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the histogram-based binary numeric split strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<typename VecType>
+bool HistogramBinaryNumericSplit<FitnessFunction>::BinData(
+    const VecType& data,
+    arma::Row<size_t>& assignments,
+    arma::Row<size_t>& binCounts,
+    double& minValue,
+    double& binWidth)
+{
+  minValue = (double) data.min();
+  const double maxValue = (double) data.max();
+
+  // If the dimension is constant, we can't split.
+  if (minValue == maxValue)
+    return false;
+
+  const size_t numBins = std::min(MaxBins(), (size_t) data.n_elem);
+  binWidth = (maxValue - minValue) / numBins;
+
+  assignments.set_size(data.n_elem);
+  binCounts.zeros(numBins);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    size_t bin = (size_t) (((double) data[i] - minValue) / binWidth);
+    // Guard against floating point rounding at the top edge.
+    if (bin >= numBins)
+      bin = numBins - 1;
+
+    assignments[i] = bin;
+    ++binCounts[bin];
+  }
+
+  return true;
+}
+
+// Overload used for classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Quantize the dimension into equal-width bins in a single pass (instead of
+  // sorting it).
+  arma::Row<size_t> assignments, binCounts;
+  double minValue, binWidth;
+  if (!BinData(data, assignments, binCounts, minValue, binWidth))
+    return DBL_MAX;
+  const size_t numBins = binCounts.n_elem;
+
+  // Build the per-bin class histogram.
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
+  double totalWeight = 0.0;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, numBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      classWeightSums(labels[i], assignments[i]) += weights[i];
+      totalWeight += weights[i];
+    }
+  }
+  else
+  {
+    classCounts.zeros(numClasses, numBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+      ++classCounts(labels[i], assignments[i]);
+  }
+
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+  if (UseWeights)
+    bestFoundGain *= totalWeight;
+  else
+    bestFoundGain *= data.n_elem;
+
+  // Scan the bin boundaries (the only candidate split points), accumulating
+  // the left-child statistics as we go.
+  arma::Col<size_t> leftCounts, rightCounts;
+  arma::vec leftWeightSums, rightWeightSums;
+  if (UseWeights)
+  {
+    leftWeightSums.zeros(numClasses);
+    rightWeightSums = arma::sum(classWeightSums, 1);
+  }
+  else
+  {
+    leftCounts.zeros(numClasses);
+    rightCounts = arma::sum(classCounts, 1);
+  }
+
+  size_t leftPoints = 0;
+  double leftWeight = 0.0;
+  double rightWeight = totalWeight;
+  for (size_t bin = 0; bin + 1 < numBins; ++bin)
+  {
+    if (UseWeights)
+    {
+      const double binWeight = arma::accu(classWeightSums.col(bin));
+      leftWeightSums += classWeightSums.col(bin);
+      rightWeightSums -= classWeightSums.col(bin);
+      leftWeight += binWeight;
+      rightWeight -= binWeight;
+    }
+    else
+    {
+      leftCounts += classCounts.col(bin);
+      rightCounts -= classCounts.col(bin);
+    }
+    leftPoints += binCounts[bin];
+    const size_t rightPoints = data.n_elem - leftPoints;
+
+    // An empty bin yields the same partition as the previous boundary.
+    if (binCounts[bin] == 0)
+      continue;
+    if (leftPoints < minimum)
+      continue;
+    if (rightPoints < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(leftWeightSums.memptr(),
+            numClasses, leftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(leftCounts.memptr(),
+            numClasses, leftPoints);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(rightWeightSums.memptr(),
+            numClasses, rightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(rightCounts.memptr(),
+            numClasses, rightPoints);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftWeight * leftGain + rightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(leftPoints) * leftGain + double(rightPoints) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      splitInfo.set_size(1);
+      splitInfo[0] = minValue + binWidth * (bin + 1);
+
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = minValue + binWidth * (bin + 1);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Overload used for regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Quantize the dimension into equal-width bins in a single pass (instead of
+  // sorting it).
+  arma::Row<size_t> assignments, binCounts;
+  double minValue, binWidth;
+  if (!BinData(data, assignments, binCounts, minValue, binWidth))
+    return DBL_MAX;
+  const size_t numBins = binCounts.n_elem;
+
+  // Group the responses (and weights) by bin with a counting sort.
+  arma::Row<size_t> binStarts(numBins + 1);
+  binStarts[0] = 0;
+  for (size_t bin = 0; bin < numBins; ++bin)
+    binStarts[bin + 1] = binStarts[bin] + binCounts[bin];
+
+  arma::Row<size_t> positions = binStarts.subvec(0, numBins - 1);
+  arma::Row<RType> sortedResponses(responses.n_elem);
+  arma::Row<WType> sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(responses.n_elem);
+  for (size_t i = 0; i < responses.n_elem; ++i)
+  {
+    const size_t position = positions[assignments[i]]++;
+    sortedResponses[position] = responses[i];
+    if (UseWeights)
+      sortedWeights[position] = weights[i];
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType totalLeftWeight = 0.0;
+  WType totalRightWeight = 0.0;
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+    totalRightWeight = totalWeight;
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Only the bin boundaries are candidate split points.
+  size_t lastIndex = 0;
+  for (size_t bin = 0; bin + 1 < numBins; ++bin)
+  {
+    const size_t index = binStarts[bin + 1];
+    if (UseWeights)
+    {
+      for (size_t i = lastIndex; i < index; ++i)
+      {
+        totalLeftWeight += sortedWeights[i];
+        totalRightWeight -= sortedWeights[i];
+      }
+    }
+    lastIndex = index;
+
+    // An empty bin yields the same partition as the previous boundary.
+    if (binCounts[bin] == 0)
+      continue;
+    if (index < minimum)
+      continue;
+    if (data.n_elem - index < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.
+    const double leftGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, 0, index);
+    const double rightGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, index,
+            responses.n_elem);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(index) * leftGain +
+          double(responses.n_elem - index) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      splitInfo = minValue + binWidth * (bin + 1);
+
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo = minValue + binWidth * (bin + 1);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Optimized version for any fitness function that implements
+// BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+HistogramBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    double& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Quantize the dimension into equal-width bins in a single pass (instead of
+  // sorting it).
+  arma::Row<size_t> assignments, binCounts;
+  double minValue, binWidth;
+  if (!BinData(data, assignments, binCounts, minValue, binWidth))
+    return DBL_MAX;
+  const size_t numBins = binCounts.n_elem;
+
+  // Group the responses (and weights) by bin with a counting sort.
+  arma::Row<size_t> binStarts(numBins + 1);
+  binStarts[0] = 0;
+  for (size_t bin = 0; bin < numBins; ++bin)
+    binStarts[bin + 1] = binStarts[bin] + binCounts[bin];
+
+  arma::Row<size_t> positions = binStarts.subvec(0, numBins - 1);
+  arma::Row<RType> sortedResponses(responses.n_elem);
+  arma::Row<WType> sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(responses.n_elem);
+  for (size_t i = 0; i < responses.n_elem; ++i)
+  {
+    const size_t position = positions[assignments[i]]++;
+    sortedResponses[position] = responses[i];
+    if (UseWeights)
+      sortedWeights[position] = weights[i];
+  }
+
+  // Mark the left-child sizes at which a bin boundary falls, along with the
+  // split value of that boundary.  (For an empty bin, the earlier boundary
+  // with the same partition is kept.)
+  arma::vec thresholds(data.n_elem + 1);
+  thresholds.fill(DBL_MAX);
+  for (size_t bin = 0; bin + 1 < numBins; ++bin)
+  {
+    if (binCounts[bin] == 0)
+      continue;
+    if (thresholds[binStarts[bin + 1]] == DBL_MAX)
+      thresholds[binStarts[bin + 1]] = minValue + binWidth * (bin + 1);
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType leftChildWeight = 0.0;
+  WType rightChildWeight = 0.0;
+
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+
+    for (size_t i = 0; i < minimum - 1; ++i)
+      leftChildWeight += sortedWeights[i];
+
+    for (size_t i = minimum - 1; i < data.n_elem; ++i)
+      rightChildWeight += sortedWeights[i];
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Initialize and precompute various statistics to efficiently compute gain
+  // values for all candidate splits.
+  fitnessFunction.template BinaryScanInitialize<UseWeights>(sortedResponses,
+      sortedWeights, minimum);
+
+  // Step through every point in bin order, but compute gains only at the bin
+  // boundaries.
+  for (size_t index = minimum; index < data.n_elem - minimum + 1; ++index)
+  {
+    if (UseWeights)
+    {
+      leftChildWeight += sortedWeights[index - 1];
+      rightChildWeight -= sortedWeights[index - 1];
+    }
+
+    // Steps through the current index and updates the cached data.
+    fitnessFunction.template BinaryStep<UseWeights>(sortedResponses,
+        sortedWeights, index - 1);
+
+    // Only bin boundaries are candidate splits.
+    if (thresholds[index] == DBL_MAX)
+      continue;
+
+    // Calculate the gain for the left and right child.
+    std::tuple<double, double> binaryGains = fitnessFunction.BinaryGains();
+    const double leftGain = std::get<0>(binaryGains);
+    const double rightGain = std::get<1>(binaryGains);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftChildWeight * leftGain + rightChildWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(index) * leftGain +
+          double(sortedResponses.n_elem - index) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      splitInfo = thresholds[index];
+
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo = thresholds[index];
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramBinaryNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const double& splitInfo,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  if (point <= splitInfo)
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
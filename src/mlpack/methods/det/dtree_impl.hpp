@@ -636,10 +636,56 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+      auto growChild = [&](DTree* child, double& childG)
+      {
+        childG = child->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+            minLeafSize);
+      };
+
+      #if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+      // The children cover disjoint column ranges of the dataset, so they can
+      // be grown as OpenMP tasks; small subtrees are grown inline, since the
+      // scheduling overhead would outweigh the work.  Sparse matrices are
+      // excluded: swapping columns during SplitData() restructures storage
+      // shared between the children.
+      const size_t minimumTaskSize = 10000;
+      const bool useTasks = !arma::is_arma_sparse_type<MatType>::value &&
+          ((size_t) (end - start) >= 2 * minimumTaskSize);
+      if (useTasks && !omp_in_parallel())
+      {
+        // We are at (or near) the root, so create the task team here.
+        #pragma omp parallel
+        #pragma omp single
+        {
+          #pragma omp task default(shared) \
+              if ((size_t) (splitIndex - start) >= minimumTaskSize)
+          growChild(left, leftG);
+          #pragma omp task default(shared) \
+              if ((size_t) (end - splitIndex) >= minimumTaskSize)
+          growChild(right, rightG);
+        }
+      }
+      else if (useTasks)
+      {
+        // We are inside the task team of an ancestor node; nest further
+        // tasks.
+        #pragma omp task default(shared) \
+            if ((size_t) (splitIndex - start) >= minimumTaskSize)
+        growChild(left, leftG);
+        #pragma omp task default(shared) \
+            if ((size_t) (end - splitIndex) >= minimumTaskSize)
+        growChild(right, rightG);
+        #pragma omp taskwait
+      }
+      else
+      {
+        growChild(left, leftG);
+        growChild(right, rightG);
+      }
+      #else
+      growChild(left, leftG);
+      growChild(right, rightG);
+      #endif
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -99,6 +99,13 @@ class DualTreeBoruvka
   //! Indicates whether or not O(n^2) naive mode will be used.
   bool naive;
 
+  //! Relative approximation error allowed for candidate edges (0 is exact).
+  double epsilon;
+
+  //! Edges longer than this are never added to the tree (DBL_MAX disables
+  //! the cutoff).
+  double cutoff;
+
   //! Edges.
   std::vector<EdgePair> edges; // We must use vector with non-numerical types.
 
@@ -134,10 +141,19 @@ class DualTreeBoruvka
    *
    * @param dataset Dataset to build a tree for.
    * @param naive Whether the computation should be done in O(n^2) naive mode.
+   * @param epsilon Relative approximation error (non-negative): each edge
+   *      added to the tree is at most (1 + epsilon) times longer than the
+   *      shortest edge leaving its component, so 0 gives the exact MST.
+   * @param cutoff If less than DBL_MAX, edges longer than this are never
+   *      added and the computation terminates as soon as no shorter
+   *      component-connecting edges remain; the result is then a spanning
+   *      forest, possibly with fewer than n - 1 edges.
    * @param metric An optional instantiated metric to use.
    */
   DualTreeBoruvka(const MatType& dataset,
                   const bool naive = false,
+                  const double epsilon = 0.0,
+                  const double cutoff = DBL_MAX,
                   const MetricType metric = MetricType());
 
   /**
@@ -154,9 +170,15 @@ class DualTreeBoruvka
    * is not done when this constructor is used.
    *
    * @param tree Pre-built tree.
+   * @param epsilon Relative approximation error (non-negative); see the other
+   *      constructor.
+   * @param cutoff Edge length cutoff (DBL_MAX disables it); see the other
+   *      constructor.
    * @param metric An optional instantiated metric to use.
    */
   DualTreeBoruvka(Tree* tree,
+                  const double epsilon = 0.0,
+                  const double cutoff = DBL_MAX,
                   const MetricType metric = MetricType());
 
   /**
@@ -171,10 +193,24 @@ class DualTreeBoruvka
    * index of the edge; the second row will contain the greater index of the
    * edge; and the third row will contain the distance between the two edges.
    *
+   * If an edge length cutoff was given, the computation stops as soon as no
+   * component-connecting edges shorter than the cutoff remain, and the result
+   * is a spanning forest that may have fewer than N edges.
+   *
    * @param results Matrix which results will be stored in.
    */
   void ComputeMST(arma::mat& results);
 
+  //! Get the relative approximation error (0 means exact computation).
+  double Epsilon() const { return epsilon; }
+  //! Modify the relative approximation error (0 means exact computation).
+  double& Epsilon() { return epsilon; }
+
+  //! Get the edge length cutoff (DBL_MAX means no cutoff).
+  double Cutoff() const { return cutoff; }
+  //! Modify the edge length cutoff (DBL_MAX means no cutoff).
+  double& Cutoff() { return cutoff; }
+
  private:
   /**
    * Adds a single edge to the edge list
@@ -186,6 +222,15 @@ class DualTreeBoruvka
    */
   void AddAllEdges();
 
+  /**
+   * Merges one thread's candidate edges into the shared per-component
+   * candidates, keeping the shorter candidate for each component.  Only one
+   * thread merges at a time.
+   */
+  void MergeCandidates(const arma::vec& threadDistances,
+                       const arma::Col<size_t>& threadInComponent,
+                       const arma::Col<size_t>& threadOutComponent);
+
   /**
    * Unpermute the edge list and output it to results.
    */
@@ -52,15 +52,25 @@ template<
 DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     const MatType& dataset,
     const bool naive,
+    const double epsilon,
+    const double cutoff,
     const MetricType metric) :
     tree(naive ? NULL : BuildTree<Tree>(dataset, oldFromNew)),
     data(naive ? dataset : tree->Dataset()),
     ownTree(!naive),
     naive(naive),
+    epsilon(epsilon),
+    cutoff(cutoff),
     connections(dataset.n_cols),
     totalDist(0.0),
     metric(metric)
 {
+  if (epsilon < 0)
+    throw std::invalid_argument("DualTreeBoruvka: epsilon must be "
+        "non-negative");
+  if (cutoff <= 0)
+    throw std::invalid_argument("DualTreeBoruvka: cutoff must be positive");
+
   edges.reserve(data.n_cols - 1); // Set size.
 
   neighborsInComponent.set_size(data.n_cols);
@@ -77,15 +87,25 @@ template<
              typename TreeMatType> class TreeType>
 DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     Tree* tree,
+    const double epsilon,
+    const double cutoff,
     const MetricType metric) :
     tree(tree),
     data(tree->Dataset()),
     ownTree(false),
     naive(false),
+    epsilon(epsilon),
+    cutoff(cutoff),
     connections(data.n_cols),
     totalDist(0.0),
     metric(metric)
 {
+  if (epsilon < 0)
+    throw std::invalid_argument("DualTreeBoruvka: epsilon must be "
+        "non-negative");
+  if (cutoff <= 0)
+    throw std::invalid_argument("DualTreeBoruvka: cutoff must be positive");
+
   edges.reserve(data.n_cols - 1); // Fill with EdgePairs.
 
   neighborsInComponent.set_size(data.n_cols);
@@ -122,23 +142,145 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   totalDist = 0; // Reset distance.
 
   typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+
+  // The rules write per-component candidate edges and (in the dual-tree case)
+  // query-node bounds, so they cannot be shared between threads; the parallel
+  // paths below give each thread its own RuleType with its own candidate
+  // arrays and merge the candidates per component afterwards.
+#ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+#else
+  const size_t numThreads = 1;
+#endif
+
+  // Cumulative work counters across rounds.
+  size_t totalBaseCases = 0;
+  size_t totalScores = 0;
+
   while (edges.size() < (data.n_cols - 1))
   {
-    if (naive)
+    // Flatten the union-find structure so that Find() performs no writes
+    // during the traversal; components only change in AddAllEdges(), between
+    // rounds.
+    connections.Flatten();
+
+    if (numThreads == 1)
     {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
+      RuleType rules(data, connections, neighborsDistances,
+          neighborsInComponent, neighborsOutComponent, metric, epsilon,
+          cutoff);
+
+      if (naive)
+      {
+        // Full O(N^2) traversal.
+        for (size_t i = 0; i < data.n_cols; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            rules.BaseCase(i, j);
+      }
+      else
+      {
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        traverser.Traverse(*tree, *tree);
+      }
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+    }
+    else if (naive)
+    {
+      // Each thread computes candidate edges for a contiguous block of query
+      // points with its own candidate arrays, then merges them per component.
+      size_t roundBaseCases = 0;
+
+      #pragma omp parallel for schedule(static) reduction(+: roundBaseCases)
+      for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+      {
+        const size_t blockBegin = (data.n_cols * t) / numThreads;
+        const size_t blockEnd = (data.n_cols * (t + 1)) / numThreads;
+        if (blockBegin == blockEnd)
+          continue;
+
+        arma::vec threadDistances(data.n_cols);
+        threadDistances.fill(DBL_MAX);
+        arma::Col<size_t> threadInComponent(data.n_cols);
+        arma::Col<size_t> threadOutComponent(data.n_cols);
+
+        RuleType rules(data, connections, threadDistances, threadInComponent,
+            threadOutComponent, metric, epsilon, cutoff);
+        for (size_t i = blockBegin; i < blockEnd; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            rules.BaseCase(i, j);
+
+        roundBaseCases += rules.BaseCases();
+
+        MergeCandidates(threadDistances, threadInComponent,
+            threadOutComponent);
+      }
+
+      totalBaseCases += roundBaseCases;
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      // Collect a frontier of disjoint query subtrees to traverse in
+      // parallel---several per thread, so that uneven subtree costs balance
+      // out.  The largest frontier node is expanded first.
+      std::vector<Tree*> frontier(1, tree);
+      while (frontier.size() < 4 * numThreads)
+      {
+        size_t largest = frontier.size();
+        for (size_t i = 0; i < frontier.size(); ++i)
+        {
+          if (frontier[i]->NumChildren() > 0 &&
+              (largest == frontier.size() ||
+               frontier[i]->NumDescendants() >
+                   frontier[largest]->NumDescendants()))
+            largest = i;
+        }
+
+        // If every frontier node is a leaf, we cannot expand further.
+        if (largest == frontier.size())
+          break;
+
+        Tree* node = frontier[largest];
+        frontier[largest] = &node->Child(0);
+        for (size_t c = 1; c < node->NumChildren(); ++c)
+          frontier.push_back(&node->Child(c));
+      }
+
+      size_t roundBaseCases = 0;
+      size_t roundScores = 0;
+
+      // Each subtree traversal gets its own rule set and candidate arrays.
+      // The query subtrees are disjoint, so bound updates in the query nodes'
+      // statistics never collide, and the reference side of the traversal
+      // only reads node statistics.
+      #pragma omp parallel for schedule(dynamic) \
+          reduction(+: roundBaseCases, roundScores)
+      for (omp_size_t t = 0; t < (omp_size_t) frontier.size(); ++t)
+      {
+        arma::vec threadDistances(data.n_cols);
+        threadDistances.fill(DBL_MAX);
+        arma::Col<size_t> threadInComponent(data.n_cols);
+        arma::Col<size_t> threadOutComponent(data.n_cols);
+
+        RuleType rules(data, connections, threadDistances, threadInComponent,
+            threadOutComponent, metric, epsilon, cutoff);
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        traverser.Traverse(*frontier[t], *tree);
+
+        roundBaseCases += rules.BaseCases();
+        roundScores += rules.Scores();
+
+        MergeCandidates(threadDistances, threadInComponent,
+            threadOutComponent);
+      }
+
+      totalBaseCases += roundBaseCases;
+      totalScores += roundScores;
     }
 
+    const size_t edgesBefore = edges.size();
+
     AddAllEdges();
 
     Cleanup();
@@ -146,10 +288,19 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     Log::Info << edges.size() << " edges found so far." << std::endl;
     if (!naive)
     {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
+      Log::Info << totalBaseCases << " cumulative base cases." << std::endl;
+      Log::Info << totalScores << " cumulative node combinations scored."
           << std::endl;
     }
+
+    // If no components could be merged, every remaining candidate edge is
+    // longer than the cutoff; emit the forest built so far.
+    if (edges.size() == edgesBefore)
+    {
+      Log::Info << "No component-connecting edges within the cutoff remain; "
+          << "emitting a spanning forest." << std::endl;
+      break;
+    }
   }
 
   EmitResults(results);
@@ -194,6 +345,13 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
   for (size_t i = 0; i < data.n_cols; ++i)
   {
     size_t component = connections.Find(i);
+
+    // The candidate edge for the component may be longer than the cutoff, or
+    // may not exist at all (the distance is then still DBL_MAX) if everything
+    // outside the component was pruned by the cutoff.
+    if (neighborsDistances[component] > cutoff)
+      continue;
+
     size_t inEdge = neighborsInComponent[component];
     size_t outEdge = neighborsOutComponent[component];
     if (connections.Find(inEdge) != connections.Find(outEdge))
@@ -207,6 +365,35 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
   }
 }
 
+/**
+ * Merges one thread's candidate edges into the shared per-component
+ * candidates.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::MergeCandidates(
+    const arma::vec& threadDistances,
+    const arma::Col<size_t>& threadInComponent,
+    const arma::Col<size_t>& threadOutComponent)
+{
+  #pragma omp critical (DTBMergeCandidates)
+  {
+    for (size_t c = 0; c < data.n_cols; ++c)
+    {
+      if (threadDistances[c] < neighborsDistances[c])
+      {
+        neighborsDistances[c] = threadDistances[c];
+        neighborsInComponent[c] = threadInComponent[c];
+        neighborsOutComponent[c] = threadOutComponent[c];
+      }
+    }
+  }
+}
+
 /**
  * Unpermute the edge list (if necessary) and output it to results.
  */
@@ -222,13 +409,14 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::EmitResults(
   // Sort the edges.
   std::sort(edges.begin(), edges.end(), SortFun);
 
-  Log::Assert(edges.size() == data.n_cols - 1);
+  // With a cutoff, fewer than n - 1 edges may have been found.
+  Log::Assert((cutoff < DBL_MAX) || (edges.size() == data.n_cols - 1));
   results.set_size(3, edges.size());
 
   // Need to unpermute the point labels.
   if (!naive && ownTree && tree::TreeTraits<Tree>::RearrangesDataset)
   {
-    for (size_t i = 0; i < (data.n_cols - 1); ++i)
+    for (size_t i = 0; i < edges.size(); ++i)
     {
       // Make sure the edge list stores the smaller index first to
       // make checking correctness easier
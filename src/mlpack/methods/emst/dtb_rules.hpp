@@ -28,7 +28,9 @@ class DTBRules
            arma::vec& neighborsDistances,
            arma::Col<size_t>& neighborsInComponent,
            arma::Col<size_t>& neighborsOutComponent,
-           MetricType& metric);
+           MetricType& metric,
+           const double epsilon = 0.0,
+           const double cutoff = DBL_MAX);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
@@ -118,6 +120,15 @@ class DTBRules
   //! The instantiated metric.
   MetricType& metric;
 
+  //! Relative approximation error: pruning bounds are relaxed by a factor of
+  //! (1 + epsilon), so nodes that cannot improve a candidate edge by more
+  //! than the allowed error are pruned too.
+  const double epsilon;
+
+  //! Nodes farther away than this are pruned outright; edges longer than the
+  //! cutoff will never be added to the spanning tree.
+  const double cutoff;
+
   /**
    * Update the bound for the given query node.
    */
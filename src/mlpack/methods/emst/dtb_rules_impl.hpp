@@ -22,7 +22,9 @@ DTBRules(const arma::mat& dataSet,
          arma::vec& neighborsDistances,
          arma::Col<size_t>& neighborsInComponent,
          arma::Col<size_t>& neighborsOutComponent,
-         MetricType& metric)
+         MetricType& metric,
+         const double epsilon,
+         const double cutoff)
 :
   dataSet(dataSet),
   connections(connections),
@@ -30,6 +32,8 @@ DTBRules(const arma::mat& dataSet,
   neighborsInComponent(neighborsInComponent),
   neighborsOutComponent(neighborsOutComponent),
   metric(metric),
+  epsilon(epsilon),
+  cutoff(cutoff),
   baseCases(0),
   scores(0)
 {
@@ -91,10 +95,18 @@ double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
   const arma::vec queryPoint = dataSet.unsafe_col(queryIndex);
   const double distance = referenceNode.MinDistance(queryPoint);
 
+  // No edge longer than the cutoff will ever be added to the tree.
+  if (distance > cutoff)
+    return DBL_MAX;
+
   // If all the points in the reference node are farther than the candidate
-  // nearest neighbor for the query's component, we prune.
-  return neighborsDistances[queryComponentIndex] < distance
-      ? DBL_MAX : distance;
+  // nearest neighbor for the query's component, we prune.  The bound is
+  // relaxed by the allowed approximation error, so nodes that could only
+  // improve the candidate by less than a factor of (1 + epsilon) are pruned
+  // too.
+  const double relaxedBound =
+      neighborsDistances[queryComponentIndex] / (1.0 + epsilon);
+  return relaxedBound < distance ? DBL_MAX : distance;
 }
 
 template<typename MetricType, typename TreeType>
@@ -104,8 +116,9 @@ double DTBRules<MetricType, TreeType>::Rescore(const size_t queryIndex,
 {
   // We don't need to check component membership again, because it can't
   // change inside a single iteration.
-  return (oldScore > neighborsDistances[connections.Find(queryIndex)])
-      ? DBL_MAX : oldScore;
+  const double relaxedBound =
+      neighborsDistances[connections.Find(queryIndex)] / (1.0 + epsilon);
+  return (oldScore > relaxedBound) ? DBL_MAX : oldScore;
 }
 
 template<typename MetricType, typename TreeType>
@@ -121,11 +134,16 @@ double DTBRules<MetricType, TreeType>::Score(TreeType& queryNode,
 
   ++scores;
   const double distance = queryNode.MinDistance(referenceNode);
+
+  // No edge longer than the cutoff will ever be added to the tree.
+  if (distance > cutoff)
+    return DBL_MAX;
+
   const double bound = CalculateBound(queryNode);
 
-  // If all the points in the reference node are farther than the candidate
-  // nearest neighbor for all queries in the node, we prune.
-  return (bound < distance) ? DBL_MAX : distance;
+  // If all the points in the reference node are farther than the (relaxed)
+  // candidate nearest neighbor for all queries in the node, we prune.
+  return (bound / (1.0 + epsilon) < distance) ? DBL_MAX : distance;
 }
 
 template<typename MetricType, typename TreeType>
@@ -134,7 +152,7 @@ double DTBRules<MetricType, TreeType>::Rescore(TreeType& queryNode,
                                                const double oldScore) const
 {
   const double bound = CalculateBound(queryNode);
-  return (oldScore > bound) ? DBL_MAX : oldScore;
+  return (oldScore > bound / (1.0 + epsilon)) ? DBL_MAX : oldScore;
 }
 
 // Calculate the bound for a given query node in its current state and update
@@ -58,7 +58,18 @@ BINDING_LONG_DESC(
     "and if the " + PRINT_PARAM_STRING("naive") + " option is given, then "
     "brute-force search is used (this is typically much slower in low "
     "dimensions).  The leaf size does not affect the results, but it may have "
-    "some effect on the runtime of the algorithm.");
+    "some effect on the runtime of the algorithm."
+    "\n\n"
+    "If the " + PRINT_PARAM_STRING("epsilon") + " parameter is set to a "
+    "positive value, an approximate spanning tree is computed: each edge is "
+    "at most (1 + epsilon) times longer than the shortest edge that could "
+    "have been chosen in its place.  If the " +
+    PRINT_PARAM_STRING("cutoff") + " parameter is set to a positive value, "
+    "edges longer than the cutoff are never added, and the computation "
+    "terminates early; the output is then a spanning forest, which may have "
+    "fewer edges than a spanning tree.  Both options can significantly "
+    "reduce the runtime when only short edges are of interest (e.g. for "
+    "single-linkage clustering with a distance threshold).");
 
 // Example.
 BINDING_EXAMPLE(
@@ -90,6 +101,12 @@ PARAM_FLAG("naive", "Compute the MST using O(n^2) naive algorithm.", "n");
 PARAM_INT_IN("leaf_size", "Leaf size in the kd-tree.  One-element leaves give "
     "the empirically best performance, but at the cost of greater memory "
     "requirements.", "l", 1);
+PARAM_DOUBLE_IN("epsilon", "If positive, compute an approximate spanning tree "
+    "where each edge is at most (1 + epsilon) times longer than the shortest "
+    "edge that could have been chosen in its place.", "e", 0.0);
+PARAM_DOUBLE_IN("cutoff", "If positive, do not add edges longer than this "
+    "length and terminate as soon as none remain; the output is then a "
+    "spanning forest.", "c", 0.0);
 
 using namespace mlpack;
 using namespace mlpack::emst;
@@ -105,12 +122,21 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
   arma::mat dataPoints = std::move(params.Get<arma::mat>("input"));
 
+  RequireParamValue<double>(params, "epsilon",
+      [](double x) { return x >= 0.0; }, true, "epsilon must be non-negative");
+  RequireParamValue<double>(params, "cutoff",
+      [](double x) { return x >= 0.0; }, true, "cutoff must be non-negative");
+
+  const double epsilon = params.Get<double>("epsilon");
+  const double cutoff = (params.Get<double>("cutoff") > 0.0) ?
+      params.Get<double>("cutoff") : DBL_MAX;
+
   // Do naive computation if necessary.
   if (params.Get<bool>("naive"))
   {
     Log::Info << "Running naive algorithm." << endl;
 
-    DualTreeBoruvka<> naive(dataPoints, true);
+    DualTreeBoruvka<> naive(dataPoints, true, epsilon, cutoff);
 
     arma::mat naiveResults;
     naive.ComputeMST(naiveResults);
@@ -137,7 +163,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     metric::LMetric<2, true> metric;
     timers.Stop("tree_building");
 
-    DualTreeBoruvka<> dtb(&tree, metric);
+    DualTreeBoruvka<> dtb(&tree, epsilon, cutoff, metric);
 
     // Run the DTB algorithm.
     Log::Info << "Calculating minimum spanning tree." << endl;
@@ -55,16 +55,37 @@ class UnionFind
    */
   size_t Find(const size_t x)
   {
-    if (parent[x] == x)
-    {
-      return x;
-    }
-    else
+    // Walk up to the root without recursing; before any compression has
+    // happened the path can be long enough to overflow the stack on very
+    // large datasets.
+    size_t root = x;
+    while (parent[root] != root)
+      root = parent[root];
+
+    // Path compression: point every element on the path directly at the root.
+    // Only entries that actually change are written, so on a flattened
+    // structure (see Flatten()) this is a pure read and may be called from
+    // several threads at once.
+    size_t current = x;
+    while (parent[current] != root)
     {
-      // This ensures that the tree has a small depth.
-      parent[x] = Find(parent[x]);
-      return parent[x];
+      const size_t next = parent[current];
+      parent[current] = root;
+      current = next;
     }
+
+    return root;
+  }
+
+  /**
+   * Fully compress the structure so that every element points directly at the
+   * root of its component.  Until the next Union(), Find() then performs no
+   * writes, so it is safe to call concurrently.
+   */
+  void Flatten()
+  {
+    for (size_t i = 0; i < parent.n_elem; ++i)
+      Find(i);
   }
 
   /**
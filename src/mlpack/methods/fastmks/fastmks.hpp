@@ -302,6 +302,35 @@ class FastMKS
   //! Modify whether or not brute-force (naive) search is used.
   bool& Naive() { return naive; }
 
+  //! Get the base case budget for tree-based search (0 means no budget).
+  size_t BaseCaseBudget() const { return baseCaseBudget; }
+  /**
+   * Modify the base case budget for tree-based search.  If set to a nonzero
+   * value, each call to Search() will stop recursing once (approximately) this
+   * many kernel evaluations between dataset points have been performed, and
+   * the best candidates found so far will be returned.  Each returned kernel
+   * value is then a lower bound on the true maximum kernel value, so the
+   * budget trades exactness for a hard ceiling on the amount of work done.
+   * When OpenMP is enabled, the budget is split across threads in proportion
+   * to the number of query points each thread handles.  A value of 0 (the
+   * default) means search runs to completion and results are exact.
+   */
+  size_t& BaseCaseBudget() { return baseCaseBudget; }
+
+  //! Get whether base case kernel evaluations are served from a tile cache.
+  bool CacheKernels() const { return cacheKernels; }
+  /**
+   * Modify whether base case kernel evaluations are served from a tile cache
+   * during tree-based search.  If set to true, each tile of the kernel
+   * matrix is computed at most once per traversal as one bulk panel and kept
+   * in a memory-bounded least-recently-used cache (see
+   * kernel::KernelMatrix).  This pays off when the traversal performs many
+   * base cases (large k or slowly-pruning kernels); under heavy pruning the
+   * untouched entries of each computed tile are wasted work.  Has no effect
+   * on naive search, which already computes bulk panels.
+   */
+  bool& CacheKernels() { return cacheKernels; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -322,6 +351,14 @@ class FastMKS
   //! If true, naive (brute-force) search is used.
   bool naive;
 
+  //! Maximum number of base cases to perform per Search() call (0 means no
+  //! budget; search runs to completion).
+  size_t baseCaseBudget = 0;
+
+  //! If true, base case kernel evaluations are served from a memory-bounded
+  //! tile cache during tree-based search.
+  bool cacheKernels = false;
+
   //! The instantiated inner-product metric induced by the given kernel.
   metric::IPMetric<KernelType> metric;
 
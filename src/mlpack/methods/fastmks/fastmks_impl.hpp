@@ -18,6 +18,7 @@
 #include "fastmks_rules.hpp"
 
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/pairwise_kernels.hpp>
 
 namespace mlpack {
 namespace fastmks {
@@ -166,6 +167,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const FastMKS& other) :
     setOwner(other.referenceTree == NULL),
     singleMode(other.singleMode),
     naive(other.naive),
+    baseCaseBudget(other.baseCaseBudget),
+    cacheKernels(other.cacheKernels),
     metric(other.metric)
 {
   // Set reference set correctly.
@@ -187,6 +190,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(FastMKS&& other) :
     setOwner(other.setOwner),
     singleMode(other.singleMode),
     naive(other.naive),
+    baseCaseBudget(other.baseCaseBudget),
+    cacheKernels(other.cacheKernels),
     metric(std::move(other.metric))
 {
   // Clear information from the other.
@@ -196,6 +201,7 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(FastMKS&& other) :
   other.setOwner = false;
   other.singleMode = false;
   other.naive = false;
+  other.cacheKernels = false;
 }
 
 template<typename KernelType,
@@ -234,6 +240,8 @@ FastMKS<KernelType, MatType, TreeType>::operator=(const FastMKS& other)
 
   singleMode = other.singleMode;
   naive = other.naive;
+  baseCaseBudget = other.baseCaseBudget;
+  cacheKernels = other.cacheKernels;
 }
 
 template<typename KernelType,
@@ -252,6 +260,8 @@ FastMKS<KernelType, MatType, TreeType>::operator=(FastMKS&& other)
     setOwner = other.setOwner;
     singleMode = other.singleMode;
     naive = other.naive;
+    baseCaseBudget = other.baseCaseBudget;
+    cacheKernels = other.cacheKernels;
     metric = std::move(other.metric);
 
     // Clear information from the other.
@@ -261,6 +271,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(FastMKS&& other)
     other.setOwner = false;
     other.singleMode = false;
     other.naive = false;
+    other.cacheKernels = false;
   }
   return *this;
 }
@@ -439,31 +450,49 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
+    // Process the queries in blocks: each block's kernel evaluations are
+    // computed as one bulk panel (a single matrix multiplication for
+    // dot-product kernels), and then the top-k scan over the panel
+    // parallelizes trivially over the block's query points.  The block size
+    // caps the panel at about a million elements.
+    const size_t blockSize = std::max((size_t) 1,
+        (size_t) (1 << 20) / referenceSet->n_cols);
+
+    arma::mat kernelBlock;
+    for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
     {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+      const size_t blockCols = std::min(blockSize, querySet.n_cols - begin);
+      const MatType queryBlock = querySet.cols(begin, begin + blockCols - 1);
+      kernel::PairwiseKernels(*referenceSet, queryBlock, kernelBlock,
+          metric.Kernel());
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t i = 0; i < (omp_size_t) blockCols; ++i)
       {
-        const double eval = metric.Kernel().Evaluate(querySet.col(q),
-                                                     referenceSet->col(r));
+        const size_t q = begin + i;
 
-        if (eval > pqueue.top().first)
+        const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+        std::vector<Candidate> cList(k, def);
+        CandidateList pqueue(CandidateCmp(), std::move(cList));
+
+        for (size_t r = 0; r < referenceSet->n_cols; ++r)
         {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          const double eval = kernelBlock(r, i);
+
+          if (eval > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(eval, r);
+            pqueue.pop();
+            pqueue.push(c);
+          }
         }
-      }
 
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
+        for (size_t j = 1; j <= k; ++j)
+        {
+          indices(k - j, q) = pqueue.top().second;
+          kernels(k - j, q) = pqueue.top().first;
+          pqueue.pop();
+        }
       }
     }
 
@@ -473,20 +502,79 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Single-tree implementation.
   if (singleMode)
   {
-    // Create rules object (this will store the results).  This constructor
-    // precalculates each self-kernel value.
     typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, querySet, k, metric.Kernel());
 
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+#ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+#else
+    const size_t numThreads = 1;
+#endif
 
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    if (numThreads == 1)
+    {
+      // Create rules object (this will store the results).  This constructor
+      // precalculates each self-kernel value.
+      kernel::KernelMatrix<KernelType, MatType> kernelMatrix(*referenceSet,
+          querySet, metric.Kernel());
+      RuleType rules(*referenceSet, querySet, k, metric.Kernel(),
+          baseCaseBudget, cacheKernels ? &kernelMatrix : NULL);
 
-    Log::Info << rules.BaseCases() << " base cases." << std::endl;
-    Log::Info << rules.Scores() << " scores." << std::endl;
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    rules.GetResults(indices, kernels);
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      Log::Info << rules.BaseCases() << " base cases." << std::endl;
+      Log::Info << rules.Scores() << " scores." << std::endl;
+
+      rules.GetResults(indices, kernels);
+
+      return;
+    }
+
+    size_t totalBaseCases = 0, totalScores = 0;
+
+    // Each thread traverses for a contiguous block of query points with its
+    // own rule set and traverser, and writes only its own block of output
+    // columns.  Any base case budget is split between the blocks in
+    // proportion to their sizes, although each block may always perform at
+    // least k base cases.
+    #pragma omp parallel for schedule(static) \
+        reduction(+: totalBaseCases, totalScores)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (querySet.n_cols * t) / numThreads;
+      const size_t blockEnd = (querySet.n_cols * (t + 1)) / numThreads;
+      if (blockBegin == blockEnd)
+        continue;
+
+      const size_t blockBudget = (baseCaseBudget == 0) ? 0 : std::max(k,
+          (baseCaseBudget * (blockEnd - blockBegin)) / querySet.n_cols);
+
+      kernel::KernelMatrix<KernelType, MatType> kernelMatrix(*referenceSet,
+          querySet, metric.Kernel(), 512, (size_t(1) << 26) / numThreads);
+      RuleType rules(*referenceSet, querySet, k, metric.Kernel(),
+          blockBudget, cacheKernels ? &kernelMatrix : NULL);
+
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+
+      arma::Mat<size_t> blockIndices;
+      arma::mat blockKernels;
+      rules.GetResults(blockIndices, blockKernels);
+      indices.cols(blockBegin, blockEnd - 1) =
+          blockIndices.cols(blockBegin, blockEnd - 1);
+      kernels.cols(blockBegin, blockEnd - 1) =
+          blockKernels.cols(blockBegin, blockEnd - 1);
+    }
+
+    Log::Info << totalBaseCases << " base cases." << std::endl;
+    Log::Info << totalScores << " scores." << std::endl;
 
     return;
   }
@@ -537,16 +625,99 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   kernels.set_size(k, queryTree->Dataset().n_cols);
 
   typedef FastMKSRules<KernelType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), k, metric.Kernel());
 
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+#ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+#else
+  const size_t numThreads = 1;
+#endif
+
+  if (numThreads == 1)
+  {
+    kernel::KernelMatrix<KernelType, MatType> kernelMatrix(*referenceSet,
+        queryTree->Dataset(), metric.Kernel());
+    RuleType rules(*referenceSet, queryTree->Dataset(), k, metric.Kernel(),
+        baseCaseBudget, cacheKernels ? &kernelMatrix : NULL);
+
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    Log::Info << rules.BaseCases() << " base cases." << std::endl;
+    Log::Info << rules.Scores() << " scores." << std::endl;
+
+    rules.GetResults(indices, kernels);
+
+    return;
+  }
+
+  // Collect a frontier of disjoint query subtrees to traverse in
+  // parallel---several per thread, so that uneven subtree costs balance out.
+  // The largest frontier node is expanded first.
+  std::vector<Tree*> frontier(1, queryTree);
+  while (frontier.size() < 4 * numThreads)
+  {
+    size_t largest = frontier.size();
+    for (size_t i = 0; i < frontier.size(); ++i)
+    {
+      if (frontier[i]->NumChildren() > 0 &&
+          (largest == frontier.size() ||
+           frontier[i]->NumDescendants() >
+               frontier[largest]->NumDescendants()))
+        largest = i;
+    }
+
+    // If every frontier node is a leaf, we cannot expand further.
+    if (largest == frontier.size())
+      break;
+
+    Tree* node = frontier[largest];
+    frontier[largest] = &node->Child(0);
+    for (size_t c = 1; c < node->NumChildren(); ++c)
+      frontier.push_back(&node->Child(c));
+  }
+
+  size_t totalBaseCases = 0, totalScores = 0;
 
-  traverser.Traverse(*queryTree, *referenceTree);
+  // Each subtree traversal gets its own rule set; a subtree's query points
+  // are disjoint from every other subtree's, so the merge touches disjoint
+  // columns.  Any base case budget is split between the subtrees in
+  // proportion to how many query points they hold, although each subtree may
+  // always perform at least k base cases.
+  #pragma omp parallel for schedule(dynamic) \
+      reduction(+: totalBaseCases, totalScores)
+  for (omp_size_t t = 0; t < (omp_size_t) frontier.size(); ++t)
+  {
+    const size_t subtreeBudget = (baseCaseBudget == 0) ? 0 : std::max(k,
+        (baseCaseBudget * frontier[t]->NumDescendants()) /
+            queryTree->Dataset().n_cols);
+
+    kernel::KernelMatrix<KernelType, MatType> kernelMatrix(*referenceSet,
+        queryTree->Dataset(), metric.Kernel(), 512,
+        (size_t(1) << 26) / numThreads);
+    RuleType rules(*referenceSet, queryTree->Dataset(), k, metric.Kernel(),
+        subtreeBudget, cacheKernels ? &kernelMatrix : NULL);
+
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
-  Log::Info << rules.BaseCases() << " base cases." << std::endl;
-  Log::Info << rules.Scores() << " scores." << std::endl;
+    traverser.Traverse(*frontier[t], *referenceTree);
 
-  rules.GetResults(indices, kernels);
+    totalBaseCases += rules.BaseCases();
+    totalScores += rules.Scores();
+
+    arma::Mat<size_t> blockIndices;
+    arma::mat blockKernels;
+    rules.GetResults(blockIndices, blockKernels);
+    for (size_t j = 0; j < frontier[t]->NumDescendants(); ++j)
+    {
+      const size_t q = frontier[t]->Descendant(j);
+      indices.col(q) = blockIndices.col(q);
+      kernels.col(q) = blockKernels.col(q);
+    }
+  }
+
+  Log::Info << totalBaseCases << " base cases." << std::endl;
+  Log::Info << totalScores << " scores." << std::endl;
 }
 
 template<typename KernelType,
@@ -566,34 +737,51 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+    // Process the queries in blocks, just like the bichromatic case: one bulk
+    // kernel panel per block, then a parallel top-k scan over the panel.
+    const size_t blockSize = std::max((size_t) 1,
+        (size_t) (1 << 20) / referenceSet->n_cols);
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+    arma::mat kernelBlock;
+    for (size_t begin = 0; begin < referenceSet->n_cols; begin += blockSize)
+    {
+      const size_t blockCols = std::min(blockSize,
+          referenceSet->n_cols - begin);
+      const MatType queryBlock =
+          referenceSet->cols(begin, begin + blockCols - 1);
+      kernel::PairwiseKernels(*referenceSet, queryBlock, kernelBlock,
+          metric.Kernel());
+
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t i = 0; i < (omp_size_t) blockCols; ++i)
       {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
+        const size_t q = begin + i;
 
-        const double eval = metric.Kernel().Evaluate(referenceSet->col(q),
-                                                     referenceSet->col(r));
+        const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+        std::vector<Candidate> cList(k, def);
+        CandidateList pqueue(CandidateCmp(), std::move(cList));
 
-        if (eval > pqueue.top().first)
+        for (size_t r = 0; r < referenceSet->n_cols; ++r)
         {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          if (q == r)
+            continue; // Don't return the point as its own candidate.
+
+          const double eval = kernelBlock(r, i);
+
+          if (eval > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(eval, r);
+            pqueue.pop();
+            pqueue.push(c);
+          }
         }
-      }
 
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
+        for (size_t j = 1; j <= k; ++j)
+        {
+          indices(k - j, q) = pqueue.top().second;
+          kernels(k - j, q) = pqueue.top().first;
+          pqueue.pop();
+        }
       }
     }
 
@@ -603,25 +791,84 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Single-tree implementation.
   if (singleMode)
   {
-    // Create rules object (this will store the results).  This constructor
-    // precalculates each self-kernel value.
     typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel());
 
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+#ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+#else
+    const size_t numThreads = 1;
+#endif
 
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    if (numThreads == 1)
+    {
+      // Create rules object (this will store the results).  This constructor
+      // precalculates each self-kernel value.
+      kernel::KernelMatrix<KernelType, MatType> kernelMatrix(*referenceSet,
+          *referenceSet, metric.Kernel());
+      RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel(),
+          baseCaseBudget, cacheKernels ? &kernelMatrix : NULL);
 
-    // Save the number of pruned nodes.
-    const size_t numPrunes = traverser.NumPrunes();
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    Log::Info << "Pruned " << numPrunes << " nodes." << std::endl;
+      for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
 
-    Log::Info << rules.BaseCases() << " base cases." << std::endl;
-    Log::Info << rules.Scores() << " scores." << std::endl;
+      // Save the number of pruned nodes.
+      const size_t numPrunes = traverser.NumPrunes();
 
-    rules.GetResults(indices, kernels);
+      Log::Info << "Pruned " << numPrunes << " nodes." << std::endl;
+
+      Log::Info << rules.BaseCases() << " base cases." << std::endl;
+      Log::Info << rules.Scores() << " scores." << std::endl;
+
+      rules.GetResults(indices, kernels);
+
+      return;
+    }
+
+    size_t totalBaseCases = 0, totalScores = 0;
+
+    // Each thread traverses for a contiguous block of query points with its
+    // own rule set and traverser, and writes only its own block of output
+    // columns.  Any base case budget is split between the blocks in
+    // proportion to their sizes, although each block may always perform at
+    // least k base cases.
+    #pragma omp parallel for schedule(static) \
+        reduction(+: totalBaseCases, totalScores)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (referenceSet->n_cols * t) / numThreads;
+      const size_t blockEnd = (referenceSet->n_cols * (t + 1)) / numThreads;
+      if (blockBegin == blockEnd)
+        continue;
+
+      const size_t blockBudget = (baseCaseBudget == 0) ? 0 : std::max(k,
+          (baseCaseBudget * (blockEnd - blockBegin)) / referenceSet->n_cols);
+
+      kernel::KernelMatrix<KernelType, MatType> kernelMatrix(*referenceSet,
+          *referenceSet, metric.Kernel(), 512, (size_t(1) << 26) / numThreads);
+      RuleType rules(*referenceSet, *referenceSet, k, metric.Kernel(),
+          blockBudget, cacheKernels ? &kernelMatrix : NULL);
+
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+
+      arma::Mat<size_t> blockIndices;
+      arma::mat blockKernels;
+      rules.GetResults(blockIndices, blockKernels);
+      indices.cols(blockBegin, blockEnd - 1) =
+          blockIndices.cols(blockBegin, blockEnd - 1);
+      kernels.cols(blockBegin, blockEnd - 1) =
+          blockKernels.cols(blockBegin, blockEnd - 1);
+    }
+
+    Log::Info << totalBaseCases << " base cases." << std::endl;
+    Log::Info << totalScores << " scores." << std::endl;
 
     return;
   }
@@ -643,6 +890,7 @@ void FastMKS<KernelType, MatType, TreeType>::serialize(
   // Serialize preferences for search.
   ar(CEREAL_NVP(naive));
   ar(CEREAL_NVP(singleMode));
+  ar(CEREAL_NVP(baseCaseBudget));
 
   // If we are doing naive search, serialize the dataset.  Otherwise we
   // serialize the tree.
@@ -13,10 +13,12 @@
 #define MLPACK_METHODS_FASTMKS_FASTMKS_RULES_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
 #include <algorithm>
+#include <unordered_map>
 
 namespace mlpack {
 namespace fastmks {
@@ -38,15 +40,32 @@ class FastMKSRules
    * Construct the FastMKSRules object.  This is usually done from within the
    * FastMKS class at search time.
    *
+   * If a nonzero base case budget is given, Score() and Rescore() will prune
+   * every node combination once that many base cases have been performed, so
+   * the traversal unwinds and the candidates found so far are returned.  The
+   * budget is a soft cap: base cases already scheduled by the traverser may
+   * still run after it is reached.
+   *
    * @param referenceSet Set of reference data.
    * @param querySet Set of query data.
    * @param k Number of candidates to search for.
+   * If a kernel matrix view is given, base case kernel evaluations are
+   * served from it instead of being computed pair by pair, so each tile of
+   * the kernel matrix is computed at most once as one bulk panel.
+   *
    * @param kernel Kernel to run FastMKS with.
+   * @param baseCaseBudget Maximum number of base cases to perform before
+   *      terminating the traversal (0 means no budget).
+   * @param kernelMatrix If non-NULL, a lazily-evaluated kernel matrix view
+   *      between the reference and query sets to serve base cases from.
    */
   FastMKSRules(const typename TreeType::Mat& referenceSet,
                const typename TreeType::Mat& querySet,
                const size_t k,
-               KernelType& kernel);
+               KernelType& kernel,
+               const size_t baseCaseBudget = 0,
+               kernel::KernelMatrix<KernelType, typename TreeType::Mat>*
+                   kernelMatrix = NULL);
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -153,6 +172,16 @@ class FastMKSRules
   //! Number of points to search for.
   const size_t k;
 
+  //! Maximum number of base cases to perform before terminating the traversal
+  //! (0 means no budget).
+  const size_t baseCaseBudget;
+
+  //! The kernel evaluation between each scored reference node's centroid and
+  //! the current query, used for parent-child prunes.  This is stored here
+  //! instead of in the tree statistics so that several rule sets can traverse
+  //! the same reference tree concurrently.
+  std::unordered_map<const TreeType*, double> lastKernels;
+
   //! Cached query set self-kernels (|| q || for each q).
   arma::vec queryKernels;
   //! Cached reference set self-kernels (|| r || for each r).
@@ -161,6 +190,10 @@ class FastMKSRules
   //! The instantiated kernel.
   KernelType& kernel;
 
+  //! If non-NULL, base case kernel evaluations are served from this
+  //! lazily-evaluated tile-cached view of the kernel matrix.
+  kernel::KernelMatrix<KernelType, typename TreeType::Mat>* kernelMatrix;
+
   //! The last query index BaseCase() was called with.
   size_t lastQueryIndex;
   //! The last reference index BaseCase() was called with.
@@ -23,11 +23,15 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     const typename TreeType::Mat& referenceSet,
     const typename TreeType::Mat& querySet,
     const size_t k,
-    KernelType& kernel) :
+    KernelType& kernel,
+    const size_t baseCaseBudget,
+    kernel::KernelMatrix<KernelType, typename TreeType::Mat>* kernelMatrix) :
     referenceSet(referenceSet),
     querySet(querySet),
     k(k),
+    baseCaseBudget(baseCaseBudget),
     kernel(kernel),
+    kernelMatrix(kernelMatrix),
     lastQueryIndex(-1),
     lastReferenceIndex(-1),
     lastKernel(0.0),
@@ -103,8 +107,10 @@ double FastMKSRules<KernelType, TreeType>::BaseCase(
   }
 
   ++baseCases;
-  double kernelEval = kernel.Evaluate(querySet.col(queryIndex),
-                                      referenceSet.col(referenceIndex));
+  double kernelEval = (kernelMatrix != NULL) ?
+      kernelMatrix->Evaluate(referenceIndex, queryIndex) :
+      kernel.Evaluate(querySet.col(queryIndex),
+                      referenceSet.col(referenceIndex));
 
   // Update the last kernel value, if we need to.
   if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
@@ -125,17 +131,29 @@ template<typename KernelType, typename TreeType>
 double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
                                                  TreeType& referenceNode)
 {
+  // If the base case budget has been exhausted, prune everything; the
+  // traversal will unwind and the best candidates found so far will be
+  // returned.
+  if ((baseCaseBudget > 0) && (baseCases >= baseCaseBudget))
+    return DBL_MAX;
+
   // Compare with the current best.
   const double bestKernel = candidates[queryIndex].front().first;
 
-  // See if we can perform a parent-child prune.
+  // See if we can perform a parent-child prune.  The parent's last kernel
+  // evaluation is only available if the parent has been scored during this
+  // traversal; the root of the traversal has not, so no prune is attempted
+  // there.
   const double furthestDist = referenceNode.FurthestDescendantDistance();
-  if (referenceNode.Parent() != NULL)
+  const typename std::unordered_map<const TreeType*, double>::const_iterator
+      lastIt = (referenceNode.Parent() == NULL) ? lastKernels.end() :
+      lastKernels.find(referenceNode.Parent());
+  if (lastIt != lastKernels.end())
   {
     double maxKernelBound;
     const double parentDist = referenceNode.ParentDistance();
     const double combinedDistBound = parentDist + furthestDist;
-    const double lastKernel = referenceNode.Parent()->Stat().LastKernel();
+    const double lastKernel = lastIt->second;
     if (kernel::KernelTraits<KernelType>::IsNormalized)
     {
       const double squaredDist = std::pow(combinedDistBound, 2.0);
@@ -169,10 +187,10 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
   {
     // Could it be that this kernel evaluation has already been calculated?
     if (tree::TreeTraits<TreeType>::HasSelfChildren &&
-        referenceNode.Parent() != NULL &&
+        lastIt != lastKernels.end() &&
         referenceNode.Point(0) == referenceNode.Parent()->Point(0))
     {
-      kernelEval = referenceNode.Parent()->Stat().LastKernel();
+      kernelEval = lastIt->second;
     }
     else
     {
@@ -187,7 +205,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
     kernelEval = kernel.Evaluate(querySet.col(queryIndex), refCenter);
   }
 
-  referenceNode.Stat().LastKernel() = kernelEval;
+  lastKernels[&referenceNode] = kernelEval;
 
   double maxKernel;
   if (kernel::KernelTraits<KernelType>::IsNormalized)
@@ -219,6 +237,12 @@ template<typename KernelType, typename TreeType>
 double FastMKSRules<KernelType, TreeType>::Score(TreeType& queryNode,
                                                  TreeType& referenceNode)
 {
+  // If the base case budget has been exhausted, prune everything; the
+  // traversal will unwind and the best candidates found so far will be
+  // returned.
+  if ((baseCaseBudget > 0) && (baseCases >= baseCaseBudget))
+    return DBL_MAX;
+
   // Update and get the query node's bound.
   queryNode.Stat().Bound() = CalculateBound(queryNode);
   const double bestKernel = queryNode.Stat().Bound();
@@ -409,6 +433,9 @@ double FastMKSRules<KernelType, TreeType>::Rescore(const size_t queryIndex,
                                                    TreeType& /*referenceNode*/,
                                                    const double oldScore) const
 {
+  if ((baseCaseBudget > 0) && (baseCases >= baseCaseBudget))
+    return DBL_MAX;
+
   const double bestKernel = candidates[queryIndex].front().first;
 
   return ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX;
@@ -419,6 +446,9 @@ double FastMKSRules<KernelType, TreeType>::Rescore(TreeType& queryNode,
                                                    TreeType& /*referenceNode*/,
                                                    const double oldScore) const
 {
+  if ((baseCaseBudget > 0) && (baseCases >= baseCaseBudget))
+    return DBL_MAX;
+
   queryNode.Stat().Bound() = CalculateBound(queryNode);
   const double bestKernel = queryNode.Stat().Bound();
 
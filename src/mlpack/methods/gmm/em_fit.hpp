@@ -17,6 +17,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/dists/gaussian_distribution.hpp>
 #include <mlpack/core/dists/diagonal_gaussian_distribution.hpp>
+#include <mlpack/core/math/batch_cholesky.hpp>
 
 // Default clustering mechanism.
 #include <mlpack/methods/kmeans/kmeans.hpp>
@@ -162,6 +163,29 @@ class EMFit
       const std::vector<Distribution>& dists,
       const arma::vec& weights) const;
 
+  /**
+   * Assign freshly estimated covariances to the given components.  For full
+   * Gaussians, all covariances are factored in one batch (see
+   * math::BatchCholesky()) instead of one LAPACK call per component.
+   *
+   * @param dists Distributions to assign the covariances to.
+   * @param covs Covariances, one slice per updated component.
+   * @param indices For each slice, the index of the component it belongs to.
+   */
+  void AssignCovariances(
+      std::vector<distribution::GaussianDistribution>& dists,
+      arma::cube& covs,
+      const std::vector<size_t>& indices) const;
+
+  /**
+   * Assign freshly estimated covariances one component at a time; fallback
+   * for distribution types without a precomputed-factorization setter.
+   */
+  template<typename OtherDistribution>
+  void AssignCovariances(std::vector<OtherDistribution>& dists,
+                         arma::cube& covs,
+                         const std::vector<size_t>& indices) const;
+
   /**
    * Use the Armadillo gmm_diag clusterer to train a GMM with diagonal
    * covariance.  If InitialClusteringType == kmeans::KMeans<>, this will use
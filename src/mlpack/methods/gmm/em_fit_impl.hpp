@@ -87,8 +87,11 @@ Estimate(const arma::mat& observations,
         << "log-likelihood " << l << "." << std::endl;
 
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // Gaussian writes only its own column, so the E-step is parallelized
+    // over the components.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -98,7 +101,8 @@ Estimate(const arma::mat& observations,
     }
 
     // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -107,24 +111,42 @@ Estimate(const arma::mat& observations,
         condLogProb.row(i) -= probSum;
     }
 
-    // Store the sum of the probability of each state over all the observations.
+    // Store the sum of the probability of each state over all the
+    // observations, and materialize the normalized responsibilities once;
+    // all of the sufficient statistics below are computed from this matrix.
     arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
+    arma::mat normProb(observations.n_cols, dists.size());
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       probRowSums(i) = mlpack::math::AccuLog(condLogProb.col(i));
+      if (probRowSums(i) != -std::numeric_limits<double>::infinity())
+        normProb.col(i) = arma::exp(condLogProb.col(i) - probRowSums(i));
+      else
+        normProb.col(i).zeros();
     }
 
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
+    // Calculate the new values of the means for all components with a single
+    // matrix multiplication.
+    const arma::mat means = observations * normProb;
+
+    // Updated full covariances are collected here and factored in one batch
+    // at the end, instead of one factorization per component.
+    arma::cube newCovs;
+    std::vector<size_t> updated;
+    if (!std::is_same<Distribution,
+        distribution::DiagonalGaussianDistribution>::value)
+      newCovs.set_size(observations.n_rows, observations.n_rows,
+          dists.size());
+
     for (size_t i = 0; i < dists.size(); ++i)
     {
       // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-        dists[i].Mean() = observations * arma::exp(condLogProb.col(i) -
-                                                   probRowSums[i]);
-      else
+      if (probRowSums[i] == -std::numeric_limits<double>::infinity())
         continue;
 
+      dists[i].Mean() = means.col(i);
+
       // Calculate the new value of the covariances using the updated
       // conditional probabilities and the updated means.
       arma::mat tmp = observations.each_col() - dists[i].Mean();
@@ -136,7 +158,7 @@ Estimate(const arma::mat& observations,
       {
         arma::vec covariance = arma::sum((tmp % tmp) %
             (arma::ones<arma::vec>(observations.n_rows) *
-            trans(arma::exp(condLogProb.col(i) - probRowSums[i]))), 1);
+            trans(normProb.col(i))), 1);
 
         // Apply covariance constraint.
         constraint.ApplyConstraint(covariance);
@@ -144,16 +166,23 @@ Estimate(const arma::mat& observations,
       }
       else
       {
-        arma::mat tmpB = tmp.each_row() % trans(arma::exp(condLogProb.col(i) -
-                                                          probRowSums[i]));
+        arma::mat tmpB = tmp.each_row() % trans(normProb.col(i));
         arma::mat covariance = tmp * trans(tmpB);
 
         // Apply covariance constraint.
         constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
+        newCovs.slice(updated.size()) = covariance;
+        updated.push_back(i);
       }
     }
 
+    if (!updated.empty())
+    {
+      newCovs.resize(observations.n_rows, observations.n_rows,
+          updated.size());
+      AssignCovariances(dists, newCovs, updated);
+    }
+
     // Calculate the new values for omega using the updated conditional
     // probabilities.
     weights = arma::exp(probRowSums - std::log(observations.n_cols));
@@ -192,8 +221,11 @@ Estimate(const arma::mat& observations,
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // Gaussian writes only its own column, so the E-step is parallelized
+    // over the components.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -203,7 +235,8 @@ Estimate(const arma::mat& observations,
     }
 
     // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -213,13 +246,14 @@ Estimate(const arma::mat& observations,
     }
 
     // This will store the sum of probabilities of each state over all the
-    // observations.
+    // observations, and the normalized per-point responsibilities weighted by
+    // the probability of each point being from this mixture model; all of the
+    // sufficient statistics below are computed from this matrix.
     arma::vec probRowSums(dists.size());
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
+    arma::mat normProb(observations.n_cols, dists.size());
     arma::vec logProbabilities = arma::log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Calculate the sum of probabilities of points, which is the
       // conditional probability of each point being from Gaussian i
@@ -227,16 +261,33 @@ Estimate(const arma::mat& observations,
       // model.
       arma::vec tmpProb = condLogProb.col(i) + logProbabilities;
       probRowSums[i] = mlpack::math::AccuLog(tmpProb);
-
-      // Don't update if there's no probability of the Gaussian having points.
       if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-      {
-        dists[i].Mean() = observations *
-              arma::exp(condLogProb.col(i) + logProbabilities - probRowSums[i]);
-      }
+        normProb.col(i) = arma::exp(tmpProb - probRowSums[i]);
       else
+        normProb.col(i).zeros();
+    }
+
+    // Calculate the new values of the means for all components with a single
+    // matrix multiplication.
+    const arma::mat means = observations * normProb;
+
+    // Updated full covariances are collected here and factored in one batch
+    // at the end, instead of one factorization per component.
+    arma::cube newCovs;
+    std::vector<size_t> updated;
+    if (!std::is_same<Distribution,
+        distribution::DiagonalGaussianDistribution>::value)
+      newCovs.set_size(observations.n_rows, observations.n_rows,
+          dists.size());
+
+    for (size_t i = 0; i < dists.size(); ++i)
+    {
+      // Don't update if there's no probability of the Gaussian having points.
+      if (probRowSums[i] == -std::numeric_limits<double>::infinity())
         continue;
 
+      dists[i].Mean() = means.col(i);
+
       // Calculate the new value of the covariances using the updated
       // conditional probabilities and the updated means.
       arma::mat tmp = observations.each_col() - dists[i].Mean();
@@ -248,8 +299,7 @@ Estimate(const arma::mat& observations,
       {
         arma::vec cov = arma::sum((tmp % tmp) %
             (arma::ones<arma::vec>(observations.n_rows) *
-            trans(arma::exp(condLogProb.col(i) +
-                            logProbabilities - probRowSums[i]))), 1);
+            trans(normProb.col(i))), 1);
 
         // Apply covariance constraint.
         constraint.ApplyConstraint(cov);
@@ -257,16 +307,23 @@ Estimate(const arma::mat& observations,
       }
       else
       {
-        arma::mat tmpB = tmp.each_row() % trans(arma::exp(condLogProb.col(i) +
-            logProbabilities - probRowSums[i]));
+        arma::mat tmpB = tmp.each_row() % trans(normProb.col(i));
         arma::mat cov = (tmp * trans(tmpB));
 
         // Apply covariance constraint.
         constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
+        newCovs.slice(updated.size()) = cov;
+        updated.push_back(i);
       }
     }
 
+    if (!updated.empty())
+    {
+      newCovs.resize(observations.n_rows, observations.n_rows,
+          updated.size());
+      AssignCovariances(dists, newCovs, updated);
+    }
+
     // Calculate the new values for omega using the updated conditional
     // probabilities.
     weights = arma::exp(probRowSums - mlpack::math::AccuLog(logProbabilities));
@@ -383,12 +440,13 @@ LogLikelihood(const arma::mat& observations,
 {
   double logLikelihood = 0;
 
-  arma::vec logPhis;
   arma::mat logLikelihoods(dists.size(), observations.n_cols);
 
   // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
   {
+    arma::vec logPhis;
     dists[i].LogProbability(observations, logPhis);
     logLikelihoods.row(i) = log(weights(i)) + trans(logPhis);
   }
@@ -407,6 +465,42 @@ LogLikelihood(const arma::mat& observations,
   return logLikelihood;
 }
 
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+AssignCovariances(std::vector<distribution::GaussianDistribution>& dists,
+                  arma::cube& covs,
+                  const std::vector<size_t>& indices) const
+{
+  // Factor every covariance at once; the per-component systems are small, so
+  // batching amortizes the per-call overhead and parallelizes over slices.
+  arma::cube lowers, inverses;
+  arma::vec logDets;
+  if (!math::BatchCholesky(covs, lowers))
+    Log::Fatal << "Cholesky decomposition failed." << std::endl;
+  math::BatchCholeskyInverse(lowers, inverses, logDets);
+
+  for (size_t t = 0; t < indices.size(); ++t)
+  {
+    dists[indices[t]].Covariance(arma::mat(covs.slice(t)),
+        arma::mat(lowers.slice(t)), arma::mat(inverses.slice(t)), logDets[t]);
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+template<typename OtherDistribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+AssignCovariances(std::vector<OtherDistribution>& dists,
+                  arma::cube& covs,
+                  const std::vector<size_t>& indices) const
+{
+  for (size_t t = 0; t < indices.size(); ++t)
+    dists[indices[t]].Covariance(arma::mat(covs.slice(t)));
+}
+
 template<typename InitialClusteringType,
          typename CovarianceConstraintPolicy,
          typename Distribution>
@@ -278,6 +278,32 @@ class GMM
                const bool useExistingModel = false,
                FittingType fitter = FittingType());
 
+  /**
+   * Incrementally estimate the probability distribution from the given new
+   * observations.  This performs a single EM update, folding the
+   * responsibilities of the new observations into decayed sufficient
+   * statistics (component counts, first moments, and second moments) that are
+   * kept between calls; old statistics are multiplied by the given decay
+   * factor before the new responsibilities are added.  This means the model
+   * can absorb new observations in O(new data) without revisiting all
+   * previous training data.
+   *
+   * The decay must be in (0, 1].  A decay of 1 weights all observations ever
+   * seen equally; any smaller value exponentially forgets old data.
+   *
+   * On the first call (or after the model has been loaded or resized), the
+   * model is bootstrapped with a full batch fit of the given observations
+   * using the default EMFit<> fitter, and the statistics are seeded from that
+   * fit.  The retained statistics are not serialized.
+   *
+   * @param observations New observations to absorb into the model.
+   * @param decay Factor by which old sufficient statistics are downweighted.
+   * @return The log-likelihood of the new observations under the updated
+   *     model.
+   */
+  double TrainIncremental(const arma::mat& observations,
+                          const double decay = 0.9);
+
   /**
    * Classify the given observations as being from an individual component in
    * this GMM.  The resultant classifications are stored in the 'labels' object,
@@ -317,6 +343,28 @@ class GMM
       const arma::mat& dataPoints,
       const std::vector<distribution::GaussianDistribution>& distsL,
       const arma::vec& weights) const;
+
+  /**
+   * Compute the responsibilities of the given observations under the current
+   * parameters, fold them into the decayed sufficient statistics, and
+   * re-estimate the parameters from the statistics.  This is the single EM
+   * update used by TrainIncremental().
+   *
+   * @param observations Observations to absorb into the statistics.
+   * @param decay Factor by which old sufficient statistics are downweighted.
+   */
+  void UpdateStatistics(const arma::mat& observations, const double decay);
+
+  //! Decayed per-component responsibility sums, for TrainIncremental().
+  arma::vec suffCounts;
+
+  //! Decayed responsibility-weighted sums of the observations; one column per
+  //! component.
+  arma::mat suffMeans;
+
+  //! Decayed responsibility-weighted second moments of the observations; one
+  //! matrix per component.
+  std::vector<arma::mat> suffSecondMoments;
 };
 
 } // namespace gmm
@@ -87,8 +87,10 @@ inline void GMM::LogProbability(const arma::mat& observation,
   // Store log-probability value in a matrix.
   arma::mat logProb(observation.n_cols, gaussians);
 
-  // Assign value to the matrix.
-  for (size_t i = 0; i < gaussians; i++)
+  // Assign value to the matrix.  Each component writes only its own column,
+  // so this is parallelized over the components.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) gaussians; i++)
   {
     arma::vec temp(logProb.colptr(i), observation.n_cols, false, true);
     dists[i].LogProbability(observation, temp);
@@ -98,7 +100,7 @@ inline void GMM::LogProbability(const arma::mat& observation,
   arma::vec logWeights = arma::log(weights);
 
   // Compute log-probability.
-  logProb += repmat(logWeights.t(), logProb.n_rows, 1);
+  logProb.each_row() += logWeights.t();
   math::LogSumExp(logProb, logProbs);
 }
 
@@ -246,6 +248,105 @@ inline double GMM::LogLikelihood(
   return loglikelihood;
 }
 
+/**
+ * Incrementally estimate the probability distribution from the given new
+ * observations, folding their responsibilities into decayed sufficient
+ * statistics.
+ */
+inline double GMM::TrainIncremental(const arma::mat& observations,
+                                    const double decay)
+{
+  if (decay <= 0.0 || decay > 1.0)
+  {
+    Log::Fatal << "GMM::TrainIncremental(): decay (" << decay << ") must be "
+        << "in the range (0, 1]." << std::endl;
+  }
+
+  if (observations.n_rows != dimensionality)
+  {
+    Log::Fatal << "GMM::TrainIncremental(): observations have dimensionality "
+        << observations.n_rows << " (expected " << dimensionality << ")."
+        << std::endl;
+  }
+
+  // If the retained statistics do not match the model (first call, or the
+  // model was loaded or resized), bootstrap with a full batch fit of this
+  // batch and seed the statistics from the fitted model.
+  if (suffCounts.n_elem != gaussians)
+  {
+    suffCounts.zeros(gaussians);
+    suffMeans.zeros(dimensionality, gaussians);
+    suffSecondMoments.assign(gaussians,
+        arma::zeros<arma::mat>(dimensionality, dimensionality));
+
+    Train(observations);
+    UpdateStatistics(observations, 1.0);
+  }
+  else
+  {
+    UpdateStatistics(observations, decay);
+  }
+
+  return LogLikelihood(observations, dists, weights);
+}
+
+/**
+ * Perform the single EM update used by TrainIncremental(): compute the
+ * responsibilities of the observations, fold them into the decayed sufficient
+ * statistics, and re-estimate the parameters from the statistics.
+ */
+inline void GMM::UpdateStatistics(const arma::mat& observations,
+                                  const double decay)
+{
+  // Compute the (log) conditional probability of each point belonging to each
+  // component, as in EMFit<>::Estimate().  Each component writes only its own
+  // column, so this is parallelized over the components.
+  arma::mat condLogProb(observations.n_cols, gaussians);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) gaussians; i++)
+  {
+    arma::vec alias(condLogProb.colptr(i), observations.n_cols, false, true);
+    dists[i].LogProbability(observations, alias);
+    alias += log(weights[i]);
+  }
+
+  // Normalize row-wise to get the responsibilities of each component.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) observations.n_cols; i++)
+    condLogProb.row(i) -= math::AccuLog(condLogProb.row(i).t());
+
+  const arma::mat resp = exp(condLogProb);
+
+  // Fold the responsibilities into the decayed sufficient statistics.
+  suffCounts = decay * suffCounts + arma::sum(resp, 0).t();
+  suffMeans = decay * suffMeans + observations * resp;
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) gaussians; i++)
+  {
+    arma::mat tmp = observations;
+    tmp.each_row() %= arma::trans(resp.col(i));
+    suffSecondMoments[i] = decay * suffSecondMoments[i] +
+        tmp * arma::trans(observations);
+  }
+
+  // Re-estimate the parameters from the statistics.
+  weights = suffCounts / arma::accu(suffCounts);
+
+  for (size_t i = 0; i < gaussians; i++)
+  {
+    // Leave a component with no responsibility mass unchanged.
+    if (suffCounts[i] <= 0)
+      continue;
+
+    dists[i].Mean() = suffMeans.col(i) / suffCounts[i];
+    arma::mat covariance = suffSecondMoments[i] / suffCounts[i] -
+        dists[i].Mean() * arma::trans(dists[i].Mean());
+    PositiveDefiniteConstraint::ApplyConstraint(covariance);
+    dists[i].Covariance(std::move(covariance));
+  }
+}
+
 /**
  * Fit the GMM to the given observations.
  */
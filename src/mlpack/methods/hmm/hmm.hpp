@@ -191,6 +191,32 @@ class HMM
   void Train(const std::vector<arma::mat>& dataSeq,
              const std::vector<arma::Row<size_t> >& stateSeq);
 
+  /**
+   * Incrementally train the model on the given new unlabeled observation
+   * sequences.  This performs a single Baum-Welch update, folding the expected
+   * counts of the new sequences into decayed sufficient statistics that are
+   * kept between calls; old statistics are multiplied by the given decay
+   * factor before the new counts are added.  This means the model can absorb
+   * new sequences without revisiting all previous training data, which is
+   * useful when sequences arrive in a stream and full retraining is too
+   * expensive.
+   *
+   * The decay must be in (0, 1].  A decay of 1 retains all previous
+   * statistics indefinitely; any smaller value exponentially forgets old data
+   * and keeps the amount of retained emission training data bounded, so that
+   * each call costs O(new data).
+   *
+   * Note that the retained statistics are not serialized; after loading a
+   * model, the first call to TrainIncremental() starts accumulating fresh
+   * statistics from the current parameters.
+   *
+   * @param dataSeq Vector of new observation sequences.
+   * @param decay Factor by which old sufficient statistics are downweighted.
+   * @return Log-likelihood of the new sequences under the previous parameters.
+   */
+  double TrainIncremental(const std::vector<arma::mat>& dataSeq,
+                          const double decay = 0.9);
+
   /**
    * Estimate the probabilities of each hidden state at each time step for each
    * given data observation, using the Forward-Backward algorithm.  Each matrix
@@ -274,13 +300,45 @@ class HMM
    * sequence, using the Viterbi algorithm, returning the log-likelihood of the
    * most likely state sequence.
    *
+   * If 'beamWidth' is nonzero and smaller than the number of hidden states,
+   * beam pruning is applied: at each time step, only the 'beamWidth' most
+   * probable states are kept as candidate predecessors for the next step.
+   * This reduces the per-step work from quadratic in the number of states to
+   * beamWidth times the number of states, at the cost of an approximate
+   * result (the pruned path may occasionally be the true optimum).  A
+   * 'beamWidth' of 0 (the default) or of at least the number of states gives
+   * the exact Viterbi decoding.
+   *
    * @param dataSeq Sequence of observations.
    * @param stateSeq Vector in which the most probable state sequence will be
    *    stored.
+   * @param beamWidth Number of states to retain per time step (0 means no
+   *    pruning).
    * @return Log-likelihood of most probable state sequence.
    */
   double Predict(const arma::mat& dataSeq,
-                 arma::Row<size_t>& stateSeq) const;
+                 arma::Row<size_t>& stateSeq,
+                 const size_t beamWidth = 0) const;
+
+  /**
+   * Compute the most probable hidden state sequences for a batch of data
+   * sequences at once.  The emission log-probabilities of every observation
+   * of every sequence are computed in a single vectorized pass per state, and
+   * the Viterbi recursions of the sequences then run in parallel, so this is
+   * significantly faster than calling Predict() once per sequence.  Beam
+   * pruning is applied to each sequence as in the single-sequence overload.
+   *
+   * @param dataSeqs Sequences of observations.
+   * @param stateSeqs Vector in which the most probable state sequence of each
+   *    data sequence will be stored.
+   * @param beamWidth Number of states to retain per time step (0 means no
+   *    pruning).
+   * @return Log-likelihood of the most probable state sequence of each data
+   *    sequence.
+   */
+  arma::vec Predict(const std::vector<arma::mat>& dataSeqs,
+                    std::vector<arma::Row<size_t>>& stateSeqs,
+                    const size_t beamWidth = 0) const;
 
   /**
    * Compute the log-likelihood of the given data sequence.
@@ -513,6 +571,24 @@ class HMM
    */
   void ConvertToLogSpace() const;
 
+  /**
+   * Run the Viterbi recursion on precomputed emission log-probabilities
+   * (one row per time step, one column per state), storing the most probable
+   * state sequence in stateSeq and returning its log-likelihood.  This
+   * expects ConvertToLogSpace() to have been called already, so it can be
+   * used concurrently for different sequences.
+   *
+   * @param logProbs Emission log-probabilities of one sequence.
+   * @param stateSeq Vector in which the most probable state sequence will be
+   *    stored.
+   * @param beamWidth Number of states to retain per time step (0 means no
+   *    pruning).
+   * @return Log-likelihood of most probable state sequence.
+   */
+  double ViterbiDecode(const arma::mat& logProbs,
+                       arma::Row<size_t>& stateSeq,
+                       const size_t beamWidth) const;
+
   /**
    * A proxy vriable in linear space for logInitial.
    * Should be removed in mlpack 4.0.
@@ -539,6 +615,20 @@ class HMM
    * Should be removed in mlpack 4.0.
    */
   mutable bool recalculateTransition;
+
+  //! Decayed expected initial state counts, for TrainIncremental().
+  arma::vec initialStats;
+
+  //! Decayed expected transition counts, for TrainIncremental().
+  arma::mat transitionStats;
+
+  //! Observations retained for incremental emission updates.  Columns whose
+  //! responsibility weight has decayed to insignificance are dropped.
+  arma::mat emissionBuffer;
+
+  //! Decayed per-state responsibilities of the buffered observations; each
+  //! row corresponds to a state.
+  arma::mat emissionProbBuffer;
 };
 
 } // namespace hmm
@@ -133,70 +133,109 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
+    // Precompute the offset of each sequence into the emission lists, so that
+    // each sequence writes its per-timestep statistics into a disjoint block
+    // of emissionList and emissionProb regardless of the order in which the
+    // sequences are processed.
+    std::vector<size_t> seqOffsets(dataSeq.size());
     size_t sumTime = 0;
-
-    // Loop over each sequence.
     for (size_t seq = 0; seq < dataSeq.size(); seq++)
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
-          newLogInitial);
-
-      // Define a variable to store the value of log-probability for data.
-      arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
-      // Save the values of log-probability to logProbs.
-      for (size_t i = 0; i < logTransition.n_rows; i++)
-      {
-        // Define alias of desired column.
-        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-        // Use advanced constructor for using logProbs directly.
-        emission[i].LogProbability(dataSeq[seq], alias);
-      }
+      seqOffsets[seq] = sumTime;
+      sumTime += dataSeq[seq].n_cols;
+    }
 
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+    // The E-step is independent across sequences, so we process the sequences
+    // in parallel.  Each thread accumulates its own estimates of the initial
+    // probabilities, the transition matrix, and the log-likelihood, and those
+    // are merged into the shared estimates once the thread has finished its
+    // share of the sequences.
+    #pragma omp parallel
+    {
+      arma::vec threadLogInitial(logTransition.n_rows);
+      threadLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat threadLogTransition(logTransition.n_rows,
+          logTransition.n_cols);
+      threadLogTransition.fill(-std::numeric_limits<double>::infinity());
+      double threadLoglik = 0;
+
+      // Loop over each sequence.  Sequence lengths may vary widely, so use
+      // dynamic scheduling to keep the threads balanced.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); seq++)
       {
-        // Assemble temporary vector that's used in log-sum computation.
-        if (t < dataSeq[seq].n_cols - 1)
+        arma::mat stateLogProb;
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+
+        // Add the log-likelihood of this sequence.  This is the E-step.
+        threadLoglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+            backwardLog, logScales);
+
+        // Add to estimate of initial probability for state j.
+        math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
+            threadLogInitial);
+
+        // Define a variable to store the value of log-probability for data.
+        arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
+        // Save the values of log-probability to logProbs.
+        for (size_t i = 0; i < logTransition.n_rows; i++)
         {
-          // This term is the same across all states, so compute it once and
-          // cache it.
-          const arma::vec tmp = backwardLog.col(t + 1) +
-              logProbs.row(t + 1).t() - logScales[t + 1];
-          arma::vec output;
-          math::LogSumExp(tmp, output);
+          // Define alias of desired column.
+          arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+          // Use advanced constructor for using logProbs directly.
+          emission[i].LogProbability(dataSeq[seq], alias);
+        }
 
-          for (size_t j = 0; j < logTransition.n_cols; ++j)
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+        {
+          // Assemble temporary vector that's used in log-sum computation.
+          if (t < dataSeq[seq].n_cols - 1)
           {
-            // Compute the estimate of T_ij (probability of transition from
-            // state j to state i).  We postpone multiplication of the old T_ij
-            // until later.
-            arma::vec tmp2 = output + forwardLog(j, t);
-            arma::vec alias = newLogTransition.unsafe_col(j);
-            math::LogSumExp<arma::vec, true>(tmp2, alias);
+            // This term is the same across all states, so compute it once and
+            // cache it.
+            const arma::vec tmp = backwardLog.col(t + 1) +
+                logProbs.row(t + 1).t() - logScales[t + 1];
+            arma::vec output;
+            math::LogSumExp(tmp, output);
+
+            for (size_t j = 0; j < logTransition.n_cols; ++j)
+            {
+              // Compute the estimate of T_ij (probability of transition from
+              // state j to state i).  We postpone multiplication of the old
+              // T_ij until later.
+              arma::vec tmp2 = output + forwardLog(j, t);
+              arma::vec alias = threadLogTransition.unsafe_col(j);
+              math::LogSumExp<arma::vec, true>(tmp2, alias);
+            }
           }
+
+          // Add to list of emission observations, for Distribution::Train().
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
+            emissionProb[j][seqOffsets[seq] + t] = exp(stateLogProb(j, t));
+          emissionList.col(seqOffsets[seq] + t) = dataSeq[seq].col(t);
         }
+      }
 
-        // Add to list of emission observations, for Distribution::Train().
+      // Merge the per-thread accumulators into the shared estimates.
+      #pragma omp critical
+      {
+        loglik += threadLoglik;
+        math::LogSumExp<arma::vec, true>(threadLogInitial, newLogInitial);
         for (size_t j = 0; j < logTransition.n_cols; ++j)
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
-        emissionList.col(sumTime) = dataSeq[seq].col(t);
-        sumTime++;
+        {
+          arma::vec alias = newLogTransition.unsafe_col(j);
+          math::LogSumExp<arma::vec, true>(threadLogTransition.unsafe_col(j),
+              alias);
+        }
       }
     }
 
@@ -232,8 +271,11 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
 
     initialProxy = exp(logInitial);
     transitionProxy = exp(logTransition);
-    // Now estimate emission probabilities.
-    for (size_t state = 0; state < logTransition.n_cols; state++)
+    // Now estimate emission probabilities.  Each state's distribution is
+    // trained independently, so this can also be done in parallel.
+    #pragma omp parallel for
+    for (omp_size_t state = 0; state < (omp_size_t) logTransition.n_cols;
+        state++)
       emission[state].Train(emissionList, emissionProb[state]);
 
     Log::Debug << "Iteration " << iter << ": log-likelihood " << loglik
@@ -343,6 +385,156 @@ void HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq,
   }
 }
 
+/**
+ * Incrementally train the model on the given new unlabeled observation
+ * sequences, folding their expected counts into decayed sufficient statistics.
+ */
+template<typename Distribution>
+double HMM<Distribution>::TrainIncremental(
+    const std::vector<arma::mat>& dataSeq,
+    const double decay)
+{
+  if (decay <= 0.0 || decay > 1.0)
+  {
+    Log::Fatal << "HMM::TrainIncremental(): decay (" << decay << ") must be "
+        << "in the range (0, 1]." << std::endl;
+  }
+
+  // Find length of all sequences and ensure they are the correct size.
+  size_t totalLength = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    totalLength += dataSeq[seq].n_cols;
+
+    if (dataSeq[seq].n_rows != dimensionality)
+      Log::Fatal << "HMM::TrainIncremental(): data sequence " << seq << " has "
+          << "dimensionality " << dataSeq[seq].n_rows << " (expected "
+          << dimensionality << " dimensions)." << std::endl;
+  }
+
+  ConvertToLogSpace();
+
+  const size_t states = logTransition.n_rows;
+
+  // Run a single E-step over the new sequences, with the current parameters.
+  // This is the same expected-count computation that Train() performs, but
+  // only once, and only over the new data.
+  arma::vec newLogInitial(states);
+  newLogInitial.fill(-std::numeric_limits<double>::infinity());
+  arma::mat newLogTransition(states, states);
+  newLogTransition.fill(-std::numeric_limits<double>::infinity());
+  arma::mat newEmissionList(dimensionality, totalLength);
+  arma::mat newEmissionProb(states, totalLength);
+
+  double loglik = 0;
+  size_t sumTime = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    arma::mat stateLogProb;
+    arma::mat forwardLog;
+    arma::mat backwardLog;
+    arma::vec logScales;
+
+    loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+        backwardLog, logScales);
+
+    // Add to estimate of initial probability for state j.
+    math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
+        newLogInitial);
+
+    // Batch-compute the per-state emission log-probabilities.
+    arma::mat logProbs(dataSeq[seq].n_cols, states);
+    for (size_t i = 0; i < states; i++)
+    {
+      arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+      emission[i].LogProbability(dataSeq[seq], alias);
+    }
+
+    for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+    {
+      // Accumulate the expected transition counts (in log space, with the
+      // multiplication by the old transition matrix postponed, exactly as in
+      // Train()).
+      if (t < dataSeq[seq].n_cols - 1)
+      {
+        const arma::vec tmp = backwardLog.col(t + 1) +
+            logProbs.row(t + 1).t() - logScales[t + 1];
+        arma::vec output;
+        math::LogSumExp(tmp, output);
+
+        for (size_t j = 0; j < states; ++j)
+        {
+          arma::vec tmp2 = output + forwardLog(j, t);
+          arma::vec alias = newLogTransition.unsafe_col(j);
+          math::LogSumExp<arma::vec, true>(tmp2, alias);
+        }
+      }
+
+      // Save the responsibilities and the observation for the emission update.
+      newEmissionProb.col(sumTime) = exp(stateLogProb.col(t));
+      newEmissionList.col(sumTime) = dataSeq[seq].col(t);
+      sumTime++;
+    }
+  }
+
+  // If the retained statistics do not match the model (first call, or the
+  // model was loaded or resized), start accumulating from scratch.
+  if (initialStats.n_elem != states)
+  {
+    initialStats.zeros(states);
+    transitionStats.zeros(states, states);
+    emissionBuffer.set_size(dimensionality, 0);
+    emissionProbBuffer.set_size(states, 0);
+  }
+
+  // Fold the new expected counts into the decayed sufficient statistics.
+  // The expected transition counts are the postponed elementwise product of
+  // the old transition matrix with the accumulated log-sums.
+  initialStats = decay * initialStats + exp(newLogInitial);
+  transitionStats = decay * transitionStats +
+      transitionProxy % exp(newLogTransition);
+
+  // Decay the buffered emission responsibilities, and drop observations whose
+  // total weight has become insignificant, so the buffer stays bounded when
+  // decay < 1.
+  if (emissionBuffer.n_cols > 0)
+  {
+    emissionProbBuffer *= decay;
+    if (decay < 1.0)
+    {
+      const arma::uvec keep =
+          arma::find(arma::sum(emissionProbBuffer, 0) >= 1e-4);
+      emissionBuffer = emissionBuffer.cols(keep);
+      emissionProbBuffer = emissionProbBuffer.cols(keep);
+    }
+  }
+  emissionBuffer = arma::join_rows(emissionBuffer, newEmissionList);
+  emissionProbBuffer = arma::join_rows(emissionProbBuffer, newEmissionProb);
+
+  // Now the M-step: re-estimate the parameters from the statistics.
+  logInitial = log(initialStats / arma::accu(initialStats));
+
+  for (size_t i = 0; i < states; i++)
+  {
+    const double sum = arma::accu(transitionStats.col(i));
+    if (sum > 0)
+      logTransition.col(i) = log(transitionStats.col(i) / sum);
+    else
+      logTransition.col(i).fill(-log((double) states));
+  }
+
+  initialProxy = exp(logInitial);
+  transitionProxy = exp(logTransition);
+
+  // Re-estimate the emission distributions from the weighted buffer.  Each
+  // state's distribution is trained independently, so this is parallelized.
+  #pragma omp parallel for
+  for (omp_size_t state = 0; state < (omp_size_t) states; state++)
+    emission[state].Train(emissionBuffer, emissionProbBuffer.row(state).t());
+
+  return loglik;
+}
+
 /**
  * Estimate the probabilities of each hidden state at each time step for each
  * given data observation.
@@ -484,17 +676,116 @@ void HMM<Distribution>::Generate(const size_t length,
  */
 template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
-                                  arma::Row<size_t>& stateSeq) const
+                                  arma::Row<size_t>& stateSeq,
+                                  const size_t beamWidth) const
+{
+  ConvertToLogSpace();
+
+  // Define a variable to store the value of log-probability for dataSeq.
+  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+
+  // Save the values of log-probability to logProbs.
+  for (size_t i = 0; i < logTransition.n_rows; i++)
+  {
+    // Define alias of desired column.
+    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+    // Use advanced constructor for using logProbs directly.
+    emission[i].LogProbability(dataSeq, alias);
+  }
+
+  return ViterbiDecode(logProbs, stateSeq, beamWidth);
+}
+
+/**
+ * Compute the most probable hidden state sequences for a batch of
+ * observation sequences, sharing one emission pass and decoding the
+ * sequences in parallel.
+ */
+template<typename Distribution>
+arma::vec HMM<Distribution>::Predict(
+    const std::vector<arma::mat>& dataSeqs,
+    std::vector<arma::Row<size_t>>& stateSeqs,
+    const size_t beamWidth) const
+{
+  stateSeqs.resize(dataSeqs.size());
+  arma::vec logLikelihoods(dataSeqs.size());
+  if (dataSeqs.empty())
+    return logLikelihoods;
+
+  ConvertToLogSpace();
+
+  // Concatenate all sequences, so that each state's emission
+  // log-probabilities can be computed in a single vectorized pass over every
+  // observation of every sequence.
+  size_t totalLength = 0;
+  std::vector<size_t> offsets(dataSeqs.size());
+  for (size_t seq = 0; seq < dataSeqs.size(); ++seq)
+  {
+    offsets[seq] = totalLength;
+    totalLength += dataSeqs[seq].n_cols;
+  }
+
+  arma::mat allData(dimensionality, totalLength);
+  for (size_t seq = 0; seq < dataSeqs.size(); ++seq)
+  {
+    if (dataSeqs[seq].n_cols > 0)
+    {
+      allData.cols(offsets[seq], offsets[seq] + dataSeqs[seq].n_cols - 1) =
+          dataSeqs[seq];
+    }
+  }
+
+  arma::mat logProbs(totalLength, logTransition.n_rows);
+  for (size_t i = 0; i < logTransition.n_rows; i++)
+  {
+    // Define alias of desired column.
+    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+    // Use advanced constructor for using logProbs directly.
+    emission[i].LogProbability(allData, alias);
+  }
+
+  // The Viterbi recursions of the sequences are independent, and
+  // ViterbiDecode() only reads the model, so the sequences can be decoded
+  // concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t seq = 0; seq < (omp_size_t) dataSeqs.size(); ++seq)
+  {
+    if (dataSeqs[seq].n_cols == 0)
+    {
+      stateSeqs[seq].clear();
+      logLikelihoods(seq) = 0.0;
+      continue;
+    }
+
+    const arma::mat seqLogProbs = logProbs.rows(offsets[seq],
+        offsets[seq] + dataSeqs[seq].n_cols - 1);
+    logLikelihoods(seq) = ViterbiDecode(seqLogProbs, stateSeqs[seq],
+        beamWidth);
+  }
+
+  return logLikelihoods;
+}
+
+/**
+ * The Viterbi recursion over precomputed emission log-probabilities, with
+ * optional beam pruning.
+ */
+template<typename Distribution>
+double HMM<Distribution>::ViterbiDecode(const arma::mat& logProbs,
+                                        arma::Row<size_t>& stateSeq,
+                                        const size_t beamWidth) const
 {
   // This is an implementation of the Viterbi algorithm for finding the most
   // probable sequence of states to produce the observed data sequence.  We
   // don't use log-likelihoods to save that little bit of time, but we'll
   // calculate the log-likelihood at the end of it all.
-  stateSeq.set_size(dataSeq.n_cols);
-  arma::mat logStateProb(logTransition.n_rows, dataSeq.n_cols);
-  arma::mat stateSeqBack(logTransition.n_rows, dataSeq.n_cols);
+  const size_t seqLength = logProbs.n_rows;
+  stateSeq.set_size(seqLength);
+  arma::mat logStateProb(logTransition.n_rows, seqLength);
+  arma::mat stateSeqBack(logTransition.n_rows, seqLength);
 
-  ConvertToLogSpace();
+  // A beam at least as wide as the state set means no pruning at all.
+  const bool useBeam = (beamWidth > 0) && (beamWidth < logTransition.n_rows);
 
   // The calculation of the first state is slightly different; the probability
   // of the first state being state j is the maximum probability that the state
@@ -502,49 +793,74 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
   logStateProb.col(0).zeros();
   for (size_t state = 0; state < logTransition.n_rows; state++)
   {
-    logStateProb(state, 0) = logInitial[state] +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
+    logStateProb(state, 0) = logInitial[state] + logProbs(0, state);
     stateSeqBack(state, 0) = state;
   }
 
   // Store the best first state.
   arma::uword index;
 
-  // Define a variable to store the value of log-probability for dataSeq.
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
-
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
-  {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
-  }
+  // Reuse this matrix across time steps to avoid reallocation; prob(j, i) is
+  // the probability of being in state i at time t - 1 and transitioning to
+  // state j.
+  arma::mat prob;
+  if (!useBeam)
+    prob.set_size(logTransition.n_rows, logTransition.n_cols);
 
-  for (size_t t = 1; t < dataSeq.n_cols; t++)
+  for (size_t t = 1; t < seqLength; t++)
   {
-    // Assemble the state probability for this element.
-    // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < logTransition.n_rows; j++)
+    if (!useBeam)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) + logProbs(t, j);
-      stateSeqBack(j, t) = index;
+      // Assemble the state probability for this element.
+      // Given that we are in state j, we use state with the highest
+      // probability of being the previous state.  This is done for all states
+      // at once: the maximum of each row of prob is the best predecessor for
+      // that state.
+      prob = logTransition.each_row() + logStateProb.col(t - 1).t();
+      logStateProb.col(t) = arma::max(prob, 1) + logProbs.row(t).t();
+      stateSeqBack.col(t) = arma::conv_to<arma::colvec>::from(
+          arma::index_max(prob, 1));
+    }
+    else
+    {
+      // Beam pruning: only the beamWidth most probable states at time t - 1
+      // are considered as candidate predecessors, so each step costs
+      // O(beamWidth * states) instead of O(states^2).
+      const arma::uvec beam = arma::conv_to<arma::uvec>::from(
+          arma::sort_index(logStateProb.col(t - 1), "descend"));
+
+      for (size_t j = 0; j < logTransition.n_rows; ++j)
+      {
+        double bestLogProb = -DBL_MAX;
+        size_t bestState = beam[0];
+        for (size_t b = 0; b < beamWidth; ++b)
+        {
+          const size_t i = beam[b];
+          const double candidate = logTransition(j, i) +
+              logStateProb(i, t - 1);
+          if (candidate > bestLogProb)
+          {
+            bestLogProb = candidate;
+            bestState = i;
+          }
+        }
+
+        logStateProb(j, t) = bestLogProb + logProbs(t, j);
+        stateSeqBack(j, t) = bestState;
+      }
     }
   }
 
   // Backtrack to find the most probable state sequence.
-  logStateProb.unsafe_col(dataSeq.n_cols - 1).max(index);
-  stateSeq[dataSeq.n_cols - 1] = index;
-  for (size_t t = 2; t <= dataSeq.n_cols; t++)
+  logStateProb.unsafe_col(seqLength - 1).max(index);
+  stateSeq[seqLength - 1] = index;
+  for (size_t t = 2; t <= seqLength; t++)
   {
-    stateSeq[dataSeq.n_cols - t] =
-        stateSeqBack(stateSeq[dataSeq.n_cols - t + 1], dataSeq.n_cols - t + 1);
+    stateSeq[seqLength - t] =
+        stateSeqBack(stateSeq[seqLength - t + 1], seqLength - t + 1);
   }
 
-  return logStateProb(stateSeq(dataSeq.n_cols - 1), dataSeq.n_cols - 1);
+  return logStateProb(stateSeq(seqLength - 1), seqLength - 1);
 }
 
 /**
@@ -747,13 +1063,22 @@ arma::vec HMM<Distribution>::ForwardAtTn(const arma::vec& emissionLogProb,
 
   // The forward probability of state j at time t is the sum over all states of
   // the probability of the previous state transitioning to the current state
-  // and emitting the given observation.  To do this computation in log-space,
-  // we can use LogSumExp().
-  arma::vec forwardLogProb;
-  arma::mat tmp = logTransition + repmat(prevForwardLogProb.t(),
-      logTransition.n_rows, 1);
-  math::LogSumExp(tmp, forwardLogProb);
-  forwardLogProb += emissionLogProb;
+  // and emitting the given observation.  Instead of assembling an n x n
+  // matrix in log space and reducing it with LogSumExp(), we shift the
+  // previous forward probabilities by their maximum, exponentiate, and use a
+  // single matrix-vector product with the linear-space transition matrix;
+  // this computes the same log-sum with far less memory traffic.
+  arma::vec forwardLogProb(logTransition.n_rows);
+  const double shift = prevForwardLogProb.max();
+  if (std::isfinite(shift))
+  {
+    forwardLogProb = log(transitionProxy * exp(prevForwardLogProb - shift)) +
+        shift + emissionLogProb;
+  }
+  else
+  {
+    forwardLogProb.fill(-std::numeric_limits<double>::infinity());
+  }
 
   // Normalize probability.
   logScales = math::AccuLog(forwardLogProb);
@@ -809,19 +1134,24 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   // The last element probability is 1.
   backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
 
+  // Transpose the linear-space transition matrix once, so each step below is
+  // a single matrix-vector product with contiguous access.
+  const arma::mat transitionT = trans(transitionProxy);
+
   // Now step backwards through all other observations.
   for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
   {
     // The backward probability of state j at time t is the sum over all
     // states of the probability of the next state having been a transition
     // from the current state multiplied by the probability of each of those
-    // states emitting the given observation.  To compute this in log-space, we
-    // can use LogSumExpT().
-    const arma::mat tmp = logTransition +
-        repmat(backwardLogProb.col(t + 1), 1, logTransition.n_cols) +
-        repmat(logProbs.row(t + 1).t(), 1, logTransition.n_cols);
-    arma::vec alias = backwardLogProb.unsafe_col(t);
-    math::LogSumExpT<arma::mat, true>(tmp, alias);
+    // states emitting the given observation.  As in ForwardAtTn(), we compute
+    // this log-sum by shifting with the maximum, exponentiating, and
+    // multiplying with the linear-space transition matrix, instead of
+    // reducing an n x n matrix in log space.
+    const arma::vec next = backwardLogProb.col(t + 1) + logProbs.row(t + 1).t();
+    const double shift = next.max();
+    if (std::isfinite(shift))
+      backwardLogProb.col(t) = log(transitionT * exp(next - shift)) + shift;
 
     // Normalize by the weights from the forward algorithm.
     if (std::isfinite(logScales[t + 1]))
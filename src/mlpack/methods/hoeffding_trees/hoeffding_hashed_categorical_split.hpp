@@ -0,0 +1,165 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_hashed_categorical_split.hpp
+ *
+ * A categorical split for Hoeffding trees that stores its sufficient
+ * statistics in a hashed sparse table, for use with high-cardinality
+ * categorical features.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_HASHED_CATEGORICAL_SPLIT_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_HASHED_CATEGORICAL_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include "categorical_split_info.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A drop-in alternative to HoeffdingCategoricalSplit that keeps the
+ * per-category class counts in an open-addressing hash table instead of a
+ * dense `numClasses` x `numCategories` matrix.  Memory use and per-event cost
+ * then depend only on the number of categories actually seen at this node,
+ * not on the cardinality of the feature, which makes features with thousands
+ * of (mostly rare) categories practical.
+ *
+ * Each table slot stores the class counts of its category contiguously, so a
+ * training event touches one probe in the (compact, mostly cache-resident)
+ * key array and one counter in a single contiguous block.  The table doubles
+ * and rehashes when it becomes three-quarters full; since counts are never
+ * removed, this growth rehash is the only rebuild the table ever needs.
+ *
+ * The split decisions are identical to those of HoeffdingCategoricalSplit:
+ * categories that have never been seen hold zero counts and contribute
+ * nothing to any of the fitness functions, so evaluating over the seen
+ * categories only gives the same gain.
+ *
+ * @tparam FitnessFunction Fitness function to use for calculating gain.
+ */
+template<typename FitnessFunction>
+class HoeffdingHashedCategoricalSplit
+{
+ public:
+  //! The type of split information required by the
+  //! HoeffdingHashedCategoricalSplit.
+  typedef CategoricalSplitInfo SplitInfo;
+
+  /**
+   * Create the HoeffdingHashedCategoricalSplit given a number of categories
+   * for this dimension and a number of classes.
+   *
+   * @param numCategories Number of categories in this dimension.
+   * @param numClasses Number of classes in this dimension.
+   */
+  HoeffdingHashedCategoricalSplit(const size_t numCategories = 0,
+                                  const size_t numClasses = 0);
+
+  /**
+   * Create the HoeffdingHashedCategoricalSplit given a number of categories
+   * for this dimension and a number of classes and another split to take
+   * parameters from.  In this particular case, there are no parameters to
+   * take, but this constructor is required by the HoeffdingTree class.
+   */
+  HoeffdingHashedCategoricalSplit(
+      const size_t numCategories,
+      const size_t numClasses,
+      const HoeffdingHashedCategoricalSplit& other);
+
+  /**
+   * Train on the given value with the given label.
+   *
+   * @param value Value to train on.
+   * @param label Label to train on.
+   */
+  template<typename eT>
+  void Train(eT value, const size_t label);
+
+  /**
+   * Given the points seen so far, evaluate the fitness function, returning the
+   * gain for the best possible split and the second best possible split.  In
+   * this splitting technique, we only split one possible way, so
+   * secondBestFitness will always be 0.
+   *
+   * @param bestFitness The fitness function result for this split.
+   * @param secondBestFitness This is always set to 0 (this split only splits
+   *      one way).
+   */
+  void EvaluateFitnessFunction(double& bestFitness, double& secondBestFitness)
+      const;
+
+  //! Return the number of children, if the node were to split.
+  size_t NumChildren() const { return numCategories; }
+
+  /**
+   * Gather the information for a split: get the labels of the child majorities,
+   * and initialize the SplitInfo object.
+   *
+   * @param childMajorities Majorities of child nodes to be created.
+   * @param splitInfo Information for splitting.
+   */
+  void Split(arma::Col<size_t>& childMajorities, SplitInfo& splitInfo);
+
+  //! Get the majority class seen so far.
+  size_t MajorityClass() const;
+  //! Get the probability of the majority class given the points seen so far.
+  double MajorityProbability() const;
+
+  //! Get the number of distinct categories seen so far.
+  size_t NumSeenCategories() const { return numSeen; }
+
+  //! Serialize the categorical split.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numCategories));
+    ar(CEREAL_NVP(numClasses));
+    ar(CEREAL_NVP(numSeen));
+    ar(CEREAL_NVP(keys));
+    ar(CEREAL_NVP(counts));
+    ar(CEREAL_NVP(classCounts));
+  }
+
+ private:
+  /**
+   * Find the table slot of the given category, inserting it (and growing the
+   * table if necessary) if it has not been seen before.
+   */
+  size_t Slot(const size_t category);
+
+  //! Double the table and reinsert all of the seen categories.
+  void Grow();
+
+  //! Number of categories in this dimension.
+  size_t numCategories;
+
+  //! Number of classes in this dimension.
+  size_t numClasses;
+
+  //! Number of distinct categories seen so far (occupied table slots).
+  size_t numSeen;
+
+  //! Category of each table slot, offset by one (0 denotes an empty slot).
+  //! The table size is always a power of two.
+  std::vector<size_t> keys;
+
+  //! Class counts of each table slot; the counts of slot `s` are the
+  //! `numClasses` contiguous entries starting at `s * numClasses`.
+  std::vector<size_t> counts;
+
+  //! Total count of each class over all categories, kept up to date so the
+  //! majority class does not require a sweep over the table.
+  std::vector<size_t> classCounts;
+}; // class HoeffdingHashedCategoricalSplit
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "hoeffding_hashed_categorical_split_impl.hpp"
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_hashed_categorical_split_impl.hpp
+ *
+ * Implementation of the HoeffdingHashedCategoricalSplit class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_HASHED_CATEGORICAL_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_HASHED_CATEGORICAL_SPLIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hoeffding_hashed_categorical_split.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+HoeffdingHashedCategoricalSplit<FitnessFunction>::
+HoeffdingHashedCategoricalSplit(
+    const size_t numCategories,
+    const size_t numClasses) :
+    numCategories(numCategories),
+    numClasses(numClasses),
+    numSeen(0),
+    keys(8, 0),
+    counts(8 * numClasses, 0),
+    classCounts(numClasses, 0)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction>
+HoeffdingHashedCategoricalSplit<FitnessFunction>::
+HoeffdingHashedCategoricalSplit(
+    const size_t numCategories,
+    const size_t numClasses,
+    const HoeffdingHashedCategoricalSplit& /* other */) :
+    numCategories(numCategories),
+    numClasses(numClasses),
+    numSeen(0),
+    keys(8, 0),
+    counts(8 * numClasses, 0),
+    classCounts(numClasses, 0)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction>
+template<typename eT>
+void HoeffdingHashedCategoricalSplit<FitnessFunction>::Train(
+    eT value,
+    const size_t label)
+{
+  // 'value' should be categorical, so we should be able to cast to size_t...
+  const size_t slot = Slot(size_t(value));
+
+  counts[slot * numClasses + label]++;
+  classCounts[label]++;
+}
+
+template<typename FitnessFunction>
+void HoeffdingHashedCategoricalSplit<FitnessFunction>::
+EvaluateFitnessFunction(double& bestFitness, double& secondBestFitness) const
+{
+  // Gather the counts of the seen categories into a compact matrix.  The
+  // categories that have never been seen hold zero counts, and all-zero
+  // columns contribute nothing to the fitness functions, so this evaluates to
+  // the same gain as the dense representation would.
+  arma::Mat<size_t> seenStatistics(numClasses, numSeen);
+  size_t col = 0;
+  for (size_t slot = 0; slot < keys.size(); ++slot)
+  {
+    if (keys[slot] == 0)
+      continue;
+
+    for (size_t label = 0; label < numClasses; ++label)
+      seenStatistics(label, col) = counts[slot * numClasses + label];
+    ++col;
+  }
+
+  bestFitness = FitnessFunction::Evaluate(seenStatistics);
+  secondBestFitness = 0.0; // We only split one possible way.
+}
+
+template<typename FitnessFunction>
+void HoeffdingHashedCategoricalSplit<FitnessFunction>::Split(
+    arma::Col<size_t>& childMajorities,
+    SplitInfo& splitInfo)
+{
+  // We'll make one child for each category.  Categories that have never been
+  // seen get class 0 as their majority, matching the dense representation
+  // (where the maximum of an all-zero column is at index 0).
+  childMajorities.zeros(numCategories);
+  for (size_t slot = 0; slot < keys.size(); ++slot)
+  {
+    if (keys[slot] == 0)
+      continue;
+
+    size_t majority = 0;
+    for (size_t label = 1; label < numClasses; ++label)
+    {
+      if (counts[slot * numClasses + label] >
+          counts[slot * numClasses + majority])
+        majority = label;
+    }
+
+    childMajorities[keys[slot] - 1] = majority;
+  }
+
+  // Create the according SplitInfo object.
+  splitInfo = SplitInfo(numCategories);
+}
+
+template<typename FitnessFunction>
+size_t HoeffdingHashedCategoricalSplit<FitnessFunction>::MajorityClass() const
+{
+  // Calculate the class that we have seen the most of.
+  size_t majority = 0;
+  for (size_t label = 1; label < numClasses; ++label)
+  {
+    if (classCounts[label] > classCounts[majority])
+      majority = label;
+  }
+
+  return majority;
+}
+
+template<typename FitnessFunction>
+double HoeffdingHashedCategoricalSplit<FitnessFunction>::
+MajorityProbability() const
+{
+  size_t majority = 0;
+  size_t total = classCounts[0];
+  for (size_t label = 1; label < numClasses; ++label)
+  {
+    if (classCounts[label] > classCounts[majority])
+      majority = label;
+    total += classCounts[label];
+  }
+
+  return double(classCounts[majority]) / double(total);
+}
+
+template<typename FitnessFunction>
+size_t HoeffdingHashedCategoricalSplit<FitnessFunction>::Slot(
+    const size_t category)
+{
+  // Grow before inserting, so that the linear probe below always finds either
+  // the category or an empty slot, and the table stays at most
+  // three-quarters full.
+  if (4 * (numSeen + 1) > 3 * keys.size())
+    Grow();
+
+  // The table size is a power of two, so masking the mixed bits of the
+  // category gives the starting slot of the linear probe.
+  const size_t mask = keys.size() - 1;
+  size_t slot = math::MixSeed(category) & mask;
+  while (keys[slot] != 0 && keys[slot] != category + 1)
+    slot = (slot + 1) & mask;
+
+  if (keys[slot] == 0)
+  {
+    keys[slot] = category + 1;
+    ++numSeen;
+  }
+
+  return slot;
+}
+
+template<typename FitnessFunction>
+void HoeffdingHashedCategoricalSplit<FitnessFunction>::Grow()
+{
+  std::vector<size_t> oldKeys(2 * keys.size(), 0);
+  std::vector<size_t> oldCounts(2 * counts.size(), 0);
+  oldKeys.swap(keys);
+  oldCounts.swap(counts);
+
+  // Reinsert every seen category into the doubled table.
+  const size_t mask = keys.size() - 1;
+  for (size_t oldSlot = 0; oldSlot < oldKeys.size(); ++oldSlot)
+  {
+    if (oldKeys[oldSlot] == 0)
+      continue;
+
+    size_t slot = math::MixSeed(oldKeys[oldSlot] - 1) & mask;
+    while (keys[slot] != 0)
+      slot = (slot + 1) & mask;
+
+    keys[slot] = oldKeys[oldSlot];
+    for (size_t label = 0; label < numClasses; ++label)
+      counts[slot * numClasses + label] =
+          oldCounts[oldSlot * numClasses + label];
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -15,9 +15,12 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/data/dataset_mapper.hpp>
+#include <atomic>
+#include <mutex>
 #include "gini_impurity.hpp"
 #include "hoeffding_numeric_split.hpp"
 #include "hoeffding_categorical_split.hpp"
+#include "hoeffding_hashed_categorical_split.hpp"
 
 namespace mlpack {
 namespace tree {
@@ -237,6 +240,37 @@ class HoeffdingTree
   template<typename VecType>
   void Train(const VecType& point, const size_t label);
 
+  /**
+   * Train on a single point in streaming mode, with the given label, safely
+   * from multiple threads at once.  Routing from the root to a leaf is
+   * lock-free: an internal node publishes its children with release ordering
+   * only after they are fully built, so readers never see a half-split node.
+   * Leaf statistics updates and the split decision itself happen under a
+   * short leaf-local lock, so threads only contend when they land on the same
+   * leaf.
+   *
+   * Do not mix calls to this method with calls to the non-concurrent Train()
+   * overloads (or any other non-const method) from other threads.
+   *
+   * @param point Point to train on.
+   * @param label Label of point to train on.
+   */
+  template<typename VecType>
+  void TrainConcurrent(const VecType& point, const size_t label);
+
+  /**
+   * Train on a set of points in streaming mode, splitting the points across
+   * all available threads.  See the single-point TrainConcurrent() for the
+   * concurrency guarantees.  Note that the result depends on the order in
+   * which the threads interleave, so this is not bitwise-reproducible across
+   * runs.
+   *
+   * @param data Data points to train on.
+   * @param labels Labels of data points.
+   */
+  template<typename MatType>
+  void TrainConcurrent(const MatType& data, const arma::Row<size_t>& labels);
+
   /**
    * Check if a split would satisfy the conditions of the Hoeffding bound with
    * the node's specified success probability.  If so, the number of children
@@ -403,6 +437,12 @@ class HoeffdingTree
   typename NumericSplitType<FitnessFunction>::SplitInfo numericSplit;
   //! If the split has occurred, these are the children.
   std::vector<HoeffdingTree*> children;
+  //! Set (with release ordering) only once `children` is fully built, so that
+  //! concurrent training can route points to leaves without taking a lock.
+  std::atomic<bool> childrenReady;
+  //! Guards this node's split statistics and split decision during concurrent
+  //! training.  Not copied or serialized.
+  mutable std::mutex leafMutex;
 
   /**
    * Perform training (typically after a reset, but not necessarily).  This
@@ -53,7 +53,8 @@ HoeffdingTree<
     majorityClass(0),
     majorityProbability(0.0),
     categoricalSplit(0),
-    numericSplit()
+    numericSplit(),
+    childrenReady(false)
 {
   // Reset the tree.
   ResetTree(categoricalSplitIn, numericSplitIn);
@@ -97,7 +98,8 @@ HoeffdingTree<
     majorityClass(0),
     majorityProbability(0.0),
     categoricalSplit(0),
-    numericSplit()
+    numericSplit(),
+    childrenReady(false)
 {
   // Do we need to generate the mappings too?
   if (ownsMappings)
@@ -145,7 +147,8 @@ HoeffdingTree<
     majorityClass(0),
     majorityProbability(0.0),
     categoricalSplit(0),
-    numericSplit()
+    numericSplit(),
+    childrenReady(false)
 {
   // Nothing to do.
 }
@@ -173,7 +176,8 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     majorityClass(other.majorityClass),
     majorityProbability(other.majorityProbability),
     categoricalSplit(other.categoricalSplit),
-    numericSplit(other.numericSplit)
+    numericSplit(other.numericSplit),
+    childrenReady(false)
 {
   // Copy each of the children.
   for (size_t i = 0; i < other.children.size(); ++i)
@@ -189,6 +193,8 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     children[i]->dimensionMappings = this->dimensionMappings;
     children[i]->ownsMappings = false;
   }
+
+  childrenReady.store(children.size() > 0, std::memory_order_release);
 }
 
 // Move constructor.
@@ -213,7 +219,8 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     majorityClass(other.majorityClass),
     majorityProbability(other.majorityProbability),
     categoricalSplit(std::move(other.categoricalSplit)),
-    numericSplit(std::move(other.numericSplit))
+    numericSplit(std::move(other.numericSplit)),
+    childrenReady(false)
 {
   // Remove pointers.
   other.dimensionMappings = nullptr;
@@ -273,6 +280,8 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
       children[i]->dimensionMappings = this->dimensionMappings;
       children[i]->ownsMappings = false;
     }
+
+    childrenReady.store(children.size() > 0, std::memory_order_release);
   }
   return *this;
 }
@@ -459,6 +468,57 @@ void HoeffdingTree<
   }
 }
 
+//! Train on one point from (possibly) multiple threads.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainConcurrent(const VecType& point, const size_t label)
+{
+  HoeffdingTree* node = this;
+  while (true)
+  {
+    // Lock-free descent to a leaf: childrenReady is published (with release
+    // ordering) only after a node's children are fully built, so if we see it
+    // set, the children and the split information are safe to read.
+    while (node->childrenReady.load(std::memory_order_acquire))
+      node = node->children[node->CalculateDirection(point)];
+
+    std::lock_guard<std::mutex> lock(node->leafMutex);
+
+    // The node may have split while we were waiting for the lock; if so, keep
+    // descending from it.
+    if (node->childrenReady.load(std::memory_order_acquire))
+      continue;
+
+    // We hold the only lock on this leaf, so the serial single-point logic
+    // applies directly: update the leaf's split statistics, and possibly
+    // split it (CreateChildren() publishes childrenReady last).
+    node->Train(point, label);
+    return;
+  }
+}
+
+//! Train on a set of points, one point per thread at a time.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainConcurrent(const MatType& data, const arma::Row<size_t>& labels)
+{
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    TrainConcurrent(data.col(i), labels[i]);
+}
+
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType>
@@ -811,6 +871,10 @@ void HoeffdingTree<
   // Eliminate now-unnecessary split information.
   numericSplits.clear();
   categoricalSplits.clear();
+
+  // Publish the children last, so that concurrent training threads routing
+  // on childrenReady never see a partially-built split.
+  childrenReady.store(true, std::memory_order_release);
 }
 
 template<
@@ -852,6 +916,7 @@ void HoeffdingTree<
     for (size_t i = 0; i < children.size(); ++i)
       delete children[i];
     children.clear();
+    childrenReady.store(false, std::memory_order_release);
   }
 
   ar(CEREAL_NVP(majorityClass));
@@ -914,6 +979,8 @@ void HoeffdingTree<
 
     if (cereal::is_loading<Archive>())
     {
+      childrenReady.store(children.size() > 0, std::memory_order_release);
+
       for (size_t i = 0; i < children.size(); ++i)
       {
         // The child doesn't actually own its own DatasetInfo.  We do.  The same
@@ -1057,6 +1124,7 @@ void HoeffdingTree<
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
   children.clear();
+  childrenReady.store(false, std::memory_order_release);
 
   // Reset statistics.
   numSamples = 0;
@@ -14,6 +14,8 @@
 #define MLPACK_METHODS_KDE_KDE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <unordered_set>
+
 #include <mlpack/core/tree/binary_space_tree.hpp>
 
 #include "kde_stat.hpp"
@@ -57,6 +59,24 @@ struct KDEDefaultParams
   static constexpr double mcBreakCoef = 0.4;
 };
 
+/**
+ * EvaluationStats holds the work counters of a single call to
+ * KDE::Evaluate().  (This is the per-call counter object, not to be confused
+ * with KDEStat, which is the per-tree-node statistic.)
+ */
+struct EvaluationStats
+{
+  //! The number of base case (point-to-point kernel) evaluations performed.
+  size_t baseCases = 0;
+  //! The number of node combinations scored.
+  size_t scores = 0;
+  //! The number of node combinations pruned without recursion.
+  size_t prunes = 0;
+  //! Wall-clock time spent in the traversal phase of the evaluation
+  //! (excluding query tree building and normalization).
+  std::chrono::microseconds traversalTime{0};
+};
+
 /**
  * The KDE class is a template class for performing Kernel Density Estimations.
  * In statistics, kernel density estimation is a way to estimate the
@@ -225,6 +245,96 @@ class KDE
    */
   void Evaluate(arma::vec& estimations);
 
+  /**
+   * Estimate the density of each query point under several kernel bandwidths
+   * in a single traversal.  This amortizes the traversal cost across a
+   * bandwidth sweep: a node combination is pruned only once every kernel of
+   * the sweep can prune it, so the tree is walked once instead of once per
+   * bandwidth.  Estimations might not be normalized.
+   *
+   * Monte Carlo estimations are not applied in multi-bandwidth mode; every
+   * estimation is deterministic within the error tolerances of the model.
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to get the density of.
+   * @param kernels Instantiated kernels, one per bandwidth of the sweep.
+   * @param estimations Matrix which will hold the density of each query
+   *                    point; one row per kernel and one column per query
+   *                    point.
+   */
+  void Evaluate(MatType querySet,
+                std::vector<KernelType> kernels,
+                arma::mat& estimations);
+
+  /**
+   * Estimate the density of each reference point under several kernel
+   * bandwidths in a single traversal, without computing the estimation of a
+   * point with itself.  Estimations might not be normalized.
+   *
+   * Monte Carlo estimations are not applied in multi-bandwidth mode; every
+   * estimation is deterministic within the error tolerances of the model.
+   *
+   * @pre The model has to be previously trained.
+   * @param kernels Instantiated kernels, one per bandwidth of the sweep.
+   * @param estimations Matrix which will hold the density of each reference
+   *                    point; one row per kernel and one column per
+   *                    reference point.
+   */
+  void Evaluate(std::vector<KernelType> kernels, arma::mat& estimations);
+
+  /**
+   * Insert new reference points without rebuilding the reference tree.  The
+   * points are kept in a side buffer (the delta set) whose kernel
+   * contributions every subsequent Evaluate() adds by brute force, so
+   * insertion cost scales with the number of inserted points rather than the
+   * reference set size.
+   *
+   * When the pending changes (inserts plus lazy deletes) exceed
+   * RebuildThreshold() times the reference set size, the tree is rebuilt on
+   * the merged set.
+   *
+   * Note that the monochromatic Evaluate(estimations) overload does not
+   * compute densities for pending inserted points; they only contribute to
+   * the densities of the tree points.
+   *
+   * @pre The model has to be previously trained.
+   * @param points New reference points, one per column.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Lazily delete a reference point.  For a tree point, the index refers to a
+   * column of ReferenceTree()->Dataset(); pending inserted points follow with
+   * the j'th inserted point at index ReferenceTree()->Dataset().n_cols + j.
+   * The point is not removed from the tree; its kernel contribution is
+   * instead subtracted from subsequent estimations, and the point is
+   * physically dropped at the next tree rebuild.
+   *
+   * @pre The model has to be previously trained.
+   * @param index Index of the point to delete.
+   */
+  void Delete(const size_t index);
+
+  /**
+   * Merge the pending inserted points into the reference set, drop the lazily
+   * deleted points, and rebuild the tree on the result.  This is called
+   * automatically once the pending changes exceed RebuildThreshold() times
+   * the reference set size.
+   */
+  void RebuildIndex();
+
+  //! Access the points inserted since the last rebuild.
+  const MatType& DeltaSet() const { return deltaSet; }
+
+  //! Get the number of points lazily deleted since the last rebuild.
+  size_t NumPendingDeletes() const { return deletedPoints.size(); }
+
+  //! Access the fraction of the reference set size that pending changes may
+  //! reach before the tree is rebuilt.
+  double RebuildThreshold() const { return rebuildThreshold; }
+  //! Modify the rebuild threshold.
+  double& RebuildThreshold() { return rebuildThreshold; }
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
 
@@ -258,6 +368,9 @@ class KDE
   //! Check whether KDE model is trained or not.
   bool IsTrained() const { return trained; }
 
+  //! Get the work counters of the last call to Evaluate().
+  const EvaluationStats& LastEvaluationStats() const { return lastStats; }
+
   //! Get the mode of KDE.
   KDEMode Mode() const { return mode; }
 
@@ -346,12 +459,57 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! Reference points inserted since the last tree rebuild, one per column.
+  MatType deltaSet;
+
+  //! Indices of reference points lazily deleted since the last tree rebuild.
+  std::unordered_set<size_t> deletedPoints;
+
+  //! Fraction of the reference set size that pending changes may reach before
+  //! the tree is rebuilt.
+  double rebuildThreshold = 0.1;
+
+  //! The work counters of the last call to Evaluate().
+  EvaluationStats lastStats;
+
+  //! Rebuild the tree if the pending changes exceed the rebuild threshold.
+  void MaybeRebuildIndex();
+
+  //! Get the number of reference points that have not been lazily deleted,
+  //! including pending inserted points.
+  size_t LiveReferenceSize() const;
+
+  //! Add the kernel contributions of pending inserted points to the (still
+  //! unnormalized) estimations and subtract the contributions of lazily
+  //! deleted tree points.  If sameSet is true, the query set is the tree
+  //! dataset itself and a deleted point's own estimation is left alone.
+  void ApplyDeltaCorrections(const MatType& querySet,
+                             arma::vec& estimations,
+                             const bool sameSet = false);
+
+  //! As above, but with an explicitly given kernel; the multi-bandwidth
+  //! sweep applies the corrections once per kernel of the sweep.
+  void ApplyDeltaCorrections(const MatType& querySet,
+                             arma::vec& estimations,
+                             KernelType& correctionKernel,
+                             const bool sameSet);
+
+  //! Pre-populate the Monte Carlo alpha values of every node of the given
+  //! tree, so that traversals only read them.  This must be called before
+  //! evaluating query points in parallel.
+  static void InitializeMCAlpha(Tree* node, const double mcBeta);
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
   //! Rearrange estimations vector if required.
   static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
                                    arma::vec& estimations);
+
+  //! Rearrange the columns of a multi-bandwidth estimations matrix if
+  //! required.
+  static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
+                                   arma::mat& estimations);
 };
 
 } // namespace kde
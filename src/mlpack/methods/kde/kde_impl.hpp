@@ -13,6 +13,8 @@
 #include "kde.hpp"
 #include "kde_rules.hpp"
 
+#include <mlpack/core/metrics/pairwise_distances.hpp>
+
 namespace mlpack {
 namespace kde {
 
@@ -106,7 +108,11 @@ KDE(const KDE& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    deltaSet(other.deltaSet),
+    deletedPoints(other.deletedPoints),
+    rebuildThreshold(other.rebuildThreshold),
+    lastStats(other.lastStats)
 {
   if (trained)
   {
@@ -152,7 +158,11 @@ KDE(KDE&& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    deltaSet(std::move(other.deltaSet)),
+    deletedPoints(std::move(other.deletedPoints)),
+    rebuildThreshold(other.rebuildThreshold),
+    lastStats(other.lastStats)
 {
   other.kernel = std::move(KernelType());
   other.metric = std::move(MetricType());
@@ -168,6 +178,9 @@ KDE(KDE&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.deltaSet.reset();
+  other.deletedPoints.clear();
+  other.lastStats = EvaluationStats();
 }
 
 template<typename KernelType,
@@ -212,6 +225,10 @@ operator=(const KDE& other)
     initialSampleSize = other.initialSampleSize;
     mcEntryCoef = other.mcEntryCoef;
     mcBreakCoef = other.mcBreakCoef;
+    deltaSet = other.deltaSet;
+    deletedPoints = other.deletedPoints;
+    rebuildThreshold = other.rebuildThreshold;
+    lastStats = other.lastStats;
     if (trained)
     {
       if (ownsReferenceTree)
@@ -276,6 +293,10 @@ operator=(KDE&& other)
     this->initialSampleSize = other.initialSampleSize;
     this->mcEntryCoef = other.mcEntryCoef;
     this->mcBreakCoef = other.mcBreakCoef;
+    this->deltaSet = std::move(other.deltaSet);
+    this->deletedPoints = std::move(other.deletedPoints);
+    this->rebuildThreshold = other.rebuildThreshold;
+    this->lastStats = other.lastStats;
   }
   return *this;
 }
@@ -337,6 +358,10 @@ Train(MatType referenceSet)
   this->referenceTree = BuildTree<Tree>(std::move(referenceSet),
                                         *oldFromNewReferences);
   this->trained = true;
+
+  // Any pending incremental updates refer to the old reference set.
+  deltaSet.reset();
+  deletedPoints.clear();
 }
 
 template<typename KernelType,
@@ -372,6 +397,10 @@ Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences)
   this->referenceTree = referenceTree;
   this->oldFromNewReferences = oldFromNewReferences;
   this->trained = true;
+
+  // Any pending incremental updates refer to the old reference set.
+  deltaSet.reset();
+  deletedPoints.clear();
 }
 
 template<typename KernelType,
@@ -435,34 +464,80 @@ Evaluate(MatType querySet, arma::vec& estimations)
                                   "referenceSet dimensions don't match");
     }
 
-    // Evaluate.
+    // Pre-populate the Monte Carlo alpha values of the reference tree so
+    // that the traversals below only read them.
+    if (monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value)
+      InitializeMCAlpha(referenceTree, 1 - mcProb);
+
+    // The rules hold per-query accumulated error tolerances (and Monte Carlo
+    // alpha values), so they cannot be shared between threads; each thread
+    // evaluates a contiguous block of query points with its own rule set and
+    // writes disjoint entries of the estimations vector.
+#ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+#else
+    const size_t numThreads = 1;
+#endif
+
     typedef KDERules<MetricType, KernelType, Tree> RuleType;
-    RuleType rules = RuleType(referenceTree->Dataset(),
-                              querySet,
-                              estimations,
-                              relError,
-                              absError,
-                              mcProb,
-                              initialSampleSize,
-                              mcEntryCoef,
-                              mcBreakCoef,
-                              metric,
-                              kernel,
-                              monteCarlo,
-                              false);
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
+    size_t totalPrunes = 0;
 
-    // Create traverser.
-    SingleTreeTraversalType<RuleType> traverser(rules);
+    const std::chrono::steady_clock::time_point traversalStart =
+        std::chrono::steady_clock::now();
 
-    // Traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    #pragma omp parallel for schedule(static) \
+        reduction(+: totalBaseCases, totalScores, totalPrunes)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (querySet.n_cols * t) / numThreads;
+      const size_t blockEnd = (querySet.n_cols * (t + 1)) / numThreads;
+      if (blockBegin == blockEnd)
+        continue;
 
-    estimations /= referenceTree->Dataset().n_cols;
+      RuleType rules = RuleType(referenceTree->Dataset(),
+                                querySet,
+                                estimations,
+                                relError,
+                                absError,
+                                mcProb,
+                                initialSampleSize,
+                                mcEntryCoef,
+                                mcBreakCoef,
+                                metric,
+                                kernel,
+                                monteCarlo,
+                                false);
 
-    Log::Info << rules.Scores() << " node combinations were scored."
+      // Create traverser.
+      SingleTreeTraversalType<RuleType> traverser(rules);
+
+      // Traverse for each point of this thread's block.
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+      totalPrunes += traverser.NumPrunes();
+    }
+
+    // Record the work counters of this evaluation.
+    lastStats.baseCases = totalBaseCases;
+    lastStats.scores = totalScores;
+    lastStats.prunes = totalPrunes;
+    lastStats.traversalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - traversalStart);
+
+    // Account for pending incremental updates, then normalize over the live
+    // reference set.
+    ApplyDeltaCorrections(querySet, estimations);
+    estimations /= LiveReferenceSize();
+
+    Log::Info << totalScores << " node combinations were scored."
               << std::endl;
-    Log::Info << rules.BaseCases() << " base cases were calculated."
+    Log::Info << totalBaseCases << " base cases were calculated."
               << std::endl;
   }
 }
@@ -546,8 +621,23 @@ Evaluate(Tree* queryTree,
 
   // Create traverser.
   DualTreeTraversalType<RuleType> traverser(rules);
+
+  const std::chrono::steady_clock::time_point traversalStart =
+      std::chrono::steady_clock::now();
   traverser.Traverse(*queryTree, *referenceTree);
-  estimations /= referenceTree->Dataset().n_cols;
+
+  // Record the work counters of this evaluation.
+  lastStats.baseCases = rules.BaseCases();
+  lastStats.scores = rules.Scores();
+  lastStats.prunes = traverser.NumPrunes();
+  lastStats.traversalTime =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - traversalStart);
+
+  // Account for pending incremental updates, then normalize over the live
+  // reference set.
+  ApplyDeltaCorrections(queryTree->Dataset(), estimations);
+  estimations /= LiveReferenceSize();
 
   // Rearrange if necessary.
   RearrangeEstimations(oldFromNewQueries, estimations);
@@ -594,39 +684,728 @@ Evaluate(arma::vec& estimations)
 
   // Evaluate.
   typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            referenceTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            true);
 
   if (mode == DUAL_TREE_MODE)
   {
+    RuleType rules = RuleType(referenceTree->Dataset(),
+                              referenceTree->Dataset(),
+                              estimations,
+                              relError,
+                              absError,
+                              mcProb,
+                              initialSampleSize,
+                              mcEntryCoef,
+                              mcBreakCoef,
+                              metric,
+                              kernel,
+                              monteCarlo,
+                              true);
+
     // Create traverser.
     DualTreeTraversalType<RuleType> traverser(rules);
+
+    const std::chrono::steady_clock::time_point traversalStart =
+        std::chrono::steady_clock::now();
     traverser.Traverse(*referenceTree, *referenceTree);
+
+    // Record the work counters of this evaluation.
+    lastStats.baseCases = rules.BaseCases();
+    lastStats.scores = rules.Scores();
+    lastStats.prunes = traverser.NumPrunes();
+    lastStats.traversalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - traversalStart);
+
+    Log::Info << rules.Scores() << " node combinations were scored."
+              << std::endl;
+    Log::Info << rules.BaseCases() << " base cases were calculated."
+              << std::endl;
   }
   else if (mode == SINGLE_TREE_MODE)
   {
-    SingleTreeTraversalType<RuleType> traverser(rules);
-    for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    // Pre-populate the Monte Carlo alpha values of the reference tree so
+    // that the traversals below only read them.
+    if (monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value)
+      InitializeMCAlpha(referenceTree, 1 - mcProb);
+
+    // The rules hold per-query accumulated error tolerances (and Monte Carlo
+    // alpha values), so they cannot be shared between threads; each thread
+    // evaluates a contiguous block of query points with its own rule set and
+    // writes disjoint entries of the estimations vector.
+#ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+#else
+    const size_t numThreads = 1;
+#endif
+
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
+    size_t totalPrunes = 0;
+
+    const std::chrono::steady_clock::time_point traversalStart =
+        std::chrono::steady_clock::now();
+
+    #pragma omp parallel for schedule(static) \
+        reduction(+: totalBaseCases, totalScores, totalPrunes)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (referenceTree->Dataset().n_cols * t) /
+          numThreads;
+      const size_t blockEnd = (referenceTree->Dataset().n_cols * (t + 1)) /
+          numThreads;
+      if (blockBegin == blockEnd)
+        continue;
+
+      RuleType rules = RuleType(referenceTree->Dataset(),
+                                referenceTree->Dataset(),
+                                estimations,
+                                relError,
+                                absError,
+                                mcProb,
+                                initialSampleSize,
+                                mcEntryCoef,
+                                mcBreakCoef,
+                                metric,
+                                kernel,
+                                monteCarlo,
+                                true);
+
+      SingleTreeTraversalType<RuleType> traverser(rules);
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+      totalPrunes += traverser.NumPrunes();
+    }
+
+    // Record the work counters of this evaluation.
+    lastStats.baseCases = totalBaseCases;
+    lastStats.scores = totalScores;
+    lastStats.prunes = totalPrunes;
+    lastStats.traversalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - traversalStart);
+
+    Log::Info << totalScores << " node combinations were scored." << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated." << std::endl;
   }
 
-  estimations /= referenceTree->Dataset().n_cols;
+  // Account for pending incremental updates, then normalize over the live
+  // reference set.
+  ApplyDeltaCorrections(referenceTree->Dataset(), estimations, true);
+  estimations /= LiveReferenceSize();
+
   // Rearrange if necessary.
   RearrangeEstimations(*oldFromNewReferences, estimations);
+}
 
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(MatType querySet,
+         std::vector<KernelType> kernels,
+         arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  // Check the sweep has at least 1 kernel to evaluate.
+  if (kernels.empty())
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: the bandwidth "
+                                "sweep needs at least one kernel");
+  }
+
+  // Check querySet has at least 1 element to evaluate.
+  if (querySet.n_cols == 0)
+  {
+    Log::Warn << "KDE::Evaluate(): querySet is empty, no predictions will "
+              << "be returned" << std::endl;
+    estimations.clear();
+    estimations.set_size(kernels.size(), 0);
+    return;
+  }
+
+  // Check whether dimensions match.
+  if (querySet.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: querySet and "
+                                "referenceSet dimensions don't match");
+  }
+
+  // Get estimations matrix ready.
+  estimations.clear();
+  estimations.zeros(kernels.size(), querySet.n_cols);
+
+  typedef KDEMultiBandwidthRules<MetricType, KernelType, Tree> SweepRuleType;
+
+  if (mode == DUAL_TREE_MODE)
+  {
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+
+    SweepRuleType rules = SweepRuleType(referenceTree->Dataset(),
+                                        queryTree->Dataset(),
+                                        estimations,
+                                        relError,
+                                        absError,
+                                        metric,
+                                        kernels,
+                                        false);
+
+    // Create traverser.
+    DualTreeTraversalType<SweepRuleType> traverser(rules);
+
+    const std::chrono::steady_clock::time_point traversalStart =
+        std::chrono::steady_clock::now();
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    // Record the work counters of this evaluation.
+    lastStats.baseCases = rules.BaseCases();
+    lastStats.scores = rules.Scores();
+    lastStats.prunes = traverser.NumPrunes();
+    lastStats.traversalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - traversalStart);
+
+    // Account for pending incremental updates, then normalize over the live
+    // reference set.  The corrections are applied once per kernel of the
+    // sweep.
+    for (size_t k = 0; k < kernels.size(); ++k)
+    {
+      arma::vec kernelEstimations = estimations.row(k).t();
+      ApplyDeltaCorrections(queryTree->Dataset(), kernelEstimations,
+          kernels[k], false);
+      estimations.row(k) = kernelEstimations.t();
+    }
+    estimations /= LiveReferenceSize();
+
+    // Rearrange if necessary.
+    RearrangeEstimations(oldFromNewQueries, estimations);
+
+    delete queryTree;
+
+    Log::Info << rules.Scores() << " node combinations were scored."
+              << std::endl;
+    Log::Info << rules.BaseCases() << " base cases were calculated."
+              << std::endl;
+  }
+  else if (mode == SINGLE_TREE_MODE)
+  {
+    // Each thread evaluates a contiguous block of query points with its own
+    // rule set and writes disjoint columns of the estimations matrix.
+#ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+#else
+    const size_t numThreads = 1;
+#endif
+
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
+    size_t totalPrunes = 0;
+
+    const std::chrono::steady_clock::time_point traversalStart =
+        std::chrono::steady_clock::now();
+
+    #pragma omp parallel for schedule(static) \
+        reduction(+: totalBaseCases, totalScores, totalPrunes)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (querySet.n_cols * t) / numThreads;
+      const size_t blockEnd = (querySet.n_cols * (t + 1)) / numThreads;
+      if (blockBegin == blockEnd)
+        continue;
+
+      // Each thread needs mutable kernels of its own.
+      std::vector<KernelType> threadKernels = kernels;
+      SweepRuleType rules = SweepRuleType(referenceTree->Dataset(),
+                                          querySet,
+                                          estimations,
+                                          relError,
+                                          absError,
+                                          metric,
+                                          threadKernels,
+                                          false);
+
+      SingleTreeTraversalType<SweepRuleType> traverser(rules);
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+      totalPrunes += traverser.NumPrunes();
+    }
+
+    // Record the work counters of this evaluation.
+    lastStats.baseCases = totalBaseCases;
+    lastStats.scores = totalScores;
+    lastStats.prunes = totalPrunes;
+    lastStats.traversalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - traversalStart);
+
+    // Account for pending incremental updates, then normalize over the live
+    // reference set.  The corrections are applied once per kernel of the
+    // sweep.
+    for (size_t k = 0; k < kernels.size(); ++k)
+    {
+      arma::vec kernelEstimations = estimations.row(k).t();
+      ApplyDeltaCorrections(querySet, kernelEstimations, kernels[k], false);
+      estimations.row(k) = kernelEstimations.t();
+    }
+    estimations /= LiveReferenceSize();
+
+    Log::Info << totalScores << " node combinations were scored." << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated." << std::endl;
+  }
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(std::vector<KernelType> kernels, arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  // Check the sweep has at least 1 kernel to evaluate.
+  if (kernels.empty())
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: the bandwidth "
+                                "sweep needs at least one kernel");
+  }
+
+  // Get estimations matrix ready.
+  estimations.clear();
+  estimations.zeros(kernels.size(), referenceTree->Dataset().n_cols);
+
+  typedef KDEMultiBandwidthRules<MetricType, KernelType, Tree> SweepRuleType;
+
+  if (mode == DUAL_TREE_MODE)
+  {
+    SweepRuleType rules = SweepRuleType(referenceTree->Dataset(),
+                                        referenceTree->Dataset(),
+                                        estimations,
+                                        relError,
+                                        absError,
+                                        metric,
+                                        kernels,
+                                        true);
+
+    // Create traverser.
+    DualTreeTraversalType<SweepRuleType> traverser(rules);
+
+    const std::chrono::steady_clock::time_point traversalStart =
+        std::chrono::steady_clock::now();
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    // Record the work counters of this evaluation.
+    lastStats.baseCases = rules.BaseCases();
+    lastStats.scores = rules.Scores();
+    lastStats.prunes = traverser.NumPrunes();
+    lastStats.traversalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - traversalStart);
+
+    Log::Info << rules.Scores() << " node combinations were scored."
+              << std::endl;
+    Log::Info << rules.BaseCases() << " base cases were calculated."
+              << std::endl;
+  }
+  else if (mode == SINGLE_TREE_MODE)
+  {
+    // Each thread evaluates a contiguous block of query points with its own
+    // rule set and writes disjoint columns of the estimations matrix.
+#ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+#else
+    const size_t numThreads = 1;
+#endif
+
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
+    size_t totalPrunes = 0;
+
+    const std::chrono::steady_clock::time_point traversalStart =
+        std::chrono::steady_clock::now();
+
+    #pragma omp parallel for schedule(static) \
+        reduction(+: totalBaseCases, totalScores, totalPrunes)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (referenceTree->Dataset().n_cols * t) /
+          numThreads;
+      const size_t blockEnd = (referenceTree->Dataset().n_cols * (t + 1)) /
+          numThreads;
+      if (blockBegin == blockEnd)
+        continue;
+
+      // Each thread needs mutable kernels of its own.
+      std::vector<KernelType> threadKernels = kernels;
+      SweepRuleType rules = SweepRuleType(referenceTree->Dataset(),
+                                          referenceTree->Dataset(),
+                                          estimations,
+                                          relError,
+                                          absError,
+                                          metric,
+                                          threadKernels,
+                                          true);
+
+      SingleTreeTraversalType<SweepRuleType> traverser(rules);
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+      totalPrunes += traverser.NumPrunes();
+    }
+
+    // Record the work counters of this evaluation.
+    lastStats.baseCases = totalBaseCases;
+    lastStats.scores = totalScores;
+    lastStats.prunes = totalPrunes;
+    lastStats.traversalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - traversalStart);
+
+    Log::Info << totalScores << " node combinations were scored." << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated." << std::endl;
+  }
+
+  // Account for pending incremental updates, then normalize over the live
+  // reference set.  The corrections are applied once per kernel of the
+  // sweep.
+  for (size_t k = 0; k < kernels.size(); ++k)
+  {
+    arma::vec kernelEstimations = estimations.row(k).t();
+    ApplyDeltaCorrections(referenceTree->Dataset(), kernelEstimations,
+        kernels[k], true);
+    estimations.row(k) = kernelEstimations.t();
+  }
+  estimations /= LiveReferenceSize();
+
+  // Rearrange if necessary.
+  RearrangeEstimations(*oldFromNewReferences, estimations);
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Insert(const MatType& points)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot insert points into KDE model: model "
+                             "needs to be trained before inserting points");
+  }
+
+  if (points.n_cols == 0)
+    return;
+
+  // Check whether dimensions match.
+  if (points.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot insert points into KDE model: "
+                                "inserted points and referenceSet dimensions "
+                                "don't match");
+  }
+
+  if (deltaSet.n_cols == 0)
+    deltaSet = points;
+  else
+    deltaSet = arma::join_rows(deltaSet, points);
+
+  MaybeRebuildIndex();
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Delete(const size_t index)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot delete points from KDE model: model "
+                             "needs to be trained before deleting points");
+  }
+
+  if (index >= referenceTree->Dataset().n_cols + deltaSet.n_cols)
+  {
+    throw std::invalid_argument("cannot delete point from KDE model: index "
+                                "is out of bounds of the reference set");
+  }
+
+  deletedPoints.insert(index);
+  MaybeRebuildIndex();
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+MaybeRebuildIndex()
+{
+  if ((double) (deltaSet.n_cols + deletedPoints.size()) >
+      rebuildThreshold * referenceTree->Dataset().n_cols)
+    RebuildIndex();
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+RebuildIndex()
+{
+  if (deltaSet.n_cols == 0 && deletedPoints.empty())
+    return; // Nothing pending.
+
+  const size_t oldSize = referenceTree->Dataset().n_cols;
+  MatType newSet(referenceTree->Dataset().n_rows,
+      oldSize + deltaSet.n_cols - deletedPoints.size());
+
+  // Keep the tree points that have not been lazily deleted.
+  size_t c = 0;
+  for (size_t i = 0; i < oldSize; ++i)
+    if (deletedPoints.count(i) == 0)
+      newSet.col(c++) = referenceTree->Dataset().col(i);
+
+  // Then append the pending inserted points that are still alive.
+  for (size_t j = 0; j < deltaSet.n_cols; ++j)
+    if (deletedPoints.count(oldSize + j) == 0)
+      newSet.col(c++) = deltaSet.col(j);
+
+  // Train() clears the pending updates once the new tree is built.
+  Train(std::move(newSet));
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+size_t KDE<KernelType,
+           MetricType,
+           MatType,
+           TreeType,
+           DualTreeTraversalType,
+           SingleTreeTraversalType>::
+LiveReferenceSize() const
+{
+  return referenceTree->Dataset().n_cols + deltaSet.n_cols -
+      deletedPoints.size();
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+ApplyDeltaCorrections(const MatType& querySet,
+                      arma::vec& estimations,
+                      const bool sameSet)
+{
+  ApplyDeltaCorrections(querySet, estimations, kernel, sameSet);
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+ApplyDeltaCorrections(const MatType& querySet,
+                      arma::vec& estimations,
+                      KernelType& correctionKernel,
+                      const bool sameSet)
+{
+  if (deltaSet.n_cols == 0 && deletedPoints.empty())
+    return; // Nothing pending.
+
+  const size_t treeSize = referenceTree->Dataset().n_cols;
+
+  // Gather the pending inserted points that have not themselves been deleted,
+  // and the lazily deleted tree points.
+  std::vector<size_t> liveDelta;
+  for (size_t j = 0; j < deltaSet.n_cols; ++j)
+    if (deletedPoints.count(treeSize + j) == 0)
+      liveDelta.push_back(j);
+
+  std::vector<size_t> deletedTreePoints;
+  for (const size_t index : deletedPoints)
+    if (index < treeSize)
+      deletedTreePoints.push_back(index);
+
+  // The corrections are exact kernel evaluations, so they do not widen the
+  // approximation error of the tree-based estimations.  The kernels here are
+  // functions of the metric distance, so each correction set is handled as
+  // one bulk distance panel (a single matrix multiplication for Euclidean
+  // metrics) followed by an elementwise kernel application.
+  if (!liveDelta.empty())
+  {
+    MatType deltaPanel(querySet.n_rows, liveDelta.size());
+    for (size_t j = 0; j < liveDelta.size(); ++j)
+      deltaPanel.col(j) = deltaSet.col(liveDelta[j]);
+
+    arma::mat kernelPanel;
+    metric::PairwiseDistances(deltaPanel, querySet, kernelPanel, metric);
+    kernelPanel.transform(
+        [&](double dist) { return correctionKernel.Evaluate(dist); });
+
+    estimations += arma::sum(kernelPanel, 0).t();
+  }
+
+  if (!deletedTreePoints.empty())
+  {
+    MatType deletedPanel(querySet.n_rows, deletedTreePoints.size());
+    for (size_t j = 0; j < deletedTreePoints.size(); ++j)
+      deletedPanel.col(j) = referenceTree->Dataset().col(deletedTreePoints[j]);
+
+    arma::mat kernelPanel;
+    metric::PairwiseDistances(deletedPanel, querySet, kernelPanel, metric);
+    kernelPanel.transform(
+        [&](double dist) { return correctionKernel.Evaluate(dist); });
+
+    estimations -= arma::sum(kernelPanel, 0).t();
+
+    // In the monochromatic case a deleted point never contributed to its own
+    // estimation, so cancel the panel's self-term exactly.
+    if (sameSet)
+    {
+      for (size_t j = 0; j < deletedTreePoints.size(); ++j)
+        estimations(deletedTreePoints[j]) +=
+            kernelPanel(j, deletedTreePoints[j]);
+    }
+  }
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+InitializeMCAlpha(Tree* node, const double mcBeta)
+{
+  KDEStat& stat = node->Stat();
+
+  // Mirror KDERules::CalculateAlpha(): the root gets the whole beta and each
+  // node distributes its alpha evenly between its children.
+  if (std::abs(stat.MCBeta() - mcBeta) > DBL_EPSILON)
+  {
+    if (node->Parent() == NULL)
+      stat.MCAlpha() = mcBeta;
+    else
+      stat.MCAlpha() = node->Parent()->Stat().MCAlpha() /
+          node->Parent()->NumChildren();
+
+    stat.MCBeta() = mcBeta;
+  }
+
+  for (size_t i = 0; i < node->NumChildren(); ++i)
+    InitializeMCAlpha(&node->Child(i), mcBeta);
 }
 
 template<typename KernelType,
@@ -787,6 +1566,15 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(metric));
   ar(CEREAL_POINTER(referenceTree));
   ar(CEREAL_POINTER(oldFromNewReferences));
+
+  // Serialize the pending incremental updates.
+  ar(CEREAL_NVP(deltaSet));
+  ar(CEREAL_NVP(rebuildThreshold));
+  std::vector<size_t> deletedList(deletedPoints.begin(), deletedPoints.end());
+  ar(CEREAL_NVP(deletedList));
+  if (cereal::is_loading<Archive>())
+    deletedPoints = std::unordered_set<size_t>(deletedList.begin(),
+        deletedList.end());
 }
 
 template<typename KernelType,
@@ -327,6 +327,12 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     kde->Evaluate(timers, estimations);
   }
 
+  const EvaluationStats& stats = kde->LastEvaluationStats();
+  Log::Info << "Evaluation statistics: " << stats.baseCases << " base cases, "
+      << stats.scores << " node combinations scored, " << stats.prunes
+      << " prunes; the traversal took " << stats.traversalTime.count()
+      << " microseconds." << endl;
+
   // Output predictions if needed.
   if (params.Has("predictions"))
     params.Get<arma::vec>("predictions") = std::move(estimations);
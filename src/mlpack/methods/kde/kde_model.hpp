@@ -115,6 +115,9 @@ class KDEWrapperBase
   //! Modify the search mode.
   virtual KDEMode& Mode() = 0;
 
+  //! Get the work counters of the last call to Evaluate().
+  virtual const EvaluationStats& LastEvaluationStats() const = 0;
+
   //! Train the model (build the tree).
   virtual void Train(util::Timers& timers, arma::mat&& referenceSet) = 0;
 
@@ -194,6 +197,12 @@ class KDEWrapper : public KDEWrapperBase
   //! Modify the search mode.
   virtual KDEMode& Mode() { return kde.Mode(); }
 
+  //! Get the work counters of the last call to Evaluate().
+  virtual const EvaluationStats& LastEvaluationStats() const
+  {
+    return kde.LastEvaluationStats();
+  }
+
   //! Train the model (build the tree).
   virtual void Train(util::Timers& timers, arma::mat&& referenceSet);
 
@@ -416,6 +425,12 @@ class KDEModel
   //! Modify the mode of the model.
   KDEMode& Mode() { return kdeModel->Mode(); }
 
+  //! Get the work counters of the last call to Evaluate().
+  const EvaluationStats& LastEvaluationStats() const
+  {
+    return kdeModel->LastEvaluationStats();
+  }
+
   /**
    * Initialize the KDE model.
    */
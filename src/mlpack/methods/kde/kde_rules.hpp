@@ -181,6 +181,127 @@ class KDERules
   size_t scores;
 };
 
+/**
+ * A traversal Rules class that estimates densities for several kernel
+ * bandwidths in a single pass.  A node combination is pruned only when the
+ * pruning bound of every kernel of the sweep is within its error tolerance,
+ * so one traversal does the work of evaluating each bandwidth separately
+ * while visiting no more nodes than the least prunable bandwidth would visit
+ * alone.  Monte Carlo estimations and accumulated error tolerances are not
+ * applied; every estimation is deterministic.
+ */
+template<typename MetricType, typename KernelType, typename TreeType>
+class KDEMultiBandwidthRules
+{
+ public:
+  /**
+   * Construct KDEMultiBandwidthRules.
+   *
+   * @param referenceSet Reference set data.
+   * @param querySet Query set data.
+   * @param densities Matrix where estimations will be written; one row per
+   *                  kernel and one column per query point.
+   * @param relError Relative error tolerance.
+   * @param absError Absolute error tolerance.
+   * @param metric Instantiated metric.
+   * @param kernels Instantiated kernels, one per bandwidth of the sweep.
+   * @param sameSet True if query and reference sets are the same
+   *                (monochromatic evaluation).
+   */
+  KDEMultiBandwidthRules(const arma::mat& referenceSet,
+                         const arma::mat& querySet,
+                         arma::mat& densities,
+                         const double relError,
+                         const double absError,
+                         MetricType& metric,
+                         std::vector<KernelType>& kernels,
+                         const bool sameSet);
+
+  //! Base Case.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  //! SingleTree Score.
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  //! SingleTree Rescore.
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  //! Dual-Tree Score.
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Dual-Tree Rescore.
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
+  //! Get traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+
+  //! Modify traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+
+  //! Get the number of scores.
+  size_t Scores() const { return scores; }
+
+  //! Get the minimum number of base cases we need to perform to have
+  //! acceptable results.
+  size_t MinimumBaseCases() const { return 0; }
+
+ private:
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! Density values; one row per kernel and one column per query point.
+  arma::mat& densities;
+
+  //! Absolute error tolerance.
+  const double absError;
+
+  //! Relative error tolerance.
+  const double relError;
+
+  //! Instantiated metric.
+  MetricType& metric;
+
+  //! Instantiated kernels, one per bandwidth of the sweep.
+  std::vector<KernelType>& kernels;
+
+  //! Whether reference and query sets are the same.
+  const bool sameSet;
+
+  //! Absolute error tolerance available for each reference point.
+  const double absErrorTol;
+
+  //! Midpoint kernel estimations of the current node combination, one per
+  //! kernel (scratch space reused across Score() calls).
+  arma::vec midKernel;
+
+  //! The last query index.
+  size_t lastQueryIndex;
+
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
+  //! Traversal information.
+  TraversalInfoType traversalInfo;
+
+  //! The number of base cases.
+  size_t baseCases;
+
+  //! The number of scores.
+  size_t scores;
+};
+
 /**
  * A dual-tree traversal Rules class for cleaning used trees before performing
  * kernel density estimation.
@@ -569,6 +569,245 @@ CalculateAlpha(TreeType* node)
   return stat.MCAlpha();
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+KDEMultiBandwidthRules(const arma::mat& referenceSet,
+                       const arma::mat& querySet,
+                       arma::mat& densities,
+                       const double relError,
+                       const double absError,
+                       MetricType& metric,
+                       std::vector<KernelType>& kernels,
+                       const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    densities(densities),
+    absError(absError),
+    relError(relError),
+    metric(metric),
+    kernels(kernels),
+    sameSet(sameSet),
+    absErrorTol(absError / referenceSet.n_cols),
+    midKernel(kernels.size()),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+//! The multi-bandwidth base case.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // If reference and query sets are the same we don't want to compute the
+  // estimation of a point with itself.
+  if (sameSet && (queryIndex == referenceIndex))
+    return 0.0;
+
+  // Avoid duplicated calculations.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0;
+
+  // The distance is computed once and evaluated under every kernel of the
+  // sweep.
+  const double distance = metric.Evaluate(querySet.col(queryIndex),
+                                          referenceSet.col(referenceIndex));
+  for (size_t k = 0; k < kernels.size(); ++k)
+    densities(k, queryIndex) += kernels[k].Evaluate(distance);
+
+  ++baseCases;
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+  traversalInfo.LastBaseCase() = distance;
+  return distance;
+}
+
+//! Multi-bandwidth single-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+Score(const size_t queryIndex, TreeType& referenceNode)
+{
+  // Auxiliary variables.
+  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      lastQueryIndex == queryIndex &&
+      traversalInfo.LastReferenceNode() != NULL &&
+      lastReferenceIndex == referenceNode.Point(0))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    const double furthestDescDist = referenceNode.FurthestDescendantDistance();
+    minDistance = std::max(traversalInfo.LastBaseCase() - furthestDescDist,
+        0.0);
+    maxDistance = traversalInfo.LastBaseCase() + furthestDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = referenceNode.RangeDistance(queryPoint);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+
+    // Check if we are a self-child.
+    if (tree::TreeTraits<TreeType>::HasSelfChildren &&
+        referenceNode.Parent() != NULL &&
+        referenceNode.Parent()->Point(0) == referenceNode.Point(0))
+    {
+      alreadyDidRefPoint0 = true;
+    }
+  }
+
+  // The node can be pruned only if every kernel of the sweep is within its
+  // error tolerance.
+  bool canPrune = true;
+  for (size_t k = 0; k < kernels.size(); ++k)
+  {
+    const double maxKernel = kernels[k].Evaluate(minDistance);
+    const double minKernel = kernels[k].Evaluate(maxDistance);
+    const double bound = maxKernel - minKernel;
+    const double errorTolerance = absErrorTol + relError * minKernel;
+    if (bound > 2 * errorTolerance)
+    {
+      canPrune = false;
+      break;
+    }
+    midKernel(k) = (maxKernel + minKernel) / 2.0;
+  }
+
+  if (canPrune)
+  {
+    const size_t effNumDesc = alreadyDidRefPoint0 ? refNumDesc - 1 : refNumDesc;
+    for (size_t k = 0; k < kernels.size(); ++k)
+      densities(k, queryIndex) += effNumDesc * midKernel(k);
+
+    // Don't explore this tree branch.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+Rescore(const size_t /* queryIndex */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If it's pruned it continues to be pruned.
+  return oldScore;
+}
+
+//! Multi-bandwidth dual-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+Score(TreeType& queryNode, TreeType& referenceNode)
+{
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      (traversalInfo.LastQueryNode() != NULL) &&
+      (traversalInfo.LastReferenceNode() != NULL) &&
+      (traversalInfo.LastQueryNode()->Point(0) == queryNode.Point(0)) &&
+      (traversalInfo.LastReferenceNode()->Point(0) == referenceNode.Point(0)))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    lastQueryIndex = queryNode.Point(0);
+    lastReferenceIndex = referenceNode.Point(0);
+
+    // Calculate min and max distance.
+    const double refFurtDescDist = referenceNode.FurthestDescendantDistance();
+    const double queryFurtDescDist = queryNode.FurthestDescendantDistance();
+    const double sumFurtDescDist = refFurtDescDist + queryFurtDescDist;
+    minDistance = std::max(traversalInfo.LastBaseCase() - sumFurtDescDist, 0.0);
+    maxDistance = traversalInfo.LastBaseCase() + sumFurtDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = queryNode.RangeDistance(referenceNode);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+  }
+
+  // The node combination can be pruned only if every kernel of the sweep is
+  // within its error tolerance.
+  bool canPrune = true;
+  for (size_t k = 0; k < kernels.size(); ++k)
+  {
+    const double maxKernel = kernels[k].Evaluate(minDistance);
+    const double minKernel = kernels[k].Evaluate(maxDistance);
+    const double bound = maxKernel - minKernel;
+    const double errorTolerance = absErrorTol + relError * minKernel;
+    if (bound > 2 * errorTolerance)
+    {
+      canPrune = false;
+      break;
+    }
+    midKernel(k) = (maxKernel + minKernel) / 2.0;
+  }
+
+  if (canPrune)
+  {
+    // Sum up estimations.
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    {
+      const size_t effNumDesc = (alreadyDidRefPoint0 && i == 0) ?
+          refNumDesc - 1 : refNumDesc;
+      for (size_t k = 0; k < kernels.size(); ++k)
+        densities(k, queryNode.Descendant(i)) += effNumDesc * midKernel(k);
+    }
+
+    // Prune.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+  }
+
+  ++scores;
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+//! Multi-bandwidth dual-tree rescore.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+Rescore(TreeType& /* queryNode */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If a branch is pruned then it continues to be pruned.
+  return oldScore;
+}
+
 //! Clean rules base case.
 template<typename TreeType>
 inline force_inline
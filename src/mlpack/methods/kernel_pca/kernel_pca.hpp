@@ -32,6 +32,16 @@ namespace kpca {
  * There are numerous available kernels in the mlpack::kernel namespace (see
  * files in mlpack/core/kernels/) and it is easy to write your own; see other
  * implementations for examples.
+ *
+ * The KernelRule policy controls how the kernel matrix is (approximately)
+ * eigendecomposed.  The default NaiveKernelRule stores and decomposes the
+ * full n x n kernel matrix, which is exact but becomes unusable past a few
+ * tens of thousands of points.  For large datasets, NystroemKernelRule
+ * (kernel_rules/nystroem_method.hpp) is the recommended choice: it works on
+ * an automatically-sized set of landmark points and never builds the full
+ * kernel matrix.  RandomizedKernelRule (kernel_rules/randomized_method.hpp)
+ * is an alternative that computes the leading eigenpairs with randomized
+ * subspace iteration over blockwise kernel products.
  */
 template <
   typename KernelType,
@@ -44,9 +44,16 @@ class NystroemKernelRule
                                 const size_t rank,
                                 KernelType kernel = KernelType())
   {
+    // Automatically select the number of landmark points: at least the
+    // requested rank, and on the order of sqrt(n) landmarks so that the
+    // approximation stays accurate on large datasets (capped by the number
+    // of points).
+    const size_t landmarks = std::min(data.n_cols, std::max(rank,
+        (size_t) std::ceil(std::sqrt((double) data.n_cols))));
+
     arma::mat G, v;
     kernel::NystroemMethod<KernelType, PointSelectionPolicy> nm(data, kernel,
-        rank);
+        landmarks);
     nm.Apply(G);
     transformedData = G.t() * G;
 
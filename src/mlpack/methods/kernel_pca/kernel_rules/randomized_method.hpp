@@ -0,0 +1,174 @@
+/**
+ * @file methods/kernel_pca/kernel_rules/randomized_method.hpp
+ * @author Ajinkya Kale
+ *
+ * Use a randomized eigensolver over blockwise kernel products to approximate
+ * the leading eigenpairs of the kernel matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_KERNEL_PCA_RANDOMIZED_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_RANDOMIZED_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/pairwise_kernels.hpp>
+
+namespace mlpack {
+namespace kpca {
+
+/**
+ * Approximate the leading eigenpairs of the centered kernel matrix with
+ * randomized subspace iteration (the algorithm behind RandomizedSVD).  The
+ * kernel matrix is never stored: every product with it is computed from
+ * column panels built with PairwiseKernels(), so the memory use is bounded by
+ * the panel size instead of n^2, and the eigendecomposition cost drops from
+ * O(n^3) to a handful of kernel passes plus an eigendecomposition of a small
+ * (rank + oversampling) matrix.
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @article{halko2011structure,
+ *   title = {Finding structure with randomness: Probabilistic algorithms for
+ *       constructing approximate matrix decompositions},
+ *   author = {Halko, N. and Martinsson, P.G. and Tropp, J.A.},
+ *   journal = {SIAM Review},
+ *   volume = {53},
+ *   number = {2},
+ *   year = {2011}
+ * }
+ * @endcode
+ */
+template<typename KernelType>
+class RandomizedKernelRule
+{
+ public:
+  /**
+   * Construct the approximate eigendecomposition of the kernel matrix.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors will be written to this matrix.
+   * @param rank Number of eigenpairs to compute (0 means all).
+   * @param kernel Kernel to be used for computation.
+   */
+  static void ApplyKernelMatrix(const arma::mat& data,
+                                arma::mat& transformedData,
+                                arma::vec& eigval,
+                                arma::mat& eigvec,
+                                const size_t rank,
+                                KernelType kernel = KernelType())
+  {
+    const size_t n = data.n_cols;
+    const size_t outRank = std::min(rank == 0 ? n : rank, n);
+
+    // A small oversampling and a few subspace iterations are enough for
+    // near-exact leading eigenpairs (Halko et al., 2011).
+    const size_t sampleSize = std::min(outRank + 10, n);
+    const size_t subspaceIterations = 2;
+
+    // Size of the column blocks the kernel matrix is produced in; this keeps
+    // every panel at roughly 128 MB regardless of the number of points.
+    const size_t blockSize = std::max<size_t>(1,
+        std::min<size_t>(n, 16777216 / n));
+
+    // The column means of the kernel matrix (equal to the row means, since
+    // the matrix is symmetric) are needed for the "pseudo-centering" used by
+    // the other kernel rules; compute them in one block pass.
+    arma::vec kernelMean(n);
+    for (size_t begin = 0; begin < n; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, n) - 1;
+      arma::mat panel;
+      kernel::PairwiseKernels(data, data.cols(begin, end), panel, kernel);
+      kernelMean.subvec(begin, end) = arma::sum(panel, 0).t() / n;
+    }
+    const double totalMean = arma::mean(kernelMean);
+
+    // Find an orthonormal basis of the dominant subspace of the centered
+    // kernel matrix.
+    arma::mat omega(n, sampleSize, arma::fill::randn);
+    arma::mat y, q, r;
+    CenteredKernelMultiply(data, kernelMean, totalMean, omega, y, kernel,
+        blockSize);
+    for (size_t i = 0; i < subspaceIterations; ++i)
+    {
+      arma::qr_econ(q, r, y);
+      CenteredKernelMultiply(data, kernelMean, totalMean, q, y, kernel,
+          blockSize);
+    }
+    arma::qr_econ(q, r, y);
+
+    // Project the centered kernel matrix into the basis and eigendecompose
+    // the small projected matrix.
+    arma::mat z;
+    CenteredKernelMultiply(data, kernelMean, totalMean, q, z, kernel,
+        blockSize);
+    arma::vec smallEigval;
+    arma::mat smallEigvec;
+    if (!arma::eig_sym(smallEigval, smallEigvec, arma::symmatu(q.t() * z)))
+    {
+      Log::Fatal << "Failed to construct the kernel matrix." << std::endl;
+    }
+
+    // Swap the eigenvalues since they are ordered backwards (we need largest
+    // to smallest).
+    for (size_t i = 0; i < floor(smallEigval.n_elem / 2.0); ++i)
+      smallEigval.swap_rows(i, (smallEigval.n_elem - 1) - i);
+
+    // Flip the coefficients to produce the same effect.
+    smallEigvec = arma::fliplr(smallEigvec);
+
+    // Keep the requested number of leading components and lift them back to
+    // the full space.  Note that z * smallEigvec is the product of the
+    // centered kernel matrix with the lifted eigenvectors, so no additional
+    // kernel pass is needed for the transformed data.
+    eigval = smallEigval.head(outRank);
+    eigvec = q * smallEigvec.cols(0, outRank - 1);
+    transformedData = (z * smallEigvec.cols(0, outRank - 1)).t();
+    transformedData.each_col() /= arma::sqrt(eigval);
+  }
+
+ private:
+  /**
+   * Compute result = Kc * x, where Kc is the centered kernel matrix, without
+   * ever materializing the kernel matrix: the product is accumulated from
+   * column panels and the centering terms are applied afterwards with
+   * rank-one corrections.
+   */
+  static void CenteredKernelMultiply(const arma::mat& data,
+                                     const arma::vec& kernelMean,
+                                     const double totalMean,
+                                     const arma::mat& x,
+                                     arma::mat& result,
+                                     KernelType& kernel,
+                                     const size_t blockSize)
+  {
+    const size_t n = data.n_cols;
+    const arma::rowvec colSums = arma::sum(x, 0);
+    const arma::rowvec meanProjection = kernelMean.t() * x;
+
+    result.set_size(n, x.n_cols);
+    for (size_t begin = 0; begin < n; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, n) - 1;
+      arma::mat panel;
+      kernel::PairwiseKernels(data, data.cols(begin, end), panel, kernel);
+      result.rows(begin, end) = panel.t() * x;
+    }
+
+    // Centering: Kc = K - mean 1^T - 1 mean^T + totalMean 1 1^T.
+    result -= kernelMean * colSums;
+    result.each_row() -= meanProjection - totalMean * colSums;
+  }
+};
+
+} // namespace kpca
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file methods/kmeans/drake_kmeans.hpp
+ *
+ * An implementation of Drake and Hamerly's adaptive-bound algorithm for exact
+ * Lloyd iterations ("Accelerated k-means with adaptive distance bounds",
+ * 2012).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_DRAKE_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_DRAKE_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * A single iteration of Drake and Hamerly's adaptive-bound k-means.  Like
+ * Elkan's algorithm it prunes distance computations with per-point bounds,
+ * but instead of a full n x k lower-bound matrix it keeps, for each point, an
+ * upper bound to the assigned centroid, exact-at-last-refresh lower bounds to
+ * the next (b - 1) closest centroids, and one scalar lower bound covering all
+ * remaining centroids.  The memory cost is O(n * b) rather than O(n * k), so
+ * bound-based pruning stays usable when both n and k are large.  The results
+ * are exactly those of a full Lloyd iteration.
+ *
+ * This class may be used as the LloydStepType policy of the KMeans class.
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class DrakeKMeans
+{
+ public:
+  /**
+   * Construct the DrakeKMeans object, which must store several sets of
+   * bounds.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  DrakeKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single iteration of Drake and Hamerly's algorithm, updating the
+   * given centroids into the newCentroids matrix.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Current counts, to be overwritten with new counts.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the number of bounds kept per point (0 means automatic selection).
+  size_t NumBounds() const { return numBounds; }
+  //! Modify the number of bounds kept per point (0 means automatic
+  //! selection).
+  size_t& NumBounds() { return numBounds; }
+
+ private:
+  /**
+   * Recompute the distances from point i to all centroids, resetting its
+   * assignment and all of its bounds to exact values.
+   */
+  void FullRecalculate(const size_t i, const arma::mat& centroids);
+
+  /**
+   * Recompute the distances from point i to its assigned and tracked
+   * centroids only; valid when the exact upper bound does not exceed the
+   * lower bound covering the untracked centroids.
+   */
+  void PartialRecalculate(const size_t i, const arma::mat& centroids);
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of bounds kept per point; 0 selects a default based on k.
+  size_t numBounds;
+
+  //! Upper bounds on the distance from each point to its assigned centroid.
+  arma::vec upperBounds;
+  //! Lower bounds from each point to its tracked centroids ((b - 1) x n).
+  arma::mat trackedBounds;
+  //! Indices of the tracked centroids of each point ((b - 1) x n).
+  arma::Mat<size_t> trackedCenters;
+  //! Lower bounds from each point to all of its untracked centroids.
+  arma::vec otherBounds;
+  //! Assignments for each point.
+  arma::Col<size_t> assignments;
+
+  //! Track distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "drake_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,191 @@
+/**
+ * @file methods/kmeans/drake_kmeans_impl.hpp
+ *
+ * An implementation of Drake and Hamerly's adaptive-bound algorithm for exact
+ * Lloyd iterations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_DRAKE_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_DRAKE_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "drake_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+DrakeKMeans<MetricType, MatType>::DrakeKMeans(const MatType& dataset,
+                                              MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    numBounds(0),
+    distanceCalculations(0)
+{
+  // Nothing to do here.
+}
+
+// Run a single iteration of Drake and Hamerly's algorithm.
+template<typename MetricType, typename MatType>
+double DrakeKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
+                                                 arma::mat& newCentroids,
+                                                 arma::Col<size_t>& counts)
+{
+  // Clear new centroids.
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  // Select the number of bounds kept per point: the assigned centroid plus
+  // (b - 1) tracked centroids plus one bound over the rest.  The default
+  // follows Drake's suggestion of a small fraction of k.
+  const size_t b = (numBounds > 0) ?
+      std::min(numBounds, centroids.n_cols) :
+      std::max<size_t>(1, std::min<size_t>(centroids.n_cols / 8, 8));
+
+  // If this is the first iteration (or the number of clusters or bounds has
+  // changed), we must reset all the bounds.
+  const bool reset = (assignments.n_elem != dataset.n_cols) ||
+      (trackedCenters.n_rows != b - 1);
+  if (reset)
+  {
+    upperBounds.set_size(dataset.n_cols);
+    trackedBounds.set_size(b - 1, dataset.n_cols);
+    trackedCenters.set_size(b - 1, dataset.n_cols);
+    otherBounds.set_size(dataset.n_cols);
+    assignments.set_size(dataset.n_cols);
+  }
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (reset)
+    {
+      FullRecalculate(i, centroids);
+    }
+    else
+    {
+      // The smallest lower bound on any non-assigned centroid.
+      double minLower = otherBounds(i);
+      for (size_t r = 0; r < trackedBounds.n_rows; ++r)
+        minLower = std::min(minLower, trackedBounds(r, i));
+
+      if (upperBounds(i) > minLower)
+      {
+        // Tighten the upper bound to the exact distance and test again.
+        upperBounds(i) = metric.Evaluate(dataset.col(i),
+            centroids.col(assignments[i]));
+        distanceCalculations++;
+
+        if (upperBounds(i) > minLower)
+        {
+          // The assignment may have changed.  If the exact distance does not
+          // exceed the bound covering the untracked centroids, the closest
+          // centroid must be among the tracked ones; otherwise everything
+          // must be recomputed.
+          if (upperBounds(i) <= otherBounds(i))
+            PartialRecalculate(i, centroids);
+          else
+            FullRecalculate(i, centroids);
+        }
+      }
+    }
+
+    // At this point, we know the cluster assignment of this point.
+    newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
+    counts[assignments[i]]++;
+  }
+
+  // Now, normalize and calculate the distance each cluster has moved.
+  arma::vec moveDistances(centroids.n_cols);
+  double cNorm = 0.0; // Cluster movement for residual.
+  for (size_t c = 0; c < centroids.n_cols; ++c)
+  {
+    if (counts[c] > 0)
+      newCentroids.col(c) /= counts[c];
+
+    moveDistances(c) = metric.Evaluate(newCentroids.col(c), centroids.col(c));
+    cNorm += std::pow(moveDistances(c), 2.0);
+    distanceCalculations++;
+  }
+  const double maxMove = moveDistances.max();
+
+  // Update the bounds to account for the centroid movement: the upper bound
+  // grows by the movement of the assigned centroid, each tracked lower bound
+  // shrinks by the movement of its centroid, and the bound over the untracked
+  // centroids shrinks by the largest movement of any centroid.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    upperBounds(i) += moveDistances(assignments[i]);
+    for (size_t r = 0; r < trackedBounds.n_rows; ++r)
+      trackedBounds(r, i) -= moveDistances(trackedCenters(r, i));
+    otherBounds(i) -= maxMove;
+  }
+
+  return std::sqrt(cNorm);
+}
+
+template<typename MetricType, typename MatType>
+void DrakeKMeans<MetricType, MatType>::FullRecalculate(
+    const size_t i,
+    const arma::mat& centroids)
+{
+  arma::vec dists(centroids.n_cols);
+  for (size_t c = 0; c < centroids.n_cols; ++c)
+    dists(c) = metric.Evaluate(dataset.col(i), centroids.col(c));
+  distanceCalculations += centroids.n_cols;
+
+  const arma::uvec order = arma::sort_index(dists);
+
+  assignments[i] = order(0);
+  upperBounds(i) = dists(order(0));
+  for (size_t r = 0; r < trackedCenters.n_rows; ++r)
+  {
+    trackedCenters(r, i) = order(r + 1);
+    trackedBounds(r, i) = dists(order(r + 1));
+  }
+
+  // All untracked centroids are at least as far as the closest of them.
+  otherBounds(i) = (trackedCenters.n_rows + 1 < centroids.n_cols) ?
+      dists(order(trackedCenters.n_rows + 1)) : DBL_MAX;
+}
+
+template<typename MetricType, typename MatType>
+void DrakeKMeans<MetricType, MatType>::PartialRecalculate(
+    const size_t i,
+    const arma::mat& centroids)
+{
+  // The upper bound is already exact, so only the tracked centroids need new
+  // distances.
+  arma::vec dists(trackedCenters.n_rows + 1);
+  arma::Col<size_t> ids(trackedCenters.n_rows + 1);
+  ids(0) = assignments[i];
+  dists(0) = upperBounds(i);
+  for (size_t r = 0; r < trackedCenters.n_rows; ++r)
+  {
+    ids(r + 1) = trackedCenters(r, i);
+    dists(r + 1) = metric.Evaluate(dataset.col(i),
+        centroids.col(ids(r + 1)));
+  }
+  distanceCalculations += trackedCenters.n_rows;
+
+  const arma::uvec order = arma::sort_index(dists);
+
+  assignments[i] = ids(order(0));
+  upperBounds(i) = dists(order(0));
+  for (size_t r = 0; r < trackedCenters.n_rows; ++r)
+  {
+    trackedCenters(r, i) = ids(order(r + 1));
+    trackedBounds(r, i) = dists(order(r + 1));
+  }
+
+  // The set of tracked centroids is unchanged, so the bound covering the
+  // untracked centroids remains valid.
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
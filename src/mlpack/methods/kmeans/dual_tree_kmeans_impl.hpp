@@ -195,6 +195,8 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
 
   ++iteration;
 
+  util::MemoryTracker::Report("DualTreeKMeans iteration");
+
   return std::sqrt(residual);
 }
 
@@ -18,6 +18,7 @@
 #include "sample_initialization.hpp"
 #include "max_variance_new_cluster.hpp"
 #include "naive_kmeans.hpp"
+#include "kmeans_coreset.hpp"
 
 #include <mlpack/core/tree/binary_space_tree.hpp>
 
@@ -155,6 +156,39 @@ class KMeans
                const bool initialAssignmentGuess = false,
                const bool initialCentroidGuess = false);
 
+  /**
+   * Perform k-means clustering on a weighted coreset of the data, returning
+   * the centroids of each cluster in the centroids matrix.  A lightweight
+   * coreset of coresetSize points is importance-sampled from the data (see
+   * KMeansCoreset), and all Lloyd iterations run on the coreset, so each
+   * iteration touches coresetSize points instead of all of them.  This trades
+   * a small amount of clustering quality for a large speedup when the coreset
+   * is much smaller than the data.
+   *
+   * The weighted problem is always solved with the weighted NaiveKMeans
+   * Lloyd step, regardless of the LloydStepType template parameter; the other
+   * Lloyd step implementations do not handle per-point weights.  The coreset
+   * guarantee only holds for the Euclidean metric.
+   *
+   * Optionally, the initial centroids can be specified by filling the
+   * centroids matrix with the initial centroids and specifying initialGuess =
+   * true.  To get assignments for the full dataset, pass the resulting
+   * centroids to Cluster() with initialCentroidGuess set to true, or assign
+   * each point to its nearest centroid directly.
+   *
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param centroids Matrix in which centroids are stored.
+   * @param coresetSize Number of points to sample for the coreset.
+   * @param initialGuess If true, then it is assumed that centroids contains
+   *      the initial cluster centroids.
+   */
+  void ClusterCoreset(const MatType& data,
+                      const size_t clusters,
+                      arma::mat& centroids,
+                      const size_t coresetSize,
+                      const bool initialGuess = false);
+
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Set the maximum number of iterations.
@@ -0,0 +1,121 @@
+/**
+ * @file methods/kmeans/kmeans_coreset.hpp
+ * @author Ryan Curtin
+ *
+ * This file implements lightweight coreset construction for k-means.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_CORESET_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_CORESET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This class constructs a lightweight coreset for k-means: a small weighted
+ * subset of the data whose weighted clustering cost approximates the
+ * clustering cost of the full dataset for any set of centroids.  Points are
+ * importance-sampled with probabilities given by their sensitivity bound --
+ * half uniform, half proportional to the squared distance from the dataset
+ * mean -- and each sampled point is weighted by the inverse of its expected
+ * sampling count, as described in:
+ *
+ * @code
+ * @inproceedings{bachem2018scalable,
+ *   title={Scalable k-means clustering via lightweight coresets},
+ *   author={Bachem, Olivier and Lucic, Mario and Krause, Andreas},
+ *   booktitle={Proceedings of the 24th ACM SIGKDD International Conference on
+ *        Knowledge Discovery and Data Mining (KDD '18)},
+ *   pages={1119--1127},
+ *   year={2018}
+ * }
+ * @endcode
+ *
+ * Running Lloyd iterations on the weighted coreset instead of the full data
+ * trades a small amount of clustering quality for touching orders of
+ * magnitude fewer points per iteration; see KMeans::ClusterCoreset().  The
+ * sensitivity bound is specific to the squared Euclidean cost, so the coreset
+ * guarantee only holds for the Euclidean metric.
+ */
+class KMeansCoreset
+{
+ public:
+  /**
+   * Build a weighted coreset of the given size.  Points are sampled with
+   * replacement, so the coreset may contain duplicate columns; the weights
+   * sum to the dataset size in expectation.  If coresetSize is not smaller
+   * than the dataset, the dataset itself is returned with unit weights.
+   *
+   * @param data Dataset to summarize.
+   * @param coresetSize Number of points to sample.
+   * @param coreset Matrix to put the sampled points into.
+   * @param weights Vector to put the coreset weights into.
+   */
+  template<typename MatType>
+  inline static void Build(const MatType& data,
+                           const size_t coresetSize,
+                           MatType& coreset,
+                           arma::vec& weights)
+  {
+    if (coresetSize >= data.n_cols)
+    {
+      coreset = data;
+      weights.ones(data.n_cols);
+      return;
+    }
+
+    // The sensitivity bound of the lightweight coreset framework: half of the
+    // sampling mass is uniform and half is proportional to the squared
+    // distance from the dataset mean.
+    const arma::vec mean(arma::conv_to<arma::vec>::from(arma::mean(data, 1)));
+    arma::vec distribution(data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      distribution[i] = mlpack::metric::SquaredEuclideanDistance::Evaluate(
+          data.col(i), mean);
+    }
+
+    const double totalCost = arma::accu(distribution);
+    if (totalCost > 0.0)
+    {
+      distribution = 0.5 / data.n_cols +
+          0.5 * distribution / totalCost;
+    }
+    else
+    {
+      // All points coincide with the mean; sample uniformly.
+      distribution.fill(1.0 / data.n_cols);
+    }
+
+    // Turn the distribution into a CDF for sampling.
+    const arma::vec cdf = arma::cumsum(distribution);
+
+    coreset.set_size(data.n_rows, coresetSize);
+    weights.set_size(coresetSize);
+    for (size_t i = 0; i < coresetSize; ++i)
+    {
+      const double sampleValue = math::Random();
+      const double* elem = std::lower_bound(cdf.begin(), cdf.end(),
+          sampleValue);
+      size_t position = (size_t) (elem - cdf.begin());
+      if (position >= data.n_cols)
+        position = data.n_cols - 1; // Guard against roundoff in the CDF.
+
+      coreset.col(i) = data.col(position);
+      weights[i] = 1.0 / (coresetSize * distribution[position]);
+    }
+  }
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -257,6 +257,146 @@ Cluster(const MatType& data,
       << std::endl;
 }
 
+/**
+ * Perform k-means clustering on a weighted coreset of the data, returning the
+ * centroids of each cluster in the centroids matrix.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+ClusterCoreset(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids,
+               const size_t coresetSize,
+               const bool initialGuess)
+{
+  // Make sure we have more points than clusters.
+  if (clusters > data.n_cols)
+  {
+    Log::Warn << "KMeans::ClusterCoreset(): more clusters requested than "
+        << "points given." << std::endl;
+  }
+  if (clusters > coresetSize)
+  {
+    Log::Warn << "KMeans::ClusterCoreset(): more clusters requested than "
+        << "coreset points; consider a larger coreset size." << std::endl;
+  }
+
+  // Check validity of initial guess.
+  if (initialGuess)
+  {
+    util::CheckSameSizes(centroids, clusters, "KMeans::ClusterCoreset()",
+        "clusters");
+    util::CheckSameDimensionality(data, centroids,
+        "KMeans::ClusterCoreset()");
+  }
+
+  // Build the weighted coreset; all further work happens on it.
+  MatType coreset;
+  arma::vec weights;
+  KMeansCoreset::Build(data, coresetSize, coreset, weights);
+  Log::Info << "KMeans::ClusterCoreset(): sampled coreset of "
+      << coreset.n_cols << " points from " << data.n_cols << " points."
+      << std::endl;
+
+  // Use the partitioner to calculate the initial centroids.  The partitioner
+  // sees the unweighted coreset, which only perturbs the starting point.
+  if (!initialGuess)
+  {
+    arma::Row<size_t> assignments;
+    bool gotAssignments = GetInitialAssignmentsOrCentroids(partitioner,
+        coreset, clusters, assignments, centroids);
+    if (gotAssignments)
+    {
+      // The partitioner gives assignments, so we need to calculate centroids
+      // from those assignments.
+      arma::Row<size_t> counts;
+      counts.zeros(clusters);
+      centroids.zeros(coreset.n_rows, clusters);
+      for (size_t i = 0; i < coreset.n_cols; ++i)
+      {
+        centroids.col(assignments[i]) += arma::vec(coreset.col(i));
+        counts[assignments[i]]++;
+      }
+
+      for (size_t i = 0; i < clusters; ++i)
+        if (counts[i] != 0)
+          centroids.col(i) /= counts[i];
+    }
+  }
+
+  // Counts of points in each cluster.
+  arma::Col<size_t> counts(clusters);
+
+  size_t iteration = 0;
+
+  // The weighted problem is always solved with the weighted naive Lloyd
+  // step; the other Lloyd step implementations do not handle per-point
+  // weights.
+  NaiveKMeans<MetricType, MatType> lloydStep(coreset, weights, metric);
+  arma::mat centroidsOther;
+  double cNorm;
+
+  do
+  {
+    // We have two centroid matrices.  We don't want to copy anything, so,
+    // depending on the iteration number, we use a different centroid matrix...
+    if (iteration % 2 == 0)
+      cNorm = lloydStep.Iterate(centroids, centroidsOther, counts);
+    else
+      cNorm = lloydStep.Iterate(centroidsOther, centroids, counts);
+
+    // If we are not allowing empty clusters, then check that all of our
+    // clusters have points.
+    for (size_t i = 0; i < counts.n_elem; ++i)
+    {
+      if (counts[i] == 0)
+      {
+        Log::Info << "Cluster " << i << " is empty.\n";
+        if (iteration % 2 == 0)
+          emptyClusterAction.EmptyCluster(coreset, i, centroids,
+              centroidsOther, counts, metric, iteration);
+        else
+          emptyClusterAction.EmptyCluster(coreset, i, centroidsOther,
+              centroids, counts, metric, iteration);
+      }
+    }
+
+    iteration++;
+    Log::Info << "KMeans::ClusterCoreset(): iteration " << iteration
+        << ", residual " << cNorm << ".\n";
+    if (std::isnan(cNorm) || std::isinf(cNorm))
+      cNorm = 1e-4; // Keep iterating.
+  } while (cNorm > 1e-5 && iteration != maxIterations);
+
+  // If we ended on an even iteration, then the centroids are in the
+  // centroidsOther matrix, and we need to steal its memory (steal_mem()
+  // avoids a copy if possible).
+  if ((iteration - 1) % 2 == 0)
+    centroids.steal_mem(centroidsOther);
+
+  if (iteration != maxIterations)
+  {
+    Log::Info << "KMeans::ClusterCoreset(): converged after " << iteration
+        << " iterations." << std::endl;
+  }
+  else
+  {
+    Log::Info << "KMeans::ClusterCoreset(): terminated after limit of "
+        << iteration << " iterations." << std::endl;
+  }
+  Log::Info << lloydStep.DistanceCalculations() << " distance calculations."
+      << std::endl;
+}
+
 /**
  * Perform k-means clustering on the data, returning a list of cluster
  * assignments and the centroids of each cluster.
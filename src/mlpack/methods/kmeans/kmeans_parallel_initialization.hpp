@@ -0,0 +1,211 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ *
+ * This file implements the k-means|| ("k-means parallel") initialization
+ * strategy.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+/**
+ * This class implements the k-means|| initialization, as described in the
+ * following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * Instead of the k sequential full-data passes of k-means++, k-means|| makes
+ * a small fixed number of passes, each of which samples an oversampled set of
+ * candidate centroids in parallel; the candidates are then reduced to k
+ * centroids with a weighted k-means++ seeding and a few weighted Lloyd
+ * iterations over the (small) candidate set.  The quality of the seeding is
+ * comparable to k-means++ at a fraction of the passes over the data.
+ *
+ * In accordance with mlpack's InitialPartitionPolicy template type, we only
+ * need to implement a constructor and a method to compute the initial
+ * centroids.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  /**
+   * Construct the initialization strategy.
+   *
+   * @param rounds Number of sampling passes over the data.
+   * @param oversampling Expected number of candidates sampled per round; if
+   *      0, twice the number of clusters is used.
+   */
+  KMeansParallelInitialization(const size_t rounds = 5,
+                               const double oversampling = 0.0) :
+      rounds(rounds), oversampling(oversampling) { }
+
+  /**
+   * Initialize the centroids matrix with oversampled parallel seeding
+   * followed by a weighted clustering of the candidates.
+   *
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  inline void Cluster(const MatType& data,
+                      const size_t clusters,
+                      arma::mat& centroids)
+  {
+    const size_t n = data.n_cols;
+    const double l = (oversampling > 0.0) ? oversampling :
+        2.0 * (double) clusters;
+
+    // Start from one uniformly random point.
+    std::vector<size_t> candidates;
+    candidates.push_back(mlpack::math::RandInt(0, n));
+
+    // Squared distance from each point to its closest candidate, and the
+    // index (into the candidate list) of that candidate.
+    arma::vec minDistances(n);
+    arma::Col<size_t> closest(n, arma::fill::zeros);
+
+    #pragma omp parallel for
+    for (omp_size_t p = 0; p < (omp_size_t) n; ++p)
+    {
+      minDistances[p] = mlpack::metric::SquaredEuclideanDistance::Evaluate(
+          data.col(p), data.col(candidates[0]));
+    }
+    double cost = arma::accu(minDistances);
+
+    // Each round samples every point independently with probability
+    // proportional to its current cost, so about l candidates are added per
+    // round, then the distances are updated in one parallel pass.
+    for (size_t round = 0; round < rounds && cost > 0.0; ++round)
+    {
+      const size_t oldSize = candidates.size();
+      for (size_t p = 0; p < n; ++p)
+      {
+        if (mlpack::math::Random() < l * minDistances[p] / cost)
+          candidates.push_back(p);
+      }
+      if (candidates.size() == oldSize)
+        break;
+
+      #pragma omp parallel for
+      for (omp_size_t p = 0; p < (omp_size_t) n; ++p)
+      {
+        for (size_t c = oldSize; c < candidates.size(); ++c)
+        {
+          const double distance =
+              mlpack::metric::SquaredEuclideanDistance::Evaluate(data.col(p),
+              data.col(candidates[c]));
+          if (distance < minDistances[p])
+          {
+            minDistances[p] = distance;
+            closest[p] = c;
+          }
+        }
+      }
+      cost = arma::accu(minDistances);
+    }
+
+    // If sampling was unlucky, pad the candidate set with random points so
+    // that at least `clusters` candidates exist.
+    while (candidates.size() < clusters)
+      candidates.push_back(mlpack::math::RandInt(0, n));
+
+    // Weight each candidate by the number of points it is closest to, and
+    // gather the candidates densely.
+    const size_t m = candidates.size();
+    arma::vec weights(m, arma::fill::zeros);
+    for (size_t p = 0; p < n; ++p)
+      weights[closest[p]] += 1.0;
+
+    arma::mat candidateSet(data.n_rows, m);
+    for (size_t c = 0; c < m; ++c)
+      candidateSet.col(c) = arma::vec(data.col(candidates[c]));
+
+    // Reduce the candidates to k centroids with weighted k-means++ seeding.
+    centroids.set_size(data.n_rows, clusters);
+    arma::vec candDistances(m);
+    candDistances.fill(std::numeric_limits<double>::max());
+
+    // The first centroid is sampled proportionally to the weights alone.
+    centroids.col(0) = candidateSet.col(SampleFromCDF(arma::cumsum(weights)));
+
+    for (size_t i = 1; i < clusters; ++i)
+    {
+      for (size_t c = 0; c < m; ++c)
+      {
+        const double distance =
+            mlpack::metric::SquaredEuclideanDistance::Evaluate(
+            candidateSet.col(c), centroids.col(i - 1));
+        candDistances[c] = std::min(candDistances[c], distance);
+      }
+
+      centroids.col(i) = candidateSet.col(
+          SampleFromCDF(arma::cumsum(weights % candDistances)));
+    }
+
+    // Polish with a few weighted Lloyd iterations over the candidate set.
+    for (size_t iter = 0; iter < 5; ++iter)
+    {
+      arma::mat newCentroids(data.n_rows, clusters, arma::fill::zeros);
+      arma::vec newWeights(clusters, arma::fill::zeros);
+
+      for (size_t c = 0; c < m; ++c)
+      {
+        double minDistance = std::numeric_limits<double>::max();
+        size_t assignment = 0;
+        for (size_t j = 0; j < clusters; ++j)
+        {
+          const double distance =
+              mlpack::metric::SquaredEuclideanDistance::Evaluate(
+              candidateSet.col(c), centroids.col(j));
+          if (distance < minDistance)
+          {
+            minDistance = distance;
+            assignment = j;
+          }
+        }
+
+        newCentroids.col(assignment) += weights[c] * candidateSet.col(c);
+        newWeights[assignment] += weights[c];
+      }
+
+      for (size_t j = 0; j < clusters; ++j)
+        if (newWeights[j] > 0.0)
+          centroids.col(j) = newCentroids.col(j) / newWeights[j];
+    }
+  }
+
+ private:
+  //! Sample an index from an (unnormalized) CDF.
+  static size_t SampleFromCDF(const arma::vec& cdf)
+  {
+    const double total = cdf[cdf.n_elem - 1];
+    if (total <= 0.0)
+      return mlpack::math::RandInt(0, cdf.n_elem);
+
+    const double sampleValue = mlpack::math::Random() * total;
+    const double* elem = std::lower_bound(cdf.begin(), cdf.end(),
+        sampleValue);
+    return std::min((size_t) (elem - cdf.begin()), (size_t) cdf.n_elem - 1);
+  }
+
+  //! Number of sampling passes over the data.
+  size_t rounds;
+  //! Expected number of candidates sampled per round (0 means 2k).
+  double oversampling;
+};
+
+#endif
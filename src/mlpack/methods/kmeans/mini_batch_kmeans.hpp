@@ -0,0 +1,98 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * An implementation of mini-batch k-means (Sculley, "Web-scale k-means
+ * clustering", WWW 2010).  Each iteration updates the centroids from a small
+ * random sample of the dataset instead of a full pass, which converges far
+ * faster on very large datasets at the cost of slightly noisier centroids.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * A single iteration of mini-batch k-means: sample a batch of points, assign
+ * each to its closest centroid, then move those centroids towards the sampled
+ * points with a per-centroid learning rate of 1 / (number of points the
+ * centroid has ever been assigned).  This class may be used as the
+ * LloydStepType policy of the KMeans class:
+ *
+ * @code
+ * KMeans<metric::EuclideanDistance, SampleInitialization,
+ *     MaxVarianceNewCluster, MiniBatchKMeans> k(200);
+ * @endcode
+ *
+ * The counts reported to KMeans are the cumulative per-centroid assignment
+ * counts, so the EmptyClusterPolicy only triggers for centroids that no
+ * sampled point has ever been assigned to (dead centers).
+ *
+ * Because iterations are stochastic, the residual does not decrease
+ * monotonically; the maximum number of iterations is the primary termination
+ * criterion.
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  MiniBatchKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single mini-batch iteration, updating the given centroids into the
+   * newCentroids matrix.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Overwritten with the cumulative assignment counts.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the number of points sampled in each iteration.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points sampled in each iteration.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of points sampled in each iteration.
+  size_t batchSize;
+  //! Cumulative per-centroid assignment counts; these set the learning rates.
+  arma::Col<size_t> totalCounts;
+
+  //! Track distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
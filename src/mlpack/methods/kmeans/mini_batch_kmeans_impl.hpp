@@ -0,0 +1,88 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * An implementation of mini-batch k-means (Sculley, "Web-scale k-means
+ * clustering", WWW 2010).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+// For AssignmentDistances().
+#include "naive_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(std::min<size_t>(1000, dataset.n_cols)),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  newCentroids = centroids;
+
+  // The cumulative counts persist across iterations; reset them if the number
+  // of clusters has changed (i.e. this is a fresh run).
+  if (totalCounts.n_elem != centroids.n_cols)
+    totalCounts.zeros(centroids.n_cols);
+
+  // Sample the mini-batch with replacement and gather it densely, so the
+  // assignment distances can be computed in one bulk call.
+  arma::mat batch(dataset.n_rows, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+    batch.col(i) = arma::vec(dataset.col(math::RandInt(dataset.n_cols)));
+
+  arma::mat batchDistances;
+  AssignmentDistances(centroids, batch, batchDistances, metric);
+  distanceCalculations += centroids.n_cols * batchSize;
+
+  // Take a gradient step for the closest centroid of each sampled point; the
+  // per-centroid learning rate decays with its cumulative assignment count.
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    arma::uword closestCluster;
+    batchDistances.col(i).min(closestCluster);
+
+    totalCounts(closestCluster)++;
+    const double eta = 1.0 / (double) totalCounts(closestCluster);
+    newCentroids.col(closestCluster) =
+        (1.0 - eta) * newCentroids.col(closestCluster) + eta * batch.col(i);
+  }
+
+  // Report the cumulative counts, so that only centroids that have never
+  // received a sampled point are treated as empty clusters.
+  counts = totalCounts;
+
+  // Calculate cluster distortion for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,8 @@
 #ifndef MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -40,6 +42,20 @@ class NaiveKMeans
    */
   NaiveKMeans(const MatType& dataset, MetricType& metric);
 
+  /**
+   * Construct the NaiveKMeans object with the given weighted dataset and
+   * metric.  Each point contributes to its closest centroid in proportion to
+   * its weight; this is the form of the problem produced by KMeansCoreset.
+   * The weights vector must outlive this object.
+   *
+   * @param dataset Dataset.
+   * @param weights Per-point weights, one per column of the dataset.
+   * @param metric Instantiated metric.
+   */
+  NaiveKMeans(const MatType& dataset,
+              const arma::vec& weights,
+              MetricType& metric);
+
   /**
    * Run a single iteration of the Lloyd algorithm, updating the given centroids
    * into the newCentroids matrix.  If any cluster is empty (that is, if any
@@ -59,6 +75,8 @@ class NaiveKMeans
  private:
   //! The dataset.
   const MatType& dataset;
+  //! Per-point weights, or NULL if the points are unweighted.
+  const arma::vec* weights;
   //! The instantiated metric.
   MetricType& metric;
 
@@ -19,13 +19,48 @@
 // In case it hasn't been included yet.
 #include "naive_kmeans.hpp"
 
+#include <mlpack/core/util/numa_topology.hpp>
+
 namespace mlpack {
 namespace kmeans {
 
+//! Compute the centroid-to-point distances used for cluster assignment.
+template<typename MetricType, typename MatAType, typename MatBType>
+inline void AssignmentDistances(const MatAType& centroids,
+                                const MatBType& points,
+                                arma::mat& distances,
+                                MetricType& metric)
+{
+  mlpack::metric::PairwiseDistances(centroids, points, distances, metric);
+}
+
+//! For the Euclidean metric the assignment only needs the distance ordering,
+//! which squaring preserves, so the square-root pass can be skipped.
+template<typename MatAType, typename MatBType>
+inline void AssignmentDistances(const MatAType& centroids,
+                                const MatBType& points,
+                                arma::mat& distances,
+                                metric::EuclideanDistance& /* metric */)
+{
+  metric::SquaredEuclideanDistance squared;
+  mlpack::metric::PairwiseDistances(centroids, points, distances, squared);
+}
+
+template<typename MetricType, typename MatType>
+NaiveKMeans<MetricType, MatType>::NaiveKMeans(const MatType& dataset,
+                                              MetricType& metric) :
+    dataset(dataset),
+    weights(nullptr),
+    metric(metric),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
 template<typename MetricType, typename MatType>
 NaiveKMeans<MetricType, MatType>::NaiveKMeans(const MatType& dataset,
+                                              const arma::vec& weights,
                                               MetricType& metric) :
     dataset(dataset),
+    weights(&weights),
     metric(metric),
     distanceCalculations(0)
 { /* Nothing to do. */ }
@@ -39,51 +74,142 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
 
+  // In the weighted case the centroids are normalized by the total weight
+  // assigned to them instead of the number of assigned points.
+  arma::vec weightSums(centroids.n_cols, arma::fill::zeros);
+
   // Find the closest centroid to each point and update the new centroids.
-  // Computed in parallel over the complete dataset
+  // The dataset is processed in blocks of points: all centroid-to-point
+  // distances for a block are computed in one bulk call — a single matrix
+  // multiplication for L2 metrics — before the assignment pass.  Blocks are
+  // distributed over the threads.
+  const size_t blockSize = std::max<size_t>(1,
+      (1 << 20) / std::max<size_t>(1, centroids.n_cols));
+  const size_t numBlocks = (dataset.n_cols + blockSize - 1) / blockSize;
+
+  // In deterministic mode each thread parks its partial sums in its own slot
+  // and the slots are merged in thread order after the parallel region, so
+  // the floating-point summation order (and therefore the result) is fixed
+  // for a given seed and thread count.  By default threads merge directly as
+  // they finish, which is faster but unordered.
+#ifdef HAS_OPENMP
+  const size_t numThreads = (size_t) omp_get_max_threads();
+#else
+  const size_t numThreads = 1;
+#endif
+  std::vector<arma::mat> threadCentroids;
+  std::vector<arma::Col<size_t> > threadCounts;
+  std::vector<arma::vec> threadWeightSums;
+  if (math::Deterministic())
+  {
+    threadCentroids.resize(numThreads);
+    threadCounts.resize(numThreads);
+    threadWeightSums.resize(numThreads);
+  }
+
   #pragma omp parallel
   {
+    // Bind this worker to one NUMA node before allocating its local state.
+    // With the static block schedule each worker then reads the same dataset
+    // columns from the same socket on every Lloyd iteration, and its partial
+    // sums stay in node-local memory.
+#ifdef HAS_OPENMP
+    {
+      const util::NumaTopology& topology = util::NumaTopology::Get();
+      topology.PinThreadToNode(((size_t) omp_get_thread_num() *
+          topology.NumNodes()) / numThreads);
+    }
+#endif
+
     // The current state of the K-means is private for each thread
     arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
         arma::fill::zeros);
     arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    arma::vec localWeightSums(centroids.n_cols, arma::fill::zeros);
+    arma::mat blockDistances;
 
-    #pragma omp for
-    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
+    #pragma omp for schedule(static)
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
     {
-      // Find the closest centroid to this point.
-      double minDistance = std::numeric_limits<double>::infinity();
-      size_t closestCluster = centroids.n_cols; // Invalid value.
+      const size_t begin = block * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) dataset.n_cols);
+
+      AssignmentDistances(centroids, dataset.cols(begin, end - 1),
+          blockDistances, metric);
 
-      for (size_t j = 0; j < centroids.n_cols; ++j)
+      for (size_t i = begin; i < end; ++i)
       {
-        const double distance = metric.Evaluate(dataset.col(i),
-            centroids.unsafe_col(j));
-        if (distance < minDistance)
+        // Find the closest centroid to this point.
+        arma::uword closestCluster;
+        blockDistances.col(i - begin).min(closestCluster);
+
+        // We now have the minimum distance centroid index.  Update that
+        // centroid.
+        if (weights == nullptr)
         {
-          minDistance = distance;
-          closestCluster = j;
+          localCentroids.unsafe_col(closestCluster) += dataset.col(i);
         }
+        else
+        {
+          const double weight = (*weights)(i);
+          localCentroids.unsafe_col(closestCluster) +=
+              weight * dataset.col(i);
+          localWeightSums(closestCluster) += weight;
+        }
+        localCounts(closestCluster)++;
       }
-
-      Log::Assert(closestCluster != centroids.n_cols);
-
-      // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.unsafe_col(closestCluster) += dataset.col(i);
-      localCounts(closestCluster)++;
     }
     // Combine calculated state from each thread
-    #pragma omp critical
+    if (math::Deterministic())
+    {
+#ifdef HAS_OPENMP
+      const size_t threadId = (size_t) omp_get_thread_num();
+#else
+      const size_t threadId = 0;
+#endif
+      threadCentroids[threadId] = std::move(localCentroids);
+      threadCounts[threadId] = std::move(localCounts);
+      threadWeightSums[threadId] = std::move(localWeightSums);
+    }
+    else
+    {
+      #pragma omp critical
+      {
+        newCentroids += localCentroids;
+        counts += localCounts;
+        weightSums += localWeightSums;
+      }
+    }
+  }
+
+  if (math::Deterministic())
+  {
+    // Merge the thread-local state in thread order.
+    for (size_t t = 0; t < numThreads; ++t)
     {
-      newCentroids += localCentroids;
-      counts += localCounts;
+      if (threadCentroids[t].n_elem == 0)
+        continue; // The parallel region used fewer threads than the maximum.
+
+      newCentroids += threadCentroids[t];
+      counts += threadCounts[t];
+      weightSums += threadWeightSums[t];
     }
   }
 
   // Now normalize the centroid.
   for (size_t i = 0; i < centroids.n_cols; ++i)
-    if (counts(i) != 0)
+  {
+    if (weights != nullptr)
+    {
+      if (weightSums(i) > 0.0)
+        newCentroids.col(i) /= weightSums(i);
+    }
+    else if (counts(i) != 0)
+    {
       newCentroids.col(i) /= counts(i);
+    }
+  }
 
   distanceCalculations += centroids.n_cols * dataset.n_cols;
 
@@ -25,6 +25,8 @@
 #define MLPACK_METHODS_LARS_LARS_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/skippable_section.hpp>
+#include <mlpack/core/math/cholesky_update.hpp>
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/timers.hpp>
 
@@ -385,14 +387,13 @@ class LARS
   // interpolate to compute last solution vector
   void InterpolateBeta();
 
+  // The Cholesky up/downdates below are thin wrappers around the functions in
+  // core/math/cholesky_update.hpp that fold in the elastic net penalty.
+
   void CholeskyInsert(const arma::vec& newX, const arma::mat& X);
 
   void CholeskyInsert(double sqNormNewX, const arma::vec& newGramCol);
 
-  void GivensRotate(const arma::vec::fixed<2>& x,
-                    arma::vec::fixed<2>& rotatedX,
-                    arma::mat& G);
-
   void CholeskyDelete(const size_t colToKill);
 };
 
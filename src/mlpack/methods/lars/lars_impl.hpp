@@ -533,115 +533,22 @@ inline void LARS::InterpolateBeta()
 inline void LARS::CholeskyInsert(const arma::vec& newX,
                                  const arma::mat& X)
 {
-  if (matUtriCholFactor.n_rows == 0)
-  {
-    matUtriCholFactor = arma::mat(1, 1);
-
-    if (elasticNet)
-      matUtriCholFactor(0, 0) = sqrt(dot(newX, newX) + lambda2);
-    else
-      matUtriCholFactor(0, 0) = norm(newX, 2);
-  }
-  else
-  {
-    arma::vec newGramCol = trans(X) * newX;
-    CholeskyInsert(dot(newX, newX), newGramCol);
-  }
+  math::CholeskyInsert(matUtriCholFactor, newX, X,
+      elasticNet ? lambda2 : 0.0);
 }
 
 inline void LARS::CholeskyInsert(double sqNormNewX,
                                  const arma::vec& newGramCol)
 {
-  int n = matUtriCholFactor.n_rows;
-
-  if (n == 0)
-  {
-    matUtriCholFactor = arma::mat(1, 1);
-
-    if (elasticNet)
-      matUtriCholFactor(0, 0) = sqrt(sqNormNewX + lambda2);
-    else
-      matUtriCholFactor(0, 0) = sqrt(sqNormNewX);
-  }
-  else
-  {
-    arma::mat matNewR = arma::mat(n + 1, n + 1);
-
-    if (elasticNet)
-      sqNormNewX += lambda2;
-
-    arma::vec matUtriCholFactork = solve(trimatl(trans(matUtriCholFactor)),
-        newGramCol);
-
-    matNewR(arma::span(0, n - 1), arma::span(0, n - 1)) = matUtriCholFactor;
-    matNewR(arma::span(0, n - 1), n) = matUtriCholFactork;
-    matNewR(n, arma::span(0, n - 1)).fill(0.0);
-    matNewR(n, n) = sqrt(sqNormNewX - dot(matUtriCholFactork,
-                                          matUtriCholFactork));
-
-    matUtriCholFactor = matNewR;
-  }
-}
-
-inline void LARS::GivensRotate(const arma::vec::fixed<2>& x,
-                               arma::vec::fixed<2>& rotatedX,
-                               arma::mat& matG)
-{
-  if (x(1) == 0)
-  {
-    matG = arma::eye(2, 2);
-    rotatedX = x;
-  }
-  else
-  {
-    double r = norm(x, 2);
-    matG = arma::mat(2, 2);
-
-    double scaledX1 = x(0) / r;
-    double scaledX2 = x(1) / r;
-
-    matG(0, 0) = scaledX1;
-    matG(1, 0) = -scaledX2;
-    matG(0, 1) = scaledX2;
-    matG(1, 1) = scaledX1;
+  if (elasticNet)
+    sqNormNewX += lambda2;
 
-    rotatedX = arma::vec(2);
-    rotatedX(0) = r;
-    rotatedX(1) = 0;
-  }
+  math::CholeskyInsert(matUtriCholFactor, sqNormNewX, newGramCol);
 }
 
 inline void LARS::CholeskyDelete(const size_t colToKill)
 {
-  size_t n = matUtriCholFactor.n_rows;
-
-  if (colToKill == (n - 1))
-  {
-    matUtriCholFactor = matUtriCholFactor(arma::span(0, n - 2),
-                                          arma::span(0, n - 2));
-  }
-  else
-  {
-    matUtriCholFactor.shed_col(colToKill); // remove column colToKill
-    n--;
-
-    for (size_t k = colToKill; k < n; ++k)
-    {
-      arma::mat matG;
-      arma::vec::fixed<2> rotatedVec;
-      GivensRotate(matUtriCholFactor(arma::span(k, k + 1), k), rotatedVec,
-          matG);
-      matUtriCholFactor(arma::span(k, k + 1), k) = rotatedVec;
-      if (k < n - 1)
-      {
-        matUtriCholFactor(arma::span(k, k + 1), arma::span(k + 1, n - 1)) =
-            matG * matUtriCholFactor(arma::span(k, k + 1),
-            arma::span(k + 1, n - 1));
-      }
-    }
-
-    matUtriCholFactor.shed_row(n);
-  }
+  math::CholeskyDelete(matUtriCholFactor, colToKill);
 }
 
 inline double LARS::ComputeError(const arma::mat& matX,
@@ -665,19 +572,22 @@ inline double LARS::ComputeError(const arma::mat& matX,
 template<typename Archive>
 void LARS::serialize(Archive& ar, const uint32_t /* version */)
 {
+  // The Gram matrix and its Cholesky factor are only needed to continue
+  // training---Predict() uses the beta path alone---so they are stored as
+  // skippable sections for inference-only loads.
   // If we're loading, we have to use the internal storage.
   if (cereal::is_loading<Archive>())
   {
     matGram = &matGramInternal;
-    ar(CEREAL_NVP(matGramInternal));
+    data::SerializeSection(ar, "matGramInternal", matGramInternal);
   }
   else
   {
-    ar(cereal::make_nvp("matGramInternal",
-        (const_cast<arma::mat&>(*matGram))));
+    data::SerializeSection(ar, "matGramInternal",
+        const_cast<arma::mat&>(*matGram));
   }
 
-  ar(CEREAL_NVP(matUtriCholFactor));
+  data::SerializeSection(ar, "matUtriCholFactor", matUtriCholFactor);
   ar(CEREAL_NVP(useCholesky));
   ar(CEREAL_NVP(lasso));
   ar(CEREAL_NVP(lambda1));
@@ -175,10 +175,57 @@ class LinearSVMFunction
   //! Gets the intercept flag.
   bool FitIntercept() const { return fitIntercept; }
 
+  //! Gets whether the shrinking heuristic is enabled.
+  bool Shrinking() const { return shrinking; }
+  //! Sets whether the shrinking heuristic is enabled.  When enabled, each
+  //! full-batch EvaluateWithGradient() pass drops points whose hinge loss has
+  //! remained zero for several consecutive passes from the active set, so
+  //! later passes skip them entirely.
+  bool& Shrinking() { return shrinking; }
+
+  //! Get the number of points currently in the active set.
+  size_t ActiveSetSize() const { return activeSet.n_elem; }
+
+  /**
+   * Restore all points to the active set and reset the zero-loss counters.
+   */
+  void ResetActiveSet();
+
   //! Return the number of functions.
   size_t NumFunctions() const;
 
  private:
+  /**
+   * Gather the given slice of the active set into contiguous chunk matrices.
+   * If no points have been dropped, this is a plain contiguous submatrix
+   * copy.
+   *
+   * @param begin Index of the first active point of the chunk.
+   * @param count Number of points in the chunk.
+   * @param chunkData Matrix to gather the data points into.
+   * @param chunkTruth Matrix to gather the ground truth columns into.
+   */
+  void ActiveChunk(const size_t begin,
+                   const size_t count,
+                   MatType& chunkData,
+                   arma::sp_mat& chunkTruth) const;
+
+  /**
+   * Drop every active point whose hinge loss has been zero for at least
+   * shrinkPatience consecutive passes.  The active set is never shrunk to
+   * zero points.
+   */
+  void ShrinkActiveSet() const;
+
+  //! Number of points processed per chunk by the full-batch Evaluate(),
+  //! Gradient() and EvaluateWithGradient() overloads; with OpenMP the chunks
+  //! are processed in parallel.
+  static constexpr size_t chunkSize = 4096;
+
+  //! Number of consecutive zero-loss passes after which a point is dropped
+  //! from the active set.
+  static constexpr size_t shrinkPatience = 3;
+
   //! The initial point, from which to start the optimization.
   arma::mat initialPoint;
 
@@ -199,6 +246,18 @@ class LinearSVMFunction
 
   //! Intercept term flag.
   bool fitIntercept;
+
+  //! Whether the shrinking heuristic is enabled.
+  bool shrinking;
+
+  //! Indices of the points currently in the active set.  Mutable, because
+  //! the shrinking heuristic updates it inside the const full-batch
+  //! EvaluateWithGradient().
+  mutable arma::uvec activeSet;
+
+  //! Number of consecutive passes for which each point's hinge loss has been
+  //! zero.
+  mutable arma::Row<size_t> zeroLossStreaks;
 };
 
 } // namespace svm
@@ -35,13 +35,17 @@ LinearSVMFunction<MatType>::LinearSVMFunction(
     numClasses(numClasses),
     lambda(lambda),
     delta(delta),
-    fitIntercept(fitIntercept)
+    fitIntercept(fitIntercept),
+    shrinking(false)
 {
   InitializeWeights(initialPoint, dataset.n_rows, numClasses, fitIntercept);
   initialPoint *= 0.005;
 
   // Calculate the label matrix.
   GetGroundTruthMatrix(labels, groundTruth);
+
+  // Initially, every point is in the active set.
+  ResetActiveSet();
 }
 
 /**
@@ -140,6 +144,63 @@ void LinearSVMFunction<MatType>::Shuffle()
 
   groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
                              groundTruth.n_cols);
+
+  // Shuffling invalidates the per-point bookkeeping of the shrinking
+  // heuristic; start over with every point active.
+  ResetActiveSet();
+}
+
+template <typename MatType>
+void LinearSVMFunction<MatType>::ResetActiveSet()
+{
+  activeSet.set_size(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    activeSet[i] = i;
+
+  zeroLossStreaks.zeros(dataset.n_cols);
+}
+
+template <typename MatType>
+void LinearSVMFunction<MatType>::ActiveChunk(const size_t begin,
+                                             const size_t count,
+                                             MatType& chunkData,
+                                             arma::sp_mat& chunkTruth) const
+{
+  if (activeSet.n_elem == dataset.n_cols)
+  {
+    // No points have been dropped, so the chunk is a contiguous block.
+    chunkData = dataset.cols(begin, begin + count - 1);
+    chunkTruth = groundTruth.cols(begin, begin + count - 1);
+  }
+  else
+  {
+    chunkData.set_size(dataset.n_rows, count);
+    chunkTruth = arma::sp_mat(numClasses, count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      chunkData.col(i) = dataset.col(activeSet[begin + i]);
+      chunkTruth.col(i) = groundTruth.col(activeSet[begin + i]);
+    }
+  }
+}
+
+template <typename MatType>
+void LinearSVMFunction<MatType>::ShrinkActiveSet() const
+{
+  // Keep every point whose hinge loss has been positive at least once in the
+  // last shrinkPatience passes.
+  arma::uvec newActiveSet(activeSet.n_elem);
+  size_t kept = 0;
+  for (size_t i = 0; i < activeSet.n_elem; ++i)
+  {
+    if (zeroLossStreaks[activeSet[i]] < shrinkPatience)
+      newActiveSet[kept++] = activeSet[i];
+  }
+
+  // Never shrink the active set to nothing; with no violated margins left
+  // the optimization is governed by the regularization term alone.
+  if (kept > 0 && kept < activeSet.n_elem)
+    activeSet = newActiveSet.head(kept);
 }
 
 template <typename MatType>
@@ -152,39 +213,52 @@ double LinearSVMFunction<MatType>::Evaluate(
   // Calculate the loss and regularization terms.
   // L_i = Σ_i Σ_m max(0, Δ + (w_m x_i + b_m) - (w_{y_i} x_i + b_{y_i}))
   // where (m != y_i)
-  double loss, regularization;
-
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
+  double loss = 0.0, regularization;
+
+  // The scores of each chunk of points are evaluated as a blocked GEMM; with
+  // OpenMP the chunks are processed in parallel.  Points that the shrinking
+  // heuristic has dropped from the active set are skipped.
+  #pragma omp parallel for reduction(+ : loss) schedule(static)
+  for (omp_size_t begin = 0; begin < (omp_size_t) activeSet.n_elem;
+      begin += chunkSize)
   {
-    // When using `fitIntercept` we need to add the `b_i` term explicitly.
-    // The first `parameters.n_rows - 1` rows of parameters holds the value
-    // of Weights `w_i`, and the last row holds `b_i`.
-    // On calculating the score, we add `b_i` term to each element of
-    // `i_th` row of `scores`.
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+    const size_t count = std::min((size_t) chunkSize,
+        (size_t) (activeSet.n_elem - begin));
+
+    MatType chunkData;
+    arma::sp_mat chunkTruth;
+    ActiveChunk(begin, count, chunkData, chunkTruth);
+
+    // Scores for each class are evaluated.  When using `fitIntercept` we
+    // need to add the `b_i` term explicitly.  The first
+    // `parameters.n_rows - 1` rows of parameters holds the value of Weights
+    // `w_i`, and the last row holds `b_i`.  On calculating the score, we add
+    // `b_i` term to each element of `i_th` row of `scores`.
+    arma::mat scores;
+    if (!fitIntercept)
+    {
+      scores = parameters.t() * chunkData;
+    }
+    else
+    {
+      scores = parameters.rows(0, dataset.n_rows - 1).t() * chunkData
+          + arma::repmat(parameters.row(dataset.n_rows).t(), 1, count);
+    }
+
+    // Evaluate the margin by the following steps:
+    //  - Subtracting the score of correct class from all the class scores.
+    //  - Adding the margin parameter `delta`.
+    //  - Removing the `delta` parameter from correct class label in each
+    //    column.
+    arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+        * (scores % chunkTruth), numClasses, 1)) + delta
+        - (delta * chunkTruth);
+
+    // The Hinge Loss Function
+    loss += arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
   }
 
-  // Evaluate the margin by the following steps:
-  //  - Subtracting the score of correct class from all the class scores.
-  //  - Adding the margin parameter `delta`.
-  //  - Removing the `delta` parameter from correct class label in each
-  //    column.
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
-
-  // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX)) / dataset.n_cols;
+  loss /= dataset.n_cols;
 
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
@@ -245,32 +319,6 @@ void LinearSVMFunction<MatType>::Gradient(
   // So, we focus of these positive elements and reduce them.
   // Also, we need to increase the score of the correct class.
 
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
-
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
-
-  // An element of `mask` matrix holds `1` corresponding to
-  // each positive element of `margin` matrix.
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
-
-  arma::mat difference = groundTruth
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
-
   // The gradient is evaluated as follows:
   //  - Add `x_i` to `w_j` if `margin_i_m`is positive.
   //  - Subtract `x_i` from `w_y_i` for each positive
@@ -278,18 +326,68 @@ void LinearSVMFunction<MatType>::Gradient(
   //  - Take the average over the size of dataset.
   //  - Add the regularization parameter.
 
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset * difference.t();
-  }
-  else
+  gradient.set_size(arma::size(parameters));
+  gradient.zeros();
+
+  // The margin of each chunk of points is evaluated as a blocked GEMM
+  // followed by a vectorized hinge mask; with OpenMP the chunks are
+  // processed in parallel and each thread accumulates the gradient of its
+  // chunks locally.  Points that the shrinking heuristic has dropped from
+  // the active set are skipped.
+  #pragma omp parallel
   {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
+    arma::mat localGradient(arma::size(parameters), arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t begin = 0; begin < (omp_size_t) activeSet.n_elem;
+        begin += chunkSize)
+    {
+      const size_t count = std::min((size_t) chunkSize,
+          (size_t) (activeSet.n_elem - begin));
+
+      MatType chunkData;
+      arma::sp_mat chunkTruth;
+      ActiveChunk(begin, count, chunkData, chunkTruth);
+
+      // Scores for each class are evaluated.
+      arma::mat scores;
+      if (!fitIntercept)
+      {
+        scores = parameters.t() * chunkData;
+      }
+      else
+      {
+        scores = parameters.rows(0, dataset.n_rows - 1).t() * chunkData
+            + arma::repmat(parameters.row(dataset.n_rows).t(), 1, count);
+      }
+
+      arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+          * (scores % chunkTruth), numClasses, 1)) + delta
+          - (delta * chunkTruth);
+
+      // An element of `mask` matrix holds `1` corresponding to
+      // each positive element of `margin` matrix.
+      const arma::mat mask = arma::conv_to<arma::mat>::from(margin > 0);
+
+      arma::mat difference = chunkTruth
+          % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+      // Check intercept condition
+      if (!fitIntercept)
+      {
+        localGradient += chunkData * difference.t();
+      }
+      else
+      {
+        localGradient.submat(0, 0, parameters.n_rows - 2,
+            parameters.n_cols - 1) += chunkData * difference.t();
+        localGradient.row(parameters.n_rows - 1) +=
+            arma::ones<arma::rowvec>(count) * difference.t();
+      }
+    }
+
+    #pragma omp critical (LinearSVMFunctionGradient)
+    gradient += localGradient;
   }
 
   gradient /= dataset.n_cols;
@@ -329,8 +427,7 @@ void LinearSVMFunction<MatType>::Gradient(
 
   // For each sample, find the total number of classes where
   // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
+  arma::mat mask = arma::conv_to<arma::mat>::from(margin > 0);
 
   arma::mat difference = groundTruth.cols(firstId, lastId)
       % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
@@ -361,46 +458,87 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
     const arma::mat& parameters,
     GradType& gradient) const
 {
-  double loss, regularization, cost;
-
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
-
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
-
-  // For each sample, find the total number of classes where
-  // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
-
-  arma::mat difference = groundTruth
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
-
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset * difference.t();
-  }
-  else
+  double loss = 0.0, regularization, cost;
+
+  gradient.set_size(arma::size(parameters));
+  gradient.zeros();
+
+  // The margin of each chunk of points is evaluated as a blocked GEMM
+  // followed by a vectorized hinge mask; with OpenMP the chunks are
+  // processed in parallel and each thread accumulates the gradient of its
+  // chunks locally.  The per-point losses additionally feed the shrinking
+  // heuristic, which drops points with persistently zero loss from the
+  // active set between passes.
+  #pragma omp parallel reduction(+ : loss)
   {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-            dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-            arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
+    arma::mat localGradient(arma::size(parameters), arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t begin = 0; begin < (omp_size_t) activeSet.n_elem;
+        begin += chunkSize)
+    {
+      const size_t count = std::min((size_t) chunkSize,
+          (size_t) (activeSet.n_elem - begin));
+
+      MatType chunkData;
+      arma::sp_mat chunkTruth;
+      ActiveChunk(begin, count, chunkData, chunkTruth);
+
+      // Scores for each class are evaluated.
+      arma::mat scores;
+      if (!fitIntercept)
+      {
+        scores = parameters.t() * chunkData;
+      }
+      else
+      {
+        scores = parameters.rows(0, dataset.n_rows - 1).t() * chunkData
+            + arma::repmat(parameters.row(dataset.n_rows).t(), 1, count);
+      }
+
+      arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+          * (scores % chunkTruth), numClasses, 1)) + delta
+          - (delta * chunkTruth);
+
+      // For each sample, find the total number of classes where
+      // ( margin > 0 ).
+      const arma::mat mask = arma::conv_to<arma::mat>::from(margin > 0);
+
+      arma::mat difference = chunkTruth
+          % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+      // Check intercept condition
+      if (!fitIntercept)
+      {
+        localGradient += chunkData * difference.t();
+      }
+      else
+      {
+        localGradient.submat(0, 0, parameters.n_rows - 2,
+            parameters.n_cols - 1) += chunkData * difference.t();
+        localGradient.row(parameters.n_rows - 1) +=
+            arma::ones<arma::rowvec>(count) * difference.t();
+      }
+
+      // The Hinge Loss Function
+      const arma::rowvec pointLoss = arma::sum(arma::clamp(margin, 0.0,
+          DBL_MAX), 0);
+      loss += arma::accu(pointLoss);
+
+      // Update the zero-loss streaks; each thread owns the entries of its
+      // own chunks, so this is race-free.
+      if (shrinking)
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          zeroLossStreaks[activeSet[begin + i]] = (pointLoss[i] > 0.0) ? 0 :
+              zeroLossStreaks[activeSet[begin + i]] + 1;
+        }
+      }
+    }
+
+    #pragma omp critical (LinearSVMFunctionGradient)
+    gradient += localGradient;
   }
 
   gradient /= dataset.n_cols;
@@ -408,13 +546,16 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   // Adding the regularization contribution to the gradient.
   gradient += lambda * parameters;
 
-  // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
   loss /= dataset.n_cols;
 
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
 
+  // This pass is complete; drop points whose loss has stayed at zero for
+  // several consecutive passes.
+  if (shrinking)
+    ShrinkActiveSet();
+
   cost = loss + regularization;
   return cost;
 }
@@ -453,8 +594,7 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
 
   // For each sample, find the total number of classes where
   // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
+  arma::mat mask = arma::conv_to<arma::mat>::from(margin > 0);
 
   arma::mat difference = groundTruth.cols(firstId, lastId)
       % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
@@ -140,6 +140,49 @@ double LinearSVM<MatType>::Train(
   return out;
 }
 
+template <typename MatType>
+template <typename OptimizerType, typename... CallbackTypes>
+double LinearSVM<MatType>::TrainIncremental(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    OptimizerType optimizer,
+    CallbackTypes&&... callbacks)
+{
+  const size_t expectedRows = data.n_rows + (fitIntercept ? 1 : 0);
+  if (parameters.is_empty() || parameters.n_rows != expectedRows ||
+      parameters.n_cols != numClasses)
+  {
+    throw std::invalid_argument("LinearSVM::TrainIncremental(): the model "
+        "must already be trained on data of the same dimensionality and "
+        "number of classes; use Train() to fit a model from scratch!");
+  }
+
+  // The current weights stay in place, so the optimizer starts from them and
+  // only passes over the given data.
+  return Train(data, labels, numClasses, optimizer, callbacks...);
+}
+
+template <typename MatType>
+template <typename OptimizerType>
+double LinearSVM<MatType>::TrainIncremental(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    OptimizerType optimizer)
+{
+  const size_t expectedRows = data.n_rows + (fitIntercept ? 1 : 0);
+  if (parameters.is_empty() || parameters.n_rows != expectedRows ||
+      parameters.n_cols != numClasses)
+  {
+    throw std::invalid_argument("LinearSVM::TrainIncremental(): the model "
+        "must already be trained on data of the same dimensionality and "
+        "number of classes; use Train() to fit a model from scratch!");
+  }
+
+  // The current weights stay in place, so the optimizer starts from them and
+  // only passes over the given data.
+  return Train(data, labels, numClasses, optimizer);
+}
+
 template <typename MatType>
 void LinearSVM<MatType>::Classify(
     const MatType& data,
@@ -257,7 +257,10 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
     constraint.Impostors(impostors, distance, transformedDataset, labels, norm);
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // Each point only touches its own slice of the caches, so the loop can be
+  // split between threads with only the cost needing a reduction.
+  #pragma omp parallel for reduction(+ : cost) schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     for (size_t j = 0; j < k ; ++j)
     {
@@ -520,73 +523,85 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
   // Calculate gradient due to impostors.
   arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel
   {
-    for (int j = k - 1; j >= 0; j--)
+    // Each thread accumulates the impostor term into its own matrix; the
+    // caches are only touched at each point's own slice.
+    arma::mat localCil(dataset.n_rows, dataset.n_rows, arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      // Bound constraints to avoid uneccesary computation.
-      for (size_t l = 0, bp = k; l < bp ; l++)
+      for (int j = k - 1; j >= 0; j--)
       {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        double eval = 0;
-
-        // Bounds for eval.
-        if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
+        // Bound constraints to avoid uneccesary computation.
+        for (size_t l = 0, bp = k; l < bp ; l++)
         {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
+          // Calculate cost due to {data point, target neighbors, impostors}
+          // triplets.
+          double eval = 0;
 
-          eval = evalOld(l, j, i) + transformationDiff *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
-              2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % range == 0)
+          // Bounds for eval.
+          if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
           {
-            eval = metric.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distance(l, i);
+            // Update cache max impostor norm.
+            maxImpNorm(l, i) = std::max(maxImpNorm(l, i),
+                norm(impostors(l, i)));
+
+            eval = evalOld(l, j, i) + transformationDiff *
+                (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
+                2 * norm(i));
           }
-          else
+
+          // Calculate exact eval value.
+          if (eval > -1)
           {
-            eval = metric.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   metric.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
+            if (iteration - 1 % range == 0)
+            {
+              eval = metric.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                   distance(l, i);
+            }
+            else
+            {
+              eval = metric.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                     metric.Evaluate(transformedDataset.col(i),
+                         transformedDataset.col(impostors(l, i)));
+            }
           }
-        }
 
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
+          // Update cache eval value.
+          evalOld(l, j, i) = eval;
 
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
+          // Check bounding condition.
+          if (eval <= -1)
+          {
+            // update bound.
+            bp = l;
+            break;
+          }
 
-        // Reset cache.
-        if (eval > -1)
-        {
-          // update bound.
-          evalOld(l, j, i) = 0;
-          maxImpNorm(l, i) = 0;
-        }
+          // Reset cache.
+          if (eval > -1)
+          {
+            // update bound.
+            evalOld(l, j, i) = 0;
+            maxImpNorm(l, i) = 0;
+          }
 
-        // Caculate gradient due to impostors.
-        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * arma::trans(diff);
+          // Caculate gradient due to impostors.
+          arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
+          localCil += diff * arma::trans(diff);
 
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * arma::trans(diff);
+          diff = dataset.col(i) - dataset.col(impostors(l, i));
+          localCil -= diff * arma::trans(diff);
+        }
       }
     }
+
+    #pragma omp critical (LMNNFunctionGradient)
+    cil += localCil;
   }
 
   gradient = 2 * transformation * ((1 - regularization) * cij +
@@ -795,75 +810,88 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   // Calculate gradient due to impostors.
   arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel reduction(+ : cost)
   {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate cost due to distance between target neighbors & data point.
-      double eval = metric.Evaluate(transformedDataset.col(i),
-                        transformedDataset.col(targetNeighbors(j, i)));
-      cost += (1 - regularization) * eval;
-    }
+    // Each thread accumulates the impostor term into its own matrix; the
+    // caches are only touched at each point's own slice.
+    arma::mat localCil(dataset.n_rows, dataset.n_rows, arma::fill::zeros);
 
-    for (int j = k - 1; j >= 0; j--)
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      // Bound constraints to avoid uneccesary computation.
-      for (size_t l = 0, bp = k; l < bp ; l++)
+      for (size_t j = 0; j < k ; ++j)
       {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        double eval = 0;
+        // Calculate cost due to distance between target neighbors & data
+        // point.
+        double eval = metric.Evaluate(transformedDataset.col(i),
+                          transformedDataset.col(targetNeighbors(j, i)));
+        cost += (1 - regularization) * eval;
+      }
 
-        // Bounds for eval.
-        if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
+      for (int j = k - 1; j >= 0; j--)
+      {
+        // Bound constraints to avoid uneccesary computation.
+        for (size_t l = 0, bp = k; l < bp ; l++)
         {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
+          // Calculate cost due to {data point, target neighbors, impostors}
+          // triplets.
+          double eval = 0;
 
-          eval = evalOld(l, j, i) + transformationDiff *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
-              2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % range == 0)
+          // Bounds for eval.
+          if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
           {
-            eval = metric.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distance(l, i);
+            // Update cache max impostor norm.
+            maxImpNorm(l, i) = std::max(maxImpNorm(l, i),
+                norm(impostors(l, i)));
+
+            eval = evalOld(l, j, i) + transformationDiff *
+                (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
+                2 * norm(i));
           }
-          else
+
+          // Calculate exact eval value.
+          if (eval > -1)
           {
-            eval = metric.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   metric.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
+            if (iteration - 1 % range == 0)
+            {
+              eval = metric.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                   distance(l, i);
+            }
+            else
+            {
+              eval = metric.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                     metric.Evaluate(transformedDataset.col(i),
+                         transformedDataset.col(impostors(l, i)));
+            }
           }
-        }
 
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
+          // Update cache eval value.
+          evalOld(l, j, i) = eval;
 
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
+          // Check bounding condition.
+          if (eval <= -1)
+          {
+            // update bound.
+            bp = l;
+            break;
+          }
 
-        cost += regularization * (1 + eval);
+          cost += regularization * (1 + eval);
 
-        // Caculate gradient due to impostors.
-        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * arma::trans(diff);
+          // Caculate gradient due to impostors.
+          arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
+          localCil += diff * arma::trans(diff);
 
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * arma::trans(diff);
+          diff = dataset.col(i) - dataset.col(impostors(l, i));
+          localCil -= diff * arma::trans(diff);
+        }
       }
     }
+
+    #pragma omp critical (LMNNFunctionGradient)
+    cil += localCil;
   }
 
   gradient = 2 * transformation * ((1 - regularization) * cij +
@@ -1020,14 +1048,23 @@ inline void LMNNFunction<MetricType>::Precalculate()
 {
   pCij.zeros(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel
   {
-    for (size_t j = 0; j < k ; ++j)
+    arma::mat localPCij(dataset.n_rows, dataset.n_rows, arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      // Calculate gradient due to target neighbors.
-      arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-      pCij += diff * arma::trans(diff);
+      for (size_t j = 0; j < k ; ++j)
+      {
+        // Calculate gradient due to target neighbors.
+        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
+        localPCij += diff * arma::trans(diff);
+      }
     }
+
+    #pragma omp critical (LMNNFunctionPrecalculate)
+    pCij += localPCij;
   }
 }
 
@@ -123,32 +123,44 @@ inline void LocalCoordinateCoding::Encode(const arma::mat& data,
       data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
       * data);
 
+  // The dictionary Gram matrix is computed once and shared (read-only) by
+  // every solve; only its per-point reweighting happens inside the loop.
   arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+
+  // The per-point LARS problems are independent, so solve them in parallel.
+  // Each thread reuses one LARS solver and one reweighted Gram matrix across
+  // all of the points it is assigned: the solver holds a pointer to the
+  // matrix, so overwriting the matrix in place points each solve at the
+  // current point's reweighted Gram without rebuilding the solver.
+  #pragma omp parallel
   {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
+    arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
+    bool useCholesky = false;
+    regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
 
-    arma::vec invW = invSqDists.unsafe_col(i);
-    arma::mat dictPrime = dictionary * diagmat(invW);
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      // Report progress.
+      if ((i % 100) == 0)
+      {
+        Log::Debug << "Optimization at point " << i << "." << std::endl;
+      }
 
-    arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+      arma::vec invW = invSqDists.unsafe_col(i);
+      arma::mat dictPrime = dictionary * diagmat(invW);
 
-    bool useCholesky = false;
-    regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
+      dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    arma::vec beta = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, beta, false);
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      arma::vec beta = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictPrime, responses, beta, false);
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
+    }
   }
 }
 
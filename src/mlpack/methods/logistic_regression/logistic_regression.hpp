@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_LOGISTIC_REGRESSION_LOGISTIC_REGRESSION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/streaming_dataset.hpp>
 #include <ensmallen.hpp>
 
 #include "logistic_regression_function.hpp"
@@ -116,7 +117,10 @@ class LogisticRegression
   /**
    * Train the LogisticRegression model on the given input data.  By default,
    * the L-BFGS optimization algorithm is used, but others can be specified
-   * (such as ens::SGD).
+   * (such as ens::SGD).  When the default optimizer is in use and the dataset
+   * has at least a million points, mini-batch SGD is used instead of L-BFGS,
+   * since full-batch gradient passes dominate the training time at that
+   * scale; pass an instantiated optimizer to override this choice.
    *
    * This will use the existing model parameters as a starting point for the
    * optimization.  If this is not what you want, then you should access the
@@ -159,6 +163,93 @@ class LogisticRegression
                OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Incrementally refit the LogisticRegression model on new data, starting
+   * the optimization from the current weights (a warm start).  Since the
+   * existing weights are usually a near-solution for a refit, pass only the
+   * newly arrived points: the optimizer only sweeps over the given data, so
+   * a daily refit does not have to revisit the full history.
+   *
+   * The model must already be trained on data of the same dimensionality;
+   * otherwise a std::invalid_argument exception is thrown.  To fit a model
+   * from scratch, use Train() instead.
+   *
+   * @tparam OptimizerType Type of optimizer to use to refit the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors New input training variables.
+   * @param responses Outputs for the new training variables.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the refit model (NaN or Inf on error)
+   */
+  template<typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
+  double TrainIncremental(const MatType& predictors,
+                          const arma::Row<size_t>& responses,
+                          CallbackTypes&&... callbacks);
+
+  /**
+   * Incrementally refit the LogisticRegression model on new data with the
+   * given instantiated optimizer, starting the optimization from the current
+   * weights (a warm start).
+   *
+   * The model must already be trained on data of the same dimensionality;
+   * otherwise a std::invalid_argument exception is thrown.  To fit a model
+   * from scratch, use Train() instead.
+   *
+   * @tparam OptimizerType Type of optimizer to use to refit the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors New input training variables.
+   * @param responses Outputs for the new training variables.
+   * @param optimizer Instantiated optimizer with instantiated error function.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the refit model (NaN or Inf on error)
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double TrainIncremental(const MatType& predictors,
+                          const arma::Row<size_t>& responses,
+                          OptimizerType& optimizer,
+                          CallbackTypes&&... callbacks);
+
+  /**
+   * Train the LogisticRegression model by streaming over an out-of-core
+   * dataset.  This performs mini-batch gradient descent: for each epoch, the
+   * stream is swept batch by batch and one gradient step is taken per batch,
+   * so only two batches of the dataset are ever resident in memory.  The
+   * responses must still fit in memory (they are a single row).
+   *
+   * This will use the existing model parameters as a starting point for the
+   * optimization, like the in-memory Train() overloads.
+   *
+   * @param stream Streaming view of the training data.
+   * @param responses Outputs results from input training variables.
+   * @param epochs Number of sweeps over the dataset.
+   * @param stepSize Gradient descent step size.
+   * @return The sum of batch objectives over the final epoch.
+   */
+  template<typename eT>
+  double Train(data::StreamingDataset<eT>& stream,
+               const arma::Row<size_t>& responses,
+               const size_t epochs = 5,
+               const double stepSize = 0.01);
+
+  /**
+   * Merge another model into this one by averaging the parameter vectors.
+   * The given weight is the weight of the other model relative to a weight
+   * of 1 for this model; to combine models trained on different shards of a
+   * dataset, pass the ratio of the other shard's sample count to the number
+   * of samples this model already summarizes.  Merging left to right with
+   * weights n_i / (n_1 + ... + n_{i-1}) then yields the sample-count
+   * weighted average of all shard models.
+   *
+   * The other model must have the same dimensionality; otherwise a
+   * std::invalid_argument exception is thrown.
+   *
+   * @param other Model to merge into this one.
+   * @param weight Weight of the other model relative to this one.
+   */
+  void Merge(const LogisticRegression& other, const double weight = 1.0);
+
   //! Return the parameters (the b vector).
   const arma::rowvec& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
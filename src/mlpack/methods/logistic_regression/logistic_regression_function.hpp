@@ -159,6 +159,11 @@ class LogisticRegressionFunction
   size_t NumFeatures() const { return predictors.n_rows + 1; }
 
  private:
+  //! Number of points processed per chunk by the full-batch Evaluate(),
+  //! Gradient() and EvaluateWithGradient() overloads; with OpenMP the chunks
+  //! are processed in parallel.
+  static constexpr size_t chunkSize = 4096;
+
   //! The matrix of data points (predictors).  This is an alias until shuffling
   //! is done.
   MatType predictors;
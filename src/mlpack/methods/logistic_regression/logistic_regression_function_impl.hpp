@@ -83,19 +83,29 @@ double LogisticRegressionFunction<MatType>::Evaluate(
       parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate vectors of sigmoids.  The intercept term is parameters(0, 0) and
-  // does not need to be multiplied by any of the predictors.
-  const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
-
-  // Assemble full objective function.  Often the objective function and the
-  // regularization as given are divided by the number of features, but this
-  // doesn't actually affect the optimization result, so we'll just ignore those
-  // terms for computational efficiency.  Note that the conversion causes some
-  // copy and slowdown, but this is so negligible compared to the rest of the
-  // calculation it is not worth optimizing for.
-  const double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoid %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  // does not need to be multiplied by any of the predictors.  The points are
+  // processed in column chunks, so that with OpenMP the chunks run in
+  // parallel; the per-chunk objectives reduce to a single scalar.  Often the
+  // objective function and the regularization as given are divided by the
+  // number of features, but this doesn't actually affect the optimization
+  // result, so we'll just ignore those terms for computational efficiency.
+  double result = 0.0;
+  #pragma omp parallel for reduction(+ : result) schedule(static)
+  for (omp_size_t begin = 0; begin < (omp_size_t) predictors.n_cols;
+      begin += chunkSize)
+  {
+    const size_t last = std::min((size_t) (begin + chunkSize),
+        (size_t) predictors.n_cols) - 1;
+
+    const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+        parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(begin, last))));
+
+    const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(
+        responses.subvec(begin, last));
+    result += arma::accu(arma::log(1.0 - respD + sigmoid %
+        (2 * respD - 1.0)));
+  }
 
   // Invert the result, because it's a minimization.
   return regularization - result;
@@ -142,13 +152,38 @@ void LogisticRegressionFunction<MatType>::Gradient(
   arma::mat regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
 
-  const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
-
   gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient.zeros();
+
+  // Process the points in column chunks; with OpenMP each thread accumulates
+  // the gradient of its chunks locally and the partial gradients are summed
+  // at the end, so the threads never write to shared state inside the loop.
+  #pragma omp parallel
+  {
+    arma::mat localGradient(arma::size(parameters), arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t begin = 0; begin < (omp_size_t) predictors.n_cols;
+        begin += chunkSize)
+    {
+      const size_t last = std::min((size_t) (begin + chunkSize),
+          (size_t) predictors.n_cols) - 1;
+
+      const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
+          - parameters.tail_cols(parameters.n_elem - 1) *
+          predictors.cols(begin, last))));
+
+      localGradient[0] -= arma::accu(responses.subvec(begin, last) - sigmoids);
+      localGradient.tail_cols(parameters.n_elem - 1) +=
+          (sigmoids - responses.subvec(begin, last)) *
+          predictors.cols(begin, last).t();
+    }
+
+    #pragma omp critical (LogisticRegressionFunctionGradient)
+    gradient += localGradient;
+  }
+
+  gradient.tail_cols(parameters.n_elem - 1) += regularization;
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
@@ -220,19 +255,47 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
                 parameters.tail_cols(parameters.n_elem - 1));
 
-  // Calculate the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
-
   gradient.set_size(arma::size(parameters));
-  gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient.zeros();
+
+  // Process the points in column chunks, computing the sigmoids of each chunk
+  // only once for both the objective and the gradient.  With OpenMP the
+  // chunks run in parallel; each thread accumulates its gradient locally and
+  // the partial gradients are summed at the end.
+  double result = 0.0;
+  #pragma omp parallel reduction(+ : result)
+  {
+    GradType localGradient(arma::size(parameters), arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t begin = 0; begin < (omp_size_t) predictors.n_cols;
+        begin += chunkSize)
+    {
+      const size_t last = std::min((size_t) (begin + chunkSize),
+          (size_t) predictors.n_cols) - 1;
+
+      // Calculate the sigmoid function values.
+      const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+          parameters.tail_cols(parameters.n_elem - 1) *
+          predictors.cols(begin, last))));
+
+      localGradient[0] -= arma::accu(responses.subvec(begin, last) - sigmoids);
+      localGradient.tail_cols(parameters.n_elem - 1) +=
+          (sigmoids - responses.subvec(begin, last)) *
+          predictors.cols(begin, last).t();
+
+      // Now compute the objective function using the sigmoids.
+      const arma::rowvec respD = arma::conv_to<arma::rowvec>::from(
+          responses.subvec(begin, last));
+      result += arma::accu(arma::log(1.0 - respD + sigmoids %
+          (2 * respD - 1.0)));
+    }
+
+    #pragma omp critical (LogisticRegressionFunctionGradient)
+    gradient += localGradient;
+  }
 
-  // Now compute the objective function using the sigmoids.
-  double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoids %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  gradient.tail_cols(parameters.n_elem - 1) += regularization;
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
@@ -21,6 +21,8 @@
 
 #include "logistic_regression.hpp"
 
+#include <mlpack/core/data/stream_csv.hpp>
+
 #include <ensmallen.hpp>
 
 using namespace std;
@@ -160,6 +162,11 @@ PARAM_MATRIX_OUT("probabilities", "If test data is specified, this "
 PARAM_DOUBLE_IN("decision_boundary", "Decision boundary for prediction; if the "
     "logistic function for a point is less than the boundary, the class is "
     "taken to be 0; otherwise, the class is 1.", "d", 0.5);
+PARAM_FLAG("stream", "If set, test points are additionally read from standard "
+    "input as CSV rows (one point per row), and the predicted class of each "
+    "point is written to standard output as soon as its chunk of input has "
+    "been read, so data can be piped through a model without temporary "
+    "files.", "S");
 
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
@@ -184,7 +191,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   }
 
   RequireAtLeastOnePassed(params, { "output_model", "predictions",
-      "probabilities"}, false, "no output will be saved");
+      "probabilities", "stream" }, false, "no output will be saved");
 
   ReportIgnoredParam(params, {{ "test", false }}, "predictions");
   ReportIgnoredParam(params, {{ "test", false }}, "probabilities");
@@ -375,5 +382,32 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     }
   }
 
+  // Streaming prediction: read chunks of CSV rows from standard input and
+  // emit each chunk's predictions to standard output immediately.
+  if (params.Has("stream"))
+  {
+    data::StreamingCSVReader reader(std::cin);
+    arma::mat chunk;
+    arma::Row<size_t> chunkPredictions;
+    while (reader.ReadChunk(chunk))
+    {
+      if (chunk.n_rows != model->Parameters().n_cols - 1)
+      {
+        const size_t dimensionality = model->Parameters().n_cols - 1;
+        if (!params.Has("input_model"))
+          delete model;
+
+        Log::Fatal << "Streamed point dimensionality (" << chunk.n_rows
+            << ") must be the same as the dimensionality of the model ("
+            << dimensionality << ")!" << endl;
+      }
+
+      model->Classify(chunk, chunkPredictions, decisionBoundary);
+      for (size_t i = 0; i < chunkPredictions.n_elem; ++i)
+        std::cout << chunkPredictions[i] << "\n";
+      std::cout << std::flush;
+    }
+  }
+
   params.Get<LogisticRegression<>*>("output_model") = model;
 }
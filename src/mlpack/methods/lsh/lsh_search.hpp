@@ -424,6 +424,30 @@ class LSHSearch
    */
   bool PerturbationValid(const std::vector<bool>& A) const;
 
+  /**
+   * Generate a probing sequence of T valid perturbation sets, ordered by
+   * increasing score, with the heap-based enumeration of Lv et al.  The
+   * scores vector must be sorted in increasing order.
+   *
+   * @param scores Sorted scores of the 2 * numProj perturbations.
+   * @param T Number of perturbation sets to generate.
+   * @param sequence Vector to store the perturbation sets into.
+   */
+  void GenerateProbingSequence(const arma::vec& scores,
+                               const size_t T,
+                               std::vector<std::vector<bool>>& sequence) const;
+
+  /**
+   * Make sure the cached probing sequence template holds at least T
+   * perturbation sets.  The template is the probing sequence of the expected
+   * perturbation scores, expressed in sorted-rank space, so one template
+   * serves every query and every table.  Not thread-safe; this is called
+   * before the parallel query loop in Search().
+   *
+   * @param T Number of additional probing bins that will be requested.
+   */
+  void EnsureProbingTemplate(const size_t T);
+
   //! Reference dataset.
   MatType referenceSet;
 
@@ -465,6 +489,11 @@ class LSHSearch
   //! The number of distance evaluations.
   size_t distanceEvaluations;
 
+  //! Cached multiprobe probing sequence template; element i marks, in
+  //! sorted-score rank space, the perturbations applied by the i'th
+  //! additional probing bin.  See EnsureProbingTemplate().
+  std::vector<std::vector<bool>> probingTemplate;
+
   //! Candidate represents a possible candidate neighbor (distance, index).
   typedef std::pair<double, size_t> Candidate;
 
@@ -189,6 +189,9 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   this->secondHashSize = secondHashSize;
   this->bucketSize = bucketSize;
 
+  // The cached probing sequence template depends on numProj.
+  probingTemplate.clear();
+
   if (hashWidth == 0.0) // The user has not provided any value.
   {
     const size_t numSamples = 25;
@@ -519,6 +522,116 @@ bool LSHSearch<SortPolicy, MatType>::PerturbationValid(
   return true;
 }
 
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::GenerateProbingSequence(
+    const arma::vec& scores,
+    const size_t T,
+    std::vector<std::vector<bool>>& sequence) const
+{
+  sequence.clear();
+  sequence.reserve(T);
+
+  // Theory:
+  // A probing sequence is a sequence of T probing bins where a query's
+  // neighbors are most likely to be. Likelihood is dependent only on a bin's
+  // score, which is the sum of scores of all dimension-action pairs, so we
+  // need to calculate the T smallest sums of scores that are not conflicting.
+  //
+  // Method:
+  // Store each perturbation set (pair of (dimension, action)) in a
+  // std::vector. Create a minheap of scores, with each node pointing to its
+  // relevant perturbation set. Each perturbation set popped from the minheap
+  // is the next most likely perturbation set.
+
+  // Perturbation sets (A) mark with 1 the (score, action, dimension) positions
+  // included in a given perturbation vector. Other spaces are 0.
+  std::vector<bool> Ao(2 * numProj);
+  Ao[0] = 1; // Smallest vector includes only smallest score.
+
+  std::vector< std::vector<bool> > perturbationSets;
+  perturbationSets.push_back(Ao); // Storage of perturbation sets.
+
+  std::priority_queue<
+    std::pair<double, size_t>,        // contents: pairs of (score, index)
+    std::vector<                      // container: vector of pairs
+      std::pair<double, size_t>
+      >,
+    std::greater< std::pair<double, size_t> > // comparator of pairs
+  > minHeap; // our minheap
+
+  // Start by adding the lowest scoring set to the minheap.
+  minHeap.push(std::make_pair(PerturbationScore(Ao, scores), 0));
+
+  // Loop invariable: after pvec iterations, sequence contains the pvec valid
+  // perturbation sets with the lowest scores.
+  for (size_t pvec = 0; pvec < T; ++pvec)
+  {
+    std::vector<bool> Ai;
+    do
+    {
+      // Get the perturbation set corresponding to the minimum score.
+      Ai = perturbationSets[ minHeap.top().second ];
+      minHeap.pop(); // .top() returns, .pop() removes
+
+      // Shift operation on Ai (replace max with max+1).
+      std::vector<bool> As = Ai;
+
+      // Don't add invalid sets.
+      if (PerturbationShift(As) && PerturbationValid(As))
+      {
+        perturbationSets.push_back(As); // add shifted set to sets
+        minHeap.push(
+            std::make_pair(PerturbationScore(As, scores),
+            perturbationSets.size() - 1));
+      }
+
+      // Expand operation on Ai (add max+1 to set).
+      std::vector<bool> Ae = Ai;
+
+      // Don't add invalid sets.
+      if (PerturbationExpand(Ae) && PerturbationValid(Ae))
+      {
+        perturbationSets.push_back(Ae); // add expanded set to sets
+        minHeap.push(
+            std::make_pair(PerturbationScore(Ae, scores),
+            perturbationSets.size() - 1));
+      }
+    } while (!PerturbationValid(Ai)); // Discard invalid perturbations
+
+    sequence.push_back(Ai);
+  }
+}
+
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::EnsureProbingTemplate(const size_t T)
+{
+  if (probingTemplate.size() >= T || T == 0 || numProj == 0)
+    return;
+
+  // The template is the probing sequence generated from the expected scores
+  // of the sorted perturbations, under the assumption that the query's
+  // projection falls uniformly inside its bin (Lv et al., "Multi-Probe LSH").
+  // Only the ordering of the scores matters, so the hashWidth^2 factor is
+  // dropped.
+  arma::vec expectedScores(2 * numProj);
+  const double m = (double) numProj;
+  for (size_t j = 1; j <= 2 * numProj; ++j)
+  {
+    if (j <= numProj)
+    {
+      expectedScores[j - 1] = (j * (j + 1)) / (4.0 * (m + 1) * (m + 2));
+    }
+    else
+    {
+      const double r = 2.0 * m + 1 - j;
+      expectedScores[j - 1] = 1.0 - r / (m + 1) +
+          (r * (r + 1)) / (4.0 * (m + 1) * (m + 2));
+    }
+  }
+
+  GenerateProbingSequence(expectedScores, T, probingTemplate);
+}
+
 // Compute additional probing bins for a query
 template<typename SortPolicy, typename MatType>
 void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
@@ -616,84 +729,31 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
     return;
   }
 
-  // General case: more than 2 perturbation vectors require use of minheap.
+  // General case: more than 2 perturbation vectors.
   // Sort everything in increasing order.
   arma::uvec sortidx = arma::sort_index(scores);
   scores = scores(sortidx);
   actions = actions(sortidx);
   positions = positions(sortidx);
 
-  // Theory:
-  // A probing sequence is a sequence of T probing bins where a query's
-  // neighbors are most likely to be. Likelihood is dependent only on a bin's
-  // score, which is the sum of scores of all dimension-action pairs, so we
-  // need to calculate the T smallest sums of scores that are not conflicting.
-  //
-  // Method:
-  // Store each perturbation set (pair of (dimension, action)) in a
-  // std::vector. Create a minheap of scores, with each node pointing to its
-  // relevant perturbation set. Each perturbation set popped from the minheap
-  // is the next most likely perturbation set.
-  // Transform perturbation set to perturbation vector by setting the
+  // The cached template holds the probing sequence in sorted-rank space,
+  // precomputed once from the expected scores (see EnsureProbingTemplate());
+  // the only per-query work left is the rank-to-(dimension, action) mapping
+  // computed above.  If the template is too small — this function was reached
+  // without going through Search() — enumerate the sequence for this query's
+  // actual scores instead.
+  std::vector<std::vector<bool>> localSequence;
+  if (probingTemplate.size() < T)
+    GenerateProbingSequence(scores, T, localSequence);
+  const std::vector<std::vector<bool>>& sequence =
+      (probingTemplate.size() >= T) ? probingTemplate : localSequence;
+
+  // Transform each perturbation set to a perturbation vector by setting the
   // dimensions specified by the set to queryCode+action (action is {-1, 1}).
-
-  // Perturbation sets (A) mark with 1 the (score, action, dimension) positions
-  // included in a given perturbation vector. Other spaces are 0.
-  std::vector<bool> Ao(2 * numProj);
-  Ao[0] = 1; // Smallest vector includes only smallest score.
-
-  std::vector< std::vector<bool> > perturbationSets;
-  perturbationSets.push_back(Ao); // Storage of perturbation sets.
-
-  std::priority_queue<
-    std::pair<double, size_t>,        // contents: pairs of (score, index)
-    std::vector<                      // container: vector of pairs
-      std::pair<double, size_t>
-      >,
-    std::greater< std::pair<double, size_t> > // comparator of pairs
-  > minHeap; // our minheap
-
-  // Start by adding the lowest scoring set to the minheap.
-  minHeap.push(std::make_pair(PerturbationScore(Ao, scores), 0));
-
-  // Loop invariable: after pvec iterations, additionalProbingBins contains pvec
-  // valid codes of the lowest-scoring bins (bins most likely to contain
-  // neighbors of the query).
   for (size_t pvec = 0; pvec < T; ++pvec)
   {
-    std::vector<bool> Ai;
-    do
-    {
-      // Get the perturbation set corresponding to the minimum score.
-      Ai = perturbationSets[ minHeap.top().second ];
-      minHeap.pop(); // .top() returns, .pop() removes
-
-      // Shift operation on Ai (replace max with max+1).
-      std::vector<bool> As = Ai;
-
-      // Don't add invalid sets.
-      if (PerturbationShift(As) && PerturbationValid(As))
-      {
-        perturbationSets.push_back(As); // add shifted set to sets
-        minHeap.push(
-            std::make_pair(PerturbationScore(As, scores),
-            perturbationSets.size() - 1));
-      }
-
-      // Expand operation on Ai (add max+1 to set).
-      std::vector<bool> Ae = Ai;
+    const std::vector<bool>& Ai = sequence[pvec];
 
-      // Don't add invalid sets.
-      if (PerturbationExpand(Ae) && PerturbationValid(Ae))
-      {
-        perturbationSets.push_back(Ae); // add expanded set to sets
-        minHeap.push(
-            std::make_pair(PerturbationScore(Ae, scores),
-            perturbationSets.size() - 1));
-      }
-    } while (!PerturbationValid(Ai)); // Discard invalid perturbations
-
-    // Found valid perturbation set Ai. Construct perturbation vector from set.
     for (size_t pos = 0; pos < Ai.size(); ++pos)
     {
       // If Ai[pos] is marked, add action to probing vector.
@@ -901,6 +961,10 @@ void LSHSearch<SortPolicy, MatType>::Search(
     Log::Info << "Running multiprobe LSH with " << Teffective
         <<" additional probing bins per table per query." << std::endl;
 
+  // Cache the probing sequence template before the parallel loop, so the
+  // per-query probing bin computation does not need the heap enumeration.
+  EnsureProbingTemplate(Teffective);
+
   size_t avgIndicesReturned = 0;
 
   // Parallelization to process more than one query at a time.
@@ -963,6 +1027,10 @@ Search(const size_t k,
     Log::Info << "Running multiprobe LSH with " << Teffective <<
       " additional probing bins per table per query."<< std::endl;
 
+  // Cache the probing sequence template before the parallel loop, so the
+  // per-query probing bin computation does not need the heap enumeration.
+  EnsureProbingTemplate(Teffective);
+
   size_t avgIndicesReturned = 0;
 
   // Parallelization to process more than one query at a time.
@@ -1046,6 +1114,10 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(bucketContentSize));
   ar(CEREAL_NVP(bucketRowInHashTable));
   ar(CEREAL_NVP(distanceEvaluations));
+
+  // The probing sequence template depends on numProj; recompute it lazily.
+  if (cereal::is_loading<Archive>())
+    probingTemplate.clear();
 }
 
 } // namespace neighbor
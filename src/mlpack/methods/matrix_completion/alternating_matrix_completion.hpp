@@ -0,0 +1,180 @@
+/**
+ * @file methods/matrix_completion/alternating_matrix_completion.hpp
+ * @author Stephen Tu
+ *
+ * A scalable alternating-minimization solver for low rank matrix completion
+ * problems given as a list of observed entries.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_ALTERNATING_MATRIX_COMPLETION_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_ALTERNATING_MATRIX_COMPLETION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace matrix_completion {
+
+/**
+ * This class solves low rank matrix completion problems with regularized
+ * alternating least squares over the list of observed entries.  That is,
+ * given known values M_ij, it finds factors W (m x r) and H (r x n)
+ * minimizing
+ *
+ *   sum_ij ((W H)_ij - M_ij)^2 + lambda (||W||_F^2 + ||H||_F^2)
+ *
+ * where the sum runs over the observed entries only.  Each pass solves a
+ * small r x r least squares problem per row (with H fixed) and per column
+ * (with W fixed); rows and columns are independent and are solved in
+ * parallel.  Unlike the SDP formulation used by MatrixCompletion, the work
+ * per iteration is linear in the number of observed entries, so this solver
+ * scales to matrices with millions of rows and observed entries.  For very
+ * large problems, call Train() and work with the factors directly instead of
+ * materializing the completed matrix with Recover().
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @incollection{zhou2008als,
+ *   title = {Large-Scale Parallel Collaborative Filtering for the Netflix
+ *       Prize},
+ *   author = {Zhou, Y. and Wilkinson, D. and Schreiber, R. and Pan, R.},
+ *   booktitle = {Algorithmic Aspects in Information and Management},
+ *   year = {2008}
+ * }
+ * @endcode
+ *
+ * An example of how to use this class is shown below:
+ *
+ * @code
+ * size_t m, n;         // size of unknown matrix
+ * arma::umat indices;  // contains the known indices [2 x n_entries]
+ * arma::vec values;    // contains the known values [n_entries]
+ * arma::mat recovered; // will contain the completed matrix
+ *
+ * AlternatingMatrixCompletion amc(m, n, indices, values, 10);
+ * amc.Recover(recovered);
+ * @endcode
+ *
+ * @see MatrixCompletion
+ */
+class AlternatingMatrixCompletion
+{
+ public:
+  /**
+   * Construct an alternating-minimization matrix completion problem,
+   * specifying the rank of the solution.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param indices Matrix containing the indices of the known entries (must
+   *    be [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   * @param r Rank of the solution.
+   * @param maxIterations Maximum number of alternating passes.
+   * @param lambda Regularization parameter of the least squares problems.
+   * @param tolerance Terminate when the RMSE over the observed entries
+   *    improves by less than this between two passes.
+   */
+  AlternatingMatrixCompletion(const size_t m,
+                              const size_t n,
+                              const arma::umat& indices,
+                              const arma::vec& values,
+                              const size_t r,
+                              const size_t maxIterations = 100,
+                              const double lambda = 1e-6,
+                              const double tolerance = 1e-5);
+
+  /**
+   * Construct an alternating-minimization matrix completion problem, using
+   * the same default rank heuristic as MatrixCompletion.  For very large
+   * problems, prefer specifying a small rank explicitly.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param indices Matrix containing the indices of the known entries (must
+   *    be [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   */
+  AlternatingMatrixCompletion(const size_t m,
+                              const size_t n,
+                              const arma::umat& indices,
+                              const arma::vec& values);
+
+  /**
+   * Run the alternating least squares passes to compute the factors W and H.
+   */
+  void Train();
+
+  /**
+   * Fill in the remaining values, materializing the completed matrix
+   * W * H.  This calls Train() first; for very large problems, call Train()
+   * and use W() and H() instead.
+   *
+   * @param recovered Will contain the completed matrix.
+   */
+  void Recover(arma::mat& recovered);
+
+  //! Return the row factor matrix (m x r); available after Train().
+  const arma::mat& W() const { return w; }
+  //! Return the column factor matrix (r x n); available after Train().
+  const arma::mat& H() const { return h; }
+
+  //! Get the maximum number of alternating passes.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of alternating passes.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the termination tolerance on the observed-entry RMSE.
+  double Tolerance() const { return tolerance; }
+  //! Modify the termination tolerance on the observed-entry RMSE.
+  double& Tolerance() { return tolerance; }
+
+ private:
+  //! Number of rows in original matrix.
+  size_t m;
+  //! Number of columns in original matrix.
+  size_t n;
+  //! Matrix containing the indices of the known entries (has two rows).
+  arma::umat indices;
+  //! Vector containing the values of the known entries.
+  arma::vec values;
+  //! Rank of the solution.
+  size_t rank;
+  //! Maximum number of alternating passes.
+  size_t maxIterations;
+  //! Regularization parameter of the least squares problems.
+  double lambda;
+  //! Termination tolerance on the observed-entry RMSE.
+  double tolerance;
+
+  //! Row factor matrix (m x r).
+  arma::mat w;
+  //! Column factor matrix (r x n).
+  arma::mat h;
+
+  //! Validate the input matrices.
+  void CheckValues();
+
+  //! Select a rank of the matrix given that is of size m x n and has p known
+  //! elements.
+  static size_t DefaultRank(const size_t m, const size_t n, const size_t p);
+};
+
+} // namespace matrix_completion
+} // namespace mlpack
+
+// Include implementation.
+#include "alternating_matrix_completion_impl.hpp"
+
+#endif
@@ -0,0 +1,199 @@
+/**
+ * @file methods/matrix_completion/alternating_matrix_completion_impl.hpp
+ * @author Stephen Tu
+ *
+ * Implementation of AlternatingMatrixCompletion class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_ALTERNATING_MATRIX_COMPLETION_IMPL_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_ALTERNATING_MATRIX_COMPLETION_IMPL_HPP
+
+#include "alternating_matrix_completion.hpp"
+#include <mlpack/core/util/size_checks.hpp>
+
+namespace mlpack {
+namespace matrix_completion {
+
+inline AlternatingMatrixCompletion::AlternatingMatrixCompletion(
+    const size_t m,
+    const size_t n,
+    const arma::umat& indices,
+    const arma::vec& values,
+    const size_t r,
+    const size_t maxIterations,
+    const double lambda,
+    const double tolerance) :
+    m(m),
+    n(n),
+    indices(indices),
+    values(values),
+    rank(r),
+    maxIterations(maxIterations),
+    lambda(lambda),
+    tolerance(tolerance)
+{
+  CheckValues();
+}
+
+inline AlternatingMatrixCompletion::AlternatingMatrixCompletion(
+    const size_t m,
+    const size_t n,
+    const arma::umat& indices,
+    const arma::vec& values) :
+    m(m),
+    n(n),
+    indices(indices),
+    values(values),
+    rank(DefaultRank(m, n, indices.n_cols)),
+    maxIterations(100),
+    lambda(1e-6),
+    tolerance(1e-5)
+{
+  CheckValues();
+}
+
+inline void AlternatingMatrixCompletion::CheckValues()
+{
+  if (indices.n_rows != 2)
+  {
+    Log::Fatal << "AlternatingMatrixCompletion::CheckValues(): matrix of "
+        << "constraint indices does not have 2 rows!" << std::endl;
+  }
+
+  util::CheckSameSizes(indices, values,
+      "AlternatingMatrixCompletion::CheckValues()", "labels", false, true);
+
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    if (indices(0, i) >= m || indices(1, i) >= n)
+      Log::Fatal << "AlternatingMatrixCompletion::CheckValues(): indices ("
+          << indices(0, i) << ", " << indices(1, i)
+          << ") are out of bounds for matrix of size " << m << " x n!"
+          << std::endl;
+  }
+}
+
+inline void AlternatingMatrixCompletion::Train()
+{
+  const size_t p = indices.n_cols;
+
+  // Group the observed entries by row and by column once, so that each
+  // alternating pass only visits the entries of the row or column it is
+  // solving for.
+  const arma::uvec rowOrder = arma::stable_sort_index(indices.row(0).t());
+  const arma::uvec colOrder = arma::stable_sort_index(indices.row(1).t());
+  arma::uvec rowOffsets(m + 1, arma::fill::zeros);
+  arma::uvec colOffsets(n + 1, arma::fill::zeros);
+  for (size_t i = 0; i < p; ++i)
+  {
+    ++rowOffsets(indices(0, i) + 1);
+    ++colOffsets(indices(1, i) + 1);
+  }
+  for (size_t i = 1; i <= m; ++i)
+    rowOffsets(i) += rowOffsets(i - 1);
+  for (size_t i = 1; i <= n; ++i)
+    colOffsets(i) += colOffsets(i - 1);
+
+  // Initialize the factors randomly.
+  w.randu(m, rank);
+  h.randu(rank, n);
+
+  const arma::mat regularization = lambda *
+      arma::eye<arma::mat>(rank, rank);
+
+  double lastResidual = DBL_MAX;
+  for (size_t iteration = 1; iteration <= maxIterations; ++iteration)
+  {
+    // Solve for every row of W with H fixed.  The rows are independent, so
+    // they are solved in parallel; the work per row is proportional to the
+    // number of entries observed in that row, hence the dynamic schedule.
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t i = 0; i < (omp_size_t) m; ++i)
+    {
+      const size_t begin = rowOffsets(i);
+      const size_t end = rowOffsets(i + 1);
+      if (begin == end)
+        continue; // No observed entries: the row stays as it is.
+
+      arma::mat subH(rank, end - begin);
+      arma::vec subValues(end - begin);
+      for (size_t k = begin; k < end; ++k)
+      {
+        subH.col(k - begin) = h.col(indices(1, rowOrder(k)));
+        subValues(k - begin) = values(rowOrder(k));
+      }
+
+      w.row(i) = arma::solve(subH * subH.t() + regularization,
+          subH * subValues).t();
+    }
+
+    // Solve for every column of H with W fixed.
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t j = 0; j < (omp_size_t) n; ++j)
+    {
+      const size_t begin = colOffsets(j);
+      const size_t end = colOffsets(j + 1);
+      if (begin == end)
+        continue; // No observed entries: the column stays as it is.
+
+      arma::mat subW(end - begin, rank);
+      arma::vec subValues(end - begin);
+      for (size_t k = begin; k < end; ++k)
+      {
+        subW.row(k - begin) = w.row(indices(0, colOrder(k)));
+        subValues(k - begin) = values(colOrder(k));
+      }
+
+      h.col(j) = arma::solve(subW.t() * subW + regularization,
+          subW.t() * subValues);
+    }
+
+    // RMSE over the observed entries, to check for convergence.
+    double residual = 0;
+    #pragma omp parallel for reduction(+:residual)
+    for (omp_size_t k = 0; k < (omp_size_t) p; ++k)
+    {
+      const double error = values(k) -
+          arma::dot(w.row(indices(0, k)), h.col(indices(1, k)));
+      residual += error * error;
+    }
+    residual = std::sqrt(residual / p);
+
+    Log::Info << "AlternatingMatrixCompletion: iteration " << iteration
+        << ", RMSE " << residual << "." << std::endl;
+
+    if (std::abs(lastResidual - residual) < tolerance)
+      break;
+    lastResidual = residual;
+  }
+}
+
+inline void AlternatingMatrixCompletion::Recover(arma::mat& recovered)
+{
+  Train();
+  recovered = w * h;
+}
+
+inline size_t AlternatingMatrixCompletion::DefaultRank(const size_t m,
+                                                       const size_t n,
+                                                       const size_t p)
+{
+  // The same heuristic as MatrixCompletion::DefaultRank(): if
+  // r = O(sqrt(p)), an exact solution of the relaxation is guaranteed to
+  // exist.  For large problems this is usually far more than needed, and an
+  // explicit small rank should be given instead.
+  const size_t mpn = m + n;
+  float r = 0.5 + sqrt(0.25 + 2 * p);
+  if (ceil(r) > mpn)
+    r = mpn; // An upper bound on the dimension.
+  return ceil(r);
+}
+
+} // namespace matrix_completion
+} // namespace mlpack
+
+#endif
@@ -17,6 +17,7 @@
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 
 namespace mlpack {
 namespace meanshift /** Mean shift clustering. */ {
@@ -91,6 +92,29 @@ class MeanShift
                bool forceConvergence = true,
                bool useSeeds = true);
 
+  /**
+   * Perform mean shift clustering on the data, running every shift against
+   * the given prebuilt range searcher instead of building a new tree.  The
+   * searcher must have been built on exactly the given dataset; this overload
+   * is useful when the same dataset is clustered several times (e.g. with
+   * different radii), since then the tree only needs to be built once.
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments in.
+   * @param centroids Matrix in which centroids are stored.
+   * @param rangeSearcher Range searcher prebuilt on the dataset.
+   * @param forceConvergence Flag whether to force each centroid seed to
+   * converge regardless of maxIterations.
+   * @param useSeeds Set true to use seeds.
+   */
+  template<typename RangeSearcherType>
+  void Cluster(const MatType& data,
+               arma::Row<size_t>& assignments,
+               arma::mat& centroids,
+               RangeSearcherType& rangeSearcher,
+               bool forceConvergence = true,
+               bool useSeeds = true);
+
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Set the maximum number of iterations.
@@ -194,6 +194,32 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
     Radius(EstimateRadius(data));
   }
 
+  // Build the tree once; every shift of every seed searches against it.
+  range::RangeSearch<> rangeSearcher(data);
+  Cluster(data, assignments, centroids, rangeSearcher, forceConvergence,
+      useSeeds);
+}
+
+/**
+ * Perform Mean Shift clustering on the data set against a prebuilt range
+ * searcher, returning a list of cluster assignments and centroids.
+ */
+template<bool UseKernel, typename KernelType, typename MatType>
+template<typename RangeSearcherType>
+void MeanShift<UseKernel, KernelType, MatType>::Cluster(
+    const MatType& data,
+    arma::Row<size_t>& assignments,
+    arma::mat& centroids,
+    RangeSearcherType& rangeSearcher,
+    bool forceConvergence,
+    bool useSeeds)
+{
+  if (radius <= 0)
+  {
+    // An invalid radius is given; an estimation is needed.
+    Radius(EstimateRadius(data));
+  }
+
   MatType seeds;
   const MatType* pSeeds = &data;
   if (useSeeds)
@@ -204,61 +230,108 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
 
   // Holds all centroids before removing duplicate ones.
   arma::mat allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    allCentroids.col(i) = pSeeds->unsafe_col(i); // Initial centroid is seed.
 
   assignments.set_size(data.n_cols);
 
-  range::RangeSearch<> rangeSearcher(data);
   math::Range validRadius(0, radius);
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  // All seeds iterate in lockstep: each round performs one bulk range search
+  // against the fixed prebuilt tree for every seed that has not yet
+  // converged, and then shifts those seeds in parallel.  Seeds that converge
+  // are registered as modes immediately, and any active seed that has
+  // wandered to within the duplicate-removal radius of a registered mode is
+  // stopped early, since a centroid that converged there would be removed as
+  // a duplicate anyway.
+  std::vector<size_t> activeSeeds(pSeeds->n_cols);
+  for (size_t i = 0; i < activeSeeds.size(); ++i)
+    activeSeeds[i] = i;
+
+  size_t completedIterations = 0;
+  while (!activeSeeds.empty() &&
+      (completedIterations < maxIterations || forceConvergence))
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    // Gather the active centroids into one query set, so that the whole
+    // round is a single bulk search against the prebuilt tree.
+    arma::mat querySet(pSeeds->n_rows, activeSeeds.size());
+    for (size_t i = 0; i < activeSeeds.size(); ++i)
+      querySet.col(i) = allCentroids.col(activeSeeds[i]);
+
+    rangeSearcher.Search(querySet, validRadius, neighbors, distances);
+
+    // Holds, for each active seed, whether this round left it converged (1)
+    // or found no points in its range at all (2).
+    std::vector<char> status(activeSeeds.size(), 0);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) activeSeeds.size(); ++i)
     {
+      const size_t seed = activeSeeds[i];
+      if (neighbors[i].size() == 0) // There are no points in the cluster.
+      {
+        status[i] = 2;
+        continue;
+      }
+
       // Store new centroid in this.
       arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
-
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+      if (!CalculateCentroid(data, neighbors[i], distances[i], newCentroid))
+        newCentroid = allCentroids.unsafe_col(seed);
 
       // If the mean shift vector is small enough, it has converged.
       if (metric::EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+          allCentroids.unsafe_col(seed)) < 1e-3 * radius)
+      {
+        status[i] = 1;
+      }
+      else
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
-        {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
-        }
+        // Update the centroid.
+        allCentroids.col(seed) = newCentroid;
+      }
+    }
 
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
+    // Register the modes of the seeds that converged this round, and stop
+    // any seed that has come within the radius of a registered mode.
+    std::vector<size_t> stillActive;
+    for (size_t i = 0; i < activeSeeds.size(); ++i)
+    {
+      if (status[i] == 2)
+        continue;
 
-        // Get out of the loop.
-        break;
+      const size_t seed = activeSeeds[i];
+
+      // Determine if the centroid is duplicate with registered ones; the
+      // distances to all found centroids are computed in one bulk call.
+      bool isDuplicated = false;
+      if (centroids.n_cols > 0)
+      {
+        arma::mat centroidDistances;
+        metric::EuclideanDistance euclidean;
+        metric::PairwiseDistances(centroids, allCentroids.col(seed),
+            centroidDistances, euclidean);
+        isDuplicated = arma::any(centroidDistances.col(0) < radius);
       }
 
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+      if (status[i] == 1)
+      {
+        if (!isDuplicated)
+          centroids.insert_cols(centroids.n_cols,
+              allCentroids.unsafe_col(seed));
+      }
+      else if (!isDuplicated)
+      {
+        stillActive.push_back(seed);
+      }
     }
+    activeSeeds = std::move(stillActive);
+
+    completedIterations++;
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -131,6 +131,46 @@ class NaiveBayesClassifier
   template<typename VecType>
   void Train(const VecType& point, const size_t label);
 
+  /**
+   * Train the Naive Bayes classifier on the given batch by accumulating
+   * per-chunk sufficient statistics (count, sum and sum of squares per class)
+   * and merging them into the model.  With OpenMP the chunks are accumulated
+   * in parallel across threads.  The current model is always used as a
+   * starting point, so calling this repeatedly with successive batches is
+   * equivalent to training on their concatenation.
+   *
+   * Note that the sum-of-squares formulation is a one-pass algorithm, so for
+   * data with a very large mean-to-variance ratio it can lose a little
+   * precision compared to the two-pass batch algorithm used by Train().
+   *
+   * @param data The dataset to train on.
+   * @param labels The labels for the dataset.
+   * @param numClasses The number of classes in the dataset.
+   */
+  template<typename MatType>
+  void TrainParallel(const MatType& data,
+                     const arma::Row<size_t>& labels,
+                     const size_t numClasses);
+
+  /**
+   * Merge another classifier into this one, so that this model afterwards
+   * summarizes the union of the data the two models were trained on.  This
+   * allows map-reduce-style training, where classifiers are trained on
+   * different shards of the data and then combined.  The other model must
+   * have the same dimensionality and number of classes; otherwise a
+   * std::invalid_argument exception is thrown.
+   *
+   * Optionally, a weight may be given; the other model's sufficient
+   * statistics are scaled by it before being added.  Since the statistics
+   * already carry the per-class point counts, the default weight of 1 merges
+   * the exact union of the data; other weights up- or down-weight the other
+   * shard's contribution.
+   *
+   * @param other Classifier to merge into this one.
+   * @param weight Weight to apply to the other model's statistics.
+   */
+  void Merge(const NaiveBayesClassifier& other, const double weight = 1.0);
+
   /**
    * Classify the given point, using the trained NaiveBayesClassifier model. The
    * predicted label is returned.
@@ -241,6 +281,32 @@ class NaiveBayesClassifier
   template<typename MatType>
   void LogLikelihood(const MatType& data,
                      ModelMatType& logLikelihoods) const;
+
+  /**
+   * Convert the model into its sufficient statistics: the number of points,
+   * the sum of the points and the sum of the squared points of each class.
+   * The epsilon added to the variances is removed, so that statistics from
+   * several models can be added together and converted back.
+   *
+   * @param counts Vector to store per-class point counts in.
+   * @param sums Matrix to store per-class feature sums in.
+   * @param sumsOfSquares Matrix to store per-class squared feature sums in.
+   */
+  void SufficientStatistics(ModelMatType& counts,
+                            ModelMatType& sums,
+                            ModelMatType& sumsOfSquares) const;
+
+  /**
+   * Rebuild the model parameters (probabilities, means, variances and the
+   * number of training points) from the given sufficient statistics.
+   *
+   * @param counts Per-class point counts.
+   * @param sums Per-class feature sums.
+   * @param sumsOfSquares Per-class squared feature sums.
+   */
+  void RestoreModel(const ModelMatType& counts,
+                    const ModelMatType& sums,
+                    const ModelMatType& sumsOfSquares);
 };
 
 } // namespace naive_bayes
@@ -22,6 +22,8 @@
 // In case it hasn't been included already.
 #include "naive_bayes_classifier.hpp"
 
+#include <mlpack/core/math/scores_to_labels.hpp>
+
 namespace mlpack {
 namespace naive_bayes {
 
@@ -200,6 +202,164 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
   probabilities /= trainingPoints;
 }
 
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::SufficientStatistics(
+    ModelMatType& counts,
+    ModelMatType& sums,
+    ModelMatType& sumsOfSquares) const
+{
+  counts = probabilities * trainingPoints;
+  sums.set_size(arma::size(means));
+  sumsOfSquares.set_size(arma::size(variances));
+
+  for (size_t i = 0; i < probabilities.n_elem; ++i)
+  {
+    sums.col(i) = means.col(i) * counts[i];
+
+    // Invert the normalization of the variances; the epsilon added to
+    // prevent log of zero is removed first.
+    const ElemType norm = (counts[i] > 1) ? (counts[i] - 1) : ElemType(1);
+    sumsOfSquares.col(i) = (variances.col(i) - epsilon) * norm +
+        arma::square(means.col(i)) * counts[i];
+  }
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::RestoreModel(
+    const ModelMatType& counts,
+    const ModelMatType& sums,
+    const ModelMatType& sumsOfSquares)
+{
+  trainingPoints = (size_t) std::round(arma::accu(counts));
+  if (trainingPoints == 0)
+  {
+    // Leave the model in its untrained state.
+    probabilities.zeros();
+    means.zeros();
+    variances.zeros();
+    return;
+  }
+
+  probabilities = counts / (ElemType) trainingPoints;
+
+  for (size_t i = 0; i < probabilities.n_elem; ++i)
+  {
+    if (counts[i] > 0)
+      means.col(i) = sums.col(i) / counts[i];
+    else
+      means.col(i).zeros();
+
+    if (counts[i] > 1)
+    {
+      // The one-pass formulation can produce tiny negative values due to
+      // floating point roundoff; clamp those to zero.
+      variances.col(i) = arma::clamp(
+          (sumsOfSquares.col(i) - arma::square(means.col(i)) * counts[i]) /
+          (counts[i] - 1),
+          ElemType(0), std::numeric_limits<ElemType>::max());
+    }
+    else
+    {
+      variances.col(i).zeros();
+    }
+  }
+
+  // Add epsilon to prevent log of zero.
+  variances += epsilon;
+}
+
+template<typename ModelMatType>
+template<typename MatType>
+void NaiveBayesClassifier<ModelMatType>::TrainParallel(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses)
+{
+  static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
+      "NaiveBayesClassifier: element type of given data must match the element "
+      "type of the model!");
+
+  // Do we need to resize the model?
+  if (probabilities.n_elem != numClasses)
+  {
+    probabilities.zeros(numClasses);
+    means.zeros(data.n_rows, numClasses);
+    variances.zeros(data.n_rows, numClasses);
+    trainingPoints = 0;
+  }
+
+  // Start from the sufficient statistics of the current model, so the batch
+  // is merged into it incrementally.
+  ModelMatType counts, sums, sumsOfSquares;
+  SufficientStatistics(counts, sums, sumsOfSquares);
+
+  // Accumulate the statistics of the batch; with OpenMP each thread
+  // accumulates its own chunk of points locally and the per-thread statistics
+  // are merged at the end.
+  #pragma omp parallel
+  {
+    ModelMatType localCounts;
+    localCounts.zeros(numClasses);
+    ModelMatType localSums;
+    localSums.zeros(data.n_rows, numClasses);
+    ModelMatType localSumsOfSquares;
+    localSumsOfSquares.zeros(data.n_rows, numClasses);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+    {
+      const size_t label = labels[j];
+      ++localCounts[label];
+      localSums.col(label) += data.col(j);
+      localSumsOfSquares.col(label) += arma::square(data.col(j));
+    }
+
+    #pragma omp critical (NaiveBayesSufficientStatistics)
+    {
+      counts += localCounts;
+      sums += localSums;
+      sumsOfSquares += localSumsOfSquares;
+    }
+  }
+
+  RestoreModel(counts, sums, sumsOfSquares);
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::Merge(
+    const NaiveBayesClassifier& other,
+    const double weight)
+{
+  if (other.means.n_rows != means.n_rows ||
+      other.probabilities.n_elem != probabilities.n_elem)
+  {
+    throw std::invalid_argument("NaiveBayesClassifier::Merge(): models must "
+        "have the same dimensionality and number of classes!");
+  }
+  if (weight < 0.0)
+  {
+    throw std::invalid_argument("NaiveBayesClassifier::Merge(): the merge "
+        "weight must be non-negative!");
+  }
+
+  if (other.trainingPoints == 0 || weight == 0.0)
+    return;
+
+  // The sufficient statistics of the two models simply add, with the other
+  // model's statistics scaled by the given weight.
+  ModelMatType counts, sums, sumsOfSquares;
+  SufficientStatistics(counts, sums, sumsOfSquares);
+
+  ModelMatType otherCounts, otherSums, otherSumsOfSquares;
+  other.SufficientStatistics(otherCounts, otherSums, otherSumsOfSquares);
+
+  counts += weight * otherCounts;
+  sums += weight * otherSums;
+  sumsOfSquares += weight * otherSumsOfSquares;
+
+  RestoreModel(counts, sums, sumsOfSquares);
+}
+
 template<typename ModelMatType>
 template<typename MatType>
 void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
@@ -291,17 +451,11 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  predictions.set_size(data.n_cols);
-
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    arma::uword maxIndex = 0;
-    logLikelihoods.unsafe_col(i).max(maxIndex);
-    predictions[i] = maxIndex;
-  }
+  // Predict the class with the highest log-likelihood for each point.
+  math::ScoresToLabels(logLikelihoods, predictions);
 }
 
 template<typename ModelMatType>
@@ -319,32 +473,20 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  predictions.set_size(data.n_cols);
-
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
-  predictionProbs.set_size(arma::size(logLikelihoods));
-  double maxValue, logProbX;
-  for (size_t j = 0; j < data.n_cols; ++j)
-  {
-    // The LogLikelihood() gives us the unnormalized log likelihood which is
-    // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
-    // Besides, to prevent underflow in log of sum of exp of x operation (where
-    // x is a small negative value), we use logsumexp(x - max(x)) + max(x).
-    maxValue = arma::max(logLikelihoods.col(j));
-    logProbX = log(arma::accu(exp(logLikelihoods.col(j) -
-        maxValue))) + maxValue;
-    predictionProbs.col(j) = arma::exp(logLikelihoods.col(j) - logProbX);
-  }
-
-  // Now calculate maximum probabilities for each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    arma::uword maxIndex = 0;
-    logLikelihoods.unsafe_col(i).max(maxIndex);
-    predictions[i] = maxIndex;
-  }
+  // The LogLikelihood() gives us the unnormalized log likelihood which is
+  // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
+  // Besides, to prevent underflow in log of sum of exp of x operation (where
+  // x is a small negative value), we use logsumexp(x - max(x)) + max(x).
+  const arma::Row<ElemType> maxValues = arma::max(logLikelihoods, 0);
+  const arma::Row<ElemType> logProbX = arma::log(arma::sum(
+      arma::exp(logLikelihoods.each_row() - maxValues), 0)) + maxValues;
+  predictionProbs = arma::exp(logLikelihoods.each_row() - logProbX);
+
+  // Predict the class with the highest log-likelihood for each point.
+  math::ScoresToLabels(logLikelihoods, predictions);
 }
 
 template<typename ModelMatType>
@@ -76,10 +76,13 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
   stretchedDataset = coordinates * dataset;
   for (size_t i = begin; i < begin + batchSize; ++i)
   {
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    // The scan over all points is embarrassingly parallel.
+    #pragma omp parallel for reduction(+ : numerator, denominator) \
+        schedule(static)
+    for (omp_size_t k = 0; k < (omp_size_t) dataset.n_cols; ++k)
     {
       // Don't consider the case where the points are the same.
-      if (k == i)
+      if ((size_t) k == i)
         continue;
 
       // We want to evaluate exp(-D(A x_i, A x_k)).
@@ -129,26 +132,40 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   //     (p_i p_ik + p_k p_ki) x_ik x_ik^T
   arma::mat sum;
   sum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+  #pragma omp parallel
   {
-    for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
+    // Each thread accumulates into its own matrix, and these are combined once
+    // each thread finishes its share of the pairs.
+    arma::mat localSum(stretchedDataset.n_rows, stretchedDataset.n_rows,
+        arma::fill::zeros);
+
+    // The amount of work in the inner loop depends on i, so use dynamic
+    // scheduling to keep the threads balanced.
+    #pragma omp for schedule(dynamic, 64) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
     {
-      // Calculate p_ik and p_ki first.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-      double p_ik = 0, p_ki = 0;
-      p_ik = eval / denominators(i);
-      p_ki = eval / denominators(k);
-
-      // Subtract x_i from x_k.  We are not using stretched points here.
-      arma::vec x_ik = dataset.col(i) - dataset.col(k);
-      arma::mat secondTerm = (x_ik * trans(x_ik));
-
-      if (labels[i] == labels[k])
-        sum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
-      else
-        sum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+      for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
+      {
+        // Calculate p_ik and p_ki first.
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(k)));
+        double p_ik = 0, p_ki = 0;
+        p_ik = eval / denominators(i);
+        p_ki = eval / denominators(k);
+
+        // Subtract x_i from x_k.  We are not using stretched points here.
+        arma::vec x_ik = dataset.col(i) - dataset.col(k);
+        arma::mat secondTerm = (x_ik * trans(x_ik));
+
+        if (labels[i] == labels[k])
+          localSum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
+        else
+          localSum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+      }
     }
+
+    #pragma omp critical (SoftmaxErrorFunctionGradient)
+    sum += localSum;
   }
 
   // Assemble the final gradient.
@@ -182,31 +199,48 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
     firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
     secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
 
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    // Split the scan over all points between threads, with each thread
+    // accumulating into local matrices.
+    #pragma omp parallel reduction(+ : numerator, denominator)
     {
-      // Don't consider the case where the points are the same.
-      if (i == k)
-        continue;
+      GradType localFirstTerm, localSecondTerm;
+      localFirstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
+      localSecondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
 
-      // Calculate the numerator of p_ik.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-
-      // If the points are in the same class, we must add to the second term of
-      // the gradient as well as the numerator of p_i.  We will divide by the
-      // denominator of p_ik later.  For x_ik we are not using stretched points.
-      GradType x_ik = dataset.col(i) - dataset.col(k);
-      if (labels[i] == labels[k])
+      #pragma omp for schedule(static) nowait
+      for (omp_size_t k = 0; k < (omp_size_t) dataset.n_cols; ++k)
       {
-        numerator += eval;
-        secondTerm += eval * x_ik * trans(x_ik);
+        // Don't consider the case where the points are the same.
+        if (i == (size_t) k)
+          continue;
+
+        // Calculate the numerator of p_ik.
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(k)));
+
+        // If the points are in the same class, we must add to the second term
+        // of the gradient as well as the numerator of p_i.  We will divide by
+        // the denominator of p_ik later.  For x_ik we are not using stretched
+        // points.
+        GradType x_ik = dataset.col(i) - dataset.col(k);
+        if (labels[i] == labels[k])
+        {
+          numerator += eval;
+          localSecondTerm += eval * x_ik * trans(x_ik);
+        }
+
+        // We always have to add to the denominator of p_i
+        // and the first term of the gradient computation.
+        // We will divide by the denominator of p_ik later.
+        denominator += eval;
+        localFirstTerm += eval * x_ik * trans(x_ik);
       }
 
-      // We always have to add to the denominator of p_i
-      // and the first term of the gradient computation.
-      // We will divide by the denominator of p_ik later.
-      denominator += eval;
-      firstTerm += eval * x_ik * trans(x_ik);
+      #pragma omp critical (SoftmaxErrorFunctionSeparableGradient)
+      {
+        firstTerm += localFirstTerm;
+        secondTerm += localSecondTerm;
+      }
     }
 
     // Calculate p_i.
@@ -265,25 +299,42 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   // order of O((n * (n + 1)) / 2), which really isn't all that great.
   p.zeros(stretchedDataset.n_cols);
   denominators.zeros(stretchedDataset.n_cols);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+  #pragma omp parallel
   {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
+    // Each pair (i, j) updates both the i-th and j-th entries, so each thread
+    // accumulates into its own vectors and these are combined at the end.
+    arma::vec localP(stretchedDataset.n_cols, arma::fill::zeros);
+    arma::vec localDenominators(stretchedDataset.n_cols, arma::fill::zeros);
+
+    // The amount of work in the inner loop depends on i, so use dynamic
+    // scheduling to keep the threads balanced.
+    #pragma omp for schedule(dynamic, 64) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
     {
-      // Evaluate exp(-d(x_i, x_j)).
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(j)));
-
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      denominators[i] += eval;
-      denominators[j] += eval;
-
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
+      for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
       {
-        p[i] += eval;
-        p[j] += eval;
+        // Evaluate exp(-d(x_i, x_j)).
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(j)));
+
+        // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
+        localDenominators[i] += eval;
+        localDenominators[j] += eval;
+
+        // If i and j are the same class, add to numerator of both.
+        if (labels[i] == labels[j])
+        {
+          localP[i] += eval;
+          localP[j] += eval;
+        }
       }
     }
+
+    #pragma omp critical (SoftmaxErrorFunctionPrecalculate)
+    {
+      p += localP;
+      denominators += localDenominators;
+    }
   }
 
   // Divide p_i by their denominators.
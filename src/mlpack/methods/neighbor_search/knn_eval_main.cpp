@@ -0,0 +1,226 @@
+/**
+ * @file methods/neighbor_search/knn_eval_main.cpp
+ *
+ * Executable for evaluating approximate k-nearest-neighbor strategies:
+ * computes exact ground truth on a sample of the queries, then sweeps the
+ * quality parameter of each strategy and reports recall@k against queries
+ * per second.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#ifdef BINDING_NAME
+  #undef BINDING_NAME
+#endif
+#define BINDING_NAME knn_eval
+
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "knn_evaluation.hpp"
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::neighbor;
+using namespace mlpack::util;
+
+// Program Name.
+BINDING_USER_NAME("k-Nearest-Neighbors Evaluation");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An evaluation harness for approximate k-nearest-neighbor search.  Exact "
+    "ground truth is computed on a sample of the queries, then the quality "
+    "parameters of the approximate strategies are swept, reporting recall@k "
+    "versus queries per second for each setting.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program evaluates the recall/latency tradeoff of approximate "
+    "k-nearest-neighbor strategies on a given dataset, replacing manual "
+    "parameter tuning with one sweep.  A random sample of the query set "
+    "(controlled by " + PRINT_PARAM_STRING("sample_size") + ") is taken and "
+    "its exact neighbors are computed with dual-tree search; then each "
+    "strategy is run across a range of its quality parameter, and for each "
+    "setting the parameter value, the recall@k against the ground truth, and "
+    "the achieved queries per second are reported."
+    "\n\n"
+    "If " + PRINT_PARAM_STRING("epsilon_results") + " is specified, the "
+    "relative error bound of approximate dual-tree search is swept linearly "
+    "from " + PRINT_PARAM_STRING("min_epsilon") + " to " +
+    PRINT_PARAM_STRING("max_epsilon") + " in " +
+    PRINT_PARAM_STRING("sweep_steps") + " steps.  If " +
+    PRINT_PARAM_STRING("ef_results") + " is specified, a small-world graph "
+    "index is built (with degree " + PRINT_PARAM_STRING("max_neighbors") +
+    " and construction beam width " +
+    PRINT_PARAM_STRING("ef_construction") + ") and its search beam width is "
+    "swept linearly from " + PRINT_PARAM_STRING("min_ef_search") + " to " +
+    PRINT_PARAM_STRING("max_ef_search") + ".  Each row of an output matrix "
+    "is [parameter value, recall@k, queries per second].");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, the following command sweeps both strategies for 10-nearest"
+    "-neighbor search on " + PRINT_DATASET("input") + ", storing the sweeps "
+    "in " + PRINT_DATASET("eps_results") + " and " +
+    PRINT_DATASET("ef_results") + ": "
+    "\n\n" +
+    PRINT_CALL("knn_eval", "k", 10, "reference", "input", "epsilon_results",
+        "eps_results", "ef_results", "ef_results"));
+
+// See also...
+BINDING_SEE_ALSO("@knn", "#knn");
+BINDING_SEE_ALSO("@lsh", "#lsh");
+BINDING_SEE_ALSO("mlpack::neighbor::KNNEvaluation C++ class documentation",
+    "@doxygen/classmlpack_1_1neighbor_1_1KNNEvaluation.html");
+
+// Define our input parameters that this program will take.
+PARAM_MATRIX_IN_REQ("reference", "Matrix containing the reference dataset.",
+    "r");
+PARAM_MATRIX_IN("query", "Matrix containing query points (optional; if "
+    "unspecified, the reference set is used).", "q");
+PARAM_INT_IN_REQ("k", "Number of nearest neighbors to evaluate.", "k");
+PARAM_INT_IN("sample_size", "Maximum number of queries to sample for "
+    "evaluation.", "s", 1000);
+
+// Epsilon sweep parameters.
+PARAM_MATRIX_OUT("epsilon_results", "Matrix to store the approximate "
+    "dual-tree sweep results into ([epsilon, recall@k, queries/second] per "
+    "row).", "e");
+PARAM_DOUBLE_IN("min_epsilon", "Minimum relative error bound to evaluate.",
+    "E", 0.0);
+PARAM_DOUBLE_IN("max_epsilon", "Maximum relative error bound to evaluate.",
+    "X", 1.0);
+PARAM_INT_IN("sweep_steps", "Number of settings to evaluate per sweep.", "S",
+    5);
+
+// Graph index sweep parameters.
+PARAM_MATRIX_OUT("ef_results", "Matrix to store the small-world graph sweep "
+    "results into ([efSearch, recall@k, queries/second] per row).", "f");
+PARAM_INT_IN("min_ef_search", "Minimum search beam width to evaluate.", "F",
+    8);
+PARAM_INT_IN("max_ef_search", "Maximum search beam width to evaluate.", "G",
+    256);
+PARAM_INT_IN("max_neighbors", "Maximum node degree of the graph index.", "N",
+    16);
+PARAM_INT_IN("ef_construction", "Beam width used while building the graph "
+    "index.", "c", 100);
+
+PARAM_INT_IN("seed", "Random seed for query sampling (0 uses std::time(NULL))."
+    , "d", 0);
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  if (params.Get<int>("seed") != 0)
+    math::RandomSeed((size_t) params.Get<int>("seed"));
+  else
+    math::RandomSeed((size_t) std::time(NULL));
+
+  // Sanity-check the parameters.
+  const size_t k = (size_t) params.Get<int>("k");
+  RequireParamValue<int>(params, "k", [](int x) { return x > 0; }, true,
+      "k must be positive");
+  RequireParamValue<int>(params, "sample_size",
+      [](int x) { return x > 0; }, true, "sample size must be positive");
+  RequireParamValue<int>(params, "sweep_steps",
+      [](int x) { return x > 0; }, true, "sweep steps must be positive");
+  RequireAtLeastOnePassed(params, { "epsilon_results", "ef_results" }, false,
+      "no sweep will be run");
+
+  arma::mat referenceSet = std::move(params.Get<arma::mat>("reference"));
+
+  if (k > referenceSet.n_cols)
+  {
+    Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and less "
+        << "than or equal to the number of reference points ("
+        << referenceSet.n_cols << ")." << endl;
+  }
+
+  const size_t sampleSize = (size_t) params.Get<int>("sample_size");
+  const size_t sweepSteps = (size_t) params.Get<int>("sweep_steps");
+
+  // Build the harness; this computes the exact ground truth.
+  timers.Start("ground_truth");
+  std::unique_ptr<KNNEvaluation> eval;
+  if (params.Has("query"))
+  {
+    eval.reset(new KNNEvaluation(std::move(referenceSet),
+        params.Get<arma::mat>("query"), k, sampleSize));
+  }
+  else
+  {
+    // The reference set doubles as the query set.
+    arma::mat querySet = referenceSet;
+    eval.reset(new KNNEvaluation(std::move(referenceSet), querySet, k,
+        sampleSize));
+  }
+  timers.Stop("ground_truth");
+
+  Log::Info << "Evaluating on " << eval->SampledQueries().n_cols
+      << " sampled queries." << endl;
+
+  if (params.Has("epsilon_results"))
+  {
+    const double minEpsilon = params.Get<double>("min_epsilon");
+    const double maxEpsilon = params.Get<double>("max_epsilon");
+    if (minEpsilon < 0.0 || maxEpsilon < minEpsilon)
+      Log::Fatal << "Invalid epsilon range [" << minEpsilon << ", "
+          << maxEpsilon << "]!" << endl;
+
+    const arma::vec epsilons = (sweepSteps == 1) ?
+        arma::vec(1).fill(minEpsilon) :
+        arma::linspace<arma::vec>(minEpsilon, maxEpsilon, sweepSteps);
+
+    arma::mat results;
+    timers.Start("epsilon_sweep");
+    eval->SweepEpsilon(epsilons, results);
+    timers.Stop("epsilon_sweep");
+
+    for (size_t i = 0; i < results.n_rows; ++i)
+    {
+      Log::Info << "epsilon " << results(i, 0) << ": recall@" << k << " "
+          << results(i, 1) << ", " << results(i, 2) << " queries/second."
+          << endl;
+    }
+
+    params.Get<arma::mat>("epsilon_results") = std::move(results);
+  }
+
+  if (params.Has("ef_results"))
+  {
+    const size_t minEf = (size_t) params.Get<int>("min_ef_search");
+    const size_t maxEf = (size_t) params.Get<int>("max_ef_search");
+    if (minEf == 0 || maxEf < minEf)
+      Log::Fatal << "Invalid efSearch range [" << minEf << ", " << maxEf
+          << "]!" << endl;
+
+    arma::Col<size_t> efValues(sweepSteps);
+    for (size_t i = 0; i < sweepSteps; ++i)
+    {
+      efValues[i] = (sweepSteps == 1) ? minEf :
+          minEf + (size_t) std::round((double) i * (maxEf - minEf) /
+          (sweepSteps - 1));
+    }
+
+    arma::mat results;
+    timers.Start("ef_sweep");
+    eval->SweepEfSearch(efValues, results,
+        (size_t) params.Get<int>("max_neighbors"),
+        (size_t) params.Get<int>("ef_construction"));
+    timers.Stop("ef_sweep");
+
+    for (size_t i = 0; i < results.n_rows; ++i)
+    {
+      Log::Info << "efSearch " << results(i, 0) << ": recall@" << k << " "
+          << results(i, 1) << ", " << results(i, 2) << " queries/second."
+          << endl;
+    }
+
+    params.Get<arma::mat>("ef_results") = std::move(results);
+  }
+}
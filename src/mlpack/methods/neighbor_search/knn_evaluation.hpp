@@ -0,0 +1,131 @@
+/**
+ * @file methods/neighbor_search/knn_evaluation.hpp
+ *
+ * Evaluation harness for approximate nearest-neighbor search strategies.  It
+ * computes exact ground truth on a sample of the queries, then sweeps the
+ * quality parameter of a strategy (the relative error bound of approximate
+ * dual-tree search, or the beam width of the small-world graph index),
+ * reporting recall@k against queries per second for each setting.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_KNN_EVALUATION_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_KNN_EVALUATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "neighbor_search.hpp"
+#include "sw_graph.hpp"
+#include "typedef.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * KNNEvaluation measures the recall/latency tradeoff of approximate
+ * nearest-neighbor strategies.  On construction it samples the query set and
+ * computes exact k-nearest-neighbor ground truth for the sample with
+ * dual-tree search; each Sweep*() call then runs one strategy across a range
+ * of its quality parameter and reports, for every setting, the parameter
+ * value, the recall@k against the ground truth, and the achieved queries per
+ * second.
+ *
+ * Ground truth is computed on a sample because exact search over the full
+ * query set is exactly the cost the approximate strategies are meant to
+ * avoid; the sample size trades evaluation time for recall precision.
+ *
+ * @code
+ * KNNEvaluation eval(referenceSet, querySet, 10);
+ * arma::mat results;
+ * eval.SweepEpsilon(arma::vec("0.0 0.1 0.5 1.0"), results);
+ * // results.row(i) is [epsilon, recall@10, queries/second].
+ * @endcode
+ */
+class KNNEvaluation
+{
+ public:
+  /**
+   * Construct the evaluation harness: sample the query set and compute exact
+   * ground truth for the sampled queries.
+   *
+   * @param referenceSet Set of reference points.
+   * @param querySet Set of query points; a random sample of at most
+   *      sampleSize of them is used for evaluation.
+   * @param k Number of neighbors to search for.
+   * @param sampleSize Maximum number of queries to evaluate on.
+   */
+  KNNEvaluation(arma::mat referenceSet,
+                const arma::mat& querySet,
+                const size_t k,
+                const size_t sampleSize = 1000);
+
+  /**
+   * Sweep the relative error bound of approximate dual-tree search.  Each row
+   * of the results matrix is [epsilon, recall@k, queries per second]; index
+   * build time is not included in the timing, matching the steady-state
+   * regime where one built tree serves many queries.
+   *
+   * @param epsilons Relative error bounds to evaluate.
+   * @param results Output matrix; set to epsilons.n_elem x 3.
+   */
+  void SweepEpsilon(const arma::vec& epsilons, arma::mat& results) const;
+
+  /**
+   * Sweep the search beam width of the small-world graph index.  The graph is
+   * built once with the given construction parameters, then searched with
+   * each beam width; each row of the results matrix is [efSearch, recall@k,
+   * queries per second], excluding the one-time build cost.
+   *
+   * @param efValues Search beam widths to evaluate.
+   * @param results Output matrix; set to efValues.n_elem x 3.
+   * @param maxNeighbors Maximum node degree of the graph.
+   * @param efConstruction Beam width used while building the graph.
+   */
+  void SweepEfSearch(const arma::Col<size_t>& efValues,
+                     arma::mat& results,
+                     const size_t maxNeighbors = 16,
+                     const size_t efConstruction = 100) const;
+
+  /**
+   * Compute the recall@k of the given neighbor lists against the ground
+   * truth.  The neighbors must correspond to the sampled queries (see
+   * SampledQueries()).
+   *
+   * @param foundNeighbors Neighbor lists to evaluate (k x sample size).
+   */
+  double Recall(const arma::Mat<size_t>& foundNeighbors) const;
+
+  //! Access the reference set.
+  const arma::mat& ReferenceSet() const { return referenceSet; }
+  //! Access the sampled queries that strategies are evaluated on.
+  const arma::mat& SampledQueries() const { return sampledQueries; }
+  //! Access the exact neighbors of the sampled queries.
+  const arma::Mat<size_t>& TrueNeighbors() const { return trueNeighbors; }
+  //! Access the exact neighbor distances of the sampled queries.
+  const arma::mat& TrueDistances() const { return trueDistances; }
+  //! Get the number of neighbors searched for.
+  size_t K() const { return k; }
+
+ private:
+  //! The reference set that all strategies index.
+  arma::mat referenceSet;
+  //! The sampled queries used for evaluation.
+  arma::mat sampledQueries;
+  //! Number of neighbors to search for.
+  size_t k;
+  //! Exact neighbors of the sampled queries.
+  arma::Mat<size_t> trueNeighbors;
+  //! Exact neighbor distances of the sampled queries.
+  arma::mat trueDistances;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "knn_evaluation_impl.hpp"
+
+#endif
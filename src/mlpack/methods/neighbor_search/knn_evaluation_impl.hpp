@@ -0,0 +1,118 @@
+/**
+ * @file methods/neighbor_search/knn_evaluation_impl.hpp
+ *
+ * Implementation of the approximate nearest-neighbor evaluation harness.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_KNN_EVALUATION_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_KNN_EVALUATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "knn_evaluation.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+inline KNNEvaluation::KNNEvaluation(arma::mat referenceSet,
+                                    const arma::mat& querySet,
+                                    const size_t k,
+                                    const size_t sampleSize) :
+    referenceSet(std::move(referenceSet)),
+    k(k)
+{
+  if (k > this->referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "KNNEvaluation: requested value of k (" << k << ") is greater "
+        << "than the number of reference points ("
+        << this->referenceSet.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Sample the queries without replacement.
+  if (sampleSize >= querySet.n_cols)
+  {
+    sampledQueries = querySet;
+  }
+  else
+  {
+    const arma::uvec ordering = arma::shuffle(
+        arma::linspace<arma::uvec>(0, querySet.n_cols - 1, querySet.n_cols));
+    sampledQueries = querySet.cols(ordering.head(sampleSize));
+  }
+
+  // Compute exact ground truth for the sample with dual-tree search.
+  KNN exact(this->referenceSet);
+  exact.Search(sampledQueries, k, trueNeighbors, trueDistances);
+}
+
+inline void KNNEvaluation::SweepEpsilon(const arma::vec& epsilons,
+                                        arma::mat& results) const
+{
+  results.set_size(epsilons.n_elem, 3);
+
+  for (size_t i = 0; i < epsilons.n_elem; ++i)
+  {
+    // The tree is rebuilt for each setting, but only the search is timed;
+    // one built tree typically serves many queries.
+    KNN approx(referenceSet, DUAL_TREE_MODE, epsilons[i]);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    arma::wall_clock clock;
+    clock.tic();
+    approx.Search(sampledQueries, k, neighbors, distances);
+    const double searchTime = clock.toc();
+
+    results(i, 0) = epsilons[i];
+    results(i, 1) = Recall(neighbors);
+    results(i, 2) = (searchTime > 0.0) ?
+        (sampledQueries.n_cols / searchTime) : 0.0;
+  }
+}
+
+inline void KNNEvaluation::SweepEfSearch(const arma::Col<size_t>& efValues,
+                                         arma::mat& results,
+                                         const size_t maxNeighbors,
+                                         const size_t efConstruction) const
+{
+  results.set_size(efValues.n_elem, 3);
+
+  // Build the graph once; the beam width only affects searches.
+  SWGraph<> graph(referenceSet, maxNeighbors, efConstruction);
+
+  for (size_t i = 0; i < efValues.n_elem; ++i)
+  {
+    graph.EfSearch() = efValues[i];
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    arma::wall_clock clock;
+    clock.tic();
+    graph.Search(sampledQueries, k, neighbors, distances);
+    const double searchTime = clock.toc();
+
+    results(i, 0) = (double) efValues[i];
+    results(i, 1) = Recall(neighbors);
+    results(i, 2) = (searchTime > 0.0) ?
+        (sampledQueries.n_cols / searchTime) : 0.0;
+  }
+}
+
+inline double KNNEvaluation::Recall(
+    const arma::Mat<size_t>& foundNeighbors) const
+{
+  // KNN::Recall() takes non-const references, so make mutable copies.
+  arma::Mat<size_t> found = foundNeighbors;
+  arma::Mat<size_t> truth = trueNeighbors;
+  return KNN::Recall(found, truth);
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
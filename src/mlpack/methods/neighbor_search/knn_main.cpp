@@ -130,6 +130,10 @@ PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
     "'dual_tree', 'greedy'.", "a", "dual_tree");
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
+PARAM_STRING_IN("precision", "Precision to store the reference points and tree "
+    "bounds in: 'double' or 'float'.  The 'float' mode halves the memory of "
+    "the index; it supports only kd-trees, the default leaf size, and cannot "
+    "save or load models.", "P", "double");
 
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
@@ -214,6 +218,131 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   else if (algorithm == "greedy")
     searchMode = GREEDY_SINGLE_TREE_MODE;
 
+  // The float32 mode stores the reference points, tree bounds, and distance
+  // computations in single precision, halving index memory.
+  const string precision = params.Get<string>("precision");
+  RequireParamInSet<string>(params, "precision", { "double", "float" }, true,
+      "unknown precision");
+  if (precision == "float")
+  {
+    if (params.Has("input_model") || params.Has("output_model"))
+    {
+      Log::Fatal << "Models cannot be loaded or saved in 'float' precision "
+          << "mode; use 'double' precision instead." << endl;
+    }
+    if (params.Get<string>("tree_type") != "kd")
+    {
+      Log::Fatal << PRINT_PARAM_STRING("tree_type") << " must be 'kd' in "
+          << "'float' precision mode." << endl;
+    }
+    ReportIgnoredParam(params, "random_basis", "float precision mode");
+    if (lsInt != 20)
+    {
+      Log::Warn << PRINT_PARAM_STRING("leaf_size") << " is ignored in 'float'"
+          << " precision mode; the default leaf size of 20 is used." << endl;
+    }
+
+    typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::fmat,
+        tree::KDTree> FloatKNN;
+
+    Log::Info << "Using reference data from "
+        << params.GetPrintable<arma::mat>("reference") << "." << endl;
+    arma::fmat referenceSet = arma::conv_to<arma::fmat>::from(
+        params.Get<arma::mat>("reference"));
+
+    FloatKNN floatKNN(std::move(referenceSet), searchMode, epsilon);
+
+    if (params.Has("k"))
+    {
+      const size_t k = (size_t) params.Get<int>("k");
+
+      arma::fmat queryData;
+      if (params.Has("query"))
+      {
+        Log::Info << "Using query data from "
+            << params.GetPrintable<arma::mat>("query") << "." << endl;
+        queryData = arma::conv_to<arma::fmat>::from(
+            params.Get<arma::mat>("query"));
+        if (queryData.n_rows != floatKNN.ReferenceSet().n_rows)
+        {
+          Log::Fatal << "Query has invalid dimensions(" << queryData.n_rows
+              << "); should be " << floatKNN.ReferenceSet().n_rows << "!"
+              << endl;
+        }
+      }
+
+      // The same sanity checks on k as in the double-precision path below.
+      if (k > floatKNN.ReferenceSet().n_cols)
+      {
+        Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and "
+            << "less than or equal to the number of reference points ("
+            << floatKNN.ReferenceSet().n_cols << ")." << endl;
+      }
+      if (!params.Has("query") && k == floatKNN.ReferenceSet().n_cols)
+      {
+        Log::Fatal << "Invalid k: " << k << "; must be less than the number "
+            << "of reference points (" << floatKNN.ReferenceSet().n_cols
+            << ") if query data has not been provided." << endl;
+      }
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+
+      timers.Start("computing_neighbors");
+      if (params.Has("query"))
+        floatKNN.Search(queryData, k, neighbors, distances);
+      else
+        floatKNN.Search(k, neighbors, distances);
+      timers.Stop("computing_neighbors");
+
+      Log::Info << "Search complete." << endl;
+
+      const SearchStats& stats = floatKNN.LastSearchStats();
+      Log::Info << "Search statistics: " << stats.baseCases << " base cases, "
+          << stats.scores << " node combinations scored, " << stats.prunes
+          << " prunes; the traversal took " << stats.traversalTime.count()
+          << " microseconds." << endl;
+
+      if (params.Has("true_distances"))
+      {
+        arma::mat trueDistances =
+            std::move(params.Get<arma::mat>("true_distances"));
+
+        if (trueDistances.n_rows != distances.n_rows ||
+            trueDistances.n_cols != distances.n_cols)
+        {
+          Log::Fatal << "The true distances file must have the same number of "
+              << "values than the set of distances being queried!" << endl;
+        }
+
+        Log::Info << "Effective error: " << KNN::EffectiveError(distances,
+            trueDistances) << endl;
+      }
+
+      if (params.Has("true_neighbors"))
+      {
+        arma::Mat<size_t> trueNeighbors =
+            std::move(params.Get<arma::Mat<size_t>>("true_neighbors"));
+
+        if (trueNeighbors.n_rows != neighbors.n_rows ||
+            trueNeighbors.n_cols != neighbors.n_cols)
+        {
+          Log::Fatal << "The true neighbors file must have the same number of "
+              << "values than the set of neighbors being queried!" << endl;
+        }
+
+        Log::Info << "Recall: " << KNN::Recall(neighbors, trueNeighbors)
+            << endl;
+      }
+
+      // Save output.
+      params.Get<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
+      params.Get<arma::mat>("distances") = std::move(distances);
+    }
+
+    return;
+  }
+
   if (params.Has("reference"))
   {
     // Get all the parameters.
@@ -352,6 +481,12 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     Log::Info << "Search complete." << endl;
 
+    const SearchStats& stats = knn->LastSearchStats();
+    Log::Info << "Search statistics: " << stats.baseCases << " base cases, "
+        << stats.scores << " node combinations scored, " << stats.prunes
+        << " prunes; the traversal took " << stats.traversalTime.count()
+        << " microseconds." << endl;
+
     // Calculate the effective error, if desired.
     if (params.Has("true_distances"))
     {
@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include <vector>
 #include <string>
+#include <unordered_set>
 
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
@@ -24,6 +25,7 @@
 #include "neighbor_search_stat.hpp"
 #include "sort_policies/nearest_neighbor_sort.hpp"
 #include "neighbor_search_rules.hpp"
+#include "quantized_reference_set.hpp"
 
 namespace mlpack {
 // Neighbor-search routines. These include all-nearest-neighbors and
@@ -48,6 +50,30 @@ enum NeighborSearchMode
   GREEDY_SINGLE_TREE_MODE
 };
 
+/**
+ * SearchStats holds the work counters of a single search.  The const (and
+ * therefore thread-safe) Search() overloads write their counters into an
+ * object of this type supplied by the caller, instead of into the counters on
+ * the NeighborSearch object that BaseCases() and Scores() report; this way a
+ * search does not touch any shared state.  (This is the scratch object for
+ * searches, not to be confused with NeighborSearchStat, which is the
+ * per-tree-node statistic.)
+ */
+struct SearchStats
+{
+  //! The number of base case (point-to-point distance) evaluations performed.
+  size_t baseCases = 0;
+  //! The number of node combinations scored (zero for naive search).
+  size_t scores = 0;
+  //! The number of node combinations pruned without recursion (zero for
+  //! naive search).
+  size_t prunes = 0;
+  //! Wall-clock time spent in the traversal phase of the search, including
+  //! building the query tree in dual-tree mode but excluding mapping the
+  //! results back to original indices.
+  std::chrono::microseconds traversalTime{0};
+};
+
 /**
  * The NeighborSearch class is a template class for performing distance-based
  * neighbor searches.  It takes a query dataset and a reference dataset (or just
@@ -62,6 +88,18 @@ enum NeighborSearchMode
  * can be found in the NearestNeighborSort class and the kernel::ExampleKernel
  * class.
  *
+ * Thread safety: the const Search() overloads (those taking a SearchStats
+ * object) do not modify this object, so any number of threads may call them
+ * concurrently on one NeighborSearch object, as long as no thread concurrently
+ * calls a non-const member (Train(), Insert(), Delete(), RebuildIndex(), or a
+ * non-const Search() overload).  The non-const Search() overloads update the
+ * BaseCases() and Scores() counters---and the monochromatic overload also
+ * resets bounds cached in the reference tree---so they must not run
+ * concurrently with anything else.  Concurrent searches also require that
+ * MetricType::Evaluate() can be called from several threads at once; this
+ * holds for every metric shipped with mlpack, since none of them modify the
+ * metric object during evaluation.
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
  * @tparam MetricType The metric to use for computation.
  * @tparam MatType The type of data matrix.
@@ -233,6 +271,50 @@ class NeighborSearch
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Thread-safe version of Search(): computes exactly the same results, but
+   * does not modify this object, so any number of threads may call it
+   * concurrently on one NeighborSearch object (see the class documentation for
+   * the exact guarantee).  The work counters for this search are written to
+   * the given SearchStats object instead of the counters that BaseCases() and
+   * Scores() report, which are left untouched.
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   * @param stats Object the work counters of this search are written to.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              SearchStats& stats) const;
+
+  /**
+   * For each point in the query set, compute the nearest neighbors and store
+   * the output in the given matrices, exactly as Search() does, but first
+   * reorder the query points along a Morton (Z-order) curve so that
+   * consecutive queries are spatially close and traverse similar parts of the
+   * reference tree.  On large query sets this keeps the tree's working set in
+   * cache between consecutive queries; the results are unmapped back to the
+   * original query order, so the output is identical to Search().
+   *
+   * The reordering copies the query set once, so for small query sets plain
+   * Search() may be faster.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void SearchBatch(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& neighbors,
+                   arma::mat& distances);
+
   /**
    * Given a pre-built query tree, search for the nearest neighbors of each
    * point in the query tree, storing the output in the given matrices.  The
@@ -259,6 +341,31 @@ class NeighborSearch
               arma::mat& distances,
               bool sameSet = false);
 
+  /**
+   * Thread-safe version of the pre-built query tree overload of Search(): it
+   * does not modify this object, so it may be called concurrently from many
+   * threads.  Note that the traversal caches pruning bounds in the statistics
+   * of the query tree, so each thread must search with its own query tree (and
+   * the usual caveat applies: reset the query tree statistics before reusing
+   * the tree).  The work counters are written to the given SearchStats object;
+   * BaseCases() and Scores() are left untouched.
+   *
+   * @param queryTree Tree built on query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   * @param stats Object the work counters of this search are written to.
+   * @param sameSet Denotes whether or not the reference and query sets are the
+   *      same.
+   */
+  void Search(Tree& queryTree,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              SearchStats& stats,
+              const bool sameSet = false) const;
+
   /**
    * Search for the nearest neighbors of every point in the reference set.  This
    * is basically equivalent to calling any other overload of Search() with the
@@ -268,6 +375,12 @@ class NeighborSearch
    * where n is the number of points in the query dataset and k is the number of
    * neighbors being searched for.
    *
+   * There is no thread-safe (const) version of this overload: in dual-tree
+   * mode the monochromatic traversal dirties the bounds cached in the
+   * reference tree, which must be reset afterwards.  To search the reference
+   * points concurrently, pass ReferenceSet() as the query set of the const
+   * bichromatic Search() overload and drop each point's self-match.
+   *
    * @param k Number of neighbors to search for.
    * @param neighbors Matrix storing lists of neighbors for each query point.
    * @param distances Matrix storing distances of neighbors for each query
@@ -277,6 +390,57 @@ class NeighborSearch
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Insert new reference points without rebuilding the tree.  The points are
+   * kept in a side buffer (the delta set) that every subsequent Search()
+   * scans by brute force in addition to the tree, so insertion cost scales
+   * with the number of inserted points rather than the reference set size.
+   * Results refer to inserted points with indices following the reference
+   * set: the j'th inserted point has index ReferenceSet().n_cols + j.
+   *
+   * When the pending changes (inserts plus lazy deletes) exceed
+   * RebuildThreshold() times the reference set size, the index is rebuilt on
+   * the merged set; see RebuildIndex() for what that implies for indices.
+   *
+   * Note that the monochromatic Search(k, ...) overload does not issue
+   * queries for pending inserted points; they only appear as candidates.
+   *
+   * @param points New reference points, one per column.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Lazily delete the reference point with the given index (in the same
+   * indexing Search() reports: original reference points first, then pending
+   * inserted points).  The point is not removed from the tree; it is instead
+   * filtered out of subsequent search results, and physically dropped at the
+   * next index rebuild.
+   *
+   * @param index Index of the point to delete.
+   */
+  void Delete(const size_t index);
+
+  /**
+   * Merge the pending inserted points into the reference set, drop the
+   * lazily deleted points, and rebuild the tree on the result.  This is
+   * called automatically once the pending changes exceed RebuildThreshold()
+   * times the reference set size.  After a rebuild the points are renumbered
+   * compactly, so previously returned neighbor indices are stale; the
+   * current point set is available via ReferenceSet().
+   */
+  void RebuildIndex();
+
+  //! Access the points inserted since the last rebuild.
+  const MatType& DeltaSet() const { return deltaSet; }
+  //! Get the number of points lazily deleted since the last rebuild.
+  size_t NumPendingDeletes() const { return deletedPoints.size(); }
+
+  //! Access the fraction of the reference set size that pending changes may
+  //! reach before the index is rebuilt.
+  double RebuildThreshold() const { return rebuildThreshold; }
+  //! Modify the rebuild threshold.
+  double& RebuildThreshold() { return rebuildThreshold; }
+
   /**
    * Calculate the average relative error (effective error) between the
    * distances calculated and the true distances provided.  The input matrices
@@ -316,6 +480,11 @@ class NeighborSearch
   //! Return the number of node combination scores during the last search.
   size_t Scores() const { return scores; }
 
+  //! Return the full work counters of the last search performed through a
+  //! non-const Search() overload (the const overloads report through their
+  //! SearchStats argument instead and leave this untouched).
+  const SearchStats& LastSearchStats() const { return lastStats; }
+
   //! Access the search mode.
   NeighborSearchMode SearchMode() const { return searchMode; }
   //! Modify the search mode.
@@ -326,6 +495,12 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  //! Access whether two-tier low-precision base case evaluation is used.
+  bool LowPrecisionPrune() const { return lowPrecisionPrune; }
+  //! Modify whether two-tier low-precision base case evaluation is used.
+  //! This is only supported for the Euclidean metric; results stay exact.
+  bool& LowPrecisionPrune() { return lowPrecisionPrune; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -339,6 +514,52 @@ class NeighborSearch
   void serialize(Archive& ar, const uint32_t version);
 
  private:
+  /**
+   * The tree-only search implementations; these are the bodies of the
+   * corresponding public Search() overloads, which additionally merge the
+   * delta set into the results and filter out lazily deleted points when
+   * there are pending incremental updates.  The bichromatic overloads are
+   * const (the public thread-safe overloads are built on them) and report
+   * their work counters through the given SearchStats object; the
+   * monochromatic overload mutates the reference tree statistics and the
+   * counter members directly.
+   */
+  void SearchTree(const MatType& querySet,
+                  const size_t k,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances,
+                  SearchStats& stats) const;
+  void SearchTree(Tree& queryTree,
+                  const size_t k,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances,
+                  SearchStats& stats,
+                  bool sameSet = false) const;
+  void SearchTree(const size_t k,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances);
+
+  /**
+   * Merge brute-force results over the delta set into the tree results and
+   * drop lazily deleted points, keeping the k best candidates per query.
+   *
+   * @param querySet The query points.
+   * @param k Number of neighbors to keep.
+   * @param treeNeighbors Tree results (possibly more than k rows).
+   * @param treeDistances Tree result distances.
+   * @param neighbors Matrix to store the merged neighbors into.
+   * @param distances Matrix to store the merged distances into.
+   */
+  void MergeDeltaResults(const MatType& querySet,
+                         const size_t k,
+                         const arma::Mat<size_t>& treeNeighbors,
+                         const arma::mat& treeDistances,
+                         arma::Mat<size_t>& neighbors,
+                         arma::mat& distances) const;
+
+  //! Rebuild the index if the pending changes have crossed the threshold.
+  void MaybeRebuildIndex();
+
   //! Permutations of reference points during tree building.
   std::vector<size_t> oldFromNewReferences;
   //! Pointer to the root of the reference tree.
@@ -350,19 +571,38 @@ class NeighborSearch
   NeighborSearchMode searchMode;
   //! Indicates the relative error to be considered in approximate search.
   double epsilon;
+  //! If true, tree-based searches evaluate base cases against a 16-bit
+  //! quantized copy of the reference set first, and only candidates that
+  //! could enter the result list are rescored at full precision.  The
+  //! quantization error bound keeps the results exact; this is only
+  //! supported for the Euclidean metric.
+  bool lowPrecisionPrune = false;
 
-  //! Instantiation of metric.
-  MetricType metric;
+  //! Instantiation of metric.  (Mutable because some metrics have a non-const
+  //! Evaluate(); the const Search() overloads still treat it as read-only.)
+  mutable MetricType metric;
 
   //! The total number of base cases.
   size_t baseCases;
   //! The total number of scores (applicable for non-naive search).
   size_t scores;
+  //! The full work counters of the last non-const search.
+  SearchStats lastStats;
 
   //! If this is true, the reference tree bounds need to be reset on a call to
   //! Search() without a query set.
   bool treeNeedsReset;
 
+  //! Points inserted since the last rebuild; these are searched by brute
+  //! force and merged into the tree results.
+  MatType deltaSet;
+  //! Indices of lazily deleted points (in the indexing Search() reports);
+  //! these are filtered from results and dropped at the next rebuild.
+  std::unordered_set<size_t> deletedPoints;
+  //! Fraction of the reference set size that pending changes may reach
+  //! before the index is rebuilt.
+  double rebuildThreshold = 0.1;
+
   //! The NSModel class should have access to internal members.
   friend class LeafSizeNSWrapper<SortPolicy, TreeType, DualTreeTraversalType,
       SingleTreeTraversalType>;
@@ -14,8 +14,13 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+#include <mlpack/core/util/numa_topology.hpp>
+#include <mlpack/core/util/task_pool.hpp>
 #include "neighbor_search_rules.hpp"
+#include "unmap.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
 
 namespace mlpack {
@@ -129,7 +134,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
   // Build the tree on the empty dataset, if necessary.
   if (mode != NAIVE_MODE)
   {
-    referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+    referenceTree = BuildTree<Tree>(std::move(MatType()),
         oldFromNewReferences);
     referenceSet = &referenceTree->Dataset();
   }
@@ -152,10 +157,15 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
         new MatType(*other.referenceSet)),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    lowPrecisionPrune(other.lowPrecisionPrune),
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(false)
+    lastStats(other.lastStats),
+    treeNeedsReset(false),
+    deltaSet(other.deltaSet),
+    deletedPoints(other.deletedPoints),
+    rebuildThreshold(other.rebuildThreshold)
 {
   // Nothing else to do.
 }
@@ -176,10 +186,15 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     referenceSet(other.referenceSet),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    lowPrecisionPrune(other.lowPrecisionPrune),
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(other.treeNeedsReset)
+    lastStats(other.lastStats),
+    treeNeedsReset(other.treeNeedsReset),
+    deltaSet(std::move(other.deltaSet)),
+    deletedPoints(std::move(other.deletedPoints)),
+    rebuildThreshold(other.rebuildThreshold)
 {
   // Clear the other model.
   other.referenceTree = BuildTree<Tree>(std::move(MatType()),
@@ -187,9 +202,14 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.lowPrecisionPrune = false;
   other.baseCases = 0;
   other.scores = 0;
+  other.lastStats = SearchStats();
   other.treeNeedsReset = false;
+  other.deltaSet.reset();
+  other.deletedPoints.clear();
+  other.rebuildThreshold = 0.1;
 }
 
 // Copy operator.
@@ -229,10 +249,15 @@ NeighborSearch<SortPolicy,
       new MatType(*other.referenceSet);
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  lowPrecisionPrune = other.lowPrecisionPrune;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
+  lastStats = other.lastStats;
   treeNeedsReset = false;
+  deltaSet = other.deltaSet;
+  deletedPoints = other.deletedPoints;
+  rebuildThreshold = other.rebuildThreshold;
 }
 
 // Move operator.
@@ -271,23 +296,33 @@ NeighborSearch<SortPolicy,
   referenceSet = other.referenceSet;
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  lowPrecisionPrune = other.lowPrecisionPrune;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
+  lastStats = other.lastStats;
   treeNeedsReset = other.treeNeedsReset;
+  deltaSet = std::move(other.deltaSet);
+  deletedPoints = std::move(other.deletedPoints);
+  rebuildThreshold = other.rebuildThreshold;
 
   // Reset the other object.  Clean memory if needed.
   if (!other.referenceTree)
     delete other.referenceSet;
 
-  other.referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+  other.referenceTree = BuildTree<Tree>(std::move(MatType()),
       other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.lowPrecisionPrune = false;
   other.baseCases = 0;
   other.scores = 0;
+  other.lastStats = SearchStats();
   other.treeNeedsReset = false;
+  other.deltaSet.reset();
+  other.deletedPoints.clear();
+  other.rebuildThreshold = 0.1;
 }
 
 // Clean memory.
@@ -386,12 +421,15 @@ template<typename SortPolicy,
          template<typename> class DualTreeTraversalType,
          template<typename> class SingleTreeTraversalType>
 void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType>::SearchTree(
     const MatType& querySet,
     const size_t k,
     arma::Mat<size_t>& neighbors,
-    arma::mat& distances)
+    arma::mat& distances,
+    SearchStats& stats) const
 {
+  util::ProfileRegion profile("neighbor_search_traversal");
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -400,8 +438,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     throw std::invalid_argument(ss.str());
   }
 
-  baseCases = 0;
-  scores = 0;
+  stats.baseCases = 0;
+  stats.scores = 0;
+  stats.prunes = 0;
+  stats.traversalTime = std::chrono::microseconds(0);
 
   // This will hold mappings for query points, if necessary.
   std::vector<size_t> oldFromNewQueries;
@@ -431,44 +471,163 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
 
-  switch (searchMode)
+  // If two-tier low-precision pruning was requested, build the 16-bit
+  // compressed copy of the reference set once; the rule sets share it
+  // read-only.  The quantized distance computation is Euclidean, so the
+  // option is ignored for other metrics.  The naive mode computes its
+  // distances in bulk and does not use base cases, so it gets no copy.
+  QuantizedReferenceSet<MatType> quantizedSet;
+  const QuantizedReferenceSet<MatType>* quantizedPtr = NULL;
+  if (lowPrecisionPrune && searchMode != NAIVE_MODE)
   {
-    case NAIVE_MODE:
+    if (std::is_same<MetricType, metric::EuclideanDistance>::value)
+    {
+      quantizedSet = QuantizedReferenceSet<MatType>(*referenceSet);
+      quantizedPtr = &quantizedSet;
+    }
+    else
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      Log::Warn << "NeighborSearch::Search(): low-precision pruning is only "
+          << "supported for the Euclidean metric; it will be ignored."
+          << std::endl;
+    }
+  }
 
-      // The naive brute-force traversal.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+  // The rules hold per-query candidate heaps and cached base-case state, so
+  // they cannot be shared between threads; the parallel modes below give each
+  // thread its own RuleType over a disjoint set of query points and merge the
+  // per-thread results into disjoint columns of the output at the end.
+#ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+#else
+  const size_t numThreads = 1;
+#endif
 
-      baseCases += querySet.n_cols * referenceSet->n_cols;
+  const std::chrono::steady_clock::time_point traversalStart =
+      std::chrono::steady_clock::now();
 
-      rules.GetResults(*neighborPtr, *distancePtr);
+  switch (searchMode)
+  {
+    case NAIVE_MODE:
+    {
+      // The naive brute-force search: compute the reference-to-query
+      // distances in bulk — for L2 metrics each chunk reduces to a single
+      // matrix multiplication — and keep the k best per query.  Each thread
+      // handles a contiguous block of query points and writes disjoint
+      // columns of the output, so no synchronization is needed.
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+      {
+        const size_t blockBegin = (querySet.n_cols * t) / numThreads;
+        const size_t blockEnd = (querySet.n_cols * (t + 1)) / numThreads;
+        if (blockBegin == blockEnd)
+          continue;
+
+        // Bind this worker to one NUMA node before touching any data, then
+        // copy its query shard: the first touch after pinning places the
+        // shard in node-local memory.  On single-node machines both are
+        // no-ops beyond the local copy.
+        const util::NumaTopology& topology = util::NumaTopology::Get();
+        topology.PinThreadToNode((t * topology.NumNodes()) / numThreads);
+        const MatType queryShard(querySet.cols(blockBegin, blockEnd - 1));
+
+        // Chunk the block so the temporary distance matrix stays small.
+        const size_t chunkCols = std::max<size_t>(1,
+            (1 << 22) / referenceSet->n_cols);
+        arma::mat chunkDistances;
+        std::vector<std::pair<double, size_t>> candidates(
+            referenceSet->n_cols);
+
+        for (size_t begin = blockBegin; begin < blockEnd; begin += chunkCols)
+        {
+          const size_t end = std::min(begin + chunkCols, blockEnd);
+          mlpack::metric::PairwiseDistances(*referenceSet,
+              queryShard.cols(begin - blockBegin, end - blockBegin - 1),
+              chunkDistances, metric);
+
+          for (size_t i = begin; i < end; ++i)
+          {
+            for (size_t j = 0; j < referenceSet->n_cols; ++j)
+              candidates[j] = std::make_pair(chunkDistances(j, i - begin), j);
+
+            // SortPolicy::IsBetter() is not strict, so build a strict
+            // comparator from it for std::partial_sort().
+            std::partial_sort(candidates.begin(), candidates.begin() + k,
+                candidates.end(),
+                [](const std::pair<double, size_t>& a,
+                   const std::pair<double, size_t>& b)
+                {
+                  return SortPolicy::IsBetter(a.first, b.first) &&
+                      !SortPolicy::IsBetter(b.first, a.first);
+                });
+
+            for (size_t r = 0; r < k; ++r)
+            {
+              (*neighborPtr)(r, i) = candidates[r].second;
+              (*distancePtr)(r, i) = candidates[r].first;
+            }
+          }
+        }
+      }
+
+      stats.baseCases += querySet.n_cols * referenceSet->n_cols;
       break;
     }
     case SINGLE_TREE_MODE:
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      size_t totalScores = 0, totalBaseCases = 0, totalPrunes = 0;
 
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Each thread traverses for a contiguous block of query points with its
+      // own rule set and traverser.
+      #pragma omp parallel for schedule(static) \
+          reduction(+: totalScores, totalBaseCases, totalPrunes)
+      for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+      {
+        const size_t blockBegin = (querySet.n_cols * t) / numThreads;
+        const size_t blockEnd = (querySet.n_cols * (t + 1)) / numThreads;
+        if (blockBegin == blockEnd)
+          continue;
+
+        // Bind this worker to one NUMA node before touching any data, then
+        // copy its query shard: the first touch after pinning places the
+        // shard in node-local memory.  On single-node machines both are
+        // no-ops beyond the local copy.
+        const util::NumaTopology& topology = util::NumaTopology::Get();
+        topology.PinThreadToNode((t * topology.NumNodes()) / numThreads);
+        const MatType queryShard(querySet.cols(blockBegin, blockEnd - 1));
+
+        // Create the helper object for the tree traversal.  It works on the
+        // node-local shard, so its indices are relative to blockBegin.
+        RuleType rules(*referenceSet, queryShard, k, metric, epsilon, false,
+            quantizedPtr);
+
+        // Create the traverser.
+        SingleTreeTraversalType<RuleType> traverser(rules);
+
+        // Now have it traverse for each point.
+        for (size_t i = blockBegin; i < blockEnd; ++i)
+          traverser.Traverse(i - blockBegin, *referenceTree);
+
+        totalScores += rules.Scores();
+        totalBaseCases += rules.BaseCases();
+        totalPrunes += traverser.NumPrunes();
+
+        // Each thread writes only its own block of columns.
+        arma::Mat<size_t> blockNeighbors;
+        arma::mat blockDistances;
+        rules.GetResults(blockNeighbors, blockDistances);
+        neighborPtr->cols(blockBegin, blockEnd - 1) = blockNeighbors;
+        distancePtr->cols(blockBegin, blockEnd - 1) = blockDistances;
+      }
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      stats.scores += totalScores;
+      stats.baseCases += totalBaseCases;
+      stats.prunes += totalPrunes;
 
-      Log::Info << rules.Scores() << " node combinations were scored."
+      Log::Info << totalScores << " node combinations were scored."
           << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
+      Log::Info << totalBaseCases << " base cases were calculated."
           << std::endl;
-
-      rules.GetResults(*neighborPtr, *distancePtr);
       break;
     }
     case DUAL_TREE_MODE:
@@ -476,52 +635,163 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Build the query tree.
       Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
 
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
+      if (numThreads == 1)
+      {
+        // Create the helper object for the tree traversal.
+        RuleType rules(*referenceSet, queryTree->Dataset(), k, metric,
+            epsilon, false, quantizedPtr);
 
-      // Create the traverser.
-      DualTreeTraversalType<RuleType> traverser(rules);
+        // Create the traverser.
+        DualTreeTraversalType<RuleType> traverser(rules);
 
-      traverser.Traverse(*queryTree, *referenceTree);
+        traverser.Traverse(*queryTree, *referenceTree);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+        stats.scores += rules.Scores();
+        stats.baseCases += rules.BaseCases();
+        stats.prunes += traverser.NumPrunes();
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+        Log::Info << rules.Scores() << " node combinations were scored."
+            << std::endl;
+        Log::Info << rules.BaseCases() << " base cases were calculated."
+            << std::endl;
 
-      rules.GetResults(*neighborPtr, *distancePtr);
+        rules.GetResults(*neighborPtr, *distancePtr);
+      }
+      else
+      {
+        std::atomic<size_t> totalScores(0), totalBaseCases(0), totalPrunes(0);
+
+        // Each subtree traversal gets its own rule set; a subtree's query
+        // points are disjoint from every other subtree's, so the merge
+        // touches disjoint columns.  Subtree costs are heavily skewed on
+        // clustered data, so the traversals run on a work-stealing pool: a
+        // task over a still-large subtree splits itself into one task per
+        // child while workers are starving, instead of a fixed up-front
+        // partition serializing the tail of the traversal.  (The pool also
+        // pins its workers across the NUMA nodes, so each worker's candidate
+        // heaps and traversal stack stay node-local.)
+        util::TaskPool pool;
+        std::function<void(Tree*)> traverseSubtree = [&](Tree* node)
+        {
+          if (node->NumChildren() > 0 && node->NumDescendants() >= 512 &&
+              pool.Starving())
+          {
+            for (size_t c = 1; c < node->NumChildren(); ++c)
+            {
+              Tree* child = &node->Child(c);
+              pool.Submit([&traverseSubtree, child]()
+                  { traverseSubtree(child); });
+            }
+            traverseSubtree(&node->Child(0));
+            return;
+          }
+
+          RuleType rules(*referenceSet, queryTree->Dataset(), k, metric,
+              epsilon, false, quantizedPtr);
+          DualTreeTraversalType<RuleType> traverser(rules);
+
+          traverser.Traverse(*node, *referenceTree);
+
+          totalScores += rules.Scores();
+          totalBaseCases += rules.BaseCases();
+          totalPrunes += traverser.NumPrunes();
+
+          arma::Mat<size_t> blockNeighbors;
+          arma::mat blockDistances;
+          rules.GetResults(blockNeighbors, blockDistances);
+          for (size_t j = 0; j < node->NumDescendants(); ++j)
+          {
+            const size_t q = node->Descendant(j);
+            neighborPtr->col(q) = blockNeighbors.col(q);
+            distancePtr->col(q) = blockDistances.col(q);
+          }
+        };
+
+        // Seed the pool with the root; it splits itself as needed.
+        std::vector<util::TaskPool::Task> seeds;
+        Tree* root = queryTree;
+        seeds.push_back([&traverseSubtree, root]() { traverseSubtree(root); });
+        pool.Run(std::move(seeds));
+
+        stats.scores += totalScores.load();
+        stats.baseCases += totalBaseCases.load();
+        stats.prunes += totalPrunes.load();
+
+        Log::Info << totalScores.load() << " node combinations were scored."
+            << std::endl;
+        Log::Info << totalBaseCases.load() << " base cases were calculated."
+            << std::endl;
+      }
 
       delete queryTree;
       break;
     }
     case GREEDY_SINGLE_TREE_MODE:
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric);
+      size_t totalScores = 0, totalBaseCases = 0, totalPrunes = 0;
 
-      // Create the traverser.
-      tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Each thread traverses for a contiguous block of query points with its
+      // own rule set and traverser.
+      #pragma omp parallel for schedule(static) \
+          reduction(+: totalScores, totalBaseCases, totalPrunes)
+      for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+      {
+        const size_t blockBegin = (querySet.n_cols * t) / numThreads;
+        const size_t blockEnd = (querySet.n_cols * (t + 1)) / numThreads;
+        if (blockBegin == blockEnd)
+          continue;
+
+        // Bind this worker to one NUMA node before touching any data, then
+        // copy its query shard: the first touch after pinning places the
+        // shard in node-local memory.  On single-node machines both are
+        // no-ops beyond the local copy.
+        const util::NumaTopology& topology = util::NumaTopology::Get();
+        topology.PinThreadToNode((t * topology.NumNodes()) / numThreads);
+        const MatType queryShard(querySet.cols(blockBegin, blockEnd - 1));
+
+        // Create the helper object for the tree traversal.  It works on the
+        // node-local shard, so its indices are relative to blockBegin.
+        RuleType rules(*referenceSet, queryShard, k, metric, 0, false,
+            quantizedPtr);
+
+        // Create the traverser.
+        tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+
+        // Have it traverse the whole shard as one batch; the batch splits at
+        // each node by which child each point prefers, so each tree node is
+        // fetched once per batch instead of once per point.
+        std::vector<size_t> batch(blockEnd - blockBegin);
+        for (size_t i = 0; i < batch.size(); ++i)
+          batch[i] = i;
+        traverser.Traverse(batch, *referenceTree);
+
+        totalScores += rules.Scores();
+        totalBaseCases += rules.BaseCases();
+        totalPrunes += traverser.NumPrunes();
+
+        // Each thread writes only its own block of columns.
+        arma::Mat<size_t> blockNeighbors;
+        arma::mat blockDistances;
+        rules.GetResults(blockNeighbors, blockDistances);
+        neighborPtr->cols(blockBegin, blockEnd - 1) = blockNeighbors;
+        distancePtr->cols(blockBegin, blockEnd - 1) = blockDistances;
+      }
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      stats.scores += totalScores;
+      stats.baseCases += totalBaseCases;
+      stats.prunes += totalPrunes;
 
-      Log::Info << rules.Scores() << " node combinations were scored."
+      Log::Info << totalScores << " node combinations were scored."
           << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
+      Log::Info << totalBaseCases << " base cases were calculated."
           << std::endl;
-
-      rules.GetResults(*neighborPtr, *distancePtr);
       break;
     }
   }
 
+  stats.traversalTime += std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - traversalStart);
+
   // Map points back to original indices, if necessary.
   if (tree::TreeTraits<Tree>::RearrangesDataset)
   {
@@ -580,7 +850,47 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       delete neighborPtr;
     }
   }
-} // Search()
+} // SearchTree()
+
+/**
+ * Compute a Morton (Z-order) code for the given point, quantized inside the
+ * given hyperrectangle bound.  The available 64 bits are split evenly across
+ * the dimensions (round-robin interleaving, most significant bit first), so
+ * in very high dimensions only the leading dimensions contribute; that is
+ * fine, since the code is only used as a sort key for locality.
+ */
+template<typename VecType, typename BoundType>
+uint64_t MortonCode(const VecType& point, const BoundType& bound)
+{
+  const size_t dims = point.n_elem;
+  const size_t bitsPerDim = std::max<size_t>(1, 64 / dims);
+  const uint64_t maxCell = (uint64_t(1) << bitsPerDim) - 1;
+
+  // Quantize each dimension into its grid cell.
+  arma::Col<uint64_t> cells(dims);
+  for (size_t d = 0; d < dims; ++d)
+  {
+    const double width = bound[d].Hi() - bound[d].Lo();
+    if (width > 0)
+    {
+      const double scaled = (point[d] - bound[d].Lo()) / width;
+      cells[d] = std::min(maxCell, (uint64_t) (scaled * (double) maxCell));
+    }
+    else
+    {
+      cells[d] = 0;
+    }
+  }
+
+  // Interleave the cell bits across dimensions, one bit level at a time.
+  uint64_t code = 0;
+  size_t bitsUsed = 0;
+  for (size_t b = bitsPerDim; b > 0; --b)
+    for (size_t d = 0; d < dims && bitsUsed < 64; ++d, ++bitsUsed)
+      code = (code << 1) | ((cells[d] >> (b - 1)) & 1);
+
+  return code;
+}
 
 template<typename SortPolicy,
          typename MetricType,
@@ -591,13 +901,73 @@ template<typename SortPolicy,
          template<typename> class DualTreeTraversalType,
          template<typename> class SingleTreeTraversalType>
 void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType>::SearchBatch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  // Reordering a tiny query set cannot pay for the extra copy.
+  if (querySet.n_cols < 2)
+  {
+    Search(querySet, k, neighbors, distances);
+    return;
+  }
+
+  // Grow a bound around the query set, so each dimension can be normalized
+  // before quantization.
+  bound::HRectBound<MetricType, typename MatType::elem_type> bound(
+      querySet.n_rows);
+  bound |= querySet;
+
+  // Compute the Morton code of every query point.
+  arma::Col<uint64_t> codes(querySet.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    codes[i] = MortonCode(querySet.col(i), bound);
+
+  // Sort the query points along the curve; queryMap[i] holds the original
+  // index of sorted query i.
+  std::vector<size_t> queryMap(querySet.n_cols);
+  for (size_t i = 0; i < queryMap.size(); ++i)
+    queryMap[i] = i;
+  std::stable_sort(queryMap.begin(), queryMap.end(),
+      [&codes](const size_t a, const size_t b) { return codes[a] < codes[b]; });
+
+  MatType sortedQuerySet(querySet.n_rows, querySet.n_cols);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    sortedQuerySet.col(i) = querySet.col(queryMap[i]);
+
+  // Search with the reordered queries, then put the columns back in the
+  // caller's order.  Search() already maps neighbor indices back to the
+  // original reference set, so only the query order needs unmapping.
+  arma::Mat<size_t> sortedNeighbors;
+  arma::mat sortedDistances;
+  Search(sortedQuerySet, k, sortedNeighbors, sortedDistances);
+
+  UnmapQueries(sortedNeighbors, sortedDistances, queryMap, neighbors,
+      distances);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SearchTree(
     Tree& queryTree,
     const size_t k,
     arma::Mat<size_t>& neighbors,
     arma::mat& distances,
-    bool sameSet)
+    SearchStats& stats,
+    bool sameSet) const
 {
+  util::ProfileRegion profile("neighbor_search_traversal");
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -611,8 +981,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     throw std::invalid_argument("cannot call NeighborSearch::Search() with a "
         "query tree when naive or singleMode are set to true");
 
-  baseCases = 0;
-  scores = 0;
+  stats.baseCases = 0;
+  stats.scores = 0;
+  stats.prunes = 0;
+  stats.traversalTime = std::chrono::microseconds(0);
 
   // Get a reference to the query set.
   const MatType& querySet = queryTree.Dataset();
@@ -627,16 +999,34 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   neighborPtr->set_size(k, querySet.n_cols);
   distances.set_size(k, querySet.n_cols);
 
+  // If two-tier low-precision pruning was requested, build the 16-bit
+  // compressed copy of the reference set (Euclidean metric only).
+  QuantizedReferenceSet<MatType> quantizedSet;
+  const QuantizedReferenceSet<MatType>* quantizedPtr = NULL;
+  if (lowPrecisionPrune &&
+      std::is_same<MetricType, metric::EuclideanDistance>::value)
+  {
+    quantizedSet = QuantizedReferenceSet<MatType>(*referenceSet);
+    quantizedPtr = &quantizedSet;
+  }
+
   // Create the helper object for the traversal.
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, querySet, k, metric, epsilon, sameSet);
+  RuleType rules(*referenceSet, querySet, k, metric, epsilon, sameSet,
+      quantizedPtr);
 
   // Create the traverser.
   DualTreeTraversalType<RuleType> traverser(rules);
+
+  const std::chrono::steady_clock::time_point traversalStart =
+      std::chrono::steady_clock::now();
   traverser.Traverse(queryTree, *referenceTree);
+  stats.traversalTime += std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - traversalStart);
 
-  scores += rules.Scores();
-  baseCases += rules.BaseCases();
+  stats.scores += rules.Scores();
+  stats.baseCases += rules.BaseCases();
+  stats.prunes += traverser.NumPrunes();
 
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
@@ -672,11 +1062,13 @@ template<typename SortPolicy,
          template<typename> class DualTreeTraversalType,
          template<typename> class SingleTreeTraversalType>
 void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType>::SearchTree(
     const size_t k,
     arma::Mat<size_t>& neighbors,
     arma::mat& distances)
 {
+  util::ProfileRegion profile("neighbor_search_traversal");
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -695,6 +1087,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   baseCases = 0;
   scores = 0;
+  size_t prunes = 0;
 
   arma::Mat<size_t>* neighborPtr = &neighbors;
   arma::mat* distancePtr = &distances;
@@ -711,10 +1104,27 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   neighborPtr->set_size(k, referenceSet->n_cols);
   distancePtr->set_size(k, referenceSet->n_cols);
 
+  // If two-tier low-precision pruning was requested, build the 16-bit
+  // compressed copy of the reference set (Euclidean metric only).  All four
+  // search modes below evaluate base cases through the rules, so they all
+  // benefit from the prune.
+  QuantizedReferenceSet<MatType> quantizedSet;
+  const QuantizedReferenceSet<MatType>* quantizedPtr = NULL;
+  if (lowPrecisionPrune &&
+      std::is_same<MetricType, metric::EuclideanDistance>::value)
+  {
+    quantizedSet = QuantizedReferenceSet<MatType>(*referenceSet);
+    quantizedPtr = &quantizedSet;
+  }
+
   // Create the helper object for the traversal.
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
   RuleType rules(*referenceSet, *referenceSet, k, metric, epsilon,
-      true /* don't return the same point as nearest neighbor */);
+      true /* don't return the same point as nearest neighbor */,
+      quantizedPtr);
+
+  const std::chrono::steady_clock::time_point traversalStart =
+      std::chrono::steady_clock::now();
 
   switch (searchMode)
   {
@@ -739,6 +1149,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      prunes += traverser.NumPrunes();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -787,6 +1198,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      prunes += traverser.NumPrunes();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -802,12 +1214,17 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Create the traverser.
       tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Have it traverse with all points as one batch; the batch splits at
+      // each node by which child each point prefers, so each tree node is
+      // fetched once per batch instead of once per point.
+      std::vector<size_t> batch(referenceSet->n_cols);
+      for (size_t i = 0; i < batch.size(); ++i)
+        batch[i] = i;
+      traverser.Traverse(batch, *referenceTree);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      prunes += traverser.NumPrunes();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -817,6 +1234,14 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
   }
 
+  // Record the full counters of this search for LastSearchStats().
+  lastStats.baseCases = baseCases;
+  lastStats.scores = scores;
+  lastStats.prunes = prunes;
+  lastStats.traversalTime =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - traversalStart);
+
   rules.GetResults(*neighborPtr, *distancePtr);
 
   // Do we need to map the reference indices?
@@ -843,6 +1268,400 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  // Delegate to the const implementation, then store the work counters so
+  // that BaseCases(), Scores(), and LastSearchStats() report this search.
+  SearchStats stats;
+  Search(querySet, k, neighbors, distances, stats);
+  baseCases = stats.baseCases;
+  scores = stats.scores;
+  lastStats = stats;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    SearchStats& stats) const
+{
+  // Without pending incremental updates, the tree results are the results.
+  if (deltaSet.n_cols == 0 && deletedPoints.empty())
+  {
+    SearchTree(querySet, k, neighbors, distances, stats);
+    return;
+  }
+
+  const size_t liveCount =
+      referenceSet->n_cols + deltaSet.n_cols - deletedPoints.size();
+  if (k > liveCount)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << liveCount << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Ask the tree for extra candidates so that lazily deleted points can be
+  // filtered out of the results afterwards.
+  const size_t kTree = std::min(k + deletedPoints.size(),
+      (size_t) referenceSet->n_cols);
+  arma::Mat<size_t> treeNeighbors;
+  arma::mat treeDistances;
+  if (kTree > 0)
+    SearchTree(querySet, kTree, treeNeighbors, treeDistances, stats);
+
+  MergeDeltaResults(querySet, k, treeNeighbors, treeDistances, neighbors,
+      distances);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    Tree& queryTree,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    bool sameSet)
+{
+  // Delegate to the const implementation, then store the work counters so
+  // that BaseCases(), Scores(), and LastSearchStats() report this search.
+  SearchStats stats;
+  Search(queryTree, k, neighbors, distances, stats, sameSet);
+  baseCases = stats.baseCases;
+  scores = stats.scores;
+  lastStats = stats;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    Tree& queryTree,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    SearchStats& stats,
+    const bool sameSet) const
+{
+  if (deltaSet.n_cols == 0 && deletedPoints.empty())
+  {
+    SearchTree(queryTree, k, neighbors, distances, stats, sameSet);
+    return;
+  }
+
+  const size_t liveCount =
+      referenceSet->n_cols + deltaSet.n_cols - deletedPoints.size();
+  if (k > liveCount)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << liveCount << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t kTree = std::min(k + deletedPoints.size(),
+      (size_t) referenceSet->n_cols);
+  arma::Mat<size_t> treeNeighbors;
+  arma::mat treeDistances;
+  if (kTree > 0)
+    SearchTree(queryTree, kTree, treeNeighbors, treeDistances, stats, sameSet);
+
+  // Result columns follow the order of the query tree's dataset, so that is
+  // what we brute-force the delta set against.
+  MergeDeltaResults(queryTree.Dataset(), k, treeNeighbors, treeDistances,
+      neighbors, distances);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (deltaSet.n_cols == 0 && deletedPoints.empty())
+  {
+    SearchTree(k, neighbors, distances);
+    return;
+  }
+
+  const size_t liveCount =
+      referenceSet->n_cols + deltaSet.n_cols - deletedPoints.size();
+  if (k >= liveCount)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than or equal to the "
+        << "number of points in the reference set (" << liveCount << ") and "
+        << "no query set has been provided.";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // The monochromatic search already excludes the query point itself, so the
+  // tree can return at most n_cols - 1 candidates.
+  const size_t kTree = (referenceSet->n_cols <= 1) ? 0 :
+      std::min(k + deletedPoints.size(), (size_t) referenceSet->n_cols - 1);
+  arma::Mat<size_t> treeNeighbors;
+  arma::mat treeDistances;
+  if (kTree > 0)
+    SearchTree(kTree, treeNeighbors, treeDistances);
+
+  // The tree results come back in the original reference point ordering, but
+  // the reference set may have been rearranged during tree building; undo the
+  // permutation so that query columns line up with result columns.
+  const MatType* queryPtr = referenceSet;
+  MatType unmappedQueries;
+  if (!oldFromNewReferences.empty() &&
+      tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    unmappedQueries.set_size(referenceSet->n_rows, referenceSet->n_cols);
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      unmappedQueries.col(oldFromNewReferences[i]) = referenceSet->col(i);
+    queryPtr = &unmappedQueries;
+  }
+
+  MergeDeltaResults(*queryPtr, k, treeNeighbors, treeDistances, neighbors,
+      distances);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Insert(const MatType& points)
+{
+  if (points.n_cols == 0)
+    return;
+
+  if (points.n_rows != referenceSet->n_rows)
+  {
+    std::stringstream ss;
+    ss << "Dimensionality of inserted points (" << points.n_rows << ") does "
+        << "not match the dimensionality of the reference set ("
+        << referenceSet->n_rows << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (deltaSet.n_cols == 0)
+    deltaSet = points;
+  else
+    deltaSet = arma::join_rows(deltaSet, points);
+
+  MaybeRebuildIndex();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Delete(const size_t index)
+{
+  if (index >= referenceSet->n_cols + deltaSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested deletion of point " << index << ", but the reference set "
+        << "only has " << (referenceSet->n_cols + deltaSet.n_cols)
+        << " points";
+    throw std::invalid_argument(ss.str());
+  }
+
+  deletedPoints.insert(index);
+  MaybeRebuildIndex();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::MaybeRebuildIndex()
+{
+  if ((double) (deltaSet.n_cols + deletedPoints.size()) >
+      rebuildThreshold * referenceSet->n_cols)
+    RebuildIndex();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::RebuildIndex()
+{
+  if (deltaSet.n_cols == 0 && deletedPoints.empty())
+    return; // Nothing pending.
+
+  const size_t oldSize = referenceSet->n_cols;
+  MatType newSet(referenceSet->n_rows,
+      oldSize + deltaSet.n_cols - deletedPoints.size());
+
+  // Keep the reference points that have not been lazily deleted.  Deleted
+  // indices refer to the original point ordering, so map through the
+  // permutation if the tree rearranged the dataset.
+  size_t c = 0;
+  for (size_t i = 0; i < oldSize; ++i)
+  {
+    const size_t oldIndex = (!oldFromNewReferences.empty() &&
+        tree::TreeTraits<Tree>::RearrangesDataset) ?
+        oldFromNewReferences[i] : i;
+    if (deletedPoints.count(oldIndex) == 0)
+      newSet.col(c++) = referenceSet->col(i);
+  }
+
+  // Then append the pending inserted points that are still alive.
+  for (size_t j = 0; j < deltaSet.n_cols; ++j)
+    if (deletedPoints.count(oldSize + j) == 0)
+      newSet.col(c++) = deltaSet.col(j);
+
+  deltaSet.reset();
+  deletedPoints.clear();
+
+  Train(std::move(newSet));
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::MergeDeltaResults(
+    const MatType& querySet,
+    const size_t k,
+    const arma::Mat<size_t>& treeNeighbors,
+    const arma::mat& treeDistances,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances) const
+{
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Gather the pending inserted points that have not themselves been deleted.
+  std::vector<size_t> liveDelta;
+  for (size_t j = 0; j < deltaSet.n_cols; ++j)
+    if (deletedPoints.count(referenceSet->n_cols + j) == 0)
+      liveDelta.push_back(j);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    // Brute-force distances to the live delta points, ordered best-first.
+    std::vector<std::pair<double, size_t>> deltaResults(liveDelta.size());
+    for (size_t j = 0; j < liveDelta.size(); ++j)
+    {
+      deltaResults[j] = std::make_pair(
+          metric.Evaluate(querySet.col(i), deltaSet.col(liveDelta[j])),
+          referenceSet->n_cols + liveDelta[j]);
+    }
+    // IsBetter() is not a strict ordering, so make it one for std::sort().
+    std::sort(deltaResults.begin(), deltaResults.end(),
+        [](const std::pair<double, size_t>& a,
+           const std::pair<double, size_t>& b)
+        {
+          return SortPolicy::IsBetter(a.first, b.first) &&
+              !SortPolicy::IsBetter(b.first, a.first);
+        });
+
+    // Two-way merge of the tree results and the delta results, skipping any
+    // lazily deleted tree candidates.
+    size_t t = 0, d = 0;
+    for (size_t r = 0; r < k; ++r)
+    {
+      while (t < treeNeighbors.n_rows &&
+          deletedPoints.count(treeNeighbors(t, i)) > 0)
+        ++t;
+
+      const bool haveTree = (t < treeNeighbors.n_rows) &&
+          (treeDistances(t, i) != SortPolicy::WorstDistance());
+      const bool haveDelta = (d < deltaResults.size());
+
+      if (haveTree && (!haveDelta ||
+          SortPolicy::IsBetter(treeDistances(t, i), deltaResults[d].first)))
+      {
+        neighbors(r, i) = treeNeighbors(t, i);
+        distances(r, i) = treeDistances(t, i);
+        ++t;
+      }
+      else if (haveDelta)
+      {
+        neighbors(r, i) = deltaResults[d].second;
+        distances(r, i) = deltaResults[d].first;
+        ++d;
+      }
+      else
+      {
+        // Not enough live candidates; pad the results.
+        neighbors(r, i) = (size_t) -1;
+        distances(r, i) = SortPolicy::WorstDistance();
+      }
+    }
+  }
+}
+
 //! Calculate the average relative error.
 template<typename SortPolicy,
          typename MetricType,
@@ -973,6 +1792,15 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
     }
   }
 
+  // Serialize the pending incremental updates.
+  ar(CEREAL_NVP(deltaSet));
+  ar(CEREAL_NVP(rebuildThreshold));
+  std::vector<size_t> deletedList(deletedPoints.begin(), deletedPoints.end());
+  ar(CEREAL_NVP(deletedList));
+  if (cereal::is_loading<Archive>())
+    deletedPoints = std::unordered_set<size_t>(deletedList.begin(),
+        deletedList.end());
+
   // Reset base cases and scores.
   if (cereal::is_loading<Archive>())
   {
@@ -15,6 +15,8 @@
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include "quantized_reference_set.hpp"
+
 #include <queue>
 
 namespace mlpack {
@@ -46,13 +48,21 @@ class NeighborSearchRules
    * @param epsilon Relative approximate error.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   * @param quantizedSet If non-NULL, a 16-bit compressed copy of the
+   *      reference set; BaseCase() will score candidates against it first and
+   *      skip the full-precision evaluation for those whose quantized
+   *      distance, adjusted by the quantization error bound, cannot enter the
+   *      candidate list.  The caller must only pass this for the Euclidean
+   *      metric, and retains ownership.
    */
   NeighborSearchRules(const typename TreeType::Mat& referenceSet,
                       const typename TreeType::Mat& querySet,
                       const size_t k,
                       MetricType& metric,
                       const double epsilon = 0,
-                      const bool sameSet = false);
+                      const bool sameSet = false,
+                      const QuantizedReferenceSet<typename TreeType::Mat>*
+                          quantizedSet = NULL);
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -192,6 +202,10 @@ class NeighborSearchRules
   //! The instantiated metric.
   MetricType& metric;
 
+  //! Compressed copy of the reference set for two-tier base case evaluation,
+  //! or NULL if two-tier evaluation is not in use.  Not owned by us.
+  const QuantizedReferenceSet<typename TreeType::Mat>* quantizedSet;
+
   //! Denotes whether or not the reference and query sets are the same.
   bool sameSet;
 
@@ -26,11 +26,13 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     const size_t k,
     MetricType& metric,
     const double epsilon,
-    const bool sameSet) :
+    const bool sameSet,
+    const QuantizedReferenceSet<typename TreeType::Mat>* quantizedSet) :
     referenceSet(referenceSet),
     querySet(querySet),
     k(k),
     metric(metric),
+    quantizedSet(quantizedSet),
     sameSet(sameSet),
     epsilon(epsilon),
     lastQueryIndex(querySet.n_cols),
@@ -93,6 +95,35 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return lastBaseCase;
 
+  // Two-tier evaluation: if a compressed copy of the reference set is
+  // available, score the candidate against it first.  The quantized distance
+  // is within MaxError() of the true distance, so if even the most favorable
+  // true distance could not displace the current k-th best candidate, the
+  // full-precision evaluation can be skipped without affecting the results.
+  if (quantizedSet != NULL)
+  {
+    const double approx = quantizedSet->Distance(querySet.col(queryIndex),
+        referenceIndex);
+    const double error = quantizedSet->MaxError();
+    const double kthBest = candidates[queryIndex].top().first;
+    if (!SortPolicy::IsBetter(approx - error, kthBest) &&
+        !SortPolicy::IsBetter(approx + error, kthBest))
+    {
+      ++baseCases;
+
+      // Cache and return the favorable end of the error interval; as an
+      // optimistic estimate it keeps any pruning done with the return value
+      // valid.
+      const double estimate = SortPolicy::IsBetter(approx - error,
+          approx + error) ? approx - error : approx + error;
+      lastQueryIndex = queryIndex;
+      lastReferenceIndex = referenceIndex;
+      lastBaseCase = estimate;
+
+      return estimate;
+    }
+  }
+
   double distance = metric.Evaluate(querySet.col(queryIndex),
                                     referenceSet.col(referenceIndex));
   ++baseCases;
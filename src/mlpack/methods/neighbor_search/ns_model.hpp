@@ -22,6 +22,7 @@
 #include <mlpack/core/tree/spill_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
 #include "neighbor_search.hpp"
+#include "sw_graph.hpp"
 
 namespace mlpack {
 namespace neighbor {
@@ -59,6 +60,10 @@ class NSWrapperBase
   //! Modify the approximation parameter epsilon.
   virtual double& Epsilon() = 0;
 
+  //! Get the work counters of the last search performed through a timed
+  //! (non-const) Search() overload.
+  virtual const SearchStats& LastSearchStats() const = 0;
+
   //! Train the NeighborSearch model with the given parameters.
   virtual void Train(util::Timers& timers,
                      arma::mat&& referenceSet,
@@ -76,6 +81,18 @@ class NSWrapperBase
                       const size_t leafSize,
                       const double rho) = 0;
 
+  //! Perform bichromatic neighbor search without modifying the model.  This
+  //! is the thread-safe prediction path (see NSModel::Search() for the exact
+  //! guarantee); work counters are reported through the given SearchStats
+  //! object instead of being stored on the model, and no timers are updated.
+  virtual void Search(arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t leafSize,
+                      const double rho,
+                      SearchStats& stats) const = 0;
+
   //! Perform monochromatic neighbor search (i.e. use the reference set as the
   //! query set).
   virtual void Search(util::Timers& timers,
@@ -131,6 +148,9 @@ class NSWrapper : public NSWrapperBase
   //! Modify epsilon, the approximation parameter.
   double& Epsilon() { return ns.Epsilon(); }
 
+  //! Get the work counters of the last timed search.
+  const SearchStats& LastSearchStats() const { return ns.LastSearchStats(); }
+
   //! Train the model with the given options.  For NSWrapper, we ignore the
   //! extra parameters.
   virtual void Train(util::Timers& timers,
@@ -149,6 +169,16 @@ class NSWrapper : public NSWrapperBase
                       const size_t /* leafSize */,
                       const double /* rho */);
 
+  //! Perform bichromatic neighbor search without modifying the model.  For
+  //! NSWrapper, we ignore the extra parameters.
+  virtual void Search(arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t /* leafSize */,
+                      const double /* rho */,
+                      SearchStats& stats) const;
+
   //! Perform monochromatic neighbor search (i.e. use the reference set as the
   //! query set).
   virtual void Search(util::Timers& timers,
@@ -239,6 +269,87 @@ class LeafSizeNSWrapper :
                       const size_t leafSize,
                       const double /* rho */);
 
+  //! Perform bichromatic search without modifying the model.  This overload
+  //! uses the leaf size, but ignores the other parameters.
+  virtual void Search(arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t leafSize,
+                      const double /* rho */,
+                      SearchStats& stats) const;
+
+  //! Serialize the NeighborSearch model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(ns));
+  }
+
+ protected:
+  using NSWrapper<SortPolicy,
+                  TreeType,
+                  DualTreeTraversalType,
+                  SingleTreeTraversalType>::ns;
+};
+
+/**
+ * BulkLoadNSWrapper wraps the NeighborSearch types built on rectangle trees
+ * that support sort-tile-recursive bulk loading (RTree and RStarTree).  When
+ * bulk loading is enabled, Train() packs the tree directly from the dataset
+ * instead of inserting the points one at a time.
+ */
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename RuleType> class DualTreeTraversalType =
+             TreeType<metric::EuclideanDistance,
+                      NeighborSearchStat<SortPolicy>,
+                      arma::mat>::template DualTreeTraverser,
+         template<typename RuleType> class SingleTreeTraversalType =
+             TreeType<metric::EuclideanDistance,
+                      NeighborSearchStat<SortPolicy>,
+                      arma::mat>::template SingleTreeTraverser>
+class BulkLoadNSWrapper :
+    public NSWrapper<SortPolicy,
+                     TreeType,
+                     DualTreeTraversalType,
+                     SingleTreeTraversalType>
+{
+ public:
+  //! Construct the BulkLoadNSWrapper by delegating to the NSWrapper
+  //! constructor.
+  BulkLoadNSWrapper(const NeighborSearchMode searchMode,
+                    const double epsilon,
+                    const bool bulkLoad) :
+      NSWrapper<SortPolicy,
+                TreeType,
+                DualTreeTraversalType,
+                SingleTreeTraversalType>(searchMode, epsilon),
+      bulkLoad(bulkLoad)
+  {
+    // Nothing to do.
+  }
+
+  //! Delete the BulkLoadNSWrapper.
+  virtual ~BulkLoadNSWrapper() { }
+
+  //! Return a copy of the BulkLoadNSWrapper.
+  virtual BulkLoadNSWrapper* Clone() const
+  {
+    return new BulkLoadNSWrapper(*this);
+  }
+
+  //! Train a model with the given parameters.  If bulk loading is enabled,
+  //! the tree is packed directly from the reference set; the extra parameters
+  //! are ignored either way.
+  virtual void Train(util::Timers& timers,
+                     arma::mat&& referenceSet,
+                     const size_t /* leafSize */,
+                     const double /* tau */,
+                     const double /* rho */);
+
   //! Serialize the NeighborSearch model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -251,6 +362,9 @@ class LeafSizeNSWrapper :
                   TreeType,
                   DualTreeTraversalType,
                   SingleTreeTraversalType>::ns;
+
+  //! Whether Train() should bulk-load the tree.
+  bool bulkLoad;
 };
 
 /**
@@ -310,6 +424,16 @@ class SpillNSWrapper :
                       const size_t leafSize,
                       const double rho);
 
+  //! Perform bichromatic search without modifying the model, using the given
+  //! parameters.
+  virtual void Search(arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t leafSize,
+                      const double rho,
+                      SearchStats& stats) const;
+
   //! Serialize the NeighborSearch model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -329,6 +453,106 @@ class SpillNSWrapper :
                    arma::mat>::template DefeatistSingleTreeTraverser>::ns;
 };
 
+/**
+ * The GraphNSWrapper class wraps the SWGraph small-world graph index so that
+ * it can be selected through NSModel like the tree-based strategies.  The
+ * index is approximate and ignores the search mode (queries always use beam
+ * search), and the leaf size parameter is reused as the maximum node degree
+ * of the graph.
+ */
+template<typename SortPolicy>
+class GraphNSWrapper : public NSWrapperBase
+{
+ public:
+  //! Construct the GraphNSWrapper.
+  GraphNSWrapper(const NeighborSearchMode searchMode,
+                 const double epsilon) :
+      searchMode(searchMode),
+      epsilon(epsilon)
+  {
+    // Nothing to do.
+  }
+
+  //! Destruct the GraphNSWrapper.
+  virtual ~GraphNSWrapper() { }
+
+  //! Return a copy of the GraphNSWrapper.
+  virtual GraphNSWrapper* Clone() const { return new GraphNSWrapper(*this); }
+
+  //! Get a reference to the reference set.
+  const arma::mat& Dataset() const { return graph.ReferenceSet(); }
+
+  //! Get the search mode.  (The graph index ignores it.)
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode.
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Get epsilon, the approximation parameter.  (The graph index ignores it;
+  //! approximation is controlled by the beam width instead.)
+  double Epsilon() const { return epsilon; }
+  //! Modify epsilon, the approximation parameter.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the work counters of the last timed search.  (The graph index does
+  //! not count work, so these are always zero.)
+  const SearchStats& LastSearchStats() const { return stats; }
+
+  //! Build the graph index; the leaf size is reused as the maximum node
+  //! degree, and tau and rho are ignored.
+  virtual void Train(util::Timers& timers,
+                     arma::mat&& referenceSet,
+                     const size_t leafSize,
+                     const double /* tau */,
+                     const double /* rho */);
+
+  //! Perform bichromatic neighbor search (i.e. search with a separate query
+  //! set).  The extra parameters are ignored.
+  virtual void Search(util::Timers& timers,
+                      arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t /* leafSize */,
+                      const double /* rho */);
+
+  //! Perform bichromatic neighbor search without modifying the model.  The
+  //! extra parameters are ignored, and the graph index does not count work,
+  //! so the given SearchStats object is left zeroed.
+  virtual void Search(arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t /* leafSize */,
+                      const double /* rho */,
+                      SearchStats& stats) const;
+
+  //! Perform monochromatic neighbor search (i.e. use the reference set as the
+  //! query set).
+  virtual void Search(util::Timers& timers,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances);
+
+  //! Serialize the graph index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(searchMode));
+    ar(CEREAL_NVP(epsilon));
+    ar(CEREAL_NVP(graph));
+  }
+
+ protected:
+  //! The instantiated graph index that we are wrapping.
+  SWGraph<SortPolicy> graph;
+  //! The search mode (held only to satisfy the NSWrapperBase interface).
+  NeighborSearchMode searchMode;
+  //! The approximation parameter (also unused by the graph index).
+  double epsilon;
+  //! Work counters (always zero; the graph index does not count work).
+  SearchStats stats;
+};
+
 /**
  * The NSModel class provides an easy way to serialize a model, abstracts away
  * the different types of trees, and also reflects the NeighborSearch API.  This
@@ -337,6 +561,13 @@ class SpillNSWrapper :
  * flexibility as the NeighborSearch class.  So if you are using it outside of
  * mlpack_knn and mlpack_kfn, be aware that it is limited!
  *
+ * Thread safety: a built (or deserialized) model may be searched from many
+ * threads at once through the const Search() overload (the one taking a
+ * SearchStats object), so a service can serve one loaded model from a thread
+ * pool instead of keeping a copy per worker.  The non-const members---
+ * BuildModel(), AutoTune(), the timed Search() overloads, and the non-const
+ * accessors---must not run concurrently with anything else on the same model.
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
  */
 template<typename SortPolicy>
@@ -360,7 +591,8 @@ class NSModel
     MAX_RP_TREE,
     SPILL_TREE,
     UB_TREE,
-    OCTREE
+    OCTREE,
+    SW_GRAPH
   };
 
  private:
@@ -375,6 +607,9 @@ class NSModel
   size_t leafSize;
   double tau;
   double rho;
+  //! If true, R trees and R* trees are bulk-loaded (STR-packed) instead of
+  //! built by insertion.
+  bool bulkLoad;
 
   /**
    * nSearch holds an instance of the NeighborSearch class for the current
@@ -447,10 +682,17 @@ class NSModel
   double Rho() const { return rho; }
   double& Rho() { return rho; }
 
+  //! Expose BulkLoad (only used by the R tree and R* tree).
+  bool BulkLoad() const { return bulkLoad; }
+  bool& BulkLoad() { return bulkLoad; }
+
   //! Expose Epsilon.
   double Epsilon() const;
   double& Epsilon();
 
+  //! Expose the work counters of the last timed search.
+  const SearchStats& LastSearchStats() const;
+
   //! Expose treeType.
   TreeTypes TreeType() const { return treeType; }
   TreeTypes& TreeType() { return treeType; }
@@ -469,6 +711,36 @@ class NSModel
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
+  /**
+   * Automatically choose the tree type and leaf size, then build the reference
+   * tree.  Candidate configurations are evaluated by building a tree on a
+   * random sample of the reference set and timing probe queries against it;
+   * the fastest configuration is then used to build the full model.  The
+   * chosen configuration is reflected by TreeType() and LeafSize().
+   *
+   * The kd-tree and ball tree are considered at several leaf sizes; the spill
+   * tree (whose defeatist search is approximate) is only considered when
+   * epsilon is nonzero.  For NAIVE_MODE there is nothing to tune, so this is
+   * equivalent to BuildModel().
+   *
+   * @param timers Timers for the model.
+   * @param referenceSet The reference set to build the model on.
+   * @param searchMode The mode that will be used for searching.
+   * @param k Number of neighbors that will be searched for, used for the
+   *      probe queries.
+   * @param epsilon Allowed relative error for approximate search.
+   * @param sampleSize Number of sampled reference points to build candidate
+   *      trees on.
+   * @param numProbes Number of probe queries used to time each candidate.
+   */
+  void AutoTune(util::Timers& timers,
+                arma::mat&& referenceSet,
+                const NeighborSearchMode searchMode,
+                const size_t k,
+                const double epsilon = 0,
+                const size_t sampleSize = 2000,
+                const size_t numProbes = 200);
+
   //! Perform neighbor search.  The query set will be reordered.
   void Search(util::Timers& timers,
               arma::mat&& querySet,
@@ -476,6 +748,26 @@ class NSModel
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Perform neighbor search without modifying the model; this is safe to call
+   * concurrently from many threads on one model (see the class documentation).
+   * No timers are updated, no informational output is logged, and the work
+   * counters of the search are written to the given SearchStats object.  The
+   * query set will be reordered.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   * @param stats Object the work counters of this search are written to.
+   */
+  void Search(arma::mat&& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              SearchStats& stats) const;
+
   //! Perform monochromatic neighbor search.
   void Search(util::Timers& timers,
               const size_t k,
@@ -83,6 +83,37 @@ void NSWrapper<
   }
 }
 
+//! Perform bichromatic neighbor search without modifying the model.  For
+//! NSWrapper, we ignore the extra parameters.
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType>
+void NSWrapper<
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+>::Search(arma::mat&& querySet,
+          const size_t k,
+          arma::Mat<size_t>& neighbors,
+          arma::mat& distances,
+          const size_t /* leafSize */,
+          const double /* rho */,
+          SearchStats& stats) const
+{
+  if (ns.SearchMode() == DUAL_TREE_MODE)
+  {
+    // Each search builds its own query tree, since the traversal writes
+    // pruning bounds into the query tree's statistics.
+    typename NSType::Tree queryTree(std::move(querySet));
+    ns.Search(queryTree, k, neighbors, distances, stats);
+  }
+  else
+  {
+    ns.Search(querySet, k, neighbors, distances, stats);
+  }
+}
+
 //! Perform monochromatic neighbor search (i.e. use the reference set as the
 //! query set).
 template<typename SortPolicy,
@@ -189,6 +220,87 @@ void LeafSizeNSWrapper<
   }
 }
 
+//! Perform bichromatic search without modifying the model.  This overload
+//! uses the leaf size, but ignores the other parameters.
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType>
+void LeafSizeNSWrapper<
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+>::Search(arma::mat&& querySet,
+          const size_t k,
+          arma::Mat<size_t>& neighbors,
+          arma::mat& distances,
+          const size_t leafSize,
+          const double /* rho */,
+          SearchStats& stats) const
+{
+  if (ns.SearchMode() == DUAL_TREE_MODE)
+  {
+    // As in the timed overload, we build the query tree ourselves so that the
+    // leaf size is honored, and therefore we must also unmap the query points
+    // ourselves.  The query tree is local to this call, so concurrent
+    // searches do not share any tree statistics.
+    std::vector<size_t> oldFromNewQueries;
+    typename decltype(ns)::Tree queryTree(std::move(querySet),
+        oldFromNewQueries, leafSize);
+
+    arma::Mat<size_t> neighborsOut;
+    arma::mat distancesOut;
+    ns.Search(queryTree, k, neighborsOut, distancesOut, stats);
+
+    // Unmap the query points.
+    distances.set_size(distancesOut.n_rows, distancesOut.n_cols);
+    neighbors.set_size(neighborsOut.n_rows, neighborsOut.n_cols);
+    for (size_t i = 0; i < neighborsOut.n_cols; ++i)
+    {
+      neighbors.col(oldFromNewQueries[i]) = neighborsOut.col(i);
+      distances.col(oldFromNewQueries[i]) = distancesOut.col(i);
+    }
+  }
+  else
+  {
+    ns.Search(querySet, k, neighbors, distances, stats);
+  }
+}
+
+//! Train a model with the given parameters.  If bulk loading is enabled, the
+//! tree is packed directly from the reference set.
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType>
+void BulkLoadNSWrapper<
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+>::Train(util::Timers& timers,
+         arma::mat&& referenceSet,
+         const size_t /* leafSize */,
+         const double /* tau */,
+         const double /* rho */)
+{
+  if (!bulkLoad || ns.SearchMode() == NAIVE_MODE)
+  {
+    ns.Train(std::move(referenceSet));
+  }
+  else
+  {
+    // Pack the tree directly from the reference set with a
+    // sort-tile-recursive bulk load.  Rectangle trees do not rearrange the
+    // dataset, so no mappings need to be handled.  The first five parameters
+    // are the constructor's defaults.
+    timers.Start("tree_building");
+    typename decltype(ns)::Tree referenceTree(std::move(referenceSet),
+        20, 8, 5, 2, 0, true);
+    ns.Train(std::move(referenceTree));
+    timers.Stop("tree_building");
+  }
+}
+
 //! Train the model using the given parameters.
 template<typename SortPolicy>
 void SpillNSWrapper<SortPolicy>::Train(util::Timers& timers,
@@ -237,6 +349,86 @@ void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
   }
 }
 
+//! Perform bichromatic search without modifying the model, using the given
+//! parameters.
+template<typename SortPolicy>
+void SpillNSWrapper<SortPolicy>::Search(arma::mat&& querySet,
+                                        const size_t k,
+                                        arma::Mat<size_t>& neighbors,
+                                        arma::mat& distances,
+                                        const size_t leafSize,
+                                        const double rho,
+                                        SearchStats& stats) const
+{
+  if (ns.SearchMode() == DUAL_TREE_MODE)
+  {
+    // For Dual Tree Search on SpillTrees, the queryTree must be built with
+    // non overlapping (tau = 0).
+    typename decltype(ns)::Tree queryTree(std::move(querySet), 0 /* tau */,
+        leafSize, rho);
+    ns.Search(queryTree, k, neighbors, distances, stats);
+  }
+  else
+  {
+    ns.Search(querySet, k, neighbors, distances, stats);
+  }
+}
+
+template<typename SortPolicy>
+void GraphNSWrapper<SortPolicy>::Train(util::Timers& timers,
+                                       arma::mat&& referenceSet,
+                                       const size_t leafSize,
+                                       const double /* tau */,
+                                       const double /* rho */)
+{
+  // Reuse the leaf size as the maximum node degree of the graph.
+  if (leafSize > 1)
+    graph.MaxNeighbors() = leafSize;
+
+  timers.Start("graph_building");
+  graph.Train(std::move(referenceSet));
+  timers.Stop("graph_building");
+}
+
+template<typename SortPolicy>
+void GraphNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                        arma::mat&& querySet,
+                                        const size_t k,
+                                        arma::Mat<size_t>& neighbors,
+                                        arma::mat& distances,
+                                        const size_t /* leafSize */,
+                                        const double /* rho */)
+{
+  timers.Start("computing_neighbors");
+  graph.Search(querySet, k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Perform bichromatic neighbor search without modifying the model.  The
+//! graph index does not count work, so the SearchStats object stays zeroed.
+template<typename SortPolicy>
+void GraphNSWrapper<SortPolicy>::Search(arma::mat&& querySet,
+                                        const size_t k,
+                                        arma::Mat<size_t>& neighbors,
+                                        arma::mat& distances,
+                                        const size_t /* leafSize */,
+                                        const double /* rho */,
+                                        SearchStats& /* stats */) const
+{
+  graph.Search(querySet, k, neighbors, distances);
+}
+
+template<typename SortPolicy>
+void GraphNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                        const size_t k,
+                                        arma::Mat<size_t>& neighbors,
+                                        arma::mat& distances)
+{
+  timers.Start("computing_neighbors");
+  graph.Search(k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
 /**
  * Initialize the NSModel with the given type and whether or not a random
  * basis should be used.
@@ -248,6 +440,7 @@ NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
     leafSize(20),
     tau(0.0),
     rho(0.7),
+    bulkLoad(false),
     nSearch(NULL)
 {
   // Nothing to do.
@@ -261,6 +454,7 @@ NSModel<SortPolicy>::NSModel(const NSModel& other) :
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    bulkLoad(other.bulkLoad),
     nSearch(other.nSearch->Clone())
 {
   // Nothing to do.
@@ -274,6 +468,7 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    bulkLoad(other.bulkLoad),
     nSearch(other.nSearch)
 {
   // Reset parameters of the other model.
@@ -282,6 +477,7 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.leafSize = 20;
   other.tau = 0.0;
   other.rho = 0.7;
+  other.bulkLoad = false;
   other.nSearch = NULL;
 }
 
@@ -298,6 +494,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
     leafSize = other.leafSize;
     tau = other.tau;
     rho = other.rho;
+    bulkLoad = other.bulkLoad;
     nSearch = other.nSearch->Clone();
   }
 
@@ -317,6 +514,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     leafSize = other.leafSize;
     tau = other.tau;
     rho = other.rho;
+    bulkLoad = other.bulkLoad;
     nSearch = other.nSearch;
 
     // Reset parameters of the other model.
@@ -325,6 +523,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     other.leafSize = 20;
     other.tau = 0.0;
     other.rho = 0.7;
+    other.bulkLoad = false;
     other.nSearch = NULL;
   }
 
@@ -349,6 +548,7 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(leafSize));
   ar(CEREAL_NVP(tau));
   ar(CEREAL_NVP(rho));
+  ar(CEREAL_NVP(bulkLoad));
 
   // This should never happen, but just in case, be clean with memory.
   if (cereal::is_loading<Archive>())
@@ -375,15 +575,17 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
       }
     case R_TREE:
       {
-        NSWrapper<SortPolicy, tree::RTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RTree>&>(*nSearch);
+        BulkLoadNSWrapper<SortPolicy, tree::RTree>& typedSearch =
+            dynamic_cast<BulkLoadNSWrapper<SortPolicy, tree::RTree>&>(
+            *nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_STAR_TREE:
       {
-        NSWrapper<SortPolicy, tree::RStarTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RStarTree>&>(*nSearch);
+        BulkLoadNSWrapper<SortPolicy, tree::RStarTree>& typedSearch =
+            dynamic_cast<BulkLoadNSWrapper<SortPolicy, tree::RStarTree>&>(
+            *nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
@@ -467,6 +669,13 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
         ar(CEREAL_NVP(typedSearch));
         break;
       }
+    case SW_GRAPH:
+      {
+        GraphNSWrapper<SortPolicy>& typedSearch =
+            dynamic_cast<GraphNSWrapper<SortPolicy>&>(*nSearch);
+        ar(CEREAL_NVP(typedSearch));
+        break;
+      }
   }
 }
 
@@ -503,6 +712,13 @@ double& NSModel<SortPolicy>::Epsilon()
   return nSearch->Epsilon();
 }
 
+//! Expose the work counters of the last timed search.
+template<typename SortPolicy>
+const SearchStats& NSModel<SortPolicy>::LastSearchStats() const
+{
+  return nSearch->LastSearchStats();
+}
+
 //! Initialize a model given the tree type.  (No training happens here.)
 template<typename SortPolicy>
 void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
@@ -523,10 +739,12 @@ void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
           epsilon);
       break;
     case R_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RTree>(searchMode, epsilon);
+      nSearch = new BulkLoadNSWrapper<SortPolicy, tree::RTree>(searchMode,
+          epsilon, bulkLoad);
       break;
     case R_STAR_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RStarTree>(searchMode, epsilon);
+      nSearch = new BulkLoadNSWrapper<SortPolicy, tree::RStarTree>(searchMode,
+          epsilon, bulkLoad);
       break;
     case BALL_TREE:
       nSearch = new LeafSizeNSWrapper<SortPolicy, tree::BallTree>(searchMode,
@@ -569,6 +787,9 @@ void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
       nSearch = new LeafSizeNSWrapper<SortPolicy, tree::Octree>(searchMode,
           epsilon);
       break;
+    case SW_GRAPH:
+      nSearch = new GraphNSWrapper<SortPolicy>(searchMode, epsilon);
+      break;
   }
 }
 
@@ -625,6 +846,93 @@ void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
     Log::Info << "Tree built." << std::endl;
 }
 
+//! Automatically choose the tree type and leaf size, then build the model.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::AutoTune(util::Timers& timers,
+                                   arma::mat&& referenceSet,
+                                   const NeighborSearchMode searchMode,
+                                   const size_t k,
+                                   const double epsilon,
+                                   const size_t sampleSize,
+                                   const size_t numProbes)
+{
+  // There is nothing to tune for brute-force search, and tiny datasets are
+  // not worth timing candidates on.
+  if (searchMode == NAIVE_MODE || referenceSet.n_cols < 10 ||
+      sampleSize == 0 || numProbes == 0)
+  {
+    BuildModel(timers, std::move(referenceSet), searchMode, epsilon);
+    return;
+  }
+
+  timers.Start("auto_tuning");
+
+  // Draw a random sample of the reference set to build candidate trees on,
+  // and a set of probe queries to time against them.
+  const size_t numSamples = std::min(sampleSize, (size_t) referenceSet.n_cols);
+  const size_t numQueries = std::min(numProbes, (size_t) referenceSet.n_cols);
+  const arma::uvec order = arma::shuffle(
+      arma::regspace<arma::uvec>(0, referenceSet.n_cols - 1));
+  const arma::mat sampleSet = referenceSet.cols(order.head(numSamples));
+  const arma::mat probeSet = referenceSet.cols(order.tail(numQueries));
+  const size_t probeK = std::min(k, numSamples);
+
+  // The kd-tree and ball tree are exact; the spill tree's defeatist search is
+  // approximate, so it only competes when approximation is already allowed.
+  std::vector<TreeTypes> candidateTrees = { KD_TREE, BALL_TREE };
+  if (epsilon > 0)
+    candidateTrees.push_back(SPILL_TREE);
+  const size_t candidateLeafSizes[4] = { 10, 20, 50, 100 };
+
+  TreeTypes bestType = treeType;
+  size_t bestLeafSize = leafSize;
+  double bestTime = DBL_MAX;
+
+  arma::wall_clock clock;
+  for (size_t t = 0; t < candidateTrees.size(); ++t)
+  {
+    for (size_t l = 0; l < 4; ++l)
+    {
+      treeType = candidateTrees[t];
+      leafSize = candidateLeafSizes[l];
+
+      // Build a small candidate tree on the sample, then time the probe
+      // queries against it.  BuildModel() and Search() take ownership of (and
+      // may reorder) their inputs, so they get copies.
+      arma::mat sampleCopy(sampleSet);
+      BuildModel(timers, std::move(sampleCopy), searchMode, epsilon);
+
+      arma::Mat<size_t> probeNeighbors;
+      arma::mat probeDistances;
+      arma::mat probeCopy(probeSet);
+      clock.tic();
+      Search(timers, std::move(probeCopy), probeK, probeNeighbors,
+          probeDistances);
+      const double queryTime = clock.toc();
+
+      Log::Info << "Auto-tune candidate " << TreeName() << " with leaf size "
+          << candidateLeafSizes[l] << ": " << queryTime << "s." << std::endl;
+
+      if (queryTime < bestTime)
+      {
+        bestTime = queryTime;
+        bestType = candidateTrees[t];
+        bestLeafSize = candidateLeafSizes[l];
+      }
+    }
+  }
+
+  treeType = bestType;
+  leafSize = bestLeafSize;
+  timers.Stop("auto_tuning");
+
+  Log::Info << "Auto-tuned configuration: " << TreeName() << " with leaf "
+      << "size " << leafSize << "." << std::endl;
+
+  // Now build the full model with the chosen configuration.
+  BuildModel(timers, std::move(referenceSet), searchMode, epsilon);
+}
+
 //! Perform neighbor search.  The query set will be reordered.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::Search(util::Timers& timers,
@@ -664,6 +972,25 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
       leafSize, rho);
 }
 
+//! Perform neighbor search without modifying the model.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::Search(arma::mat&& querySet,
+                                 const size_t k,
+                                 arma::Mat<size_t>& neighbors,
+                                 arma::mat& distances,
+                                 SearchStats& stats) const
+{
+  // We may need to map the query set randomly.  (The projection matrix is
+  // only read, and the query set is this call's own.)
+  if (randomBasis)
+    querySet = q * querySet;
+
+  // No informational logging or timing here: this path is meant to be called
+  // from several threads at once.
+  nSearch->Search(std::move(querySet), k, neighbors, distances, leafSize, rho,
+      stats);
+}
+
 //! Perform neighbor search.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::Search(util::Timers& timers,
@@ -733,6 +1060,8 @@ std::string NSModel<SortPolicy>::TreeName() const
       return "UB tree";
     case OCTREE:
       return "octree";
+    case SW_GRAPH:
+      return "small-world graph";
     default:
       return "unknown tree";
   }
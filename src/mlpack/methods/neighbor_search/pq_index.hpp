@@ -0,0 +1,134 @@
+/**
+ * @file methods/neighbor_search/pq_index.hpp
+ *
+ * Defines the PQIndex class, a product-quantization compressed index for
+ * approximate nearest neighbor search.  The reference set is split into
+ * subspaces, each subspace is vector-quantized with KMeans, and every point is
+ * stored as one 8-bit code per subspace; queries compute asymmetric distances
+ * through per-subspace lookup tables instead of full metric evaluations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The PQIndex class implements product quantization for approximate
+ * k-nearest-neighbor search under the Euclidean distance.  The dimensions of
+ * the reference set are partitioned into NumSubspaces() contiguous subspaces;
+ * a codebook of NumCodewords() centroids is trained per subspace with KMeans,
+ * and each reference point is stored only as its nearest codeword index in
+ * every subspace.  With the default 8 subspaces and 256 codewords, a
+ * 512-dimensional double-precision point shrinks from 4096 bytes to 8 bytes.
+ *
+ * Queries use asymmetric distance computation: the (uncompressed) query point
+ * is compared against every codeword of every subspace once, filling a lookup
+ * table, and the distance to each reference point is then the sum of table
+ * entries selected by its codes.  Results are approximate — quantization
+ * error both reorders near ties and biases the returned distances.
+ *
+ * The reference set itself is not stored; only the codebooks and codes are.
+ *
+ * @tparam MatType The type of data matrix.
+ */
+template<typename MatType = arma::mat>
+class PQIndex
+{
+ public:
+  /**
+   * Construct the PQIndex by training it on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numSubspaces Number of subspaces to split the dimensions into.
+   * @param numCodewords Number of codewords per subspace (at most 256).
+   * @param maxIterations Maximum number of KMeans iterations per codebook.
+   */
+  PQIndex(const MatType& referenceSet,
+          const size_t numSubspaces = 8,
+          const size_t numCodewords = 256,
+          const size_t maxIterations = 25);
+
+  /**
+   * Construct an empty PQIndex; it can be trained later with Train().
+   *
+   * @param numSubspaces Number of subspaces to split the dimensions into.
+   * @param numCodewords Number of codewords per subspace (at most 256).
+   * @param maxIterations Maximum number of KMeans iterations per codebook.
+   */
+  PQIndex(const size_t numSubspaces = 8,
+          const size_t numCodewords = 256,
+          const size_t maxIterations = 25);
+
+  /**
+   * Train the codebooks on a new reference set and encode it, replacing any
+   * previously held codes.  The reference set is only read during training;
+   * it is not retained.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(const MatType& referenceSet);
+
+  /**
+   * For each point in the query set, find the approximate k nearest neighbors
+   * among the encoded reference points, using asymmetric distance lookup
+   * tables.  Returned distances are the (approximate) Euclidean distances
+   * reconstructed from the quantized points.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  //! Get the number of encoded reference points.
+  size_t NumPoints() const { return codes.n_cols; }
+  //! Get the number of subspaces.
+  size_t NumSubspaces() const { return numSubspaces; }
+  //! Get the number of codewords per subspace.
+  size_t NumCodewords() const { return numCodewords; }
+
+  //! Access the trained codebook of the given subspace (one codeword per
+  //! column).
+  const arma::mat& Codebook(const size_t subspace) const
+  { return codebooks[subspace]; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  //! Number of subspaces.
+  size_t numSubspaces;
+  //! Number of codewords per subspace.
+  size_t numCodewords;
+  //! Maximum number of KMeans iterations used to train each codebook.
+  size_t maxIterations;
+  //! First dimension of each subspace, plus a trailing total-dimension entry.
+  std::vector<size_t> subspaceBegin;
+  //! Trained codebooks, one per subspace (subspace dimension x numCodewords).
+  std::vector<arma::mat> codebooks;
+  //! Compressed reference set (numSubspaces x number of points).
+  arma::Mat<unsigned char> codes;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "pq_index_impl.hpp"
+
+#endif
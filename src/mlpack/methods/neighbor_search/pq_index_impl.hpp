@@ -0,0 +1,169 @@
+/**
+ * @file methods/neighbor_search/pq_index_impl.hpp
+ *
+ * Implementation of the PQIndex class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "pq_index.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename MatType>
+PQIndex<MatType>::PQIndex(const MatType& referenceSet,
+                          const size_t numSubspaces,
+                          const size_t numCodewords,
+                          const size_t maxIterations) :
+    numSubspaces(numSubspaces),
+    numCodewords(numCodewords),
+    maxIterations(maxIterations)
+{
+  Train(referenceSet);
+}
+
+template<typename MatType>
+PQIndex<MatType>::PQIndex(const size_t numSubspaces,
+                          const size_t numCodewords,
+                          const size_t maxIterations) :
+    numSubspaces(numSubspaces),
+    numCodewords(numCodewords),
+    maxIterations(maxIterations)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+void PQIndex<MatType>::Train(const MatType& referenceSet)
+{
+  if (numCodewords > 256)
+  {
+    throw std::invalid_argument("PQIndex::Train(): at most 256 codewords per "
+        "subspace are supported (codes are stored as 8-bit values)");
+  }
+  if (numSubspaces == 0 || numSubspaces > referenceSet.n_rows)
+  {
+    std::stringstream ss;
+    ss << "PQIndex::Train(): number of subspaces (" << numSubspaces << ") "
+        << "must be between 1 and the dimensionality of the data ("
+        << referenceSet.n_rows << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Partition the dimensions into contiguous subspaces of (nearly) equal
+  // size; the first (n_rows % numSubspaces) subspaces get one extra
+  // dimension.
+  subspaceBegin.assign(numSubspaces + 1, 0);
+  const size_t baseDims = referenceSet.n_rows / numSubspaces;
+  const size_t extraDims = referenceSet.n_rows % numSubspaces;
+  for (size_t s = 0; s < numSubspaces; ++s)
+    subspaceBegin[s + 1] = subspaceBegin[s] + baseDims + (s < extraDims);
+
+  codebooks.resize(numSubspaces);
+  codes.set_size(numSubspaces, referenceSet.n_cols);
+
+  // Train one codebook per subspace.  KMeans cannot produce more clusters
+  // than points, so small reference sets get smaller codebooks.
+  const size_t clusters = std::min(numCodewords,
+      (size_t) referenceSet.n_cols);
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    const arma::mat subspaceData = arma::conv_to<arma::mat>::from(
+        referenceSet.rows(subspaceBegin[s], subspaceBegin[s + 1] - 1));
+
+    kmeans::KMeans<> kmeans(maxIterations);
+    arma::Row<size_t> assignments;
+    kmeans.Cluster(subspaceData, clusters, assignments, codebooks[s]);
+
+    for (size_t i = 0; i < referenceSet.n_cols; ++i)
+      codes(s, i) = (unsigned char) assignments[i];
+  }
+}
+
+template<typename MatType>
+void PQIndex<MatType>::Search(const MatType& querySet,
+                              const size_t k,
+                              arma::Mat<size_t>& neighbors,
+                              arma::mat& distances) const
+{
+  if (k > codes.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << codes.n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    // Asymmetric distance: compare the raw query against every codeword once,
+    // storing squared distances; the distance to a reference point is then
+    // the sum of the table entries selected by its codes.
+    arma::mat table(codebooks[0].n_cols, numSubspaces);
+    for (size_t s = 0; s < numSubspaces; ++s)
+    {
+      const arma::vec querySub = arma::conv_to<arma::vec>::from(
+          querySet.submat(subspaceBegin[s], i, subspaceBegin[s + 1] - 1, i));
+      for (size_t c = 0; c < codebooks[s].n_cols; ++c)
+      {
+        table(c, s) = arma::accu(arma::square(querySub - codebooks[s].col(c)));
+      }
+    }
+
+    // Scan the codes, keeping the k best in a max-heap so that the worst
+    // candidate can be evicted in O(log k).
+    std::priority_queue<std::pair<double, size_t>> best;
+    for (size_t j = 0; j < codes.n_cols; ++j)
+    {
+      double squaredDistance = 0.0;
+      for (size_t s = 0; s < numSubspaces; ++s)
+        squaredDistance += table(codes(s, j), s);
+
+      if (best.size() < k)
+        best.push(std::make_pair(squaredDistance, j));
+      else if (squaredDistance < best.top().first)
+      {
+        best.pop();
+        best.push(std::make_pair(squaredDistance, j));
+      }
+    }
+
+    // Extract worst-first and reverse, converting back to plain distances.
+    for (size_t j = best.size(); j > 0; --j)
+    {
+      neighbors(j - 1, i) = best.top().second;
+      distances(j - 1, i) = std::sqrt(best.top().first);
+      best.pop();
+    }
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void PQIndex<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numSubspaces));
+  ar(CEREAL_NVP(numCodewords));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(subspaceBegin));
+  ar(CEREAL_NVP(codebooks));
+  ar(CEREAL_NVP(codes));
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file methods/neighbor_search/quantized_reference_set.hpp
+ *
+ * Defines the QuantizedReferenceSet class, a 16-bit fixed-point compressed
+ * copy of a reference dataset.  It is used by NeighborSearchRules::BaseCase()
+ * for two-tier distance evaluation: candidates are first scored against the
+ * compressed copy, and only those that could enter the result list are
+ * rescored against the full-precision data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_QUANTIZED_REFERENCE_SET_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_QUANTIZED_REFERENCE_SET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The QuantizedReferenceSet class holds a compressed copy of a reference
+ * dataset in which every coordinate is stored as a 16-bit fixed-point code:
+ * each dimension is affinely mapped from [min, max] onto [0, 65535] and
+ * rounded to the nearest code.  A point therefore occupies a quarter of the
+ * memory of its double-precision original (half of a single-precision copy),
+ * and streaming the codes during search costs a quarter of the memory
+ * bandwidth.
+ *
+ * Because every coordinate is off by at most half a quantization step, the
+ * Euclidean distance computed from the codes is within MaxError() of the
+ * true distance.  This makes the compressed copy usable for *exact* pruning:
+ * if even Distance() - MaxError() cannot beat the current k-th best
+ * candidate, the true distance cannot either, and the full-precision
+ * evaluation can be skipped.
+ *
+ * Distance() computes the Euclidean (L2) distance; the error bound does not
+ * transfer to other metrics, so users should only enable quantized pruning
+ * for the Euclidean metric.
+ *
+ * @tparam MatType The type of data matrix.
+ */
+template<typename MatType = arma::mat>
+class QuantizedReferenceSet
+{
+ public:
+  //! The element type of the original data.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Construct an empty QuantizedReferenceSet holding no points.
+   */
+  QuantizedReferenceSet();
+
+  /**
+   * Construct the QuantizedReferenceSet as a compressed copy of the given
+   * reference set.  The reference set is only read during construction; it
+   * is not retained.
+   *
+   * @param referenceSet Set of reference points to compress.
+   */
+  QuantizedReferenceSet(const MatType& referenceSet);
+
+  /**
+   * Compute the Euclidean distance between the given (uncompressed) query
+   * point and the dequantized reference point with the given index.  The
+   * result is within MaxError() of the true distance.
+   *
+   * @param query Query point.
+   * @param index Index of the reference point.
+   */
+  template<typename VecType>
+  double Distance(const VecType& query, const size_t index) const;
+
+  //! Get the bound on the absolute error of Distance() (half the Euclidean
+  //! norm of the per-dimension quantization steps).
+  double MaxError() const { return maxError; }
+
+  //! Get the number of points held in the compressed copy.
+  size_t NumPoints() const { return codes.n_cols; }
+
+  //! Get the dimensionality of the compressed copy.
+  size_t Dim() const { return codes.n_rows; }
+
+ private:
+  //! The 16-bit fixed-point codes, one column per reference point.
+  arma::Mat<arma::u16> codes;
+  //! Per-dimension minimum values (the value a code of 0 decodes to).
+  arma::Col<ElemType> mins;
+  //! Per-dimension quantization step sizes (range / 65535).
+  arma::Col<ElemType> steps;
+  //! Bound on the absolute error of Distance().
+  double maxError;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_reference_set_impl.hpp"
+
+#endif // MLPACK_METHODS_NEIGHBOR_SEARCH_QUANTIZED_REFERENCE_SET_HPP
@@ -0,0 +1,78 @@
+/**
+ * @file methods/neighbor_search/quantized_reference_set_impl.hpp
+ *
+ * Implementation of the QuantizedReferenceSet class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_QUANTIZED_REFERENCE_SET_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_QUANTIZED_REFERENCE_SET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantized_reference_set.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename MatType>
+QuantizedReferenceSet<MatType>::QuantizedReferenceSet() : maxError(0.0)
+{ /* Nothing to do. */ }
+
+template<typename MatType>
+QuantizedReferenceSet<MatType>::QuantizedReferenceSet(
+    const MatType& referenceSet) : maxError(0.0)
+{
+  codes.set_size(referenceSet.n_rows, referenceSet.n_cols);
+  if (referenceSet.n_elem == 0)
+  {
+    mins.zeros(referenceSet.n_rows);
+    steps.zeros(referenceSet.n_rows);
+    return;
+  }
+
+  mins = arma::min(referenceSet, 1);
+  // A code of 65535 decodes to the per-dimension maximum, so the step is the
+  // range divided by 65535; constant dimensions get a step of zero and all
+  // points share the code 0 there.
+  steps = (arma::max(referenceSet, 1) - mins) /
+      ElemType(std::numeric_limits<arma::u16>::max());
+
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    for (size_t d = 0; d < referenceSet.n_rows; ++d)
+    {
+      codes(d, i) = (steps[d] > ElemType(0)) ?
+          (arma::u16) std::lround((referenceSet(d, i) - mins[d]) / steps[d]) :
+          arma::u16(0);
+    }
+  }
+
+  // Rounding puts every coordinate within half a step of its original value,
+  // so the Euclidean distance error is at most half the norm of the steps.
+  maxError = 0.5 * std::sqrt((double) arma::accu(arma::square(steps)));
+}
+
+template<typename MatType>
+template<typename VecType>
+double QuantizedReferenceSet<MatType>::Distance(const VecType& query,
+                                                const size_t index) const
+{
+  double sum = 0.0;
+  for (size_t d = 0; d < codes.n_rows; ++d)
+  {
+    const double value = (double) mins[d] +
+        (double) steps[d] * (double) codes(d, index);
+    const double diff = (double) query[d] - value;
+    sum += diff * diff;
+  }
+
+  return std::sqrt(sum);
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_NEIGHBOR_SEARCH_QUANTIZED_REFERENCE_SET_IMPL_HPP
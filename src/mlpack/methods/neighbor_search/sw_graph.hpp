@@ -0,0 +1,194 @@
+/**
+ * @file methods/neighbor_search/sw_graph.hpp
+ *
+ * Defines the SWGraph class, a navigable small-world graph index for
+ * approximate nearest neighbor search.  Instead of a space-partitioning tree,
+ * the index is a graph with one node per reference point, where each node is
+ * linked to (approximately) its nearest neighbors; queries are answered with a
+ * greedy beam search over the graph.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SW_GRAPH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SW_GRAPH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The SWGraph class implements a navigable small-world graph index for
+ * approximate k-nearest-neighbor search.  The graph is built by inserting the
+ * reference points one block at a time: each point in a block is beam-searched
+ * against the already-built graph in parallel, and then linked to its best
+ * candidates serially.  Queries run an independent beam search per query
+ * point, so they parallelize trivially.
+ *
+ * Search quality is controlled by the beam width: EfSearch() (and
+ * EfConstruction() at build time).  Wider beams give higher recall and slower
+ * queries.  Results are approximate; for exact search use NeighborSearch.
+ *
+ * The index does not reorder the reference set, so returned neighbor indices
+ * refer directly to columns of ReferenceSet() and need no unmapping.
+ *
+ * Both Search() overloads are const and keep all per-query state on the
+ * stack, so a built index can be searched from any number of threads
+ * concurrently, as long as no thread concurrently calls Train() or modifies
+ * EfSearch().
+ *
+ * Note that the graph is built from nearest-neighbor links, so it is only
+ * meaningful for nearest-neighbor sort policies.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat>
+class SWGraph
+{
+ public:
+  /**
+   * Construct the SWGraph index on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param maxNeighbors Maximum node degree in the graph.
+   * @param efConstruction Beam width used while building the graph.
+   * @param metric An optional instance of the MetricType class.
+   */
+  SWGraph(MatType referenceSet,
+          const size_t maxNeighbors = 16,
+          const size_t efConstruction = 100,
+          const MetricType metric = MetricType());
+
+  /**
+   * Construct an empty SWGraph index; it can be trained later with Train().
+   *
+   * @param maxNeighbors Maximum node degree in the graph.
+   * @param efConstruction Beam width used while building the graph.
+   * @param metric An optional instance of the MetricType class.
+   */
+  SWGraph(const size_t maxNeighbors = 16,
+          const size_t efConstruction = 100,
+          const MetricType metric = MetricType());
+
+  /**
+   * Build the graph on a new reference set, replacing any old one.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * For each point in the query set, find the approximate k nearest neighbors
+   * in the reference set and store the indices in the neighbors matrix and
+   * the distances in the distances matrix.  If the beam search cannot reach k
+   * points (which can only happen when the graph is disconnected), the unused
+   * entries are filled with SortPolicy::WorstDistance() and invalid indices.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Perform monochromatic search, using every reference point as a query and
+   * excluding it from its own result list.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  //! Access the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the maximum node degree.
+  size_t MaxNeighbors() const { return maxNeighbors; }
+  //! Modify the maximum node degree (only affects later Train() calls).
+  size_t& MaxNeighbors() { return maxNeighbors; }
+
+  //! Get the beam width used during construction.
+  size_t EfConstruction() const { return efConstruction; }
+  //! Modify the beam width used during construction.
+  size_t& EfConstruction() { return efConstruction; }
+
+  //! Get the beam width used during search.
+  size_t EfSearch() const { return efSearch; }
+  //! Modify the beam width used during search.
+  size_t& EfSearch() { return efSearch; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  //! Strict version of SortPolicy::IsBetter(), usable as an ordering.
+  static bool StrictlyBetter(const double value, const double ref)
+  {
+    return SortPolicy::IsBetter(value, ref) &&
+        !SortPolicy::IsBetter(ref, value);
+  }
+
+  /**
+   * Run a beam search over the graph for the given query point, returning up
+   * to ef candidates as (distance, index) pairs ordered best-first.
+   *
+   * @param query The query point.
+   * @param ef Beam width (number of candidates to maintain).
+   * @param results Vector to store the candidates into.
+   */
+  template<typename VecType>
+  void BeamSearch(const VecType& query,
+                  const size_t ef,
+                  std::vector<std::pair<double, size_t>>& results) const;
+
+  /**
+   * Link a freshly inserted node to the best of its candidates, adding
+   * reverse edges and pruning any node whose degree exceeds maxNeighbors.
+   *
+   * @param index Index of the inserted node.
+   * @param candidates Candidates from the construction beam search,
+   *      best-first.
+   */
+  void LinkNode(const size_t index,
+                const std::vector<std::pair<double, size_t>>& candidates);
+
+  //! The reference set.
+  MatType referenceSet;
+  //! Instantiation of metric.
+  MetricType metric;
+  //! Maximum node degree.
+  size_t maxNeighbors;
+  //! Beam width during construction.
+  size_t efConstruction;
+  //! Beam width during search.
+  size_t efSearch;
+  //! Adjacency lists; edges[i] holds the graph neighbors of point i.
+  std::vector<std::vector<size_t>> edges;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "sw_graph_impl.hpp"
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file methods/neighbor_search/sw_graph_impl.hpp
+ *
+ * Implementation of the SWGraph class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SW_GRAPH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SW_GRAPH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sw_graph.hpp"
+
+#include <queue>
+#include <unordered_set>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy, typename MetricType, typename MatType>
+SWGraph<SortPolicy, MetricType, MatType>::SWGraph(
+    MatType referenceSet,
+    const size_t maxNeighbors,
+    const size_t efConstruction,
+    const MetricType metric) :
+    metric(metric),
+    maxNeighbors(maxNeighbors),
+    efConstruction(efConstruction),
+    efSearch(64)
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename SortPolicy, typename MetricType, typename MatType>
+SWGraph<SortPolicy, MetricType, MatType>::SWGraph(
+    const size_t maxNeighbors,
+    const size_t efConstruction,
+    const MetricType metric) :
+    metric(metric),
+    maxNeighbors(maxNeighbors),
+    efConstruction(efConstruction),
+    efSearch(64)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy, typename MetricType, typename MatType>
+void SWGraph<SortPolicy, MetricType, MatType>::Train(MatType referenceSetIn)
+{
+  referenceSet = std::move(referenceSetIn);
+  edges.assign(referenceSet.n_cols, std::vector<size_t>());
+
+  if (referenceSet.n_cols <= 1)
+    return;
+
+  // Insert the points in blocks.  Within a block, the construction beam
+  // searches only read the already-built part of the graph, so they can run
+  // in parallel; the link phase that mutates the adjacency lists is serial.
+  const size_t blockSize = 256;
+  std::vector<std::vector<std::pair<double, size_t>>> candidates(blockSize);
+
+  // Point 0 seeds the graph and is the entry point for every search.
+  for (size_t start = 1; start < referenceSet.n_cols; start += blockSize)
+  {
+    const size_t end = std::min(start + blockSize,
+        (size_t) referenceSet.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t i = start; i < (omp_size_t) end; ++i)
+      BeamSearch(referenceSet.col(i), efConstruction, candidates[i - start]);
+
+    for (size_t i = start; i < end; ++i)
+      LinkNode(i, candidates[i - start]);
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename MatType>
+void SWGraph<SortPolicy, MetricType, MatType>::LinkNode(
+    const size_t index,
+    const std::vector<std::pair<double, size_t>>& candidates)
+{
+  const size_t degree = std::min(maxNeighbors, candidates.size());
+  for (size_t j = 0; j < degree; ++j)
+  {
+    const size_t other = candidates[j].second;
+    edges[index].push_back(other);
+
+    // Add the reverse edge, pruning the other node back to maxNeighbors by
+    // keeping its closest neighbors.
+    edges[other].push_back(index);
+    if (edges[other].size() > maxNeighbors)
+    {
+      std::vector<size_t>& list = edges[other];
+      std::vector<std::pair<double, size_t>> scored(list.size());
+      for (size_t l = 0; l < list.size(); ++l)
+      {
+        scored[l] = std::make_pair(
+            metric.Evaluate(referenceSet.col(other),
+                            referenceSet.col(list[l])), list[l]);
+      }
+      std::sort(scored.begin(), scored.end(),
+          [](const std::pair<double, size_t>& a,
+             const std::pair<double, size_t>& b)
+          { return StrictlyBetter(a.first,
+                b.first); });
+
+      list.resize(maxNeighbors);
+      for (size_t l = 0; l < maxNeighbors; ++l)
+        list[l] = scored[l].second;
+    }
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename MatType>
+template<typename VecType>
+void SWGraph<SortPolicy, MetricType, MatType>::BeamSearch(
+    const VecType& query,
+    const size_t ef,
+    std::vector<std::pair<double, size_t>>& results) const
+{
+  results.clear();
+  if (referenceSet.n_cols == 0)
+    return;
+
+  typedef std::pair<double, size_t> Candidate;
+
+  // The frontier keeps the best unexpanded candidate on top; the beam keeps
+  // the worst of the current ef best on top, so it can be evicted cheaply.
+  auto bestOnTop = [](const Candidate& a, const Candidate& b)
+      { return StrictlyBetter(b.first, a.first); };
+  auto worstOnTop = [](const Candidate& a, const Candidate& b)
+      { return StrictlyBetter(a.first, b.first); };
+
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      decltype(bestOnTop)> frontier(bestOnTop);
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      decltype(worstOnTop)> beam(worstOnTop);
+  std::unordered_set<size_t> visited;
+
+  const size_t entryPoint = 0;
+  const double entryDistance = metric.Evaluate(query,
+      referenceSet.col(entryPoint));
+  frontier.push(std::make_pair(entryDistance, entryPoint));
+  beam.push(std::make_pair(entryDistance, entryPoint));
+  visited.insert(entryPoint);
+
+  while (!frontier.empty())
+  {
+    const Candidate current = frontier.top();
+
+    // Once the best unexpanded candidate is no better than the worst point in
+    // a full beam, no expansion can improve the results.
+    if (beam.size() >= ef &&
+        !SortPolicy::IsBetter(current.first, beam.top().first))
+      break;
+    frontier.pop();
+
+    for (const size_t neighbor : edges[current.second])
+    {
+      if (!visited.insert(neighbor).second)
+        continue;
+
+      const double distance = metric.Evaluate(query,
+          referenceSet.col(neighbor));
+      if (beam.size() < ef ||
+          SortPolicy::IsBetter(distance, beam.top().first))
+      {
+        frontier.push(std::make_pair(distance, neighbor));
+        beam.push(std::make_pair(distance, neighbor));
+        if (beam.size() > ef)
+          beam.pop();
+      }
+    }
+  }
+
+  // Extract the beam, worst-first, then reverse to best-first.
+  results.resize(beam.size());
+  for (size_t i = results.size(); i > 0; --i)
+  {
+    results[i - 1] = beam.top();
+    beam.pop();
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename MatType>
+void SWGraph<SortPolicy, MetricType, MatType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances) const
+{
+  if (k > referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referenceSet.n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  const size_t ef = std::max(efSearch, k);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    std::vector<std::pair<double, size_t>> results;
+    BeamSearch(querySet.col(i), ef, results);
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (j < results.size())
+      {
+        neighbors(j, i) = results[j].second;
+        distances(j, i) = results[j].first;
+      }
+      else
+      {
+        neighbors(j, i) = (size_t) -1;
+        distances(j, i) = SortPolicy::WorstDistance();
+      }
+    }
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename MatType>
+void SWGraph<SortPolicy, MetricType, MatType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances) const
+{
+  if (k >= referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than or equal to the "
+        << "number of points in the reference set (" << referenceSet.n_cols
+        << ") and no query set has been provided.";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, referenceSet.n_cols);
+  distances.set_size(k, referenceSet.n_cols);
+
+  // Search with a wider beam so the query point itself can be dropped.
+  const size_t ef = std::max(efSearch, k + 1);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
+  {
+    std::vector<std::pair<double, size_t>> results;
+    BeamSearch(referenceSet.col(i), ef, results);
+
+    size_t j = 0;
+    for (size_t r = 0; r < results.size() && j < k; ++r)
+    {
+      if (results[r].second == (size_t) i)
+        continue; // Skip the query point itself.
+      neighbors(j, i) = results[r].second;
+      distances(j, i) = results[r].first;
+      ++j;
+    }
+    for (; j < k; ++j)
+    {
+      neighbors(j, i) = (size_t) -1;
+      distances(j, i) = SortPolicy::WorstDistance();
+    }
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename MatType>
+template<typename Archive>
+void SWGraph<SortPolicy, MetricType, MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(metric));
+  ar(CEREAL_NVP(maxNeighbors));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(efSearch));
+  ar(CEREAL_NVP(edges));
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -60,6 +60,24 @@ void Unmap(const arma::Mat<size_t>& neighbors,
            arma::mat& distancesOut,
            const bool squareRoot = false);
 
+/**
+ * Assuming that only the query points have been permuted using queryMap (such
+ * as when query points are reordered for locality before a batch search),
+ * unmap the columns of the distances and neighbors matrices into neighborsOut
+ * and distancesOut.  The neighbor indices themselves are left untouched.
+ *
+ * @param neighbors Matrix of neighbors resulting from neighbor search.
+ * @param distances Matrix of distances resulting from neighbor search.
+ * @param queryMap Mapping of query set to old points.
+ * @param neighborsOut Matrix to store unmapped neighbors into.
+ * @param distancesOut Matrix to store unmapped distances into.
+ */
+void UnmapQueries(const arma::Mat<size_t>& neighbors,
+                  const arma::mat& distances,
+                  const std::vector<size_t>& queryMap,
+                  arma::Mat<size_t>& neighborsOut,
+                  arma::mat& distancesOut);
+
 } // namespace neighbor
 } // namespace mlpack
 
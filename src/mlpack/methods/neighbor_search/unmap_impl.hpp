@@ -68,6 +68,25 @@ inline void Unmap(const arma::Mat<size_t>& neighbors,
     neighborsOut[j] = referenceMap[neighbors[j]];
 }
 
+// Useful when only the query points were permuted.
+inline void UnmapQueries(const arma::Mat<size_t>& neighbors,
+                         const arma::mat& distances,
+                         const std::vector<size_t>& queryMap,
+                         arma::Mat<size_t>& neighborsOut,
+                         arma::mat& distancesOut)
+{
+  // Set matrices to correct size.
+  neighborsOut.set_size(neighbors.n_rows, neighbors.n_cols);
+  distancesOut.set_size(distances.n_rows, distances.n_cols);
+
+  // Map columns to the correct place.
+  for (size_t i = 0; i < distances.n_cols; ++i)
+  {
+    distancesOut.col(queryMap[i]) = distances.col(i);
+    neighborsOut.col(queryMap[i]) = neighbors.col(i);
+  }
+}
+
 } // namespace neighbor
 } // namespace mlpack
 
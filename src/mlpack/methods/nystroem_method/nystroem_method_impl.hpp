@@ -35,18 +35,13 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      miniKernel(i, j) = kernel.Evaluate(selectedData->col(i),
-                                         selectedData->col(j));
+  // Assemble the mini-kernel matrix as one bulk panel.
+  PairwiseKernels(*selectedData, *selectedData, miniKernel, kernel);
 
   // Construct semi-kernel matrix with interactions between selected data and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         selectedData->col(j));
+  // all points, again as one bulk panel.
+  PairwiseKernels(data, *selectedData, semiKernel, kernel);
+
   // Clean the memory.
   delete selectedData;
 }
@@ -57,22 +52,18 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-  {
-    for (size_t j = 0; j < rank; ++j)
-    {
-      miniKernel(i, j) = kernel.Evaluate(data.col(selectedPoints(i)),
-                                         data.col(selectedPoints(j)));
-    }
-  }
-
-  // Construct semi-kernel matrix with interactions between selected points and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         data.col(selectedPoints(j)));
+  // Materialize the selected columns once, so that both kernel panels can be
+  // computed in bulk.
+  arma::mat selectedData(data.n_rows, rank);
+  for (size_t j = 0; j < rank; ++j)
+    selectedData.col(j) = data.col(selectedPoints(j));
+
+  // Assemble the mini-kernel matrix as one bulk panel.
+  PairwiseKernels(selectedData, selectedData, miniKernel, kernel);
+
+  // Construct semi-kernel matrix with interactions between selected points
+  // and all points, again as one bulk panel.
+  PairwiseKernels(data, selectedData, semiKernel, kernel);
 }
 
 template<typename KernelType, typename PointSelectionPolicy>
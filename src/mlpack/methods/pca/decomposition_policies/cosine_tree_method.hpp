@@ -0,0 +1,135 @@
+/**
+ * @file methods/pca/decomposition_policies/cosine_tree_method.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the cosine tree policy for use in the Principal
+ * Components Analysis method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_COSINE_TREE_METHOD_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_COSINE_TREE_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/cosine_tree/cosine_tree.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * Implementation of the cosine tree policy.  This uses the cosine tree's
+ * low-rank subspace construction directly: the tree is built on the centered
+ * data in one pass, splitting in the direction of maximum estimated error
+ * until either the Monte Carlo error estimate drops below the given epsilon
+ * or, if 'maxRank' is nonzero, the basis reaches that many vectors.  The
+ * principal directions are then recovered by diagonalizing the covariance of
+ * the data projected into that subspace, which only involves a small
+ * eigendecomposition.  Compared to the QUIC-SVD policy, this skips the SVD
+ * extraction step and can bound the subspace size, so it is preferable when
+ * only a low-dimensional projection is needed from a very large matrix.
+ *
+ * Note that capping 'maxRank' also caps the set of eigenvalues the policy can
+ * report, so variance-retained estimates become relative to the captured
+ * subspace rather than to the full data.
+ */
+class CosineTreePolicy
+{
+ public:
+  /**
+   * Use the cosine tree method to perform the principal components analysis
+   * (PCA).
+   *
+   * @param epsilon Error tolerance fraction for calculated subspace.
+   * @param delta Cumulative probability for Monte Carlo error lower bound.
+   * @param maxRank Maximum number of basis vectors to build (0 means no
+   *      limit).
+   */
+  CosineTreePolicy(const double epsilon = 0.03,
+                   const double delta = 0.1,
+                   const size_t maxRank = 0) :
+      epsilon(epsilon),
+      delta(delta),
+      maxRank(maxRank)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided data set using the
+   * cosine tree method.
+   *
+   * @param data Data matrix.
+   * @param centeredData Centered data matrix.
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param * (rank) Rank of the decomposition.
+   */
+  void Apply(const arma::mat& data,
+             const arma::mat& centeredData,
+             arma::mat& transformedData,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t /* rank */)
+  {
+    // Build the cosine tree on the centered data; the basis it constructs is
+    // an orthonormal set spanning the dominant part of the column space,
+    // bounded in size by maxRank (if it is nonzero).
+    tree::CosineTree ctree(centeredData, epsilon, delta, maxRank);
+    arma::mat basis;
+    ctree.GetFinalBasis(basis);
+
+    // The basis spans the subspace, but its vectors are not principal
+    // directions yet; diagonalize the covariance of the projected data to
+    // rotate them into place.
+    arma::mat projectedData = basis.t() * centeredData;
+    arma::mat projectedCovariance = projectedData * projectedData.t() /
+        (data.n_cols - 1);
+
+    arma::vec subspaceEigVal;
+    arma::mat subspaceEigvec;
+    arma::eig_sym(subspaceEigVal, subspaceEigvec, projectedCovariance);
+
+    // eig_sym() returns the eigenvalues in ascending order, but PCA expects
+    // them in descending order.
+    eigVal = arma::flipud(subspaceEigVal);
+    eigvec = basis * arma::fliplr(subspaceEigvec);
+
+    // Project the samples to the principals.
+    transformedData = arma::trans(eigvec) * centeredData;
+  }
+
+  //! Get the error tolerance fraction for calculated subspace.
+  double Epsilon() const { return epsilon; }
+  //! Modify the error tolerance fraction for calculated subspace.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the cumulative probability for Monte Carlo error lower bound.
+  double Delta() const { return delta; }
+  //! Modify the cumulative probability for Monte Carlo error lower bound.
+  double& Delta() { return delta; }
+
+  //! Get the maximum number of basis vectors to build.
+  size_t MaxRank() const { return maxRank; }
+  //! Modify the maximum number of basis vectors to build.
+  size_t& MaxRank() { return maxRank; }
+
+ private:
+  //! Error tolerance fraction for calculated subspace.
+  double epsilon;
+
+  //! Cumulative probability for Monte Carlo error lower bound.
+  double delta;
+
+  //! Maximum number of basis vectors to build (0 means no limit).
+  size_t maxRank;
+};
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file methods/pca/incremental_pca.hpp
+ * @author Marcus Edel
+ *
+ * Defines the IncrementalPCA class, which maintains a mergeable rank-k sketch
+ * of a dataset that is consumed in column batches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * This class implements incremental principal components analysis.  Unlike
+ * PCA, which is one-shot over a full in-memory matrix, IncrementalPCA
+ * consumes the dataset in column batches and maintains a frequent-directions
+ * sketch of bounded size, plus exact mean statistics.  The principal
+ * components can be extracted from the sketch at any time, new batches can be
+ * appended afterwards, and sketches built independently (e.g. by several
+ * workers over shards of the data) can be merged without losing the sketch
+ * guarantee.  Re-running a nightly PCA over mostly-unchanged data thus
+ * reduces to sketching only the new columns.
+ *
+ * The sketch is the frequent-directions algorithm of:
+ *
+ * @code
+ * @article{Ghashami2016,
+ *   author  = {Ghashami, M. and Liberty, E. and Phillips, J. M. and
+ *              Woodruff, D. P.},
+ *   title   = {Frequent Directions: Simple and Deterministic Matrix
+ *              Sketching},
+ *   journal = {SIAM J. Comput.},
+ *   volume  = {45},
+ *   year    = {2016},
+ * }
+ * @endcode
+ *
+ * The raw (uncentered) columns are sketched; the mean is tracked exactly and
+ * subtracted when the eigendecomposition is formed, so centering never has to
+ * be redone when more batches arrive.
+ */
+class IncrementalPCA
+{
+ public:
+  /**
+   * Create the incremental PCA object.
+   *
+   * @param rank Number of principal components to maintain.
+   * @param sketchSize Number of rows of the sketch; must be greater than
+   *      rank.  Larger values give a more accurate sketch (Default: 2 *
+   *      rank).
+   */
+  IncrementalPCA(const size_t rank = 10, const size_t sketchSize = 0);
+
+  /**
+   * Add a batch of data to the sketch.  Each column of the batch is one
+   * point.  The dimensionality of the first batch fixes the dimensionality
+   * of the sketch.
+   *
+   * @param batch Batch of data points to add.
+   */
+  void Add(const arma::mat& batch);
+
+  /**
+   * Merge another sketch into this one.  The other sketch must have the same
+   * rank, sketch size and dimensionality; afterwards this object summarizes
+   * the union of the two datasets.
+   *
+   * @param other Sketch to merge into this one.
+   */
+  void Merge(const IncrementalPCA& other);
+
+  /**
+   * Extract the principal components of the data seen so far.  The
+   * eigenvalues are those of the (approximated) covariance matrix, in
+   * descending order, truncated to the rank of the sketch.
+   *
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   */
+  void Eigendecompose(arma::vec& eigVal, arma::mat& eigvec) const;
+
+  /**
+   * Project the given data onto the principal components of the data seen so
+   * far, centering it with the tracked mean.  It is safe to pass the same
+   * matrix reference for both data and transformedData.
+   *
+   * @param data Data matrix.
+   * @param transformedData Matrix to put the projected data into.
+   */
+  void Apply(const arma::mat& data, arma::mat& transformedData) const;
+
+  //! Get the number of principal components maintained.
+  size_t Rank() const { return rank; }
+
+  //! Get the number of rows of the sketch.
+  size_t SketchSize() const { return sketchSize; }
+
+  //! Get the number of points seen so far.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Get the dimensionality of the sketched data (0 before any batch).
+  size_t Dimensionality() const { return sketch.n_cols; }
+
+  //! Get the mean of the points seen so far.
+  arma::vec Mean() const;
+
+  //! Serialize the sketch.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(rank));
+    ar(CEREAL_NVP(sketchSize));
+    ar(CEREAL_NVP(numPoints));
+    ar(CEREAL_NVP(sum));
+    ar(CEREAL_NVP(sketch));
+  }
+
+ private:
+  /**
+   * Shrink the sketch back to sketchSize rows, applying the
+   * frequent-directions singular value reduction.
+   *
+   * @param stacked The sketch with extra rows appended.
+   */
+  void Shrink(const arma::mat& stacked);
+
+  //! Number of principal components maintained.
+  size_t rank;
+
+  //! Number of rows of the sketch.
+  size_t sketchSize;
+
+  //! Number of points seen so far.
+  size_t numPoints;
+
+  //! Sum of the points seen so far (for exact centering).
+  arma::vec sum;
+
+  //! The frequent-directions sketch; each row is one direction.
+  arma::mat sketch;
+};
+
+} // namespace pca
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_pca_impl.hpp"
+
+#endif
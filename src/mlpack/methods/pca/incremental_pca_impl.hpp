@@ -0,0 +1,176 @@
+/**
+ * @file methods/pca/incremental_pca_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the IncrementalPCA class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incremental_pca.hpp"
+
+namespace mlpack {
+namespace pca {
+
+inline IncrementalPCA::IncrementalPCA(const size_t rank,
+                                      const size_t sketchSize) :
+    rank(rank),
+    sketchSize((sketchSize == 0) ? 2 * rank : sketchSize),
+    numPoints(0)
+{
+  if (this->sketchSize <= rank)
+  {
+    throw std::invalid_argument("IncrementalPCA: sketchSize must be greater "
+        "than rank!");
+  }
+}
+
+inline void IncrementalPCA::Add(const arma::mat& batch)
+{
+  if (batch.n_cols == 0)
+    return;
+
+  if (numPoints == 0)
+  {
+    sum.zeros(batch.n_rows);
+    sketch.zeros(sketchSize, batch.n_rows);
+  }
+  else if (batch.n_rows != sketch.n_cols)
+  {
+    throw std::invalid_argument("IncrementalPCA::Add(): batch dimensionality "
+        "does not match the sketch!");
+  }
+
+  numPoints += batch.n_cols;
+  sum += arma::sum(batch, 1);
+
+  // Append the new points as rows of the sketch and shrink it back to its
+  // fixed size.
+  Shrink(arma::join_cols(sketch, batch.t()));
+}
+
+inline void IncrementalPCA::Merge(const IncrementalPCA& other)
+{
+  if (other.rank != rank || other.sketchSize != sketchSize)
+  {
+    throw std::invalid_argument("IncrementalPCA::Merge(): sketches must have "
+        "the same rank and sketch size!");
+  }
+
+  if (other.numPoints == 0)
+    return;
+
+  if (numPoints == 0)
+  {
+    numPoints = other.numPoints;
+    sum = other.sum;
+    sketch = other.sketch;
+    return;
+  }
+
+  if (other.sketch.n_cols != sketch.n_cols)
+  {
+    throw std::invalid_argument("IncrementalPCA::Merge(): sketches must have "
+        "the same dimensionality!");
+  }
+
+  numPoints += other.numPoints;
+  sum += other.sum;
+
+  // Stacking two frequent-directions sketches and shrinking preserves the
+  // sketch guarantee of the union of the two datasets.
+  Shrink(arma::join_cols(sketch, other.sketch));
+}
+
+inline void IncrementalPCA::Shrink(const arma::mat& stacked)
+{
+  arma::mat u, v;
+  arma::vec s;
+  arma::svd_econ(u, s, v, stacked);
+
+  // The frequent-directions reduction: subtract the squared singular value
+  // that falls just outside the sketch from every kept squared singular
+  // value, so the smallest kept direction is zeroed out.
+  arma::vec squared = arma::square(s);
+  const double delta = (squared.n_elem > sketchSize) ? squared(sketchSize) :
+      0.0;
+
+  const size_t kept = std::min((size_t) squared.n_elem, sketchSize);
+  sketch.zeros(sketchSize, stacked.n_cols);
+  for (size_t i = 0; i < kept; ++i)
+  {
+    const double shrunk = std::max(squared(i) - delta, 0.0);
+    if (shrunk > 0.0)
+      sketch.row(i) = std::sqrt(shrunk) * v.col(i).t();
+  }
+}
+
+inline void IncrementalPCA::Eigendecompose(arma::vec& eigVal,
+                                           arma::mat& eigvec) const
+{
+  if (numPoints < 2)
+  {
+    throw std::invalid_argument("IncrementalPCA::Eigendecompose(): at least "
+        "two points must be added first!");
+  }
+
+  // The (approximated) scatter matrix of the centered data is
+  // S = B^T B - n * mean * mean^T, with B the sketch of the raw data.  S has
+  // rank at most sketchSize + 1, so its eigendecomposition is computed from
+  // the small factorization S = P J P^T with P = [B^T, sqrt(n) * mean] and
+  // J = diag(1, ..., 1, -1): a QR of P reduces the problem to a symmetric
+  // eigendecomposition of the (sketchSize + 1)^2 matrix R J R^T.
+  const arma::vec mean = sum / numPoints;
+  const arma::mat p = arma::join_rows(sketch.t(),
+      std::sqrt((double) numPoints) * mean);
+
+  arma::mat q, r;
+  arma::qr_econ(q, r, p);
+
+  arma::mat rj = r;
+  rj.col(rj.n_cols - 1) *= -1.0;
+
+  arma::vec smallVal;
+  arma::mat smallVec;
+  arma::eig_sym(smallVal, smallVec, arma::symmatu(rj * r.t()));
+
+  // eig_sym() returns ascending eigenvalues; flip to descending and truncate
+  // to the maintained rank.  Shrinkage can leave tiny negative values; clamp
+  // them to zero.
+  const size_t kept = std::min(rank, (size_t) smallVal.n_elem);
+  eigVal.set_size(kept);
+  eigvec.set_size(q.n_rows, kept);
+  for (size_t i = 0; i < kept; ++i)
+  {
+    const size_t j = smallVal.n_elem - 1 - i;
+    eigVal(i) = std::max(smallVal(j), 0.0) / (numPoints - 1);
+    eigvec.col(i) = q * smallVec.col(j);
+  }
+}
+
+inline void IncrementalPCA::Apply(const arma::mat& data,
+                                  arma::mat& transformedData) const
+{
+  arma::vec eigVal;
+  arma::mat eigvec;
+  Eigendecompose(eigVal, eigvec);
+
+  const arma::vec mean = sum / numPoints;
+  transformedData = eigvec.t() * (data.each_col() - mean);
+}
+
+inline arma::vec IncrementalPCA::Mean() const
+{
+  return (numPoints == 0) ? arma::vec() : arma::vec(sum / numPoints);
+}
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,8 @@
 
 #include "perceptron.hpp"
 
+#include <mlpack/core/math/scores_to_labels.hpp>
+
 namespace mlpack {
 namespace perceptron {
 
@@ -132,17 +134,12 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels)
 {
-  arma::vec tempLabelMat;
-  arma::uword maxIndex = 0;
-  predictedLabels.set_size(test.n_cols);
+  // Score all test points with a single GEMM, then take the vectorized argmax
+  // over the classes.
+  arma::mat scores = weights.t() * test;
+  scores.each_col() += biases;
 
-  // Could probably be faster if done in batch.
-  for (size_t i = 0; i < test.n_cols; ++i)
-  {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    tempLabelMat.max(maxIndex);
-    predictedLabels(i) = maxIndex;
-  }
+  math::ScoresToLabels(scores, predictedLabels);
 }
 
 /**
@@ -172,16 +169,22 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     wip.Initialize(weights, biases, data.n_rows, numClasses);
   }
 
-  size_t j, i = 0;
+  size_t i = 0;
   bool converged = false;
-  size_t tempLabel;
-  arma::uword maxIndexRow = 0, maxIndexCol = 0;
-  arma::mat tempLabelMat;
 
   LearnPolicy LP;
 
   const bool hasWeights = (instanceWeights.n_elem > 0);
 
+  // Instead of scoring every point with its own matrix-vector product, score
+  // whole blocks of points with a single matrix product.  A weight update
+  // only touches the two classes involved in the mistake, so after an update
+  // just those two score rows are refreshed for the rest of the block; the
+  // points are still visited, and the weights updated, in exactly the same
+  // order as a point-by-point pass.
+  const size_t batchSize = 256;
+  arma::mat scores;
+
   while ((i < maxIterations) && (!converged))
   {
     // This outer loop is for each iteration, and we use the 'converged'
@@ -189,31 +192,55 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     ++i;
     converged = true;
 
-    // Now this inner loop is for going through the dataset in each iteration.
-    for (j = 0; j < data.n_cols; ++j)
+    // Now this inner loop is for going through the dataset in each iteration,
+    // one block of points at a time.
+    for (size_t begin = 0; begin < data.n_cols; begin += batchSize)
     {
-      // Multiply for each variable and check whether the current weight vector
-      // correctly classifies this.
-      tempLabelMat = weights.t() * data.col(j) + biases;
+      const size_t end = std::min(begin + batchSize,
+          (size_t) data.n_cols) - 1;
 
-      tempLabelMat.max(maxIndexRow, maxIndexCol);
+      // Score the block against the current weights.
+      scores = weights.t() * data.cols(begin, end);
+      scores.each_col() += biases;
 
-      // Check whether prediction is correct.
-      if (maxIndexRow != labels(0, j))
+      for (size_t j = begin; j <= end; ++j)
       {
-        // Due to incorrect prediction, convergence set to false.
-        converged = false;
-        tempLabel = labels(0, j);
-
-        // Send maxIndexRow for knowing which weight to update, send j to know
-        // the value of the vector to update it with.  Send tempLabel to know
-        // the correct class.
-        if (hasWeights)
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow, tempLabel,
-              instanceWeights(j));
-        else
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
-              tempLabel);
+        // Check whether the current weight vector correctly classifies this
+        // point.
+        const arma::uword maxIndex = scores.col(j - begin).index_max();
+
+        // Check whether prediction is correct.
+        if (maxIndex != labels(j))
+        {
+          // Due to incorrect prediction, convergence set to false.
+          converged = false;
+          const size_t correctLabel = labels(j);
+
+          // Send maxIndex for knowing which weight to update, send j to know
+          // the value of the vector to update it with.  Send correctLabel to
+          // know the correct class.
+          if (hasWeights)
+            LP.UpdateWeights(data.col(j), weights, biases, maxIndex,
+                correctLabel, instanceWeights(j));
+          else
+            LP.UpdateWeights(data.col(j), weights, biases, maxIndex,
+                correctLabel);
+
+          // The update changed only the weights of the predicted and the
+          // correct class, so only those two score rows are stale for the
+          // points remaining in this block.
+          if (j < end)
+          {
+            scores.submat(arma::span(maxIndex),
+                arma::span(j - begin + 1, end - begin)) =
+                weights.col(maxIndex).t() * data.cols(j + 1, end) +
+                biases(maxIndex);
+            scores.submat(arma::span(correctLabel),
+                arma::span(j - begin + 1, end - begin)) =
+                weights.col(correctLabel).t() * data.cols(j + 1, end) +
+                biases(correctLabel);
+          }
+        }
       }
     }
   }
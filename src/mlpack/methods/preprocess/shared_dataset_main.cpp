@@ -0,0 +1,101 @@
+/**
+ * @file methods/preprocess/shared_dataset_main.cpp
+ *
+ * A binding to publish a dataset in POSIX shared memory, so that later mlpack
+ * binding invocations can attach to it instead of loading the file again.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/io.hpp>
+
+#ifdef BINDING_NAME
+  #undef BINDING_NAME
+#endif
+#define BINDING_NAME shared_dataset
+
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/core/data/shared_dataset.hpp>
+
+// Program Name.
+BINDING_USER_NAME("Shared Dataset Publisher");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "A utility to publish a dataset in a POSIX shared-memory segment.  Other "
+    "mlpack command-line programs can then attach to the already-parsed data "
+    "by passing 'shm://<name>' wherever a dataset filename is expected, "
+    "instead of each loading its own copy of the file.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This utility loads the dataset given with " +
+    PRINT_PARAM_STRING("input") + " and publishes it under the name given "
+    "with " + PRINT_PARAM_STRING("name") + " in a POSIX shared-memory "
+    "segment.  The segment persists after this program exits, so any number "
+    "of later mlpack command-line invocations can attach to the parsed data "
+    "by passing 'shm://<name>' in place of a dataset filename---eliminating "
+    "the redundant load and parse of the same file by every program in a "
+    "pipeline."
+    "\n\n"
+    "The segment persists until it is removed by running this utility again "
+    "with the " + PRINT_PARAM_STRING("unpublish") + " flag (or until the "
+    "machine is rebooted).  Be sure to unpublish datasets that are no longer "
+    "needed, since the segment occupies memory for as long as it exists."
+    "\n\n"
+    "Shared memory is a POSIX facility, so this utility (and the 'shm://' "
+    "syntax) is not available on Windows.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, to publish the dataset " + PRINT_DATASET("X") + " under the "
+    "name 'census', run"
+    "\n\n" +
+    PRINT_CALL("shared_dataset", "input", "X", "name", "census") +
+    "\n\n"
+    "After that, other programs can use the dataset by passing "
+    "'shm://census' as a dataset filename.  Once the pipeline is done, the "
+    "segment can be removed with"
+    "\n\n" +
+    PRINT_CALL("shared_dataset", "name", "census", "unpublish", true));
+
+// See also...
+BINDING_SEE_ALSO("@preprocess_split", "#preprocess_split");
+BINDING_SEE_ALSO("@preprocess_describe", "#preprocess_describe");
+
+// Define parameters for data.
+PARAM_MATRIX_IN("input", "Dataset to publish.", "i");
+PARAM_STRING_IN_REQ("name", "Name to publish the dataset under.", "n");
+PARAM_FLAG("unpublish", "If set, remove the named shared dataset instead of "
+    "publishing one.", "u");
+
+using namespace mlpack;
+using namespace mlpack::util;
+using namespace arma;
+using namespace std;
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  const string name = params.Get<string>("name");
+
+  if (params.Has("unpublish"))
+  {
+    ReportIgnoredParam(params, {{ "unpublish", true }}, "input");
+
+    data::SharedDataset<double>::Unpublish(name, true);
+    return;
+  }
+
+  RequireAtLeastOnePassed(params, { "input" }, true,
+      "no dataset given to publish");
+
+  // Load the data.
+  arma::mat input = std::move(params.Get<arma::mat>("input"));
+
+  timers.Start("publishing_data");
+  data::SharedDataset<double>::Publish(name, input, true);
+  timers.Stop("publishing_data");
+}
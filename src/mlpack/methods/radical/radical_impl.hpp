@@ -71,24 +71,25 @@ inline double Radical::DoRadical2D(const arma::mat& matX,
   CopyAndPerturb(perturbed, matX);
   timers.Stop("radical_copy_and_perturb");
 
-  arma::mat::fixed<2, 2> matJacobi;
-
   arma::vec values(angles);
 
-  for (size_t i = 0; i < angles; ++i)
+  // The two base projections are shared read-only by every candidate angle;
+  // each rotated coordinate is just a linear combination of them, so there is
+  // no need to rebuild the full candidate matrix for each angle.
+  const arma::vec perturbedY1 = perturbed.unsafe_col(0);
+  const arma::vec perturbedY2 = perturbed.unsafe_col(1);
+
+  // Each angle is scored independently: the rotated coordinates are local to
+  // the iteration and each iteration writes only its own element of values.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) angles; ++i)
   {
     const double theta = (i / (double) angles) * M_PI / 2.0;
     const double cosTheta = cos(theta);
     const double sinTheta = sin(theta);
 
-    matJacobi(0, 0) = cosTheta;
-    matJacobi(1, 0) = -sinTheta;
-    matJacobi(0, 1) = sinTheta;
-    matJacobi(1, 1) = cosTheta;
-
-    candidate = perturbed * matJacobi;
-    arma::vec candidateY1 = candidate.unsafe_col(0);
-    arma::vec candidateY2 = candidate.unsafe_col(1);
+    arma::vec candidateY1 = cosTheta * perturbedY1 - sinTheta * perturbedY2;
+    arma::vec candidateY2 = sinTheta * perturbedY1 + cosTheta * perturbedY2;
 
     values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
   }
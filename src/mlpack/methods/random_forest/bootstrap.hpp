@@ -18,6 +18,9 @@ namespace tree {
 
 /**
  * Given a dataset, create another dataset via bootstrap sampling, with labels.
+ * The indices of the points that were not sampled are returned in oobIndices,
+ * so that the caller can compute out-of-bag statistics for whatever was
+ * trained on the bootstrap sample.
  */
 template<bool UseWeights,
          typename MatType,
@@ -28,20 +31,49 @@ void Bootstrap(const MatType& dataset,
                const WeightsType& weights,
                MatType& bootstrapDataset,
                LabelsType& bootstrapLabels,
-               WeightsType& bootstrapWeights)
+               WeightsType& bootstrapWeights,
+               arma::uvec& oobIndices)
 {
   bootstrapDataset.set_size(dataset.n_rows, dataset.n_cols);
   bootstrapLabels.set_size(labels.n_elem);
   if (UseWeights)
     bootstrapWeights.set_size(weights.n_elem);
 
-  // Random sampling with replacement.
-  arma::uvec indices = arma::randi<arma::uvec>(dataset.n_cols,
-      arma::distr_param(0, dataset.n_cols - 1));
+  // Random sampling with replacement.  We draw the indices from mlpack's
+  // thread-local RNG stream instead of Armadillo's global RNG, so that trees
+  // trained concurrently draw independent bootstrap samples.
+  arma::uvec indices(dataset.n_cols);
+  arma::Col<char> inBag(dataset.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    indices[i] = (arma::uword) math::RandInt((int) dataset.n_cols);
+    inBag[indices[i]] = 1;
+  }
   bootstrapDataset = dataset.cols(indices);
   bootstrapLabels = labels.cols(indices);
   if (UseWeights)
     bootstrapWeights = weights.cols(indices);
+
+  oobIndices = arma::find(inBag == 0);
+}
+
+/**
+ * Given a dataset, create another dataset via bootstrap sampling, with labels.
+ */
+template<bool UseWeights,
+         typename MatType,
+         typename LabelsType,
+         typename WeightsType>
+void Bootstrap(const MatType& dataset,
+               const LabelsType& labels,
+               const WeightsType& weights,
+               MatType& bootstrapDataset,
+               LabelsType& bootstrapLabels,
+               WeightsType& bootstrapWeights)
+{
+  arma::uvec oobIndices; // Ignored.
+  Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
+      bootstrapLabels, bootstrapWeights, oobIndices);
 }
 
 } // namespace tree
@@ -0,0 +1,129 @@
+/**
+ * @file methods/random_forest/flat_random_forest.hpp
+ * @author Ryan Curtin
+ *
+ * A read-only, flattened representation of a trained random forest, for
+ * low-latency scoring.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_RANDOM_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_RANDOM_FOREST_HPP
+
+#include <mlpack/methods/decision_tree/flat_decision_tree.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A FlatRandomForest holds a FlatDecisionTree for every tree of a trained
+ * RandomForest, so that scoring walks contiguous node arrays instead of
+ * chasing child pointers.  Its predictions match those of the forest it was
+ * built from: each tree contributes its leaf's class probabilities, and the
+ * predicted class is the one with the largest average probability.
+ *
+ * A flat forest is built from a trained forest with Build() (or the matching
+ * constructor) and holds its own copy of everything it needs, so it may
+ * outlive the forest it was built from.  It cannot be trained or modified; to
+ * pick up a retrained forest, build a new flat forest.
+ */
+class FlatRandomForest
+{
+ public:
+  /**
+   * Construct an empty flat forest; it cannot classify anything until Build()
+   * is called.
+   */
+  FlatRandomForest();
+
+  /**
+   * Construct a flat forest from the given trained random forest.
+   *
+   * @param forest Trained random forest to flatten.
+   */
+  template<typename ForestType>
+  explicit FlatRandomForest(const ForestType& forest);
+
+  /**
+   * Flatten the given trained random forest into this object, replacing
+   * anything that was built before.
+   *
+   * @param forest Trained random forest to flatten.
+   */
+  template<typename ForestType>
+  void Build(const ForestType& forest);
+
+  /**
+   * Classify the given point, returning the predicted label.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given point and also return estimates of the probability for
+   * each class in the given vector.
+   *
+   * @param point Point to classify.
+   * @param prediction This will be set to the predicted class of the point.
+   * @param probabilities This will be filled with class probabilities for the
+   *      point.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Classify the given points, storing the predicted labels in the given
+   * vector.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points and also return estimates of the probabilities
+   * for each class in the given matrix.  The predicted labels for each point
+   * are stored in the given vector.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities This will be filled with class probabilities for
+   *      each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Access a flattened tree in the forest.
+  const FlatDecisionTree& Tree(const size_t i) const { return trees[i]; }
+
+  //! Get the number of trees in the flat forest.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Get the number of classes in the flat forest.
+  size_t NumClasses() const { return numClasses; }
+
+ private:
+  //! The flattened trees of the forest.
+  std::vector<FlatDecisionTree> trees;
+  //! The number of classes in the forest.
+  size_t numClasses;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_random_forest_impl.hpp"
+
+#endif
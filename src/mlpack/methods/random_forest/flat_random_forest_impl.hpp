@@ -0,0 +1,134 @@
+/**
+ * @file methods/random_forest/flat_random_forest_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the FlatRandomForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_RANDOM_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_RANDOM_FOREST_IMPL_HPP
+
+#include "flat_random_forest.hpp"
+
+namespace mlpack {
+namespace tree {
+
+inline FlatRandomForest::FlatRandomForest() : numClasses(0)
+{
+  // Nothing to do here.
+}
+
+template<typename ForestType>
+FlatRandomForest::FlatRandomForest(const ForestType& forest)
+{
+  Build(forest);
+}
+
+template<typename ForestType>
+void FlatRandomForest::Build(const ForestType& forest)
+{
+  trees.resize(forest.NumTrees());
+  for (size_t i = 0; i < forest.NumTrees(); ++i)
+    trees[i].Build(forest.Tree(i));
+
+  numClasses = (trees.size() > 0) ? trees[0].NumClasses() : 0;
+}
+
+template<typename VecType>
+size_t FlatRandomForest::Classify(const VecType& point) const
+{
+  // Pass off to another Classify() overload.
+  size_t predictedClass;
+  arma::vec probabilities;
+  Classify(point, predictedClass, probabilities);
+
+  return predictedClass;
+}
+
+template<typename VecType>
+void FlatRandomForest::Classify(const VecType& point,
+                                size_t& prediction,
+                                arma::vec& probabilities) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    probabilities.clear();
+    prediction = 0;
+
+    throw std::invalid_argument("FlatRandomForest::Classify(): no flat forest "
+        "built!");
+  }
+
+  probabilities.zeros(numClasses);
+  for (size_t i = 0; i < trees.size(); ++i)
+  {
+    probabilities +=
+        trees[i].LeafProbabilities().col(trees[i].WalkToLeaf(point));
+  }
+
+  // Find maximum element after renormalizing probabilities.
+  probabilities /= trees.size();
+  arma::uword maxIndex = 0;
+  probabilities.max(maxIndex);
+
+  // Set prediction.
+  prediction = (size_t) maxIndex;
+}
+
+template<typename MatType>
+void FlatRandomForest::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+
+    throw std::invalid_argument("FlatRandomForest::Classify(): no flat forest "
+        "built!");
+  }
+
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < data.n_cols; ++i)
+  {
+    predictions[i] = Classify(data.col(i));
+  }
+}
+
+template<typename MatType>
+void FlatRandomForest::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions,
+                                arma::mat& probabilities) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+    probabilities.clear();
+
+    throw std::invalid_argument("FlatRandomForest::Classify(): no flat forest "
+        "built!");
+  }
+
+  probabilities.set_size(numClasses, data.n_cols);
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < data.n_cols; ++i)
+  {
+    arma::vec probs = probabilities.unsafe_col(i);
+    Classify(data.col(i), predictions[i], probs);
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -35,6 +35,11 @@ namespace tree {
  *   publisher={Springer}
  * }
  * @endcode
+ *
+ * Thread safety: all Classify() overloads are const and keep no scratch state
+ * on the object, so a trained forest may be used for prediction from many
+ * threads concurrently, as long as no thread concurrently calls Train() or
+ * modifies a tree through Tree().
  */
 template<typename FitnessFunction = GiniGain,
          typename DimensionSelectionType = MultipleRandomDimensionSelect,
@@ -361,6 +366,34 @@ class RandomForest
   //! Get the number of trees in the forest.
   size_t NumTrees() const { return trees.size(); }
 
+  /**
+   * Get the out-of-bag error of the forest: the misclassification rate of the
+   * training points under the majority vote of the trees that did not train
+   * on them.  The estimate is computed during Train() from the bootstrap
+   * samples, so it costs no separate holdout pass, and it accumulates across
+   * warm-start calls on the same dataset---so it can be used as a stopping
+   * signal when adding trees incrementally.  Only meaningful when
+   * bootstrapping is enabled (so not for ExtraTrees).
+   */
+  double OOBError() const { return oobError; }
+
+  /**
+   * Merge another forest into this one by appending its trees.  This allows
+   * map-reduce-style training, where forests are trained on different shards
+   * of the data and then combined; the relative weight of each shard is
+   * expressed by the number of trees it contributes, since classification
+   * averages the votes of all trees.  Both forests must have been trained on
+   * data with the same dimensions and classes (this is not checked).
+   *
+   * The average gain and the out-of-bag error become tree-count weighted
+   * averages of the two forests' values, and the accumulated out-of-bag
+   * votes are cleared (so a later warm-start Train() restarts the
+   * out-of-bag estimate).
+   *
+   * @param other Forest whose trees should be merged into this one.
+   */
+  void Merge(const RandomForest& other);
+
   /**
    * Serialize the random forest.
    */
@@ -408,6 +441,14 @@ class RandomForest
 
   //! The average gain of the forest.
   double avgGain;
+
+  //! The out-of-bag error of the forest (see OOBError()).
+  double oobError;
+  //! The accumulated out-of-bag votes for each training point (one column per
+  //! point), used to update oobError across warm-start Train() calls.  This
+  //! is not serialized, so warm-starting a loaded forest restarts the
+  //! out-of-bag estimate.
+  arma::mat oobVotes;
 };
 
 /**
@@ -32,7 +32,8 @@ RandomForest<
     CategoricalSplitType,
     UseBootstrap
 >::RandomForest() :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(0.0)
 {
   // Nothing to do here.
 }
@@ -59,7 +60,8 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(0.0)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored.
@@ -92,7 +94,8 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector):
-                    avgGain(0.0)
+                    avgGain(0.0),
+                    oobError(0.0)
 {
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
@@ -124,7 +127,8 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(0.0)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored by Train().
@@ -157,7 +161,8 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(0.0)
 {
   // Pass off work to the Train() method.
   Train<true, true>(dataset, datasetInfo, labels, numClasses, weights,
@@ -437,6 +442,40 @@ void RandomForest<
   }
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::Merge(const RandomForest& other)
+{
+  if (other.trees.size() == 0)
+    return;
+
+  // The gain and out-of-bag error of the combined forest are the tree-count
+  // weighted averages of the two forests' values.
+  const size_t oldNumTrees = trees.size();
+  const size_t newNumTrees = oldNumTrees + other.trees.size();
+  avgGain = (avgGain * oldNumTrees + other.avgGain * other.trees.size()) /
+      newNumTrees;
+  oobError = (oobError * oldNumTrees + other.oobError * other.trees.size()) /
+      newNumTrees;
+
+  // The accumulated out-of-bag votes only refer to this forest's own
+  // training set, so they cannot be carried across the merge.
+  oobVotes.clear();
+
+  trees.insert(trees.end(), other.trees.begin(), other.trees.end());
+}
+
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
@@ -467,6 +506,12 @@ void RandomForest<
 
   ar(CEREAL_NVP(trees));
   ar(CEREAL_NVP(avgGain));
+  ar(CEREAL_NVP(oobError));
+
+  // The accumulated out-of-bag votes are not serialized, so warm-starting a
+  // loaded forest restarts the out-of-bag estimate.
+  if (cereal::is_loading<Archive>())
+    oobVotes.clear();
 }
 
 template<
@@ -504,37 +549,68 @@ double RandomForest<
   // Convert avgGain to total gain.
   double totalGain = avgGain * oldNumTrees;
 
-  // Train each tree individually.
-  #pragma omp parallel for reduction( + : totalGain)
+  // Reset the out-of-bag vote accumulator, unless we are warm-starting on a
+  // dataset of the same shape; keeping the old votes makes the estimate cover
+  // the whole forest as trees are added incrementally.
+  if (UseBootstrap)
+  {
+    if (!warmStart || oobVotes.n_rows != numClasses ||
+        oobVotes.n_cols != dataset.n_cols)
+      oobVotes.zeros(numClasses, dataset.n_cols);
+  }
+
+  // Draw a seed for each tree's RNG stream up front, from the main thread's
+  // generator.  The thread-local generators of OpenMP worker threads are all
+  // default-seeded, so without this, concurrently-trained trees would draw
+  // identical bootstrap samples and dimension subsets; seeding per tree also
+  // makes the forest reproducible for a given initial seed regardless of the
+  // number of threads.
+  std::vector<uint32_t> treeSeeds(numTrees);
+  for (size_t i = 0; i < numTrees; ++i)
+    treeSeeds[i] = (uint32_t) math::RandGen()();
+
+  // Train each tree individually.  Each tree records its gain in its own
+  // slot; summing the slots in index order afterwards keeps the average gain
+  // reproducible regardless of which threads finish first (an OpenMP
+  // reduction may add in any order).
+  arma::vec treeGains(numTrees);
+  #pragma omp parallel for schedule(static)
   for (omp_size_t i = 0; i < numTrees; ++i)
   {
+    math::RandGen().seed(treeSeeds[i]);
+
+    // Each tree gets its own dimension selector, since the selectors are
+    // stateful and the trees train concurrently.
+    DimensionSelectionType treeSelector(dimensionSelector);
+
     MatType bootstrapDataset;
     arma::Row<size_t> bootstrapLabels;
     arma::rowvec bootstrapWeights;
+    arma::uvec oobIndices;
     if (UseBootstrap)
     {
       Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-          bootstrapLabels, bootstrapWeights);
+          bootstrapLabels, bootstrapWeights, oobIndices);
     }
 
     if (UseWeights)
     {
       if (UseDatasetInfo)
       {
-        totalGain += UseBootstrap ?
+        treeGains[i] = UseBootstrap ?
             trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
                 bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
+                minimumGainSplit, maximumDepth, treeSelector) :
             trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
                 numClasses, weights, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector);
+                maximumDepth, treeSelector);
       }
       else
       {
-        totalGain += UseBootstrap ?
+        treeGains[i] = UseBootstrap ?
             trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
                 numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
+                minimumGainSplit, maximumDepth, treeSelector) :
             trees[oldNumTrees + i].Train(dataset, labels, numClasses,
                 weights, minimumLeafSize, minimumGainSplit, maximumDepth,
                 dimensionSelector);
@@ -544,17 +620,17 @@ double RandomForest<
     {
       if (UseDatasetInfo)
       {
-        totalGain += UseBootstrap ?
+        treeGains[i] = UseBootstrap ?
             trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
                 bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector) :
+                maximumDepth, treeSelector) :
             trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
                 numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
                 dimensionSelector);
       }
       else
       {
-        totalGain += UseBootstrap ?
+        treeGains[i] = UseBootstrap ?
             trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
                 numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
                 dimensionSelector) :
@@ -563,6 +639,43 @@ double RandomForest<
                 dimensionSelector);
       }
     }
+
+    if (UseBootstrap)
+    {
+      // Collect the tree's votes on the points it did not train on; these
+      // form the out-of-bag estimate of the forest's accuracy.
+      const DecisionTreeType& tree = trees[oldNumTrees + i];
+      arma::Row<size_t> oobPredictions(oobIndices.n_elem);
+      for (size_t j = 0; j < oobIndices.n_elem; ++j)
+        oobPredictions[j] = tree.Classify(dataset.col(oobIndices[j]));
+
+      #pragma omp critical (RandomForestOOBVotes)
+      {
+        for (size_t j = 0; j < oobIndices.n_elem; ++j)
+          oobVotes(oobPredictions[j], oobIndices[j]) += 1.0;
+      }
+    }
+  }
+
+  totalGain += arma::accu(treeGains);
+
+  if (UseBootstrap)
+  {
+    // The out-of-bag error is the misclassification rate, under majority
+    // vote, of the training points that at least one tree did not train on.
+    size_t wrong = 0;
+    size_t voted = 0;
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      if (arma::accu(oobVotes.col(i)) == 0.0)
+        continue;
+
+      ++voted;
+      if ((size_t) oobVotes.col(i).index_max() != labels[i])
+        ++wrong;
+    }
+
+    oobError = (voted > 0) ? ((double) wrong / (double) voted) : 0.0;
   }
 
   avgGain = totalGain / trees.size();
@@ -21,6 +21,7 @@
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/methods/random_forest/random_forest.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
+#include <mlpack/core/data/stream_csv.hpp>
 
 using namespace mlpack;
 using namespace mlpack::math;
@@ -141,11 +142,20 @@ PARAM_INT_IN("subspace_dim", "Dimensionality of random subspace to use for "
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 PARAM_FLAG("warm_start", "If true and passed along with `training` and "
     "`input_model` then trains more trees on top of existing model.", "w");
+PARAM_FLAG("stream", "If set, test points are additionally read from standard "
+    "input as CSV rows (one point per row), and the predicted class of each "
+    "point is written to standard output as soon as its chunk of input has "
+    "been read, so data can be piped through a model without temporary "
+    "files.", "S");
 
 /**
  * This is the class that we will serialize.  It is a pretty simple wrapper
  * around DecisionTree<>.  In order to support categoricals, it will need to
  * also hold and serialize a DatasetInfo.
+ *
+ * A loaded model may be used for prediction from many threads at once:
+ * RandomForest::Classify() is const and keeps no scratch state on the model
+ * (see the RandomForest class documentation).
  */
 class RandomForestModel
 {
@@ -194,8 +204,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "test", false }}, "test_labels");
 
   RequireAtLeastOnePassed(params, { "test", "output_model",
-      "print_training_accuracy" }, false, "the trained forest model will not "
-      "be used or saved");
+      "print_training_accuracy", "stream" }, false, "the trained forest model "
+      "will not be used or saved");
 
   if (params.Has("training"))
   {
@@ -312,6 +322,24 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     params.Get<arma::Row<size_t>>("predictions") = std::move(predictions);
   }
 
+  // Streaming prediction: read chunks of CSV rows from standard input and
+  // emit each chunk's predictions to standard output immediately.
+  if (params.Has("stream"))
+  {
+    data::StreamingCSVReader reader(std::cin);
+    arma::mat chunk;
+    arma::Row<size_t> chunkPredictions;
+    timers.Start("rf_stream_prediction");
+    while (reader.ReadChunk(chunk))
+    {
+      rfModel->rf.Classify(chunk, chunkPredictions);
+      for (size_t i = 0; i < chunkPredictions.n_elem; ++i)
+        std::cout << chunkPredictions[i] << "\n";
+      std::cout << std::flush;
+    }
+    timers.Stop("rf_stream_prediction");
+  }
+
   // Save the output model.
   params.Get<RandomForestModel*>("output_model") = rfModel;
 }
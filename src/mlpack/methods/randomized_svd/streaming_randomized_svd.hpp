@@ -0,0 +1,204 @@
+/**
+ * @file methods/randomized_svd/streaming_randomized_svd.hpp
+ * @author Marcus Edel
+ *
+ * An implementation of a single-pass (streaming) randomized SVD method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_RANDOMIZED_SVD_STREAMING_RANDOMIZED_SVD_HPP
+#define MLPACK_METHODS_RANDOMIZED_SVD_STREAMING_RANDOMIZED_SVD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * StreamingRandomizedSVD computes an approximate truncated SVD in a single
+ * pass over the input matrix, which is consumed in column blocks.  Unlike
+ * RandomizedSVD, which needs the whole matrix in RAM and revisits it once per
+ * power iteration, this method only ever holds one column block plus two
+ * small sketch matrices, so it can factor matrices much larger than RAM when
+ * the blocks are produced from out-of-core storage.
+ *
+ * The algorithm maintains a range sketch Y = A * Omega and a co-range sketch
+ * W = Psi * A, both accumulated block by block; after the pass, an in-memory
+ * QR of the range sketch and one small least squares solve recover the
+ * factorization.  This is the practical sketching scheme of:
+ *
+ * @code
+ * @article{Tropp2017,
+ *   author  = {Tropp, J. A. and Yurtsever, A. and Udell, M. and Cevher, V.},
+ *   title   = {Practical Sketching Algorithms for Low-Rank Matrix
+ *              Approximation},
+ *   journal = {SIAM J. Matrix Anal. Appl.},
+ *   volume  = {38},
+ *   year    = {2017},
+ * }
+ * @endcode
+ *
+ * The single pass comes at an accuracy cost relative to RandomizedSVD's power
+ * iterations; the oversampling parameter trades sketch memory for accuracy.
+ *
+ * An example of how to use the interface with an in-memory matrix is shown
+ * below; for out-of-core use, pass a block function that reads the requested
+ * columns from storage instead.
+ *
+ * @code
+ * arma::mat data; // Data matrix.
+ *
+ * const size_t rank = 20; // Rank used for the decomposition.
+ *
+ * // Make a StreamingRandomizedSVD object.
+ * StreamingRandomizedSVD sSVD;
+ *
+ * arma::mat u, v;
+ * arma::vec s;
+ *
+ * // Use the Apply() method to get a factorization.
+ * sSVD.Apply(data, u, s, v, rank);
+ * @endcode
+ */
+class StreamingRandomizedSVD
+{
+ public:
+  /**
+   * Create object for the streaming randomized SVD method.
+   *
+   * @param oversampling Number of extra sketch dimensions beyond the rank;
+   *        larger values give a more accurate sketch at the cost of memory.
+   * @param blockSize Number of columns consumed per block (Default: 1024).
+   */
+  StreamingRandomizedSVD(const size_t oversampling = 10,
+                         const size_t blockSize = 1024) :
+      oversampling(oversampling),
+      blockSize(blockSize)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Apply the single-pass randomized SVD to a matrix produced in column
+   * blocks by the given block function.  The block function is called with
+   * the index of the first column and a matrix to fill; it must fill the
+   * matrix (which is already sized to numRows x the block's column count)
+   * with the requested consecutive columns of the input.  Each column range
+   * is requested exactly once, in order, so the producer can stream the
+   * matrix from out-of-core storage.
+   *
+   * @param numRows Number of rows of the input matrix.
+   * @param numCols Number of columns of the input matrix.
+   * @param blockFn Function filling a block with the requested columns.
+   * @param u First unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param v Second unitary matrix.
+   * @param rank Rank of the approximation.
+   */
+  template<typename BlockFunctionType>
+  void Apply(const size_t numRows,
+             const size_t numCols,
+             BlockFunctionType blockFn,
+             arma::mat& u,
+             arma::vec& s,
+             arma::mat& v,
+             const size_t rank)
+  {
+    // The range sketch has k columns and the co-range sketch has l rows;
+    // l >= 2k is the recommendation of the paper.
+    const size_t k = std::min(rank + oversampling, std::min(numRows, numCols));
+    const size_t l = std::min(2 * k + 1, numRows);
+
+    // The co-range test matrix spans all rows, so it is drawn up front; the
+    // range test matrix Omega is drawn one row block per column block, which
+    // avoids ever materializing all numCols rows of it.
+    const arma::mat psi = arma::randn<arma::mat>(l, numRows);
+
+    arma::mat y(numRows, k, arma::fill::zeros); // Range sketch A * Omega.
+    arma::mat w(l, numCols);                    // Co-range sketch Psi * A.
+
+    arma::mat block;
+    for (size_t begin = 0; begin < numCols; begin += blockSize)
+    {
+      const size_t cols = std::min(blockSize, numCols - begin);
+      block.set_size(numRows, cols);
+      blockFn(begin, block);
+
+      y += block * arma::randn<arma::mat>(cols, k);
+      w.cols(begin, begin + cols - 1) = psi * block;
+    }
+
+    // Form an orthonormal basis Q for the range sketch; then A ~ Q * B with
+    // B the least squares solution of (Psi * Q) * B = W.
+    arma::mat q, r;
+    arma::qr_econ(q, r, y);
+    const arma::mat b = arma::solve(psi * q, w);
+
+    // Do economical singular value decomposition of the small matrix B and
+    // lift the left singular vectors through Q.
+    arma::svd_econ(u, s, v, b);
+    u = q * u;
+
+    // Truncate to the requested rank.
+    if (rank < s.n_elem)
+    {
+      u = u.cols(0, rank - 1);
+      s = s.subvec(0, rank - 1);
+      v = v.cols(0, rank - 1);
+    }
+  }
+
+  /**
+   * Apply the single-pass randomized SVD to an in-memory matrix, consuming it
+   * in column blocks.  This is mainly useful for testing the streaming path;
+   * if the matrix fits in RAM, RandomizedSVD with power iterations is more
+   * accurate.
+   *
+   * @param data Data matrix.
+   * @param u First unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param v Second unitary matrix.
+   * @param rank Rank of the approximation.
+   */
+  template<typename MatType>
+  void Apply(const MatType& data,
+             arma::mat& u,
+             arma::vec& s,
+             arma::mat& v,
+             const size_t rank)
+  {
+    Apply(data.n_rows, data.n_cols,
+        [&data](const size_t begin, arma::mat& block)
+        {
+          block = arma::conv_to<arma::mat>::from(
+              data.cols(begin, begin + block.n_cols - 1));
+        },
+        u, s, v, rank);
+  }
+
+  //! Get the number of extra sketch dimensions.
+  size_t Oversampling() const { return oversampling; }
+  //! Modify the number of extra sketch dimensions.
+  size_t& Oversampling() { return oversampling; }
+
+  //! Get the number of columns consumed per block.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of columns consumed per block.
+  size_t& BlockSize() { return blockSize; }
+
+ private:
+  //! Locally stored number of extra sketch dimensions beyond the rank.
+  size_t oversampling;
+
+  //! Locally stored number of columns consumed per block.
+  size_t blockSize;
+};
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
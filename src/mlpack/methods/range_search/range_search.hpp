@@ -268,6 +268,51 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, invoking the given callback for each pair found instead of
+   * materializing result vectors.  The callback must be callable as
+   *
+   * @code
+   * callback(queryIndex, referenceIndex, distance);
+   * @endcode
+   *
+   * where queryIndex and referenceIndex are size_t indices into the original
+   * (unpermuted) query and reference sets and distance is a double.  Pairs
+   * are reported in no particular order, and nothing is allocated for the
+   * results, so this is the overload to use when the range is dense and the
+   * materialized results would not fit in memory (e.g. for DBSCAN-style
+   * consumers that can process matches on the fly).
+   *
+   * When OpenMP is enabled, the traversal is parallelized over query points
+   * and the callback may be invoked from several threads at once, so it must
+   * be safe to call concurrently; however, no two concurrent invocations will
+   * ever share a query index.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param callback Functor to invoke for each pair found.
+   */
+  template<typename CallbackType>
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              CallbackType& callback);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set (which was passed to the constructor), invoking the given callback
+   * for each pair found instead of materializing result vectors.  This means
+   * that the query set and the reference set are the same; a query point will
+   * not be reported as its own neighbor.  See the bichromatic callback
+   * overload of Search() for the callback signature and its thread-safety
+   * requirements.
+   *
+   * @param range Range of distances in which to search.
+   * @param callback Functor to invoke for each pair found.
+   */
+  template<typename CallbackType>
+  void Search(const math::Range& range, CallbackType& callback);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -42,6 +42,44 @@ TreeType* BuildTree(
   return new TreeType(std::forward<MatType>(dataset));
 }
 
+//! Utility functor for the callback overloads of Search().  Trees may
+//! rearrange the points of the datasets they are built on, so this maps
+//! rearranged indices back to their original indices before invoking the
+//! user's callback.  Either map may be NULL if no mapping is necessary.
+template<typename CallbackType>
+class MappedRangeSearchCallback
+{
+ public:
+  //! Construct with the user's callback and the index mappings to apply.
+  MappedRangeSearchCallback(CallbackType& callback,
+                            const std::vector<size_t>* queryMap,
+                            const std::vector<size_t>* refMap) :
+      callback(callback),
+      queryMap(queryMap),
+      refMap(refMap)
+  {
+    // Nothing to do.
+  }
+
+  //! Map the indices of a single result pair and report it.
+  void operator()(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const double distance)
+  {
+    callback(queryMap ? (*queryMap)[queryIndex] : queryIndex,
+             refMap ? (*refMap)[referenceIndex] : referenceIndex,
+             distance);
+  }
+
+ private:
+  //! The user's callback.
+  CallbackType& callback;
+  //! Mappings to old query indices (or NULL).
+  const std::vector<size_t>* queryMap;
+  //! Mappings to old reference indices (or NULL).
+  const std::vector<size_t>* refMap;
+};
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
@@ -352,8 +390,9 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distancePtr->clear();
   distancePtr->resize(querySet.n_cols);
 
-  // Create the helper object for the traversal.
+  // Create the helper objects for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
+  VectorResultCallback resultCallback(*neighborPtr, *distancePtr);
 
   // Reset counts.
   baseCases = 0;
@@ -361,8 +400,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, resultCallback, metric);
 
     // The naive brute-force solution.
     for (size_t i = 0; i < querySet.n_cols; ++i)
@@ -374,8 +412,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   else if (singleMode)
   {
     // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, resultCallback, metric);
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
     // Now have it traverse for each point.
@@ -391,8 +428,8 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
 
     // Create the traverser.
-    RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, metric);
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, resultCallback,
+        metric);
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     traverser.Traverse(*queryTree, *referenceTree);
@@ -506,10 +543,11 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distances.clear();
   distances.resize(querySet.n_cols);
 
-  // Create the helper object for the traversal.
+  // Create the helper objects for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-      distances, metric);
+  VectorResultCallback resultCallback(*neighborPtr, distances);
+  RuleType rules(*referenceSet, queryTree->Dataset(), range, resultCallback,
+      metric);
 
   // Create the traverser.
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
@@ -569,10 +607,11 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distancePtr->clear();
   distancePtr->resize(referenceSet->n_cols);
 
-  // Create the helper object for the traversal.
+  // Create the helper objects for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
+  VectorResultCallback resultCallback(*neighborPtr, *distancePtr);
+  RuleType rules(*referenceSet, *referenceSet, range, resultCallback, metric,
+      true /* don't return the query in the results */);
 
   if (naive)
   {
@@ -635,6 +674,310 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    CallbackType& callback)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Search()", "query set");
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+#ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+#else
+  const size_t numThreads = 1;
+#endif
+
+  // Reference indices must be mapped back to their original order if we built
+  // the reference tree ourselves.
+  const std::vector<size_t>* refMap =
+      (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  // The index mapping is applied before the user's callback is invoked, so
+  // results are streamed without any post-processing pass.
+  typedef MappedRangeSearchCallback<CallbackType> MappedCallback;
+  typedef RangeSearchRules<MetricType, Tree, MappedCallback> RuleType;
+
+  size_t totalBaseCases = 0;
+  size_t totalScores = 0;
+
+  if (naive)
+  {
+    // The naive brute-force solution; each thread handles a contiguous block
+    // of query points.
+    #pragma omp parallel for schedule(static) reduction(+: totalBaseCases)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (querySet.n_cols * t) / numThreads;
+      const size_t blockEnd = (querySet.n_cols * (t + 1)) / numThreads;
+
+      MappedCallback mappedCallback(callback, NULL, refMap);
+      RuleType rules(*referenceSet, querySet, range, mappedCallback, metric);
+
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+
+      totalBaseCases += (blockEnd - blockBegin) * referenceSet->n_cols;
+    }
+  }
+  else if (singleMode)
+  {
+    // Each thread traverses for a contiguous block of query points with its
+    // own rule set and traverser.
+    #pragma omp parallel for schedule(static) \
+        reduction(+: totalBaseCases, totalScores)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (querySet.n_cols * t) / numThreads;
+      const size_t blockEnd = (querySet.n_cols * (t + 1)) / numThreads;
+      if (blockBegin == blockEnd)
+        continue;
+
+      MappedCallback mappedCallback(callback, NULL, refMap);
+      RuleType rules(*referenceSet, querySet, range, mappedCallback, metric);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+    }
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree.
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+
+    // Query indices need to be mapped if the tree rearranged the query set.
+    const std::vector<size_t>* queryMap =
+        tree::TreeTraits<Tree>::RearrangesDataset ? &oldFromNewQueries : NULL;
+
+    if (numThreads == 1)
+    {
+      MappedCallback mappedCallback(callback, queryMap, refMap);
+      RuleType rules(*referenceSet, queryTree->Dataset(), range,
+          mappedCallback, metric);
+      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+      traverser.Traverse(*queryTree, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+    }
+    else
+    {
+      // Collect a frontier of disjoint query subtrees to traverse in
+      // parallel---several per thread, so that uneven subtree costs balance
+      // out.  The largest frontier node is expanded first.
+      std::vector<Tree*> frontier(1, queryTree);
+      while (frontier.size() < 4 * numThreads)
+      {
+        size_t largest = frontier.size();
+        for (size_t i = 0; i < frontier.size(); ++i)
+        {
+          if (frontier[i]->NumChildren() > 0 &&
+              (largest == frontier.size() ||
+               frontier[i]->NumDescendants() >
+                   frontier[largest]->NumDescendants()))
+            largest = i;
+        }
+
+        // If every frontier node is a leaf, we cannot expand further.
+        if (largest == frontier.size())
+          break;
+
+        Tree* node = frontier[largest];
+        frontier[largest] = &node->Child(0);
+        for (size_t c = 1; c < node->NumChildren(); ++c)
+          frontier.push_back(&node->Child(c));
+      }
+
+      // Each subtree traversal gets its own rule set; a subtree's query
+      // points are disjoint from every other subtree's, so no two threads
+      // report results for the same query point.
+      #pragma omp parallel for schedule(dynamic) \
+          reduction(+: totalBaseCases, totalScores)
+      for (omp_size_t t = 0; t < (omp_size_t) frontier.size(); ++t)
+      {
+        MappedCallback mappedCallback(callback, queryMap, refMap);
+        RuleType rules(*referenceSet, queryTree->Dataset(), range,
+            mappedCallback, metric);
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+        traverser.Traverse(*frontier[t], *referenceTree);
+
+        totalBaseCases += rules.BaseCases();
+        totalScores += rules.Scores();
+      }
+    }
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+
+  baseCases = totalBaseCases;
+  scores = totalScores;
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    CallbackType& callback)
+{
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+#ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+#else
+  const size_t numThreads = 1;
+#endif
+
+  // Here, we will use the query set as the reference set, so both query and
+  // reference indices are mapped with the reference mappings (if we built the
+  // reference tree ourselves).
+  const std::vector<size_t>* refMap =
+      (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  typedef MappedRangeSearchCallback<CallbackType> MappedCallback;
+  typedef RangeSearchRules<MetricType, Tree, MappedCallback> RuleType;
+
+  size_t totalBaseCases = 0;
+  size_t totalScores = 0;
+
+  if (naive)
+  {
+    // The naive brute-force solution; each thread handles a contiguous block
+    // of query points.
+    #pragma omp parallel for schedule(static) reduction(+: totalBaseCases)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (referenceSet->n_cols * t) / numThreads;
+      const size_t blockEnd = (referenceSet->n_cols * (t + 1)) / numThreads;
+
+      MappedCallback mappedCallback(callback, refMap, refMap);
+      RuleType rules(*referenceSet, *referenceSet, range, mappedCallback,
+          metric, true /* don't return the query in the results */);
+
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+
+      totalBaseCases += (blockEnd - blockBegin) * referenceSet->n_cols;
+    }
+  }
+  else if (singleMode)
+  {
+    // Each thread traverses for a contiguous block of query points with its
+    // own rule set and traverser.
+    #pragma omp parallel for schedule(static) \
+        reduction(+: totalBaseCases, totalScores)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t blockBegin = (referenceSet->n_cols * t) / numThreads;
+      const size_t blockEnd = (referenceSet->n_cols * (t + 1)) / numThreads;
+      if (blockBegin == blockEnd)
+        continue;
+
+      MappedCallback mappedCallback(callback, refMap, refMap);
+      RuleType rules(*referenceSet, *referenceSet, range, mappedCallback,
+          metric, true /* don't return the query in the results */);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+      for (size_t i = blockBegin; i < blockEnd; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+    }
+  }
+  else // Dual-tree recursion.
+  {
+    if (numThreads == 1)
+    {
+      MappedCallback mappedCallback(callback, refMap, refMap);
+      RuleType rules(*referenceSet, *referenceSet, range, mappedCallback,
+          metric, true /* don't return the query in the results */);
+      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+      traverser.Traverse(*referenceTree, *referenceTree);
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+    }
+    else
+    {
+      // Collect a frontier of disjoint query subtrees to traverse in
+      // parallel---several per thread, so that uneven subtree costs balance
+      // out.  The largest frontier node is expanded first.
+      std::vector<Tree*> frontier(1, referenceTree);
+      while (frontier.size() < 4 * numThreads)
+      {
+        size_t largest = frontier.size();
+        for (size_t i = 0; i < frontier.size(); ++i)
+        {
+          if (frontier[i]->NumChildren() > 0 &&
+              (largest == frontier.size() ||
+               frontier[i]->NumDescendants() >
+                   frontier[largest]->NumDescendants()))
+            largest = i;
+        }
+
+        // If every frontier node is a leaf, we cannot expand further.
+        if (largest == frontier.size())
+          break;
+
+        Tree* node = frontier[largest];
+        frontier[largest] = &node->Child(0);
+        for (size_t c = 1; c < node->NumChildren(); ++c)
+          frontier.push_back(&node->Child(c));
+      }
+
+      // Each subtree traversal gets its own rule set; a subtree's query
+      // points are disjoint from every other subtree's, so no two threads
+      // report results for the same query point.
+      #pragma omp parallel for schedule(dynamic) \
+          reduction(+: totalBaseCases, totalScores)
+      for (omp_size_t t = 0; t < (omp_size_t) frontier.size(); ++t)
+      {
+        MappedCallback mappedCallback(callback, refMap, refMap);
+        RuleType rules(*referenceSet, *referenceSet, range, mappedCallback,
+            metric, true /* don't return the query in the results */);
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+        traverser.Traverse(*frontier[t], *referenceTree);
+
+        totalBaseCases += rules.BaseCases();
+        totalScores += rules.Scores();
+      }
+    }
+  }
+
+  baseCases = totalBaseCases;
+  scores = totalScores;
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
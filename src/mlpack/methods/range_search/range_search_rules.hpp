@@ -13,18 +13,60 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <unordered_map>
 
 namespace mlpack {
 namespace range {
 
+/**
+ * A result callback for range search which appends each result pair to
+ * per-query result vectors.  This is the default callback type, and produces
+ * the materialized output returned by the vector-based overloads of
+ * RangeSearch::Search().
+ */
+class VectorResultCallback
+{
+ public:
+  //! Construct with the output vectors that results will be appended to.
+  VectorResultCallback(std::vector<std::vector<size_t>>& neighbors,
+                       std::vector<std::vector<double>>& distances) :
+      neighbors(neighbors),
+      distances(distances)
+  {
+    // Nothing to do.
+  }
+
+  //! Append a single result pair to the output vectors.
+  void operator()(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const double distance)
+  {
+    neighbors[queryIndex].push_back(referenceIndex);
+    distances[queryIndex].push_back(distance);
+  }
+
+ private:
+  //! The vector the resultant neighbor indices are stored in.
+  std::vector<std::vector<size_t>>& neighbors;
+  //! The vector the resultant neighbor distances are stored in.
+  std::vector<std::vector<double>>& distances;
+};
+
 /**
  * The RangeSearchRules class is a template helper class used by RangeSearch
- * class when performing range searches.
+ * class when performing range searches.  Results are not stored by the rules
+ * themselves; instead, every pair found in the range is reported to the given
+ * callback, which may either materialize the results (see
+ * VectorResultCallback) or process them on the fly.
  *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam CallbackType Functor invoked as callback(queryIndex, referenceIndex,
+ *      distance) for every pair found in the range.
  */
-template<typename MetricType, typename TreeType>
+template<typename MetricType,
+         typename TreeType,
+         typename CallbackType = VectorResultCallback>
 class RangeSearchRules
 {
  public:
@@ -35,8 +77,7 @@ class RangeSearchRules
    * @param referenceSet Set of reference data.
    * @param querySet Set of query data.
    * @param range Range to search for.
-   * @param neighbors Vector to store resulting neighbors in.
-   * @param distances Vector to store resulting distances in.
+   * @param callback Functor to invoke for every pair found in the range.
    * @param metric Instantiated metric.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
@@ -44,8 +85,7 @@ class RangeSearchRules
   RangeSearchRules(const arma::mat& referenceSet,
                    const arma::mat& querySet,
                    const math::Range& range,
-                   std::vector<std::vector<size_t> >& neighbors,
-                   std::vector<std::vector<double> >& distances,
+                   CallbackType& callback,
                    MetricType& metric,
                    const bool sameSet = false);
 
@@ -131,11 +171,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const math::Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The functor each result pair is reported to.
+  CallbackType& callback;
 
   //! The instantiated metric.
   MetricType& metric;
@@ -148,6 +185,12 @@ class RangeSearchRules
   //! The last reference index.
   size_t lastReferenceIndex;
 
+  //! The base case evaluation between each scored reference node's first point
+  //! and the current query, used when a self-child is scored.  This is stored
+  //! here instead of in the tree statistics so that several rule sets can
+  //! traverse the same reference tree concurrently.
+  std::unordered_map<const TreeType*, double> lastDistances;
+
   //! Add all the points in the given node to the results for the given query
   //! point.  If the base case has already been calculated, we make sure to not
   //! add that to the results twice.
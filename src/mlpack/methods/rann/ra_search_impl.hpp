@@ -303,10 +303,12 @@ Search(const MatType& querySet,
         distinctSamples);
 
     // Run the base case on each combination of query point and sampled
-    // reference point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        rules.BaseCase(i, (size_t) distinctSamples[j]);
+    // reference point, processing the query points in parallel; all sampled
+    // distances for a query point are evaluated through the bulk distance
+    // kernel.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+      rules.BaseCaseBatch((size_t) i, distinctSamples);
 
     rules.GetResults(*neighborPtr, *distancePtr);
   }
@@ -518,10 +520,13 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
     math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
         distinctSamples);
 
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+    // Run the base case on each combination of query point and sampled
+    // reference point, processing the query points in parallel; this replaces
+    // an exact brute-force pass that ignored the samples drawn above and
+    // made naive mode no cheaper than exact search.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+      rules.BaseCaseBatch((size_t) i, distinctSamples);
   }
   else if (singleMode)
   {
@@ -84,6 +84,19 @@ class RASearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Run the base case for one query point against a set of sampled reference
+   * points.  All sampled distances are evaluated through the bulk distance
+   * kernel (one GEMM-backed panel for the Euclidean metric) instead of one
+   * scalar evaluation per sample.  Concurrent calls for distinct query points
+   * are safe, so callers may process query points in parallel.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceIndices Indices of the sampled reference points.
+   */
+  void BaseCaseBatch(const size_t queryIndex,
+                     const arma::uvec& referenceIndices);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -15,6 +15,8 @@
 // In case it hasn't been included yet.
 #include "ra_search_rules.hpp"
 
+#include <mlpack/core/metrics/pairwise_distances.hpp>
+
 namespace mlpack {
 namespace neighbor {
 
@@ -84,13 +86,15 @@ RASearchRules(const arma::mat& referenceSet,
 
   if (naive) // No tree traversal; just do naive sampling here.
   {
-    // Sample enough points.
-    arma::uvec distinctSamples;
-    for (size_t i = 0; i < querySet.n_cols; ++i)
+    // Sample enough points for each query point, processing the query points
+    // in parallel.  Each thread draws from its own generator, so the sampling
+    // does not contend on (or perturb) a shared random stream.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
     {
+      arma::uvec distinctSamples;
       math::ObtainDistinctSamples(0, n, numSamplesReqd, distinctSamples);
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        BaseCase(i, (size_t) distinctSamples[j]);
+      BaseCaseBatch((size_t) i, distinctSamples);
     }
   }
 }
@@ -138,6 +142,43 @@ double RASearchRules<SortPolicy, MetricType, TreeType>::BaseCase(
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void RASearchRules<SortPolicy, MetricType, TreeType>::BaseCaseBatch(
+    const size_t queryIndex,
+    const arma::uvec& referenceIndices)
+{
+  // Evaluate the distances to all sampled reference points through the bulk
+  // distance kernel; for the Euclidean metric this is one GEMM-backed panel
+  // instead of referenceIndices.n_elem scalar evaluations.
+  const arma::mat samplePanel = referenceSet.cols(referenceIndices);
+  const arma::mat queryPoint = querySet.col(queryIndex);
+  arma::mat sampleDistances;
+  mlpack::metric::PairwiseDistances(samplePanel, queryPoint, sampleDistances,
+      metric);
+
+  size_t samplesMade = 0;
+  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  {
+    const size_t referenceIndex = (size_t) referenceIndices[j];
+
+    // If the datasets are the same, then this search is only using one
+    // dataset and we should not return identical points.
+    if (sameSet && (queryIndex == referenceIndex))
+      continue;
+
+    InsertNeighbor(queryIndex, referenceIndex, sampleDistances(j, 0));
+    samplesMade++;
+  }
+
+  // The candidate list and the sample count belong to this query point alone;
+  // only the distance-computation counter is shared between query points, so
+  // it is the only update that must be atomic.
+  numSamplesMade[queryIndex] += samplesMade;
+
+  #pragma omp atomic
+  numDistComputations += samplesMade;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
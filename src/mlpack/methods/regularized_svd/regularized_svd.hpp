@@ -18,6 +18,7 @@
 #include <mlpack/methods/cf/cf.hpp>
 
 #include "regularized_svd_function.hpp"
+#include "sharded_sgd.hpp"
 
 namespace mlpack {
 namespace svd {
@@ -85,6 +86,28 @@ class RegularizedSVD
              arma::mat& u,
              arma::mat& v);
 
+  /**
+   * Obtains the user and item matrices using the provided data and rank,
+   * optionally starting the optimization from the factor matrices of a
+   * previous decomposition.  If warmStart is set but the passed u and v do
+   * not match the rank and the numbers of users and items in the data (e.g.
+   * on the very first fit), random initialization is used instead.  Training
+   * uses parallel sharded SGD over disjoint user blocks (ShardedSGD), so
+   * repeated refits on slightly changed data converge much faster than
+   * training from scratch.
+   *
+   * @param data Rating data matrix.
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix: starting point and output of decomposition.
+   * @param v User matrix: starting point and output of decomposition.
+   * @param warmStart If true, start the optimization from the passed u and v.
+   */
+  void Apply(const arma::mat& data,
+             const size_t rank,
+             arma::mat& u,
+             arma::mat& v,
+             const bool warmStart);
+
  private:
   //! Number of optimization iterations.
   size_t iterations;
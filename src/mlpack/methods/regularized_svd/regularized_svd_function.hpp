@@ -94,6 +94,20 @@ class RegularizedSVDFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Apply a single SGD update for the given rating.  This is the update rule
+   * used by ShardedSGD: the caller must guarantee that no other thread is
+   * concurrently updating the column of this rating's user, while the item
+   * column may be shared between threads and is therefore written atomically.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param index Index of the rating to use for the update.
+   * @param stepSize Step size of the SGD update.
+   */
+  void ShardedUpdate(arma::mat& parameters,
+                     const size_t index,
+                     const double stepSize) const;
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
@@ -150,6 +150,37 @@ void RegularizedSVDFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void RegularizedSVDFunction<MatType>::ShardedUpdate(
+    arma::mat& parameters,
+    const size_t index,
+    const double stepSize) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, index);
+  const size_t item = data(1, index) + numUsers;
+
+  // Prediction error for the example.
+  const double rating = data(2, index);
+  const double ratingError = rating - arma::dot(parameters.col(user),
+                                                parameters.col(item));
+
+  const arma::vec itemUpdate = stepSize * (lambda * parameters.col(item) -
+      ratingError * parameters.col(user));
+
+  // The caller guarantees exclusive access to the user's column, so it can be
+  // written directly.
+  parameters.col(user) -= stepSize * (lambda * parameters.col(user) -
+                                      ratingError * parameters.col(item));
+
+  // The item column may be shared with other shards.
+  for (size_t j = 0; j < rank; ++j)
+  {
+    #pragma omp atomic
+    parameters(j, item) -= itemUpdate(j);
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
 
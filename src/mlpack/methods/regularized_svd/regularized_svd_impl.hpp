@@ -57,6 +57,50 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
   v = parameters.submat(0, 0, rank - 1, numUsers - 1);
 }
 
+template<typename OptimizerType>
+void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
+                                          const size_t rank,
+                                          arma::mat& u,
+                                          arma::mat& v,
+                                          const bool warmStart)
+{
+  // Make the optimizer object using a RegularizedSVDFunction object.
+  RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
+  ShardedSGD optimizer(alpha, iterations * data.n_cols);
+
+  // Constants for assembling and extracting user and item matrices.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+
+  // Seed the parameters from the passed factorization when possible;
+  // otherwise fall back to random initialization.
+  arma::mat parameters;
+  if (warmStart && u.n_rows == numItems && u.n_cols == rank &&
+      v.n_rows == rank && v.n_cols == numUsers)
+  {
+    parameters.set_size(rank, numUsers + numItems);
+    parameters.cols(0, numUsers - 1) = v;
+    parameters.cols(numUsers, numUsers + numItems - 1) = u.t();
+  }
+  else
+  {
+    if (warmStart)
+    {
+      Log::Warn << "RegularizedSVD::Apply(): passed factor matrices do not "
+          << "match the data; using random initialization instead."
+          << std::endl;
+    }
+    parameters = rSVDFunc.GetInitialPoint();
+  }
+
+  // Get optimized parameters.
+  optimizer.Optimize(rSVDFunc, parameters);
+
+  // Extract user and item matrices from the optimized parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -0,0 +1,88 @@
+/**
+ * @file methods/regularized_svd/sharded_sgd.hpp
+ * @author Siddharth Agrawal
+ *
+ * Sharded stochastic gradient descent for rating-based matrix factorization
+ * functions (RegularizedSVDFunction, BiasSVDFunction, SVDPlusPlusFunction).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_SHARDED_SGD_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_SHARDED_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * ShardedSGD runs stochastic gradient descent over a rating dataset in
+ * parallel by partitioning the ratings into disjoint blocks of users.  The
+ * ratings are grouped by user id and each thread is assigned a contiguous
+ * range of users, so every thread has exclusive access to the parameter
+ * columns of its own users; only the item columns (which any thread may
+ * touch) are updated atomically.  With a single thread this reduces to plain
+ * SGD over the user-grouped ratings.
+ *
+ * The function type must expose Dataset(), NumFunctions(), Evaluate() and a
+ * ShardedUpdate() method applying the SGD step for a single rating under the
+ * exclusive-user guarantee described above.  RegularizedSVDFunction,
+ * BiasSVDFunction and SVDPlusPlusFunction all qualify.
+ */
+class ShardedSGD
+{
+ public:
+  /**
+   * Construct the ShardedSGD optimizer.  The parameter choices mirror the
+   * StandardSGD settings used by the SVD factorizers.
+   *
+   * @param stepSize Step size for each SGD update.
+   * @param maxIterations Maximum number of single-rating updates (the number
+   *     of epochs is maxIterations divided by the number of ratings).
+   */
+  ShardedSGD(const double stepSize = 0.01,
+             const size_t maxIterations = 100000) :
+      stepSize(stepSize),
+      maxIterations(maxIterations)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Optimize the given function with sharded parallel SGD.
+   *
+   * @param function Rating-based factorization function to optimize.
+   * @param parameters Starting point, overwritten with the solution.
+   * @return Objective value at the final parameters.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function, arma::mat& parameters) const;
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the maximum number of single-rating updates.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of single-rating updates.
+  size_t& MaxIterations() { return maxIterations; }
+
+ private:
+  //! Step size for each SGD update.
+  double stepSize;
+  //! Maximum number of single-rating updates.
+  size_t maxIterations;
+};
+
+} // namespace svd
+} // namespace mlpack
+
+// Include implementation.
+#include "sharded_sgd_impl.hpp"
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file methods/regularized_svd/sharded_sgd_impl.hpp
+ * @author Siddharth Agrawal
+ *
+ * Implementation of the ShardedSGD optimizer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_SHARDED_SGD_IMPL_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_SHARDED_SGD_IMPL_HPP
+
+#include "sharded_sgd.hpp"
+
+namespace mlpack {
+namespace svd {
+
+template<typename FunctionType>
+double ShardedSGD::Optimize(FunctionType& function,
+                            arma::mat& parameters) const
+{
+  const arma::mat& data = function.Dataset();
+  const size_t numFunctions = function.NumFunctions();
+  if (numFunctions == 0)
+    return 0.0;
+
+  // Group the ratings by user, so that each thread can be handed a
+  // contiguous, disjoint block of users.  Every rating of a user then lands
+  // in exactly one shard and the user's parameter column is owned by a
+  // single thread.
+  const arma::uvec order = arma::stable_sort_index(data.row(0).t());
+
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+  numThreads = (size_t) omp_get_max_threads();
+  #endif
+
+  // Shard boundaries, as positions into the user-grouped order.  The shards
+  // are balanced by rating count, but a split may only fall between two
+  // different users.
+  std::vector<size_t> bounds(numThreads + 1, numFunctions);
+  bounds[0] = 0;
+  for (size_t t = 1; t < numThreads; ++t)
+  {
+    size_t pos = std::max(bounds[t - 1], t * numFunctions / numThreads);
+    while (pos > 0 && pos < numFunctions &&
+           data(0, order[pos]) == data(0, order[pos - 1]))
+      ++pos;
+    bounds[t] = pos;
+  }
+
+  // Calculate the first objective function.
+  double overallObjective = 0;
+  for (size_t i = 0; i < numFunctions; ++i)
+    overallObjective += function.Evaluate(parameters, i);
+
+  const size_t numEpochs = maxIterations / numFunctions;
+  for (size_t epoch = 1; epoch <= numEpochs; ++epoch)
+  {
+    Log::Info << "Epoch " << epoch << "; " << "objective "
+        << overallObjective << "." << std::endl;
+
+    #pragma omp parallel
+    {
+      size_t threadId = 0;
+      #ifdef HAS_OPENMP
+      threadId = omp_get_thread_num();
+      #endif
+
+      // Threads beyond the shard count (if the team is larger than expected)
+      // simply have no work.
+      if (threadId < numThreads)
+      {
+        for (size_t j = bounds[threadId]; j < bounds[threadId + 1]; ++j)
+          function.ShardedUpdate(parameters, order[j], stepSize);
+      }
+    }
+
+    // Recalculate the objective for the next epoch's report.
+    overallObjective = 0;
+    #pragma omp parallel for reduction(+:overallObjective)
+    for (omp_size_t i = 0; i < (omp_size_t) numFunctions; ++i)
+      overallObjective += function.Evaluate(parameters, i);
+  }
+
+  return overallObjective;
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file methods/reinforcement_learning/environment/vectorized_env.hpp
+ *
+ * Vectorized environment wrapper for RL environments.  Runs several copies
+ * of one environment side by side so an agent can batch their encoded states
+ * into a single matrix and do one network forward pass per step for all of
+ * them, instead of one forward pass per environment.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENV_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENV_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Interface for stepping several instances of one environment at once.  Every
+ * instance keeps its own current state; Sample() advances all of them with
+ * one action apiece and reports the per-instance transitions.  Instances
+ * that reach a terminal state are reset automatically, so the wrapper can be
+ * stepped indefinitely and every column of the encoded state matrix always
+ * holds a valid state.
+ *
+ * @tparam EnvironmentType A type of Environment that is being wrapped.
+ */
+template<typename EnvironmentType>
+class VectorizedEnv
+{
+ public:
+  //! Convenient typedef for state.
+  using State = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using Action = typename EnvironmentType::Action;
+
+  /**
+   * Constructor for creating a VectorizedEnv instance.
+   *
+   * @param numEnvs Number of environment instances to run side by side.
+   * @param environment An instance of the environment to be replicated.
+   */
+  VectorizedEnv(const size_t numEnvs,
+                const EnvironmentType& environment = EnvironmentType()) :
+      environments(numEnvs, environment),
+      states(numEnvs)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Reset every environment instance to an initial state and write the
+   * encoded states into the given matrix, one column per instance.
+   *
+   * @param encodedStates Output matrix of encoded states.
+   */
+  void InitialSample(arma::mat& encodedStates)
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+      states[i] = environments[i].InitialSample();
+    EncodeStates(encodedStates);
+  }
+
+  /**
+   * Advance every environment instance with its own action.  The transition
+   * of instance i is (States()[i] before the call, actions[i], rewards(i),
+   * nextStates[i], isTerminal(i)); instances whose next state is terminal
+   * are reset immediately afterwards, so States() and the encoded state
+   * matrix always hold live states.
+   *
+   * @param actions One action per environment instance.
+   * @param nextStates The raw next state of every instance, before any
+   *        automatic reset; use these when storing transitions for replay.
+   * @param rewards The reward of every instance.
+   * @param isTerminal Whether every instance's next state is terminal.
+   */
+  void Sample(const std::vector<Action>& actions,
+              std::vector<State>& nextStates,
+              arma::rowvec& rewards,
+              arma::irowvec& isTerminal)
+  {
+    nextStates.resize(environments.size());
+    rewards.set_size(environments.size());
+    isTerminal.set_size(environments.size());
+
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      rewards(i) = environments[i].Sample(states[i], actions[i],
+          nextStates[i]);
+      isTerminal(i) = environments[i].IsTerminal(nextStates[i]);
+
+      // Reset finished instances so the next step starts a fresh episode.
+      if (isTerminal(i))
+        states[i] = environments[i].InitialSample();
+      else
+        states[i] = nextStates[i];
+    }
+  }
+
+  /**
+   * Write the encoded current state of every instance into the given matrix,
+   * one column per instance.
+   *
+   * @param encodedStates Output matrix of encoded states.
+   */
+  void EncodeStates(arma::mat& encodedStates) const
+  {
+    const size_t dimension = states[0].Encode().n_elem;
+    encodedStates.set_size(dimension, states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+      encodedStates.col(i) = states[i].Encode();
+  }
+
+  //! Get the current state of every environment instance.
+  const std::vector<State>& States() const { return states; }
+  //! Modify the current state of every environment instance.
+  std::vector<State>& States() { return states; }
+
+  //! Get the number of environment instances.
+  size_t NumEnvs() const { return environments.size(); }
+
+  //! Get the environment instance with the given index.
+  const EnvironmentType& Environment(const size_t i) const
+  { return environments[i]; }
+  //! Modify the environment instance with the given index.
+  EnvironmentType& Environment(const size_t i) { return environments[i]; }
+
+ private:
+  //! The environment instances being stepped side by side.
+  std::vector<EnvironmentType> environments;
+
+  //! The current state of every environment instance.
+  std::vector<State> states;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,7 @@
 
 #include "replay/random_replay.hpp"
 #include "replay/prioritized_replay.hpp"
+#include "environment/vectorized_env.hpp"
 #include "training_config.hpp"
 
 namespace mlpack {
@@ -111,6 +112,21 @@ class QLearning
    */
   double Episode();
 
+  /**
+   * Execute one episode in each of numEnvs copies of the environment at
+   * once.  The encoded states of all environments are batched into one
+   * matrix, so action selection costs a single network forward pass per step
+   * instead of one per environment.  Environments that finish their episode
+   * keep running (auto-resetting) until every environment has completed one;
+   * all transitions feed the replay memory, and training happens once per
+   * vectorized step.  Only usable with single-step replay (NSteps() == 1),
+   * since interleaved transitions would corrupt the n-step buffer.
+   *
+   * @param numEnvs Number of environment copies to step in parallel.
+   * @return Mean return of the numEnvs episodes.
+   */
+  double VectorizedEpisode(const size_t numEnvs);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
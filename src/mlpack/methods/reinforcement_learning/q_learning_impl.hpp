@@ -386,6 +386,91 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::VectorizedEpisode(const size_t numEnvs)
+{
+  if (replayMethod.NSteps() > 1)
+  {
+    Log::Fatal << "QLearning::VectorizedEpisode(): interleaved transitions "
+        << "from multiple environments cannot be used with n-step replay "
+        << "(NSteps() > 1)!" << std::endl;
+  }
+
+  VectorizedEnv<EnvironmentType> vecEnv(numEnvs, environment);
+
+  // Reset all the environments and batch their encoded states.
+  arma::mat encodedStates;
+  vecEnv.InitialSample(encodedStates);
+  std::vector<StateType> currentStates = vecEnv.States();
+
+  // Track the return of the first episode completed by each environment.
+  arma::vec returns(numEnvs, arma::fill::zeros);
+  std::vector<bool> finished(numEnvs, false);
+  size_t numFinished = 0;
+
+  while (numFinished < numEnvs)
+  {
+    // One forward pass selects the actions for every environment.
+    arma::mat actionValues;
+    learningNetwork.Predict(encodedStates, actionValues);
+
+    std::vector<ActionType> actions(numEnvs);
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      const arma::colvec actionValue = actionValues.col(i);
+      actions[i] = policy.Sample(actionValue, deterministic,
+          config.NoisyQLearning());
+    }
+
+    // Step every environment; finished ones auto-reset inside the wrapper.
+    std::vector<StateType> nextStates;
+    arma::rowvec rewards;
+    arma::irowvec isTerminal;
+    vecEnv.Sample(actions, nextStates, rewards, isTerminal);
+
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      replayMethod.Store(currentStates[i], actions[i], rewards(i),
+          nextStates[i], isTerminal(i), config.Discount());
+      totalSteps++;
+
+      if (!finished[i])
+      {
+        returns(i) += rewards(i);
+        if (isTerminal(i))
+        {
+          finished[i] = true;
+          numFinished++;
+        }
+      }
+    }
+
+    currentStates = vecEnv.States();
+    vecEnv.EncodeStates(encodedStates);
+
+    if (deterministic || totalSteps < config.ExplorationSteps())
+      continue;
+    if (config.IsCategorical())
+      TrainCategoricalAgent();
+    else
+      TrainAgent();
+  }
+
+  return arma::mean(returns);
+}
+
 } // namespace rl
 } // namespace mlpack
 
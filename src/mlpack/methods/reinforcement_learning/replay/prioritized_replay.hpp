@@ -228,22 +228,19 @@ class PrioritizedReplay
     BetaAnneal();
 
     sampledStates = states.cols(sampledIndices);
+    sampledActions.reserve(sampledActions.size() + sampledIndices.n_rows);
     for (size_t t = 0; t < sampledIndices.n_rows; t ++)
       sampledActions.push_back(actions[sampledIndices[t]]);
     sampledRewards = rewards.elem(sampledIndices).t();
     sampledNextStates = nextStates.cols(sampledIndices);
     isTerminal = this->isTerminal.elem(sampledIndices).t();
 
-    // Calculate the weights of sampled transitions.
-
+    // Calculate the weights of sampled transitions.  The priorities are
+    // gathered in one pass and the total sum is queried only once.
     size_t numSample = full ? capacity : position;
-    weights = arma::rowvec(sampledIndices.n_rows);
-
-    for (size_t i = 0; i < sampledIndices.n_rows; ++i)
-    {
-      double p_sample = idxSum.Get(sampledIndices(i)) / idxSum.Sum();
-      weights(i) = pow(numSample * p_sample, -beta);
-    }
+    arma::colvec priorities;
+    idxSum.Get(sampledIndices, priorities);
+    weights = arma::pow((numSample / idxSum.Sum()) * priorities.t(), -beta);
     weights /= weights.max();
   }
 
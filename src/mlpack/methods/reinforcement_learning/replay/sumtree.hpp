@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_RL_SUMTREE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <algorithm>
 
 namespace mlpack {
 namespace rl {
@@ -74,14 +75,39 @@ class SumTree
    */
   void BatchUpdate(const arma::ucolvec& indices, const arma::Col<T>& data)
   {
+    // Set the leaves, and collect the parents of the touched leaves.
+    std::vector<size_t> touched;
+    touched.reserve(indices.n_rows);
     for (size_t i = 0; i < indices.n_rows; ++i)
     {
       element[indices[i] + capacity] = data[i];
+      if ((indices[i] + capacity) / 2 >= 1)
+        touched.push_back((indices[i] + capacity) / 2);
     }
-    // update the total tree with bottom-up technique.
-    for (size_t i = capacity - 1; i > 0; i--)
+
+    // Recompute only the ancestors of the touched leaves, one level at a
+    // time; since all leaves live at the same depth, every pass holds nodes
+    // of a single level, and deduplicating recomputes each shared ancestor
+    // only once.  This is O(batch size * log capacity) rather than
+    // O(capacity) for a full bottom-up rebuild.
+    while (!touched.empty())
     {
-      element[i] = element[2 * i] + element[2 * i + 1];
+      std::sort(touched.begin(), touched.end());
+      touched.erase(std::unique(touched.begin(), touched.end()),
+          touched.end());
+
+      for (size_t i = 0; i < touched.size(); ++i)
+      {
+        const size_t node = touched[i];
+        element[node] = element[2 * node] + element[2 * node + 1];
+      }
+
+      // Stop after the root has been recomputed.
+      if (touched[0] == 1)
+        break;
+
+      for (size_t i = 0; i < touched.size(); ++i)
+        touched[i] /= 2;
     }
   }
 
@@ -96,6 +122,19 @@ class SumTree
     return element[idx];
   }
 
+  /**
+   * Get the data of all the given indices in one pass.
+   *
+   * @param indices The array indices to get data for.
+   * @param values Output vector; set to the value stored at each index.
+   */
+  void Get(const arma::ucolvec& indices, arma::Col<T>& values)
+  {
+    values.set_size(indices.n_rows);
+    for (size_t i = 0; i < indices.n_rows; ++i)
+      values[i] = element[indices[i] + capacity];
+  }
+
   /**
    * Help function for the `sum` function
    *
@@ -61,7 +61,8 @@ class OneStepQLearningWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetEpoch(0)
   { Reset(); }
 
   /**
@@ -82,6 +83,8 @@ class OneStepQLearningWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      localTargetNetwork(other.localTargetNetwork),
+      targetEpoch(other.targetEpoch),
       state(other.state)
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -112,6 +115,8 @@ class OneStepQLearningWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      localTargetNetwork(std::move(other.localTargetNetwork)),
+      targetEpoch(std::move(other.targetEpoch)),
       state(std::move(other.state))
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -147,6 +152,8 @@ class OneStepQLearningWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    localTargetNetwork = other.localTargetNetwork;
+    targetEpoch = other.targetEpoch;
     state = other.state;
 
     #if ENS_VERSION_MAJOR >= 2
@@ -184,6 +191,8 @@ class OneStepQLearningWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    localTargetNetwork = std::move(other.localTargetNetwork);
+    targetEpoch = std::move(other.targetEpoch);
     state = std::move(other.state);
 
     #if ENS_VERSION_MAJOR >= 2
@@ -228,6 +237,10 @@ class OneStepQLearningWorker
 
     // Build local network.
     network = learningNetwork;
+
+    // Build the local target network replica.
+    localTargetNetwork = learningNetwork;
+    targetEpoch = 0;
   }
 
   /**
@@ -281,6 +294,19 @@ class OneStepQLearningWorker
 
     if (terminal || pendingIndex >= config.UpdateInterval())
     {
+      // Refresh the local target network replica if a new target sync epoch
+      // has begun.  Predicting against the replica keeps the update loop
+      // below free of locks; the critical section here runs only once per
+      // sync interval instead of once per transition.
+      const size_t currentEpoch = totalSteps /
+          config.TargetNetworkSyncInterval();
+      if (currentEpoch != targetEpoch)
+      {
+        #pragma omp critical
+        { localTargetNetwork = targetNetwork; }
+        targetEpoch = currentEpoch;
+      }
+
       // Initialize the gradient storage.
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
@@ -290,11 +316,8 @@ class OneStepQLearningWorker
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        localTargetNetwork.Predict(
+            std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = actionValue.max();
         if (terminal && i == pending.size() - 1)
           targetActionValue = 0;
@@ -396,6 +419,13 @@ class OneStepQLearningWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local replica of the target network; refreshed once per target sync
+  //! epoch so that target predictions need no locking.
+  NetworkType localTargetNetwork;
+
+  //! The target sync epoch in which localTargetNetwork was last refreshed.
+  size_t targetEpoch;
+
   //! Current state of the agent.
   StateType state;
 };
@@ -62,7 +62,8 @@ class OneStepSarsaWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetEpoch(0)
   { Reset(); }
 
   /**
@@ -83,6 +84,8 @@ class OneStepSarsaWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      localTargetNetwork(other.localTargetNetwork),
+      targetEpoch(other.targetEpoch),
       state(other.state),
       action(other.action)
   {
@@ -114,6 +117,8 @@ class OneStepSarsaWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      localTargetNetwork(std::move(other.localTargetNetwork)),
+      targetEpoch(std::move(other.targetEpoch)),
       state(std::move(other.state)),
       action(std::move(other.action))
   {
@@ -150,6 +155,8 @@ class OneStepSarsaWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    localTargetNetwork = other.localTargetNetwork;
+    targetEpoch = other.targetEpoch;
     state = other.state;
     action = other.action;
 
@@ -188,6 +195,8 @@ class OneStepSarsaWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    localTargetNetwork = std::move(other.localTargetNetwork);
+    targetEpoch = std::move(other.targetEpoch);
     state = std::move(other.state);
     action = std::move(other.action);
 
@@ -233,6 +242,10 @@ class OneStepSarsaWorker
 
     // Build local network.
     network = learningNetwork;
+
+    // Build the local target network replica.
+    localTargetNetwork = learningNetwork;
+    targetEpoch = 0;
   }
 
   /**
@@ -294,6 +307,19 @@ class OneStepSarsaWorker
 
     if (terminal || pendingIndex >= config.UpdateInterval())
     {
+      // Refresh the local target network replica if a new target sync epoch
+      // has begun.  Predicting against the replica keeps the update loop
+      // below free of locks; the critical section here runs only once per
+      // sync interval instead of once per transition.
+      const size_t currentEpoch = totalSteps /
+          config.TargetNetworkSyncInterval();
+      if (currentEpoch != targetEpoch)
+      {
+        #pragma omp critical
+        { localTargetNetwork = targetNetwork; }
+        targetEpoch = currentEpoch;
+      }
+
       // Initialize the gradient storage.
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
@@ -303,11 +329,8 @@ class OneStepSarsaWorker
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        localTargetNetwork.Predict(
+            std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = 0;
         if (!(terminal && i == pending.size() - 1))
           targetActionValue = actionValue[std::get<4>(transition).action];
@@ -412,6 +435,13 @@ class OneStepSarsaWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local replica of the target network; refreshed once per target sync
+  //! epoch so that target predictions need no locking.
+  NetworkType localTargetNetwork;
+
+  //! The target sync epoch in which localTargetNetwork was last refreshed.
+  size_t targetEpoch;
+
   //! Current state of the agent.
   StateType state;
 
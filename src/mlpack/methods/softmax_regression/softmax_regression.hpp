@@ -205,6 +205,51 @@ class SoftmaxRegression
                OptimizerType optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Incrementally refit the softmax regression on new data, starting the
+   * optimization from the current weights (a warm start).  Since the
+   * existing weights are usually a near-solution for a refit, pass only the
+   * newly arrived points: the optimizer only sweeps over the given data, so
+   * a daily refit does not have to revisit the full history.
+   *
+   * The model must already be trained on data of the same dimensionality;
+   * otherwise a std::invalid_argument exception is thrown.  To fit a model
+   * from scratch, use Train() instead.
+   *
+   * @tparam OptimizerType Desired optimizer type.
+   * @param data New input data with each column as one example.
+   * @param labels Labels associated with the feature data.
+   * @param optimizer Desired optimizer.
+   * @return Objective value of the final point.
+   */
+  template<typename OptimizerType = ens::L_BFGS>
+  double TrainIncremental(const arma::mat& data,
+                          const arma::Row<size_t>& labels,
+                          OptimizerType optimizer = OptimizerType());
+
+  /**
+   * Incrementally refit the softmax regression on new data, starting the
+   * optimization from the current weights (a warm start).
+   *
+   * The model must already be trained on data of the same dimensionality;
+   * otherwise a std::invalid_argument exception is thrown.  To fit a model
+   * from scratch, use Train() instead.
+   *
+   * @tparam OptimizerType Desired optimizer type.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param data New input data with each column as one example.
+   * @param labels Labels associated with the feature data.
+   * @param optimizer Desired optimizer.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return Objective value of the final point.
+   */
+  template<typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
+  double TrainIncremental(const arma::mat& data,
+                          const arma::Row<size_t>& labels,
+                          OptimizerType optimizer,
+                          CallbackTypes&&... callbacks);
+
   //! Sets the number of classes.
   size_t& NumClasses() { return numClasses; }
   //! Gets the number of classes.
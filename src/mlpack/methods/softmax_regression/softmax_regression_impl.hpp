@@ -15,6 +15,8 @@
 // In case it hasn't been included yet.
 #include "softmax_regression.hpp"
 
+#include <mlpack/core/math/scores_to_labels.hpp>
+
 namespace mlpack {
 namespace regression {
 
@@ -68,27 +70,8 @@ inline void SoftmaxRegression::Classify(const arma::mat& dataset,
   arma::mat probabilities;
   Classify(dataset, probabilities);
 
-  // Prepare necessary data.
-  labels.zeros(dataset.n_cols);
-  double maxProbability = 0;
-
-  // For each test input.
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-  {
-    // For each class.
-    for (size_t j = 0; j < numClasses; ++j)
-    {
-      // If a higher class probability is encountered, change prediction.
-      if (probabilities(j, i) > maxProbability)
-      {
-        maxProbability = probabilities(j, i);
-        labels(i) = j;
-      }
-    }
-
-    // Set maximum probability to zero for the next input.
-    maxProbability = 0;
-  }
+  // Predict the class with the highest probability for each point.
+  math::ScoresToLabels(probabilities, labels);
 }
 
 inline void SoftmaxRegression::Classify(const arma::mat& dataset,
@@ -98,27 +81,8 @@ inline void SoftmaxRegression::Classify(const arma::mat& dataset,
 {
   Classify(dataset, probabilities);
 
-  // Prepare necessary data.
-  labels.zeros(dataset.n_cols);
-  double maxProbability = 0;
-
-  // For each test input.
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-  {
-    // For each class.
-    for (size_t j = 0; j < numClasses; ++j)
-    {
-      // If a higher class probability is encountered, change prediction.
-      if (probabilities(j, i) > maxProbability)
-      {
-        maxProbability = probabilities(j, i);
-        labels(i) = j;
-      }
-    }
-
-    // Set maximum probability to zero for the next input.
-    maxProbability = 0;
-  }
+  // Predict the class with the highest probability for each point.
+  math::ScoresToLabels(probabilities, labels);
 }
 
 inline void SoftmaxRegression::Classify(const arma::mat& dataset,
@@ -219,6 +183,43 @@ double SoftmaxRegression::Train(const arma::mat& data,
   return out;
 }
 
+template<typename OptimizerType>
+double SoftmaxRegression::TrainIncremental(const arma::mat& data,
+                                           const arma::Row<size_t>& labels,
+                                           OptimizerType optimizer)
+{
+  if (parameters.is_empty())
+  {
+    throw std::invalid_argument("SoftmaxRegression::TrainIncremental(): the "
+        "model is not trained; use Train() to fit a model from scratch!");
+  }
+  util::CheckSameDimensionality(data, FeatureSize(),
+      "SoftmaxRegression::TrainIncremental()");
+
+  // The current weights stay in place, so the optimizer starts from them and
+  // only passes over the given data.
+  return Train(data, labels, numClasses, optimizer);
+}
+
+template<typename OptimizerType, typename... CallbackTypes>
+double SoftmaxRegression::TrainIncremental(const arma::mat& data,
+                                           const arma::Row<size_t>& labels,
+                                           OptimizerType optimizer,
+                                           CallbackTypes&&... callbacks)
+{
+  if (parameters.is_empty())
+  {
+    throw std::invalid_argument("SoftmaxRegression::TrainIncremental(): the "
+        "model is not trained; use Train() to fit a model from scratch!");
+  }
+  util::CheckSameDimensionality(data, FeatureSize(),
+      "SoftmaxRegression::TrainIncremental()");
+
+  // The current weights stay in place, so the optimizer starts from them and
+  // only passes over the given data.
+  return Train(data, labels, numClasses, optimizer, callbacks...);
+}
+
 } // namespace regression
 } // namespace mlpack
 
@@ -60,25 +60,35 @@ inline void SparseCoding::Encode(const arma::mat& data,
                                  arma::mat& codes)
 {
   // When using the Cholesky version of LARS, this is correct even if
-  // lambda2 > 0.
+  // lambda2 > 0.  The Gram matrix is computed once up front and shared
+  // (read-only) by every solve.
   arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
 
+  // The per-point LARS problems are independent, so solve them in parallel.
+  // Each thread reuses a single LARS object across all of the points it is
+  // assigned, since Train() resets the solver's state; this avoids
+  // reallocating the solver's workspace for every point.
+  #pragma omp parallel
+  {
     bool useCholesky = true;
     regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
 
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    arma::vec code = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, code, false);
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      // Report progress.
+      if ((i % 100) == 0)
+        Log::Debug << "Optimization at point " << i << "." << std::endl;
+
+      // Create an alias of the code (using the same memory), and then LARS
+      // will place the result directly into that; then we will not need to
+      // have an extra copy.
+      arma::vec code = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictionary, responses, code, false);
+    }
   }
 }
 
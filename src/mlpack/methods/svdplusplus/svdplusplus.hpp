@@ -19,6 +19,8 @@
 
 #include <ensmallen.hpp>
 
+#include <mlpack/methods/regularized_svd/sharded_sgd.hpp>
+
 #include "svdplusplus_function.hpp"
 
 namespace mlpack {
@@ -132,6 +134,36 @@ class SVDPlusPlus
              arma::vec& q,
              arma::mat& y);
 
+  /**
+   * Trains the model, optionally starting the optimization from the factors,
+   * biases, and item implicit matrix of a previous decomposition.  If
+   * warmStart is set but the passed factors do not match the rank and the
+   * numbers of users and items in the data (e.g. on the very first fit),
+   * random initialization is used instead.  Training uses parallel sharded
+   * SGD over disjoint user blocks (ShardedSGD), so repeated refits on
+   * slightly changed data converge much faster than training from scratch.
+   *
+   * @param data Rating data matrix.
+   * @param implicitData Implicit feedback.
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix: starting point and output of decomposition.
+   * @param v User matrix: starting point and output of decomposition.
+   * @param p Item bias: starting point and output of decomposition.
+   * @param q User bias: starting point and output of decomposition.
+   * @param y Item implicit matrix: starting point and output of
+   *     decomposition.
+   * @param warmStart If true, start the optimization from the passed factors.
+   */
+  void Apply(const arma::mat& data,
+             const arma::mat& implicitData,
+             const size_t rank,
+             arma::mat& u,
+             arma::mat& v,
+             arma::vec& p,
+             arma::vec& q,
+             arma::mat& y,
+             const bool warmStart);
+
   /**
    * Converts the User, Item matrix of implicit data to Item-User Table.
    */
@@ -103,6 +103,22 @@ class SVDPlusPlusFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Apply a single SGD update for the given rating.  This is the update rule
+   * used by ShardedSGD: the caller must guarantee that no other thread is
+   * concurrently updating the column of this rating's user, while the item
+   * column and the item implicit vectors may be shared between threads and
+   * are therefore written atomically.
+   *
+   * @param parameters Parameters(user/item matrices, user/item bias,
+   *     item implicit matrix) of the decomposition.
+   * @param index Index of the rating to use for the update.
+   * @param stepSize Step size of the SGD update.
+   */
+  void ShardedUpdate(arma::mat& parameters,
+                     const size_t index,
+                     const double stepSize) const;
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
@@ -285,6 +285,80 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void SVDPlusPlusFunction<MatType>::ShardedUpdate(arma::mat& parameters,
+                                                 const size_t index,
+                                                 const double stepSize) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, index);
+  const size_t item = data(1, index) + numUsers;
+  const size_t implicitStart = numUsers + numItems;
+
+  // Prediction error for the example.
+  const double rating = data(2, index);
+  const double userBias = parameters(rank, user);
+  const double itemBias = parameters(rank, item);
+
+  // Iterate through each item which the user interacted with to calculate
+  // user vector.
+  arma::vec userVec(rank, arma::fill::zeros);
+  arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+  arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+  size_t implicitCount = 0;
+  for (; it != it_end; ++it)
+  {
+    userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+    implicitCount += 1;
+  }
+  if (implicitCount != 0)
+    userVec /= std::sqrt(implicitCount);
+  userVec += parameters.col(user).subvec(0, rank - 1);
+
+  double ratingError = rating - userBias - itemBias -
+      arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
+
+  const arma::vec itemVecUpdate = stepSize * 2 * (
+      lambda * parameters.col(item).subvec(0, rank - 1) -
+      ratingError * userVec);
+  const double itemBiasUpdate = stepSize * 2 * (
+      lambda * parameters(rank, item) - ratingError);
+
+  // The caller guarantees exclusive access to the user's column, so it can be
+  // written directly.
+  parameters.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
+      lambda * parameters.col(user).subvec(0, rank - 1) -
+      ratingError * parameters.col(item).subvec(0, rank - 1));
+  parameters(rank, user) -= stepSize * 2 * (
+      lambda * parameters(rank, user) - ratingError);
+
+  // The item implicit vectors may be shared with other shards.
+  it = implicitData.begin_col(user);
+  for (; it != it_end; ++it)
+  {
+    // Note that implicitCount != 0 if this loop is acutally executed.
+    const arma::vec implicitUpdate = stepSize * 2.0 * (
+        lambda / implicitCount *
+        parameters.col(implicitStart + it.row()).subvec(0, rank - 1) -
+        ratingError / std::sqrt(implicitCount) *
+        parameters.col(item).subvec(0, rank - 1));
+    for (size_t j = 0; j < rank; ++j)
+    {
+      #pragma omp atomic
+      parameters(j, implicitStart + it.row()) -= implicitUpdate(j);
+    }
+  }
+
+  // The item column may be shared with other shards as well.
+  for (size_t j = 0; j < rank; ++j)
+  {
+    #pragma omp atomic
+    parameters(j, item) -= itemVecUpdate(j);
+  }
+  #pragma omp atomic
+  parameters(rank, item) -= itemBiasUpdate;
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -71,6 +71,70 @@ void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
       numUsers + 2 * numItems - 1);
 }
 
+template<typename OptimizerType>
+void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
+                                       const arma::mat& implicitData,
+                                       const size_t rank,
+                                       arma::mat& u,
+                                       arma::mat& v,
+                                       arma::vec& p,
+                                       arma::vec& q,
+                                       arma::mat& y,
+                                       const bool warmStart)
+{
+  // Converts implicitData to the form of sparse matrix.
+  arma::sp_mat cleanedData;
+  CleanData(implicitData, cleanedData, data);
+
+  // Make the optimizer object using a SVDPlusPlusFunction object.
+  SVDPlusPlusFunction<arma::mat> svdPPFunc(data, cleanedData, rank, lambda);
+  ShardedSGD optimizer(alpha, iterations * data.n_cols);
+
+  // Constants for assembling and extracting user and item matrices.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+
+  // Seed the parameters from the passed factorization when possible;
+  // otherwise fall back to random initialization.  The unused part of the
+  // last parameter row is always initialized randomly.
+  arma::mat parameters;
+  if (warmStart && u.n_rows == numItems && u.n_cols == rank &&
+      v.n_rows == rank && v.n_cols == numUsers &&
+      p.n_elem == numItems && q.n_elem == numUsers &&
+      y.n_rows == rank && y.n_cols == numItems)
+  {
+    parameters.randu(rank + 1, numUsers + 2 * numItems);
+    parameters.submat(0, 0, rank - 1, numUsers - 1) = v;
+    parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1) = u.t();
+    parameters.row(rank).subvec(0, numUsers - 1) = q.t();
+    parameters.row(rank).subvec(numUsers, numUsers + numItems - 1) = p.t();
+    parameters.submat(0, numUsers + numItems, rank - 1,
+        numUsers + 2 * numItems - 1) = y;
+  }
+  else
+  {
+    if (warmStart)
+    {
+      Log::Warn << "SVDPlusPlus::Apply(): passed factor matrices do not "
+          << "match the data; using random initialization instead."
+          << std::endl;
+    }
+    parameters = svdPPFunc.GetInitialPoint();
+  }
+
+  // Get optimized parameters.
+  optimizer.Optimize(svdPPFunc, parameters);
+
+  // Extract user and item matrices, user and item bias, item implicit matrix
+  // from the optimized parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+  p = parameters.row(rank).subvec(numUsers, numUsers + numItems - 1).t();
+  q = parameters.row(rank).subvec(0, numUsers - 1).t();
+  y = parameters.submat(0, numUsers + numItems, rank - 1,
+      numUsers + 2 * numItems - 1);
+}
+
 // Use whether a user rates an item as binary implicit data when implicitData
 // is not given.
 template<typename OptimizerType>
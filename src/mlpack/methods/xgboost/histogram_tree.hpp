@@ -0,0 +1,363 @@
+/**
+ * @file methods/xgboost/histogram_tree.hpp
+ * @author Rishabh Garg
+ *
+ * A histogram-based regression tree builder for gradient boosting.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_HISTOGRAM_TREE_HPP
+#define MLPACK_METHODS_XGBOOST_HISTOGRAM_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "quantile_binning.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+/**
+ * HistogramTree builds a regression tree on gradient and hessian statistics,
+ * the way mainstream gradient boosting systems do:
+ *
+ *  - The features are quantile-binned up front (see QuantileBinning), so
+ *    every split candidate is a bin edge and a node considers at most the
+ *    number of bins per dimension, no matter how many points it holds.
+ *  - Each node accumulates one histogram of per-bin gradient/hessian sums
+ *    per dimension; the accumulation is parallelized over dimensions, which
+ *    are independent.
+ *  - When a node splits, only the smaller child's histogram is accumulated
+ *    from its points; the larger child's histogram is obtained by
+ *    subtracting the smaller one from the parent's (the histogram
+ *    subtraction trick), which roughly halves histogram work on every level.
+ *
+ * Split gain and leaf values use the second-order formulation of
+ *
+ * @code
+ * @inproceedings{Chen16,
+ *   author    = {Tianqi Chen and Carlos Guestrin},
+ *   title     = {{XGBoost}: A Scalable Tree Boosting System},
+ *   booktitle = {Proceedings of the 22nd ACM SIGKDD International Conference
+ *                on Knowledge Discovery and Data Mining},
+ *   year      = {2016}
+ * }
+ * @endcode
+ *
+ * with L2 regularization term lambda and minimum split gain gamma: a node
+ * with gradient sum G and hessian sum H scores G^2 / (H + lambda), a split
+ * is kept if the sum of its children's scores exceeds the node's score by
+ * more than gamma, and a leaf outputs -G / (H + lambda).
+ */
+class HistogramTree
+{
+ public:
+  /**
+   * Construct a histogram tree builder with the given settings.
+   *
+   * @param maxDepth Maximum depth of the tree.
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param lambda L2 regularization applied to leaf values and gains.
+   * @param gamma Minimum gain required to keep a split.
+   */
+  HistogramTree(const size_t maxDepth = 6,
+                const size_t minimumLeafSize = 1,
+                const double lambda = 0.0,
+                const double gamma = 0.0) :
+      maxDepth(maxDepth),
+      minimumLeafSize(minimumLeafSize),
+      lambda(lambda),
+      gamma(gamma)
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Build the tree on pre-binned data and the given gradient and hessian of
+   * each point.
+   *
+   * @param binnedData Bin index of each feature value (from
+   *      QuantileBinning::Bin()).
+   * @param binning The binning that produced binnedData; used to recover raw
+   *      split thresholds.
+   * @param gradients First-order gradient of the loss for each point.
+   * @param hessians Second-order gradient of the loss for each point.
+   */
+  void Train(const arma::Mat<uint16_t>& binnedData,
+             const QuantileBinning& binning,
+             const arma::vec& gradients,
+             const arma::vec& hessians)
+  {
+    nodes.clear();
+
+    std::vector<size_t> indices(binnedData.n_cols);
+    for (size_t i = 0; i < indices.size(); ++i)
+      indices[i] = i;
+
+    // The root accumulates its histogram from all of the points; below the
+    // root, only the smaller sibling of each split accumulates.
+    Histogram hist;
+    Accumulate(binnedData, gradients, hessians, indices,
+        binning.MaxNumBins(), hist);
+
+    BuildNode(binnedData, binning, gradients, hessians, indices, hist, 0);
+  }
+
+  /**
+   * Predict the output of the tree for the given point.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const
+  {
+    size_t index = 0;
+    while (!nodes[index].isLeaf)
+    {
+      index = (point[nodes[index].splitDimension] <= nodes[index].threshold) ?
+          nodes[index].left : nodes[index].right;
+    }
+
+    return nodes[index].value;
+  }
+
+  /**
+   * Predict the output of the tree for each of the given points.
+   *
+   * @param data Points to predict for.
+   * @param predictions This will be filled with the prediction of each point.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const
+  {
+    predictions.set_size(data.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+      predictions[i] = Predict(data.col(i));
+  }
+
+  //! Get the number of nodes in the tree.
+  size_t NumNodes() const { return nodes.size(); }
+
+  //! Serialize the tree.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(maxDepth));
+    ar(CEREAL_NVP(minimumLeafSize));
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(gamma));
+    ar(CEREAL_NVP(nodes));
+  }
+
+ private:
+  //! One node of the built tree.
+  struct Node
+  {
+    //! The dimension a non-leaf splits on.
+    size_t splitDimension;
+    //! The raw-value threshold: points with values <= this go left.
+    double threshold;
+    //! The index of the left child.
+    size_t left;
+    //! The index of the right child.
+    size_t right;
+    //! The output value, if this is a leaf.
+    double value;
+    //! Whether this node is a leaf.
+    bool isLeaf;
+
+    template<typename Archive>
+    void serialize(Archive& ar, const uint32_t /* version */)
+    {
+      ar(CEREAL_NVP(splitDimension));
+      ar(CEREAL_NVP(threshold));
+      ar(CEREAL_NVP(left));
+      ar(CEREAL_NVP(right));
+      ar(CEREAL_NVP(value));
+      ar(CEREAL_NVP(isLeaf));
+    }
+  };
+
+  //! Per-bin gradient/hessian sums and counts, one column per dimension.
+  struct Histogram
+  {
+    arma::mat gradSums;
+    arma::mat hessSums;
+    arma::Mat<arma::uword> counts;
+  };
+
+  /**
+   * Accumulate the histogram of the given points.  The dimensions are
+   * independent, so the accumulation is parallelized over them.
+   */
+  static void Accumulate(const arma::Mat<uint16_t>& binnedData,
+                         const arma::vec& gradients,
+                         const arma::vec& hessians,
+                         const std::vector<size_t>& indices,
+                         const size_t maxBins,
+                         Histogram& hist)
+  {
+    hist.gradSums.zeros(maxBins, binnedData.n_rows);
+    hist.hessSums.zeros(maxBins, binnedData.n_rows);
+    hist.counts.zeros(maxBins, binnedData.n_rows);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t d = 0; d < (omp_size_t) binnedData.n_rows; ++d)
+    {
+      for (size_t k = 0; k < indices.size(); ++k)
+      {
+        const size_t i = indices[k];
+        const uint16_t b = binnedData(d, i);
+        hist.gradSums(b, d) += gradients[i];
+        hist.hessSums(b, d) += hessians[i];
+        hist.counts(b, d)++;
+      }
+    }
+  }
+
+  //! Compute a sibling's histogram by subtraction from the parent's.
+  static void Subtract(const Histogram& parent,
+                       const Histogram& child,
+                       Histogram& sibling)
+  {
+    sibling.gradSums = parent.gradSums - child.gradSums;
+    sibling.hessSums = parent.hessSums - child.hessSums;
+    sibling.counts = parent.counts - child.counts;
+  }
+
+  /**
+   * Recursively build the node holding the given points, whose histogram has
+   * already been computed.  Returns the index of the built node.
+   */
+  size_t BuildNode(const arma::Mat<uint16_t>& binnedData,
+                   const QuantileBinning& binning,
+                   const arma::vec& gradients,
+                   const arma::vec& hessians,
+                   const std::vector<size_t>& indices,
+                   const Histogram& hist,
+                   const size_t depth)
+  {
+    // The bins of any one dimension partition all of the node's points, so
+    // the totals can be read off the first dimension's column.
+    const double g = arma::accu(hist.gradSums.col(0));
+    const double h = arma::accu(hist.hessSums.col(0));
+
+    const size_t nodeIndex = nodes.size();
+    nodes.push_back(Node());
+
+    // Scan the bin edges of every dimension for the best split.  Each
+    // dimension's scan is independent, so they run in parallel, each with
+    // its own best-gain slot.
+    const size_t dims = binnedData.n_rows;
+    double bestGain = 0.0;
+    size_t bestDim = dims;
+    size_t bestBin = 0;
+    if (depth < maxDepth && indices.size() >= 2 * minimumLeafSize)
+    {
+      const double parentScore = g * g / (h + lambda);
+      std::vector<double> dimGains(dims, 0.0);
+      std::vector<size_t> dimBins(dims, 0);
+
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t d = 0; d < (omp_size_t) dims; ++d)
+      {
+        double leftG = 0.0;
+        double leftH = 0.0;
+        arma::uword leftCount = 0;
+        const size_t numBins = binning.NumBins(d);
+        for (size_t b = 0; b + 1 < numBins; ++b)
+        {
+          leftG += hist.gradSums(b, d);
+          leftH += hist.hessSums(b, d);
+          leftCount += hist.counts(b, d);
+
+          if (leftCount < minimumLeafSize)
+            continue;
+          if (indices.size() - leftCount < minimumLeafSize)
+            break;
+
+          const double rightG = g - leftG;
+          const double rightH = h - leftH;
+          const double gain = leftG * leftG / (leftH + lambda) +
+              rightG * rightG / (rightH + lambda) - parentScore;
+          if (gain > dimGains[d])
+          {
+            dimGains[d] = gain;
+            dimBins[d] = b;
+          }
+        }
+      }
+
+      for (size_t d = 0; d < dims; ++d)
+      {
+        if (dimGains[d] > bestGain)
+        {
+          bestGain = dimGains[d];
+          bestDim = d;
+          bestBin = dimBins[d];
+        }
+      }
+    }
+
+    // If no split improves on the node by more than gamma, output a leaf.
+    if (bestDim == dims || bestGain <= gamma)
+    {
+      nodes[nodeIndex].isLeaf = true;
+      nodes[nodeIndex].value = -g / (h + lambda);
+      return nodeIndex;
+    }
+
+    // Partition the node's points by the chosen split.
+    std::vector<size_t> leftIndices, rightIndices;
+    for (size_t k = 0; k < indices.size(); ++k)
+    {
+      if (binnedData(bestDim, indices[k]) <= bestBin)
+        leftIndices.push_back(indices[k]);
+      else
+        rightIndices.push_back(indices[k]);
+    }
+
+    // Accumulate only the smaller child's histogram; the larger child's is
+    // the parent's minus the smaller child's.
+    Histogram leftHist, rightHist;
+    if (leftIndices.size() <= rightIndices.size())
+    {
+      Accumulate(binnedData, gradients, hessians, leftIndices,
+          hist.gradSums.n_rows, leftHist);
+      Subtract(hist, leftHist, rightHist);
+    }
+    else
+    {
+      Accumulate(binnedData, gradients, hessians, rightIndices,
+          hist.gradSums.n_rows, rightHist);
+      Subtract(hist, rightHist, leftHist);
+    }
+
+    nodes[nodeIndex].isLeaf = false;
+    nodes[nodeIndex].splitDimension = bestDim;
+    nodes[nodeIndex].threshold = binning.Edge(bestDim, bestBin);
+    nodes[nodeIndex].left = BuildNode(binnedData, binning, gradients,
+        hessians, leftIndices, leftHist, depth + 1);
+    nodes[nodeIndex].right = BuildNode(binnedData, binning, gradients,
+        hessians, rightIndices, rightHist, depth + 1);
+
+    return nodeIndex;
+  }
+
+  //! Maximum depth of the tree.
+  size_t maxDepth;
+  //! Minimum number of points in each leaf.
+  size_t minimumLeafSize;
+  //! L2 regularization applied to leaf values and gains.
+  double lambda;
+  //! Minimum gain required to keep a split.
+  double gamma;
+  //! The nodes of the built tree; the root is node 0.
+  std::vector<Node> nodes;
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file methods/xgboost/quantile_binning.hpp
+ * @author Rishabh Garg
+ *
+ * Quantile-based feature binning for histogram gradient boosting.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_QUANTILE_BINNING_HPP
+#define MLPACK_METHODS_XGBOOST_QUANTILE_BINNING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ensemble {
+
+/**
+ * QuantileBinning learns, for every dimension of a dataset, a small set of
+ * bin edges placed at the quantiles of that dimension's values (a simplified
+ * quantile sketch), and maps feature values to bin indices.  Binning the data
+ * once up front lets the tree builder replace exact per-candidate
+ * gradient/hessian sums with fixed-size histograms, which is what makes
+ * histogram gradient boosting fast: every split candidate is a bin edge, so
+ * a node considers at most `maxBins` candidates per dimension no matter how
+ * many points it holds.
+ *
+ * Bin b of a dimension holds the values v with edge[b - 1] < v <= edge[b]
+ * (the last bin is unbounded above), so a split at bin b corresponds to the
+ * raw-value threshold edge[b].
+ */
+class QuantileBinning
+{
+ public:
+  //! Construct an empty binning; call Build() before use.
+  QuantileBinning() { }
+
+  /**
+   * Learn bin edges for each dimension of the given dataset.
+   *
+   * @param data Dataset to learn the binning from.
+   * @param maxBins Maximum number of bins per dimension.
+   */
+  template<typename MatType>
+  QuantileBinning(const MatType& data, const size_t maxBins = 256)
+  {
+    Build(data, maxBins);
+  }
+
+  /**
+   * Learn bin edges for each dimension of the given dataset, replacing any
+   * binning that was built before.
+   *
+   * @param data Dataset to learn the binning from.
+   * @param maxBins Maximum number of bins per dimension.
+   */
+  template<typename MatType>
+  void Build(const MatType& data, const size_t maxBins = 256)
+  {
+    binEdges.clear();
+    binEdges.resize(data.n_rows);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t j = 0; j < (omp_size_t) data.n_rows; ++j)
+    {
+      const arma::rowvec sorted =
+          arma::sort(arma::conv_to<arma::rowvec>::from(data.row(j)));
+
+      // Place candidate edges at evenly spaced quantiles, dropping
+      // duplicates so that every bin is non-empty on the training data.
+      std::vector<double> edges;
+      for (size_t b = 1; b < maxBins; ++b)
+      {
+        const size_t index = (b * (sorted.n_elem - 1)) / maxBins;
+        const double edge = sorted[index];
+        if (edges.empty() || edge > edges.back())
+          edges.push_back(edge);
+      }
+
+      // A constant dimension has no edges (one bin) and cannot be split.
+      if (!edges.empty() && edges.back() >= sorted[sorted.n_elem - 1])
+        edges.pop_back();
+
+      binEdges[j] = arma::vec(edges);
+    }
+  }
+
+  /**
+   * Return the bin index of the given value in the given dimension.
+   */
+  size_t Bin(const size_t dim, const double value) const
+  {
+    // Binary search for the first edge that is >= value.
+    const arma::vec& edges = binEdges[dim];
+    size_t lo = 0;
+    size_t hi = edges.n_elem;
+    while (lo < hi)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (edges[mid] < value)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    return lo;
+  }
+
+  /**
+   * Map an entire dataset to bin indices (one row per dimension, like the
+   * input data).
+   *
+   * @param data Dataset to bin.
+   * @param binnedData Output matrix of bin indices.
+   */
+  template<typename MatType>
+  void Bin(const MatType& data, arma::Mat<uint16_t>& binnedData) const
+  {
+    binnedData.set_size(data.n_rows, data.n_cols);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      for (size_t j = 0; j < data.n_rows; ++j)
+        binnedData(j, i) = (uint16_t) Bin(j, data(j, i));
+    }
+  }
+
+  //! Get the number of bins of the given dimension.
+  size_t NumBins(const size_t dim) const { return binEdges[dim].n_elem + 1; }
+
+  //! Get the largest number of bins of any dimension.
+  size_t MaxNumBins() const
+  {
+    size_t maxBins = 0;
+    for (size_t j = 0; j < binEdges.size(); ++j)
+      maxBins = std::max(maxBins, NumBins(j));
+    return maxBins;
+  }
+
+  //! Get the raw-value threshold of the given bin edge of a dimension.
+  double Edge(const size_t dim, const size_t bin) const
+  {
+    return binEdges[dim][bin];
+  }
+
+  //! Get the number of dimensions the binning was built on.
+  size_t Dimensionality() const { return binEdges.size(); }
+
+  //! Serialize the binning.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(binEdges));
+  }
+
+ private:
+  //! The sorted bin edges of each dimension.
+  std::vector<arma::vec> binEdges;
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
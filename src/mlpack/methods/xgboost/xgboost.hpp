@@ -0,0 +1,172 @@
+/**
+ * @file methods/xgboost/xgboost.hpp
+ * @author Rishabh Garg
+ *
+ * Gradient boosting of histogram-based regression trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "quantile_binning.hpp"
+#include "histogram_tree.hpp"
+#include "loss_functions/sse_loss.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+/**
+ * XGBoost is a gradient boosting ensemble of histogram-based regression
+ * trees (see HistogramTree).  The features are quantile-binned once, before
+ * the first tree; every tree then trains on the binned data, so the per-tree
+ * cost is linear in the number of points regardless of how many split
+ * candidates a node has.
+ *
+ * The current implementation boosts the squared error loss, using the same
+ * gradient/hessian convention as SSELoss: gradient = prediction - observed,
+ * hessian = 1.
+ */
+class XGBoost
+{
+ public:
+  //! Construct an empty model; call Train() before predicting.
+  XGBoost() : initialPrediction(0.0), learningRate(0.1) { }
+
+  /**
+   * Train the model on the given data.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param numTrees Number of boosting iterations (trees).
+   * @param learningRate Shrinkage applied to each tree's output.
+   * @param maxDepth Maximum depth of each tree.
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param lambda L2 regularization applied to leaf values and gains.
+   * @param gamma Minimum gain required to keep a split.
+   * @param maxBins Maximum number of bins per dimension.
+   */
+  template<typename MatType>
+  XGBoost(const MatType& data,
+          const arma::rowvec& responses,
+          const size_t numTrees = 100,
+          const double learningRate = 0.1,
+          const size_t maxDepth = 6,
+          const size_t minimumLeafSize = 1,
+          const double lambda = 0.0,
+          const double gamma = 0.0,
+          const size_t maxBins = 256)
+  {
+    Train(data, responses, numTrees, learningRate, maxDepth, minimumLeafSize,
+        lambda, gamma, maxBins);
+  }
+
+  /**
+   * Train the model on the given data, replacing any previous model.  The
+   * parameters are as in the training constructor.
+   */
+  template<typename MatType>
+  void Train(const MatType& data,
+             const arma::rowvec& responses,
+             const size_t numTrees = 100,
+             const double learningRate = 0.1,
+             const size_t maxDepth = 6,
+             const size_t minimumLeafSize = 1,
+             const double lambda = 0.0,
+             const double gamma = 0.0,
+             const size_t maxBins = 256)
+  {
+    this->learningRate = learningRate;
+
+    // Quantile-bin the features once; every tree trains on the binned data.
+    binning.Build(data, maxBins);
+    arma::Mat<uint16_t> binnedData;
+    binning.Bin(data, binnedData);
+
+    SSELoss loss;
+    initialPrediction = loss.InitialPrediction(responses);
+
+    arma::rowvec predictions(data.n_cols);
+    predictions.fill(initialPrediction);
+
+    trees.clear();
+    trees.reserve(numTrees);
+    for (size_t t = 0; t < numTrees; ++t)
+    {
+      // Squared error loss: gradient = prediction - observed, hessian = 1.
+      const arma::vec gradients = (predictions - responses).t();
+      const arma::vec hessians(data.n_cols, arma::fill::ones);
+
+      trees.emplace_back(maxDepth, minimumLeafSize, lambda, gamma);
+      trees.back().Train(binnedData, binning, gradients, hessians);
+
+      arma::rowvec treePredictions;
+      trees.back().Predict(data, treePredictions);
+      predictions += learningRate * treePredictions;
+    }
+  }
+
+  /**
+   * Predict the response of the given point.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const
+  {
+    double prediction = initialPrediction;
+    for (size_t t = 0; t < trees.size(); ++t)
+      prediction += learningRate * trees[t].Predict(point);
+
+    return prediction;
+  }
+
+  /**
+   * Predict the responses of each of the given points.
+   *
+   * @param data Points to predict for.
+   * @param predictions This will be filled with the prediction of each point.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const
+  {
+    predictions.set_size(data.n_cols);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+      predictions[i] = Predict(data.col(i));
+  }
+
+  //! Get the number of trees in the model.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Get the binning learned from the training data.
+  const QuantileBinning& Binning() const { return binning; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(binning));
+    ar(CEREAL_NVP(trees));
+    ar(CEREAL_NVP(initialPrediction));
+    ar(CEREAL_NVP(learningRate));
+  }
+
+ private:
+  //! The quantile binning of the training features.
+  QuantileBinning binning;
+  //! The boosted trees.
+  std::vector<HistogramTree> trees;
+  //! The constant prediction the trees are boosted from.
+  double initialPrediction;
+  //! Shrinkage applied to each tree's output.
+  double learningRate;
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
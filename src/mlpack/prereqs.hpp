@@ -137,6 +137,8 @@ using enable_if_t = typename enable_if<B, T>::type;
 // All code should have access to logging.
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/timers.hpp>
+#include <mlpack/core/util/fast_timer.hpp>
+#include <mlpack/core/util/profiler.hpp>
 
 // This can be removed with Visual Studio supports an OpenMP version with
 // unsigned loop variables.
@@ -12,6 +12,7 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/knn_evaluation.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
 #include "test_catch_tools.hpp"
@@ -485,3 +486,52 @@ TEST_CASE("AKNNModelMonochromaticTest", "[AKNNTest]")
     }
   }
 }
+
+/**
+ * Test the evaluation harness: with epsilon 0 the sweep must report perfect
+ * recall, and all reported values must be sane.
+ */
+TEST_CASE("KNNEvaluationSweepTest", "[AKNNTest]")
+{
+  arma::mat dataset;
+
+  if (!data::Load("test_data_3_1000.csv", dataset))
+    FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  KNNEvaluation eval(dataset, dataset, 5, 100);
+
+  REQUIRE(eval.SampledQueries().n_cols == 100);
+  REQUIRE(eval.TrueNeighbors().n_rows == 5);
+  REQUIRE(eval.TrueNeighbors().n_cols == 100);
+
+  // Sweep the relative error bound of dual-tree search.
+  arma::mat epsilonResults;
+  eval.SweepEpsilon(arma::vec("0.0 0.5 1.0"), epsilonResults);
+
+  REQUIRE(epsilonResults.n_rows == 3);
+  REQUIRE(epsilonResults.n_cols == 3);
+
+  // Exact search must have perfect recall.
+  REQUIRE(epsilonResults(0, 1) == Approx(1.0).epsilon(1e-10));
+  for (size_t i = 0; i < epsilonResults.n_rows; ++i)
+  {
+    REQUIRE(epsilonResults(i, 1) >= 0.0);
+    REQUIRE(epsilonResults(i, 1) <= 1.0);
+    REQUIRE(epsilonResults(i, 2) >= 0.0);
+  }
+
+  // Sweep the beam width of the small-world graph index.
+  arma::Col<size_t> efValues("16 64");
+  arma::mat efResults;
+  eval.SweepEfSearch(efValues, efResults);
+
+  REQUIRE(efResults.n_rows == 2);
+  REQUIRE(efResults.n_cols == 3);
+  for (size_t i = 0; i < efResults.n_rows; ++i)
+  {
+    REQUIRE(efResults(i, 0) == (double) efValues[i]);
+    REQUIRE(efResults(i, 1) >= 0.0);
+    REQUIRE(efResults(i, 1) <= 1.0);
+    REQUIRE(efResults(i, 2) >= 0.0);
+  }
+}
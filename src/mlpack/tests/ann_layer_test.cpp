@@ -6575,3 +6575,318 @@ TEST_CASE("GradientInstanceNormLayerTest", "[ANNLayerTest]")
   REQUIRE(pass);
 }
 */
+
+/**
+ * Simple Embedding layer test.
+ */
+TEST_CASE("SimpleEmbeddingLayerTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 10;
+  const size_t embeddingSize = 3;
+  const size_t numTokens = 4;
+  const size_t batchSize = 2;
+
+  // Create an Embedding layer outside of a network, and then set its memory.
+  Embedding module(vocabSize, embeddingSize);
+  module.InputDimensions() = std::vector<size_t>({ numTokens });
+  module.ComputeOutputDimensions();
+  arma::mat weights(module.WeightSize(), 1);
+  module.SetWeights(weights.memptr());
+  module.Parameters().randu();
+
+  // Test the Forward function: every token's segment of the output must be
+  // the token's column of the embedding table.
+  arma::mat input(numTokens, batchSize);
+  input = { { 0, 9 }, { 3, 3 }, { 7, 1 }, { 9, 0 } };
+  arma::mat output(numTokens * embeddingSize, batchSize);
+  module.Forward(input, output);
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    for (size_t t = 0; t < numTokens; ++t)
+    {
+      CheckMatrices(arma::mat(output.submat(t * embeddingSize, c,
+          (t + 1) * embeddingSize - 1, c)),
+          arma::mat(module.Embedding().col((size_t) input(t, c))));
+    }
+  }
+
+  // Test the Backward function: token ids are not differentiable, so the
+  // delta must be zero.
+  arma::mat delta(numTokens, batchSize);
+  module.Backward(input, output, delta);
+  REQUIRE(arma::accu(arma::abs(delta)) == 0.0);
+
+  // Test the Gradient function: the error must be scattered into exactly the
+  // columns of the tokens that occur.
+  arma::mat error(numTokens * embeddingSize, batchSize, arma::fill::randu);
+  arma::mat gradient(module.WeightSize(), 1);
+  module.Gradient(input, error, gradient);
+
+  arma::mat referenceGradient(embeddingSize, vocabSize, arma::fill::zeros);
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    for (size_t t = 0; t < numTokens; ++t)
+    {
+      referenceGradient.col((size_t) input(t, c)) += error.submat(
+          t * embeddingSize, c, (t + 1) * embeddingSize - 1, c);
+    }
+  }
+
+  CheckMatrices(gradient, arma::mat(arma::vectorise(referenceGradient)));
+}
+
+/**
+ * Train a small token classification model through an Embedding layer.
+ */
+TEST_CASE("EmbeddingLayerTrainTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 12;
+  const size_t numClasses = 3;
+
+  // Each point is a single token id, and its class is the token id modulo the
+  // number of classes; the network has to learn an embedding that separates
+  // the classes.
+  arma::mat input(1, 600);
+  arma::mat labels(1, 600);
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    const size_t token = math::RandInt(0, vocabSize);
+    input(0, i) = (double) token;
+    labels(0, i) = (double) (token % numClasses);
+  }
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Embedding>(vocabSize, 8);
+  model.Add<Linear>(numClasses);
+  model.Add<LogSoftMax>();
+
+  ens::RMSProp opt(0.05, 32, 0.99, 1e-8, 10 * input.n_cols, 1e-8);
+  model.Train(input, labels, opt);
+
+  arma::mat predictions;
+  model.Predict(input, predictions);
+  size_t correct = 0;
+  for (size_t i = 0; i < predictions.n_cols; ++i)
+    if ((size_t) predictions.col(i).index_max() == (size_t) labels(0, i))
+      ++correct;
+
+  REQUIRE(double(correct) >= 0.9 * input.n_cols);
+}
+
+/**
+ * Simple MultiheadAttention module test: the tiled streaming softmax must give
+ * the same result as an untiled pass and as a naive dense-softmax reference.
+ */
+TEST_CASE("SimpleMultiheadAttentionLayerTest", "[ANNLayerTest]")
+{
+  const size_t embedDim = 4;
+  const size_t seqLen = 7;
+  const size_t numHeads = 2;
+  const size_t headDim = embedDim / numHeads;
+  const size_t batchSize = 3;
+
+  // Use a tile size smaller than the sequence length, so that the streaming
+  // softmax has to process several tiles.
+  MultiheadAttention module(numHeads, 3);
+  module.InputDimensions() = std::vector<size_t>({ embedDim, seqLen });
+  module.ComputeOutputDimensions();
+
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randu);
+  weights -= 0.5;
+  module.SetWeights(weights.memptr());
+
+  arma::mat input(embedDim * seqLen, batchSize, arma::fill::randn);
+  arma::mat output(embedDim * seqLen, batchSize);
+  module.Forward(input, output);
+
+  // A module with a tile size larger than the sequence computes the softmax
+  // in one pass; the results must agree exactly.
+  MultiheadAttention untiled(numHeads, seqLen + 5);
+  untiled.InputDimensions() = std::vector<size_t>({ embedDim, seqLen });
+  untiled.ComputeOutputDimensions();
+  untiled.SetWeights(weights.memptr());
+
+  arma::mat untiledOutput(embedDim * seqLen, batchSize);
+  untiled.Forward(input, untiledOutput);
+  CheckMatrices(output, untiledOutput);
+
+  // Now compare against a naive reference that materializes the full score
+  // matrix.  The weight layout matches MultiheadAttentionType::SetWeights().
+  size_t o = 0;
+  arma::mat wq(weights.memptr() + o, embedDim, embedDim);
+  o += embedDim * embedDim;
+  arma::vec bq(weights.memptr() + o, embedDim);
+  o += embedDim;
+  arma::mat wk(weights.memptr() + o, embedDim, embedDim);
+  o += embedDim * embedDim;
+  arma::vec bk(weights.memptr() + o, embedDim);
+  o += embedDim;
+  arma::mat wv(weights.memptr() + o, embedDim, embedDim);
+  o += embedDim * embedDim;
+  arma::vec bv(weights.memptr() + o, embedDim);
+  o += embedDim;
+  arma::mat wo(weights.memptr() + o, embedDim, embedDim);
+  o += embedDim * embedDim;
+  arma::vec bo(weights.memptr() + o, embedDim);
+
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    arma::mat x = arma::reshape(input.col(c), embedDim, seqLen);
+    arma::mat q = wq * x;
+    q.each_col() += bq;
+    arma::mat k = wk * x;
+    k.each_col() += bk;
+    arma::mat v = wv * x;
+    v.each_col() += bv;
+
+    arma::mat attn(embedDim, seqLen);
+    for (size_t h = 0; h < numHeads; ++h)
+    {
+      const size_t r0 = h * headDim, r1 = r0 + headDim - 1;
+      arma::mat s = k.rows(r0, r1).t() * q.rows(r0, r1) /
+          std::sqrt((double) headDim);
+      for (size_t i = 0; i < seqLen; ++i)
+      {
+        s.col(i) = arma::exp(s.col(i) - s.col(i).max());
+        s.col(i) /= arma::accu(s.col(i));
+      }
+      attn.rows(r0, r1) = v.rows(r0, r1) * s;
+    }
+
+    arma::mat reference = wo * attn;
+    reference.each_col() += bo;
+    arma::mat outputSeq = arma::reshape(output.col(c), embedDim, seqLen);
+    CheckMatrices(outputSeq, reference);
+  }
+}
+
+/**
+ * Simple Gradient test for the MultiheadAttention layer.
+ */
+TEST_CASE("GradientMultiheadAttentionLayerTest", "[ANNLayerTest]")
+{
+  // MultiheadAttention function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        embedDim(4),
+        nPoints(6),
+        batchSize(2)
+    {
+      input = arma::randu(embedDim * nPoints, batchSize);
+      target = arma::randu(nPoints, batchSize);
+
+      model = new FFN<MeanSquaredError, RandomInitialization>();
+      model->ResetData(input, target);
+      model->Add<Linear3D>(embedDim);
+      // Two heads, and a tile size that does not divide the sequence length.
+      model->Add<MultiheadAttention>(2, 4);
+      model->Add<Linear3D>(1);
+      model->InputDimensions() = std::vector<size_t>{ embedDim, nPoints };
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, batchSize);
+      model->Gradient(model->Parameters(), 0, gradient, batchSize);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<MeanSquaredError, RandomInitialization>* model;
+    arma::mat input, target;
+    const size_t embedDim;
+    const size_t nPoints;
+    const size_t batchSize;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
+
+/**
+ * Simple test for the BatchNorm layer: with gamma fixed to 1 and beta fixed to
+ * 0, each channel of the training-mode output should be normalized to zero
+ * mean and unit variance over the batch.
+ */
+TEST_CASE("SimpleBatchNormLayerTest", "[ANNLayerTest]")
+{
+  arma::mat input(5, 16, arma::fill::randu);
+  // Give the channels different scales and offsets.
+  input.row(2) *= 10.0;
+  input.row(4) += 3.0;
+
+  BatchNorm module;
+  module.InputDimensions() = std::vector<size_t>({ 5 });
+  module.ComputeOutputDimensions();
+
+  arma::mat weights(module.WeightSize(), 1);
+  module.CustomInitialize(weights, module.WeightSize());
+  module.SetWeights(weights.memptr());
+  module.Training() = true;
+
+  arma::mat output;
+  module.Forward(input, output);
+
+  for (size_t c = 0; c < input.n_rows; ++c)
+  {
+    REQUIRE(arma::as_scalar(arma::mean(output.row(c), 1)) ==
+        Approx(0.0).margin(1e-7));
+    REQUIRE(arma::as_scalar(arma::var(output.row(c), 1, 1)) ==
+        Approx(1.0).epsilon(1e-3));
+  }
+
+  // After a single training pass with cumulative averaging, the running mean
+  // should be exactly the batch mean.
+  CheckMatrices(arma::mat(module.TrainingMean()),
+      arma::mat(arma::mean(input, 1)), 1e-8);
+}
+
+/**
+ * Check the numerical gradient of a network containing a BatchNorm layer.
+ */
+TEST_CASE("GradientBatchNormLayerTest", "[ANNLayerTest]")
+{
+  // BatchNorm function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        batchSize(16)
+    {
+      input = arma::randu(10, batchSize) * 5.0;
+      target = arma::randu(2, batchSize);
+
+      model = new FFN<MeanSquaredError, RandomInitialization>();
+      model->ResetData(input, target);
+      model->Add<Linear>(5);
+      model->Add<BatchNorm>();
+      model->Add<Linear>(2);
+      model->InputDimensions() = std::vector<size_t>{ 10 };
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, batchSize);
+      model->Gradient(model->Parameters(), 0, gradient, batchSize);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<MeanSquaredError, RandomInitialization>* model;
+    arma::mat input, target;
+    const size_t batchSize;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
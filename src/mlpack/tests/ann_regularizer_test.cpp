@@ -111,3 +111,49 @@ TEST_CASE("GradientOrthogonalRegularizerTest", "[ANNRegularizerTest]")
 
   REQUIRE(CheckRegularizerGradient(function) <= 1e-4);
 }
+
+/**
+ * Check that the lazy per-column path of the L-regularizers applies exactly
+ * the regularization that the dense path would have accumulated over the
+ * steps a column was skipped.
+ */
+TEST_CASE("LazyLRegularizerTest", "[ANNRegularizerTest]")
+{
+  const double factor = 0.6;
+  const arma::mat weight = arma::randu(4, 6);
+  L2Regularizer reg(factor);
+
+  // Step 1: only column 2 is touched.
+  arma::mat gradient = arma::zeros(4, 6);
+  reg.LazyEvaluate(weight, gradient, arma::uvec { 2 });
+
+  arma::mat expected = arma::zeros(4, 6);
+  expected.col(2) = 2 * factor * weight.col(2);
+  CheckMatrices(gradient, expected);
+
+  // Step 2: no columns are touched at all.
+  gradient.zeros();
+  reg.LazyEvaluate(weight, gradient, arma::uvec());
+  REQUIRE(arma::accu(arma::abs(gradient)) == Approx(0.0).margin(1e-10));
+
+  // Step 3: columns 2 and 4 are touched.  Column 2 was last regularized two
+  // steps ago; column 4 has never been regularized, so it accumulated all
+  // three steps.
+  gradient.zeros();
+  reg.LazyEvaluate(weight, gradient, arma::uvec { 2, 4 });
+
+  expected.zeros();
+  expected.col(2) = 2 * (2 * factor * weight.col(2));
+  expected.col(4) = 3 * (2 * factor * weight.col(4));
+  CheckMatrices(gradient, expected);
+
+  // The L1 path uses the same bookkeeping; check one skipped step there too.
+  L1Regularizer l1Reg(factor);
+  gradient.zeros();
+  l1Reg.LazyEvaluate(weight, gradient, arma::uvec());
+  l1Reg.LazyEvaluate(weight, gradient, arma::uvec { 1 });
+
+  expected.zeros();
+  expected.col(1) = 2 * factor * weight.col(1) / arma::abs(weight.col(1));
+  CheckMatrices(gradient, expected);
+}
@@ -375,3 +375,46 @@ TEST_CASE("BiasSVDFunctionParallelOptimize", "[BiasSVDTest]")
 }
 
 #endif
+
+// Test the warm-started Apply() overload, which reuses a previous
+// factorization as the starting point and trains with sharded parallel SGD.
+TEST_CASE("BiasSVDWarmStartOutputSizeTest", "[BiasSVDTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 100;
+  const size_t numItems = 50;
+  const size_t numRatings = 500;
+  const size_t maxRating = 5;
+  const size_t rank = 5;
+  const size_t iterations = 10;
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+  data.row(2) = floor(data.row(2) * maxRating + 0.5);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Resulting user/item matrices/bias.
+  arma::mat userLatent, itemLatent;
+  arma::vec userBias, itemBias;
+
+  // First fit: no usable factors yet, so this falls back to random
+  // initialization.
+  BiasSVD<> biasSVD(iterations);
+  biasSVD.Apply(data, rank, itemLatent, userLatent, itemBias, userBias, false);
+
+  // Refit starting from the factors of the first fit.
+  biasSVD.Apply(data, rank, itemLatent, userLatent, itemBias, userBias, true);
+
+  // Check the size of outputs.
+  REQUIRE(itemLatent.n_rows == numItems);
+  REQUIRE(itemLatent.n_cols == rank);
+  REQUIRE(userLatent.n_rows == rank);
+  REQUIRE(userLatent.n_cols == numUsers);
+  REQUIRE(itemBias.n_elem == numItems);
+  REQUIRE(userBias.n_elem == numUsers);
+}
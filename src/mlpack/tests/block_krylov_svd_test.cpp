@@ -106,3 +106,30 @@ TEST_CASE("RandomizedBlockKrylovSVDNoisyLowRankTest", "[BlockKrylovSVDTest]")
   double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
   REQUIRE(error == Approx(0.0).margin(1e-4));
 }
+
+/**
+ * The pipelined (multi-threaded) subspace construction should give the same
+ * quality of results as the serial path.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDPipelinedTest", "[BlockKrylovSVDTest]")
+{
+  arma::mat data;
+  CreateNoisyLowRankMatrix(data, 200, 1000, 5, 0.5);
+
+  const size_t rank = 5;
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+
+  arma::svd_econ(U1, s1, V1, data);
+
+  // Request at least two threads, which enables the pipelined panel path;
+  // without OpenMP this still runs the serial path.
+  svd::RandomizedBlockKrylovSVD rSVD(10, 20, 2);
+  rSVD.Apply(data, U2, s2, V2, rank);
+
+  // The singular value error should be small.
+  const double error = arma::max(arma::abs(
+      s1.subvec(0, rank) - s2.subvec(0, rank)));
+  REQUIRE(error == Approx(0.0).margin(1e-4));
+}
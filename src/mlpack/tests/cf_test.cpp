@@ -13,6 +13,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/cf/cf.hpp>
+#include <mlpack/methods/cf/decomposition_policies/als_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
@@ -589,6 +590,15 @@ TEST_CASE("CFGetRecommendationsAllUsersSVDPPTest", "[CFTest]")
   GetRecommendationsAllUsers<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for regularized ALS.
+ */
+TEST_CASE("CFGetRecommendationsAllUsersALSTest", "[CFTest]")
+{
+  GetRecommendationsAllUsers<ALSPolicy>();
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for randomized SVD.
@@ -661,6 +671,15 @@ TEST_CASE("CFGetRecommendationsQueriedUserSVDPPTest", "[CFTest]")
   GetRecommendationsQueriedUser<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that the recommendations are generated for queried users only
+ * for regularized ALS.
+ */
+TEST_CASE("CFGetRecommendationsQueriedUserALSTest", "[CFTest]")
+{
+  GetRecommendationsQueriedUser<ALSPolicy>();
+}
+
 /**
  * Make sure recommendations that are generated are reasonably accurate
  * for randomized SVD.
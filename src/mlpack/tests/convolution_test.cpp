@@ -16,6 +16,8 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 
 #include "serialization.hpp"
 #include "catch.hpp"
@@ -188,6 +190,14 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -225,6 +235,14 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -270,6 +288,14 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  Convolution3DMethodTest<WinogradConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -319,6 +345,14 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  Convolution3DMethodTest<WinogradConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -361,6 +395,14 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  ConvolutionMethodBatchTest<WinogradConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -407,6 +449,14 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  ConvolutionMethodBatchTest<WinogradConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -432,6 +482,10 @@ TEST_CASE("Stride2ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 1, 1);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 1, 1);
 }
 
 TEST_CASE("Stride3ConvolutionTest", "[ConvolutionTest]")
@@ -452,6 +506,10 @@ TEST_CASE("Stride3ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 3, 1, 1);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 3, 1, 1);
 }
 
 TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
@@ -473,6 +531,10 @@ TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 2, 1, 1);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 2, 1, 1);
 }
 
 TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
@@ -497,6 +559,10 @@ TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 2, 2);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 2, 2);
 }
 
 TEST_CASE("Dilation3ConvolutionTest", "[ConvolutionTest]")
@@ -522,6 +588,10 @@ TEST_CASE("Dilation3ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 3);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 3);
 }
 
 TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
@@ -546,6 +616,10 @@ TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 2);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 2);
 }
 
 TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
@@ -567,4 +641,56 @@ TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 2, 2);
+
+  // Perform the convolution through im2col and matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 2, 2);
+}
+
+/**
+ * Test that the Winograd convolution matches the naive convolution on random
+ * inputs whose output sizes are odd, so the edge tiles must be clipped, and
+ * that unsupported kernel shapes fall back correctly.
+ */
+TEST_CASE("WinogradConvolutionComparisonTest", "[ConvolutionTest]")
+{
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    // Odd output sizes: (7 - 2) x (6 - 2) = 5 x 4 for the valid mode.
+    arma::mat input = arma::randu<arma::mat>(7 + trial, 6 + trial);
+    arma::mat filter = arma::randu<arma::mat>(3, 3);
+
+    arma::mat naiveOutput, winogradOutput;
+    NaiveConvolution<ValidConvolution>::Convolution(input, filter,
+        naiveOutput);
+    WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+        winogradOutput);
+
+    REQUIRE(winogradOutput.n_rows == naiveOutput.n_rows);
+    REQUIRE(winogradOutput.n_cols == naiveOutput.n_cols);
+    REQUIRE(arma::norm(winogradOutput - naiveOutput, "fro") ==
+        Approx(0.0).margin(1e-10));
+
+    NaiveConvolution<FullConvolution>::Convolution(input, filter,
+        naiveOutput);
+    WinogradConvolution<FullConvolution>::Convolution(input, filter,
+        winogradOutput);
+
+    REQUIRE(winogradOutput.n_rows == naiveOutput.n_rows);
+    REQUIRE(winogradOutput.n_cols == naiveOutput.n_cols);
+    REQUIRE(arma::norm(winogradOutput - naiveOutput, "fro") ==
+        Approx(0.0).margin(1e-10));
+
+    // A 5x5 kernel is not covered by F(2x2, 3x3) and must fall back.
+    arma::mat bigFilter = arma::randu<arma::mat>(5, 5);
+    NaiveConvolution<ValidConvolution>::Convolution(input, bigFilter,
+        naiveOutput);
+    WinogradConvolution<ValidConvolution>::Convolution(input, bigFilter,
+        winogradOutput);
+
+    REQUIRE(winogradOutput.n_rows == naiveOutput.n_rows);
+    REQUIRE(winogradOutput.n_cols == naiveOutput.n_cols);
+    REQUIRE(arma::norm(winogradOutput - naiveOutput, "fro") ==
+        Approx(0.0).margin(1e-10));
+  }
 }
@@ -434,3 +434,77 @@ TEST_CASE("MoveConstructorAndOperatorCosineTreeTest", "[CosineTreeTest]")
     REQUIRE(v1.at(i) == v3.at(i));
   }
 }
+
+/**
+ * Constructs a cosine tree that needs many splits (so that, with OpenMP, the
+ * frontier is expanded several nodes at a time), and checks that the
+ * resulting basis is still orthonormal.
+ */
+TEST_CASE("CosineTreeBatchConstruction", "[CosineTreeTest]")
+{
+  // Initialize constants required for the test.
+  const size_t numRows = 100;
+  const size_t numCols = 1000;
+  const double epsilon = 0.3;
+  const double delta = 0.1;
+
+  // Make a random dataset.
+  arma::mat data = arma::randu(numRows, numCols);
+
+  // Make a cosine tree, with the generated dataset and the defined constants.
+  CosineTree ctree(data, epsilon, delta);
+  arma::mat basis;
+  ctree.GetFinalBasis(basis);
+
+  // A random matrix of this size needs more than one split for this
+  // tolerance.
+  REQUIRE(basis.n_cols > 1);
+
+  // Intra-batch children are orthogonalized against each other one at a time;
+  // the basis as a whole must still be orthonormal.
+  for (size_t i = 0; i < basis.n_cols; ++i)
+  {
+    REQUIRE(arma::norm(basis.col(i), 2) == Approx(1.0).epsilon(1e-7));
+    for (size_t j = i + 1; j < basis.n_cols; ++j)
+      REQUIRE(arma::dot(basis.col(i), basis.col(j)) ==
+          Approx(0.0).margin(1e-7));
+  }
+}
+
+/**
+ * Constructs a cosine tree with a maximum rank, and checks that the size of
+ * the basis never exceeds that rank even when the error tolerance cannot be
+ * met.
+ */
+TEST_CASE("CosineTreeMaxRank", "[CosineTreeTest]")
+{
+  // Initialize constants required for the test.  The tolerance is set low
+  // enough that an unbounded construction would need far more than 'maxRank'
+  // basis vectors for a random (full-rank) matrix.
+  const size_t numRows = 100;
+  const size_t numCols = 500;
+  const double epsilon = 0.01;
+  const double delta = 0.1;
+  const size_t maxRank = 5;
+
+  // Make a random dataset.
+  arma::mat data = arma::randu(numRows, numCols);
+
+  // Make a cosine tree, with the generated dataset and the defined constants.
+  CosineTree ctree(data, epsilon, delta, maxRank);
+  arma::mat basis;
+  ctree.GetFinalBasis(basis);
+
+  // The basis must respect the rank bound.
+  REQUIRE(basis.n_cols <= maxRank);
+  REQUIRE(basis.n_cols >= 1);
+
+  // The basis should still be orthonormal.
+  for (size_t i = 0; i < basis.n_cols; ++i)
+  {
+    REQUIRE(arma::norm(basis.col(i), 2) == Approx(1.0).epsilon(1e-7));
+    for (size_t j = i + 1; j < basis.n_cols; ++j)
+      REQUIRE(arma::dot(basis.col(i), basis.col(j)) ==
+          Approx(0.0).margin(1e-7));
+  }
+}
@@ -178,6 +178,28 @@ TEST_CASE("ConfusionMatrixTest", "[CVTest]")
   REQUIRE(output(1, 1) == 3);
 }
 
+/**
+ * Test that the confusion matrix of a large random prediction set is exact;
+ * this also exercises the multi-threaded accumulation path.
+ */
+TEST_CASE("LargeConfusionMatrixTest", "[CVTest]")
+{
+  const size_t numClasses = 7;
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(
+      5000, arma::distr_param(0, numClasses - 1));
+  arma::Row<size_t> predictedLabels = arma::randi<arma::Row<size_t>>(
+      5000, arma::distr_param(0, numClasses - 1));
+
+  arma::Mat<size_t> output;
+  data::ConfusionMatrix(predictedLabels, labels, output, numClasses);
+
+  arma::Mat<size_t> expected(numClasses, numClasses, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    expected(predictedLabels[i], labels[i])++;
+
+  REQUIRE(arma::accu(output == expected) == numClasses * numClasses);
+}
+
 /**
  * Test metrics for multiclass classification.
  */
@@ -613,6 +635,41 @@ TEST_CASE("KFoldCVAccuracyTest", "[CVTest]")
   REQUIRE_NOTHROW(cv.Model());
 }
 
+/**
+ * Test k-fold cross-validation can be run on a reduced number of folds (a
+ * partial evaluation budget).
+ */
+TEST_CASE("KFoldCVNumEvaluationFoldsTest", "[CVTest]")
+{
+  // The same dataset as in KFoldCVAccuracyTest: the last point (validated in
+  // the first fold) should be classified wrong when it is tested separately.
+  arma::mat data("0 1 2 3 100 101 102 103 104 5");
+  arma::Row<size_t> labels("0 0 0 0 1 1 1 1 1 1");
+  size_t numClasses = 2;
+
+  // 10-fold cross-validation, no shuffling.
+  KFoldCV<NaiveBayesClassifier<>, Accuracy> cv(10, data, labels, numClasses,
+      false);
+
+  // The first nine folds contain the only misclassified point.
+  cv.NumEvaluationFolds() = 9;
+  REQUIRE(cv.Evaluate() == Approx(8.0 / 9).epsilon(1e-7));
+
+  // Assert we can access a trained model without the exception of
+  // uninitialization.
+  REQUIRE_NOTHROW(cv.Model());
+
+  // Restoring the full budget should give the usual 10-fold score.
+  cv.NumEvaluationFolds() = 10;
+  REQUIRE(cv.Evaluate() == Approx(0.9).epsilon(1e-7));
+
+  // Out-of-range budgets should be rejected.
+  cv.NumEvaluationFolds() = 0;
+  REQUIRE_THROWS_AS(cv.Evaluate(), std::invalid_argument);
+  cv.NumEvaluationFolds() = 11;
+  REQUIRE_THROWS_AS(cv.Evaluate(), std::invalid_argument);
+}
+
 /**
  * Test k-fold cross-validation with the perceptron.
  */
@@ -306,3 +306,57 @@ TEST_CASE("RandomPointSelectionTest", "[DBSCANTest]")
   // The number of assignments returned should be the same as points.
   REQUIRE(assignments.n_elem == points.n_cols);
 }
+
+/**
+ * Check that the grid-based range search engine gives the same clustering as
+ * the default tree-based engine, in both batch and pointwise modes.
+ */
+TEST_CASE("GridRangeSearchTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 500, arma::fill::randu);
+
+  DBSCAN<> tree(0.1, 3);
+  arma::Row<size_t> treeAssignments;
+  const size_t treeClusters = tree.Cluster(points, treeAssignments);
+
+  DBSCAN<GridRangeSearch<>> grid(0.1, 3);
+  arma::Row<size_t> gridAssignments;
+  const size_t gridClusters = grid.Cluster(points, gridAssignments);
+
+  // Cluster numbering may depend on the order unions happen in, so compare
+  // the partitions through a label mapping instead of directly.
+  REQUIRE(gridClusters == treeClusters);
+  std::map<size_t, size_t> labelMap;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (treeAssignments[i] == SIZE_MAX)
+    {
+      REQUIRE(gridAssignments[i] == SIZE_MAX);
+      continue;
+    }
+
+    if (labelMap.count(treeAssignments[i]) == 0)
+      labelMap[treeAssignments[i]] = gridAssignments[i];
+    REQUIRE(gridAssignments[i] == labelMap[treeAssignments[i]]);
+  }
+
+  DBSCAN<GridRangeSearch<>> gridPointwise(0.1, 3, false);
+  arma::Row<size_t> pointwiseAssignments;
+  const size_t pointwiseClusters = gridPointwise.Cluster(points,
+      pointwiseAssignments);
+
+  REQUIRE(pointwiseClusters == treeClusters);
+  labelMap.clear();
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (treeAssignments[i] == SIZE_MAX)
+    {
+      REQUIRE(pointwiseAssignments[i] == SIZE_MAX);
+      continue;
+    }
+
+    if (labelMap.count(treeAssignments[i]) == 0)
+      labelMap[treeAssignments[i]] = pointwiseAssignments[i];
+    REQUIRE(pointwiseAssignments[i] == labelMap[treeAssignments[i]]);
+  }
+}
@@ -1100,3 +1100,195 @@ TEST_CASE("WeightedDecisionTreeMADGainTest", "[DecisionTreeRegressorTest]")
   double rmse = RMSE(predictions, testResponses);
   REQUIRE(rmse < 6.5);
 }
+
+/**
+ * Check that the HistogramBinaryNumericSplit splits a splittable dimension for
+ * regression, using the optimized scan of MSEGain.
+ */
+TEST_CASE("HistogramBinaryNumericSplitSimpleSplitTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors =
+      { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0 };
+  arma::rowvec responses =
+      { 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  double splitInfo;
+  HistogramBinaryNumericSplit<MSEGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MSEGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+  const double weightedGain =
+      HistogramBinaryNumericSplit<MSEGain>::SplitIfBetter<true>(bestGain,
+      predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == weightedGain);
+
+  // The split point should be a bin boundary between 0.4 and 0.5.
+  REQUIRE(splitInfo > 0.4);
+  REQUIRE(splitInfo < 0.5);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit splits a splittable dimension for
+ * regression with a fitness function that has no optimized scan (MADGain).
+ */
+TEST_CASE("HistogramBinaryNumericSplitMADGainTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors =
+      { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0 };
+  arma::rowvec responses =
+      { 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  double splitInfo;
+  HistogramBinaryNumericSplit<MADGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MADGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<MADGain>::SplitIfBetter<false>(
+      bestGain, predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+  const double weightedGain =
+      HistogramBinaryNumericSplit<MADGain>::SplitIfBetter<true>(bestGain,
+      predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == weightedGain);
+
+  // The split point should be a bin boundary between 0.4 and 0.5.
+  REQUIRE(splitInfo > 0.4);
+  REQUIRE(splitInfo < 0.5);
+}
+
+/**
+ * Check that the BestBinaryCategoricalSplit finds the right binary partition
+ * of the categories for regression, using the optimized scan of MSEGain.
+ */
+TEST_CASE("BestBinaryCategoricalSplitSimpleSplitTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec values = { 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 };
+  arma::rowvec responses =
+      { 1.0, 5.0, 1.0, 5.0, 1.0, 5.0, 1.0, 5.0, 1.0, 5.0, 1.0, 5.0 };
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  double splitInfo;
+  BestBinaryCategoricalSplit<MSEGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MSEGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain = BestBinaryCategoricalSplit<MSEGain>::SplitIfBetter<
+      false>(bestGain, values, 4, responses, weights, 3, 1e-7, splitInfo,
+      aux, f);
+  const double weightedGain = BestBinaryCategoricalSplit<MSEGain>::
+      SplitIfBetter<true>(bestGain, values, 4, responses, weights, 3, 1e-7,
+      splitInfo, aux, f);
+
+  // Make sure that a split was made, and that it is perfect.
+  REQUIRE(gain > bestGain);
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+  REQUIRE(gain == weightedGain);
+
+  // Categories 0 and 2 have mean response 1.0, and categories 1 and 3 have
+  // mean response 5.0, so the partition must be { 0, 2 } against { 1, 3 }.
+  const size_t d0 = BestBinaryCategoricalSplit<MSEGain>::CalculateDirection(
+      0.0, splitInfo, aux);
+  const size_t d1 = BestBinaryCategoricalSplit<MSEGain>::CalculateDirection(
+      1.0, splitInfo, aux);
+  const size_t d2 = BestBinaryCategoricalSplit<MSEGain>::CalculateDirection(
+      2.0, splitInfo, aux);
+  const size_t d3 = BestBinaryCategoricalSplit<MSEGain>::CalculateDirection(
+      3.0, splitInfo, aux);
+  REQUIRE(d0 == d2);
+  REQUIRE(d1 == d3);
+  REQUIRE(d0 != d1);
+}
+
+/**
+ * Check that the BestBinaryCategoricalSplit also works with a fitness
+ * function that has no optimized scan (MADGain).
+ */
+TEST_CASE("BestBinaryCategoricalSplitMADGainTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec values = { 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 };
+  arma::rowvec responses =
+      { 1.0, 5.0, 1.0, 5.0, 1.0, 5.0, 1.0, 5.0, 1.0, 5.0, 1.0, 5.0 };
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  double splitInfo;
+  BestBinaryCategoricalSplit<MADGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  MADGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain = BestBinaryCategoricalSplit<MADGain>::SplitIfBetter<
+      false>(bestGain, values, 4, responses, weights, 3, 1e-7, splitInfo,
+      aux, f);
+  const double weightedGain = BestBinaryCategoricalSplit<MADGain>::
+      SplitIfBetter<true>(bestGain, values, 4, responses, weights, 3, 1e-7,
+      splitInfo, aux, f);
+
+  // Make sure that a split was made, and that it is perfect.
+  REQUIRE(gain > bestGain);
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+  REQUIRE(gain == weightedGain);
+
+  const size_t d0 = BestBinaryCategoricalSplit<MADGain>::CalculateDirection(
+      0.0, splitInfo, aux);
+  const size_t d1 = BestBinaryCategoricalSplit<MADGain>::CalculateDirection(
+      1.0, splitInfo, aux);
+  REQUIRE(d0 != d1);
+}
+
+/**
+ * Test that we can build a regression tree with binary categorical splits on
+ * a simple categorical dataset.
+ */
+TEST_CASE("BestBinaryCategoricalBuildTest_", "[DecisionTreeRegressorTest]")
+{
+  arma::mat d;
+  arma::rowvec r;
+  data::DatasetInfo di;
+  MockCategoricalData(d, r, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::rowvec trainingResponses = r.subvec(0, 1999);
+  arma::rowvec testResponses = r.subvec(2000, 3999);
+
+  // Build the tree.
+  DecisionTreeRegressor<MSEGain, BestBinaryNumericSplit,
+      BestBinaryCategoricalSplit> tree(trainingData, di, trainingResponses,
+      10 /* Minimum leaf size of 10. */);
+
+  // Now evaluate the quality of predictions.
+  arma::rowvec predictions;
+  tree.Predict(testData, predictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+
+  const double rmse = RMSE(predictions, testResponses);
+  REQUIRE(rmse < 1.05);
+}
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/decision_tree/flat_decision_tree.hpp>
 #include <mlpack/methods/decision_tree/information_gain.hpp>
 #include <mlpack/methods/decision_tree/gini_gain.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
@@ -315,6 +316,78 @@ TEST_CASE("BestBinaryNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities[0] < 0.5);
 }
 
+/**
+ * Check that the sorted-order overload of BestBinaryNumericSplit finds the
+ * same split as the sorting overload.
+ */
+TEST_CASE("BestBinaryNumericSplitSortedOrderTest", "[DecisionTreeTest]")
+{
+  arma::vec values = arma::randu<arma::vec>(100);
+  arma::Row<size_t> labels(values.n_elem);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (values[i] > 0.6);
+  arma::rowvec weights = arma::randu<arma::rowvec>(values.n_elem) + 0.1;
+
+  const double bestGain = GiniGain::Evaluate<true>(labels, 2, weights);
+
+  arma::vec classProbabilities;
+  BestBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+  const double gain = BestBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // The precomputed order must give exactly the same gain and split point.
+  const arma::uvec sortedIndices = arma::sort_index(values);
+  arma::vec sortedClassProbabilities;
+  const double sortedGain =
+      BestBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      sortedIndices, labels, 2, weights, 3, 1e-7, sortedClassProbabilities,
+      aux);
+
+  REQUIRE(gain == sortedGain);
+  REQUIRE(sortedClassProbabilities.n_elem == classProbabilities.n_elem);
+  REQUIRE(sortedClassProbabilities[0] == classProbabilities[0]);
+}
+
+/**
+ * Check that a decision stump trained with a precomputed sorted-order cache
+ * is identical to one trained without it.
+ */
+TEST_CASE("DecisionTreeSortedOrderConstructorTest", "[DecisionTreeTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(10, 1000);
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (data(3, i) + data(7, i) > 1.0);
+  arma::rowvec weights = arma::randu<arma::rowvec>(data.n_cols) + 0.1;
+
+  ID3DecisionStump starter;
+  ID3DecisionStump plain(starter, data, labels, 2, weights);
+
+  // One column of point indices per dimension.
+  arma::umat sortedOrders(data.n_cols, data.n_rows);
+  for (size_t j = 0; j < data.n_rows; ++j)
+  {
+    sortedOrders.col(j) =
+        arma::conv_to<arma::uvec>::from(arma::sort_index(data.row(j)));
+  }
+
+  ID3DecisionStump cached(starter, data, labels, 2, weights, sortedOrders);
+
+  // The two stumps must make identical predictions.
+  arma::Row<size_t> plainPredictions, cachedPredictions;
+  plain.Classify(data, plainPredictions);
+  cached.Classify(data, cachedPredictions);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(plainPredictions[i] == cachedPredictions[i]);
+
+  // A cache of the wrong shape must be rejected.
+  arma::umat badOrders(data.n_rows, data.n_cols);
+  REQUIRE_THROWS_AS(
+      ID3DecisionStump(starter, data, labels, 2, weights, badOrders),
+      std::invalid_argument);
+}
+
 /**
  * Check that the BestBinaryNumericSplit won't split if not enough points are
  * given.
@@ -1399,3 +1472,389 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * Check that the HistogramBinaryNumericSplit will split on an obviously
+ * splittable dimension.
+ */
+TEST_CASE("HistogramBinaryNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+  const double weightedGain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == weightedGain);
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  // The class probabilities, for this split, hold the splitting point, which
+  // should be a bin boundary between 0.4 and 0.5.
+  REQUIRE(classProbabilities.n_elem == 1);
+  REQUIRE(classProbabilities[0] > 0.4);
+  REQUIRE(classProbabilities[0] < 0.5);
+}
+
+/**
+ * Check that the HistogramBinaryNumericSplit won't split if not enough points
+ * are given.
+ */
+TEST_CASE("HistogramBinaryNumericSplitMinSamplesTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+
+  arma::vec classProbabilities;
+  HistogramBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+  // This should make no difference because it won't split at all.
+  const double weightedGain =
+      HistogramBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+      values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+
+  // Make sure that no split was made.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(gain == weightedGain);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * Make sure a decision tree using the histogram numeric splitter can learn a
+ * simple separable problem.
+ */
+TEST_CASE("HistogramNumericSplitTreeTest", "[DecisionTreeTest]")
+{
+  // Two well-separated Gaussian classes in five dimensions.
+  arma::mat dataset(5, 1000, arma::fill::randn);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    dataset.col(i) += 4.0;
+    labels[i] = 1;
+  }
+  labels.head(500).fill(0);
+
+  DecisionTree<GiniGain, HistogramBinaryNumericSplit> tree(dataset, labels, 2,
+      5 /* minimum leaf size */);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+
+  const size_t correct = arma::accu(predictions == labels);
+  REQUIRE(correct > 950);
+}
+
+/**
+ * Make sure a tree built on a dataset large enough to trigger the parallel
+ * dimension scan and the task-based subtree builds still learns the problem.
+ */
+TEST_CASE("LargeDatasetParallelBuildTest", "[DecisionTreeTest]")
+{
+  // Two well-separated Gaussian classes; the node sizes here are large enough
+  // that, when OpenMP is enabled, the dimension scan runs in parallel and the
+  // subtree builds are spawned as tasks.
+  const size_t points = 50000;
+  arma::mat dataset(10, points, arma::fill::randn);
+  arma::Row<size_t> labels(points);
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    dataset.col(i) += 3.0;
+    labels[i] = 1;
+  }
+  labels.head(points / 2).fill(0);
+
+  DecisionTree<> tree(dataset, labels, 2, 10 /* minimum leaf size */);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+
+  const size_t correct = arma::accu(predictions == labels);
+  REQUIRE(correct > 0.95 * points);
+}
+
+/**
+ * A flattened tree should use 16 bytes per node and produce exactly the same
+ * predictions and probabilities as the tree it was built from.
+ */
+TEST_CASE("FlatDecisionTreeNumericTest", "[DecisionTreeTest]")
+{
+  REQUIRE(sizeof(FlatDecisionTree::FlatNode) == 16);
+
+  // Two noisy Gaussian classes in five dimensions.
+  arma::mat dataset(5, 2000, arma::fill::randn);
+  arma::Row<size_t> labels(2000);
+  for (size_t i = 1000; i < 2000; ++i)
+  {
+    dataset.col(i) += 1.5;
+    labels[i] = 1;
+  }
+  labels.head(1000).fill(0);
+
+  DecisionTree<> tree(dataset, labels, 2, 5 /* minimum leaf size */);
+  FlatDecisionTree flatTree(tree);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    size_t treePrediction, flatPrediction;
+    arma::vec treeProbs, flatProbs;
+    tree.Classify(dataset.col(i), treePrediction, treeProbs);
+    flatTree.Classify(dataset.col(i), flatPrediction, flatProbs);
+
+    REQUIRE(treePrediction == flatPrediction);
+    CheckMatrices(treeProbs, flatProbs);
+  }
+
+  // The batch overload should give the same results too.
+  arma::Row<size_t> treePredictions, flatPredictions;
+  tree.Classify(dataset, treePredictions);
+  flatTree.Classify(dataset, flatPredictions);
+  REQUIRE(arma::accu(treePredictions == flatPredictions) == dataset.n_cols);
+}
+
+/**
+ * A flattened tree should handle categorical splits the same way as the tree
+ * it was built from.
+ */
+TEST_CASE("FlatDecisionTreeCategoricalTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  data::DatasetInfo info;
+  MockCategoricalData(dataset, labels, info);
+
+  DecisionTree<> tree(dataset, info, labels, 5, 10 /* minimum leaf size */);
+  FlatDecisionTree flatTree(tree);
+
+  arma::Row<size_t> treePredictions, flatPredictions;
+  tree.Classify(dataset, treePredictions);
+  flatTree.Classify(dataset, flatPredictions);
+
+  REQUIRE(arma::accu(treePredictions == flatPredictions) == dataset.n_cols);
+}
+
+/**
+ * Check that the BestBinaryCategoricalSplit will split on a perfectly
+ * splittable dimension, and that the bitset partition it finds is correct.
+ */
+TEST_CASE("BestBinaryCategoricalSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0 1 2 3 0 1 2 3 0 1 2 3");
+  arma::Row<size_t> labels("0 1 0 1 0 1 0 1 0 1 0 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<
+      false>(bestGain, values, 4, labels, 2, weights, 3, 1e-7,
+      classProbabilities, aux);
+  const double weightedGain = BestBinaryCategoricalSplit<GiniGain>::
+      SplitIfBetter<true>(bestGain, values, 4, labels, 2, weights, 3, 1e-7,
+      classProbabilities, aux);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Since the split is perfect, make sure the new gain is 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  REQUIRE(gain == weightedGain);
+
+  // The split should always have two children.
+  REQUIRE(classProbabilities.n_elem == 1);
+  REQUIRE((size_t) classProbabilities[0] == 2);
+  REQUIRE(BestBinaryCategoricalSplit<GiniGain>::NumChildren(
+      classProbabilities[0], aux) == 2);
+
+  // Categories 0 and 2 hold class 0, and categories 1 and 3 hold class 1, so
+  // the partition must be { 0, 2 } against { 1, 3 }.
+  const size_t d0 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      0.0, classProbabilities[0], aux);
+  const size_t d1 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      1.0, classProbabilities[0], aux);
+  const size_t d2 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      2.0, classProbabilities[0], aux);
+  const size_t d3 = BestBinaryCategoricalSplit<GiniGain>::CalculateDirection(
+      3.0, classProbabilities[0], aux);
+  REQUIRE(d0 == d2);
+  REQUIRE(d1 == d3);
+  REQUIRE(d0 != d1);
+}
+
+/**
+ * Make sure that BestBinaryCategoricalSplit respects the minimum number of
+ * samples required to split.
+ */
+TEST_CASE("BestBinaryCategoricalSplitMinSamplesTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0 1 2 3 0 1 2 3 0 1 2 3");
+  arma::Row<size_t> labels("0 1 0 1 0 1 0 1 0 1 0 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<
+      false>(bestGain, values, 4, labels, 2, weights, 8, 1e-7,
+      classProbabilities, aux);
+
+  // Make sure it's not split.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * Check that no binary categorical split is made when it doesn't get us
+ * anything.
+ */
+TEST_CASE("BestBinaryCategoricalSplitNoGainTest", "[DecisionTreeTest]")
+{
+  arma::vec values(300);
+  arma::Row<size_t> labels(300);
+  arma::rowvec weights = arma::ones<arma::rowvec>(300);
+
+  for (size_t i = 0; i < 300; i += 3)
+  {
+    values[i] = int(i / 3) % 10;
+    labels[i] = 0;
+    values[i + 1] = int(i / 3) % 10;
+    labels[i + 1] = 1;
+    values[i + 2] = int(i / 3) % 10;
+    labels[i + 2] = 2;
+  }
+
+  arma::vec classProbabilities;
+  BestBinaryCategoricalSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 3, weights);
+  const double gain = BestBinaryCategoricalSplit<GiniGain>::SplitIfBetter<
+      false>(bestGain, values, 10, labels, 3, weights, 10, 1e-7,
+      classProbabilities, aux);
+  const double weightedGain = BestBinaryCategoricalSplit<GiniGain>::
+      SplitIfBetter<true>(bestGain, values, 10, labels, 3, weights, 10, 1e-7,
+      classProbabilities, aux);
+
+  // Make sure that there was no split.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(gain == weightedGain);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * Test that we can build a decision tree with binary categorical splits on a
+ * simple categorical dataset and get good accuracy.
+ */
+TEST_CASE("BestBinaryCategoricalBuildTest", "[DecisionTreeTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+  arma::Row<size_t> testLabels = l.subvec(2000, 3999);
+
+  // Build the tree.
+  DecisionTree<GiniGain, BestBinaryNumericSplit, BestBinaryCategoricalSplit>
+      tree(trainingData, di, trainingLabels, 5, 10);
+
+  // Now evaluate the accuracy of the tree.
+  arma::Row<size_t> predictions;
+  tree.Classify(testData, predictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+  size_t correct = 0;
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    if (testLabels[i] == predictions[i])
+      ++correct;
+
+  // Make sure we got at least 70% accuracy.
+  const double correctPct = double(correct) / double(testData.n_cols);
+  REQUIRE(correctPct > 0.70);
+}
+
+/**
+ * Test that a tree with binary categorical splits survives a serialization
+ * round trip, since the category bitsets are stored in the auxiliary split
+ * information.
+ */
+TEST_CASE("BestBinaryCategoricalSerializationTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  data::DatasetInfo info;
+  MockCategoricalData(dataset, labels, info);
+
+  typedef DecisionTree<GiniGain, BestBinaryNumericSplit,
+      BestBinaryCategoricalSplit> TreeType;
+  TreeType tree(dataset, info, labels, 5, 10);
+
+  TreeType xmlTree, jsonTree, binaryTree;
+  SerializeObjectAll(tree, xmlTree, jsonTree, binaryTree);
+
+  arma::Row<size_t> predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions;
+  tree.Classify(dataset, predictions);
+  xmlTree.Classify(dataset, xmlPredictions);
+  jsonTree.Classify(dataset, jsonPredictions);
+  binaryTree.Classify(dataset, binaryPredictions);
+
+  REQUIRE(arma::accu(predictions == xmlPredictions) == dataset.n_cols);
+  REQUIRE(arma::accu(predictions == jsonPredictions) == dataset.n_cols);
+  REQUIRE(arma::accu(predictions == binaryPredictions) == dataset.n_cols);
+}
+
+/**
+ * A flattened tree should handle binary categorical splits the same way as the
+ * tree it was built from.
+ */
+TEST_CASE("FlatDecisionTreeBinaryCategoricalTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  data::DatasetInfo info;
+  MockCategoricalData(dataset, labels, info);
+
+  DecisionTree<GiniGain, BestBinaryNumericSplit, BestBinaryCategoricalSplit>
+      tree(dataset, info, labels, 5, 10 /* minimum leaf size */);
+  FlatDecisionTree flatTree(tree);
+
+  arma::Row<size_t> treePredictions, flatPredictions;
+  tree.Classify(dataset, treePredictions);
+  flatTree.Classify(dataset, flatPredictions);
+
+  REQUIRE(arma::accu(treePredictions == flatPredictions) == dataset.n_cols);
+}
@@ -1544,3 +1544,146 @@ TEST_CASE("DiagonalGaussianWeightedParametersReductionTest",
     REQUIRE(d1.Covariance()(i) == Approx(d2.Covariance()(i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure the Woodbury-based log-density of the low-rank Gaussian matches
+ * the full-covariance Gaussian evaluated on the materialized covariance.
+ */
+TEST_CASE("LowRankGaussianDistributionLogProbabilityTest", "[DistributionTest]")
+{
+  arma::vec mean = arma::randu<arma::vec>(5);
+  arma::mat factors = arma::randn<arma::mat>(5, 2);
+  arma::vec noise = 0.5 + arma::randu<arma::vec>(5);
+
+  LowRankGaussianDistribution d(mean, factors, noise);
+  GaussianDistribution g(mean, d.Covariance());
+
+  REQUIRE(d.Dimensionality() == 5);
+  REQUIRE(d.Rank() == 2);
+
+  arma::mat points = arma::randn<arma::mat>(5, 20);
+
+  // Check the single-point overload.
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(d.LogProbability(points.col(i)) ==
+        Approx(g.LogProbability(points.col(i))).epsilon(1e-7));
+  }
+
+  // Check the batch overload against the single-point overload.
+  arma::vec logProbs;
+  d.LogProbability(points, logProbs);
+  REQUIRE(logProbs.n_elem == 20);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(logProbs(i) ==
+        Approx(d.LogProbability(points.col(i))).epsilon(1e-7));
+  }
+
+  // With rank 0, the distribution must reduce to a diagonal Gaussian.
+  LowRankGaussianDistribution diag(mean, arma::mat(5, 0), noise);
+  DiagonalGaussianDistribution dg(mean, noise);
+  REQUIRE(diag.LogProbability(points.col(0)) ==
+      Approx(dg.LogProbability(points.col(0))).epsilon(1e-7));
+}
+
+/**
+ * Make sure random observations follow the low-rank-plus-diagonal covariance
+ * correctly.
+ */
+TEST_CASE("LowRankGaussianDistributionRandomTest", "[DistributionTest]")
+{
+  arma::vec mean("1.0 -2.0 0.5");
+  arma::mat factors("1.0; 0.5; -1.0");
+  arma::vec noise("0.3 0.4 0.2");
+
+  LowRankGaussianDistribution d(mean, factors, noise);
+
+  arma::mat obs(3, 10000);
+  for (size_t i = 0; i < 10000; ++i)
+    obs.col(i) = d.Random();
+
+  arma::vec obsMean = arma::mean(obs, 1);
+  arma::mat obsCov = mlpack::math::ColumnCovariance(obs);
+  const arma::mat cov = d.Covariance();
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(obsMean(i) - mean(i) == Approx(0.0).margin(0.1));
+    for (size_t j = 0; j < 3; ++j)
+      REQUIRE(obsCov(i, j) - cov(i, j) == Approx(0.0).margin(0.1));
+  }
+}
+
+/**
+ * Make sure the EM fit recovers a factor analysis model: the fitted
+ * covariance should be close to the sample covariance of data generated from
+ * a low-rank-plus-diagonal Gaussian.
+ */
+TEST_CASE("LowRankGaussianDistributionTrainTest", "[DistributionTest]")
+{
+  arma::vec mean = arma::randu<arma::vec>(8);
+  arma::mat factors = arma::randn<arma::mat>(8, 2);
+  arma::vec noise = 0.1 + 0.1 * arma::randu<arma::vec>(8);
+
+  LowRankGaussianDistribution generator(mean, factors, noise);
+
+  arma::mat observations(8, 20000);
+  for (size_t i = 0; i < 20000; ++i)
+    observations.col(i) = generator.Random();
+
+  LowRankGaussianDistribution d(8, 2);
+  d.TrainingIterations() = 50;
+  d.Train(observations);
+
+  // The mean should be recovered tightly.
+  const arma::vec actualMean = arma::mean(observations, 1);
+  for (size_t i = 0; i < 8; ++i)
+    REQUIRE(d.Mean()(i) - actualMean(i) == Approx(0.0).margin(1e-5));
+
+  // The fitted covariance should approximate the sample covariance.
+  const arma::mat sampleCov = mlpack::math::ColumnCovariance(observations);
+  const double relError = arma::norm(d.Covariance() - sampleCov, "fro") /
+      arma::norm(sampleCov, "fro");
+  REQUIRE(relError < 0.1);
+
+  // The rank-2 fit should explain the data at least as well as a
+  // diagonal-covariance fit.
+  DiagonalGaussianDistribution diag;
+  diag.Train(observations);
+
+  arma::vec lowRankLogProbs, diagLogProbs;
+  d.LogProbability(observations, lowRankLogProbs);
+  diag.LogProbability(observations, diagLogProbs);
+  REQUIRE(arma::mean(lowRankLogProbs) >= arma::mean(diagLogProbs));
+}
+
+/**
+ * Make sure that if all weights are the same, the weighted EM fit reduces to
+ * the unweighted fit.  Both fits are warm-started from the same factors so
+ * that the EM iterations are deterministic.
+ */
+TEST_CASE("LowRankGaussianWeightedParametersReductionTest",
+          "[DistributionTest]")
+{
+  arma::mat obs = arma::randn<arma::mat>(4, 50);
+  arma::vec probs = 0.2 * arma::ones<arma::vec>(50);
+
+  arma::vec startMean = arma::zeros<arma::vec>(4);
+  arma::mat startFactors = arma::ones<arma::mat>(4, 2);
+  arma::vec startNoise = arma::ones<arma::vec>(4);
+
+  LowRankGaussianDistribution d1(startMean, startFactors, startNoise);
+  LowRankGaussianDistribution d2(startMean, startFactors, startNoise);
+
+  d1.Train(obs);
+  d2.Train(obs, probs);
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    REQUIRE(d1.Mean()(i) == Approx(d2.Mean()(i)).epsilon(1e-7));
+    REQUIRE(d1.Noise()(i) == Approx(d2.Noise()(i)).epsilon(1e-7));
+    for (size_t j = 0; j < 2; ++j)
+      REQUIRE(d1.Factors()(i, j) == Approx(d2.Factors()(i, j)).epsilon(1e-7));
+  }
+}
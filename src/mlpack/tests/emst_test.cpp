@@ -218,6 +218,118 @@ TEST_CASE("DualTreeVsNaive", "[EMSTTest]")
   }
 }
 
+/**
+ * Test the approximation parameter: epsilon = 0 must give exactly the same
+ * results as the exact computation, and a positive epsilon must still give a
+ * spanning tree whose total length is within (1 + epsilon) of optimal.
+ */
+TEST_CASE("EMSTEpsilonTest", "[EMSTTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("test_data_3_1000.csv", inputData))
+    FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  arma::mat exactData = inputData;
+  arma::mat zeroEpsData = inputData;
+  arma::mat approxData = inputData;
+
+  DualTreeBoruvka<> exact(exactData);
+  arma::mat exactResults;
+  exact.ComputeMST(exactResults);
+
+  // epsilon = 0 must be identical to the exact computation.
+  DualTreeBoruvka<> zeroEps(zeroEpsData, false, 0.0);
+  arma::mat zeroEpsResults;
+  zeroEps.ComputeMST(zeroEpsResults);
+
+  REQUIRE(zeroEpsResults.n_cols == exactResults.n_cols);
+  for (size_t i = 0; i < exactResults.n_cols; ++i)
+  {
+    REQUIRE(zeroEpsResults(0, i) == exactResults(0, i));
+    REQUIRE(zeroEpsResults(1, i) == exactResults(1, i));
+    REQUIRE(zeroEpsResults(2, i) ==
+        Approx(exactResults(2, i)).epsilon(1e-7));
+  }
+
+  // A positive epsilon must still produce a full spanning tree, and every
+  // edge chosen is at most (1 + epsilon) times longer than the best edge
+  // available when it was chosen, so the total length is at most
+  // (1 + epsilon) times the length of the exact MST.
+  const double epsilon = 0.5;
+  DualTreeBoruvka<> approx(approxData, false, epsilon);
+  arma::mat approxResults;
+  approx.ComputeMST(approxResults);
+
+  REQUIRE(approxResults.n_cols == exactResults.n_cols);
+
+  const double exactLength = arma::accu(exactResults.row(2));
+  const double approxLength = arma::accu(approxResults.row(2));
+  REQUIRE(approxLength >= exactLength * (1.0 - 1e-7));
+  REQUIRE(approxLength <= exactLength * (1.0 + epsilon) * (1.0 + 1e-7));
+
+  // A negative epsilon is invalid.
+  REQUIRE_THROWS_AS(DualTreeBoruvka<>(inputData, true, -0.1),
+      std::invalid_argument);
+}
+
+/**
+ * Test the edge length cutoff: the emitted forest must be exactly the set of
+ * MST edges no longer than the cutoff, both in dual-tree and naive mode.
+ */
+TEST_CASE("EMSTCutoffTest", "[EMSTTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("test_data_3_1000.csv", inputData))
+    FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  arma::mat exactData = inputData;
+  arma::mat dualData = inputData;
+  arma::mat naiveData = inputData;
+
+  DualTreeBoruvka<> exact(exactData);
+  arma::mat exactResults;
+  exact.ComputeMST(exactResults);
+
+  // Pick a cutoff strictly between two edge lengths of the (sorted) MST edge
+  // list, so that exactly half of the edges fall below it.
+  const size_t keep = exactResults.n_cols / 2;
+  const double cutoff =
+      0.5 * (exactResults(2, keep - 1) + exactResults(2, keep));
+
+  DualTreeBoruvka<> dtb(dualData, false, 0.0, cutoff);
+  arma::mat dualResults;
+  dtb.ComputeMST(dualResults);
+
+  // Thresholding the MST and running Boruvka with a cutoff must produce the
+  // same forest (the MST of this random dataset is unique), and the edge
+  // lists are both sorted by length.
+  REQUIRE(dualResults.n_cols == keep);
+  for (size_t i = 0; i < keep; ++i)
+  {
+    REQUIRE(dualResults(0, i) == exactResults(0, i));
+    REQUIRE(dualResults(1, i) == exactResults(1, i));
+    REQUIRE(dualResults(2, i) == Approx(exactResults(2, i)).epsilon(1e-7));
+    REQUIRE(dualResults(2, i) <= cutoff);
+  }
+
+  // The naive computation must respect the cutoff too.
+  DualTreeBoruvka<> dtbNaive(naiveData, true, 0.0, cutoff);
+  arma::mat naiveResults;
+  dtbNaive.ComputeMST(naiveResults);
+
+  REQUIRE(naiveResults.n_cols == keep);
+  for (size_t i = 0; i < keep; ++i)
+  {
+    REQUIRE(naiveResults(0, i) == dualResults(0, i));
+    REQUIRE(naiveResults(1, i) == dualResults(1, i));
+    REQUIRE(naiveResults(2, i) == Approx(dualResults(2, i)).epsilon(1e-7));
+  }
+
+  // A non-positive cutoff is invalid.
+  REQUIRE_THROWS_AS(DualTreeBoruvka<>(inputData, true, 0.0, 0.0),
+      std::invalid_argument);
+}
+
 /**
  * Make sure the cover tree works fine.
  */
@@ -274,3 +386,39 @@ TEST_CASE("EMSTBallTreeTest", "[EMSTTest]")
     REQUIRE(bstResults(2, i) == Approx(ballResults(2, i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Test that UnionFind's path compression and Flatten() preserve component
+ * structure: after Flatten(), every element points directly at its root.
+ */
+TEST_CASE("UnionFindFlattenTest", "[EMSTTest]")
+{
+  UnionFind connections(16);
+
+  // Build two chains of unions and one singleton.
+  for (size_t i = 0; i < 7; ++i)
+    connections.Union(i, i + 1);
+  for (size_t i = 9; i < 15; ++i)
+    connections.Union(i, i + 1);
+
+  // All elements of a chain must resolve to the same root.
+  const size_t firstRoot = connections.Find(0);
+  for (size_t i = 1; i <= 7; ++i)
+    REQUIRE(connections.Find(i) == firstRoot);
+
+  const size_t secondRoot = connections.Find(9);
+  for (size_t i = 10; i <= 15; ++i)
+    REQUIRE(connections.Find(i) == secondRoot);
+
+  REQUIRE(firstRoot != secondRoot);
+  REQUIRE(connections.Find(8) == 8);
+
+  // Flatten and make sure the components are unchanged.
+  connections.Flatten();
+
+  for (size_t i = 0; i <= 7; ++i)
+    REQUIRE(connections.Find(i) == firstRoot);
+  for (size_t i = 9; i <= 15; ++i)
+    REQUIRE(connections.Find(i) == secondRoot);
+  REQUIRE(connections.Find(8) == 8);
+}
@@ -126,6 +126,71 @@ TEST_CASE("DualTreeVsSingleTree", "[FastMKSTest]")
   }
 }
 
+/**
+ * Make sure a base case budget still returns valid results: a generous budget
+ * must not change the exact results, and any candidate reported under a tight
+ * budget must carry its true kernel value, which can be no better than the
+ * exact result.
+ */
+TEST_CASE("FastMKSBudgetTest", "[FastMKSTest]")
+{
+  arma::mat data;
+  data.randu(5, 500);
+  LinearKernel lk;
+
+  FastMKS<LinearKernel> exact(data, lk);
+
+  arma::Mat<size_t> exactIndices;
+  arma::mat exactKernels;
+  exact.Search(5, exactIndices, exactKernels);
+
+  // A budget large enough for every point pair cannot change the results.
+  FastMKS<LinearKernel> generous(data, lk);
+  generous.BaseCaseBudget() = 10 * data.n_cols * data.n_cols;
+
+  arma::Mat<size_t> generousIndices;
+  arma::mat generousKernels;
+  generous.Search(5, generousIndices, generousKernels);
+
+  for (size_t q = 0; q < exactIndices.n_cols; ++q)
+  {
+    for (size_t r = 0; r < exactIndices.n_rows; ++r)
+    {
+      REQUIRE(generousIndices(r, q) == exactIndices(r, q));
+      REQUIRE(generousKernels(r, q) ==
+          Approx(exactKernels(r, q)).epsilon(1e-7));
+    }
+  }
+
+  // Now use a tight budget, in both dual-tree and single-tree mode.
+  for (size_t mode = 0; mode < 2; ++mode)
+  {
+    FastMKS<LinearKernel> budgeted(data, lk, (mode == 1));
+    budgeted.BaseCaseBudget() = 500;
+
+    arma::Mat<size_t> budgetIndices;
+    arma::mat budgetKernels;
+    budgeted.Search(5, budgetIndices, budgetKernels);
+
+    for (size_t q = 0; q < budgetIndices.n_cols; ++q)
+    {
+      for (size_t r = 0; r < budgetIndices.n_rows; ++r)
+      {
+        // The budgeted result is a lower bound on the exact result.
+        REQUIRE(budgetKernels(r, q) <= exactKernels(r, q) + 1e-7);
+
+        // Any reported candidate must carry its true kernel value.
+        if (budgetIndices(r, q) != (size_t() - 1))
+        {
+          const double eval = lk.Evaluate(data.col(q),
+                                          data.col(budgetIndices(r, q)));
+          REQUIRE(budgetKernels(r, q) == Approx(eval).epsilon(1e-7));
+        }
+      }
+    }
+  }
+}
+
 /**
  * Test sparse FastMKS (how useful is this, I'm not sure).
  */
@@ -1141,3 +1206,56 @@ TEST_CASE("CopyAssignmentTest", "[FastMKSTest]")
       REQUIRE(newKernels[i] == Approx(0.0).margin(1e-5));
   }
 }
+
+/**
+ * Search with the kernel tile cache enabled must give exactly the same
+ * results as the default pair-by-pair evaluation.
+ */
+TEST_CASE("FastMKSCacheKernelsTest", "[FastMKSTest]")
+{
+  arma::mat data;
+  data.randn(5, 500);
+  LinearKernel lk;
+
+  // Dual-tree search without and with the tile cache.
+  FastMKS<LinearKernel> f(data, lk);
+
+  arma::Mat<size_t> indices;
+  arma::mat products;
+  f.Search(5, indices, products);
+
+  FastMKS<LinearKernel> cached(data, lk);
+  cached.CacheKernels() = true;
+
+  arma::Mat<size_t> cachedIndices;
+  arma::mat cachedProducts;
+  cached.Search(5, cachedIndices, cachedProducts);
+
+  for (size_t q = 0; q < indices.n_cols; ++q)
+  {
+    for (size_t r = 0; r < indices.n_rows; ++r)
+    {
+      REQUIRE(cachedIndices(r, q) == indices(r, q));
+      REQUIRE(cachedProducts(r, q) ==
+          Approx(products(r, q)).epsilon(1e-10));
+    }
+  }
+
+  // Single-tree search with the tile cache must also agree.
+  FastMKS<LinearKernel> single(data, lk, true);
+  single.CacheKernels() = true;
+
+  arma::Mat<size_t> singleIndices;
+  arma::mat singleProducts;
+  single.Search(5, singleIndices, singleProducts);
+
+  for (size_t q = 0; q < indices.n_cols; ++q)
+  {
+    for (size_t r = 0; r < indices.n_rows; ++r)
+    {
+      REQUIRE(singleIndices(r, q) == indices(r, q));
+      REQUIRE(singleProducts(r, q) ==
+          Approx(products(r, q)).epsilon(1e-10));
+    }
+  }
+}
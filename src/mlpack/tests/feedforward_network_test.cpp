@@ -15,6 +15,8 @@
 #include <mlpack/methods/ann/layer/layer_types.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/mixed_precision_update.hpp>
+#include <mlpack/methods/ann/quantized_ffn.hpp>
 
 #include <ensmallen.hpp>
 
@@ -1124,3 +1126,401 @@ TEST_CASE("FFNCheckInputShapeTest", "[FeedForwardNetworkTest]")
 
   REQUIRE_THROWS_AS(model.Train(trainData, trainLabels, opt), std::logic_error);
 }
+
+/**
+ * Train a small network by streaming predictors and responses from disk, and
+ * check that the streamed training actually fits the data.
+ */
+TEST_CASE("FFNStreamingTrainTest", "[FeedForwardNetworkTest]")
+{
+  // A simple linear mapping: y = 2 * x0 - x1.
+  arma::mat predictors(2, 600, arma::fill::randu);
+  arma::mat responses = 2.0 * predictors.row(0) - predictors.row(1);
+
+  REQUIRE(predictors.quiet_save("ffn_stream_x.bin", arma::arma_binary));
+  REQUIRE(responses.quiet_save("ffn_stream_y.bin", arma::arma_binary));
+
+  data::StreamingDataset<> predictorStream("ffn_stream_x.bin", 100);
+  data::StreamingDataset<> responseStream("ffn_stream_y.bin", 100);
+
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(1);
+
+  ens::RMSProp opt(0.01, 32, 0.99, 1e-8, 400 /* iterations per batch */);
+  model.Train(predictorStream, responseStream, opt, 10 /* epochs */);
+
+  arma::mat results;
+  model.Predict(predictors, results, 100);
+
+  const double mse =
+      arma::accu(arma::square(results - responses)) / responses.n_cols;
+  REQUIRE(mse < 0.01);
+
+  remove("ffn_stream_x.bin");
+  remove("ffn_stream_y.bin");
+}
+
+/**
+ * ParallelPredict() should produce exactly the same predictions as Predict(),
+ * regardless of how the points are sharded across threads.
+ */
+TEST_CASE("FFNParallelPredictTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  // Normalize labels to [0, 2].
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1) - 1;
+  trainData.shed_row(trainData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  arma::mat predictions, parallelPredictions;
+  model.Predict(trainData, predictions);
+  model.ParallelPredict(trainData, parallelPredictions);
+  CheckMatrices(predictions, parallelPredictions);
+
+  // Also check with a batch size that does not divide the number of points.
+  model.ParallelPredict(trainData, parallelPredictions, 37);
+  CheckMatrices(predictions, parallelPredictions);
+}
+
+/**
+ * Predict() packs the intermediate activations into a planned arena; the
+ * results must be identical to a plain Forward() pass, which gives every
+ * layer its own activation memory.
+ */
+TEST_CASE("FFNActivationMemoryPlanningTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 256, arma::fill::randu);
+
+  // Use a network whose activation sizes both grow and shrink, so that the
+  // planner has to handle activations that do not fit in a freed slot.
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(32);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(64);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  model.InputDimensions() = std::vector<size_t>({ 10 });
+
+  arma::mat forwardResults, predictions;
+  model.Forward(data, forwardResults);
+  model.Predict(data, predictions, 64);
+  CheckMatrices(forwardResults, predictions);
+}
+
+/**
+ * After ReserveInferenceMemory(), Predict() must not perform any activation
+ * allocation, no matter how batch sizes vary between calls.
+ */
+TEST_CASE("FFNReserveInferenceMemoryTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 128, arma::fill::randu);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(32);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  model.InputDimensions() = std::vector<size_t>({ 10 });
+
+  // A first prediction initializes the weights.
+  arma::mat reference;
+  model.Predict(data, reference, 64);
+
+  model.ReserveInferenceMemory(64);
+
+  // With the reservation in place, the tracked activation arena must not
+  // change size again, no matter how the batch sizes vary.
+  util::MemoryTracker::Enable();
+  util::MemoryTracker::ResetPeak();
+  const size_t trackedBytes = util::MemoryTracker::CurrentBytes();
+
+  arma::mat predictions;
+  model.Predict(data, predictions, 64);
+  CheckMatrices(reference, predictions);
+  model.Predict(data, predictions, 1);
+  CheckMatrices(reference, predictions);
+  model.Predict(data, predictions, 17);
+  CheckMatrices(reference, predictions);
+
+  REQUIRE(util::MemoryTracker::CurrentBytes() == trackedBytes);
+  REQUIRE(util::MemoryTracker::PeakBytes() == trackedBytes);
+  util::MemoryTracker::Disable();
+}
+
+/**
+ * An int8-quantized network should produce nearly the same predictions as the
+ * float network it was built from.
+ */
+TEST_CASE("QuantizedFFNPredictTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  // Normalize labels to [0, 2].
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1) - 1;
+  trainData.shed_row(trainData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  arma::mat floatPredictions;
+  model.Predict(trainData, floatPredictions);
+
+  // Quantize the model, calibrating on the training data itself.
+  QuantizedFFN<NegativeLogLikelihood> quantizedModel(model, trainData);
+  REQUIRE(quantizedModel.NumQuantizedLayers() == 2);
+
+  arma::mat quantizedPredictions;
+  quantizedModel.Predict(trainData, quantizedPredictions);
+  REQUIRE(quantizedPredictions.n_rows == floatPredictions.n_rows);
+  REQUIRE(quantizedPredictions.n_cols == floatPredictions.n_cols);
+
+  // The predicted classes should almost always agree with the float network.
+  size_t agreements = 0;
+  for (size_t i = 0; i < floatPredictions.n_cols; ++i)
+  {
+    if (floatPredictions.col(i).index_max() ==
+        quantizedPredictions.col(i).index_max())
+      ++agreements;
+  }
+
+  REQUIRE(double(agreements) >= 0.97 * floatPredictions.n_cols);
+}
+
+/**
+ * Train and evaluate a vanilla network held entirely in single precision.
+ */
+TEST_CASE("FFSinglePrecisionNetworkTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainDataD;
+  if (!data::Load("thyroid_train.csv", trainDataD))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::fmat trainData = arma::conv_to<arma::fmat>::from(trainDataD);
+  arma::fmat trainLabels = trainData.row(trainData.n_rows - 1) - 1;
+  trainData.shed_row(trainData.n_rows - 1);
+
+  arma::mat testDataD;
+  if (!data::Load("thyroid_test.csv", testDataD))
+    FAIL("Cannot load dataset thyroid_test.csv");
+
+  arma::fmat testData = arma::conv_to<arma::fmat>::from(testDataD);
+  arma::fmat testLabels = testData.row(testData.n_rows - 1) - 1;
+  testData.shed_row(testData.n_rows - 1);
+
+  FFN<NegativeLogLikelihoodType<arma::fmat>, RandomInitialization,
+      arma::fmat> model;
+  model.Add<LinearType<arma::fmat>>(8);
+  model.Add<SigmoidType<arma::fmat>>();
+  model.Add<LinearType<arma::fmat>>(3);
+  model.Add<LogSoftMaxType<arma::fmat>>();
+
+  // Vanilla neural net with logistic activation function; the network should
+  // reach the same accuracy as its double-precision counterpart.
+  TestNetwork<arma::fmat>(model, trainData, trainLabels, testData, testLabels,
+      10, 0.1);
+}
+
+/**
+ * Train a single-precision network with a double-precision master copy of the
+ * weights (mixed-precision training).
+ */
+TEST_CASE("FFMixedPrecisionTrainTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainDataD;
+  if (!data::Load("thyroid_train.csv", trainDataD))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::fmat trainData = arma::conv_to<arma::fmat>::from(trainDataD);
+  arma::fmat trainLabels = trainData.row(trainData.n_rows - 1) - 1;
+  trainData.shed_row(trainData.n_rows - 1);
+
+  FFN<NegativeLogLikelihoodType<arma::fmat>, RandomInitialization,
+      arma::fmat> model;
+  model.Add<LinearType<arma::fmat>>(8);
+  model.Add<SigmoidType<arma::fmat>>();
+  model.Add<LinearType<arma::fmat>>(3);
+  model.Add<LogSoftMaxType<arma::fmat>>();
+
+  // The gradient steps are applied to a double-precision master copy of the
+  // parameters and rounded back down after every update.
+  ens::SGD<MixedPrecisionUpdate<ens::MomentumUpdate>> opt(0.01, 32,
+      5 * trainData.n_cols, 1e-5);
+  model.Train(trainData, trainLabels, opt);
+
+  arma::fmat predictionTemp;
+  model.Predict(trainData, predictionTemp);
+  arma::fmat prediction(1, predictionTemp.n_cols);
+  for (size_t i = 0; i < predictionTemp.n_cols; ++i)
+    prediction(i) = (float) predictionTemp.col(i).index_max();
+
+  const size_t correct = arma::accu(prediction == trainLabels);
+  const double classificationError =
+      1 - double(correct) / trainData.n_cols;
+  REQUIRE(classificationError <= 0.1);
+}
+
+/**
+ * Elementwise layers (activations, dropout) are fused in place during
+ * prediction; the results must match a plain Forward() pass, which gives
+ * every layer its own activation memory.
+ */
+TEST_CASE("FFNElementwiseFusionTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 128, arma::fill::randu);
+
+  // Chain several elementwise layers after each linear layer so that fusion
+  // is exercised across runs of more than one layer.
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(16);
+  model.Add<ReLU>();
+  model.Add<Dropout>(0.3);
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<TanH>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  model.InputDimensions() = std::vector<size_t>({ 10 });
+
+  arma::mat forwardResults, predictions;
+  model.Forward(data, forwardResults);
+  model.Predict(data, predictions, 32);
+  CheckMatrices(forwardResults, predictions);
+}
+
+/**
+ * Test that training with gradient checkpointing computes exactly the same
+ * forward outputs and gradients as a standard training pass.
+ */
+TEST_CASE("FFNGradientCheckpointingTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat dataset(10, 64, arma::fill::randu);
+  arma::mat labels = arma::floor(3.0 * arma::randu<arma::mat>(1, 64));
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(32);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(24);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(16);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.InputDimensions() = std::vector<size_t>({ 10 });
+  model.Reset();
+
+  // An identical copy that stores only every third activation and recomputes
+  // the rest during the backward pass.
+  FFN<NegativeLogLikelihood> checkpointed(model);
+  checkpointed.CheckpointInterval() = 3;
+
+  model.SetNetworkMode(true);
+  checkpointed.SetNetworkMode(true);
+
+  arma::mat results, checkpointedResults;
+  model.Forward(dataset, results);
+  checkpointed.Forward(dataset, checkpointedResults);
+  CheckMatrices(results, checkpointedResults);
+
+  arma::mat gradients, checkpointedGradients;
+  const double obj = model.Backward(dataset, labels, gradients);
+  const double checkpointedObj = checkpointed.Backward(dataset, labels,
+      checkpointedGradients);
+  REQUIRE(obj == Approx(checkpointedObj));
+  CheckMatrices(gradients, checkpointedGradients);
+}
+
+/**
+ * Test that shared-weight inference handles alias the model's parameters and
+ * produce the same predictions.
+ */
+TEST_CASE("FFNInferenceHandleTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat dataset(10, 100, arma::fill::randu);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(16);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.InputDimensions() = std::vector<size_t>({ 10 });
+  model.Reset();
+
+  FFN<NegativeLogLikelihood> handle1, handle2;
+  model.CreateInferenceHandle(handle1);
+  model.CreateInferenceHandle(handle2);
+
+  // The handles must share the model's weight memory instead of copying it.
+  REQUIRE(handle1.Parameters().memptr() == model.Parameters().memptr());
+  REQUIRE(handle2.Parameters().memptr() == model.Parameters().memptr());
+
+  arma::mat expected, results1, results2;
+  model.Predict(dataset, expected);
+  handle1.Predict(dataset, results1);
+  handle2.Predict(dataset, results2);
+  CheckMatrices(expected, results1);
+  CheckMatrices(expected, results2);
+}
+
+/**
+ * Test that folding BatchNorm layers into the preceding Linear layers removes
+ * them from the network without changing the predictions.
+ */
+TEST_CASE("FFNFoldNormalizationTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 64, arma::fill::randu);
+  arma::mat targets(3, 64, arma::fill::randu);
+
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(8);
+  model.Add<BatchNorm>();
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.InputDimensions() = std::vector<size_t>({ 10 });
+
+  // Train for a few epochs so that the BatchNorm layer accrues running
+  // statistics.
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 4 * data.n_cols, -1);
+  model.Train(data, targets, opt);
+
+  FFN<MeanSquaredError> folded;
+  model.FoldNormalization(folded);
+
+  // The BatchNorm layer should have been folded away.
+  REQUIRE(folded.Network().size() == model.Network().size() - 1);
+
+  arma::mat expected, results;
+  model.Predict(data, expected);
+  folded.Predict(data, results);
+  CheckMatrices(expected, results, 1e-5);
+}
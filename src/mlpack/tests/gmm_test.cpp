@@ -122,6 +122,66 @@ TEST_CASE("GMMTrainEMOneGaussian", "[GMMTest]")
   }
 }
 
+/**
+ * Test that incremental training with no forgetting (decay 1) gives the same
+ * single-Gaussian fit as training on all of the data at once.
+ */
+TEST_CASE("GMMTrainIncrementalTest", "[GMMTest]")
+{
+  // Generate data from a single random Gaussian.
+  arma::vec mean;
+  mean.randu(2);
+  arma::vec covar;
+  covar.randu(2);
+
+  arma::mat data;
+  data.randn(2 /* dimension */, 5000);
+  data.row(0) = covar(0) * data.row(0) + mean(0);
+  data.row(1) = covar(1) * data.row(1) + mean(1);
+
+  // Feed the data to the model in batches; with a decay of 1, every
+  // observation ever seen is weighted equally, so the sufficient statistics
+  // should match the full-batch statistics exactly.
+  GMM gmm(1, 2);
+  for (size_t batch = 0; batch < 5; batch++)
+    gmm.TrainIncremental(data.cols(1000 * batch, 1000 * batch + 999), 1.0);
+
+  arma::vec actualMean = arma::mean(data, 1);
+  arma::mat actualCovar = mlpack::math::ColumnCovariance(data,
+      1 /* biased estimator */);
+
+  REQUIRE(arma::norm(gmm.Component(0).Mean() - actualMean) < 1e-5);
+  REQUIRE(arma::norm(gmm.Component(0).Covariance() - actualCovar) < 1e-4);
+  REQUIRE(gmm.Weights()[0] == Approx(1.0).epsilon(1e-7));
+}
+
+/**
+ * Test that incremental training with decay forgets old data: after the data
+ * distribution shifts, the model should track the new distribution.
+ */
+TEST_CASE("GMMTrainIncrementalDecayTest", "[GMMTest]")
+{
+  // Start with data centered at the origin.
+  arma::mat oldData;
+  oldData.randn(2, 1000);
+
+  GMM gmm(1, 2);
+  gmm.TrainIncremental(oldData, 0.5);
+
+  // Now feed batches from a shifted distribution.  With a decay of 0.5, the
+  // old statistics should quickly become negligible.
+  for (size_t batch = 0; batch < 10; batch++)
+  {
+    arma::mat newData;
+    newData.randn(2, 1000);
+    newData += 5.0;
+    gmm.TrainIncremental(newData, 0.5);
+  }
+
+  REQUIRE(arma::norm(gmm.Component(0).Mean() -
+      5.0 * arma::ones<arma::vec>(2)) < 0.3);
+}
+
 /**
  * Test a training model on multiple Gaussians in higher dimensionality than
  * two.  We will hold the dataset size constant at 10k points.  The EM algorithm
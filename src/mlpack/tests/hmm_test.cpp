@@ -105,6 +105,99 @@ TEST_CASE("BorodovskyHMMTestViterbi", "[HMMTest]")
   REQUIRE(states[8] == 2);
 }
 
+/**
+ * Test beam-pruned Viterbi: a beam as wide as the state set must reproduce
+ * the exact decoding, and a narrower beam must give a path that is no more
+ * likely than the exact one.
+ */
+TEST_CASE("HMMBeamPredictTest", "[HMMTest]")
+{
+  // Build a 5-state Gaussian HMM with random transitions and well-separated
+  // means.
+  const size_t numStates = 5;
+  HMM<GaussianDistribution> hmm(numStates, GaussianDistribution(2));
+
+  arma::mat transition = arma::randu(numStates, numStates);
+  transition.each_row() /= arma::sum(transition, 0);
+  hmm.Transition() = transition;
+
+  for (size_t i = 0; i < numStates; ++i)
+    hmm.Emission()[i].Mean() = 3.0 * arma::randu<arma::vec>(2);
+
+  // Generate an observation sequence from the model.
+  arma::mat obs;
+  arma::Row<size_t> genStates;
+  hmm.Generate(200, obs, genStates);
+
+  // Exact decoding.
+  arma::Row<size_t> exactStates;
+  const double exactLogLik = hmm.Predict(obs, exactStates);
+
+  // A beam covering all states must not prune anything.
+  arma::Row<size_t> fullBeamStates;
+  const double fullBeamLogLik = hmm.Predict(obs, fullBeamStates, numStates);
+
+  REQUIRE(fullBeamLogLik == Approx(exactLogLik).epsilon(1e-10));
+  for (size_t t = 0; t < obs.n_cols; ++t)
+    REQUIRE(fullBeamStates[t] == exactStates[t]);
+
+  // A narrow beam gives an approximate path; its likelihood cannot exceed
+  // the exact optimum.
+  arma::Row<size_t> beamStates;
+  const double beamLogLik = hmm.Predict(obs, beamStates, 2);
+
+  REQUIRE(beamStates.n_elem == obs.n_cols);
+  REQUIRE(beamLogLik <= exactLogLik + 1e-10);
+}
+
+/**
+ * Test batched prediction: decoding many sequences at once must give exactly
+ * the same state sequences and log-likelihoods as decoding them one at a
+ * time, with and without beam pruning.
+ */
+TEST_CASE("HMMBatchPredictTest", "[HMMTest]")
+{
+  const size_t numStates = 4;
+  HMM<GaussianDistribution> hmm(numStates, GaussianDistribution(2));
+
+  arma::mat transition = arma::randu(numStates, numStates);
+  transition.each_row() /= arma::sum(transition, 0);
+  hmm.Transition() = transition;
+
+  for (size_t i = 0; i < numStates; ++i)
+    hmm.Emission()[i].Mean() = 3.0 * arma::randu<arma::vec>(2);
+
+  // Generate sequences of different lengths from the model.
+  std::vector<arma::mat> dataSeqs(7);
+  for (size_t seq = 0; seq < dataSeqs.size(); ++seq)
+  {
+    arma::Row<size_t> genStates;
+    hmm.Generate(50 + 25 * seq, dataSeqs[seq], genStates);
+  }
+
+  for (const size_t beamWidth : { (size_t) 0, (size_t) 2 })
+  {
+    std::vector<arma::Row<size_t>> batchStates;
+    const arma::vec batchLogLik = hmm.Predict(dataSeqs, batchStates,
+        beamWidth);
+
+    REQUIRE(batchStates.size() == dataSeqs.size());
+    REQUIRE(batchLogLik.n_elem == dataSeqs.size());
+
+    for (size_t seq = 0; seq < dataSeqs.size(); ++seq)
+    {
+      arma::Row<size_t> singleStates;
+      const double singleLogLik = hmm.Predict(dataSeqs[seq], singleStates,
+          beamWidth);
+
+      REQUIRE(batchLogLik(seq) == Approx(singleLogLik).epsilon(1e-10));
+      REQUIRE(batchStates[seq].n_elem == singleStates.n_elem);
+      for (size_t t = 0; t < singleStates.n_elem; ++t)
+        REQUIRE(batchStates[seq][t] == singleStates[t]);
+    }
+  }
+}
+
 /**
  * Ensure that the forward-backward algorithm is correct.
  */
@@ -317,6 +410,77 @@ TEST_CASE("SimpleBaumWelchDiscreteHMM_2", "[HMMTest]")
   REQUIRE(hmm.Emission()[1].Probability("3") == Approx(0.8).epsilon(0.04));
 }
 
+/**
+ * Incremental Baum-Welch training on batches of sequences should recover the
+ * same model as batch training, when the states are identifiable from the
+ * emissions.  This uses the same generative model as
+ * SimpleBaumWelchDiscreteHMM_2.
+ */
+TEST_CASE("TrainIncrementalDiscreteHMM", "[HMMTest]")
+{
+  HMM<DiscreteDistribution> hmm(2, DiscreteDistribution(4));
+
+  // A little bit of obfuscation to the solution.
+  hmm.Transition() = arma::mat("0.1 0.4; 0.9 0.6");
+  hmm.Emission()[0].Probabilities() = "0.85 0.15 0.00 0.00";
+  hmm.Emission()[1].Probabilities() = "0.00 0.00 0.50 0.50";
+
+  // Generate observations from the true model: the transition matrix is
+  // uniform, state 0 emits 0 or 1, and state 1 emits 2 or 3.
+  std::vector<arma::mat> observations;
+  size_t obsNum = 100; // Number of observations.
+  size_t obsLen = 250; // Number of elements in each observation.
+  for (size_t i = 0; i < obsNum; ++i)
+  {
+    arma::mat observation(1, obsLen);
+
+    size_t state = 0;
+    size_t emission = 0;
+
+    for (size_t obs = 0; obs < obsLen; obs++)
+    {
+      // See if state changed.
+      double r = math::Random();
+      state = (r <= 0.5) ? 0 : 1;
+
+      // Now set the observation.
+      r = math::Random();
+
+      switch (state)
+      {
+        case 0:
+          emission = (r <= 0.4) ? 0 : 1;
+          break;
+        case 1:
+          emission = (r <= 0.2) ? 2 : 3;
+          break;
+      }
+
+      observation(0, obs) = emission;
+    }
+
+    observations.push_back(observation);
+  }
+
+  // Feed the sequences to the model in batches of ten.
+  for (size_t batch = 0; batch < 10; batch++)
+  {
+    std::vector<arma::mat> batchSeq(observations.begin() + 10 * batch,
+        observations.begin() + 10 * (batch + 1));
+    hmm.TrainIncremental(batchSeq, 0.9);
+  }
+
+  REQUIRE(hmm.Transition()(0, 0) == Approx(0.5).epsilon(0.05));
+  REQUIRE(hmm.Transition()(1, 0) == Approx(0.5).epsilon(0.05));
+  REQUIRE(hmm.Transition()(0, 1) == Approx(0.5).epsilon(0.05));
+  REQUIRE(hmm.Transition()(1, 1) == Approx(0.5).epsilon(0.05));
+
+  REQUIRE(hmm.Emission()[0].Probability("0") == Approx(0.4).epsilon(0.05));
+  REQUIRE(hmm.Emission()[0].Probability("1") == Approx(0.6).epsilon(0.05));
+  REQUIRE(hmm.Emission()[1].Probability("2") == Approx(0.2).epsilon(0.05));
+  REQUIRE(hmm.Emission()[1].Probability("3") == Approx(0.8).epsilon(0.05));
+}
+
 TEST_CASE("DiscreteHMMLabeledTrainTest", "[HMMTest]")
 {
   // Generate a random Markov model with 3 hidden states and 6 observations.
@@ -14,6 +14,7 @@
 #include <mlpack/methods/hoeffding_trees/information_gain.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_categorical_split.hpp>
+#include <mlpack/methods/hoeffding_trees/hoeffding_hashed_categorical_split.hpp>
 #include <mlpack/methods/hoeffding_trees/binary_numeric_split.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree_model.hpp>
 
@@ -352,6 +353,49 @@ TEST_CASE("HoeffdingCategoricalSplitSplitTest", "[HoeffdingTreeTest]")
   REQUIRE(splitInfo.CalculateDirection(2) == 2);
 }
 
+/**
+ * Check that the hashed sparse categorical split makes exactly the same
+ * decisions as the dense one, on a high-cardinality feature where only a few
+ * categories actually occur (so the hash table has to grow a few times).
+ */
+TEST_CASE("HoeffdingHashedCategoricalSplitEquivalenceTest",
+          "[HoeffdingTreeTest]")
+{
+  // 10000 categories, three classes; only 100 categories ever occur.
+  HoeffdingCategoricalSplit<GiniImpurity> denseSplit(10000, 3);
+  HoeffdingHashedCategoricalSplit<GiniImpurity> hashedSplit(10000, 3);
+
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    const size_t category = 100 * mlpack::math::RandInt(0, 100);
+    const size_t label = mlpack::math::RandInt(0, 3);
+
+    denseSplit.Train(category, label);
+    hashedSplit.Train(category, label);
+  }
+
+  REQUIRE(hashedSplit.NumSeenCategories() <= 100);
+  REQUIRE(hashedSplit.MajorityClass() == denseSplit.MajorityClass());
+  REQUIRE(hashedSplit.MajorityProbability() ==
+      Approx(denseSplit.MajorityProbability()).epsilon(1e-10));
+
+  double denseBest, denseSecondBest, hashedBest, hashedSecondBest;
+  denseSplit.EvaluateFitnessFunction(denseBest, denseSecondBest);
+  hashedSplit.EvaluateFitnessFunction(hashedBest, hashedSecondBest);
+  REQUIRE(hashedBest == Approx(denseBest).epsilon(1e-10));
+  REQUIRE(hashedSecondBest == denseSecondBest);
+
+  arma::Col<size_t> denseMajorities, hashedMajorities;
+  HoeffdingCategoricalSplit<GiniImpurity>::SplitInfo denseInfo(10000);
+  HoeffdingHashedCategoricalSplit<GiniImpurity>::SplitInfo hashedInfo(10000);
+  denseSplit.Split(denseMajorities, denseInfo);
+  hashedSplit.Split(hashedMajorities, hashedInfo);
+
+  REQUIRE(hashedMajorities.n_elem == denseMajorities.n_elem);
+  for (size_t i = 0; i < denseMajorities.n_elem; ++i)
+    REQUIRE(hashedMajorities[i] == denseMajorities[i]);
+}
+
 /**
  * If we feed the HoeffdingTree a ton of points of the same class, it should
  * not suggest that we split.
@@ -1526,3 +1570,66 @@ TEST_CASE("HoeffdingTreeEmptyConstructorTrainTest", "[HoeffdingTreeTest]")
   REQUIRE_NOTHROW(ht.Train(data, labels, false, true, 2));
   REQUIRE_NOTHROW(ht.Train(data2, info, labels2, false, 3));
 }
+
+/**
+ * Train a streaming tree concurrently on a perfectly separable dataset and
+ * ensure that it finds the same split as serial training and classifies all
+ * of the training points correctly.
+ */
+TEST_CASE("HoeffdingTreeConcurrentTrainTest", "[HoeffdingTreeTest]")
+{
+  DatasetInfo info(3);
+  info.MapString<size_t>("cat0", 0);
+  info.MapString<size_t>("cat1", 0);
+  info.MapString<size_t>("cat2", 0);
+  info.MapString<size_t>("cat3", 0);
+  info.MapString<size_t>("cat4", 0);
+  info.MapString<size_t>("cat5", 0);
+  info.MapString<size_t>("cat6", 0);
+  info.MapString<size_t>("cat0", 1);
+  info.MapString<size_t>("cat1", 1);
+  info.MapString<size_t>("cat2", 1);
+  info.MapString<size_t>("cat0", 2);
+  info.MapString<size_t>("cat1", 2);
+
+  // Now generate data: dimension 1 determines the class, the others are
+  // meaningless.
+  arma::Mat<size_t> dataset(3, 9000);
+  arma::Row<size_t> labels(9000);
+  for (size_t i = 0; i < 9000; i += 3)
+  {
+    dataset(0, i) = mlpack::math::RandInt(7);
+    dataset(1, i) = 0;
+    dataset(2, i) = mlpack::math::RandInt(2);
+    labels(i) = 0;
+
+    dataset(0, i + 1) = mlpack::math::RandInt(7);
+    dataset(1, i + 1) = 2;
+    dataset(2, i + 1) = mlpack::math::RandInt(2);
+    labels(i + 1) = 1;
+
+    dataset(0, i + 2) = mlpack::math::RandInt(7);
+    dataset(1, i + 2) = 1;
+    dataset(2, i + 2) = mlpack::math::RandInt(2);
+    labels(i + 2) = 2;
+  }
+
+  // Train one tree concurrently, on all available threads.
+  typedef HoeffdingTree<GiniImpurity, HoeffdingSizeTNumericSplit,
+      HoeffdingCategoricalSplit> TreeType;
+  TreeType tree(info, 3);
+  tree.TrainConcurrent(dataset, labels);
+
+  // The tree should split exactly as the serial one does (see
+  // HoeffdingTreeSimpleDatasetTest): the split timing can differ depending on
+  // the interleaving, but the split dimension cannot.
+  REQUIRE(tree.NumChildren() == 3);
+  REQUIRE(tree.SplitDimension() == 1);
+
+  // Now, classify all the points in the dataset.
+  arma::Row<size_t> predictions(9000);
+  tree.Classify(dataset, predictions);
+
+  for (size_t i = 0; i < 9000; ++i)
+    REQUIRE(labels[i] == predictions[i]);
+}
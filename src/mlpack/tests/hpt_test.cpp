@@ -12,6 +12,7 @@
 #include <mlpack/core/cv/metrics/mse.hpp>
 #include <mlpack/core/cv/metrics/accuracy.hpp>
 #include <mlpack/core/cv/simple_cv.hpp>
+#include <mlpack/core/cv/k_fold_cv.hpp>
 #include <mlpack/core/hpt/cv_function.hpp>
 #include <mlpack/core/hpt/fixed.hpp>
 #include <mlpack/core/hpt/hpt.hpp>
@@ -399,3 +400,132 @@ TEST_CASE("HPTGradientDescentTest", "[HPTTest]")
   REQUIRE(xOptimized == Approx(xMin).epsilon(1e-6));
   REQUIRE(zOptimized == Approx(zMin).epsilon(1e-6));
 }
+
+/**
+ * Test SuccessiveHalvingSearch finds the best combination from the specified
+ * ones.  With SimpleCV there is no fold budget, so the search should visit
+ * every combination on the full budget and agree with grid search.
+ */
+TEST_CASE("SuccessiveHalvingSearchTest", "[HPTTest]")
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  std::array<double, 4> lambda2Set{{0.0, 0.05, 0.5, 5.0}};
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  IncrementPolicy policy(true);
+  DatasetMapper<IncrementPolicy, double> datasetInfo(policy, 2);
+  for (double lambda1 : lambda1Set)
+    datasetInfo.MapString<size_t>(lambda1, 0);
+  for (double lambda2 : lambda2Set)
+    datasetInfo.MapString<size_t>(lambda2, 1);
+
+  SimpleCV<LARS, MSE> cv(validationSize, xs, ys);
+  CVFunction<decltype(cv), LARS, 4, FixedArg<bool, 0>, FixedArg<bool, 1>>
+      cvFun(cv, datasetInfo, 0.0, 0.0, {transposeData}, {useCholesky});
+
+  SuccessiveHalvingSearch optimizer;
+  arma::mat actualParameters;
+
+  std::vector<bool> categoricalDimensions(datasetInfo.Dimensionality());
+  arma::Row<size_t> numCategories(datasetInfo.Dimensionality());
+  for (size_t d = 0; d < datasetInfo.Dimensionality(); d++)
+  {
+    numCategories[d] = datasetInfo.NumMappings(d);
+    categoricalDimensions[d] = datasetInfo.Type(d) ==
+        mlpack::data::Datatype::categorical;
+  }
+
+  double actualObjective = optimizer.Optimize(cvFun, actualParameters,
+      categoricalDimensions, numCategories);
+
+  REQUIRE(expectedObjective == Approx(actualObjective).epsilon(1e-7));
+  REQUIRE(expectedLambda1 ==
+      Approx(datasetInfo.UnmapString(actualParameters(0, 0), 0)).epsilon(1e-7));
+  REQUIRE(expectedLambda2 ==
+      Approx(datasetInfo.UnmapString(actualParameters(1, 0), 1)).epsilon(1e-7));
+}
+
+/**
+ * Test SuccessiveHalvingSearch drives the fold budget of KFoldCV and restores
+ * it once the search is done, and that the reported objective is a full-budget
+ * score of the reported combination.
+ */
+TEST_CASE("SuccessiveHalvingBudgetTest", "[HPTTest]")
+{
+  arma::mat xs = arma::randn(5, 90);
+  arma::vec beta = arma::randn(5, 1);
+  arma::rowvec ys = beta.t() * xs + 0.1 * arma::randn(1, 90);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  double lambda2 = 0.0;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+
+  IncrementPolicy policy(true);
+  DatasetMapper<IncrementPolicy, double> datasetInfo(policy, 1);
+  for (double lambda1 : lambda1Set)
+    datasetInfo.MapString<size_t>(lambda1, 0);
+
+  KFoldCV<LARS, MSE> cv(9, xs, ys);
+  CVFunction<decltype(cv), LARS, 4, FixedArg<bool, 0>, FixedArg<bool, 1>,
+      FixedArg<double, 3>> cvFun(cv, datasetInfo, 0.0, 0.0, {transposeData},
+      {useCholesky}, {lambda2});
+
+  SuccessiveHalvingSearch optimizer;
+  arma::mat bestParameters;
+  std::vector<bool> categoricalDimensions(1, true);
+  arma::Row<size_t> numCategories(1);
+  numCategories[0] = datasetInfo.NumMappings(0);
+
+  double objective = optimizer.Optimize(cvFun, bestParameters,
+      categoricalDimensions, numCategories);
+
+  // The full budget should be restored once the search is done.
+  REQUIRE(cv.NumEvaluationFolds() == 9);
+
+  // The reported objective should be a full 9-fold score of the reported
+  // combination rather than a partial-budget estimate.
+  double bestLambda1 = datasetInfo.UnmapString(bestParameters(0, 0), 0);
+  REQUIRE(objective == Approx(cv.Evaluate(transposeData, useCholesky,
+      bestLambda1, lambda2)).epsilon(1e-7));
+}
+
+/**
+ * Test HyperParameterTuner works with SuccessiveHalvingSearch and k-fold
+ * cross-validation.
+ */
+TEST_CASE("HPTSuccessiveHalvingTest", "[HPTTest]")
+{
+  // Initializing a linearly separable dataset (as in HPTMaximizationTest).
+  arma::mat xs = arma::linspace<arma::rowvec>(0.0, 10.0, 50);
+  arma::Row<size_t> ys = arma::join_rows(arma::zeros<arma::Row<size_t>>(25),
+      arma::ones<arma::Row<size_t>>(25));
+  arma::mat doubledXs = arma::join_rows(xs, xs);
+  arma::Row<size_t> doubledYs = arma::join_rows(ys, ys);
+
+  // Zero should be preferred on any subset of the folds, since big lambdas are
+  // likely to restrict capabilities of logistic regression.
+  arma::vec lambdas("0 1e12");
+
+  HyperParameterTuner<LogisticRegression<>, Accuracy, KFoldCV,
+      SuccessiveHalvingSearch> hpt(9, doubledXs, doubledYs);
+
+  double actualLambda;
+  std::tie(actualLambda) = hpt.Optimize(lambdas);
+
+  REQUIRE(hpt.BestObjective() == Approx(1.0).epsilon(1e-7));
+  REQUIRE(actualLambda == Approx(0.0).epsilon(1e-7));
+  REQUIRE(Accuracy::Evaluate(hpt.BestModel(), doubledXs, doubledYs) ==
+      Approx(1.0).epsilon(1e-7));
+}
@@ -109,6 +109,29 @@ TEST_CASE("LoadVectorImageAPITest", "[ImageLoadTest]")
   REQUIRE(matrix.n_cols == 2);
 }
 
+/**
+ * Test that the batched (parallel) image loading API fills the columns
+ * correctly.
+ */
+TEST_CASE("LoadImagesBatchAPITest", "[ImageLoadTest]")
+{
+  arma::Mat<unsigned char> matrix;
+  data::ImageInfo info;
+  std::vector<std::string> files = {"test_image.png", "test_image.png",
+      "test_image.png", "test_image.png"};
+  REQUIRE(data::LoadImages(files, matrix, info, false) == true);
+  // width * height * channels.
+  REQUIRE(matrix.n_rows == 50 * 50 * 3);
+  REQUIRE(matrix.n_cols == 4);
+  REQUIRE(info.Height() == 50);
+  REQUIRE(info.Width() == 50);
+  REQUIRE(info.Channels() == 3);
+
+  // All columns decode the same file, so they must be identical.
+  for (size_t i = 1; i < matrix.n_cols; ++i)
+    REQUIRE(arma::all(matrix.col(i) == matrix.col(0)));
+}
+
 /**
  * Test if the image is saved correctly using API for arma mat.
  */
@@ -313,3 +313,94 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * Test that streaming mean imputation over an on-disk dataset matches the
+ * in-memory result.
+ */
+TEST_CASE("StreamingMeanImputationTest", "[ImputationTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "a, 2, 3"  << endl;
+  f << "5, 6, a"  << endl;
+  f << "8, 9, 10" << endl;
+  f << "a, 1, 5"  << endl;
+  f << "4, 2, a"  << endl;
+  f << "6, 3, 7"  << endl;
+  f << "2, 8, 1"  << endl;
+  f.close();
+
+  arma::mat input;
+  MissingPolicy policy({"a"});
+  DatasetMapper<MissingPolicy> info(policy);
+  REQUIRE(data::Load("test_file.csv", input, info) == true);
+
+  // Save the dataset for streaming; a batch size of two columns makes the
+  // passes cross several batch boundaries.
+  REQUIRE(input.save("test_file.bin", arma::arma_binary) == true);
+
+  // Impute an in-memory copy for reference.
+  arma::mat expected(input);
+  Imputer<double,
+          DatasetMapper<MissingPolicy>,
+          MeanImputation<double>> imputer(info);
+  imputer.Impute(expected, "a", 0);
+  imputer.Impute(expected, "a", 2);
+
+  data::StreamingDataset<> stream("test_file.bin", 2);
+  imputer.Impute(stream, "a", std::vector<size_t>({0, 2}));
+
+  arma::mat result;
+  REQUIRE(result.load("test_file.bin") == true);
+  REQUIRE(result.n_rows == expected.n_rows);
+  REQUIRE(result.n_cols == expected.n_cols);
+  CheckMatrices(result, expected);
+
+  remove("test_file.csv");
+  remove("test_file.bin");
+}
+
+/**
+ * Test that streaming median imputation over an on-disk dataset matches the
+ * in-memory result.
+ */
+TEST_CASE("StreamingMedianImputationTest", "[ImputationTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "a, 2, 3"  << endl;
+  f << "5, 6, a"  << endl;
+  f << "8, 9, 10" << endl;
+  f << "a, 1, 5"  << endl;
+  f << "4, 2, a"  << endl;
+  f << "6, 3, 7"  << endl;
+  f << "2, 8, 1"  << endl;
+  f.close();
+
+  arma::mat input;
+  MissingPolicy policy({"a"});
+  DatasetMapper<MissingPolicy> info(policy);
+  REQUIRE(data::Load("test_file.csv", input, info) == true);
+
+  REQUIRE(input.save("test_file.bin", arma::arma_binary) == true);
+
+  arma::mat expected(input);
+  Imputer<double,
+          DatasetMapper<MissingPolicy>,
+          MedianImputation<double>> imputer(info);
+  imputer.Impute(expected, "a", 0);
+  imputer.Impute(expected, "a", 2);
+
+  data::StreamingDataset<> stream("test_file.bin", 3);
+  imputer.Impute(stream, "a", std::vector<size_t>({0, 2}));
+
+  arma::mat result;
+  REQUIRE(result.load("test_file.bin") == true);
+  REQUIRE(result.n_rows == expected.n_rows);
+  REQUIRE(result.n_cols == expected.n_cols);
+  CheckMatrices(result, expected);
+
+  remove("test_file.csv");
+  remove("test_file.bin");
+}
@@ -379,3 +379,37 @@ TEST_CASE("LecunNormalInitTest", "[InitRulesTest]")
   REQUIRE(weights3d.n_cols == cols);
   REQUIRE(weights3d.n_slices == slices);
 }
+
+/**
+ * Check that random weight initialization is reproducible: with the same seed
+ * the (possibly parallel) fill gives the same weights, and the values respect
+ * the requested bounds.
+ */
+TEST_CASE("RandomInitReproducibilityTest", "[InitRulesTest]")
+{
+  const size_t rows = 100;
+  const size_t cols = 200;
+
+  arma::mat weightsA, weightsB;
+
+  RandomInitialization init(-0.5, 0.5);
+
+  math::RandomSeed(42);
+  init.Initialize(weightsA, rows, cols);
+  math::RandomSeed(42);
+  init.Initialize(weightsB, rows, cols);
+
+  CheckMatrices(weightsA, weightsB);
+  REQUIRE(weightsA.max() <= 0.5);
+  REQUIRE(weightsA.min() >= -0.5);
+
+  // The same should hold for the Gaussian-based rules.
+  GaussianInitialization gaussianInit(0.0, 0.1);
+
+  math::RandomSeed(42);
+  gaussianInit.Initialize(weightsA, rows, cols);
+  math::RandomSeed(42);
+  gaussianInit.Initialize(weightsB, rows, cols);
+
+  CheckMatrices(weightsA, weightsB);
+}
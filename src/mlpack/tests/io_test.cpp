@@ -26,6 +26,7 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/server_mode.hpp>
 
 #include "catch.hpp"
 
@@ -1291,3 +1292,62 @@ TEST_CASE("CppNameTest", "[IOTest]")
   REQUIRE(p.Parameters().at("help").cppType == "bool");
   REQUIRE(p.Parameters().at("double").cppType == "double");
 }
+
+/**
+ * Test that server-mode request lines are split into tokens like a command
+ * line, with quoting and escaping.
+ */
+TEST_CASE("ServerSplitCommandLineTest", "[IOTest]")
+{
+  std::vector<std::string> tokens =
+      SplitCommandLine("--input_file test.csv --verbose");
+  REQUIRE(tokens.size() == 3);
+  REQUIRE(tokens[0] == "--input_file");
+  REQUIRE(tokens[1] == "test.csv");
+  REQUIRE(tokens[2] == "--verbose");
+
+  // Quotes group whitespace into one token; backslashes escape.
+  tokens = SplitCommandLine("--name \"two words\" --other 'a b' esc\\ aped");
+  REQUIRE(tokens.size() == 5);
+  REQUIRE(tokens[1] == "two words");
+  REQUIRE(tokens[3] == "a b");
+  REQUIRE(tokens[4] == "esc aped");
+
+  // Empty quoted strings are still tokens; blank lines are not.
+  tokens = SplitCommandLine("--empty \"\"");
+  REQUIRE(tokens.size() == 2);
+  REQUIRE(tokens[1] == "");
+  REQUIRE(SplitCommandLine("   ").empty());
+}
+
+/**
+ * Test that the server cache hands back inserted objects, reports ownership,
+ * and is inert while disabled.
+ */
+TEST_CASE("ServerCacheTest", "[IOTest]")
+{
+  ServerCache& cache = ServerCache::Instance();
+
+  // Disabled (the default): inserts are dropped and lookups miss.
+  int dropped = 1;
+  cache.Insert("int", "file.bin", &dropped, [](void* /* object */) { });
+  REQUIRE(cache.Find("int", "file.bin") == (void*) NULL);
+
+  cache.Enabled() = true;
+  int* value = new int(37);
+  cache.Insert("int", "file.bin", value,
+      [](void* object) { delete static_cast<int*>(object); });
+  REQUIRE(cache.Find("int", "file.bin") == (void*) value);
+  REQUIRE(*static_cast<int*>(cache.Find("int", "file.bin")) == 37);
+  REQUIRE(cache.Owns(value));
+
+  // A different type name or filename is a different entry.
+  REQUIRE(cache.Find("double", "file.bin") == (void*) NULL);
+  REQUIRE(cache.Find("int", "other.bin") == (void*) NULL);
+
+  cache.Clear();
+  REQUIRE(cache.Find("int", "file.bin") == (void*) NULL);
+  REQUIRE(!cache.Owns(value));
+
+  cache.Enabled() = false;
+}
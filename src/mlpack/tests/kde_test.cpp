@@ -80,6 +80,114 @@ TEST_CASE("KDESimpleTest", "[KDETest]")
     REQUIRE(estimations[i] == Approx(estimationsResult[i]).epsilon(0.001));
 }
 
+/**
+ * LastEvaluationStats() must report the work counters of the last call to
+ * Evaluate(), for both the bichromatic and the monochromatic overloads.
+ */
+TEST_CASE("KDELastEvaluationStatsTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu<arma::mat>(2, 300);
+  arma::mat query = arma::randu<arma::mat>(2, 100);
+  arma::vec estimations;
+
+  KDE<GaussianKernel,
+      EuclideanDistance,
+      arma::mat,
+      KDTree>
+      kde(0.05, 0.0, GaussianKernel(0.3));
+  kde.Train(reference);
+
+  kde.Evaluate(query, estimations);
+  const EvaluationStats stats = kde.LastEvaluationStats();
+  REQUIRE(stats.baseCases > 0);
+  REQUIRE(stats.scores > 0);
+  REQUIRE(stats.traversalTime.count() >= 0);
+
+  // The monochromatic overload must overwrite the counters.
+  kde.Evaluate(estimations);
+  const EvaluationStats& monoStats = kde.LastEvaluationStats();
+  REQUIRE(monoStats.baseCases > 0);
+  REQUIRE(monoStats.scores > 0);
+}
+
+/**
+ * Test that a multi-bandwidth evaluation matches evaluating each bandwidth
+ * separately.
+ */
+TEST_CASE("KDEMultiBandwidthTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu<arma::mat>(2, 400);
+  arma::mat query = arma::randu<arma::mat>(2, 100);
+  const double kernelBandwidth[] = { 0.1, 0.3, 0.9 };
+  const double relError = 0.05;
+
+  std::vector<GaussianKernel> kernels;
+  for (const double bandwidth : kernelBandwidth)
+    kernels.push_back(GaussianKernel(bandwidth));
+
+  for (const KDEMode mode : { KDEMode::DUAL_TREE_MODE,
+                              KDEMode::SINGLE_TREE_MODE })
+  {
+    KDE<GaussianKernel,
+        EuclideanDistance,
+        arma::mat,
+        KDTree>
+        kde(relError, 0.0, GaussianKernel(), mode);
+    kde.Train(reference);
+
+    // One traversal for the whole sweep.
+    arma::mat sweepEstimations;
+    kde.Evaluate(query, kernels, sweepEstimations);
+    REQUIRE(sweepEstimations.n_rows == kernels.size());
+    REQUIRE(sweepEstimations.n_cols == query.n_cols);
+
+    // Compare each row against a separate evaluation of that bandwidth.
+    for (size_t k = 0; k < kernels.size(); ++k)
+    {
+      KDE<GaussianKernel,
+          EuclideanDistance,
+          arma::mat,
+          KDTree>
+          singleKDE(relError, 0.0, GaussianKernel(kernelBandwidth[k]), mode);
+      singleKDE.Train(reference);
+      arma::vec estimations;
+      singleKDE.Evaluate(query, estimations);
+
+      // Both estimations carry up to relError relative error each.
+      for (size_t i = 0; i < query.n_cols; ++i)
+      {
+        REQUIRE(sweepEstimations(k, i) ==
+            Approx(estimations(i)).epsilon(2 * relError));
+      }
+    }
+
+    // The monochromatic sweep must also match separate monochromatic
+    // evaluations.
+    arma::mat monoSweepEstimations;
+    kde.Evaluate(kernels, monoSweepEstimations);
+    REQUIRE(monoSweepEstimations.n_rows == kernels.size());
+    REQUIRE(monoSweepEstimations.n_cols == reference.n_cols);
+
+    for (size_t k = 0; k < kernels.size(); ++k)
+    {
+      KDE<GaussianKernel,
+          EuclideanDistance,
+          arma::mat,
+          KDTree>
+          singleKDE(relError, 0.0, GaussianKernel(kernelBandwidth[k]), mode);
+      singleKDE.Train(reference);
+      arma::vec estimations;
+      singleKDE.Evaluate(estimations);
+
+      for (size_t i = 0; i < reference.n_cols; ++i)
+      {
+        REQUIRE(monoSweepEstimations(k, i) ==
+            Approx(estimations(i)).epsilon(2 * relError));
+      }
+    }
+  }
+}
+
 /**
  * Test Train(Tree...) and Evaluate(Tree...).
  */
@@ -593,6 +701,44 @@ TEST_CASE("BreadthFirstKDETest", "[KDETest]")
     REQUIRE(bfEstimations[i] == Approx(treeEstimations[i]).epsilon(relError));
 }
 
+/**
+ * Test dual-tree best-first implementation results against brute force
+ * results.
+ */
+TEST_CASE("BestFirstKDETest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 200);
+  arma::mat query = arma::randu(2, 60);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double kernelBandwidth = 0.8;
+  const double relError = 0.01;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  // Best-first KDE.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree,
+      tree::KDTree<metric::EuclideanDistance,
+                   kde::KDEStat,
+                   arma::mat>::template BestFirstDualTreeTraverser>
+      kde(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  // Check whether results are equal.
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(bfEstimations[i] == Approx(treeEstimations[i]).epsilon(relError));
+}
+
 /**
  * Test 1-dimensional implementation results against brute force results.
  */
@@ -1297,3 +1443,121 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Test that evaluation with pending incremental updates matches a brute-force
+ * calculation over the merged reference set.
+ */
+TEST_CASE("KDEIncrementalUpdatesTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 200);
+  arma::mat query = arma::randu(2, 50);
+  arma::mat newPoints = arma::randu(2, 10);
+  GaussianKernel kernel(0.5);
+
+  // Exact error tolerances so that the results are deterministic.
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      kde(0.0, 0.0, GaussianKernel(0.5));
+  kde.Train(reference);
+
+  // Insert new points and lazily delete some points: two tree points and one
+  // of the pending inserted points.
+  kde.Insert(newPoints);
+  kde.Delete(3);
+  kde.Delete(7);
+  kde.Delete(200 + 2);
+
+  // The pending changes are below the rebuild threshold.
+  REQUIRE(kde.DeltaSet().n_cols == 10);
+  REQUIRE(kde.NumPendingDeletes() == 3);
+
+  arma::vec estimations;
+  kde.Evaluate(query, estimations);
+
+  // Build the merged reference set by hand.  Deleted tree point indices refer
+  // to columns of the tree dataset.
+  const arma::mat& treeSet = kde.ReferenceTree()->Dataset();
+  arma::mat mergedSet(2, treeSet.n_cols + newPoints.n_cols - 3);
+  size_t c = 0;
+  for (size_t i = 0; i < treeSet.n_cols; ++i)
+    if (i != 3 && i != 7)
+      mergedSet.col(c++) = treeSet.col(i);
+  for (size_t j = 0; j < newPoints.n_cols; ++j)
+    if (j != 2)
+      mergedSet.col(c++) = newPoints.col(j);
+
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(mergedSet, query, bfEstimations, kernel);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(estimations[i] == Approx(bfEstimations[i]).epsilon(1e-8));
+}
+
+/**
+ * Test that the tree is rebuilt once pending changes exceed the rebuild
+ * threshold and that results still match a brute-force calculation.
+ */
+TEST_CASE("KDERebuildIndexTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 100);
+  arma::mat query = arma::randu(2, 30);
+  arma::mat newPoints = arma::randu(2, 30);
+  GaussianKernel kernel(0.5);
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      kde(0.0, 0.0, GaussianKernel(0.5));
+  kde.Train(reference);
+
+  // Inserting more points than the rebuild threshold allows triggers a full
+  // tree rebuild on the merged set.
+  kde.Insert(newPoints);
+  REQUIRE(kde.DeltaSet().n_cols == 0);
+  REQUIRE(kde.NumPendingDeletes() == 0);
+  REQUIRE(kde.ReferenceTree()->Dataset().n_cols == 130);
+
+  arma::vec estimations;
+  kde.Evaluate(query, estimations);
+
+  arma::mat mergedSet = arma::join_rows(reference, newPoints);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(mergedSet, query, bfEstimations, kernel);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(estimations[i] == Approx(bfEstimations[i]).epsilon(1e-8));
+}
+
+/**
+ * Test that incremental updates also apply to the single-tree mode and the
+ * monochromatic evaluation overload.
+ */
+TEST_CASE("KDEIncrementalSingleTreeTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 200);
+  arma::mat query = arma::randu(2, 40);
+  arma::mat newPoints = arma::randu(2, 8);
+  GaussianKernel kernel(0.5);
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree>
+      kde(0.0, 0.0, GaussianKernel(0.5), KDEMode::SINGLE_TREE_MODE);
+  kde.Train(reference);
+  kde.Insert(newPoints);
+  kde.Delete(5);
+
+  arma::vec estimations;
+  kde.Evaluate(query, estimations);
+
+  const arma::mat& treeSet = kde.ReferenceTree()->Dataset();
+  arma::mat mergedSet(2, treeSet.n_cols + newPoints.n_cols - 1);
+  size_t c = 0;
+  for (size_t i = 0; i < treeSet.n_cols; ++i)
+    if (i != 5)
+      mergedSet.col(c++) = treeSet.col(i);
+  for (size_t j = 0; j < newPoints.n_cols; ++j)
+    mergedSet.col(c++) = newPoints.col(j);
+
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(mergedSet, query, bfEstimations, kernel);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(estimations[i] == Approx(bfEstimations[i]).epsilon(1e-8));
+}
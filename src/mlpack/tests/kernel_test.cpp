@@ -16,6 +16,8 @@
 #include <mlpack/core/kernels/hyperbolic_tangent_kernel.hpp>
 #include <mlpack/core/kernels/laplacian_kernel.hpp>
 #include <mlpack/core/kernels/linear_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+#include <mlpack/core/kernels/pairwise_kernels.hpp>
 #include <mlpack/core/kernels/polynomial_kernel.hpp>
 #include <mlpack/core/kernels/spherical_kernel.hpp>
 #include <mlpack/core/kernels/pspectrum_string_kernel.hpp>
@@ -632,3 +634,86 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * Check that the bulk pairwise kernel computation agrees with per-pair
+ * evaluation, for the kernels with specialized bulk forms and for a generic
+ * kernel.
+ */
+TEST_CASE("PairwiseKernelsTest", "[KernelTest]")
+{
+  arma::mat references = arma::randu(5, 40);
+  arma::mat queries = arma::randu(5, 25);
+
+  GaussianKernel gk(1.3);
+  LaplacianKernel lk(0.8);
+  LinearKernel link;
+  PolynomialKernel pk(3.0, 0.5);
+  CosineDistance cd;
+
+  arma::mat gaussians, laplacians, linears, polynomials, cosines;
+  PairwiseKernels(references, queries, gaussians, gk);
+  PairwiseKernels(references, queries, laplacians, lk);
+  PairwiseKernels(references, queries, linears, link);
+  PairwiseKernels(references, queries, polynomials, pk);
+  PairwiseKernels(references, queries, cosines, cd);
+
+  REQUIRE(gaussians.n_rows == references.n_cols);
+  REQUIRE(gaussians.n_cols == queries.n_cols);
+
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    for (size_t j = 0; j < references.n_cols; ++j)
+    {
+      REQUIRE(gaussians(j, i) ==
+          Approx(gk.Evaluate(references.col(j), queries.col(i))).
+          epsilon(1e-7));
+      REQUIRE(laplacians(j, i) ==
+          Approx(lk.Evaluate(references.col(j), queries.col(i))).
+          epsilon(1e-7));
+      REQUIRE(linears(j, i) ==
+          Approx(link.Evaluate(references.col(j), queries.col(i))).
+          epsilon(1e-7));
+      REQUIRE(polynomials(j, i) ==
+          Approx(pk.Evaluate(references.col(j), queries.col(i))).
+          epsilon(1e-7));
+      REQUIRE(cosines(j, i) ==
+          Approx(cd.Evaluate(references.col(j), queries.col(i))).
+          epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * The lazily-evaluated kernel matrix view must return exact kernel values,
+ * both from freshly computed tiles and from cached ones, and even when the
+ * memory budget forces tiles to be evicted and recomputed.
+ */
+TEST_CASE("KernelMatrixTest", "[KernelTest]")
+{
+  arma::mat references = arma::randu<arma::mat>(5, 200);
+  arma::mat queries = arma::randu<arma::mat>(5, 150);
+  GaussianKernel gk(1.5);
+
+  // A small tile size and a budget of two tiles force plenty of evictions.
+  KernelMatrix<GaussianKernel> view(references, queries, gk, 16,
+      2 * 16 * 16 * sizeof(double));
+
+  // Evaluate every entry twice, in a tile-unfriendly order.
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    for (size_t i = 0; i < queries.n_cols; ++i)
+    {
+      for (size_t j = 0; j < references.n_cols; ++j)
+      {
+        REQUIRE(view.Evaluate(j, i) ==
+            Approx(gk.Evaluate(references.col(j), queries.col(i))).
+            epsilon(1e-10));
+      }
+    }
+  }
+
+  REQUIRE(view.Hits() + view.Misses() ==
+      2 * references.n_cols * queries.n_cols);
+  REQUIRE(view.Misses() > 0);
+}
@@ -12,9 +12,12 @@
 #include <mlpack/methods/kmeans/kmeans.hpp>
 #include <mlpack/methods/kmeans/allow_empty_clusters.hpp>
 #include <mlpack/methods/kmeans/refined_start.hpp>
+#include <mlpack/methods/kmeans/kmeans_parallel_initialization.hpp>
 #include <mlpack/methods/kmeans/kmeans_plus_plus_initialization.hpp>
+#include <mlpack/methods/kmeans/drake_kmeans.hpp>
 #include <mlpack/methods/kmeans/elkan_kmeans.hpp>
 #include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
+#include <mlpack/methods/kmeans/mini_batch_kmeans.hpp>
 #include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
 #include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
 #include <mlpack/methods/kmeans/sample_initialization.hpp>
@@ -553,6 +556,60 @@ TEST_CASE("KMeansPlusPlusTest", "[KMeansTest]")
   REQUIRE(distortion < 14500.0);
 }
 
+/**
+ * Make sure the k-means|| initialization finds a seeding of quality
+ * comparable to k-means++ on the same five-Gaussian dataset.
+ */
+TEST_CASE("KMeansParallelTest", "[KMeansTest]")
+{
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  KMeansParallelInitialization k;
+  arma::mat resultingCentroids;
+  k.Cluster(data, 5, resultingCentroids);
+
+  // Calculate resulting assignments.
+  arma::Row<size_t> assignments(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double bestDist = DBL_MAX;
+    for (size_t j = 0; j < 5; ++j)
+    {
+      const double dist = metric::EuclideanDistance::Evaluate(data.col(i),
+          resultingCentroids.col(j));
+      if (dist < bestDist)
+      {
+        bestDist = dist;
+        assignments[i] = j;
+      }
+    }
+  }
+
+  // Calculate sum of distances from centroid means.
+  double distortion = 0;
+  for (size_t i = 0; i < 3000; ++i)
+    distortion += metric::EuclideanDistance::Evaluate(data.col(i),
+        resultingCentroids.col(assignments[i]));
+
+  // Use the same quality threshold as the k-means++ test above; k-means||
+  // should match that seeding quality with far fewer passes over the data.
+  REQUIRE(distortion < 14500.0);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -634,6 +691,40 @@ TEST_CASE("ElkanTest", "[KMeansTest]")
   }
 }
 
+TEST_CASE("DrakeTest", "[KMeansTest]")
+{
+  const size_t trials = 5;
+
+  for (size_t t = 0; t < trials; ++t)
+  {
+    arma::mat dataset(10, 1000);
+    dataset.randu();
+
+    const size_t k = 5 * (t + 1);
+    arma::mat centroids(10, k);
+    centroids.randu();
+
+    // Make sure the adaptive-bound algorithm and the naive method return the
+    // same clusters.
+    arma::mat naiveCentroids(centroids);
+    KMeans<> km;
+    arma::Row<size_t> assignments;
+    km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+    KMeans<metric::EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        DrakeKMeans> drake;
+    arma::Row<size_t> drakeAssignments;
+    arma::mat drakeCentroids(centroids);
+    drake.Cluster(dataset, k, drakeAssignments, drakeCentroids, false, true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      REQUIRE(assignments[i] == drakeAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      REQUIRE(naiveCentroids[i] == Approx(drakeCentroids[i]).epsilon(1e-7));
+  }
+}
+
 TEST_CASE("HamerlyTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -669,6 +760,46 @@ TEST_CASE("HamerlyTest", "[KMeansTest]")
   }
 }
 
+/**
+ * Make sure the mini-batch variant refines centroids towards the three
+ * well-separated clusters.  The iterations are stochastic, so start from
+ * rough initial centroids and check that the refined centroids end up close
+ * to the true cluster means.
+ */
+TEST_CASE("MiniBatchKMeansTest", "[KMeansTest]")
+{
+  arma::mat dataset = trans(kMeansData);
+
+  // Rough initial centroids, one per cluster.
+  arma::mat centroids("  0.5  9.0 -9.0;"
+                      " -0.5  9.0  4.0;");
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      MiniBatchKMeans> kmeans(500);
+  arma::Row<size_t> assignments;
+  kmeans.Cluster(dataset, 3, assignments, centroids, false, true);
+
+  // The true cluster means.
+  arma::mat means(2, 3);
+  means.col(0) = arma::mean(dataset.cols(0, 12), 1);
+  means.col(1) = arma::mean(dataset.cols(13, 19), 1);
+  means.col(2) = arma::mean(dataset.cols(20, 29), 1);
+
+  // The clusters are roughly ten units apart, so a loose tolerance is still
+  // conclusive.
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(arma::norm(centroids.col(i) - means.col(i)) < 0.5);
+
+  // The assignments are computed from the final centroids, so they should
+  // recover the classes exactly.
+  for (size_t i = 0; i < 13; ++i)
+    REQUIRE(assignments[i] == 0);
+  for (size_t i = 13; i < 20; ++i)
+    REQUIRE(assignments[i] == 1);
+  for (size_t i = 20; i < 30; ++i)
+    REQUIRE(assignments[i] == 2);
+}
+
 TEST_CASE("PellegMooreTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -800,3 +931,131 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+/**
+ * In deterministic mode, two runs with the same seed must produce
+ * bit-identical results, even though the Lloyd iterations are parallelized.
+ */
+TEST_CASE("DeterministicParallelKMeansTest", "[KMeansTest]")
+{
+  arma::mat dataset(10, 1000, arma::fill::randu);
+
+  math::Deterministic() = true;
+
+  math::RandomSeed(42);
+  KMeans<> kmeans;
+  arma::Row<size_t> assignmentsOne;
+  arma::mat centroidsOne;
+  kmeans.Cluster(dataset, 5, assignmentsOne, centroidsOne);
+
+  math::RandomSeed(42);
+  KMeans<> kmeansTwo;
+  arma::Row<size_t> assignmentsTwo;
+  arma::mat centroidsTwo;
+  kmeansTwo.Cluster(dataset, 5, assignmentsTwo, centroidsTwo);
+
+  math::Deterministic() = false;
+
+  // Bitwise equality, not approximate equality.
+  for (size_t i = 0; i < centroidsOne.n_elem; ++i)
+    REQUIRE(centroidsOne[i] == centroidsTwo[i]);
+  for (size_t i = 0; i < assignmentsOne.n_elem; ++i)
+    REQUIRE(assignmentsOne[i] == assignmentsTwo[i]);
+}
+
+/**
+ * A weighted Lloyd iteration with weight 2 on every point must match an
+ * unweighted iteration on the dataset with every point duplicated.
+ */
+TEST_CASE("NaiveKMeansWeightedIterateTest", "[KMeansTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 200);
+  arma::mat duplicated = arma::join_rows(data, data);
+  arma::vec weights(200);
+  weights.fill(2.0);
+
+  arma::mat centroids = data.cols(0, 4);
+  EuclideanDistance metric;
+
+  NaiveKMeans<EuclideanDistance, arma::mat> unweighted(duplicated, metric);
+  NaiveKMeans<EuclideanDistance, arma::mat> weighted(data, weights, metric);
+
+  arma::mat unweightedCentroids, weightedCentroids;
+  arma::Col<size_t> unweightedCounts, weightedCounts;
+  unweighted.Iterate(centroids, unweightedCentroids, unweightedCounts);
+  weighted.Iterate(centroids, weightedCentroids, weightedCounts);
+
+  for (size_t i = 0; i < unweightedCentroids.n_elem; ++i)
+  {
+    REQUIRE(unweightedCentroids[i] ==
+        Approx(weightedCentroids[i]).margin(1e-10));
+  }
+
+  // The counts hold numbers of points, not weights.
+  for (size_t i = 0; i < unweightedCounts.n_elem; ++i)
+    REQUIRE(unweightedCounts[i] == 2 * weightedCounts[i]);
+}
+
+/**
+ * Test the lightweight coreset construction.
+ */
+TEST_CASE("KMeansCoresetBuildTest", "[KMeansTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(2, 500);
+
+  arma::mat coreset;
+  arma::vec weights;
+  KMeansCoreset::Build(data, 100, coreset, weights);
+
+  REQUIRE(coreset.n_rows == data.n_rows);
+  REQUIRE(coreset.n_cols == 100);
+  REQUIRE(weights.n_elem == 100);
+  for (size_t i = 0; i < weights.n_elem; ++i)
+    REQUIRE(weights[i] > 0.0);
+
+  // If the requested coreset is not smaller than the data, the data itself
+  // must be returned with unit weights.
+  KMeansCoreset::Build(data, 600, coreset, weights);
+  REQUIRE(coreset.n_cols == data.n_cols);
+  REQUIRE(weights.n_elem == data.n_cols);
+  for (size_t i = 0; i < weights.n_elem; ++i)
+    REQUIRE(weights[i] == 1.0);
+}
+
+/**
+ * ClusterCoreset() must recover the centers of well-separated clusters from a
+ * coreset ten times smaller than the data.
+ */
+TEST_CASE("KMeansClusterCoresetTest", "[KMeansTest]")
+{
+  // Three well-separated Gaussians.
+  arma::mat data(2, 3000);
+  data.cols(0, 999) = arma::randn<arma::mat>(2, 1000) * 0.5;
+  data.cols(1000, 1999) = arma::randn<arma::mat>(2, 1000) * 0.5;
+  data.cols(1000, 1999).row(0) += 10.0;
+  data.cols(1000, 1999).row(1) += 10.0;
+  data.cols(2000, 2999) = arma::randn<arma::mat>(2, 1000) * 0.5;
+  data.cols(2000, 2999).row(0) -= 10.0;
+  data.cols(2000, 2999).row(1) += 5.0;
+
+  KMeans<> kmeans;
+  arma::mat centroids;
+  kmeans.ClusterCoreset(data, 3, centroids, 300);
+
+  REQUIRE(centroids.n_cols == 3);
+
+  // Each true center must have a centroid nearby.
+  arma::mat trueCenters("0.0 10.0 -10.0; 0.0 10.0 5.0");
+  for (size_t i = 0; i < 3; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::max();
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          trueCenters.col(i), centroids.col(j));
+      minDistance = std::min(minDistance, distance);
+    }
+
+    REQUIRE(minDistance < 1.0);
+  }
+}
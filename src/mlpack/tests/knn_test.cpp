@@ -12,11 +12,14 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/pq_index.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
 
+#include <thread>
+
 using namespace mlpack;
 using namespace mlpack::neighbor;
 using namespace mlpack::tree;
@@ -185,6 +188,109 @@ TEST_CASE("KNNEmptySearchTest", "[KNNTest]")
       std::invalid_argument);
 }
 
+/**
+ * Test that SearchBatch() gives exactly the same results as Search(), in the
+ * same (original) query order, for every search mode.
+ */
+TEST_CASE("KNNSearchBatchTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+  arma::mat queryData = arma::randu<arma::mat>(5, 300);
+
+  const NeighborSearchMode modes[3] =
+      { NAIVE_MODE, SINGLE_TREE_MODE, DUAL_TREE_MODE };
+  for (size_t m = 0; m < 3; ++m)
+  {
+    KNN knn(referenceData, modes[m]);
+
+    arma::Mat<size_t> neighbors, batchNeighbors;
+    arma::mat distances, batchDistances;
+
+    knn.Search(queryData, 7, neighbors, distances);
+    knn.SearchBatch(queryData, 7, batchNeighbors, batchDistances);
+
+    REQUIRE(batchNeighbors.n_rows == neighbors.n_rows);
+    REQUIRE(batchNeighbors.n_cols == neighbors.n_cols);
+
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(batchNeighbors[i] == neighbors[i]);
+      REQUIRE(batchDistances[i] == Approx(distances[i]).epsilon(1e-10));
+    }
+  }
+}
+
+/**
+ * Test that incremental Insert() and Delete() give the same results as a
+ * model built from scratch on the equivalent point set.
+ */
+TEST_CASE("KNNIncrementalUpdateTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 400);
+  arma::mat insertData = arma::randu<arma::mat>(5, 20);
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+
+  KNN knn(referenceData);
+
+  // Insert a few points and lazily delete a few reference points; keep the
+  // pending changes under the default rebuild threshold (10% of 400).
+  knn.Insert(insertData);
+  knn.Delete(3);
+  knn.Delete(177);
+  knn.Delete(400 + 5); // The sixth inserted point.
+
+  REQUIRE(knn.DeltaSet().n_cols == 20);
+  REQUIRE(knn.NumPendingDeletes() == 3);
+
+  // Build the equivalent point set from scratch, with deleted points replaced
+  // by far-away points so that indices still line up.
+  arma::mat mergedData = arma::join_rows(referenceData, insertData);
+  mergedData.col(3).fill(1000.0);
+  mergedData.col(177).fill(1000.0);
+  mergedData.col(405).fill(1000.0);
+  KNN baseline(mergedData);
+
+  arma::Mat<size_t> neighbors, baselineNeighbors;
+  arma::mat distances, baselineDistances;
+
+  knn.Search(queryData, 10, neighbors, distances);
+  baseline.Search(queryData, 10, baselineNeighbors, baselineDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == baselineNeighbors[i]);
+    REQUIRE(distances[i] == Approx(baselineDistances[i]).epsilon(1e-10));
+  }
+
+  // Monochromatic search should also agree on the non-deleted reference
+  // points (inserted points are candidates but not queries).
+  knn.Search(5, neighbors, distances);
+  REQUIRE(neighbors.n_cols == referenceData.n_cols);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    if (i == 3 || i == 177)
+      continue; // Deleted points still get a result column; skip them.
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, i) != 3);
+      REQUIRE(neighbors(j, i) != 177);
+      REQUIRE(neighbors(j, i) != 405);
+    }
+  }
+
+  // Now force a rebuild and check that the pending changes are flushed.
+  knn.RebuildIndex();
+  REQUIRE(knn.DeltaSet().n_cols == 0);
+  REQUIRE(knn.NumPendingDeletes() == 0);
+  REQUIRE(knn.ReferenceSet().n_cols == 400 + 20 - 3);
+
+  // A small threshold must trigger the rebuild automatically.
+  knn.RebuildThreshold() = 0.001;
+  knn.Insert(insertData.col(0));
+  REQUIRE(knn.DeltaSet().n_cols == 0);
+  REQUIRE(knn.ReferenceSet().n_cols == 400 + 20 - 3 + 1);
+}
+
 /**
  * Test that when training is performed, the results are the same.
  */
@@ -683,6 +789,39 @@ TEST_CASE("KNNDualTreeVsNaive", "[KNNTest]")
   }
 }
 
+/**
+ * Test the best-first dual-tree traverser against the naive method.  With an
+ * exact rule set the visit order must not change the results, so they have to
+ * be identical.
+ */
+TEST_CASE("KNNBestFirstVsNaive", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      KDTree, KDTree<EuclideanDistance,
+                     NeighborSearchStat<NearestNeighborSort>,
+                     arma::mat>::template BestFirstDualTreeTraverser>
+      BestFirstKNN;
+
+  BestFirstKNN knn(dataset);
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree;
+  arma::mat distancesTree;
+  knn.Search(dataset, 10, neighborsTree, distancesTree);
+
+  arma::Mat<size_t> neighborsNaive;
+  arma::mat distancesNaive;
+  naive.Search(dataset, 10, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+}
+
 /**
  * Test the dual-tree nearest-neighbors method with the naive method.  This uses
  * only a reference dataset.
@@ -1153,6 +1292,177 @@ TEST_CASE("KNNModelTest", "[KNNTest]")
   }
 }
 
+/**
+ * Test that the product-quantization index achieves reasonable recall, never
+ * stores the reference set, and rejects invalid configurations.
+ */
+TEST_CASE("KNNPQIndexTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(8, 100);
+
+  // Exact results for comparison.
+  KNN knn(referenceData);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  knn.Search(queryData, 10, exactNeighbors, exactDistances);
+
+  PQIndex<> pq(referenceData, 4 /* subspaces */);
+  REQUIRE(pq.NumPoints() == referenceData.n_cols);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  pq.Search(queryData, 10, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 10);
+  REQUIRE(neighbors.n_cols == queryData.n_cols);
+
+  // Quantized distances are approximate, so check recall, not equality.
+  const double recall = KNN::Recall(neighbors, exactNeighbors);
+  REQUIRE(recall > 0.5);
+
+  // Reconstructed distances must be ordered and nonnegative.
+  for (size_t i = 0; i < distances.n_cols; ++i)
+    for (size_t j = 1; j < distances.n_rows; ++j)
+      REQUIRE(distances(j, i) >= distances(j - 1, i));
+
+  // More subspaces than dimensions, or too many codewords, must be rejected.
+  REQUIRE_THROWS_AS(PQIndex<>(referenceData, 10), std::invalid_argument);
+  REQUIRE_THROWS_AS(PQIndex<>(referenceData, 4, 1000),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the small-world graph index achieves reasonable recall and that
+ * it can be selected through NSModel.
+ */
+TEST_CASE("KNNSWGraphTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(8, 100);
+
+  // Exact results for comparison.
+  KNN knn(referenceData);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  knn.Search(queryData, 10, exactNeighbors, exactDistances);
+
+  SWGraph<> graph(referenceData);
+  graph.EfSearch() = 128;
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  graph.Search(queryData, 10, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 10);
+  REQUIRE(neighbors.n_cols == queryData.n_cols);
+
+  // The index is approximate, so check recall rather than exact agreement.
+  // With a beam this wide on a dataset this small, recall should be high.
+  const double recall = KNN::Recall(neighbors, exactNeighbors);
+  REQUIRE(recall > 0.7);
+
+  // Monochromatic search must never return the query point itself.
+  arma::Mat<size_t> monoNeighbors;
+  arma::mat monoDistances;
+  graph.Search(5, monoNeighbors, monoDistances);
+  for (size_t i = 0; i < monoNeighbors.n_cols; ++i)
+    for (size_t j = 0; j < monoNeighbors.n_rows; ++j)
+      REQUIRE(monoNeighbors(j, i) != i);
+
+  // The graph index should also be selectable through NSModel.
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+  KNNModel model(KNNModel::TreeTypes::SW_GRAPH, false);
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(timers, std::move(referenceCopy), DUAL_TREE_MODE);
+  REQUIRE(model.TreeName() == "small-world graph");
+
+  arma::mat queryCopy(queryData);
+  model.Search(timers, std::move(queryCopy), 10, neighbors, distances);
+  const double modelRecall = KNN::Recall(neighbors, exactNeighbors);
+  REQUIRE(modelRecall > 0.7);
+}
+
+/**
+ * Test that bulk-loaded (STR-packed) R trees can be selected through NSModel
+ * and give exactly the same results as insertion-built trees.
+ */
+TEST_CASE("KNNModelBulkLoadTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  arma::mat referenceData = arma::randu<arma::mat>(8, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(8, 100);
+
+  // Get a baseline.
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 5, baselineNeighbors, baselineDistances);
+
+  KNNModel::TreeTypes treeTypes[2] = { KNNModel::TreeTypes::R_TREE,
+      KNNModel::TreeTypes::R_STAR_TREE };
+  for (size_t i = 0; i < 2; ++i)
+  {
+    KNNModel model(treeTypes[i], false);
+    model.BulkLoad() = true;
+    arma::mat referenceCopy(referenceData);
+    model.BuildModel(timers, std::move(referenceCopy), DUAL_TREE_MODE);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    arma::mat queryCopy(queryData);
+    model.Search(timers, std::move(queryCopy), 5, neighbors, distances);
+
+    for (size_t j = 0; j < neighbors.n_elem; ++j)
+    {
+      REQUIRE(neighbors[j] == baselineNeighbors[j]);
+      REQUIRE(distances[j] == Approx(baselineDistances[j]).epsilon(1e-7));
+    }
+  }
+}
+
+TEST_CASE("KNNModelAutoTuneTest", "[KNNTest]")
+{
+  // Ensure that AutoTune() picks one of the candidate configurations and that
+  // the resulting model gives correct results.
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  arma::mat referenceData = arma::randu<arma::mat>(8, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(8, 100);
+
+  // Get a baseline.
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 5, baselineNeighbors, baselineDistances);
+
+  KNNModel model(KNNModel::TreeTypes::OCTREE, false);
+  arma::mat referenceCopy(referenceData);
+  model.AutoTune(timers, std::move(referenceCopy), DUAL_TREE_MODE, 5,
+      0.0 /* epsilon */, 500 /* sampleSize */, 50 /* numProbes */);
+
+  // With epsilon zero, only the exact candidates may be chosen.
+  REQUIRE((model.TreeType() == KNNModel::TreeTypes::KD_TREE ||
+           model.TreeType() == KNNModel::TreeTypes::BALL_TREE));
+  REQUIRE((model.LeafSize() == 10 || model.LeafSize() == 20 ||
+           model.LeafSize() == 50 || model.LeafSize() == 100));
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(queryData);
+  model.Search(timers, std::move(queryCopy), 5, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == baselineNeighbors[i]);
+    REQUIRE(distances[i] == Approx(baselineDistances[i]).epsilon(1e-7));
+  }
+}
+
 TEST_CASE("KNNModelMonochromaticTest", "[KNNTest]")
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -1789,6 +2099,48 @@ TEST_CASE("KNNGreedyTreeSearch", "[KNNTest]")
   REQUIRE(arma::accu(distances < 0.0 || distances > std::sqrt(3.0)) == 0);
 }
 
+/**
+ * Check that the batched greedy traversal gives exactly the same results as
+ * traversing one query point at a time.
+ */
+TEST_CASE("KNNGreedyBatchTraversalTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 300);
+  arma::mat querySet = arma::randu<arma::mat>(3, 50);
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(dataset, 1);
+
+  typedef NeighborSearchRules<NearestNeighborSort, EuclideanDistance, TreeType>
+      RuleType;
+
+  EuclideanDistance metric;
+
+  // Traverse one query point at a time.
+  RuleType scalarRules(tree.Dataset(), querySet, 5, metric);
+  GreedySingleTreeTraverser<TreeType, RuleType> scalarTraverser(scalarRules);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    scalarTraverser.Traverse(i, tree);
+
+  // Traverse the whole query set as one batch.
+  RuleType batchRules(tree.Dataset(), querySet, 5, metric);
+  GreedySingleTreeTraverser<TreeType, RuleType> batchTraverser(batchRules);
+  std::vector<size_t> batch(querySet.n_cols);
+  for (size_t i = 0; i < batch.size(); ++i)
+    batch[i] = i;
+  batchTraverser.Traverse(batch, tree);
+
+  arma::Mat<size_t> scalarNeighbors, batchNeighbors;
+  arma::mat scalarDistances, batchDistances;
+  scalarRules.GetResults(scalarNeighbors, scalarDistances);
+  batchRules.GetResults(batchNeighbors, batchDistances);
+
+  CheckMatrices(scalarNeighbors, batchNeighbors);
+  CheckMatrices(scalarDistances, batchDistances);
+  REQUIRE(scalarTraverser.NumPrunes() == batchTraverser.NumPrunes());
+}
+
 /**
  * Check that no garbage value is returned when greedy tree traversal
  * is performed over spill trees.
@@ -1832,3 +2184,250 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(arma::accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * The const Search() overload must give the same results as the non-const
+ * overload, report its work through the SearchStats object, and leave the
+ * counters on the object untouched.
+ */
+TEST_CASE("KNNConstSearchStatsTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 300);
+  arma::mat queryData = arma::randu<arma::mat>(5, 80);
+
+  KNN knn(referenceData);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 5, neighbors, distances);
+  const size_t baseCases = knn.BaseCases();
+  const size_t scores = knn.Scores();
+
+  const KNN& constKnn = knn;
+  arma::Mat<size_t> constNeighbors;
+  arma::mat constDistances;
+  SearchStats stats;
+  constKnn.Search(queryData, 5, constNeighbors, constDistances, stats);
+
+  CheckMatrices(neighbors, constNeighbors);
+  CheckMatrices(distances, constDistances);
+
+  // The same search does the same work, and the counters on the object must
+  // not move.
+  REQUIRE(stats.baseCases == baseCases);
+  REQUIRE(stats.scores == scores);
+  REQUIRE(knn.BaseCases() == baseCases);
+  REQUIRE(knn.Scores() == scores);
+}
+
+/**
+ * LastSearchStats() must report the full work counters of the last non-const
+ * search: the base case and score counts must match BaseCases() and Scores(),
+ * and the prune count and traversal time must be populated.
+ */
+TEST_CASE("KNNLastSearchStatsTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+
+  KNN knn(referenceData);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 3, neighbors, distances);
+
+  const SearchStats& stats = knn.LastSearchStats();
+  REQUIRE(stats.baseCases == knn.BaseCases());
+  REQUIRE(stats.scores == knn.Scores());
+  // An exact dual-tree search over random data must prune something (else it
+  // would degenerate to brute force).
+  REQUIRE(stats.prunes > 0);
+  REQUIRE(stats.traversalTime.count() >= 0);
+
+  // The monochromatic overload must also fill in the counters.
+  knn.Search(3, neighbors, distances);
+  const SearchStats& monoStats = knn.LastSearchStats();
+  REQUIRE(monoStats.baseCases == knn.BaseCases());
+  REQUIRE(monoStats.scores == knn.Scores());
+  REQUIRE(monoStats.prunes > 0);
+}
+
+/**
+ * The const Search() overload must also agree with the non-const overload
+ * when there are pending incremental updates (inserts and lazy deletes).
+ */
+TEST_CASE("KNNConstSearchPendingUpdatesTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 200);
+  arma::mat queryData = arma::randu<arma::mat>(5, 50);
+
+  KNN knn(referenceData);
+  // Stay below the rebuild threshold so the updates remain pending.
+  knn.Insert(arma::randu<arma::mat>(5, 10));
+  knn.Delete(3);
+  REQUIRE(knn.DeltaSet().n_cols == 10);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 3, neighbors, distances);
+
+  const KNN& constKnn = knn;
+  arma::Mat<size_t> constNeighbors;
+  arma::mat constDistances;
+  SearchStats stats;
+  constKnn.Search(queryData, 3, constNeighbors, constDistances, stats);
+
+  CheckMatrices(neighbors, constNeighbors);
+  CheckMatrices(distances, constDistances);
+}
+
+/**
+ * Many threads may call the const Search() overload on one object at once,
+ * and every thread must get the serial results.
+ */
+TEST_CASE("KNNConcurrentSearchTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+
+  KNN knn(referenceData);
+
+  // Serial baseline.
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 3, baselineNeighbors, baselineDistances);
+
+  const size_t numThreads = 4;
+  std::vector<arma::Mat<size_t>> neighbors(numThreads);
+  std::vector<arma::mat> distances(numThreads);
+  std::vector<SearchStats> stats(numThreads);
+
+  const KNN& constKnn = knn;
+  std::thread threads[numThreads];
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads[t] = std::thread([&, t]()
+        {
+          constKnn.Search(queryData, 3, neighbors[t], distances[t], stats[t]);
+        });
+  }
+  for (size_t t = 0; t < numThreads; ++t)
+    threads[t].join();
+
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    CheckMatrices(baselineNeighbors, neighbors[t]);
+    CheckMatrices(baselineDistances, distances[t]);
+  }
+}
+
+/**
+ * The const NSModel::Search() overload must give the same results as the
+ * timed overload.
+ */
+TEST_CASE("KNNModelConstSearchTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  arma::mat referenceData = arma::randu<arma::mat>(6, 150);
+  arma::mat queryData = arma::randu<arma::mat>(6, 40);
+
+  KNNModel model(KNNModel::TreeTypes::KD_TREE, false);
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(timers, std::move(referenceCopy), DUAL_TREE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(queryData);
+  model.Search(timers, std::move(queryCopy), 3, neighbors, distances);
+
+  const KNNModel& constModel = model;
+  arma::Mat<size_t> constNeighbors;
+  arma::mat constDistances;
+  SearchStats stats;
+  arma::mat secondQueryCopy(queryData);
+  constModel.Search(std::move(secondQueryCopy), 3, constNeighbors,
+      constDistances, stats);
+
+  CheckMatrices(neighbors, constNeighbors);
+  CheckMatrices(distances, constDistances);
+  REQUIRE(stats.baseCases > 0);
+}
+
+/**
+ * Test that a NeighborSearch instantiated with a float32 dataset (so float
+ * tree bounds and float distance computations) finds the same neighbors as
+ * the double-precision naive search.
+ */
+TEST_CASE("KNNFloatPrecisionTest", "[KNNTest]")
+{
+  arma::mat dataset(8, 500, arma::fill::randu);
+  const arma::fmat dataset32 = arma::conv_to<arma::fmat>::from(dataset);
+
+  // The float tree must actually store float bounds.
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::fmat,
+      KDTree> FloatKNN;
+  static_assert(std::is_same<FloatKNN::Tree::ElemType, float>::value,
+      "float tree must have float element type");
+  static_assert(std::is_same<typename std::decay<decltype(
+      std::declval<FloatKNN::Tree>().Bound().MinWidth())>::type, float>::value,
+      "float tree must have float bounds");
+
+  FloatKNN knn32(dataset32);
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighbors32, neighbors;
+  arma::mat distances32, distances;
+  knn32.Search(5, neighbors32, distances32);
+  naive.Search(5, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors32[i] == neighbors[i]);
+    REQUIRE(distances32[i] == Approx(distances[i]).margin(1e-5));
+  }
+}
+
+/**
+ * Test that searching with two-tier low-precision pruning enabled gives
+ * exactly the same results as a plain search: the quantization error bound
+ * makes the prune exact, so only the amount of work changes.
+ */
+TEST_CASE("KNNLowPrecisionPruneTest", "[KNNTest]")
+{
+  arma::mat dataset(8, 1000, arma::fill::randu);
+
+  KNN exact(dataset);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  exact.Search(5, exactNeighbors, exactDistances);
+
+  KNN pruned(dataset);
+  pruned.LowPrecisionPrune() = true;
+  arma::Mat<size_t> prunedNeighbors;
+  arma::mat prunedDistances;
+  pruned.Search(5, prunedNeighbors, prunedDistances);
+
+  for (size_t i = 0; i < exactNeighbors.n_elem; ++i)
+  {
+    REQUIRE(prunedNeighbors[i] == exactNeighbors[i]);
+    REQUIRE(prunedDistances[i] == Approx(exactDistances[i]).epsilon(1e-10));
+  }
+
+  // Also check the bichromatic case, in single-tree mode for variety.
+  arma::mat queryData(8, 200, arma::fill::randu);
+
+  KNN exactSingle(dataset, SINGLE_TREE_MODE);
+  exactSingle.Search(queryData, 5, exactNeighbors, exactDistances);
+
+  KNN prunedSingle(dataset, SINGLE_TREE_MODE);
+  prunedSingle.LowPrecisionPrune() = true;
+  prunedSingle.Search(queryData, 5, prunedNeighbors, prunedDistances);
+
+  for (size_t i = 0; i < exactNeighbors.n_elem; ++i)
+  {
+    REQUIRE(prunedNeighbors[i] == exactNeighbors[i]);
+    REQUIRE(prunedDistances[i] == Approx(exactDistances[i]).epsilon(1e-10));
+  }
+}
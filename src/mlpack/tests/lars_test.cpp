@@ -469,3 +469,32 @@ TEST_CASE("LARSCopyConstructorTest", "[LARSTest]")
   // The output of both models should be the same.
   CheckMatrices(predictions, predictionsFromCopiedModel);
 }
+
+/**
+ * Make sure the Cholesky rank-1 update and downdate functions used by LARS
+ * maintain a valid factorization of the active set's Gram matrix.
+ */
+TEST_CASE("CholeskyUpdateTest", "[LARSTest]")
+{
+  arma::mat X = arma::randu<arma::mat>(50, 10);
+
+  // Insert the features one at a time, checking the factor against a full
+  // factorization of the Gram matrix after each insertion.
+  arma::mat R;
+  for (size_t i = 0; i < X.n_cols; ++i)
+  {
+    mlpack::math::CholeskyInsert(R, X.col(i), X.cols(0, i));
+
+    arma::mat fullR = arma::chol(X.cols(0, i).t() * X.cols(0, i));
+    CheckMatrices(R, fullR);
+  }
+
+  // Now remove a feature from the middle and one from the end.
+  mlpack::math::CholeskyDelete(R, 3);
+  X.shed_col(3);
+  CheckMatrices(R, arma::mat(arma::chol(X.t() * X)));
+
+  mlpack::math::CholeskyDelete(R, X.n_cols - 1);
+  X.shed_col(X.n_cols - 1);
+  CheckMatrices(R, arma::mat(arma::chol(X.t() * X)));
+}
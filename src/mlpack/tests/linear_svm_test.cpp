@@ -14,6 +14,7 @@
 #include <ensmallen.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 using namespace mlpack::svm;
@@ -1196,3 +1197,177 @@ TEST_CASE("LinearSVMCallbackTest", "[LinearSVMTest]")
 
   REQUIRE(cb.calledEndOptimization == true);
 }
+
+/**
+ * The chunked full-batch objective and gradient should agree with the
+ * accumulation of the separable (batch) overloads on a dataset that spans
+ * several chunks.
+ */
+TEST_CASE("LinearSVMFunctionChunkedGradientTest", "[LinearSVMTest]")
+{
+  const size_t points = 10000;
+  const size_t inputSize = 10;
+  const size_t numClasses = 5;
+  const size_t batchSize = 100;
+
+  // Initialize a random dataset.
+  arma::mat data;
+  data.randu(inputSize, points);
+
+  // Create random class labels.
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = math::RandInt(0, numClasses);
+
+  // Create a LinearSVMFunction, Regularization term ignored.
+  LinearSVMFunction<arma::mat> svmf(data, labels, numClasses,
+                                    0.0 /* no regularization */);
+
+  // Create a random set of parameters.
+  arma::mat parameters;
+  parameters.randu(inputSize, numClasses);
+
+  // Accumulate the objective and gradient over all batches.
+  double batchObjective = 0.0;
+  arma::mat batchGradient(arma::size(parameters), arma::fill::zeros);
+  for (size_t begin = 0; begin < points; begin += batchSize)
+  {
+    arma::mat gradient;
+    batchObjective += svmf.EvaluateWithGradient(parameters, begin, gradient,
+        batchSize) * batchSize / points;
+    batchGradient += gradient * batchSize / points;
+  }
+
+  // The full-batch overloads must match the accumulated results.
+  REQUIRE(svmf.Evaluate(parameters) ==
+      Approx(batchObjective).epsilon(1e-7));
+
+  arma::mat gradient;
+  svmf.Gradient(parameters, gradient);
+  CheckMatrices(gradient, batchGradient);
+
+  arma::mat gradient2;
+  const double objective = svmf.EvaluateWithGradient(parameters, gradient2);
+  REQUIRE(objective == Approx(batchObjective).epsilon(1e-7));
+  CheckMatrices(gradient2, batchGradient);
+}
+
+/**
+ * With the shrinking heuristic enabled, points whose hinge loss stays at zero
+ * should be dropped from the active set, without changing the objective or
+ * the gradient of a well-fit model.
+ */
+TEST_CASE("LinearSVMFunctionShrinkingTest", "[LinearSVMTest]")
+{
+  const size_t points = 1000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+  const double lambda = 0.5;
+
+  // Generate a well-separated two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+
+  // Train a model so that most points satisfy the margin.
+  LinearSVM<arma::mat> lsvm(data, labels, numClasses, lambda);
+
+  LinearSVMFunction<arma::mat> svmf(data, labels, numClasses, lambda);
+  svmf.Shrinking() = true;
+
+  arma::mat referenceGradient;
+  const double referenceObjective = svmf.EvaluateWithGradient(
+      lsvm.Parameters(), referenceGradient);
+
+  // Run enough passes for the zero-loss streaks to exceed the patience.
+  for (size_t pass = 0; pass < 4; ++pass)
+  {
+    arma::mat gradient;
+    svmf.EvaluateWithGradient(lsvm.Parameters(), gradient);
+  }
+
+  // Points with persistent zero loss must have been dropped.
+  REQUIRE(svmf.ActiveSetSize() < points);
+  REQUIRE(svmf.ActiveSetSize() > 0);
+
+  // Dropped points contributed nothing, so the objective and gradient over
+  // the shrunken active set are unchanged.
+  arma::mat shrunkGradient;
+  const double shrunkObjective = svmf.EvaluateWithGradient(lsvm.Parameters(),
+      shrunkGradient);
+  REQUIRE(shrunkObjective == Approx(referenceObjective).epsilon(1e-7));
+  CheckMatrices(shrunkGradient, referenceGradient);
+
+  // Restoring the active set brings every point back.
+  svmf.ResetActiveSet();
+  REQUIRE(svmf.ActiveSetSize() == points);
+}
+
+/**
+ * TrainIncremental() should refit an already-trained model from its current
+ * weights on new data, and refuse to run on an untrained model.
+ */
+TEST_CASE("LinearSVMTrainIncrementalTest", "[LinearSVMTest]")
+{
+  const size_t points = 1000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+  const double lambda = 0.5;
+
+  // Generate two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+
+  // Train on the dataset, then refit on a fresh batch of points from the
+  // same distributions.
+  LinearSVM<arma::mat> lsvm(data, labels, numClasses, lambda);
+
+  arma::mat newData(inputSize, points);
+  arma::Row<size_t> newLabels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    newData.col(i) = g1.Random();
+    newLabels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    newData.col(i) = g2.Random();
+    newLabels(i) = 1;
+  }
+
+  lsvm.TrainIncremental(newData, newLabels);
+
+  // The refit model must still classify both batches correctly.
+  REQUIRE(lsvm.ComputeAccuracy(data, labels) >= 0.98);
+  REQUIRE(lsvm.ComputeAccuracy(newData, newLabels) >= 0.98);
+
+  // An untrained model cannot be refit incrementally.
+  LinearSVM<arma::mat> untrained(numClasses, lambda);
+  REQUIRE_THROWS_AS(untrained.TrainIncremental(newData, newLabels),
+      std::invalid_argument);
+}
@@ -13,6 +13,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/load_arff.hpp>
+#include <mlpack/core/data/stream_csv.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -944,6 +945,410 @@ TEST_CASE("LoadArmaBinaryTest", "[LoadSaveTest]")
   remove("test_file.bin");
 }
 
+/**
+ * Make sure the mlpack native binary format round-trips through Save()/Load().
+ */
+TEST_CASE("SaveLoadMlpackBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(10, 500);
+
+  REQUIRE(data::Save("test_file.mlbin", test) == true);
+
+  arma::mat reloaded;
+  REQUIRE(data::Load("test_file.mlbin", reloaded) == true);
+
+  REQUIRE(reloaded.n_rows == 10);
+  REQUIRE(reloaded.n_cols == 500);
+
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(reloaded[i] == Approx(test[i]).epsilon(1e-7));
+
+  remove("test_file.mlbin");
+}
+
+/**
+ * Make sure a compressed mlpack binary file loads back correctly, and that
+ * compression actually shrinks a zero-heavy payload.
+ */
+TEST_CASE("SaveLoadMlpackBinaryCompressedTest", "[LoadSaveTest]")
+{
+  // A mostly-zero matrix, as produced by e.g. one-hot encoding.
+  arma::mat test(50, 200, arma::fill::zeros);
+  test(3, 17) = 1.0;
+  test(21, 98) = 2.0;
+
+  fstream stream("test_file.mlbin", fstream::out | fstream::binary);
+  REQUIRE(data::SaveMlpackBinary(stream, test, true /* compress */) == true);
+  stream.close();
+
+  // The run-length encoded payload must be much smaller than the raw one.
+  stream.open("test_file.mlbin", fstream::in | fstream::binary);
+  stream.seekg(0, ios::end);
+  REQUIRE((size_t) stream.tellg() < test.n_elem * sizeof(double));
+  stream.close();
+
+  arma::mat reloaded;
+  REQUIRE(data::Load("test_file.mlbin", reloaded, false, false) == true);
+
+  REQUIRE(reloaded.n_rows == 50);
+  REQUIRE(reloaded.n_cols == 200);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(reloaded[i] == Approx(test[i]).epsilon(1e-7));
+
+  remove("test_file.mlbin");
+}
+
+/**
+ * Test that Append() grows an mlpack binary file column by column without
+ * disturbing the existing data.
+ */
+TEST_CASE("AppendMlpackBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat first(10, 5, arma::fill::randu);
+  arma::mat second(10, 7, arma::fill::randu);
+  arma::mat third(10, 1, arma::fill::randu);
+
+  // The first call creates the file; the others must extend it.
+  REQUIRE(data::Append("test_file.mlbin", first) == true);
+  REQUIRE(data::Append("test_file.mlbin", second) == true);
+  REQUIRE(data::Append("test_file.mlbin", third) == true);
+
+  arma::mat reloaded;
+  REQUIRE(data::Load("test_file.mlbin", reloaded, false, false) == true);
+
+  arma::mat expected = arma::join_rows(arma::join_rows(first, second), third);
+  REQUIRE(reloaded.n_rows == expected.n_rows);
+  REQUIRE(reloaded.n_cols == expected.n_cols);
+  for (size_t i = 0; i < expected.n_elem; ++i)
+    REQUIRE(reloaded[i] == Approx(expected[i]).epsilon(1e-7));
+
+  // Appending a matrix with the wrong dimensionality must fail.
+  arma::mat bad(9, 2, arma::fill::randu);
+  REQUIRE(data::Append("test_file.mlbin", bad) == false);
+
+  remove("test_file.mlbin");
+}
+
+/**
+ * Test that LoadColumns() pulls the right columns out of an mlpack binary
+ * file.  Since Save() writes the transpose, on-disk columns are dimensions
+ * of the saved matrix, so a partial load must match the corresponding rows
+ * of a full load.
+ */
+TEST_CASE("LoadColumnsMlpackBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(10, 500);
+  REQUIRE(data::Save("test_file.mlbin", test) == true);
+
+  // An index list, deliberately out of order and with a repeat.
+  std::vector<size_t> columns{ 7, 2, 2, 9 };
+  arma::mat partial;
+  REQUIRE(data::LoadColumns("test_file.mlbin", partial, columns) == true);
+
+  REQUIRE(partial.n_rows == columns.size());
+  REQUIRE(partial.n_cols == test.n_cols);
+  for (size_t j = 0; j < columns.size(); ++j)
+    for (size_t i = 0; i < test.n_cols; ++i)
+      REQUIRE(partial(j, i) ==
+          Approx(test(columns[j], i)).epsilon(1e-7));
+
+  // A contiguous range, loaded with a single seek.
+  arma::mat range;
+  REQUIRE(data::LoadColumns("test_file.mlbin", range, (size_t) 3,
+      (size_t) 6) == true);
+
+  REQUIRE(range.n_rows == 4);
+  REQUIRE(range.n_cols == test.n_cols);
+  for (size_t j = 0; j < 4; ++j)
+    for (size_t i = 0; i < test.n_cols; ++i)
+      REQUIRE(range(j, i) == Approx(test(3 + j, i)).epsilon(1e-7));
+
+  // An out-of-range column index must fail.
+  std::vector<size_t> badColumns{ 0, 10 };
+  arma::mat bad;
+  REQUIRE(data::LoadColumns("test_file.mlbin", bad, badColumns) == false);
+
+  remove("test_file.mlbin");
+}
+
+/**
+ * Test that LoadColumns() works on Armadillo binary files.
+ */
+TEST_CASE("LoadColumnsArmaBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(8, 300);
+
+  // Save in the same on-disk orientation that data::Save() uses.
+  arma::mat testTrans = trans(test);
+  REQUIRE(testTrans.quiet_save("test_file.bin", arma::arma_binary) == true);
+
+  arma::mat range;
+  REQUIRE(data::LoadColumns("test_file.bin", range, (size_t) 2,
+      (size_t) 5) == true);
+
+  REQUIRE(range.n_rows == 4);
+  REQUIRE(range.n_cols == test.n_cols);
+  for (size_t j = 0; j < 4; ++j)
+    for (size_t i = 0; i < test.n_cols; ++i)
+      REQUIRE(range(j, i) == Approx(test(2 + j, i)).epsilon(1e-7));
+
+  std::vector<size_t> columns{ 6, 0, 3 };
+  arma::mat partial;
+  REQUIRE(data::LoadColumns("test_file.bin", partial, columns) == true);
+
+  REQUIRE(partial.n_rows == columns.size());
+  REQUIRE(partial.n_cols == test.n_cols);
+  for (size_t j = 0; j < columns.size(); ++j)
+    for (size_t i = 0; i < test.n_cols; ++i)
+      REQUIRE(partial(j, i) ==
+          Approx(test(columns[j], i)).epsilon(1e-7));
+
+  remove("test_file.bin");
+}
+
+/**
+ * Partial loading requires a seekable payload: a run-length encoded mlpack
+ * binary file and a text file must both be refused.
+ */
+TEST_CASE("LoadColumnsNotSeekableTest", "[LoadSaveTest]")
+{
+  // A compressible matrix, saved with the RLE codec.
+  arma::mat test(20, 50, arma::fill::zeros);
+  fstream stream("test_file.mlbin", fstream::out | fstream::binary);
+  REQUIRE(data::SaveMlpackBinary(stream, test, true /* compress */) == true);
+  stream.close();
+
+  arma::mat partial;
+  REQUIRE(data::LoadColumns("test_file.mlbin", partial, (size_t) 0,
+      (size_t) 4) == false);
+  remove("test_file.mlbin");
+
+  // A CSV file has no fixed column stride at all.
+  fstream csvStream("test_file.csv", fstream::out);
+  csvStream << "1, 2, 3" << endl;
+  csvStream << "4, 5, 6" << endl;
+  csvStream.close();
+
+  REQUIRE(data::LoadColumns("test_file.csv", partial, (size_t) 0,
+      (size_t) 1) == false);
+  remove("test_file.csv");
+}
+
+/**
+ * Test that Append() works for Armadillo binary files too, including when the
+ * file was not written with a padded header.
+ */
+TEST_CASE("AppendArmaBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat first(6, 4, arma::fill::randu);
+  arma::mat second(6, 9, arma::fill::randu);
+
+  // Save with arma directly, so the header has no padding and the first
+  // append must rewrite the file.
+  first.save("test_file.bin", arma::arma_binary);
+
+  REQUIRE(data::Append("test_file.bin", second) == true);
+  REQUIRE(data::Append("test_file.bin", second) == true);
+
+  arma::mat reloaded;
+  REQUIRE(data::Load("test_file.bin", reloaded, false, false) == true);
+
+  arma::mat expected = arma::join_rows(arma::join_rows(first, second),
+      second);
+  REQUIRE(reloaded.n_rows == expected.n_rows);
+  REQUIRE(reloaded.n_cols == expected.n_cols);
+  for (size_t i = 0; i < expected.n_elem; ++i)
+    REQUIRE(reloaded[i] == Approx(expected[i]).epsilon(1e-7));
+
+  remove("test_file.bin");
+}
+
+/**
+ * Make sure the parallel chunked CSV parse gives the same result as the
+ * sequential one.
+ */
+TEST_CASE("LoadNumericCSVParallelTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  for (size_t i = 0; i < 100; ++i)
+    f << (4 * i) << ", " << (4 * i + 1) << ", " << (4 * i + 2) << ", "
+        << (4 * i + 3) << endl;
+  f.close();
+
+  // Call the parallel parser directly, since Load() only uses it for files
+  // too large to create in a test.
+  fstream in;
+  in.open("test_file.csv", fstream::in);
+  arma::mat parallel(100, 4, arma::fill::zeros);
+  data::LoadCSV loader;
+  REQUIRE(loader.LoadNumericCSVParallel(parallel, in) == true);
+  in.close();
+
+  arma::mat sequential;
+  REQUIRE(data::Load("test_file.csv", sequential, false, false) == true);
+
+  REQUIRE(parallel.n_rows == sequential.n_rows);
+  REQUIRE(parallel.n_cols == sequential.n_cols);
+  for (size_t i = 0; i < parallel.n_elem; ++i)
+    REQUIRE(parallel[i] == Approx(sequential[i]).epsilon(1e-7));
+
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure arma_binary files can be memory-mapped without a copy.
+ */
+TEST_CASE("MmapLoadArmaBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat test = "1 5;"
+                   "2 6;"
+                   "3 7;"
+                   "4 8;";
+
+  REQUIRE(test.quiet_save("test_file.bin", arma::arma_binary) == true);
+
+  // Now map the file instead of loading it.
+  data::MmapMatrix<double> mapped;
+  REQUIRE(data::MmapLoad("test_file.bin", mapped) == true);
+
+  REQUIRE(mapped.Matrix().n_rows == 4);
+  REQUIRE(mapped.Matrix().n_cols == 2);
+
+  for (size_t i = 0; i < 8; ++i)
+    REQUIRE(mapped.Matrix()[i] == Approx(test[i]).epsilon(1e-7));
+
+  // The mapping is copy-on-write: writes must succeed but never reach disk.
+  mapped.Matrix()(0, 0) = 100.0;
+  REQUIRE(mapped.Matrix()(0, 0) == Approx(100.0).epsilon(1e-7));
+
+  mapped.Clear();
+
+  arma::mat reloaded;
+  REQUIRE(data::Load("test_file.bin", reloaded, false, false) == true);
+  REQUIRE(reloaded(0, 0) == Approx(1.0).epsilon(1e-7));
+
+  // Remove the file.
+  remove("test_file.bin");
+}
+
+/**
+ * Memory-mapping a text file must fail cleanly.
+ */
+TEST_CASE("MmapLoadTextFileTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "1, 2, 3" << endl;
+  f.close();
+
+  data::MmapMatrix<double> mapped;
+  REQUIRE(data::MmapLoad("test_file.csv", mapped) == false);
+
+  remove("test_file.csv");
+}
+
+#ifndef _WIN32
+/**
+ * Make sure a matrix published in shared memory can be attached to, and that
+ * attached writes are copy-on-write.
+ */
+TEST_CASE("SharedDatasetTest", "[LoadSaveTest]")
+{
+  arma::mat test = "1 5;"
+                   "2 6;"
+                   "3 7;"
+                   "4 8;";
+
+  REQUIRE(data::SharedDataset<double>::Publish("mlpack_test_shared", test) ==
+      true);
+
+  data::SharedDataset<double> attached;
+  REQUIRE(attached.Attach("mlpack_test_shared") == true);
+
+  REQUIRE(attached.Matrix().n_rows == 4);
+  REQUIRE(attached.Matrix().n_cols == 2);
+
+  for (size_t i = 0; i < 8; ++i)
+    REQUIRE(attached.Matrix()[i] == Approx(test[i]).epsilon(1e-7));
+
+  // The mapping is copy-on-write: writes must succeed but never be visible
+  // to a fresh attachment.
+  attached.Matrix()(0, 0) = 100.0;
+  REQUIRE(attached.Matrix()(0, 0) == Approx(100.0).epsilon(1e-7));
+
+  data::SharedDataset<double> second;
+  REQUIRE(second.Attach("mlpack_test_shared") == true);
+  REQUIRE(second.Matrix()(0, 0) == Approx(1.0).epsilon(1e-7));
+
+  // Remove the segment; existing attachments stay valid, new ones fail.
+  REQUIRE(data::SharedDataset<double>::Unpublish("mlpack_test_shared") ==
+      true);
+  REQUIRE(attached.Matrix().n_rows == 4);
+
+  data::SharedDataset<double> third;
+  REQUIRE(third.Attach("mlpack_test_shared") == false);
+}
+
+/**
+ * Attaching to a segment published with a different element type must fail
+ * cleanly.
+ */
+TEST_CASE("SharedDatasetWrongTypeTest", "[LoadSaveTest]")
+{
+  arma::mat test(3, 3, arma::fill::randu);
+  REQUIRE(data::SharedDataset<double>::Publish("mlpack_test_shared", test) ==
+      true);
+
+  data::SharedDataset<float> attached;
+  REQUIRE(attached.Attach("mlpack_test_shared") == false);
+
+  REQUIRE(data::SharedDataset<double>::Unpublish("mlpack_test_shared") ==
+      true);
+}
+#endif
+
+/**
+ * Make sure a StreamingDataset yields the full dataset, in order, in batches
+ * of the requested size.
+ */
+TEST_CASE("StreamingDatasetTest", "[LoadSaveTest]")
+{
+  // 10 points in 3 dimensions; a batch size of 4 gives a ragged last batch.
+  arma::mat dataset(3, 10, arma::fill::randu);
+  REQUIRE(dataset.quiet_save("test_file.bin", arma::arma_binary) == true);
+
+  data::StreamingDataset<> stream("test_file.bin", 4);
+  REQUIRE(stream.Rows() == 3);
+  REQUIRE(stream.Cols() == 10);
+  REQUIRE(stream.NumBatches() == 3);
+
+  // Sweep twice to make sure Reset() rewinds correctly.
+  for (size_t sweep = 0; sweep < 2; ++sweep)
+  {
+    stream.Reset();
+    size_t batches = 0;
+    while (stream.NextBatch())
+    {
+      const size_t offset = stream.BatchOffset();
+      REQUIRE(stream.Batch().n_rows == 3);
+      REQUIRE(stream.Batch().n_cols == std::min((size_t) 4, 10 - offset));
+
+      for (size_t i = 0; i < stream.Batch().n_elem; ++i)
+      {
+        REQUIRE(stream.Batch()[i] ==
+            Approx(dataset[offset * 3 + i]).epsilon(1e-7));
+      }
+
+      ++batches;
+    }
+
+    REQUIRE(batches == 3);
+  }
+
+  remove("test_file.bin");
+}
+
 /**
  * Make sure arma_binary is saved correctly.
  */
@@ -1479,6 +1884,64 @@ TEST_CASE("NontransposedCSVDatasetInfoLoad", "[LoadSaveTest]")
   }
 }
 
+/**
+ * Test that a DatasetMapper saved with SaveMappings() can seed a later
+ * categorical load: cached categories keep their mapped values and only new
+ * categories are appended.
+ */
+TEST_CASE("DatasetMapperCacheSeedTest", "[LoadSaveTest]")
+{
+  // The first day's file establishes the category vocabulary.
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, one" << endl;
+  f << "2, two" << endl;
+  f << "3, one" << endl;
+  f.close();
+
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test.csv", matrix, info))
+    FAIL("Cannot load dataset");
+
+  REQUIRE(info.MapString<arma::uword>("one", 1) == 0);
+  REQUIRE(info.MapString<arma::uword>("two", 1) == 1);
+
+  // Cache the mappings, then seed a fresh mapper from the cache.
+  REQUIRE(data::SaveMappings("mappings_cache.bin", info) == true);
+
+  DatasetInfo seeded;
+  REQUIRE(data::LoadMappings("mappings_cache.bin", seeded) == true);
+
+  REQUIRE(seeded.Dimensionality() == 2);
+  REQUIRE(seeded.Type(1) == Datatype::categorical);
+  REQUIRE(seeded.NumMappings(1) == 2);
+
+  // The second day's file shares most of its vocabulary but adds "three";
+  // cached categories must keep their mapped values and "three" must be
+  // appended after them.
+  f.open("test2.csv", fstream::out);
+  f << "4, two" << endl;
+  f << "5, three" << endl;
+  f.close();
+
+  arma::mat matrix2;
+  if (!data::Load("test2.csv", matrix2, seeded))
+    FAIL("Cannot load dataset");
+
+  REQUIRE(matrix2(1, 0) == Approx(1.0).epsilon(1e-7));
+  REQUIRE(matrix2(1, 1) == Approx(2.0).epsilon(1e-7));
+
+  REQUIRE(seeded.NumMappings(1) == 3);
+  REQUIRE(seeded.UnmapString(0, 1) == "one");
+  REQUIRE(seeded.UnmapString(1, 1) == "two");
+  REQUIRE(seeded.UnmapString(2, 1) == "three");
+
+  remove("test.csv");
+  remove("test2.csv");
+  remove("mappings_cache.bin");
+}
+
 /**
  * Create a file with a categorical string feature, then load it.
  */
@@ -1543,6 +2006,48 @@ TEST_CASE("CategoricalCSVLoadTest00", "[LoadSaveTest]")
   remove("test.csv");
 }
 
+/**
+ * A dimension that only turns out to be categorical partway through the file
+ * must have its earlier (numeric-looking) tokens mapped too.  This exercises
+ * the post-pass remap of the single-pass parser.
+ */
+TEST_CASE("CategoricalCSVMidFileFlipTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, 2" << endl;
+  f << "3, 4" << endl;
+  f << "5, cheese" << endl;
+  f << "7, 4" << endl;
+  f.close();
+
+  arma::umat matrix;
+  DatasetInfo info;
+  if (!data::Load("test.csv", matrix, info))
+    FAIL("Cannot load dataset");
+
+  REQUIRE(matrix.n_cols == 4);
+  REQUIRE(matrix.n_rows == 2);
+
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+
+  REQUIRE(matrix(0, 0) == 1);
+  REQUIRE(matrix(0, 1) == 3);
+  REQUIRE(matrix(0, 2) == 5);
+  REQUIRE(matrix(0, 3) == 7);
+
+  // In the categorical dimension the ids follow first-encounter order, and
+  // the repeated "4" maps to the same id both times.
+  REQUIRE(matrix(1, 0) == info.MapString<arma::uword>("2", 1));
+  REQUIRE(matrix(1, 1) == info.MapString<arma::uword>("4", 1));
+  REQUIRE(matrix(1, 2) == info.MapString<arma::uword>("cheese", 1));
+  REQUIRE(matrix(1, 3) == matrix(1, 1));
+  REQUIRE(info.NumMappings(1) == 3);
+
+  remove("test.csv");
+}
+
 TEST_CASE("CategoricalCSVLoadTest01", "[LoadSaveTest]")
 {
   fstream f;
@@ -2311,6 +2816,74 @@ TEST_CASE("CategoryCaseTest", "[LoadSaveTest]")
   remove("test.arff");
 }
 
+/**
+ * An ARFF file where every categorical dimension pre-declares its categories
+ * can be parsed in parallel; make sure the mappings still follow the
+ * declaration order and that an undeclared category is still an error.
+ */
+TEST_CASE("ARFFDeclaredCategoriesTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute one {A, B, C}" << endl;
+  f << "@attribute two numeric" << endl;
+  f << "@attribute three {x, y}" << endl;
+  f << "@data" << endl;
+  f << "B, 1.5, y" << endl;
+  f << "A, -2, x" << endl;
+  f << "C, 3e2, y" << endl;
+  f << "A, 4, x" << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  if (!data::Load("test.arff", dataset, info))
+    FAIL("Cannot load dataset");
+
+  REQUIRE(info.Dimensionality() == 3);
+  REQUIRE(info.Type(0) == Datatype::categorical);
+  REQUIRE(info.NumMappings(0) == 3);
+  REQUIRE(info.Type(1) == Datatype::numeric);
+  REQUIRE(info.Type(2) == Datatype::categorical);
+  REQUIRE(info.NumMappings(2) == 2);
+
+  REQUIRE(dataset.n_rows == 3);
+  REQUIRE(dataset.n_cols == 4);
+
+  // The categories were mapped in declaration order, not encounter order.
+  REQUIRE(dataset(0, 0) == Approx(1.0).epsilon(1e-7)); // "B"
+  REQUIRE(dataset(0, 1) == Approx(0.0).epsilon(1e-7)); // "A"
+  REQUIRE(dataset(0, 2) == Approx(2.0).epsilon(1e-7)); // "C"
+  REQUIRE(dataset(0, 3) == Approx(0.0).epsilon(1e-7)); // "A"
+
+  REQUIRE(dataset(1, 0) == Approx(1.5).epsilon(1e-7));
+  REQUIRE(dataset(1, 1) == Approx(-2.0).epsilon(1e-7));
+  REQUIRE(dataset(1, 2) == Approx(3e2).epsilon(1e-7));
+  REQUIRE(dataset(1, 3) == Approx(4.0).epsilon(1e-7));
+
+  REQUIRE(dataset(2, 0) == Approx(1.0).epsilon(1e-7)); // "y"
+  REQUIRE(dataset(2, 1) == Approx(0.0).epsilon(1e-7)); // "x"
+
+  // Now an undeclared category must still cause a failure.
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute one {A, B, C}" << endl;
+  f << "@attribute two numeric" << endl;
+  f << "@data" << endl;
+  f << "A, 1" << endl;
+  f << "D, 2" << endl;
+  f.close();
+
+  DatasetInfo info2;
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(data::Load("test.arff", dataset, info2, true),
+      std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  remove("test.arff");
+}
+
 /**
  * Test that a CSV with the wrong number of columns fails.
  */
@@ -2504,3 +3077,57 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * The streaming CSV reader must yield the points of the stream in order,
+ * chunk by chunk, and handle empty lines, CRLF endings, and a final partial
+ * chunk.
+ */
+TEST_CASE("StreamingCSVReaderTest", "[LoadSaveTest]")
+{
+  std::stringstream stream;
+  stream << "1,2,3\r\n";
+  stream << "\n";
+  stream << "4,5,6\n";
+  stream << "7,8,9\n";
+  stream << "10,11,12\n";
+  stream << "13,14,15";
+
+  data::StreamingCSVReader reader(stream, 2);
+  arma::mat chunk;
+
+  REQUIRE(reader.ReadChunk(chunk) == true);
+  REQUIRE(reader.Dimensionality() == 3);
+  REQUIRE(chunk.n_rows == 3);
+  REQUIRE(chunk.n_cols == 2);
+  REQUIRE(chunk(0, 0) == Approx(1.0));
+  REQUIRE(chunk(2, 1) == Approx(6.0));
+
+  REQUIRE(reader.ReadChunk(chunk) == true);
+  REQUIRE(chunk.n_cols == 2);
+  REQUIRE(chunk(0, 0) == Approx(7.0));
+  REQUIRE(chunk(1, 1) == Approx(11.0));
+
+  // The last chunk is partial.
+  REQUIRE(reader.ReadChunk(chunk) == true);
+  REQUIRE(chunk.n_cols == 1);
+  REQUIRE(chunk(2, 0) == Approx(15.0));
+
+  REQUIRE(reader.ReadChunk(chunk) == false);
+}
+
+/**
+ * The streaming CSV reader must throw on unparseable values and on rows
+ * whose length does not match the first row's.
+ */
+TEST_CASE("StreamingCSVReaderMalformedTest", "[LoadSaveTest]")
+{
+  std::stringstream bad("1,2\n3,oops\n");
+  data::StreamingCSVReader badReader(bad);
+  arma::mat chunk;
+  REQUIRE_THROWS_AS(badReader.ReadChunk(chunk), std::runtime_error);
+
+  std::stringstream ragged("1,2\n3,4,5\n");
+  data::StreamingCSVReader raggedReader(ragged);
+  REQUIRE_THROWS_AS(raggedReader.ReadChunk(chunk), std::runtime_error);
+}
@@ -15,6 +15,7 @@
 #include <ensmallen.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 using namespace mlpack::regression;
@@ -1081,3 +1082,198 @@ TEST_CASE("IncrementalTraining", "[LogisticRegressionTest]")
 
   REQUIRE(acc == Approx(100.0).epsilon(0.03)); // 3% error tolerance.
 }
+
+/**
+ * Test that streaming training over an out-of-core dataset gives a good model.
+ */
+TEST_CASE("LogisticRegressionStreamingTrainTest", "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  // Interleave the classes so every batch sees both.
+  arma::uvec ordering = arma::shuffle(
+      arma::linspace<arma::uvec>(0, 999, 1000));
+  data = data.cols(ordering);
+  responses = responses.cols(ordering);
+
+  // Write the dataset to disk and stream it back in batches of 100.
+  REQUIRE(data.quiet_save("lr_stream_test.bin", arma::arma_binary) == true);
+  data::StreamingDataset<> stream("lr_stream_test.bin", 100);
+
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  lr.Train(stream, responses, 20 /* epochs */, 0.001 /* step size */);
+
+  // Ensure that the error is close to zero.
+  const double acc = lr.ComputeAccuracy(data, responses);
+
+  REQUIRE(acc == Approx(100.0).epsilon(0.03)); // 3% error tolerance.
+
+  remove("lr_stream_test.bin");
+}
+
+/**
+ * The chunked full-batch objective and gradient should agree with the
+ * accumulation of the separable (batch) overloads on a dataset that spans
+ * several chunks.
+ */
+TEST_CASE("LogisticRegressionFunctionChunkedGradientTest",
+          "[LogisticRegressionTest]")
+{
+  const size_t points = 10000;
+  const size_t dimension = 10;
+  const size_t batchSize = 100;
+
+  arma::mat data = arma::randu<arma::mat>(dimension, points);
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points; ++i)
+    responses[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<> lrf(data, responses, 0.5);
+
+  const arma::rowvec parameters = arma::randu<arma::rowvec>(dimension + 1);
+
+  // Accumulate the objective and gradient over all batches.
+  double batchObjective = 0.0;
+  arma::mat batchGradient(arma::size(parameters), arma::fill::zeros);
+  for (size_t begin = 0; begin < points; begin += batchSize)
+  {
+    arma::mat gradient;
+    batchObjective += lrf.EvaluateWithGradient(parameters, begin, gradient,
+        batchSize);
+    batchGradient += gradient;
+  }
+
+  // The full-batch overloads must match the accumulated results.
+  REQUIRE(lrf.Evaluate(parameters) == Approx(batchObjective).epsilon(1e-7));
+
+  arma::mat gradient;
+  lrf.Gradient(parameters, gradient);
+  CheckMatrices(gradient, batchGradient);
+
+  arma::mat gradient2;
+  const double objective = lrf.EvaluateWithGradient(parameters, gradient2);
+  REQUIRE(objective == Approx(batchObjective).epsilon(1e-7));
+  CheckMatrices(gradient2, batchGradient);
+}
+
+/**
+ * TrainIncremental() should refit an already-trained model from its current
+ * weights on new data, and refuse to run on an untrained model.
+ */
+TEST_CASE("LogisticRegressionTrainIncrementalTest", "[LogisticRegressionTest]")
+{
+  const size_t points = 1000;
+
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, points);
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses(i) = 1;
+  }
+
+  // Train on the dataset, then refit on a fresh batch of points from the
+  // same distributions.
+  LogisticRegression<> lr(data, responses, 0.5);
+
+  arma::mat newData(3, points);
+  arma::Row<size_t> newResponses(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    newData.col(i) = g1.Random();
+    newResponses(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    newData.col(i) = g2.Random();
+    newResponses(i) = 1;
+  }
+
+  lr.TrainIncremental(newData, newResponses);
+
+  // The refit model must still classify both batches correctly.
+  REQUIRE(lr.ComputeAccuracy(data, responses) == Approx(100.0).epsilon(0.03));
+  REQUIRE(lr.ComputeAccuracy(newData, newResponses) ==
+      Approx(100.0).epsilon(0.03));
+
+  // An untrained model cannot be refit incrementally.
+  LogisticRegression<> untrained(10 /* different dimensionality */, 0.5);
+  REQUIRE_THROWS_AS(untrained.TrainIncremental(newData, newResponses),
+      std::invalid_argument);
+}
+
+/**
+ * Test that Merge() produces the sample-count weighted average of shard
+ * models, and that dimension mismatches are rejected.
+ */
+TEST_CASE("LogisticRegressionMergeTest", "[LogisticRegressionTest]")
+{
+  const size_t points = 1000;
+
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, points);
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses(i) = 1;
+  }
+
+  // Train one model per shard; give the second shard three times the points.
+  const size_t split = points / 4;
+  LogisticRegression<> lrShard1(data.cols(0, split - 1),
+      responses.subvec(0, split - 1), 0.5);
+  LogisticRegression<> lrShard2(data.cols(split, points - 1),
+      responses.subvec(split, points - 1), 0.5);
+
+  // The expected result is the sample-count weighted parameter average.
+  const arma::rowvec expected = (split * lrShard1.Parameters() +
+      (points - split) * lrShard2.Parameters()) / points;
+
+  lrShard1.Merge(lrShard2, double(points - split) / double(split));
+
+  REQUIRE(lrShard1.Parameters().n_elem == expected.n_elem);
+  for (size_t i = 0; i < expected.n_elem; ++i)
+    REQUIRE(lrShard1.Parameters()[i] == Approx(expected[i]).epsilon(1e-10));
+
+  // The merged model must still classify the full dataset well.
+  REQUIRE(lrShard1.ComputeAccuracy(data, responses) >= 90.0);
+
+  // Merging models of different dimensionality must fail, and so must a
+  // negative weight.
+  LogisticRegression<> wrongShape(10, 0.5);
+  REQUIRE_THROWS_AS(lrShard1.Merge(wrongShape), std::invalid_argument);
+  REQUIRE_THROWS_AS(lrShard1.Merge(lrShard2, -1.0), std::invalid_argument);
+}
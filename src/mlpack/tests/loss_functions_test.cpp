@@ -1276,3 +1276,63 @@ TEST_CASE("NegativeLogLikelihoodLossTest", "[LossFunctionsTest]")
   REQUIRE(output.n_cols == input.n_cols);
   CheckMatrices(output, expectedOutput, 0.1);
 }
+
+/**
+ * Check that the fused EvaluateWithGradient() of the common loss functions
+ * gives the same loss and gradient as separate Forward() and Backward() calls,
+ * for both reduction types.
+ */
+TEST_CASE("FusedEvaluateWithGradientTest", "[LossFunctionsTest]")
+{
+  arma::mat input, target, output, fusedOutput;
+  double loss, fusedLoss;
+
+  // Negative log likelihood: the input holds log-probabilities and the target
+  // holds class indices.
+  input = arma::randu(5, 8);
+  input.each_row() /= arma::sum(input);
+  input = arma::log(input);
+  target = arma::floor(5 * arma::randu(1, 8));
+
+  NegativeLogLikelihood nll;
+  for (const bool reduction : { true, false })
+  {
+    nll.Reduction() = reduction;
+    loss = nll.Forward(input, target);
+    nll.Backward(input, target, output);
+    fusedLoss = nll.EvaluateWithGradient(input, target, fusedOutput);
+    REQUIRE(fusedLoss == Approx(loss).epsilon(1e-10));
+    CheckMatrices(output, fusedOutput, 1e-10);
+  }
+
+  // Mean squared error.
+  input = arma::randu(5, 8);
+  target = arma::randu(5, 8);
+
+  MeanSquaredError mse;
+  for (const bool reduction : { true, false })
+  {
+    mse.Reduction() = reduction;
+    loss = mse.Forward(input, target);
+    mse.Backward(input, target, output);
+    fusedLoss = mse.EvaluateWithGradient(input, target, fusedOutput);
+    REQUIRE(fusedLoss == Approx(loss).epsilon(1e-10));
+    CheckMatrices(output, fusedOutput, 1e-10);
+  }
+
+  // Binary cross-entropy: the input holds probabilities and the target holds
+  // 0/1 labels.
+  input = arma::randu(5, 8);
+  target = arma::round(arma::randu(5, 8));
+
+  BCELoss bce;
+  for (const bool reduction : { true, false })
+  {
+    bce.Reduction() = reduction;
+    loss = bce.Forward(input, target);
+    bce.Backward(input, target, output);
+    fusedLoss = bce.EvaluateWithGradient(input, target, fusedOutput);
+    REQUIRE(fusedLoss == Approx(loss).epsilon(1e-10));
+    CheckMatrices(output, fusedOutput, 1e-10);
+  }
+}
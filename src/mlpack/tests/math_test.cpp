@@ -9,6 +9,7 @@
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#include <mlpack/core/math/batch_cholesky.hpp>
 #include <mlpack/core/math/clamp.hpp>
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/core/math/range.hpp>
@@ -1006,3 +1007,108 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * BatchCholesky() must agree with arma::chol() on every slice, both below and
+ * above the small-kernel dimension limit.
+ */
+TEST_CASE("BatchCholeskyTest", "[MathTest]")
+{
+  const size_t dims[2] = { 10, 80 };
+  for (size_t d : dims)
+  {
+    arma::cube matrices(d, d, 25);
+    for (size_t s = 0; s < matrices.n_slices; ++s)
+    {
+      arma::mat a = arma::randu<arma::mat>(d, d);
+      matrices.slice(s) = a * a.t() + d * arma::eye<arma::mat>(d, d);
+    }
+
+    arma::cube lowers;
+    REQUIRE(BatchCholesky(matrices, lowers) == true);
+
+    for (size_t s = 0; s < matrices.n_slices; ++s)
+    {
+      arma::mat expected;
+      REQUIRE(arma::chol(expected, matrices.slice(s), "lower") == true);
+      REQUIRE(arma::approx_equal(arma::mat(lowers.slice(s)), expected,
+          "absdiff", 1e-8) == true);
+    }
+  }
+}
+
+/**
+ * BatchCholesky() must report failure when any slice is not positive
+ * definite.
+ */
+TEST_CASE("BatchCholeskyNonSPDTest", "[MathTest]")
+{
+  arma::cube matrices(5, 5, 3);
+  for (size_t s = 0; s < matrices.n_slices; ++s)
+    matrices.slice(s) = arma::eye<arma::mat>(5, 5);
+  matrices(4, 4, 1) = -1.0; // Slice 1 is not positive definite.
+
+  arma::cube lowers;
+  REQUIRE(BatchCholesky(matrices, lowers) == false);
+}
+
+/**
+ * BatchCholeskyInverse() must produce the inverse and log-determinant of each
+ * original matrix.
+ */
+TEST_CASE("BatchCholeskyInverseTest", "[MathTest]")
+{
+  arma::cube matrices(12, 12, 10);
+  for (size_t s = 0; s < matrices.n_slices; ++s)
+  {
+    arma::mat a = arma::randu<arma::mat>(12, 12);
+    matrices.slice(s) = a * a.t() + 12 * arma::eye<arma::mat>(12, 12);
+  }
+
+  arma::cube lowers, inverses;
+  arma::vec logDets;
+  REQUIRE(BatchCholesky(matrices, lowers) == true);
+  BatchCholeskyInverse(lowers, inverses, logDets);
+
+  for (size_t s = 0; s < matrices.n_slices; ++s)
+  {
+    const arma::mat product = arma::mat(matrices.slice(s)) *
+        arma::mat(inverses.slice(s));
+    REQUIRE(arma::approx_equal(product, arma::eye<arma::mat>(12, 12),
+        "absdiff", 1e-8) == true);
+
+    double logDet, sign;
+    arma::log_det(logDet, sign, arma::mat(matrices.slice(s)));
+    REQUIRE(logDets[s] == Approx(logDet).epsilon(1e-8));
+  }
+}
+
+/**
+ * BatchSolveSPD() must agree with arma::solve() on every system, both below
+ * and above the small-kernel dimension limit.
+ */
+TEST_CASE("BatchSolveSPDTest", "[MathTest]")
+{
+  const size_t dims[2] = { 10, 80 };
+  for (size_t d : dims)
+  {
+    arma::cube matrices(d, d, 25);
+    arma::mat rhs = arma::randu<arma::mat>(d, 25);
+    for (size_t s = 0; s < matrices.n_slices; ++s)
+    {
+      arma::mat a = arma::randu<arma::mat>(d, d);
+      matrices.slice(s) = a * a.t() + d * arma::eye<arma::mat>(d, d);
+    }
+
+    arma::mat solutions;
+    BatchSolveSPD(matrices, rhs, solutions);
+
+    for (size_t s = 0; s < matrices.n_slices; ++s)
+    {
+      const arma::vec expected = arma::solve(arma::mat(matrices.slice(s)),
+          arma::vec(rhs.col(s)));
+      REQUIRE(arma::approx_equal(arma::vec(solutions.col(s)), expected,
+          "absdiff", 1e-8) == true);
+    }
+  }
+}
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/matrix_completion/matrix_completion.hpp>
+#include <mlpack/methods/matrix_completion/alternating_matrix_completion.hpp>
 
 #include "catch.hpp"
 
@@ -60,3 +61,55 @@ TEST_CASE("UniformMatrixCompletionSDP", "[MatrixCompletionTest]")
        Approx(Xorig(indices(0, i), indices(1, i))).epsilon(1e-7));
   }
 }
+
+/**
+ * A matrix completion test for the alternating-minimization solver.
+ *
+ * A random rank-5 matrix is generated and a random subset of its entries is
+ * observed; the solver should recover the remaining entries to good accuracy.
+ */
+TEST_CASE("UniformMatrixCompletionALS", "[MatrixCompletionTest]")
+{
+  const size_t m = 100;
+  const size_t n = 100;
+  const size_t rank = 5;
+  const size_t numObserved = 6000;
+
+  // Generate a random low rank matrix.
+  arma::mat f1 = arma::randu(m, rank);
+  arma::mat f2 = arma::randu(rank, n);
+  arma::mat Xorig = f1 * f2;
+
+  // Sample entries without replacement.
+  arma::uvec sampled = arma::randperm(m * n, numObserved);
+  arma::umat indices(2, numObserved);
+  arma::vec values(numObserved);
+  for (size_t i = 0; i < numObserved; ++i)
+  {
+    indices(0, i) = sampled(i) % m;
+    indices(1, i) = sampled(i) / m;
+    values(i) = Xorig(indices(0, i), indices(1, i));
+  }
+
+  arma::mat recovered;
+  AlternatingMatrixCompletion amc(m, n, indices, values, rank, 200, 1e-8,
+      1e-10);
+  amc.Recover(recovered);
+
+  // Check the factor sizes.
+  REQUIRE(amc.W().n_rows == m);
+  REQUIRE(amc.W().n_cols == rank);
+  REQUIRE(amc.H().n_rows == rank);
+  REQUIRE(amc.H().n_cols == n);
+
+  const double err =
+    arma::norm(Xorig - recovered, "fro") /
+    arma::norm(Xorig, "fro");
+  REQUIRE(err == Approx(0.0).margin(1e-2));
+
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    REQUIRE(recovered(indices(0, i), indices(1, i)) ==
+       Approx(Xorig(indices(0, i), indices(1, i))).margin(1e-2));
+  }
+}
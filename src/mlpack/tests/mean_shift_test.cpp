@@ -162,3 +162,30 @@ TEST_CASE("GaussianClustering", "[MeanShiftTest]")
 
   REQUIRE(success == true);
 }
+
+/**
+ * Ensure that clustering against a prebuilt range searcher gives the same
+ * result as the overload that builds its own tree.
+ */
+TEST_CASE("MeanShiftPrebuiltSearcherTest", "[MeanShiftTest]")
+{
+  arma::mat dataset = trans(meanShiftData);
+
+  MeanShift<> meanShift;
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  meanShift.Cluster(dataset, assignments, centroids);
+
+  range::RangeSearch<> rangeSearcher(dataset);
+  MeanShift<> prebuiltMeanShift;
+  arma::Row<size_t> prebuiltAssignments;
+  arma::mat prebuiltCentroids;
+  prebuiltMeanShift.Cluster(dataset, prebuiltAssignments, prebuiltCentroids,
+      rangeSearcher);
+
+  REQUIRE(prebuiltCentroids.n_cols == centroids.n_cols);
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    REQUIRE(prebuiltCentroids[i] == Approx(centroids[i]).epsilon(1e-10));
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(prebuiltAssignments[i] == assignments[i]);
+}
@@ -14,6 +14,7 @@
 #include <mlpack/core/metrics/iou_metric.hpp>
 #include <mlpack/core/metrics/non_maximal_supression.hpp>
 #include <mlpack/core/metrics/bleu.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 #include "test_catch_tools.hpp"
 
 using namespace std;
@@ -358,3 +359,68 @@ TEST_CASE("BLEUScoreTest", "[MetricTest]")
         Approx(expectedPrecision[i]).epsilon(1e-4));
   }
 }
+
+/**
+ * The bulk pairwise distance computation must agree with per-pair metric
+ * evaluation, both for the generic path and for the GEMM-based L2 path.
+ */
+TEST_CASE("PairwiseDistancesTest", "[MetricTest]")
+{
+  arma::mat references = arma::randu<arma::mat>(8, 75);
+  arma::mat queries = arma::randu<arma::mat>(8, 40);
+
+  // The generic per-pair path.
+  ManhattanDistance manhattan;
+  arma::mat distances;
+  PairwiseDistances(references, queries, distances, manhattan);
+
+  REQUIRE(distances.n_rows == references.n_cols);
+  REQUIRE(distances.n_cols == queries.n_cols);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+    for (size_t j = 0; j < references.n_cols; ++j)
+      REQUIRE(distances(j, i) == Approx(manhattan.Evaluate(references.col(j),
+          queries.col(i))).epsilon(1e-7));
+
+  // The GEMM-based path for the Euclidean and squared Euclidean distances.
+  EuclideanDistance euclidean;
+  PairwiseDistances(references, queries, distances, euclidean);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+    for (size_t j = 0; j < references.n_cols; ++j)
+      REQUIRE(distances(j, i) == Approx(euclidean.Evaluate(references.col(j),
+          queries.col(i))).margin(1e-10));
+
+  SquaredEuclideanDistance squared;
+  PairwiseDistances(references, queries, distances, squared);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+    for (size_t j = 0; j < references.n_cols; ++j)
+      REQUIRE(distances(j, i) == Approx(squared.Evaluate(references.col(j),
+          queries.col(i))).margin(1e-10));
+
+  // Subviews must work as inputs, and the results must land in the right
+  // columns.
+  arma::mat blockDistances;
+  PairwiseDistances(references, queries.cols(10, 19), blockDistances,
+      euclidean);
+  REQUIRE(blockDistances.n_cols == 10);
+  for (size_t i = 0; i < 10; ++i)
+    for (size_t j = 0; j < references.n_cols; ++j)
+      REQUIRE(blockDistances(j, i) == Approx(euclidean.Evaluate(
+          references.col(j), queries.col(10 + i))).margin(1e-10));
+
+  // The low-precision path trades accuracy for speed; make sure it stays
+  // within single precision of the exact results.
+  arma::mat lowPrecisionDistances;
+  PairwiseDistances(references, queries, lowPrecisionDistances, euclidean,
+      true);
+  PairwiseDistances(references, queries, distances, euclidean);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+    for (size_t j = 0; j < references.n_cols; ++j)
+      REQUIRE(lowPrecisionDistances(j, i) ==
+          Approx(distances(j, i)).margin(1e-4));
+
+  // Mismatched dimensionalities must be rejected.
+  arma::mat badQueries = arma::randu<arma::mat>(5, 10);
+  REQUIRE_THROWS_AS(
+      PairwiseDistances(references, badQueries, distances, euclidean),
+      std::invalid_argument);
+}
@@ -398,3 +398,99 @@ TEST_CASE("NaiveBayesClassifierHighDimensionsTest", "[NBCTest]")
   for (size_t i = 0; i < calcVec.n_cols; ++i)
     REQUIRE(calcVec(i) == testLabels(i));
 }
+
+/**
+ * TrainParallel() should produce the same model as the batch Train()
+ * algorithm.
+ */
+TEST_CASE("NaiveBayesTrainParallelTest", "[NBCTest]")
+{
+  const size_t points = 5000;
+  const size_t dimension = 8;
+  const size_t classes = 3;
+
+  arma::mat data = arma::randu<arma::mat>(dimension, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels[i] = math::RandInt(0, classes);
+
+  NaiveBayesClassifier<> nbcBatch(data, labels, classes, false);
+
+  NaiveBayesClassifier<> nbcParallel(dimension, classes);
+  nbcParallel.TrainParallel(data, labels, classes);
+
+  for (size_t i = 0; i < classes; ++i)
+  {
+    REQUIRE(nbcBatch.Probabilities()[i] ==
+        Approx(nbcParallel.Probabilities()[i]).epsilon(1e-10));
+    for (size_t j = 0; j < dimension; ++j)
+    {
+      REQUIRE(nbcBatch.Means()(j, i) ==
+          Approx(nbcParallel.Means()(j, i)).epsilon(1e-10));
+      REQUIRE(nbcBatch.Variances()(j, i) ==
+          Approx(nbcParallel.Variances()(j, i)).epsilon(1e-7));
+    }
+  }
+
+  // Training on two successive batches must match training on the
+  // concatenation.
+  NaiveBayesClassifier<> nbcTwoBatches(dimension, classes);
+  nbcTwoBatches.TrainParallel(data.cols(0, points / 2 - 1),
+      labels.subvec(0, points / 2 - 1), classes);
+  nbcTwoBatches.TrainParallel(data.cols(points / 2, points - 1),
+      labels.subvec(points / 2, points - 1), classes);
+
+  for (size_t i = 0; i < classes; ++i)
+  {
+    for (size_t j = 0; j < dimension; ++j)
+    {
+      REQUIRE(nbcBatch.Means()(j, i) ==
+          Approx(nbcTwoBatches.Means()(j, i)).epsilon(1e-10));
+      REQUIRE(nbcBatch.Variances()(j, i) ==
+          Approx(nbcTwoBatches.Variances()(j, i)).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Merging classifiers trained on different shards should match a classifier
+ * trained on the full dataset.
+ */
+TEST_CASE("NaiveBayesMergeTest", "[NBCTest]")
+{
+  const size_t points = 5000;
+  const size_t dimension = 8;
+  const size_t classes = 3;
+
+  arma::mat data = arma::randu<arma::mat>(dimension, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels[i] = math::RandInt(0, classes);
+
+  NaiveBayesClassifier<> nbcFull(data, labels, classes, false);
+
+  // Train one classifier per shard and merge them.
+  NaiveBayesClassifier<> nbcShard1(data.cols(0, points / 2 - 1),
+      labels.subvec(0, points / 2 - 1), classes, false);
+  NaiveBayesClassifier<> nbcShard2(data.cols(points / 2, points - 1),
+      labels.subvec(points / 2, points - 1), classes, false);
+
+  nbcShard1.Merge(nbcShard2);
+
+  for (size_t i = 0; i < classes; ++i)
+  {
+    REQUIRE(nbcFull.Probabilities()[i] ==
+        Approx(nbcShard1.Probabilities()[i]).epsilon(1e-10));
+    for (size_t j = 0; j < dimension; ++j)
+    {
+      REQUIRE(nbcFull.Means()(j, i) ==
+          Approx(nbcShard1.Means()(j, i)).epsilon(1e-10));
+      REQUIRE(nbcFull.Variances()(j, i) ==
+          Approx(nbcShard1.Variances()(j, i)).epsilon(1e-7));
+    }
+  }
+
+  // Merging models of different shapes must fail.
+  NaiveBayesClassifier<> wrongShape(dimension + 1, classes);
+  REQUIRE_THROWS_AS(nbcShard1.Merge(wrongShape), std::invalid_argument);
+}
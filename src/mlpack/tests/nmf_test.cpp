@@ -16,6 +16,8 @@
 #include <mlpack/methods/amf/update_rules/nmf_mult_div.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
+#include <mlpack/methods/amf/update_rules/parallel_sgd.hpp>
+#include <mlpack/methods/amf/termination_policies/max_iteration_termination.hpp>
 
 #include "catch.hpp"
 
@@ -304,3 +306,65 @@ TEST_CASE("NonNegNMFALSTest", "[NMFTest]")
   REQUIRE((arma::all(arma::vectorise(w) >= 0)
       && arma::all(arma::vectorise(h) >= 0)));
 }
+
+/**
+ * Check that block-stratified parallel SGD can factorize a dense low-rank
+ * matrix with low reconstruction error on the observed (nonzero) entries.
+ */
+TEST_CASE("ParallelSGDFactorizationTest", "[NMFTest]")
+{
+  mat w = randu<mat>(20, 12);
+  mat h = randu<mat>(12, 20);
+  mat v = w * h;
+  const size_t r = 12;
+
+  MaxIterationTermination mit(500);
+  ParallelSGDUpdate sgd(0.01 /* stepSize */, 0.0 /* lambda */);
+  AMF<MaxIterationTermination, RandomInitialization, ParallelSGDUpdate>
+      amf(mit, RandomInitialization(), sgd);
+  amf.Apply(v, r, w, h);
+
+  mat wh = w * h;
+
+  // Make sure reconstruction error is not too high.  5.0% tolerance.
+  REQUIRE(arma::norm(v - wh, "fro") / arma::norm(v, "fro") ==
+      Approx(0.0).margin(0.05));
+}
+
+/**
+ * Check that parallel SGD treats zeros as unobserved: on a sparse matrix, the
+ * reconstruction should be accurate on the nonzero entries.
+ */
+TEST_CASE("SparseParallelSGDFactorizationTest", "[NMFTest]")
+{
+  // Generate a sparse low-rank matrix by masking a dense one.
+  mat w = randu<mat>(30, 8);
+  mat h = randu<mat>(8, 30);
+  mat dense = w * h;
+  sp_mat v(30, 30);
+  for (size_t i = 0; i < v.n_elem; ++i)
+    if (math::Random() < 0.35)
+      v(i) = dense(i);
+
+  const size_t r = 8;
+
+  MaxIterationTermination mit(1000);
+  ParallelSGDUpdate sgd(0.01 /* stepSize */, 0.0 /* lambda */);
+  AMF<MaxIterationTermination, RandomInitialization, ParallelSGDUpdate>
+      amf(mit, RandomInitialization(), sgd);
+  amf.Apply(v, r, w, h);
+
+  const mat wh = w * h;
+
+  // Measure the error over the observed entries only.
+  double num = 0.0;
+  double denom = 0.0;
+  for (sp_mat::const_iterator it = v.begin(); it != v.end(); ++it)
+  {
+    num += std::pow(*it - wh(it.row(), it.col()), 2.0);
+    denom += std::pow(*it, 2.0);
+  }
+
+  // Make sure reconstruction error is not too high.  10.0% tolerance.
+  REQUIRE(std::sqrt(num / denom) == Approx(0.0).margin(0.10));
+}
@@ -346,3 +346,94 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+/**
+ * Check that two trees have the same structure, node for node.
+ */
+template<typename TreeType>
+void CheckSameStructure(TreeType& node1, TreeType& node2)
+{
+  CheckSameNode(node1, node2);
+  for (size_t i = 0; i < node1.NumChildren(); ++i)
+    CheckSameStructure(node1.Child(i), node2.Child(i));
+}
+
+/**
+ * Count the points held in the leaves of the tree.
+ */
+template<typename TreeType>
+size_t CountPoints(TreeType& node)
+{
+  if (node.NumChildren() == 0)
+    return node.NumPoints();
+
+  size_t total = 0;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    total += CountPoints(node.Child(i));
+  return total;
+}
+
+/**
+ * The Morton-code build must produce the same hierarchy as the recursive
+ * build.
+ */
+TEST_CASE("MortonBuildStructureTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 500, arma::fill::randu);
+
+  Octree<> t1(dataset, 10);
+  Octree<> t2(dataset, 10, true);
+
+  CheckSameStructure(t1, t2);
+}
+
+/**
+ * Check that the mappings filled by the Morton-code build are correct.
+ */
+TEST_CASE("MortonBuildMappingsTest", "[OctreeTest]")
+{
+  // Test with both constructors.
+  arma::mat dataset(3, 300, arma::fill::randu);
+  arma::mat datacopy(dataset);
+  std::vector<size_t> oldFromNewCopy, oldFromNewMove, newFromOldCopy,
+      newFromOldMove;
+
+  Octree<> t1(dataset, oldFromNewCopy, newFromOldCopy, 10, true);
+  Octree<> t2(std::move(dataset), oldFromNewMove, newFromOldMove, 10, true);
+
+  for (size_t i = 0; i < oldFromNewCopy.size(); ++i)
+  {
+    REQUIRE(arma::norm(datacopy.col(oldFromNewCopy[i]) -
+        t1.Dataset().col(i)) == Approx(0.0).margin(1e-3));
+    REQUIRE(arma::norm(datacopy.col(oldFromNewMove[i]) -
+        t2.Dataset().col(i)) == Approx(0.0).margin(1e-3));
+
+    REQUIRE(newFromOldCopy[oldFromNewCopy[i]] == i);
+    REQUIRE(newFromOldMove[oldFromNewMove[i]] == i);
+  }
+}
+
+/**
+ * The Morton-code build must terminate even when more than maxLeafSize points
+ * share a grid cell; those points end up in one oversized leaf.
+ */
+TEST_CASE("MortonBuildDuplicatePointsTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 100, arma::fill::randu);
+  for (size_t i = 1; i < 30; ++i)
+    dataset.col(i) = dataset.col(0);
+
+  Octree<> t(dataset, 10, true);
+
+  REQUIRE(t.NumDescendants() == 100);
+  REQUIRE(CountPoints(t) == 100);
+
+  // If every point is identical, the root must be a leaf.
+  arma::mat identical(3, 50);
+  identical.each_col() = arma::vec("0.5 0.5 0.5");
+
+  Octree<> t2(identical, 10, true);
+
+  REQUIRE(t2.NumChildren() == 0);
+  REQUIRE(t2.NumPoints() == 50);
+}
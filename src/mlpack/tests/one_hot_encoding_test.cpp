@@ -172,6 +172,49 @@ TEST_CASE("OneHotEncodingVeryBigInputTest", "[OneHotEncodingTest]")
     REQUIRE(matrix.at(i) == output.at(i));
 }
 
+/**
+ * Test that the sparse output overload agrees with the dense overload.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  // Build a random dataset with two categorical dimensions; include zeros in
+  // the numeric dimensions to check that they are not stored as explicit
+  // nonzeros.
+  arma::mat input(5, 100, arma::fill::randu);
+  input.row(1) = arma::floor(input.row(1) * 10);
+  input.row(3) = arma::floor(input.row(3) * 4);
+  input(0, 0) = 0.0;
+  input(2, 5) = 0.0;
+
+  arma::Col<size_t> indices("1 3");
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(input, indices, denseOutput);
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == denseOutput.n_rows);
+  REQUIRE(sparseOutput.n_cols == denseOutput.n_cols);
+  REQUIRE(sparseOutput.n_nonzero == arma::accu(denseOutput != 0.0));
+  for (size_t i = 0; i < denseOutput.n_elem; ++i)
+    REQUIRE(sparseOutput.at(i) == Approx(denseOutput.at(i)).margin(1e-15));
+}
+
+/**
+ * Test the sparse output overload with no dimensions to encode.
+ */
+TEST_CASE("OneHotEncodingSparseOutputNoIndicesTest", "[OneHotEncodingTest]")
+{
+  arma::mat input(4, 20, arma::fill::randu);
+  arma::Col<size_t> indices;
+  arma::sp_mat output;
+  data::OneHotEncoding(input, indices, output);
+
+  REQUIRE(output.n_rows == input.n_rows);
+  REQUIRE(output.n_cols == input.n_cols);
+  for (size_t i = 0; i < input.n_elem; ++i)
+    REQUIRE(output.at(i) == Approx(input.at(i)).margin(1e-15));
+}
+
 /**
  * Test one hot encoding using DatasetInfo object.
  */
@@ -12,6 +12,8 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/pca/pca.hpp>
+#include <mlpack/methods/pca/incremental_pca.hpp>
+#include <mlpack/methods/pca/decomposition_policies/cosine_tree_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/exact_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
@@ -278,6 +280,48 @@ TEST_CASE("QUICPCADimensionalityReductionTest", "[PCATest]")
   REQUIRE(data.n_cols == data1.n_cols);
 }
 
+/**
+ * Test that dimensionality reduction with cosine tree PCA works about the
+ * same way as the Exact-SVD PCA method.
+ */
+TEST_CASE("CosineTreePCADimensionalityReductionTest", "[PCATest]")
+{
+  arma::mat data, data1;
+  if (!data::Load("test_data_3_1000.csv", data))
+    FAIL("Cannot load dataset test_data_3_1000.csv");
+  data1 = data;
+
+  arma::mat backupData(data);
+
+  // The cosine tree construction is randomized, so just like the QUIC-SVD
+  // test above, accept a success in any of five trials.
+  size_t successes = 0;
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    if (trial > 0)
+    {
+      data = backupData;
+      data1 = backupData;
+    }
+
+    PCA<ExactSVDPolicy> exactPCA;
+    const double varRetainedExact = exactPCA.Apply(data, 1);
+
+    PCA<CosineTreePolicy> cosinePCA;
+    const double varRetainedCosine = cosinePCA.Apply(data1, 1);
+
+    if (std::abs(varRetainedExact - varRetainedCosine) < 0.2)
+    {
+      ++successes;
+      break;
+    }
+  }
+
+  REQUIRE(successes >= 1);
+  REQUIRE(data.n_rows == data1.n_rows);
+  REQUIRE(data.n_cols == data1.n_cols);
+}
+
 /**
  * Test that setting the variance retained parameter to perform dimensionality
  * reduction works using the exact svd PCA method.
@@ -336,3 +380,108 @@ TEST_CASE("PCAScalingTest", "[PCATest]")
   // The eigenvalues should sum to three.
   REQUIRE(accu(eigval) == Approx(3.0).epsilon(0.001));
 }
+
+/**
+ * Incremental PCA over column batches should agree with exact PCA when the
+ * sketch is large enough to hold the whole spectrum.
+ */
+TEST_CASE("IncrementalPCABatchAgreementTest", "[PCATest]")
+{
+  // Low-rank data plus a little noise, 5 dimensions.
+  arma::mat data = arma::randn<arma::mat>(5, 2) *
+      arma::randn<arma::mat>(2, 600) + 0.01 * arma::randn<arma::mat>(5, 600);
+
+  // Exact PCA eigenvalues of the centered data.
+  arma::mat coeff, score;
+  arma::vec exactEigVal;
+  princomp(coeff, score, exactEigVal, arma::trans(data));
+
+  // Sketch the data in uneven batches; a sketch with as many rows as the
+  // data has dimensions is exact.
+  IncrementalPCA ipca(5, 6);
+  ipca.Add(data.cols(0, 99));
+  ipca.Add(data.cols(100, 399));
+  ipca.Add(data.cols(400, 599));
+
+  REQUIRE(ipca.NumPoints() == 600);
+
+  arma::vec eigVal;
+  arma::mat eigvec;
+  ipca.Eigendecompose(eigVal, eigvec);
+
+  for (size_t i = 0; i < eigVal.n_elem; ++i)
+    REQUIRE(eigVal(i) == Approx(exactEigVal(i)).margin(1e-8));
+
+  // The projections should match up to the sign of each component.
+  arma::mat transformed;
+  ipca.Apply(data, transformed);
+  for (size_t i = 0; i < transformed.n_rows; ++i)
+  {
+    const double corr = arma::as_scalar(
+        transformed.row(i) * score.col(i)) /
+        (arma::norm(transformed.row(i), 2) * arma::norm(score.col(i), 2));
+    REQUIRE(std::abs(corr) == Approx(1.0).margin(1e-6));
+  }
+}
+
+/**
+ * Merging two sketches built over shards of the data should give the same
+ * result as sketching all of the data in one object.
+ */
+TEST_CASE("IncrementalPCAMergeTest", "[PCATest]")
+{
+  arma::mat data = arma::randn<arma::mat>(8, 3) *
+      arma::randn<arma::mat>(3, 1000) + 0.01 * arma::randn<arma::mat>(8, 1000);
+
+  IncrementalPCA full(3, 8);
+  full.Add(data);
+
+  IncrementalPCA left(3, 8), right(3, 8);
+  left.Add(data.cols(0, 499));
+  right.Add(data.cols(500, 999));
+  left.Merge(right);
+
+  REQUIRE(left.NumPoints() == full.NumPoints());
+
+  arma::vec fullEigVal, mergedEigVal;
+  arma::mat fullEigvec, mergedEigvec;
+  full.Eigendecompose(fullEigVal, fullEigvec);
+  left.Eigendecompose(mergedEigVal, mergedEigvec);
+
+  // With a sketch covering the full dimensionality, both summaries are
+  // exact, so the eigenvalues must agree.
+  for (size_t i = 0; i < fullEigVal.n_elem; ++i)
+    REQUIRE(mergedEigVal(i) == Approx(fullEigVal(i)).margin(1e-8));
+
+  // Mismatched configurations must be rejected.
+  IncrementalPCA other(4, 8);
+  REQUIRE_THROWS_AS(left.Merge(other), std::invalid_argument);
+}
+
+/**
+ * With a sketch smaller than the dimensionality, the leading eigenvalues of
+ * low-rank data should still be recovered well.
+ */
+TEST_CASE("IncrementalPCASketchApproximationTest", "[PCATest]")
+{
+  arma::mat data = arma::randn<arma::mat>(50, 4) *
+      arma::randn<arma::mat>(4, 2000) +
+      0.001 * arma::randn<arma::mat>(50, 2000);
+
+  arma::mat coeff, score;
+  arma::vec exactEigVal;
+  princomp(coeff, score, exactEigVal, arma::trans(data));
+
+  IncrementalPCA ipca(4, 12);
+  for (size_t begin = 0; begin < data.n_cols; begin += 250)
+    ipca.Add(data.cols(begin, begin + 249));
+
+  arma::vec eigVal;
+  arma::mat eigvec;
+  ipca.Eigendecompose(eigVal, eigvec);
+
+  // The data is essentially rank 4, so the top eigenvalues should be close
+  // in relative terms.
+  for (size_t i = 0; i < 4; ++i)
+    REQUIRE(eigVal(i) == Approx(exactEigVal(i)).epsilon(0.05));
+}
@@ -590,3 +590,87 @@ TEST_CASE("SACForMultipleActions", "[QLearningTest]")
   // If the agent is able to reach till this point of the test, it is assured
   // that the agent can handle multiple actions in continuous space.
 }
+
+//! Test the vectorized environment wrapper on the Cart Pole task.
+TEST_CASE("VectorizedEnvCartPole", "[QLearningTest]")
+{
+  const size_t numEnvs = 5;
+  VectorizedEnv<CartPole> vecEnv(numEnvs);
+
+  arma::mat encodedStates;
+  vecEnv.InitialSample(encodedStates);
+
+  REQUIRE(encodedStates.n_rows == 4);
+  REQUIRE(encodedStates.n_cols == numEnvs);
+  REQUIRE(vecEnv.NumEnvs() == numEnvs);
+
+  // Step the environments a number of times with fixed actions; finished
+  // instances must auto-reset, so the current states must never be terminal.
+  for (size_t step = 0; step < 50; ++step)
+  {
+    std::vector<CartPole::Action> actions(numEnvs);
+    for (size_t i = 0; i < numEnvs; ++i)
+      actions[i].action = CartPole::Action::actions::backward;
+
+    std::vector<CartPole::State> nextStates;
+    arma::rowvec rewards;
+    arma::irowvec isTerminal;
+    vecEnv.Sample(actions, nextStates, rewards, isTerminal);
+
+    REQUIRE(nextStates.size() == numEnvs);
+    REQUIRE(rewards.n_elem == numEnvs);
+    REQUIRE(isTerminal.n_elem == numEnvs);
+
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      REQUIRE(vecEnv.Environment(i).IsTerminal(vecEnv.States()[i]) == false);
+      // If the instance did not finish, its current state is the next state.
+      if (!isTerminal(i))
+      {
+        REQUIRE(arma::approx_equal(vecEnv.States()[i].Encode(),
+            nextStates[i].Encode(), "absdiff", 1e-12));
+      }
+    }
+
+    vecEnv.EncodeStates(encodedStates);
+    REQUIRE(encodedStates.n_cols == numEnvs);
+  }
+}
+
+//! Test that the vectorized episode runs, stores experience and trains.
+TEST_CASE("CartPoleVectorizedEpisode", "[QLearningTest]")
+{
+  // Set up the network.
+  SimpleDQN<> network(64, 64, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 50;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  for (size_t episode = 0; episode < 5; ++episode)
+  {
+    const double meanReturn = agent.VectorizedEpisode(4);
+
+    // Cart Pole rewards one point per step survived.
+    REQUIRE(meanReturn >= 1.0);
+  }
+
+  // Each vectorized episode steps at least one transition in each of the
+  // four environments.
+  REQUIRE(agent.TotalSteps() >= 20);
+
+  // The regular single-environment episode must still work afterwards.
+  const double episodeReturn = agent.Episode();
+  REQUIRE(episodeReturn >= 1.0);
+}
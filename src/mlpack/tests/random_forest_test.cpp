@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/random_forest/random_forest.hpp>
+#include <mlpack/methods/random_forest/flat_random_forest.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 
 #include "serialization.hpp"
@@ -609,3 +610,131 @@ TEST_CASE("ExtraTreesAccuracyTest", "[RandomForestTest]")
 
   REQUIRE(accuracy >= 0.91);
 }
+
+/**
+ * A flattened forest should produce exactly the same predictions and
+ * probabilities as the forest it was built from.
+ */
+TEST_CASE("FlatRandomForestTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  data::DatasetInfo info;
+  MockCategoricalData(dataset, labels, info);
+
+  RandomForest<> rf(dataset, info, labels, 5, 15 /* 15 trees */, 5);
+  FlatRandomForest flatRf(rf);
+
+  REQUIRE(flatRf.NumTrees() == rf.NumTrees());
+  REQUIRE(flatRf.NumClasses() == 5);
+
+  arma::Row<size_t> rfPredictions, flatPredictions;
+  arma::mat rfProbabilities, flatProbabilities;
+  rf.Classify(dataset, rfPredictions, rfProbabilities);
+  flatRf.Classify(dataset, flatPredictions, flatProbabilities);
+
+  REQUIRE(arma::accu(rfPredictions == flatPredictions) == dataset.n_cols);
+  CheckMatrices(rfProbabilities, flatProbabilities);
+}
+
+/**
+ * A flat forest that has not been built should throw on Classify().
+ */
+TEST_CASE("FlatRandomForestUnbuiltTest", "[RandomForestTest]")
+{
+  FlatRandomForest flatRf;
+
+  arma::mat points(10, 100, arma::fill::randu);
+  arma::Row<size_t> predictions;
+  REQUIRE_THROWS_AS(flatRf.Classify(points, predictions),
+      std::invalid_argument);
+}
+
+/**
+ * The out-of-bag error should be computed during training, lie in [0, 1], and
+ * be small on an easy dataset.
+ */
+TEST_CASE("OOBErrorTest", "[RandomForestTest]")
+{
+  // Two well-separated Gaussian classes.
+  arma::mat dataset(5, 1000, arma::fill::randn);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    dataset.col(i) += 4.0;
+    labels[i] = 1;
+  }
+  labels.head(500).fill(0);
+
+  RandomForest<> rf(dataset, labels, 2, 20 /* 20 trees */, 5);
+
+  REQUIRE(rf.OOBError() >= 0.0);
+  REQUIRE(rf.OOBError() <= 1.0);
+  // The classes are separable, so the out-of-bag error should be tiny.
+  REQUIRE(rf.OOBError() < 0.1);
+}
+
+/**
+ * The out-of-bag error should keep accumulating votes across warm-start
+ * training calls, and adding trees to an easy problem should not make it
+ * collapse.
+ */
+TEST_CASE("OOBErrorWarmStartTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  data::DatasetInfo info;
+  MockCategoricalData(dataset, labels, info);
+
+  RandomForest<> rf(dataset, info, labels, 5, 10 /* 10 trees */, 5);
+  const double oobBefore = rf.OOBError();
+  REQUIRE(oobBefore >= 0.0);
+  REQUIRE(oobBefore <= 1.0);
+
+  // Add 40 more trees on top of the existing forest.
+  rf.Train(dataset, info, labels, 5, 40, 5, 1e-7, 0, true /* warmStart */);
+  REQUIRE(rf.NumTrees() == 50);
+
+  const double oobAfter = rf.OOBError();
+  REQUIRE(oobAfter >= 0.0);
+  REQUIRE(oobAfter <= 1.0);
+  // A 5x larger forest should not be dramatically worse out-of-bag.
+  REQUIRE(oobAfter <= oobBefore + 0.1);
+}
+
+/**
+ * Test that Merge() concatenates the trees of two forests and that the
+ * combined forest still classifies well.
+ */
+TEST_CASE("RandomForestMergeTest", "[RandomForestTest]")
+{
+  // Two well-separated Gaussian classes.
+  arma::mat dataset(5, 1000, arma::fill::randn);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    dataset.col(i) += 4.0;
+    labels[i] = 1;
+  }
+  labels.head(500).fill(0);
+
+  // Interleave the points so each shard sees both classes.
+  arma::uvec shard1 = arma::regspace<arma::uvec>(0, 2, 999);
+  arma::uvec shard2 = arma::regspace<arma::uvec>(1, 2, 999);
+
+  RandomForest<> rf1(dataset.cols(shard1),
+      arma::Row<size_t>(labels.cols(shard1)), 2, 10 /* 10 trees */, 5);
+  RandomForest<> rf2(dataset.cols(shard2),
+      arma::Row<size_t>(labels.cols(shard2)), 2, 15 /* 15 trees */, 5);
+
+  rf1.Merge(rf2);
+
+  REQUIRE(rf1.NumTrees() == 25);
+  REQUIRE(rf1.OOBError() >= 0.0);
+  REQUIRE(rf1.OOBError() <= 1.0);
+
+  // The merged forest should classify the full dataset nearly perfectly.
+  arma::Row<size_t> predictions;
+  rf1.Classify(dataset, predictions);
+  REQUIRE(arma::accu(predictions == labels) >= 950);
+}
@@ -12,6 +12,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/randomized_svd/randomized_svd.hpp>
+#include <mlpack/methods/randomized_svd/streaming_randomized_svd.hpp>
 
 #include "catch.hpp"
 
@@ -60,3 +61,67 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * The streaming (single-pass) method should recover an exactly low-rank
+ * matrix from its column blocks almost exactly.
+ */
+TEST_CASE("StreamingRandomizedSVDReconstructionError",
+          "[RandomizedSVDTest]")
+{
+  // Create an exactly rank-3 matrix.
+  arma::mat U = arma::randn<arma::mat>(60, 3);
+  arma::mat V = arma::randn<arma::mat>(50, 3);
+  arma::mat data = U * arma::diagmat(arma::vec("1 0.1 0.01")) * V.t();
+
+  arma::mat U1, V1;
+  arma::vec s1;
+
+  // Use a small block size so that several blocks are consumed.
+  svd::StreamingRandomizedSVD sSVD(10, 7);
+  sSVD.Apply(data, U1, s1, V1, 3);
+
+  REQUIRE(U1.n_cols == 3);
+  REQUIRE(s1.n_elem == 3);
+  REQUIRE(V1.n_cols == 3);
+
+  const arma::mat reconstruct = U1 * arma::diagmat(s1) * V1.t();
+
+  // The relative reconstruction error should be small.
+  const double error = arma::norm(data - reconstruct, "frob") /
+      arma::norm(data, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+}
+
+/**
+ * The block-function interface should only ever be asked for each column
+ * range once, in order, so the producer can stream from out-of-core storage.
+ */
+TEST_CASE("StreamingRandomizedSVDBlockFunctionTest", "[RandomizedSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(40, 5);
+  arma::mat V = arma::randn<arma::mat>(33, 5);
+  arma::mat data = U * V.t();
+
+  arma::mat U1, V1;
+  arma::vec s1;
+
+  size_t expectedBegin = 0;
+  svd::StreamingRandomizedSVD sSVD(10, 8);
+  sSVD.Apply(data.n_rows, data.n_cols,
+      [&](const size_t begin, arma::mat& block)
+      {
+        // Each block is requested exactly once, in order.
+        REQUIRE(begin == expectedBegin);
+        expectedBegin += block.n_cols;
+        block = data.cols(begin, begin + block.n_cols - 1);
+      },
+      U1, s1, V1, 5);
+
+  REQUIRE(expectedBegin == data.n_cols);
+
+  const arma::mat reconstruct = U1 * arma::diagmat(s1) * V1.t();
+  const double error = arma::norm(data - reconstruct, "frob") /
+      arma::norm(data, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+}
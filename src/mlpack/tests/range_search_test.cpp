@@ -1718,3 +1718,107 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+/**
+ * Make sure the streaming callback overload of bichromatic Search() reports
+ * exactly the same result pairs as the materialized overload, in every search
+ * mode.
+ */
+TEST_CASE("CallbackSearchTest", "[RangeSearchTest]")
+{
+  arma::mat data;
+  data.randu(3, 300);
+  arma::mat queries;
+  queries.randu(3, 60);
+
+  const Range range(0.25, 0.6);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearch<> rs(data, (mode == 0) /* naive */, (mode == 1) /* single */);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queries, range, neighbors, distances);
+
+    // Collect the streamed results.  Concurrent invocations of the callback
+    // never share a query index, so per-query vectors need no locking.
+    vector<vector<size_t>> streamedNeighbors(queries.n_cols);
+    vector<vector<double>> streamedDistances(queries.n_cols);
+    auto callback = [&](const size_t queryIndex,
+                        const size_t referenceIndex,
+                        const double distance)
+    {
+      streamedNeighbors[queryIndex].push_back(referenceIndex);
+      streamedDistances[queryIndex].push_back(distance);
+    };
+    rs.Search(queries, range, callback);
+
+    vector<vector<pair<double, size_t>>> sorted;
+    vector<vector<pair<double, size_t>>> streamedSorted;
+    SortResults(neighbors, distances, sorted);
+    SortResults(streamedNeighbors, streamedDistances, streamedSorted);
+
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      REQUIRE(streamedSorted[i].size() == sorted[i].size());
+      for (size_t j = 0; j < sorted[i].size(); ++j)
+      {
+        REQUIRE(streamedSorted[i][j].second == sorted[i][j].second);
+        REQUIRE(streamedSorted[i][j].first ==
+            Approx(sorted[i][j].first).epsilon(1e-7));
+      }
+    }
+  }
+}
+
+/**
+ * Make sure the streaming callback overload of monochromatic Search() reports
+ * exactly the same result pairs as the materialized overload, in every search
+ * mode.
+ */
+TEST_CASE("CallbackMonochromaticSearchTest", "[RangeSearchTest]")
+{
+  arma::mat data;
+  data.randu(3, 300);
+
+  const Range range(0.25, 0.6);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearch<> rs(data, (mode == 0) /* naive */, (mode == 1) /* single */);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(range, neighbors, distances);
+
+    // Collect the streamed results.  Concurrent invocations of the callback
+    // never share a query index, so per-query vectors need no locking.
+    vector<vector<size_t>> streamedNeighbors(data.n_cols);
+    vector<vector<double>> streamedDistances(data.n_cols);
+    auto callback = [&](const size_t queryIndex,
+                        const size_t referenceIndex,
+                        const double distance)
+    {
+      streamedNeighbors[queryIndex].push_back(referenceIndex);
+      streamedDistances[queryIndex].push_back(distance);
+    };
+    rs.Search(range, callback);
+
+    vector<vector<pair<double, size_t>>> sorted;
+    vector<vector<pair<double, size_t>>> streamedSorted;
+    SortResults(neighbors, distances, sorted);
+    SortResults(streamedNeighbors, streamedDistances, streamedSorted);
+
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      REQUIRE(streamedSorted[i].size() == sorted[i].size());
+      for (size_t j = 0; j < sorted[i].size(); ++j)
+      {
+        REQUIRE(streamedSorted[i][j].second == sorted[i][j].second);
+        REQUIRE(streamedSorted[i][j].first ==
+            Approx(sorted[i][j].first).epsilon(1e-7));
+      }
+    }
+  }
+}
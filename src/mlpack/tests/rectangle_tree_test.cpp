@@ -1359,3 +1359,85 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * A function to check that every point in the dataset is stored in exactly one
+ * leaf of the tree.
+ */
+template<typename TreeType>
+void CollectPointCounts(const TreeType& tree, arma::Col<size_t>& counts)
+{
+  if (tree.IsLeaf())
+  {
+    for (size_t i = 0; i < tree.Count(); ++i)
+      counts[tree.Point(i)]++;
+  }
+  else
+  {
+    for (size_t i = 0; i < tree.NumChildren(); ++i)
+      CollectPointCounts(tree.Child(i), counts);
+  }
+}
+
+// Test that a bulk-loaded (STR-packed) tree satisfies all of the rectangle
+// tree invariants and holds every point exactly once.
+TEST_CASE("RectangleTreeBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  TreeType tree(dataset, 20, 6, 5, 2, 0, true);
+
+  REQUIRE(tree.NumDescendants() == 1000);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+  CheckFills(tree);
+
+  // Every leaf must be on the same level.
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+  REQUIRE(tree.TreeDepth() == GetMinLevel(tree));
+
+  // Every point must be stored in exactly one leaf.
+  arma::Col<size_t> counts(1000, arma::fill::zeros);
+  CollectPointCounts(tree, counts);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == 1);
+}
+
+// Test that search with a bulk-loaded tree gives the same results as naive
+// search.
+TEST_CASE("RectangleTreeBulkLoadSearchTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+
+  typedef RStarTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType rTree(dataset, 20, 6, 5, 2, 0, true);
+
+  // Nearest neighbor search with the bulk-loaded R* tree.
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      RStarTree> knn1(std::move(rTree), SINGLE_TREE_MODE);
+
+  knn1.Search(5, neighbors1, distances1);
+
+  // Nearest neighbor search the naive way.
+  KNN knn2(dataset, NAIVE_MODE);
+
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+    REQUIRE(distances1[i] == distances2[i]);
+  }
+}
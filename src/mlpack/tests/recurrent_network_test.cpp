@@ -622,6 +622,69 @@ TEST_CASE("MultiTimestepTest", "[RecurrentNetworkTest]")
   REQUIRE(err <= 0.025);
 }
 
+/**
+ * Test streaming window training: feed long sine sequences to TrainWindow()
+ * in fixed-size windows, carrying hidden state between windows, and check
+ * that the objective improves from the first pass over the stream to the
+ * last.
+ */
+TEST_CASE("RNNTrainWindowTest", "[RecurrentNetworkTest]")
+{
+  const size_t hiddenUnits = 8;
+  const size_t numSeqs = 8;
+  const size_t windowSteps = 10;
+  const size_t numWindows = 10;
+  const size_t totalSteps = windowSteps * numWindows;
+
+  // Generate a few phase-shifted sines; the response at each step is the next
+  // value of the sine, which cannot be predicted from the current value alone
+  // (rising and falling flanks look the same), so the recurrent state matters.
+  arma::cube data(1, numSeqs, totalSteps);
+  arma::cube labels(1, numSeqs, totalSteps);
+  for (size_t c = 0; c < numSeqs; ++c)
+  {
+    const double phase = 2.0 * M_PI * c / numSeqs;
+    for (size_t t = 0; t < totalSteps; ++t)
+    {
+      data(0, c, t) = std::sin(0.5 * t + phase);
+      labels(0, c, t) = std::sin(0.5 * (t + 1) + phase);
+    }
+  }
+
+  RNN<MeanSquaredError> net(windowSteps);
+  net.Add<LinearNoBias>(hiddenUnits);
+  net.Add<LSTM>(hiddenUnits);
+  net.Add<LinearNoBias>(1);
+
+  // The carried state is stored per-sequence, so all sequences must fit into
+  // one batch; use the same optimizer object for every window so that its
+  // state carries across windows too.
+  RMSProp opt(0.003, numSeqs, 0.9, 1e-08, 5 * numSeqs /* 5 epochs */, -1.0);
+
+  const size_t numPasses = 5;
+  arma::vec passObjectives(numPasses);
+  for (size_t pass = 0; pass < numPasses; ++pass)
+  {
+    // Each pass starts the stream over from the beginning.
+    net.ResetStreamingState();
+
+    double objective = 0.0;
+    for (size_t w = 0; w < numWindows; ++w)
+    {
+      const double windowObjective = net.TrainWindow(
+          data.slices(w * windowSteps, (w + 1) * windowSteps - 1),
+          labels.slices(w * windowSteps, (w + 1) * windowSteps - 1), opt);
+      REQUIRE(std::isfinite(windowObjective));
+      objective += windowObjective;
+    }
+
+    passObjectives[pass] = objective;
+  }
+
+  // After several passes over the stream the objective must have improved.
+  REQUIRE(passObjectives[numPasses - 1] < passObjectives[0]);
+}
+
 /**
  * Test that RNN::Train() returns finite objective value.
  *
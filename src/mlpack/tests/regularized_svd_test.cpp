@@ -315,3 +315,66 @@ TEST_CASE("RegularizedSVDFunctionOptimizeHOGWILD", "[RegularizedSVDTest]")
 }
 
 #endif
+
+// Test the warm-started Apply() overload, which reuses a previous
+// factorization as the starting point and trains with sharded parallel SGD.
+TEST_CASE("RegularizedSVDApplyWarmStartTest", "[RegularizedSVDTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 100;
+  const size_t iterations = 30;
+  const size_t rank = 10;
+  const double alpha = 0.01;
+  const double lambda = 0.01;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank, numUsers + numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    data(2, i) = arma::dot(parameters.col(data(0, i)),
+                           parameters.col(numUsers + data(1, i)));
+  }
+
+  // First fit: no usable factors yet, so this falls back to random
+  // initialization.
+  RegularizedSVD<> rSVD(iterations, alpha, lambda);
+  arma::mat u, v;
+  rSVD.Apply(data, rank, u, v, false);
+
+  // Check the size of outputs.
+  REQUIRE(u.n_rows == numItems);
+  REQUIRE(u.n_cols == rank);
+  REQUIRE(v.n_rows == rank);
+  REQUIRE(v.n_cols == numUsers);
+
+  // Refit starting from the factors of the first fit.
+  rSVD.Apply(data, rank, u, v, true);
+
+  // Get predicted ratings from the refit factors.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    predictedData(0, i) = arma::dot(v.col(data(0, i)),
+                                    u.row(data(1, i)).t());
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
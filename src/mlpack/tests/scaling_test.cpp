@@ -15,6 +15,7 @@
 #include <mlpack/core/data/scaler_methods/max_abs_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/standard_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/mean_normalization.hpp>
+#include <mlpack/core/data/scaler_methods/cached_scaler.hpp>
 
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
@@ -172,3 +173,133 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Test that CachedScaler gives the same results as the wrapped scaler and
+ * serves repeated transforms of the same view from its cache.
+ */
+TEST_CASE("CachedScalerTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(3, 100);
+
+  CachedScaler<StandardScaler> cached;
+  cached.Fit(input);
+  StandardScaler plain;
+  plain.Fit(input);
+
+  // An alias view of the first 40 points, with a stable memory pointer (the
+  // same kind of view that KFoldCV hands out for its folds).
+  arma::mat fold(input.memptr(), input.n_rows, 40, false, true);
+
+  arma::mat expected;
+  plain.Transform(fold, expected);
+  const arma::mat& first = cached.Transform(fold);
+  CheckMatrices(first, expected);
+  REQUIRE(cached.CacheSize() == 1);
+
+  // A repeated transform of the same view must be served from the cache.
+  const arma::mat& second = cached.Transform(fold);
+  REQUIRE(&first == &second);
+  REQUIRE(cached.CacheSize() == 1);
+
+  // The output-parameter overload should agree as well.
+  arma::mat output;
+  cached.Transform(fold, output);
+  CheckMatrices(output, expected);
+
+  // Refitting discards the cache, so transforms reflect the new fit.
+  arma::mat doubled = 2.0 * input;
+  cached.Fit(doubled);
+  REQUIRE(cached.CacheSize() == 0);
+  plain.Fit(doubled);
+  plain.Transform(fold, expected);
+  CheckMatrices(cached.Transform(fold), expected);
+
+  // Inverse transforms pass through to the wrapped scaler.
+  arma::mat restored;
+  cached.InverseTransform(cached.Transform(fold), restored);
+  CheckMatrices(restored, fold);
+}
+
+/**
+ * Test that incremental fitting with PartialFit() matches a single Fit().
+ */
+TEST_CASE("PartialFitTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(4, 150);
+
+  data::StandardScaler standardFull, standardBatched;
+  standardFull.Fit(input);
+  standardBatched.PartialFit(input.cols(0, 49));
+  standardBatched.PartialFit(input.cols(50, 99));
+  standardBatched.PartialFit(input.cols(100, 149));
+
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    REQUIRE(standardBatched.ItemMean()[i] ==
+        Approx(standardFull.ItemMean()[i]).epsilon(1e-10));
+    REQUIRE(standardBatched.ItemStdDev()[i] ==
+        Approx(standardFull.ItemStdDev()[i]).epsilon(1e-10));
+  }
+
+  data::MinMaxScaler minmaxFull, minmaxBatched;
+  minmaxFull.Fit(input);
+  minmaxBatched.PartialFit(input.cols(0, 49));
+  minmaxBatched.PartialFit(input.cols(50, 99));
+  minmaxBatched.PartialFit(input.cols(100, 149));
+
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    REQUIRE(minmaxBatched.ItemMin()[i] ==
+        Approx(minmaxFull.ItemMin()[i]).epsilon(1e-10));
+    REQUIRE(minmaxBatched.ItemMax()[i] ==
+        Approx(minmaxFull.ItemMax()[i]).epsilon(1e-10));
+  }
+
+  // The batched scalers must transform identically to the full ones.
+  arma::mat outputFull, outputBatched;
+  standardFull.Transform(input, outputFull);
+  standardBatched.Transform(input, outputBatched);
+  CheckMatrices(outputFull, outputBatched);
+}
+
+/**
+ * Test that merging per-shard scalers matches fitting the whole dataset.
+ */
+TEST_CASE("ScalerMergeTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(3, 120);
+
+  data::StandardScaler standardFull, standardShardA, standardShardB;
+  standardFull.Fit(input);
+  standardShardA.Fit(input.cols(0, 69));
+  standardShardB.Fit(input.cols(70, 119));
+  standardShardA.Merge(standardShardB);
+
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    REQUIRE(standardShardA.ItemMean()[i] ==
+        Approx(standardFull.ItemMean()[i]).epsilon(1e-10));
+    REQUIRE(standardShardA.ItemStdDev()[i] ==
+        Approx(standardFull.ItemStdDev()[i]).epsilon(1e-10));
+  }
+
+  data::MinMaxScaler minmaxFull, minmaxShardA, minmaxShardB;
+  minmaxFull.Fit(input);
+  minmaxShardA.Fit(input.cols(0, 69));
+  minmaxShardB.Fit(input.cols(70, 119));
+  minmaxShardA.Merge(minmaxShardB);
+
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    REQUIRE(minmaxShardA.ItemMin()[i] ==
+        Approx(minmaxFull.ItemMin()[i]).epsilon(1e-10));
+    REQUIRE(minmaxShardA.ItemMax()[i] ==
+        Approx(minmaxFull.ItemMax()[i]).epsilon(1e-10));
+  }
+
+  // Merging scalers with different output ranges must fail.
+  data::MinMaxScaler differentRange(-1, 1);
+  differentRange.Fit(input);
+  REQUIRE_THROWS_AS(minmaxShardA.Merge(differentRange), std::runtime_error);
+}
@@ -1121,6 +1121,58 @@ TEST_CASE("LARSTest", "[SerializationTest]")
   CheckMatrices(pred, xmlPred, jsonPred, binaryPred);
 }
 
+/**
+ * Test that LARS's training-only state is stored in skippable sections: a
+ * model loaded with section skipping enabled predicts identically, but does
+ * not materialize the Gram matrix or its Cholesky factor.
+ */
+TEST_CASE("LARSSkippableSectionTest", "[SerializationTest]")
+{
+  using namespace mlpack::regression;
+
+  // Create a dataset and train a model.
+  arma::mat X = arma::randn(75, 250);
+  arma::vec beta = arma::randn(75, 1);
+  arma::rowvec y = beta.t() * X;
+
+  LARS lars(true, 0.1, 0.1);
+  arma::vec betaOpt;
+  lars.Train(X, y, betaOpt);
+
+  arma::rowvec pred;
+  lars.Predict(X, pred);
+
+  // Check every archive type, since sections are embedded differently in
+  // binary and text archives.
+  const std::vector<std::string> files = { "lars_section_test.bin",
+      "lars_section_test.json", "lars_section_test.xml" };
+  for (const std::string& file : files)
+  {
+    REQUIRE(data::Save(file, "lars", lars));
+
+    // A full load must restore the training-only state.
+    LARS fullLars;
+    REQUIRE(data::Load(file, "lars", fullLars));
+    REQUIRE(fullLars.MatUtriCholFactor().n_elem ==
+        lars.MatUtriCholFactor().n_elem);
+
+    // An inference-only load skips the training-only state entirely.
+    LARS skipLars;
+    REQUIRE(data::Load(file, "lars", skipLars, false, data::format::autodetect,
+        true));
+    REQUIRE(skipLars.MatUtriCholFactor().n_elem == 0);
+
+    // Both loaded models must predict the same as the original.
+    arma::rowvec fullPred, skipPred;
+    fullLars.Predict(X, fullPred);
+    skipLars.Predict(X, skipPred);
+    CheckMatrices(pred, fullPred);
+    CheckMatrices(pred, skipPred);
+
+    remove(file.c_str());
+  }
+}
+
 /**
  * Test serialization of the HoeffdingNumericSplit object after binning has
  * occured.
@@ -674,3 +674,62 @@ TEST_CASE("SoftmaxRegressionComputeProbabilitiesAndLabelsTest",
     REQUIRE(testLabels(i) == labels(i));
   }
 }
+
+/**
+ * TrainIncremental() should refit an already-trained model from its current
+ * weights on new data, and refuse to run on an untrained model.
+ */
+TEST_CASE("SoftmaxRegressionTrainIncrementalTest", "[SoftmaxRegressionTest]")
+{
+  const size_t points = 1000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+  const double lambda = 0.5;
+
+  // Generate two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+
+  // Train on the dataset, then refit on a fresh batch of points from the
+  // same distributions.
+  SoftmaxRegression sr(data, labels, numClasses, lambda);
+
+  arma::mat newData(inputSize, points);
+  arma::Row<size_t> newLabels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    newData.col(i) = g1.Random();
+    newLabels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    newData.col(i) = g2.Random();
+    newLabels(i) = 1;
+  }
+
+  sr.TrainIncremental(newData, newLabels);
+
+  // The refit model must still classify both batches correctly.
+  REQUIRE(sr.ComputeAccuracy(data, labels) == Approx(100.0).epsilon(0.02));
+  REQUIRE(sr.ComputeAccuracy(newData, newLabels) ==
+      Approx(100.0).epsilon(0.02));
+
+  // An untrained model cannot be refit incrementally.
+  SoftmaxRegression untrained;
+  REQUIRE_THROWS_AS(untrained.TrainIncremental(newData, newLabels),
+      std::invalid_argument);
+}
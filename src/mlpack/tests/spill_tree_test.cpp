@@ -304,3 +304,114 @@ TEST_CASE("SpillTreeMoveDatasetTest", "[SpillTreeTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Test that the per-level spill statistics recorded during construction match
+ * the tree that was actually built.
+ */
+TEST_CASE("SpillTreeLevelInfoTest", "[SpillTreeTest]")
+{
+  arma::mat dataset;
+  dataset.randu(3, 1000); // 1000 points in 3 dimensions.
+
+  typedef SPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  TreeType tree(dataset, 0.05);
+
+  const std::vector<TreeType::LevelInfo>& infos = tree.LevelInfos();
+  REQUIRE(infos.size() > 0);
+
+  // Aggregate the splits level by level and compare with the recorded
+  // statistics.
+  std::vector<size_t> numNodes(infos.size(), 0), numPoints(infos.size(), 0),
+      numSpilled(infos.size(), 0);
+  std::stack<std::pair<TreeType*, size_t>> nodes;
+  nodes.push(std::make_pair(&tree, 0));
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top().first;
+    const size_t level = nodes.top().second;
+    nodes.pop();
+
+    if (node->IsLeaf())
+      continue;
+
+    REQUIRE(level < infos.size());
+    numNodes[level]++;
+    numPoints[level] += node->NumDescendants();
+    numSpilled[level] += node->Left()->NumDescendants() +
+        node->Right()->NumDescendants() - node->NumDescendants();
+
+    nodes.push(std::make_pair(node->Left(), level + 1));
+    nodes.push(std::make_pair(node->Right(), level + 1));
+  }
+
+  size_t totalSpilled = 0;
+  for (size_t l = 0; l < infos.size(); ++l)
+  {
+    REQUIRE(infos[l].numNodes == numNodes[l]);
+    REQUIRE(infos[l].numPoints == numPoints[l]);
+    REQUIRE(infos[l].numSpilled == numSpilled[l]);
+    totalSpilled += infos[l].numSpilled;
+  }
+
+  // With this overlap width, some points must actually have spilled.
+  REQUIRE(totalSpilled > 0);
+}
+
+/**
+ * Test that the auto-tuned overlap keeps every level's spill rate below the
+ * per-split duplication cap derived from the overlap budget.
+ */
+TEST_CASE("SpillTreeAutoTuneTest", "[SpillTreeTest]")
+{
+  arma::mat dataset;
+  dataset.randu(3, 1000); // 1000 points in 3 dimensions.
+
+  typedef SPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  const double overlapBudget = 1.5;
+  TreeType tree(dataset, 0.0, 20, 0.7, overlapBudget);
+
+  // This is the per-split duplication cap the auto-tuner derives from the
+  // budget.
+  const double depth = std::ceil(std::log2(1000.0 / 20));
+  const double spillFraction = std::pow(overlapBudget, 1.0 / depth) - 1.0;
+
+  const std::vector<TreeType::LevelInfo>& infos = tree.LevelInfos();
+  REQUIRE(infos.size() > 0);
+
+  size_t totalSpilled = 0;
+  for (size_t l = 0; l < infos.size(); ++l)
+  {
+    REQUIRE(infos[l].SpillRate() <= spillFraction + 1e-12);
+    totalSpilled += infos[l].numSpilled;
+  }
+
+  // The auto-tuner must actually use the budget.
+  REQUIRE(totalSpilled > 0);
+
+  // The points stored at the leaves are the original points plus one copy per
+  // spill.
+  size_t totalStored = 0;
+  std::stack<TreeType*> nodes;
+  nodes.push(&tree);
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top();
+    nodes.pop();
+
+    if (node->IsLeaf())
+    {
+      totalStored += node->NumPoints();
+    }
+    else
+    {
+      nodes.push(node->Left());
+      nodes.push(node->Right());
+    }
+  }
+  REQUIRE(totalStored == 1000 + totalSpilled);
+
+  // The per-level caps are exact; the total can only exceed the budget if the
+  // tree gets deeper than the balanced estimate, so just sanity-check it.
+  REQUIRE(totalStored <= 2 * 1000);
+}
@@ -434,3 +434,57 @@ TEST_CASE("SplitLabeledDataResultField", "[SplitDataTest]")
   CheckFields(input, inputConcat);
   CheckFields(label, labelConcat);
 }
+
+/**
+ * Check that the index-view form of Split() partitions the indices correctly,
+ * with and without shuffling.
+ */
+TEST_CASE("SplitIndexViewTest", "[SplitDataTest]")
+{
+  const size_t count = 10;
+
+  arma::uvec trainIndices, testIndices;
+  Split(count, trainIndices, testIndices, 0.3);
+
+  REQUIRE(trainIndices.n_elem == 7);
+  REQUIRE(testIndices.n_elem == 3);
+
+  // Each index must appear exactly once across the two vectors.
+  arma::uvec counts(count, arma::fill::zeros);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    counts[trainIndices[i]]++;
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    counts[testIndices[i]]++;
+  for (size_t i = 0; i < count; ++i)
+    REQUIRE(counts[i] == 1);
+
+  // Without shuffling, the split must be the same as the copying Split().
+  Split(count, trainIndices, testIndices, 0.3, false);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    REQUIRE(trainIndices[i] == i);
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    REQUIRE(testIndices[i] == trainIndices.n_elem + i);
+}
+
+/**
+ * Check that the no-copy split views alias the input's memory and match the
+ * result of the copying non-shuffled Split().
+ */
+TEST_CASE("SplitViewTest", "[SplitDataTest]")
+{
+  mat input(3, 10);
+  input.imbue([&]() { return Random(); });
+
+  mat trainView = TrainSplitView(input, 0.3);
+  mat testView = TestSplitView(input, 0.3);
+
+  // The views must share memory with the input, not copy it.
+  REQUIRE(trainView.memptr() == input.memptr());
+  REQUIRE(testView.memptr() == input.memptr() + 7 * input.n_rows);
+
+  mat trainData, testData;
+  Split(input, trainData, testData, 0.3, false);
+
+  CheckMatrices(trainView, trainData);
+  CheckMatrices(testView, testData);
+}
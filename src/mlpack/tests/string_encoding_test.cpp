@@ -1433,3 +1433,108 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Build a corpus large enough to be split into several blocks by the
+ * parallel encoder.
+ */
+static vector<string> BuildParallelEncodingInput()
+{
+  vector<string> input;
+
+  for (size_t i = 0; i < 64; ++i)
+  {
+    string document;
+    for (size_t j = 0; j <= i; ++j)
+      document += "token" + std::to_string((i * 7 + j * 3) % 50) + " ";
+    input.push_back(document);
+  }
+
+  return input;
+}
+
+/**
+ * Test that the parallel dictionary encoding algorithm is equivalent to the
+ * sequential one.
+ */
+TEST_CASE("ParallelDictionaryEncodingTest", "[StringEncodingTest]")
+{
+  const vector<string> input = BuildParallelEncodingInput();
+
+  arma::mat output, parallelOutput;
+  DictionaryEncoding<SplitByAnyOf::TokenType> encoder, parallelEncoder;
+  SplitByAnyOf tokenizer(" ");
+
+  encoder.Encode(input, output, tokenizer);
+  parallelEncoder.ParallelEncode(input, parallelOutput, tokenizer);
+
+  CheckDictionaries(encoder.Dictionary(), parallelEncoder.Dictionary());
+  CheckMatrices(output, parallelOutput);
+}
+
+/**
+ * Test that the parallel one pass dictionary encoding algorithm is
+ * equivalent to the sequential one.
+ */
+TEST_CASE("ParallelOnePassDictionaryEncodingTest", "[StringEncodingTest]")
+{
+  const vector<string> input = BuildParallelEncodingInput();
+
+  vector<vector<size_t>> output, parallelOutput;
+  DictionaryEncoding<SplitByAnyOf::TokenType> encoder, parallelEncoder;
+  SplitByAnyOf tokenizer(" ");
+
+  encoder.Encode(input, output, tokenizer);
+  parallelEncoder.ParallelEncode(input, parallelOutput, tokenizer);
+
+  CheckDictionaries(encoder.Dictionary(), parallelEncoder.Dictionary());
+  REQUIRE(output == parallelOutput);
+}
+
+/**
+ * Test that the parallel Tf-Idf encoding algorithm is equivalent to the
+ * sequential one.
+ */
+TEST_CASE("ParallelTfIdfEncodingTest", "[StringEncodingTest]")
+{
+  const vector<string> input = BuildParallelEncodingInput();
+
+  arma::mat output, parallelOutput;
+  TfIdfEncoding<SplitByAnyOf::TokenType> encoder(
+      TfIdfEncodingPolicy(TfIdfEncodingPolicy::TfTypes::RAW_COUNT, false));
+  TfIdfEncoding<SplitByAnyOf::TokenType> parallelEncoder(
+      TfIdfEncodingPolicy(TfIdfEncodingPolicy::TfTypes::RAW_COUNT, false));
+  SplitByAnyOf tokenizer(" ");
+
+  encoder.Encode(input, output, tokenizer);
+  parallelEncoder.ParallelEncode(input, parallelOutput, tokenizer);
+
+  CheckDictionaries(encoder.Dictionary(), parallelEncoder.Dictionary());
+  CheckMatrices(output, parallelOutput);
+}
+
+/**
+ * Test the parallel dictionary encoding algorithm in case of individual
+ * character encoding.
+ */
+TEST_CASE("ParallelDictionaryEncodingIndividualCharactersTest",
+          "[StringEncodingTest]")
+{
+  vector<string> input = {
+    "GACCA",
+    "ABCABCD",
+    "GAB"
+  };
+
+  arma::mat output;
+  DictionaryEncoding<CharExtract::TokenType> encoder;
+
+  encoder.ParallelEncode(input, output, CharExtract());
+
+  arma::mat target = {
+    { 1, 2, 3, 3, 2, 0, 0 },
+    { 2, 4, 3, 2, 4, 3, 5 },
+    { 1, 2, 4, 0, 0, 0, 0 }
+  };
+  CheckMatrices(output, target.t());
+}
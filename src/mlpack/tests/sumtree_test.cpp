@@ -88,3 +88,58 @@ TEST_CASE("BatchUpdate", "[SumTreeTest]")
   CHECK(sumtree.FindPrefixSum(2.8) <= 3);
   CHECK(sumtree.FindPrefixSum(3.0) <= 3);
 }
+
+/**
+ * Test that a batch update of a subset of indices leaves the tree identical
+ * to setting the same values one at a time.
+ */
+TEST_CASE("PartialBatchUpdate", "[SumTreeTest]")
+{
+  SumTree<double> sumtree(8);
+  SumTree<double> reference(8);
+  for (size_t i = 0; i < 8; ++i)
+  {
+    sumtree.Set(i, 0.5);
+    reference.Set(i, 0.5);
+  }
+
+  // Update only some of the leaves; indices 2 and 3 share a parent, so the
+  // shared ancestors must still be recomputed correctly.
+  arma::ucolvec indices = {2, 3, 7};
+  arma::colvec data = {1.5, 0.25, 2.0};
+
+  sumtree.BatchUpdate(indices, data);
+  for (size_t i = 0; i < indices.n_rows; ++i)
+    reference.Set(indices[i], data[i]);
+
+  CHECK(sumtree.Sum() == Approx(reference.Sum()).epsilon(1e-10));
+  for (size_t start = 0; start < 8; ++start)
+  {
+    for (size_t end = start + 1; end <= 8; ++end)
+    {
+      CHECK(sumtree.Sum(start, end) ==
+          Approx(reference.Sum(start, end)).epsilon(1e-10));
+    }
+  }
+}
+
+/**
+ * Test that the batched Get() returns the same values as the single-index
+ * overload.
+ */
+TEST_CASE("BatchGetElement", "[SumTreeTest]")
+{
+  SumTree<double> sumtree(4);
+  sumtree.Set(0, 1.0);
+  sumtree.Set(1, 0.8);
+  sumtree.Set(2, 0.6);
+  sumtree.Set(3, 0.4);
+
+  arma::ucolvec indices = {3, 1, 0, 2};
+  arma::colvec values;
+  sumtree.Get(indices, values);
+
+  REQUIRE(values.n_elem == indices.n_rows);
+  for (size_t i = 0; i < indices.n_rows; ++i)
+    CHECK(values[i] == Approx(sumtree.Get(indices[i])).epsilon(1e-10));
+}
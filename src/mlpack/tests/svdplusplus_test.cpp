@@ -550,3 +550,47 @@ TEST_CASE("SVDPlusPlusFunctionParallelOptimize", "[SVDPlusPlusTest]")
 }
 
 #endif
+
+// Test the warm-started Apply() overload, which reuses a previous
+// factorization as the starting point and trains with sharded parallel SGD.
+TEST_CASE("SVDPlusPlusWarmStartOutputSizeTest", "[SVDPlusPlusTest]")
+{
+  // Load small GroupLens dataset.
+  arma::mat data;
+  if (!data::Load("GroupLensSmall.csv", data))
+    FAIL("Cannot load dataset GroupLensSmall.csv");
+
+  // Define useful constants.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+  const size_t rank = 10;
+  const size_t iterations = 10;
+
+  // Use whether a user rates an item as binary implicit data.
+  arma::mat implicitData = data.submat(0, 0, 1, data.n_cols - 1);
+
+  // Resulting user/item matrices/bias, and item implicit matrix.
+  arma::mat userLatent, itemLatent;
+  arma::vec userBias, itemBias;
+  arma::mat itemImplicit;
+
+  // First fit: no usable factors yet, so this falls back to random
+  // initialization.
+  SVDPlusPlus<> svdPP(iterations);
+  svdPP.Apply(data, implicitData, rank, itemLatent, userLatent, itemBias,
+      userBias, itemImplicit, false);
+
+  // Refit starting from the factors of the first fit.
+  svdPP.Apply(data, implicitData, rank, itemLatent, userLatent, itemBias,
+      userBias, itemImplicit, true);
+
+  // Check the size of outputs.
+  REQUIRE(itemLatent.n_rows == numItems);
+  REQUIRE(itemLatent.n_cols == rank);
+  REQUIRE(userLatent.n_rows == rank);
+  REQUIRE(userLatent.n_cols == numUsers);
+  REQUIRE(itemBias.n_elem == numItems);
+  REQUIRE(userBias.n_elem == numUsers);
+  REQUIRE(itemImplicit.n_rows == rank);
+  REQUIRE(itemImplicit.n_cols == numItems);
+}
@@ -19,6 +19,7 @@
 #endif
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/util/arena_allocator.hpp>
 
 #include "catch.hpp"
 
@@ -143,3 +144,232 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * Test that integer-handle timers aggregate time and call counts, that
+ * re-registering a name returns the same handle, and that Reset() zeroes the
+ * aggregates.
+ */
+TEST_CASE("FastTimerTest", "[TimerTest]")
+{
+  const size_t handle = util::FastTimer::Register("fast_test_timer");
+  REQUIRE(util::FastTimer::Register("fast_test_timer") == handle);
+  REQUIRE(util::FastTimer::Name(handle) == "fast_test_timer");
+
+  util::FastTimer::Reset();
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    util::FastTimer::Start(handle);
+
+    #ifdef _WIN32
+    Sleep(10);
+    #else
+    usleep(10000);
+    #endif
+
+    util::FastTimer::Stop(handle);
+  }
+
+  // FastTimer aggregates are additive over runs, like Timer's.
+  REQUIRE(util::FastTimer::Get(handle).count() >= 30000);
+  REQUIRE(util::FastTimer::Count(handle) == 3);
+
+  const std::map<std::string, std::chrono::microseconds> all =
+      util::FastTimer::GetAllTimers();
+  REQUIRE(all.count("fast_test_timer") == 1);
+  REQUIRE(all.at("fast_test_timer") == util::FastTimer::Get(handle));
+
+  util::FastTimer::Reset();
+  REQUIRE(util::FastTimer::Get(handle) == std::chrono::microseconds(0));
+  REQUIRE(util::FastTimer::Count(handle) == 0);
+}
+
+/**
+ * Test that a fast timer may run on several threads at once and that its
+ * aggregate sums over the threads.
+ */
+TEST_CASE("FastTimerMultithreadTest", "[TimerTest]")
+{
+  const size_t handle = util::FastTimer::Register("fast_thread_timer");
+  util::FastTimer::Reset();
+
+  std::thread threads[3];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    threads[i] = std::thread([handle]()
+        {
+          util::ScopedFastTimer timer(handle);
+
+          #ifdef _WIN32
+          Sleep(20);
+          #else
+          int restarts = 0;
+          // Catch occasional EINTR failures.
+          while (usleep(20000) != 0 && restarts < 3)
+            ++restarts;
+          #endif
+        });
+  }
+
+  for (size_t i = 0; i < 3; ++i)
+    threads[i].join();
+
+  REQUIRE(util::FastTimer::Get(handle) > std::chrono::microseconds(50000));
+  REQUIRE(util::FastTimer::Count(handle) == 3);
+}
+
+/**
+ * Test that the hierarchical profiler aggregates nested regions with correct
+ * call counts, and that a disabled profiler records nothing.
+ */
+TEST_CASE("ProfilerRegionTreeTest", "[TimerTest]")
+{
+  // Nothing should be recorded while profiling is disabled (the default).
+  {
+    util::ProfileRegion region("disabled_region");
+  }
+  REQUIRE(util::Profiler::LocalTree().children.count("disabled_region") == 0);
+
+  util::Profiler::Enable();
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    util::ProfileRegion outer("outer_region");
+    {
+      util::ProfileRegion inner("inner_region");
+    }
+    {
+      util::ProfileRegion inner("inner_region");
+    }
+  }
+
+  util::Profiler::Disable();
+
+  const util::Profiler::Node& root = util::Profiler::LocalTree();
+  REQUIRE(root.children.count("outer_region") == 1);
+  const util::Profiler::Node& outer = *root.children.at("outer_region");
+  REQUIRE(outer.count == 3);
+
+  // The inner region is nested under the outer one, not a top-level region.
+  REQUIRE(root.children.count("inner_region") == 0);
+  REQUIRE(outer.children.count("inner_region") == 1);
+  const util::Profiler::Node& inner = *outer.children.at("inner_region");
+  REQUIRE(inner.count == 6);
+
+  // Inclusive time of the outer region covers its children.
+  REQUIRE(outer.inclusive >= inner.inclusive);
+
+  util::Profiler::Clear();
+  REQUIRE(util::Profiler::LocalTree().children.empty());
+}
+
+/**
+ * Test that the chrome-trace export is produced and contains the recorded
+ * regions.
+ */
+TEST_CASE("ProfilerChromeTraceTest", "[TimerTest]")
+{
+  util::Profiler::Clear();
+  util::Profiler::Enable();
+  {
+    util::ProfileRegion region("trace_region");
+  }
+  util::Profiler::Disable();
+
+  std::ostringstream trace;
+  util::Profiler::ExportChromeTrace(trace);
+
+  const std::string json = trace.str();
+  REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+  REQUIRE(json.find("\"name\":\"trace_region\"") != std::string::npos);
+  REQUIRE(json.find("\"ph\":\"X\"") != std::string::npos);
+
+  util::Profiler::Clear();
+}
+
+/**
+ * Test that the memory tracker counts allocations and deallocations, keeps a
+ * high-water mark, and is a no-op while disabled.
+ */
+TEST_CASE("MemoryTrackerTest", "[TimerTest]")
+{
+  // Nothing should be counted while tracking is disabled (the default).
+  util::MemoryTracker::RecordAllocation(1024);
+  REQUIRE(util::MemoryTracker::CurrentBytes() == 0);
+
+  util::MemoryTracker::Enable();
+  util::MemoryTracker::ResetPeak();
+
+  const size_t base = util::MemoryTracker::CurrentBytes();
+  util::MemoryTracker::RecordAllocation(4096);
+  util::MemoryTracker::RecordAllocation(1024);
+  REQUIRE(util::MemoryTracker::CurrentBytes() == base + 5120);
+  REQUIRE(util::MemoryTracker::PeakBytes() >= base + 5120);
+
+  // The peak survives deallocation.
+  util::MemoryTracker::RecordDeallocation(4096);
+  util::MemoryTracker::RecordDeallocation(1024);
+  REQUIRE(util::MemoryTracker::CurrentBytes() == base);
+  REQUIRE(util::MemoryTracker::PeakBytes() >= base + 5120);
+
+  // On any supported platform the process peak RSS should be measurable.
+  REQUIRE(util::MemoryTracker::PeakRSS() > 0);
+
+  util::MemoryTracker::Disable();
+}
+
+/**
+ * Test that profiled regions record the tracked high-water mark of the
+ * allocations made while they were open.
+ */
+TEST_CASE("MemoryTrackerRegionPeakTest", "[TimerTest]")
+{
+  util::Profiler::Clear();
+  util::MemoryTracker::Enable();
+  util::MemoryTracker::ResetPeak();
+  util::Profiler::Enable();
+
+  {
+    util::ProfileRegion region("alloc_region");
+    util::MemoryTracker::RecordAllocation(65536);
+    util::MemoryTracker::RecordDeallocation(65536);
+  }
+  {
+    util::ProfileRegion region("quiet_region");
+  }
+
+  util::Profiler::Disable();
+  util::MemoryTracker::Disable();
+
+  const util::Profiler::Node& root = util::Profiler::LocalTree();
+  REQUIRE(root.children.count("alloc_region") == 1);
+  REQUIRE(root.children.at("alloc_region")->peakBytes >= 65536);
+
+  // The quiet region saw no allocations beyond what was already live.
+  REQUIRE(root.children.count("quiet_region") == 1);
+  REQUIRE(root.children.at("quiet_region")->peakBytes <
+      root.children.at("alloc_region")->peakBytes);
+
+  util::Profiler::Clear();
+}
+
+/**
+ * Test that the arena allocator reports its chunk allocations to the memory
+ * tracker.
+ */
+TEST_CASE("MemoryTrackerArenaTest", "[TimerTest]")
+{
+  util::MemoryTracker::Enable();
+
+  const size_t before = util::MemoryTracker::CurrentBytes();
+  {
+    util::ArenaAllocator arena(4096);
+    arena.New<double>(1.0);
+    REQUIRE(util::MemoryTracker::CurrentBytes() >= before + 4096);
+  }
+  // The arena's chunks are counted as freed at teardown.
+  REQUIRE(util::MemoryTracker::CurrentBytes() == before);
+
+  util::MemoryTracker::Disable();
+}
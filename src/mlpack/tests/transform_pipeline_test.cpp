@@ -0,0 +1,100 @@
+/**
+ * @file tests/transform_pipeline_test.cpp
+ * @author Keon Kim
+ *
+ * Test the TransformPipeline fused elementwise transforms.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/binarize.hpp>
+#include <mlpack/core/data/transform_pipeline.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace arma;
+using namespace mlpack::data;
+
+/**
+ * A single-transform pipeline must match Binarize().
+ */
+TEST_CASE("TransformPipelineBinarizeTest", "[TransformPipelineTest]")
+{
+  mat input = randu<mat>(5, 100);
+
+  mat expected;
+  Binarize<double>(input, expected, 0.5);
+
+  mat output;
+  MakeTransformPipeline(BinarizeTransform(0.5)).Apply(input, output);
+
+  CheckMatrices(expected, output);
+}
+
+/**
+ * A chained pipeline must match applying the transforms one at a time, both
+ * out of place and in place.
+ */
+TEST_CASE("TransformPipelineChainTest", "[TransformPipelineTest]")
+{
+  mat input = randu<mat>(4, 200) * 10.0;
+
+  // Shift by -5, scale by 1/5, clamp into [-0.8, 0.8], then binarize.
+  auto pipeline = MakeTransformPipeline(ShiftTransform(-5.0))
+      .Then(ScaleTransform(1.0 / 5.0))
+      .Then(ClampTransform(-0.8, 0.8))
+      .Then(BinarizeTransform(0.0));
+
+  mat expected = (input - 5.0) / 5.0;
+  expected.transform([](double v) { return math::ClampRange(v, -0.8, 0.8); });
+  expected.transform([](double v) { return (double) (v > 0.0); });
+
+  mat output;
+  pipeline.Apply(input, output);
+  CheckMatrices(expected, output);
+
+  // The in-place overload must give the same result without a copy.
+  mat inPlace = input;
+  pipeline.Apply(inPlace);
+  CheckMatrices(expected, inPlace);
+}
+
+/**
+ * The single-dimension overload must leave all other dimensions untouched.
+ */
+TEST_CASE("TransformPipelineDimensionTest", "[TransformPipelineTest]")
+{
+  mat input = randu<mat>(3, 50);
+  mat output = input;
+
+  MakeTransformPipeline(ScaleTransform(2.0)).Apply(output, 1);
+
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    REQUIRE(output(0, i) == Approx(input(0, i)).epsilon(1e-7));
+    REQUIRE(output(1, i) == Approx(2.0 * input(1, i)).epsilon(1e-7));
+    REQUIRE(output(2, i) == Approx(input(2, i)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Lambdas must be usable as pipeline transforms.
+ */
+TEST_CASE("TransformPipelineLambdaTest", "[TransformPipelineTest]")
+{
+  mat input = randu<mat>(2, 100);
+
+  auto pipeline = MakeTransformPipeline(
+      [](double v) { return v * v; }).Then(ShiftTransform(1.0));
+
+  mat output;
+  pipeline.Apply(input, output);
+
+  for (size_t i = 0; i < input.n_elem; ++i)
+    REQUIRE(output[i] == Approx(input[i] * input[i] + 1.0).epsilon(1e-7));
+}
@@ -489,6 +489,75 @@ TEST_CASE("HRectBoundRangeDistancePoint", "[TreeTest]")
   }
 }
 
+/**
+ * The unrolled L2 fast paths of MinDistance()/MaxDistance() must agree with a
+ * straightforward per-dimension computation, for every dimensionality (to
+ * cover the unrolled loop plus its remainder) and for both the rooted and
+ * squared metrics.
+ */
+TEST_CASE("HRectBoundL2FastPathTest", "[TreeTest]")
+{
+  for (size_t dim = 1; dim <= 20; ++dim)
+  {
+    HRectBound<EuclideanDistance> a(dim);
+    HRectBound<EuclideanDistance> b(dim);
+    HRectBound<metric::LMetric<2, false>> aSq(dim);
+
+    arma::vec loA(dim, arma::fill::randu), widthA(dim, arma::fill::randu);
+    arma::vec loB(dim, arma::fill::randu), widthB(dim, arma::fill::randu);
+    loB += 0.5; // Partially overlapping bounds.
+
+    for (size_t j = 0; j < dim; ++j)
+    {
+      a[j] = Range(loA[j], loA[j] + widthA[j]);
+      aSq[j] = Range(loA[j], loA[j] + widthA[j]);
+      b[j] = Range(loB[j], loB[j] + widthB[j]);
+    }
+
+    // Reference bound-to-bound distances, computed the obvious way.
+    double minSum = 0.0, maxSum = 0.0;
+    for (size_t j = 0; j < dim; ++j)
+    {
+      const double gap = std::max(std::max(b[j].Lo() - a[j].Hi(),
+          a[j].Lo() - b[j].Hi()), 0.0);
+      minSum += gap * gap;
+      const double v = std::max(std::fabs(b[j].Hi() - a[j].Lo()),
+          std::fabs(a[j].Hi() - b[j].Lo()));
+      maxSum += v * v;
+    }
+
+    REQUIRE(a.MinDistance(b) == Approx(std::sqrt(minSum)).epsilon(1e-7));
+    REQUIRE(a.MaxDistance(b) == Approx(std::sqrt(maxSum)).epsilon(1e-7));
+
+    // Now bound-to-point distances, on a few random points.
+    for (int t = 0; t < 5; ++t)
+    {
+      arma::vec point(dim, arma::fill::randu);
+      point *= 2.0;
+
+      double minPSum = 0.0, maxPSum = 0.0;
+      for (size_t j = 0; j < dim; ++j)
+      {
+        const double gap = std::max(std::max(a[j].Lo() - point[j],
+            point[j] - a[j].Hi()), 0.0);
+        minPSum += gap * gap;
+        const double v = std::max(std::fabs(point[j] - a[j].Lo()),
+            std::fabs(a[j].Hi() - point[j]));
+        maxPSum += v * v;
+      }
+
+      REQUIRE(a.MinDistance(point) ==
+          Approx(std::sqrt(minPSum)).epsilon(1e-7));
+      REQUIRE(a.MaxDistance(point) ==
+          Approx(std::sqrt(maxPSum)).epsilon(1e-7));
+
+      // The squared (TakeRoot = false) variant must agree too.
+      REQUIRE(aSq.MinDistance(point) == Approx(minPSum).epsilon(1e-7));
+      REQUIRE(aSq.MaxDistance(point) == Approx(maxPSum).epsilon(1e-7));
+    }
+  }
+}
+
 /**
  * Test that we can expand the bound to include a new point.
  */
@@ -705,6 +774,31 @@ TEST_CASE("BallBoundMoveConstructor", "[TreeTest]")
   REQUIRE(b1.MinWidth() == Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Ensure that the batched bound-to-point minimum distances match the
+ * single-point computation.
+ */
+TEST_CASE("BallBoundBatchMinDistanceTest", "[TreeTest]")
+{
+  BallBound<> b(0.5, arma::vec("1 2 3"));
+
+  // Use points inside, on the edge of, and outside the ball.
+  arma::mat points(3, 100, arma::fill::randu);
+  points *= 2.0;
+  points.each_col() += arma::vec("0 1 2");
+
+  arma::vec batchDistances;
+  b.MinDistance(points, batchDistances);
+
+  REQUIRE(batchDistances.n_elem == points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const arma::vec point = points.col(i);
+    REQUIRE(batchDistances[i] ==
+        Approx(b.MinDistance(point)).margin(1e-10));
+  }
+}
+
 /**
  * Ensure that we calculate the correct minimum distance between a point and a
  * bound.
@@ -1363,6 +1457,232 @@ TEST_CASE("KdTreeTest", "[TreeTest]")
   TreeType root(dataset);
 }
 
+template<typename TreeType>
+void CheckSameStructure(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.Begin() == b.Begin());
+  REQUIRE(a.Count() == b.Count());
+  REQUIRE(a.IsLeaf() == b.IsLeaf());
+
+  if (!a.IsLeaf())
+  {
+    CheckSameStructure(*a.Left(), *b.Left());
+    CheckSameStructure(*a.Right(), *b.Right());
+  }
+}
+
+/**
+ * Building a kd-tree with task-parallel construction must give exactly the
+ * same tree as a serial build, since the partition at each node is finished
+ * before the two subtree builds are spawned.
+ */
+TEST_CASE("ParallelKdTreeConstructionTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(8, 5000);
+  dataset.randu();
+
+  std::vector<size_t> serialNewToOld, parallelNewToOld;
+
+  const size_t oldCutoff = TreeType::ParallelBuildCutoff();
+
+  // Force a fully serial build, then a build where every eligible node is
+  // handed to a task.
+  TreeType::ParallelBuildCutoff() = std::numeric_limits<size_t>::max();
+  TreeType serialTree(dataset, serialNewToOld);
+
+  TreeType::ParallelBuildCutoff() = 1;
+  TreeType parallelTree(dataset, parallelNewToOld);
+
+  TreeType::ParallelBuildCutoff() = oldCutoff;
+
+  REQUIRE(serialNewToOld == parallelNewToOld);
+  CheckSameStructure(serialTree, parallelTree);
+}
+
+/**
+ * Trees built by the building constructors allocate their nodes from an
+ * arena owned by the root; make sure copies and moves of such trees behave
+ * correctly (a copy is independently allocated, and a move transfers the
+ * arena so the original can be destroyed safely).
+ */
+TEST_CASE("TreeArenaLifetimeTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(3, 400);
+  dataset.randu();
+
+  // Copy an arena-built tree, then destroy the original; the copy must
+  // remain fully usable.
+  TreeType* tree = new TreeType(dataset);
+  TreeType copy(*tree);
+  const size_t numDesc = tree->NumDescendants();
+  delete tree;
+
+  REQUIRE(copy.NumDescendants() == numDesc);
+  CheckSameStructure(copy, copy); // Walks the whole copied tree.
+
+  // Move an arena-built tree out of its original object.
+  TreeType original(dataset);
+  TreeType moved(std::move(original));
+  REQUIRE(moved.NumDescendants() == numDesc);
+  CheckSameStructure(copy, moved);
+}
+
+/**
+ * A minimal nearest-neighbor rule set for testing traversal over the compact
+ * tree; it keeps track of the single nearest reference point seen so far.
+ */
+template<typename NodeType>
+class CompactNearestNeighborRule
+{
+ public:
+  CompactNearestNeighborRule(const arma::mat& referenceSet,
+                             const arma::mat& querySet) :
+      referenceSet(referenceSet),
+      querySet(querySet),
+      neighbor(referenceSet.n_cols),
+      distance(querySet.n_cols, DBL_MAX) { }
+
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex)
+  {
+    const double dist = metric::EuclideanDistance::Evaluate(
+        querySet.col(queryIndex), referenceSet.col(referenceIndex));
+    if (dist < distance[queryIndex])
+    {
+      distance[queryIndex] = dist;
+      neighbor[queryIndex] = referenceIndex;
+    }
+    return dist;
+  }
+
+  double Score(const size_t queryIndex, const NodeType& referenceNode)
+  {
+    const double minDist = referenceNode.MinDistance(
+        querySet.col(queryIndex));
+    return (minDist > distance[queryIndex]) ? DBL_MAX : minDist;
+  }
+
+  double Rescore(const size_t queryIndex,
+                 const NodeType& /* referenceNode */,
+                 const double oldScore)
+  {
+    return (oldScore > distance[queryIndex]) ? DBL_MAX : oldScore;
+  }
+
+  const std::vector<double>& Distances() const { return distance; }
+
+ private:
+  const arma::mat& referenceSet;
+  const arma::mat& querySet;
+  std::vector<size_t> neighbor;
+  std::vector<double> distance;
+};
+
+/**
+ * Traversal over the flattened tree must visit the same point sets as the
+ * pointer tree; check it by running a nearest-neighbor rule over the compact
+ * tree and comparing against brute force.
+ */
+TEST_CASE("CompactBinarySpaceTreeTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  typedef CompactBinarySpaceTree<TreeType> CompactTreeType;
+
+  arma::mat dataset(5, 1500);
+  dataset.randu();
+  arma::mat queries(5, 100);
+  queries.randu();
+
+  TreeType tree(dataset);
+  CompactTreeType compactTree(tree);
+
+  // The flattened tree must have one entry per node and hold the full point
+  // set at the root.
+  REQUIRE(compactTree.Root().Begin() == 0);
+  REQUIRE(compactTree.Root().Count() == dataset.n_cols);
+
+  CompactNearestNeighborRule<CompactTreeType::Node> rule(tree.Dataset(),
+      queries);
+  CompactTreeType::SingleTreeTraverser<
+      CompactNearestNeighborRule<CompactTreeType::Node>> traverser(rule);
+  for (size_t q = 0; q < queries.n_cols; ++q)
+    traverser.Traverse(q, compactTree.Root());
+
+  // Brute-force the true nearest neighbor distances.  The tree permuted its
+  // copy of the dataset, but the set of points is the same.
+  for (size_t q = 0; q < queries.n_cols; ++q)
+  {
+    double trueDist = DBL_MAX;
+    for (size_t r = 0; r < dataset.n_cols; ++r)
+    {
+      const double dist = metric::EuclideanDistance::Evaluate(queries.col(q),
+          tree.Dataset().col(r));
+      trueDist = std::min(trueDist, dist);
+    }
+
+    REQUIRE(rule.Distances()[q] == Approx(trueDist).epsilon(1e-10));
+  }
+}
+
+/**
+ * A compact tree saved to disk and mapped back must give the same query
+ * results as the in-memory flattened tree, with no rebuild in between.
+ */
+TEST_CASE("CompactBinarySpaceTreeMmapTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  typedef CompactBinarySpaceTree<TreeType> CompactTreeType;
+
+  arma::mat dataset(4, 800);
+  dataset.randu();
+  arma::mat queries(4, 50);
+  queries.randu();
+
+  TreeType tree(dataset);
+  CompactTreeType compactTree(tree);
+  REQUIRE(compactTree.Save("test_compact_tree.bin") == true);
+
+  // Load the blob back; on POSIX this memory-maps the file.
+  CompactTreeType loadedTree("test_compact_tree.bin");
+  REQUIRE(loadedTree.NumNodes() == compactTree.NumNodes());
+  REQUIRE(loadedTree.Dataset().n_rows == tree.Dataset().n_rows);
+  REQUIRE(loadedTree.Dataset().n_cols == tree.Dataset().n_cols);
+
+  // The loaded dataset is the tree's permuted dataset, byte for byte.
+  for (size_t i = 0; i < tree.Dataset().n_elem; ++i)
+    REQUIRE(loadedTree.Dataset()[i] == tree.Dataset()[i]);
+
+  // Query both trees; the results must be identical.
+  CompactNearestNeighborRule<CompactTreeType::Node> rule(tree.Dataset(),
+      queries);
+  CompactTreeType::SingleTreeTraverser<
+      CompactNearestNeighborRule<CompactTreeType::Node>> traverser(rule);
+  CompactNearestNeighborRule<CompactTreeType::Node> loadedRule(
+      loadedTree.Dataset(), queries);
+  CompactTreeType::SingleTreeTraverser<
+      CompactNearestNeighborRule<CompactTreeType::Node>>
+      loadedTraverser(loadedRule);
+  for (size_t q = 0; q < queries.n_cols; ++q)
+  {
+    traverser.Traverse(q, compactTree.Root());
+    loadedTraverser.Traverse(q, loadedTree.Root());
+    REQUIRE(loadedRule.Distances()[q] == rule.Distances()[q]);
+  }
+
+  // A file that is not a compact tree must be rejected.
+  std::ofstream junk("test_compact_tree_junk.bin");
+  junk << "this is not a compact tree" << std::endl;
+  junk.close();
+  REQUIRE_THROWS_AS(CompactTreeType("test_compact_tree_junk.bin"),
+      std::runtime_error);
+
+  remove("test_compact_tree.bin");
+  remove("test_compact_tree_junk.bin");
+}
+
 TEST_CASE("MaxRPTreeTest", "[TreeTest]")
 {
   typedef MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
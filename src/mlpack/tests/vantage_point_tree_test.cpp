@@ -281,3 +281,28 @@ TEST_CASE("DualVPTreeTraverserTest", "[VantagePointTreeTest]")
     REQUIRE(distances1[i] == distances2[i]);
   }
 }
+
+/**
+ * Ensure that the batched bound-to-point minimum distances match the
+ * single-point computation, for points in the hole, in the shell and outside
+ * the outer ball.
+ */
+TEST_CASE("HollowBallBoundBatchMinDistanceTest", "[VantagePointTreeTest]")
+{
+  HollowBallBound<EuclideanDistance> b(2, 4, arma::vec("1.0 2.0 3.0 4.0 5.0"));
+
+  arma::mat points(5, 200, arma::fill::randu);
+  points *= 10.0;
+  points.each_col() += arma::vec("-4.0 -3.0 -2.0 -1.0 0.0");
+
+  arma::vec batchDistances;
+  b.MinDistance(points, batchDistances);
+
+  REQUIRE(batchDistances.n_elem == points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const arma::vec point = points.col(i);
+    REQUIRE(batchDistances[i] ==
+        Approx(b.MinDistance(point)).margin(1e-10));
+  }
+}
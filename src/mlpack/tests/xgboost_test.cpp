@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/xgboost/loss_functions/sse_loss.hpp>
+#include <mlpack/methods/xgboost/xgboost.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
@@ -64,3 +65,112 @@ TEST_CASE("SSEGainTest", "[XGBTest]")
   SSELoss Loss;
   REQUIRE(Loss.Evaluate<false>(input, weights) == gain);
 }
+
+/**
+ * Quantile binning should produce strictly increasing edges and map values to
+ * the bins those edges delimit.
+ */
+TEST_CASE("QuantileBinningTest", "[XGBTest]")
+{
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  dataset.row(1) *= 100.0;
+  dataset.row(2).fill(7.0); // A constant dimension cannot be split.
+
+  QuantileBinning binning(dataset, 32);
+
+  REQUIRE(binning.Dimensionality() == 3);
+  REQUIRE(binning.NumBins(0) <= 32);
+  REQUIRE(binning.NumBins(0) >= 2);
+  REQUIRE(binning.NumBins(2) == 1);
+
+  // The edges must be strictly increasing, and values on either side of an
+  // edge must land in different bins.
+  for (size_t d = 0; d < 2; ++d)
+  {
+    for (size_t b = 0; b + 1 < binning.NumBins(d) - 1; ++b)
+      REQUIRE(binning.Edge(d, b) < binning.Edge(d, b + 1));
+
+    const double edge = binning.Edge(d, 0);
+    REQUIRE(binning.Bin(d, edge) == 0);
+    REQUIRE(binning.Bin(d, edge + 1e-8) == 1);
+  }
+
+  // Binning the whole dataset should agree with per-value binning.
+  arma::Mat<uint16_t> binnedData;
+  binning.Bin(dataset, binnedData);
+  for (size_t i = 0; i < 50; ++i)
+    REQUIRE(binnedData(0, i) == binning.Bin(0, dataset(0, i)));
+}
+
+/**
+ * A single histogram tree should be able to fit a simple step function.
+ */
+TEST_CASE("HistogramTreeStepFunctionTest", "[XGBTest]")
+{
+  arma::mat dataset(1, 500, arma::fill::randu);
+  arma::rowvec responses(500);
+  for (size_t i = 0; i < 500; ++i)
+    responses[i] = (dataset(0, i) <= 0.5) ? -1.0 : 1.0;
+
+  QuantileBinning binning(dataset, 64);
+  arma::Mat<uint16_t> binnedData;
+  binning.Bin(dataset, binnedData);
+
+  // Fit the responses directly: gradient = -response, hessian = 1, so a leaf
+  // outputs the mean response of its points.
+  const arma::vec gradients = -responses.t();
+  const arma::vec hessians(500, arma::fill::ones);
+
+  HistogramTree tree(3 /* max depth */, 5 /* minimum leaf size */);
+  tree.Train(binnedData, binning, gradients, hessians);
+
+  arma::rowvec predictions;
+  tree.Predict(dataset, predictions);
+  for (size_t i = 0; i < 500; ++i)
+    REQUIRE(predictions[i] == Approx(responses[i]).margin(0.1));
+}
+
+/**
+ * Boosting should drive the training error of a nonlinear target down far
+ * below the variance of the responses.
+ */
+TEST_CASE("XGBoostTrainingErrorTest", "[XGBTest]")
+{
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::rowvec responses = 5.0 * dataset.row(0) % dataset.row(1) -
+      2.0 * dataset.row(2);
+
+  XGBoost xgb(dataset, responses, 50, 0.3, 4 /* max depth */,
+      5 /* minimum leaf size */);
+  REQUIRE(xgb.NumTrees() == 50);
+
+  arma::rowvec predictions;
+  xgb.Predict(dataset, predictions);
+
+  const double mse = arma::mean(arma::square(predictions - responses));
+  const double variance = arma::var(responses);
+  REQUIRE(mse < 0.05 * variance);
+}
+
+/**
+ * An XGBoost model should survive a serialization round trip.
+ */
+TEST_CASE("XGBoostSerializationTest", "[XGBTest]")
+{
+  arma::mat dataset(3, 300, arma::fill::randu);
+  arma::rowvec responses = 3.0 * dataset.row(0) + dataset.row(1);
+
+  XGBoost xgb(dataset, responses, 10, 0.3, 3);
+
+  XGBoost xmlXgb, jsonXgb, binaryXgb;
+  SerializeObjectAll(xgb, xmlXgb, jsonXgb, binaryXgb);
+
+  arma::rowvec predictions, xmlPredictions, jsonPredictions, binaryPredictions;
+  xgb.Predict(dataset, predictions);
+  xmlXgb.Predict(dataset, xmlPredictions);
+  jsonXgb.Predict(dataset, jsonPredictions);
+  binaryXgb.Predict(dataset, binaryPredictions);
+
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}